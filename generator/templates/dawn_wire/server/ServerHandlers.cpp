@@ -13,6 +13,8 @@
 //* limitations under the License.
 
 #include "common/Assert.h"
+#include "dawn_platform/DawnPlatform.h"
+#include "dawn_platform/tracing/TraceEvent.h"
 #include "dawn_wire/server/Server.h"
 
 namespace dawn_wire { namespace server {
@@ -90,8 +92,11 @@ namespace dawn_wire { namespace server {
     {% endfor %}
 
     const volatile char* Server::HandleCommands(const volatile char* commands, size_t size) {
+        TRACE_EVENT1(mPlatform, General, "WireServer::HandleCommands", "size", size);
         mProcs.deviceTick(DeviceObjects().Get(1)->handle);
 
+        uint32_t handledCommandCount = 0;
+
         while (size >= sizeof(WireCmd)) {
             WireCmd cmdId = *reinterpret_cast<const volatile WireCmd*>(commands);
 
@@ -110,7 +115,10 @@ namespace dawn_wire { namespace server {
                 return nullptr;
             }
             mAllocator.Reset();
+            handledCommandCount++;
         }
+        TRACE_COUNTER_UINT64(mPlatform, General, "WireServer::HandledCommands",
+                             handledCommandCount);
 
         if (size != 0) {
             return nullptr;
@@ -76,6 +76,16 @@ bool ProcTableAsClass::DevicePopErrorScope(WGPUDevice self,
     return OnDevicePopErrorScopeCallback(self, callback, userdata);
 }
 
+void ProcTableAsClass::DeviceGetStatistics(WGPUDevice self,
+                                           WGPUDeviceStatisticsCallback callback,
+                                           void* userdata) {
+    auto object = reinterpret_cast<ProcTableAsClass::Object*>(self);
+    object->deviceStatisticsCallback = callback;
+    object->userdata = userdata;
+
+    OnDeviceGetStatisticsCallback(self, callback, userdata);
+}
+
 void ProcTableAsClass::BufferMapReadAsync(WGPUBuffer self,
                                           WGPUBufferMapReadCallback callback,
                                           void* userdata) {
@@ -107,6 +117,53 @@ void ProcTableAsClass::FenceOnCompletion(WGPUFence self,
     OnFenceOnCompletionCallback(self, value, callback, userdata);
 }
 
+void ProcTableAsClass::RayTracingAccelerationContainerGetCompactedSizeAsync(
+    WGPURayTracingAccelerationContainer self,
+    WGPURayTracingAccelerationContainerCompactedSizeCallback callback,
+    void* userdata) {
+    auto object = reinterpret_cast<ProcTableAsClass::Object*>(self);
+    object->compactedSizeCallback = callback;
+    object->userdata = userdata;
+
+    OnRayTracingAccelerationContainerGetCompactedSizeAsyncCallback(self, callback, userdata);
+}
+
+void ProcTableAsClass::DeviceCreateComputePipelineAsync(
+    WGPUDevice self,
+    WGPUComputePipelineDescriptor const* descriptor,
+    WGPUCreateComputePipelineAsyncCallback callback,
+    void* userdata) {
+    auto object = reinterpret_cast<ProcTableAsClass::Object*>(self);
+    object->createComputePipelineAsyncCallback = callback;
+    object->userdata = userdata;
+
+    OnDeviceCreateComputePipelineAsyncCallback(self, descriptor, callback, userdata);
+}
+
+void ProcTableAsClass::DeviceCreateRenderPipelineAsync(
+    WGPUDevice self,
+    WGPURenderPipelineDescriptor const* descriptor,
+    WGPUCreateRenderPipelineAsyncCallback callback,
+    void* userdata) {
+    auto object = reinterpret_cast<ProcTableAsClass::Object*>(self);
+    object->createRenderPipelineAsyncCallback = callback;
+    object->userdata = userdata;
+
+    OnDeviceCreateRenderPipelineAsyncCallback(self, descriptor, callback, userdata);
+}
+
+void ProcTableAsClass::DeviceCreateRayTracingPipelineAsync(
+    WGPUDevice self,
+    WGPURayTracingPipelineDescriptor const* descriptor,
+    WGPUCreateRayTracingPipelineAsyncCallback callback,
+    void* userdata) {
+    auto object = reinterpret_cast<ProcTableAsClass::Object*>(self);
+    object->createRayTracingPipelineAsyncCallback = callback;
+    object->userdata = userdata;
+
+    OnDeviceCreateRayTracingPipelineAsyncCallback(self, descriptor, callback, userdata);
+}
+
 void ProcTableAsClass::CallDeviceErrorCallback(WGPUDevice device,
                                                WGPUErrorType type,
                                                const char* message) {
@@ -119,6 +176,13 @@ void ProcTableAsClass::CallDeviceLostCallback(WGPUDevice device, const char* mes
     object->deviceLostCallback(message, object->userdata);
 }
 
+void ProcTableAsClass::CallDeviceStatisticsCallback(WGPUDevice device,
+                                                    WGPUDeviceStatisticsStatus status,
+                                                    const WGPUDeviceStatistics* statistics) {
+    auto object = reinterpret_cast<ProcTableAsClass::Object*>(device);
+    object->deviceStatisticsCallback(status, statistics, object->userdata);
+}
+
 void ProcTableAsClass::CallMapReadCallback(WGPUBuffer buffer,
                                            WGPUBufferMapAsyncStatus status,
                                            const void* data,
@@ -141,6 +205,41 @@ void ProcTableAsClass::CallFenceOnCompletionCallback(WGPUFence fence,
     object->fenceOnCompletionCallback(status, object->userdata);
 }
 
+void ProcTableAsClass::CallCompactedSizeCallback(
+    WGPURayTracingAccelerationContainer container,
+    WGPURayTracingAccelerationContainerCompactedSizeStatus status,
+    uint64_t compactedSize) {
+    auto object = reinterpret_cast<ProcTableAsClass::Object*>(container);
+    object->compactedSizeCallback(status, compactedSize, object->userdata);
+}
+
+void ProcTableAsClass::CallDeviceCreateComputePipelineAsyncCallback(
+    WGPUDevice device,
+    WGPUCreatePipelineAsyncStatus status,
+    WGPUComputePipeline pipeline,
+    const char* message) {
+    auto object = reinterpret_cast<ProcTableAsClass::Object*>(device);
+    object->createComputePipelineAsyncCallback(status, pipeline, message, object->userdata);
+}
+
+void ProcTableAsClass::CallDeviceCreateRenderPipelineAsyncCallback(
+    WGPUDevice device,
+    WGPUCreatePipelineAsyncStatus status,
+    WGPURenderPipeline pipeline,
+    const char* message) {
+    auto object = reinterpret_cast<ProcTableAsClass::Object*>(device);
+    object->createRenderPipelineAsyncCallback(status, pipeline, message, object->userdata);
+}
+
+void ProcTableAsClass::CallDeviceCreateRayTracingPipelineAsyncCallback(
+    WGPUDevice device,
+    WGPUCreatePipelineAsyncStatus status,
+    WGPURayTracingPipeline pipeline,
+    const char* message) {
+    auto object = reinterpret_cast<ProcTableAsClass::Object*>(device);
+    object->createRayTracingPipelineAsyncCallback(status, pipeline, message, object->userdata);
+}
+
 {% for type in by_category["object"] %}
     {{as_cType(type.name)}} ProcTableAsClass::GetNew{{type.name.CamelCase()}}() {
         mObjects.emplace_back(new Object);
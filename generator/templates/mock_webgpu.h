@@ -59,6 +59,9 @@ class ProcTableAsClass {
                                          WGPUDeviceLostCallback callback,
                                          void* userdata);
         bool DevicePopErrorScope(WGPUDevice self, WGPUErrorCallback callback, void* userdata);
+        void DeviceGetStatistics(WGPUDevice self,
+                                 WGPUDeviceStatisticsCallback callback,
+                                 void* userdata);
         void BufferMapReadAsync(WGPUBuffer self,
                                 WGPUBufferMapReadCallback callback,
                                 void* userdata);
@@ -69,6 +72,22 @@ class ProcTableAsClass {
                                uint64_t value,
                                WGPUFenceOnCompletionCallback callback,
                                void* userdata);
+        void RayTracingAccelerationContainerGetCompactedSizeAsync(
+            WGPURayTracingAccelerationContainer self,
+            WGPURayTracingAccelerationContainerCompactedSizeCallback callback,
+            void* userdata);
+        void DeviceCreateComputePipelineAsync(WGPUDevice self,
+                                              WGPUComputePipelineDescriptor const* descriptor,
+                                              WGPUCreateComputePipelineAsyncCallback callback,
+                                              void* userdata);
+        void DeviceCreateRenderPipelineAsync(WGPUDevice self,
+                                             WGPURenderPipelineDescriptor const* descriptor,
+                                             WGPUCreateRenderPipelineAsyncCallback callback,
+                                             void* userdata);
+        void DeviceCreateRayTracingPipelineAsync(WGPUDevice self,
+                                                 WGPURayTracingPipelineDescriptor const* descriptor,
+                                                 WGPUCreateRayTracingPipelineAsyncCallback callback,
+                                                 void* userdata);
 
         // Special cased mockable methods
         virtual void OnDeviceSetUncapturedErrorCallback(WGPUDevice device,
@@ -80,6 +99,9 @@ class ProcTableAsClass {
         virtual bool OnDevicePopErrorScopeCallback(WGPUDevice device,
                                               WGPUErrorCallback callback,
                                               void* userdata) = 0;
+        virtual void OnDeviceGetStatisticsCallback(WGPUDevice device,
+                                                   WGPUDeviceStatisticsCallback callback,
+                                                   void* userdata) = 0;
         virtual void OnBufferMapReadAsyncCallback(WGPUBuffer buffer,
                                                   WGPUBufferMapReadCallback callback,
                                                   void* userdata) = 0;
@@ -90,21 +112,63 @@ class ProcTableAsClass {
                                                  uint64_t value,
                                                  WGPUFenceOnCompletionCallback callback,
                                                  void* userdata) = 0;
+        virtual void OnRayTracingAccelerationContainerGetCompactedSizeAsyncCallback(
+            WGPURayTracingAccelerationContainer container,
+            WGPURayTracingAccelerationContainerCompactedSizeCallback callback,
+            void* userdata) = 0;
+        virtual void OnDeviceCreateComputePipelineAsyncCallback(
+            WGPUDevice device,
+            WGPUComputePipelineDescriptor const* descriptor,
+            WGPUCreateComputePipelineAsyncCallback callback,
+            void* userdata) = 0;
+        virtual void OnDeviceCreateRenderPipelineAsyncCallback(
+            WGPUDevice device,
+            WGPURenderPipelineDescriptor const* descriptor,
+            WGPUCreateRenderPipelineAsyncCallback callback,
+            void* userdata) = 0;
+        virtual void OnDeviceCreateRayTracingPipelineAsyncCallback(
+            WGPUDevice device,
+            WGPURayTracingPipelineDescriptor const* descriptor,
+            WGPUCreateRayTracingPipelineAsyncCallback callback,
+            void* userdata) = 0;
 
         // Calls the stored callbacks
         void CallDeviceErrorCallback(WGPUDevice device, WGPUErrorType type, const char* message);
         void CallDeviceLostCallback(WGPUDevice device, const char* message);
+        void CallDeviceStatisticsCallback(WGPUDevice device,
+                                          WGPUDeviceStatisticsStatus status,
+                                          const WGPUDeviceStatistics* statistics);
         void CallMapReadCallback(WGPUBuffer buffer, WGPUBufferMapAsyncStatus status, const void* data, uint64_t dataLength);
         void CallMapWriteCallback(WGPUBuffer buffer, WGPUBufferMapAsyncStatus status, void* data, uint64_t dataLength);
         void CallFenceOnCompletionCallback(WGPUFence fence, WGPUFenceCompletionStatus status);
+        void CallCompactedSizeCallback(WGPURayTracingAccelerationContainer container,
+                                       WGPURayTracingAccelerationContainerCompactedSizeStatus status,
+                                       uint64_t compactedSize);
+        void CallDeviceCreateComputePipelineAsyncCallback(WGPUDevice device,
+                                                          WGPUCreatePipelineAsyncStatus status,
+                                                          WGPUComputePipeline pipeline,
+                                                          const char* message);
+        void CallDeviceCreateRenderPipelineAsyncCallback(WGPUDevice device,
+                                                         WGPUCreatePipelineAsyncStatus status,
+                                                         WGPURenderPipeline pipeline,
+                                                         const char* message);
+        void CallDeviceCreateRayTracingPipelineAsyncCallback(WGPUDevice device,
+                                                             WGPUCreatePipelineAsyncStatus status,
+                                                             WGPURayTracingPipeline pipeline,
+                                                             const char* message);
 
         struct Object {
             ProcTableAsClass* procs = nullptr;
             WGPUErrorCallback deviceErrorCallback = nullptr;
             WGPUDeviceLostCallback deviceLostCallback = nullptr;
+            WGPUDeviceStatisticsCallback deviceStatisticsCallback = nullptr;
             WGPUBufferMapReadCallback mapReadCallback = nullptr;
             WGPUBufferMapWriteCallback mapWriteCallback = nullptr;
             WGPUFenceOnCompletionCallback fenceOnCompletionCallback = nullptr;
+            WGPURayTracingAccelerationContainerCompactedSizeCallback compactedSizeCallback = nullptr;
+            WGPUCreateComputePipelineAsyncCallback createComputePipelineAsyncCallback = nullptr;
+            WGPUCreateRenderPipelineAsyncCallback createRenderPipelineAsyncCallback = nullptr;
+            WGPUCreateRayTracingPipelineAsyncCallback createRayTracingPipelineAsyncCallback = nullptr;
             void* userdata = 0;
         };
 
@@ -138,9 +202,14 @@ class MockProcTable : public ProcTableAsClass {
         MOCK_METHOD(void, OnDeviceSetUncapturedErrorCallback, (WGPUDevice device, WGPUErrorCallback callback, void* userdata), (override));
         MOCK_METHOD(void, OnDeviceSetDeviceLostCallback, (WGPUDevice device, WGPUDeviceLostCallback callback, void* userdata), (override));
         MOCK_METHOD(bool, OnDevicePopErrorScopeCallback, (WGPUDevice device, WGPUErrorCallback callback, void* userdata), (override));
+        MOCK_METHOD(void, OnDeviceGetStatisticsCallback, (WGPUDevice device, WGPUDeviceStatisticsCallback callback, void* userdata), (override));
         MOCK_METHOD(void, OnBufferMapReadAsyncCallback, (WGPUBuffer buffer, WGPUBufferMapReadCallback callback, void* userdata), (override));
         MOCK_METHOD(void, OnBufferMapWriteAsyncCallback, (WGPUBuffer buffer, WGPUBufferMapWriteCallback callback, void* userdata), (override));
         MOCK_METHOD(void, OnFenceOnCompletionCallback, (WGPUFence fence, uint64_t value, WGPUFenceOnCompletionCallback callback, void* userdata), (override));
+        MOCK_METHOD(void, OnRayTracingAccelerationContainerGetCompactedSizeAsyncCallback, (WGPURayTracingAccelerationContainer container, WGPURayTracingAccelerationContainerCompactedSizeCallback callback, void* userdata), (override));
+        MOCK_METHOD(void, OnDeviceCreateComputePipelineAsyncCallback, (WGPUDevice device, WGPUComputePipelineDescriptor const* descriptor, WGPUCreateComputePipelineAsyncCallback callback, void* userdata), (override));
+        MOCK_METHOD(void, OnDeviceCreateRenderPipelineAsyncCallback, (WGPUDevice device, WGPURenderPipelineDescriptor const* descriptor, WGPUCreateRenderPipelineAsyncCallback callback, void* userdata), (override));
+        MOCK_METHOD(void, OnDeviceCreateRayTracingPipelineAsyncCallback, (WGPUDevice device, WGPURayTracingPipelineDescriptor const* descriptor, WGPUCreateRayTracingPipelineAsyncCallback callback, void* userdata), (override));
 };
 
 #endif  // MOCK_WEBGPU_H
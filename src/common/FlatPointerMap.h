@@ -0,0 +1,228 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef COMMON_FLATPOINTERMAP_H_
+#define COMMON_FLATPOINTERMAP_H_
+
+#include "common/Assert.h"
+#include "common/Platform.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+// FlatPointerSet and FlatPointerMap are sets and maps keyed by pointers, used in hot paths that
+// add a lot of keys and only iterate over them once, like the tracking of the resources used in
+// a command buffer.
+//
+// Keys (and values) are stored contiguously in insertion order so that iterating over them is
+// cheap and so that they can be moved out of the container without copies. Looking up a key uses
+// an open-addressing hash table of indices into the keys with linear probing. Small containers
+// don't have a hash table at all and look up keys with a linear search, so most of them don't
+// allocate more than the vector of keys.
+//
+// Keys can't be removed, other than by clearing the whole container.
+template <typename T>
+class FlatPointerSet {
+  public:
+    using ConstIterator = typename std::vector<T*>::const_iterator;
+
+    // Adds |key| to the set if it isn't already in it. Returns the index of |key| in the
+    // insertion order, and whether it was added to the set.
+    std::pair<size_t, bool> Insert(T* key) {
+        ASSERT(key != nullptr);
+        if (mSlots.empty()) {
+            for (size_t i = 0; i < mKeys.size(); ++i) {
+                if (mKeys[i] == key) {
+                    return {i, false};
+                }
+            }
+
+            mKeys.push_back(key);
+            if (mKeys.size() > kMaxLinearSearchSize) {
+                Rehash(kMaxLinearSearchSize * 4);
+            }
+            return {mKeys.size() - 1, true};
+        }
+
+        size_t slot = FindSlot(key);
+        if (mSlots[slot] != kEmptySlot) {
+            return {mSlots[slot], false};
+        }
+
+        size_t index = mKeys.size();
+        ASSERT(index < kEmptySlot);
+        mKeys.push_back(key);
+        mSlots[slot] = static_cast<uint32_t>(index);
+
+        // Keep the load factor under 1/2 so that probe sequences stay short.
+        if (mKeys.size() * 2 > mSlots.size()) {
+            Rehash(mSlots.size() * 2);
+        }
+        return {index, true};
+    }
+
+    template <typename Iterator>
+    void Insert(Iterator begin, Iterator end) {
+        for (Iterator it = begin; it != end; ++it) {
+            Insert(*it);
+        }
+    }
+
+    bool Contains(T* key) const {
+        if (mSlots.empty()) {
+            for (T* k : mKeys) {
+                if (k == key) {
+                    return true;
+                }
+            }
+            return false;
+        }
+        return mSlots[FindSlot(key)] != kEmptySlot;
+    }
+
+    size_t Size() const {
+        return mKeys.size();
+    }
+
+    bool Empty() const {
+        return mKeys.empty();
+    }
+
+    // Returns the keys in insertion order.
+    const std::vector<T*>& GetKeys() const {
+        return mKeys;
+    }
+
+    // Moves the keys out of the set, leaving it empty.
+    std::vector<T*> AcquireKeys() {
+        std::vector<T*> keys = std::move(mKeys);
+        Clear();
+        return keys;
+    }
+
+    void Clear() {
+        mKeys.clear();
+        mSlots.clear();
+    }
+
+    ConstIterator begin() const {
+        return mKeys.begin();
+    }
+
+    ConstIterator end() const {
+        return mKeys.end();
+    }
+
+  private:
+    static constexpr size_t kMaxLinearSearchSize = 8;
+    static constexpr uint32_t kEmptySlot = std::numeric_limits<uint32_t>::max();
+
+    // Pointers have their low bits set to zero because of alignment, so they are mixed with a
+    // multiplication before being masked with the size of the table.
+    static size_t HashPointer(T* key) {
+        size_t value = reinterpret_cast<uintptr_t>(key);
+#if defined(DAWN_PLATFORM_64_BIT)
+        value *= 0x9e3779b97f4a7c15;
+        return value ^ (value >> 32);
+#elif defined(DAWN_PLATFORM_32_BIT)
+        value *= 0x9e3779b9;
+        return value ^ (value >> 16);
+#else
+#    error "Unsupported platform"
+#endif
+    }
+
+    // Returns the slot containing |key|, or the empty slot where it should be inserted.
+    size_t FindSlot(T* key) const {
+        ASSERT(!mSlots.empty());
+        size_t mask = mSlots.size() - 1;
+        size_t slot = HashPointer(key) & mask;
+        while (mSlots[slot] != kEmptySlot && mKeys[mSlots[slot]] != key) {
+            slot = (slot + 1) & mask;
+        }
+        return slot;
+    }
+
+    void Rehash(size_t slotCount) {
+        ASSERT((slotCount & (slotCount - 1)) == 0);
+        mSlots.assign(slotCount, kEmptySlot);
+        for (size_t i = 0; i < mKeys.size(); ++i) {
+            mSlots[FindSlot(mKeys[i])] = static_cast<uint32_t>(i);
+        }
+    }
+
+    std::vector<T*> mKeys;
+    std::vector<uint32_t> mSlots;
+};
+
+template <typename T>
+constexpr size_t FlatPointerSet<T>::kMaxLinearSearchSize;
+template <typename T>
+constexpr uint32_t FlatPointerSet<T>::kEmptySlot;
+
+// A map from pointers to values stored in a FlatPointerSet and a parallel vector of values.
+template <typename K, typename V>
+class FlatPointerMap {
+  public:
+    // Returns the value for |key|, adding a value-initialized one if |key| wasn't in the map.
+    V& operator[](K* key) {
+        std::pair<size_t, bool> result = mKeys.Insert(key);
+        if (result.second) {
+            mValues.emplace_back();
+        }
+        return mValues[result.first];
+    }
+
+    bool Contains(K* key) const {
+        return mKeys.Contains(key);
+    }
+
+    size_t Size() const {
+        return mKeys.Size();
+    }
+
+    bool Empty() const {
+        return mKeys.Empty();
+    }
+
+    // Keys and values in insertion order, GetValues()[i] is the value of GetKeys()[i].
+    const std::vector<K*>& GetKeys() const {
+        return mKeys.GetKeys();
+    }
+
+    const std::vector<V>& GetValues() const {
+        return mValues;
+    }
+
+    // Moves the keys and values out of the map, leaving it empty.
+    void Acquire(std::vector<K*>* keys, std::vector<V>* values) {
+        *keys = mKeys.AcquireKeys();
+        *values = std::move(mValues);
+        mValues.clear();
+    }
+
+    void Clear() {
+        mKeys.Clear();
+        mValues.clear();
+    }
+
+  private:
+    FlatPointerSet<K> mKeys;
+    std::vector<V> mValues;
+};
+
+#endif  // COMMON_FLATPOINTERMAP_H_
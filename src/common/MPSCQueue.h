@@ -0,0 +1,143 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef COMMON_MPSCQUEUE_H_
+#define COMMON_MPSCQUEUE_H_
+
+#include <atomic>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// MPSCQueue is a multiple-producer single-consumer queue: values can be pushed from any thread
+// without locks, and a single thread at a time drains all the values pushed so far.
+//
+// Values are pushed on a linked list with a compare-and-swap on its head, and draining takes the
+// whole list with a single exchange so producers and the consumer never wait on each other. The
+// drained list is reversed to hand out the values in the order they were pushed.
+//
+// Drained nodes are recycled instead of deleted: the consumer pushes them on a free list, that
+// producers take whole, with a single exchange, into a cache of their thread. Producers never pop
+// single nodes from a shared list so this is free of ABA problems, and after warming up pushes
+// don't allocate.
+template <typename T>
+class MPSCQueue {
+  public:
+    MPSCQueue() = default;
+    MPSCQueue(const MPSCQueue&) = delete;
+    MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+    ~MPSCQueue() {
+        Drain([](T) {});
+        DeleteNodes(mFreeNodes.exchange(nullptr, std::memory_order_acquire));
+    }
+
+    // Can be called from any thread.
+    void Push(T value) {
+        Node* node = AcquireNode();
+        new (&node->storage) T(std::move(value));
+        node->next = mHead.load(std::memory_order_relaxed);
+        while (!mHead.compare_exchange_weak(node->next, node, std::memory_order_release,
+                                            std::memory_order_relaxed)) {
+        }
+    }
+
+    // Removes all the values pushed so far and calls |callback| on them in push order. Values
+    // pushed concurrently are either part of this drain or left for the next one. Must not be
+    // called concurrently with itself.
+    template <typename Callback>
+    void Drain(Callback callback) {
+        Node* node = mHead.exchange(nullptr, std::memory_order_acquire);
+        if (node == nullptr) {
+            return;
+        }
+
+        Node* reversed = nullptr;
+        Node* last = node;
+        while (node != nullptr) {
+            Node* next = node->next;
+            node->next = reversed;
+            reversed = node;
+            node = next;
+        }
+
+        for (node = reversed; node != nullptr; node = node->next) {
+            T* value = node->GetValue();
+            callback(std::move(*value));
+            value->~T();
+        }
+
+        last->next = mFreeNodes.load(std::memory_order_relaxed);
+        while (!mFreeNodes.compare_exchange_weak(last->next, reversed, std::memory_order_release,
+                                                 std::memory_order_relaxed)) {
+        }
+    }
+
+    // Only a hint when other threads push concurrently.
+    bool Empty() const {
+        return mHead.load(std::memory_order_relaxed) == nullptr;
+    }
+
+  private:
+    struct Node {
+        T* GetValue() {
+            return reinterpret_cast<T*>(&storage);
+        }
+
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+        Node* next;
+    };
+
+    // The nodes a thread took from the free list of a queue and didn't use yet. Nodes don't hold
+    // values while they are free so they can be used by any queue of the same type.
+    struct NodeCache {
+        ~NodeCache() {
+            DeleteNodes(nodes);
+        }
+
+        Node* nodes = nullptr;
+    };
+
+    static NodeCache* GetThreadNodeCache() {
+        static thread_local NodeCache cache;
+        return &cache;
+    }
+
+    static void DeleteNodes(Node* node) {
+        while (node != nullptr) {
+            Node* next = node->next;
+            delete node;
+            node = next;
+        }
+    }
+
+    Node* AcquireNode() {
+        NodeCache* cache = GetThreadNodeCache();
+        if (cache->nodes == nullptr) {
+            cache->nodes = mFreeNodes.exchange(nullptr, std::memory_order_acquire);
+            if (cache->nodes == nullptr) {
+                return new Node;
+            }
+        }
+
+        Node* node = cache->nodes;
+        cache->nodes = node->next;
+        return node;
+    }
+
+    std::atomic<Node*> mHead{nullptr};
+    std::atomic<Node*> mFreeNodes{nullptr};
+};
+
+#endif  // COMMON_MPSCQUEUE_H_
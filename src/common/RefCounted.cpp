@@ -49,6 +49,19 @@ void RefCounted::Reference() {
     mRefCount.fetch_add(kRefCountIncrement, std::memory_order_relaxed);
 }
 
+bool RefCounted::TryReference() {
+    // Relaxed ordering is enough for the same reason as in Reference(): the caller makes sure
+    // the memory of the object stays valid while it tries to reference it.
+    uint64_t refCount = mRefCount.load(std::memory_order_relaxed);
+    while ((refCount & ~kPayloadMask) != 0) {
+        if (mRefCount.compare_exchange_weak(refCount, refCount + kRefCountIncrement,
+                                            std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void RefCounted::Release() {
     ASSERT((mRefCount & ~kPayloadMask) != 0);
 
@@ -29,6 +29,10 @@ class RefCounted {
     void Reference();
     void Release();
 
+    // Adds a reference unless the object is already being deleted, for example when another
+    // thread can find it in a cache that doesn't hold references.
+    bool TryReference();
+
   protected:
     virtual ~RefCounted() = default;
     // A Derived class may override this if they require a custom deleter.
@@ -15,9 +15,11 @@
 #ifndef COMMON_SERIALMAP_H_
 #define COMMON_SERIALMAP_H_
 
+#include "common/SerialRingBuffer.h"
 #include "common/SerialStorage.h"
 
-#include <map>
+#include <iterator>
+#include <utility>
 #include <vector>
 
 template <typename T>
@@ -26,7 +28,7 @@ class SerialMap;
 template <typename T>
 struct SerialStorageTraits<SerialMap<T>> {
     using Value = T;
-    using Storage = std::map<Serial, std::vector<T>>;
+    using Storage = SerialRingBuffer<T>;
     using StorageIterator = typename Storage::iterator;
     using ConstStorageIterator = typename Storage::const_iterator;
 };
@@ -35,6 +37,9 @@ struct SerialStorageTraits<SerialMap<T>> {
 // Unlike SerialQueue, items may be enqueued with Serials in any
 // arbitrary order. SerialMap provides useful iterators for iterating
 // through T items in order of increasing Serial.
+// Items are kept sorted in the same storage as SerialQueue, so enqueuing
+// items in increasing Serial order, the common case, is as cheap as for
+// SerialQueue, and enqueuing out of order costs a move per Serial after it.
 template <typename T>
 class SerialMap : public SerialStorage<SerialMap<T>> {
   public:
@@ -42,34 +47,61 @@ class SerialMap : public SerialStorage<SerialMap<T>> {
     void Enqueue(T&& value, Serial serial);
     void Enqueue(const std::vector<T>& values, Serial serial);
     void Enqueue(std::vector<T>&& values, Serial serial);
+
+  private:
+    // Returns the values for |serial|, adding an empty vector at the right position if there
+    // were no values for it.
+    std::vector<T>& GetValues(Serial serial);
 };
 
 // SerialMap
 
 template <typename T>
 void SerialMap<T>::Enqueue(const T& value, Serial serial) {
-    this->mStorage[serial].emplace_back(value);
+    GetValues(serial).push_back(value);
 }
 
 template <typename T>
 void SerialMap<T>::Enqueue(T&& value, Serial serial) {
-    this->mStorage[serial].emplace_back(value);
+    GetValues(serial).push_back(std::move(value));
 }
 
 template <typename T>
 void SerialMap<T>::Enqueue(const std::vector<T>& values, Serial serial) {
     DAWN_ASSERT(values.size() > 0);
-    for (const T& value : values) {
-        Enqueue(value, serial);
-    }
+    std::vector<T>& storedValues = GetValues(serial);
+    storedValues.insert(storedValues.end(), values.begin(), values.end());
 }
 
 template <typename T>
 void SerialMap<T>::Enqueue(std::vector<T>&& values, Serial serial) {
     DAWN_ASSERT(values.size() > 0);
-    for (const T& value : values) {
-        Enqueue(value, serial);
+    std::vector<T>& storedValues = GetValues(serial);
+    storedValues.insert(storedValues.end(), std::make_move_iterator(values.begin()),
+                        std::make_move_iterator(values.end()));
+}
+
+template <typename T>
+std::vector<T>& SerialMap<T>::GetValues(Serial serial) {
+    auto& storage = this->mStorage;
+
+    // Look for the position of |serial| from the back since serials are usually enqueued in
+    // increasing order.
+    size_t index = storage.size();
+    while (index > 0 && storage[index - 1].first > serial) {
+        index--;
+    }
+    if (index > 0 && storage[index - 1].first == serial) {
+        return storage[index - 1].second;
+    }
+
+    // Append a pair and bubble it down to its position. Swapping keeps the memory of the
+    // vectors in the ring buffer.
+    storage.emplace_back(serial);
+    for (size_t i = storage.size() - 1; i > index; --i) {
+        std::swap(storage[i], storage[i - 1]);
     }
+    return storage[index].second;
 }
 
 #endif  // COMMON_SERIALMAP_H_
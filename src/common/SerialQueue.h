@@ -15,8 +15,10 @@
 #ifndef COMMON_SERIALQUEUE_H_
 #define COMMON_SERIALQUEUE_H_
 
+#include "common/SerialRingBuffer.h"
 #include "common/SerialStorage.h"
 
+#include <iterator>
 #include <vector>
 
 template <typename T>
@@ -26,7 +28,7 @@ template <typename T>
 struct SerialStorageTraits<SerialQueue<T>> {
     using Value = T;
     using SerialPair = std::pair<Serial, std::vector<T>>;
-    using Storage = std::vector<SerialPair>;
+    using Storage = SerialRingBuffer<T>;
     using StorageIterator = typename Storage::iterator;
     using ConstStorageIterator = typename Storage::const_iterator;
 };
@@ -35,6 +37,8 @@ struct SerialStorageTraits<SerialQueue<T>> {
 // It enforces that the Serials enqueued are strictly non-decreasing.
 // This makes it very efficient iterate or clear all items added up
 // to some Serial value because they are stored contiguously in memory.
+// The storage of cleared items is reused so that a queue that is enqueued to
+// and cleared at a steady rate, like per-frame deletion queues, doesn't allocate.
 template <typename T>
 class SerialQueue : public SerialStorage<SerialQueue<T>> {
   public:
@@ -54,7 +58,7 @@ void SerialQueue<T>::Enqueue(const T& value, Serial serial) {
     DAWN_ASSERT(this->Empty() || this->mStorage.back().first <= serial);
 
     if (this->Empty() || this->mStorage.back().first < serial) {
-        this->mStorage.emplace_back(serial, std::vector<T>{});
+        this->mStorage.emplace_back(serial);
     }
     this->mStorage.back().second.push_back(value);
 }
@@ -64,7 +68,7 @@ void SerialQueue<T>::Enqueue(T&& value, Serial serial) {
     DAWN_ASSERT(this->Empty() || this->mStorage.back().first <= serial);
 
     if (this->Empty() || this->mStorage.back().first < serial) {
-        this->mStorage.emplace_back(serial, std::vector<T>{});
+        this->mStorage.emplace_back(serial);
     }
     this->mStorage.back().second.push_back(std::move(value));
 }
@@ -73,14 +77,25 @@ template <typename T>
 void SerialQueue<T>::Enqueue(const std::vector<T>& values, Serial serial) {
     DAWN_ASSERT(values.size() > 0);
     DAWN_ASSERT(this->Empty() || this->mStorage.back().first <= serial);
-    this->mStorage.emplace_back(serial, values);
+
+    if (this->Empty() || this->mStorage.back().first < serial) {
+        this->mStorage.emplace_back(serial);
+    }
+    std::vector<T>& storedValues = this->mStorage.back().second;
+    storedValues.insert(storedValues.end(), values.begin(), values.end());
 }
 
 template <typename T>
 void SerialQueue<T>::Enqueue(std::vector<T>&& values, Serial serial) {
     DAWN_ASSERT(values.size() > 0);
     DAWN_ASSERT(this->Empty() || this->mStorage.back().first <= serial);
-    this->mStorage.emplace_back(serial, values);
+
+    if (this->Empty() || this->mStorage.back().first < serial) {
+        this->mStorage.emplace_back(serial);
+    }
+    std::vector<T>& storedValues = this->mStorage.back().second;
+    storedValues.insert(storedValues.end(), std::make_move_iterator(values.begin()),
+                        std::make_move_iterator(values.end()));
 }
 
 #endif  // COMMON_SERIALQUEUE_H_
@@ -0,0 +1,171 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef COMMON_SERIALRINGBUFFER_H_
+#define COMMON_SERIALRINGBUFFER_H_
+
+#include "common/Assert.h"
+#include "common/Serial.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// SerialRingBuffer is the storage of SerialQueue and SerialMap: a list of (Serial, values) pairs
+// sorted by serial, that is appended to at the back and retired from the front.
+//
+// The pairs are stored in a ring buffer that only grows, and the vectors of values of retired
+// pairs are cleared but not freed so that the next pairs reuse their memory. Once the buffer and
+// the vectors are large enough for the number of serials in flight, enqueuing and retiring
+// values don't allocate memory.
+//
+// The interface is the subset of the std::vector interface that SerialStorage uses.
+template <typename T>
+class SerialRingBuffer {
+  public:
+    using SerialPair = std::pair<Serial, std::vector<T>>;
+
+    template <typename Ring, typename Pair>
+    class IteratorBase {
+      public:
+        IteratorBase(Ring* ring, size_t index) : mRing(ring), mIndex(index) {
+        }
+
+        IteratorBase& operator++() {
+            mIndex++;
+            return *this;
+        }
+        IteratorBase operator++(int) {
+            IteratorBase it = *this;
+            mIndex++;
+            return it;
+        }
+
+        bool operator==(const IteratorBase& other) const {
+            return mIndex == other.mIndex;
+        }
+        bool operator!=(const IteratorBase& other) const {
+            return mIndex != other.mIndex;
+        }
+
+        Pair& operator*() const {
+            return (*mRing)[mIndex];
+        }
+        Pair* operator->() const {
+            return &(*mRing)[mIndex];
+        }
+
+      private:
+        friend class SerialRingBuffer;
+
+        Ring* mRing;
+        // The index relative to the front of the ring.
+        size_t mIndex;
+    };
+
+    using iterator = IteratorBase<SerialRingBuffer, SerialPair>;
+    using const_iterator = IteratorBase<const SerialRingBuffer, const SerialPair>;
+
+    bool empty() const {
+        return mSize == 0;
+    }
+
+    size_t size() const {
+        return mSize;
+    }
+
+    SerialPair& operator[](size_t index) {
+        ASSERT(index < mSize);
+        return mSlots[(mFront + index) & (mSlots.size() - 1)];
+    }
+
+    const SerialPair& operator[](size_t index) const {
+        ASSERT(index < mSize);
+        return mSlots[(mFront + index) & (mSlots.size() - 1)];
+    }
+
+    SerialPair& back() {
+        return (*this)[mSize - 1];
+    }
+
+    const SerialPair& back() const {
+        return (*this)[mSize - 1];
+    }
+
+    iterator begin() {
+        return {this, 0};
+    }
+    iterator end() {
+        return {this, mSize};
+    }
+    const_iterator begin() const {
+        return {this, 0};
+    }
+    const_iterator end() const {
+        return {this, mSize};
+    }
+
+    // Appends a pair with |serial| and an empty vector of values, that may have capacity left
+    // from a retired pair.
+    SerialPair& emplace_back(Serial serial) {
+        if (mSize == mSlots.size()) {
+            Grow();
+        }
+        mSize++;
+        SerialPair& pair = back();
+        ASSERT(pair.second.empty());
+        pair.first = serial;
+        return pair;
+    }
+
+    // Only the pairs at the front of the ring can be erased.
+    void erase(iterator first, iterator last) {
+        ASSERT(first.mIndex == 0);
+        for (iterator it = first; it != last; ++it) {
+            it->second.clear();
+        }
+        mFront = (mFront + last.mIndex) & (mSlots.size() - 1);
+        mSize -= last.mIndex;
+    }
+
+    void clear() {
+        erase(begin(), end());
+        mFront = 0;
+    }
+
+  private:
+    static constexpr size_t kInitialSlotCount = 4;
+
+    // Doubles the number of slots when the ring is full, moving the pairs in order to the front
+    // of the new slots.
+    void Grow() {
+        std::vector<SerialPair> slots(std::max(mSlots.size() * 2, kInitialSlotCount));
+        for (size_t i = 0; i < mSlots.size(); ++i) {
+            slots[i] = std::move(mSlots[(mFront + i) & (mSlots.size() - 1)]);
+        }
+        mSlots = std::move(slots);
+        mFront = 0;
+    }
+
+    // The number of slots is always zero or a power of two.
+    std::vector<SerialPair> mSlots;
+    size_t mFront = 0;
+    size_t mSize = 0;
+};
+
+template <typename T>
+constexpr size_t SerialRingBuffer<T>::kInitialSlotCount;
+
+#endif  // COMMON_SERIALRINGBUFFER_H_
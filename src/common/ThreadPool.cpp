@@ -0,0 +1,154 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/ThreadPool.h"
+
+#include "common/Assert.h"
+
+#include <algorithm>
+
+namespace {
+
+    // The pool and worker index of the current thread, if it is a worker of a pool.
+    thread_local const ThreadPool* tCurrentPool = nullptr;
+    thread_local uint32_t tCurrentWorkerIndex = 0;
+
+}  // anonymous namespace
+
+ThreadPool::ThreadPool(uint32_t workerCount) {
+    // One queue per worker plus the shared queue for external threads.
+    for (uint32_t i = 0; i < workerCount + 1; ++i) {
+        mQueues.push_back(std::make_unique<TaskQueue>());
+    }
+    for (uint32_t i = 0; i < workerCount; ++i) {
+        mWorkers.emplace_back(&ThreadPool::WorkerThread, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+        mStopping = true;
+    }
+    mSleepCondition.notify_all();
+    for (std::thread& worker : mWorkers) {
+        worker.join();
+    }
+
+    // Tasks must all be waited on before the pool is destroyed.
+    ASSERT(mQueuedTaskCount.load() == 0);
+}
+
+uint32_t ThreadPool::GetWorkerCount() const {
+    return static_cast<uint32_t>(mWorkers.size());
+}
+
+void ThreadPool::Spawn(TaskGroup* group, Task task) {
+    group->mPendingTaskCount.fetch_add(1, std::memory_order_relaxed);
+
+    TaskQueue* queue = mQueues[GetCurrentQueueIndex()].get();
+    {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        queue->tasks.push_back({std::move(task), group});
+    }
+
+    // Taking the lock orders the increment with the check of sleeping workers so that the wakeup
+    // can't be missed.
+    {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+        mQueuedTaskCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    mSleepCondition.notify_one();
+}
+
+void ThreadPool::Wait(TaskGroup* group) {
+    uint32_t queueIndex = GetCurrentQueueIndex();
+    while (group->mPendingTaskCount.load(std::memory_order_acquire) != 0) {
+        if (!TryRunTask(queueIndex)) {
+            // The remaining tasks of the group are running on other threads.
+            std::this_thread::yield();
+        }
+    }
+}
+
+void ThreadPool::ParallelFor(uint32_t count,
+                             uint32_t chunkSize,
+                             const std::function<void(uint32_t begin, uint32_t end)>& func) {
+    ASSERT(chunkSize > 0);
+    TaskGroup group;
+    for (uint32_t begin = 0; begin < count; begin += chunkSize) {
+        uint32_t end = begin + std::min(chunkSize, count - begin);
+        Spawn(&group, [&func, begin, end] { func(begin, end); });
+    }
+    Wait(&group);
+}
+
+uint32_t ThreadPool::GetCurrentQueueIndex() const {
+    return tCurrentPool == this ? tCurrentWorkerIndex : GetWorkerCount();
+}
+
+bool ThreadPool::TryRunTask(uint32_t queueIndex) {
+    QueuedTask task;
+    bool found = false;
+
+    // Pop the most recent task of our own queue.
+    {
+        TaskQueue* queue = mQueues[queueIndex].get();
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        if (!queue->tasks.empty()) {
+            task = std::move(queue->tasks.back());
+            queue->tasks.pop_back();
+            found = true;
+        }
+    }
+
+    // Otherwise steal the oldest task of another queue.
+    for (uint32_t i = 1; i < mQueues.size() && !found; ++i) {
+        TaskQueue* queue = mQueues[(queueIndex + i) % mQueues.size()].get();
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        if (!queue->tasks.empty()) {
+            task = std::move(queue->tasks.front());
+            queue->tasks.pop_front();
+            found = true;
+        }
+    }
+
+    if (!found) {
+        return false;
+    }
+
+    mQueuedTaskCount.fetch_sub(1, std::memory_order_relaxed);
+    task.task();
+    task.group->mPendingTaskCount.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+void ThreadPool::WorkerThread(uint32_t workerIndex) {
+    tCurrentPool = this;
+    tCurrentWorkerIndex = workerIndex;
+
+    while (true) {
+        if (TryRunTask(workerIndex)) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(mSleepMutex);
+        mSleepCondition.wait(lock, [this] {
+            return mStopping || mQueuedTaskCount.load(std::memory_order_relaxed) != 0;
+        });
+        if (mStopping) {
+            return;
+        }
+    }
+}
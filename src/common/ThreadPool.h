@@ -0,0 +1,106 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef COMMON_THREADPOOL_H_
+#define COMMON_THREADPOOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A fork-join thread pool with work stealing, meant for CPU-heavy divide-and-conquer work such as
+// building acceleration structures.
+//
+// Every worker thread has its own task deque. Tasks spawned from a worker are pushed at the back
+// of its deque and popped from the back by the same worker so that the most recent (and
+// smallest) tasks run first and stay hot in cache. Idle workers steal the oldest tasks from the
+// front of the other deques, which are the largest subdivisions of the work. Tasks spawned from
+// threads outside of the pool go to a shared deque that all workers steal from.
+//
+// Waiting on a TaskGroup never blocks: the waiting thread runs pending tasks until the group
+// completes. This makes nested Spawn / Wait safe and means a pool with zero workers runs all the
+// work on the thread that waits.
+class ThreadPool {
+  public:
+    using Task = std::function<void()>;
+
+    // Counts the tasks spawned in the group that haven't completed yet.
+    class TaskGroup {
+      public:
+        TaskGroup() = default;
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+      private:
+        friend class ThreadPool;
+        std::atomic<uint32_t> mPendingTaskCount{0};
+    };
+
+    explicit ThreadPool(uint32_t workerCount);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    uint32_t GetWorkerCount() const;
+
+    void Spawn(TaskGroup* group, Task task);
+
+    // Runs tasks of the pool on the calling thread until all the tasks of |group| are complete.
+    void Wait(TaskGroup* group);
+
+    // Calls |func(begin, end)| on chunks of at most |chunkSize| elements covering [0, count) and
+    // waits for all of them to complete.
+    void ParallelFor(uint32_t count,
+                     uint32_t chunkSize,
+                     const std::function<void(uint32_t begin, uint32_t end)>& func);
+
+  private:
+    struct QueuedTask {
+        Task task;
+        TaskGroup* group;
+    };
+
+    struct TaskQueue {
+        std::mutex mutex;
+        std::deque<QueuedTask> tasks;
+    };
+
+    void WorkerThread(uint32_t workerIndex);
+
+    // Returns the queue the calling thread pushes to, which is the shared queue for threads that
+    // are not workers of this pool.
+    uint32_t GetCurrentQueueIndex() const;
+
+    // Pops a task from the queue of the calling thread or steals one from another queue. Returns
+    // false if all the queues are empty.
+    bool TryRunTask(uint32_t queueIndex);
+
+    std::vector<std::unique_ptr<TaskQueue>> mQueues;
+    std::vector<std::thread> mWorkers;
+
+    // Used to put idle workers to sleep.
+    std::mutex mSleepMutex;
+    std::condition_variable mSleepCondition;
+    std::atomic<uint32_t> mQueuedTaskCount{0};
+    bool mStopping = false;
+};
+
+#endif  // COMMON_THREADPOOL_H_
@@ -18,6 +18,7 @@
 #include "common/Constants.h"
 #include "common/Math.h"
 #include "dawn_native/BindGroupLayout.h"
+#include "dawn_native/DeviceStatisticsTracker.h"
 #include "dawn_native/Error.h"
 #include "dawn_native/Forward.h"
 #include "dawn_native/ObjectBase.h"
@@ -79,6 +80,8 @@ namespace dawn_native {
 
         Ref<BindGroupLayoutBase> mLayout;
         BindGroupLayoutBase::BindingDataPointers mBindingData;
+
+        LiveObjectCounter mLiveObjectCounter{this, CountedObjectType::BindGroup};
     };
 
 }  // namespace dawn_native
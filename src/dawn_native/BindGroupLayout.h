@@ -20,6 +20,7 @@
 #include "common/SlabAllocator.h"
 #include "dawn_native/BindingInfo.h"
 #include "dawn_native/CachedObject.h"
+#include "dawn_native/DeviceStatisticsTracker.h"
 #include "dawn_native/Error.h"
 #include "dawn_native/Forward.h"
 
@@ -119,6 +120,8 @@ namespace dawn_native {
 
         // Map from BindGroupLayoutEntry.binding to packed indices.
         BindingMap mBindingMap;
+
+        LiveObjectCounter mLiveObjectCounter{this, CountedObjectType::BindGroupLayout};
     };
 
 }  // namespace dawn_native
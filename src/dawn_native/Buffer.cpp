@@ -269,6 +269,7 @@ namespace dawn_native {
         mMapReadCallback = callback;
         mMapUserdata = userdata;
         mState = BufferState::Mapped;
+        GetDevice()->IncrementResourceStateGeneration();
 
         if (GetDevice()->ConsumedError(MapReadAsyncImpl(mMapSerial))) {
             CallMapReadCallback(mMapSerial, WGPUBufferMapAsyncStatus_DeviceLost, nullptr, 0);
@@ -310,6 +311,7 @@ namespace dawn_native {
         mMapWriteCallback = callback;
         mMapUserdata = userdata;
         mState = BufferState::Mapped;
+        GetDevice()->IncrementResourceStateGeneration();
 
         if (GetDevice()->ConsumedError(MapWriteAsyncImpl(mMapSerial))) {
             CallMapWriteCallback(mMapSerial, WGPUBufferMapAsyncStatus_DeviceLost, nullptr, 0);
@@ -471,6 +473,7 @@ namespace dawn_native {
     void BufferBase::DestroyInternal() {
         if (mState != BufferState::Destroyed) {
             DestroyImpl();
+            GetDevice()->IncrementResourceStateGeneration();
         }
         mState = BufferState::Destroyed;
     }
@@ -15,6 +15,7 @@
 #ifndef DAWNNATIVE_BUFFER_H_
 #define DAWNNATIVE_BUFFER_H_
 
+#include "dawn_native/DeviceStatisticsTracker.h"
 #include "dawn_native/Error.h"
 #include "dawn_native/Forward.h"
 #include "dawn_native/ObjectBase.h"
@@ -107,6 +108,8 @@ namespace dawn_native {
         std::unique_ptr<StagingBufferBase> mStagingBuffer;
 
         BufferState mState;
+
+        LiveObjectCounter mLiveObjectCounter{this, CountedObjectType::Buffer};
     };
 
 }  // namespace dawn_native
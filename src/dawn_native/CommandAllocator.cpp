@@ -23,6 +23,102 @@
 
 namespace dawn_native {
 
+    // CommandBlockPool
+
+    namespace {
+
+        size_t SizeClassLog2(size_t size) {
+            return Log2(static_cast<uint64_t>(size)) + (IsPowerOfTwo(size) ? 0 : 1);
+        }
+
+    }  // anonymous namespace
+
+    constexpr size_t CommandBlockPool::kMinBlockSizeLog2;
+    constexpr size_t CommandBlockPool::kMaxBlockSizeLog2;
+    constexpr size_t CommandBlockPool::kMinBlockSize;
+    constexpr size_t CommandBlockPool::kMaxBlockSize;
+    constexpr size_t CommandBlockPool::kSizeClassCount;
+    constexpr size_t CommandBlockPool::kMaxCachedSizePerClass;
+
+    CommandBlockPool::CommandBlockPool() : mSizeHint(0), mAllocatedBlockCount(0) {
+    }
+
+    CommandBlockPool::~CommandBlockPool() {
+        for (std::vector<uint8_t*>& blocks : mFreeBlocks) {
+            for (uint8_t* block : blocks) {
+                free(block);
+            }
+        }
+    }
+
+    BlockDef CommandBlockPool::AcquireBlock(size_t minimumSize) {
+        // Blocks larger than the largest size class are only used for very large commands and
+        // aren't worth keeping.
+        if (minimumSize > kMaxBlockSize) {
+            mAllocatedBlockCount++;
+            return {minimumSize, static_cast<uint8_t*>(malloc(minimumSize))};
+        }
+
+        size_t sizeLog2 = std::max(SizeClassLog2(minimumSize), kMinBlockSizeLog2);
+        size_t size = size_t(1) << sizeLog2;
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            std::vector<uint8_t*>& freeBlocks = mFreeBlocks[sizeLog2 - kMinBlockSizeLog2];
+            if (!freeBlocks.empty()) {
+                uint8_t* block = freeBlocks.back();
+                freeBlocks.pop_back();
+                return {size, block};
+            }
+        }
+
+        mAllocatedBlockCount++;
+        return {size, static_cast<uint8_t*>(malloc(size))};
+    }
+
+    void CommandBlockPool::ReleaseBlocks(CommandBlocks* blocks) {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            for (BlockDef& block : *blocks) {
+                if (block.size < kMinBlockSize || block.size > kMaxBlockSize ||
+                    !IsPowerOfTwo(block.size)) {
+                    continue;
+                }
+
+                std::vector<uint8_t*>& freeBlocks =
+                    mFreeBlocks[Log2(static_cast<uint64_t>(block.size)) - kMinBlockSizeLog2];
+                if ((freeBlocks.size() + 1) * block.size <= kMaxCachedSizePerClass) {
+                    freeBlocks.push_back(block.block);
+                    block.block = nullptr;
+                }
+            }
+        }
+
+        for (const BlockDef& block : *blocks) {
+            free(block.block);
+        }
+        blocks->clear();
+    }
+
+    size_t CommandBlockPool::GetSizeHint() const {
+        return mSizeHint.load(std::memory_order_relaxed);
+    }
+
+    void CommandBlockPool::AddCommandsSize(size_t size) {
+        // The hint grows immediately to the largest recent command buffer, and shrinks slowly
+        // so that a few small command buffers in a frame don't make the large ones use several
+        // blocks again. It is clamped to the largest size class so that the first block is always
+        // recycled. Concurrent updates can be lost, which only makes the hint less accurate.
+        size = std::min(size, kMaxBlockSize);
+        size_t hint = mSizeHint.load(std::memory_order_relaxed);
+        mSizeHint.store(std::max(size, hint - hint / 8), std::memory_order_relaxed);
+    }
+
+    uint64_t CommandBlockPool::GetAllocatedBlockCountForTesting() const {
+        return mAllocatedBlockCount.load();
+    }
+
+    // CommandIterator
+
     // TODO(cwallez@chromium.org): figure out a way to have more type safety for the iterator
 
     CommandIterator::CommandIterator() {
@@ -33,13 +129,17 @@ namespace dawn_native {
         ASSERT(mDataWasDestroyed);
 
         if (!IsEmpty()) {
-            for (auto& block : mBlocks) {
-                free(block.block);
+            if (mPool != nullptr) {
+                mPool->ReleaseBlocks(&mBlocks);
+            } else {
+                for (auto& block : mBlocks) {
+                    free(block.block);
+                }
             }
         }
     }
 
-    CommandIterator::CommandIterator(CommandIterator&& other) {
+    CommandIterator::CommandIterator(CommandIterator&& other) : mPool(other.mPool) {
         if (!other.IsEmpty()) {
             mBlocks = std::move(other.mBlocks);
             other.Reset();
@@ -49,6 +149,7 @@ namespace dawn_native {
     }
 
     CommandIterator& CommandIterator::operator=(CommandIterator&& other) {
+        mPool = other.mPool;
         if (!other.IsEmpty()) {
             mBlocks = std::move(other.mBlocks);
             other.Reset();
@@ -61,12 +162,13 @@ namespace dawn_native {
     }
 
     CommandIterator::CommandIterator(CommandAllocator&& allocator)
-        : mBlocks(allocator.AcquireBlocks()) {
+        : mBlocks(allocator.AcquireBlocks()), mPool(allocator.mPool) {
         Reset();
     }
 
     CommandIterator& CommandIterator::operator=(CommandAllocator&& allocator) {
         mBlocks = allocator.AcquireBlocks();
+        mPool = allocator.mPool;
         Reset();
         return *this;
     }
@@ -112,12 +214,16 @@ namespace dawn_native {
     //    in Allocate
     //  - Be able to optimize allocation to one block, for command buffers expected to live long to
     //    avoid cache misses
-    //  - Better block allocation, maybe have Dawn API to say command buffer is going to have size
-    //    close to another
 
-    CommandAllocator::CommandAllocator()
-        : mCurrentPtr(reinterpret_cast<uint8_t*>(&mDummyEnum[0])),
+    CommandAllocator::CommandAllocator() : CommandAllocator(nullptr, false) {
+    }
+
+    CommandAllocator::CommandAllocator(CommandBlockPool* pool, bool useSizeHint)
+        : mPool(pool),
+          mUseSizeHint(useSizeHint),
+          mCurrentPtr(reinterpret_cast<uint8_t*>(&mDummyEnum[0])),
           mEndPtr(reinterpret_cast<uint8_t*>(&mDummyEnum[1])) {
+        ASSERT(!useSizeHint || pool != nullptr);
     }
 
     CommandAllocator::~CommandAllocator() {
@@ -130,6 +236,14 @@ namespace dawn_native {
         ASSERT(mCurrentPtr + sizeof(uint32_t) <= mEndPtr);
         *reinterpret_cast<uint32_t*>(mCurrentPtr) = detail::kEndOfBlock;
 
+        if (mUseSizeHint && !mBlocks.empty()) {
+            size_t commandsSize = static_cast<size_t>(mCurrentPtr - mBlocks.back().block);
+            for (size_t i = 0; i + 1 < mBlocks.size(); ++i) {
+                commandsSize += mBlocks[i].size;
+            }
+            mPool->AddCommandsSize(commandsSize + sizeof(uint32_t));
+        }
+
         mCurrentPtr = nullptr;
         mEndPtr = nullptr;
         return std::move(mBlocks);
@@ -160,17 +274,27 @@ namespace dawn_native {
 
     bool CommandAllocator::GetNewBlock(size_t minimumSize) {
         // Allocate blocks doubling sizes each time, to a maximum of 16k (or at least minimumSize).
-        mLastAllocationSize =
-            std::max(minimumSize, std::min(mLastAllocationSize * 2, size_t(16384)));
+        size_t blockSize = std::max(minimumSize, std::min(mLastAllocationSize * 2, size_t(16384)));
 
-        uint8_t* block = static_cast<uint8_t*>(malloc(mLastAllocationSize));
-        if (DAWN_UNLIKELY(block == nullptr)) {
+        BlockDef block;
+        if (mPool != nullptr) {
+            // Start with a block large enough for the commands of previous command buffers so
+            // that most of them only use a single block.
+            if (mUseSizeHint && mBlocks.empty()) {
+                blockSize = std::max(blockSize, mPool->GetSizeHint());
+            }
+            block = mPool->AcquireBlock(blockSize);
+        } else {
+            block = {blockSize, static_cast<uint8_t*>(malloc(blockSize))};
+        }
+        if (DAWN_UNLIKELY(block.block == nullptr)) {
             return false;
         }
 
-        mBlocks.push_back({mLastAllocationSize, block});
-        mCurrentPtr = AlignPtr(block, alignof(uint32_t));
-        mEndPtr = block + mLastAllocationSize;
+        mLastAllocationSize = block.size;
+        mBlocks.push_back(block);
+        mCurrentPtr = AlignPtr(block.block, alignof(uint32_t));
+        mEndPtr = block.block + block.size;
         return true;
     }
 
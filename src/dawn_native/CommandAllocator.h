@@ -18,8 +18,11 @@
 #include "common/Assert.h"
 #include "common/Math.h"
 
+#include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <mutex>
 #include <vector>
 
 namespace dawn_native {
@@ -66,6 +69,52 @@ namespace dawn_native {
 
     class CommandAllocator;
 
+    // A cache of command blocks shared by the CommandAllocators of a device, so that recording
+    // command buffers at a steady rate doesn't allocate and free memory for each of them. Blocks
+    // are rounded up to a power-of-two size class and the blocks of CommandIterators that are
+    // destroyed are kept for the next CommandAllocators, up to kMaxCachedSizePerClass bytes per
+    // class.
+    //
+    // The pool also remembers how large recent command buffers were, so that CommandAllocators
+    // can start with a single block large enough for all their commands.
+    //
+    // Encoders are used and command buffers are destroyed on several threads (see
+    // docs/threading.md) so the pool is thread-safe.
+    class CommandBlockPool {
+      public:
+        CommandBlockPool();
+        ~CommandBlockPool();
+
+        // Returns a block of at least |minimumSize| bytes, or a block with a nullptr if the
+        // allocation failed.
+        BlockDef AcquireBlock(size_t minimumSize);
+        // Returns the blocks to the pool, or frees them if the pool has enough blocks of their
+        // size class already. |blocks| is cleared.
+        void ReleaseBlocks(CommandBlocks* blocks);
+
+        // The size of the first block to use for a new command buffer.
+        size_t GetSizeHint() const;
+        // Called with the size of the commands of each command buffer when they are finished.
+        void AddCommandsSize(size_t size);
+
+        // Blocks allocated by the pool since its creation, for testing.
+        uint64_t GetAllocatedBlockCountForTesting() const;
+
+      private:
+        static constexpr size_t kMinBlockSizeLog2 = 12;
+        static constexpr size_t kMaxBlockSizeLog2 = 18;
+        static constexpr size_t kMinBlockSize = size_t(1) << kMinBlockSizeLog2;
+        static constexpr size_t kMaxBlockSize = size_t(1) << kMaxBlockSizeLog2;
+        static constexpr size_t kSizeClassCount = kMaxBlockSizeLog2 - kMinBlockSizeLog2 + 1;
+        static constexpr size_t kMaxCachedSizePerClass = 1024 * 1024;
+
+        std::mutex mMutex;
+        std::array<std::vector<uint8_t*>, kSizeClassCount> mFreeBlocks;
+
+        std::atomic<size_t> mSizeHint;
+        std::atomic<uint64_t> mAllocatedBlockCount;
+    };
+
     // TODO(cwallez@chromium.org): prevent copy for both iterator and allocator
     class CommandIterator {
       public:
@@ -135,6 +184,8 @@ namespace dawn_native {
         }
 
         CommandBlocks mBlocks;
+        // The pool the blocks are returned to when the iterator is destroyed, if any.
+        CommandBlockPool* mPool = nullptr;
         uint8_t* mCurrentPtr = nullptr;
         size_t mCurrentBlock = 0;
         // Used to avoid a special case for empty iterators.
@@ -145,6 +196,12 @@ namespace dawn_native {
     class CommandAllocator {
       public:
         CommandAllocator();
+        // Allocates blocks from |pool| instead of the heap. |pool| must outlive the allocator
+        // and the CommandIterator the commands are moved to. When |useSizeHint| is true, the
+        // first block is sized with the pool's size hint and the size of the commands updates
+        // it. Only short-lived command buffers should use it: a long-lived render bundle would
+        // keep a block of up to the largest size class alive for a few commands.
+        CommandAllocator(CommandBlockPool* pool, bool useSizeHint);
         ~CommandAllocator();
 
         template <typename T, typename E>
@@ -236,6 +293,8 @@ namespace dawn_native {
         bool GetNewBlock(size_t minimumSize);
 
         CommandBlocks mBlocks;
+        CommandBlockPool* mPool = nullptr;
+        bool mUseSizeHint = false;
         size_t mLastAllocationSize = 2048;
 
         // Pointers to the current range of allocation in the block. Guaranteed to allow for at
@@ -15,15 +15,35 @@
 #include "dawn_native/CommandBuffer.h"
 
 #include "common/BitSetIterator.h"
+#include "dawn_native/Buffer.h"
 #include "dawn_native/CommandEncoder.h"
 #include "dawn_native/Commands.h"
+#include "dawn_native/Device.h"
 #include "dawn_native/Format.h"
+#include "dawn_native/RayTracingAccelerationContainer.h"
 #include "dawn_native/Texture.h"
 
 namespace dawn_native {
 
-    CommandBufferBase::CommandBufferBase(CommandEncoder* encoder, const CommandBufferDescriptor*)
-        : ObjectBase(encoder->GetDevice()), mResourceUsages(encoder->AcquireResourceUsages()) {
+    CommandBufferBase::CommandBufferBase(CommandEncoder* encoder,
+                                         const CommandBufferDescriptor* descriptor)
+        : ObjectBase(encoder->GetDevice()),
+          mResourceUsages(encoder->AcquireResourceUsages()),
+          mReferencedObjects(encoder->AcquireObjectReferences()),
+          mIsReusable(descriptor != nullptr && descriptor->reusable),
+          mCommandCount(encoder->GetEncodedCommandCount()) {
+        for (const PassResourceUsage& passUsages : mResourceUsages.perPass) {
+            mUsedBuffers.Insert(passUsages.buffers.begin(), passUsages.buffers.end());
+            mUsedTextures.Insert(passUsages.textures.begin(), passUsages.textures.end());
+            mUsedAccelerationContainers.Insert(passUsages.accelerationContainers.begin(),
+                                               passUsages.accelerationContainers.end());
+        }
+        mUsedBuffers.Insert(mResourceUsages.topLevelBuffers.begin(),
+                            mResourceUsages.topLevelBuffers.end());
+        mUsedTextures.Insert(mResourceUsages.topLevelTextures.begin(),
+                             mResourceUsages.topLevelTextures.end());
+        mUsedAccelerationContainers.Insert(mResourceUsages.topLevelAccelerationContainers.begin(),
+                                           mResourceUsages.topLevelAccelerationContainers.end());
     }
 
     CommandBufferBase::CommandBufferBase(DeviceBase* device, ObjectBase::ErrorTag tag)
@@ -39,6 +59,38 @@ namespace dawn_native {
         return mResourceUsages;
     }
 
+    bool CommandBufferBase::IsReusable() const {
+        ASSERT(!IsError());
+        return mIsReusable;
+    }
+
+    uint32_t CommandBufferBase::GetCommandCount() const {
+        ASSERT(!IsError());
+        return mCommandCount;
+    }
+
+    MaybeError CommandBufferBase::ValidateCanUseInSubmitNow() {
+        ASSERT(!IsError());
+
+        uint64_t generation = GetDevice()->GetResourceStateGeneration();
+        if (mValidatedResourceStateGeneration == generation) {
+            return {};
+        }
+
+        for (const BufferBase* buffer : mUsedBuffers) {
+            DAWN_TRY(buffer->ValidateCanUseInSubmitNow());
+        }
+        for (const TextureBase* texture : mUsedTextures) {
+            DAWN_TRY(texture->ValidateCanUseInSubmitNow());
+        }
+        for (const RayTracingAccelerationContainerBase* container : mUsedAccelerationContainers) {
+            DAWN_TRY(container->ValidateCanUseInSubmitNow());
+        }
+
+        mValidatedResourceStateGeneration = generation;
+        return {};
+    }
+
     bool IsCompleteSubresourceCopiedTo(const TextureBase* texture,
                                        const Extent3D copySize,
                                        const uint32_t mipLevel) {
@@ -17,6 +17,9 @@
 
 #include "dawn_native/dawn_platform.h"
 
+#include "common/FlatPointerMap.h"
+#include "dawn_native/DeviceStatisticsTracker.h"
+#include "dawn_native/Error.h"
 #include "dawn_native/Forward.h"
 #include "dawn_native/ObjectBase.h"
 #include "dawn_native/PassResourceUsage.h"
@@ -32,10 +35,35 @@ namespace dawn_native {
 
         const CommandBufferResourceUsage& GetResourceUsages() const;
 
+        // Reusable command buffers are meant to be submitted many times. Backends can keep the
+        // native commands they translate them to instead of translating them at every submit.
+        bool IsReusable() const;
+
+        // The number of commands encoded in the command buffer, for the device statistics.
+        uint32_t GetCommandCount() const;
+
+        // Checks that the resources used by the command buffer can be used in a submit. The
+        // checks are skipped if they already passed and no resource changed state since.
+        MaybeError ValidateCanUseInSubmitNow();
+
       private:
         CommandBufferBase(DeviceBase* device, ObjectBase::ErrorTag tag);
 
         CommandBufferResourceUsage mResourceUsages;
+        // The references to the objects that the commands store as raw pointers.
+        std::vector<Ref<ObjectBase>> mReferencedObjects;
+        bool mIsReusable = false;
+        uint32_t mCommandCount = 0;
+
+        // Every resource used by the command buffer once, gathered from all the passes and the
+        // top-level commands when the command buffer is created.
+        FlatPointerSet<BufferBase> mUsedBuffers;
+        FlatPointerSet<TextureBase> mUsedTextures;
+        FlatPointerSet<RayTracingAccelerationContainerBase> mUsedAccelerationContainers;
+        // The device resource state generation in which the resources were last checked, or 0.
+        uint64_t mValidatedResourceStateGeneration = 0;
+
+        LiveObjectCounter mLiveObjectCounter{this, CountedObjectType::CommandBuffer};
     };
     bool IsCompleteSubresourceCopiedTo(const TextureBase* texture,
                                        const Extent3D copySize,
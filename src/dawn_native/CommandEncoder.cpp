@@ -14,6 +14,7 @@
 
 #include "dawn_native/CommandEncoder.h"
 
+#include <algorithm>
 #include <cmath>
 #include <map>
 
@@ -21,7 +22,6 @@
 #include "dawn_native/BindGroup.h"
 #include "dawn_native/Buffer.h"
 #include "dawn_native/CommandBuffer.h"
-#include "dawn_native/CommandBufferStateTracker.h"
 #include "dawn_native/CommandValidation.h"
 #include "dawn_native/Commands.h"
 #include "dawn_native/ComputePassEncoder.h"
@@ -250,12 +250,20 @@ namespace dawn_native {
 
         MaybeError ValidateRayTracingAccelerationContainerCanBuild(
             const RayTracingAccelerationContainerBase* container) {
-            if (container->IsBuilt()) {
+            // Containers that can be updated can also be rebuilt, for example when refits
+            // degraded their quality too much.
+            if (container->IsBuilt() &&
+                (container->GetUsage() & wgpu::RayTracingAccelerationContainerUsage::AllowUpdate) ==
+                    0) {
                 return DAWN_VALIDATION_ERROR("Acceleration Container is already built");
             }
             if (container->IsDestroyed()) {
                 return DAWN_VALIDATION_ERROR("Cannot build a destroyed Acceleration Container");
             }
+            if (container->GetCompactedSize() > 0) {
+                return DAWN_VALIDATION_ERROR(
+                    "Compacted Acceleration Containers can only be the destination of a copy");
+            }
             return {};
         }
 
@@ -275,9 +283,51 @@ namespace dawn_native {
             return {};
         }
 
-        MaybeError ValidateRayTracingAccelerationContainerCanCopy(
+        MaybeError ValidateRayTracingAccelerationContainerCanCompact(
             const RayTracingAccelerationContainerBase* srcContainer,
             const RayTracingAccelerationContainerBase* dstContainer) {
+            if ((srcContainer->GetUsage() &
+                 wgpu::RayTracingAccelerationContainerUsage::AllowCompaction) == 0) {
+                return DAWN_VALIDATION_ERROR(
+                    "Source Acceleration Container does not support compaction");
+            }
+            if (!srcContainer->IsBuilt()) {
+                return DAWN_VALIDATION_ERROR(
+                    "Source Acceleration Container must be built before compacting");
+            }
+            if (srcContainer->IsDestroyed()) {
+                return DAWN_VALIDATION_ERROR(
+                    "Source Acceleration Container is destroyed and cannot be compacted");
+            }
+            if (dstContainer->GetCompactedSize() == 0) {
+                return DAWN_VALIDATION_ERROR(
+                    "Destination Acceleration Container must be created with a compacted size");
+            }
+            if (dstContainer->IsBuilt()) {
+                return DAWN_VALIDATION_ERROR(
+                    "Destination Acceleration Container already holds a compacted container");
+            }
+            if (dstContainer->IsDestroyed()) {
+                return DAWN_VALIDATION_ERROR(
+                    "Destination Acceleration Container is destroyed and cannot be used for "
+                    "compacting");
+            }
+            return {};
+        }
+
+        MaybeError ValidateRayTracingAccelerationContainerCanCopy(
+            const RayTracingAccelerationContainerBase* srcContainer,
+            const RayTracingAccelerationContainerBase* dstContainer,
+            wgpu::RayTracingAccelerationContainerCopyMode mode) {
+            if (mode == wgpu::RayTracingAccelerationContainerCopyMode::Compact) {
+                return ValidateRayTracingAccelerationContainerCanCompact(srcContainer,
+                                                                         dstContainer);
+            }
+            if (dstContainer->GetCompactedSize() > 0) {
+                return DAWN_VALIDATION_ERROR(
+                    "Compacted Acceleration Containers can only be the destination of a compacting "
+                    "copy");
+            }
             if (!srcContainer->IsBuilt()) {
                 return DAWN_VALIDATION_ERROR(
                     "Source Acceleration Container must be built before copying");
@@ -545,7 +595,7 @@ namespace dawn_native {
     }  // namespace
 
     CommandEncoder::CommandEncoder(DeviceBase* device, const CommandEncoderDescriptor*)
-        : ObjectBase(device), mEncodingContext(device, this) {
+        : ObjectBase(device), mEncodingContext(device, this, true) {
     }
 
     CommandBufferResourceUsage CommandEncoder::AcquireResourceUsages() {
@@ -554,10 +604,18 @@ namespace dawn_native {
                                           std::move(mTopLevelAccelerationContainers)};
     }
 
+    uint32_t CommandEncoder::GetEncodedCommandCount() const {
+        return mEncodingContext.GetEncodedCommandCount();
+    }
+
     CommandIterator CommandEncoder::AcquireCommands() {
         return mEncodingContext.AcquireCommands();
     }
 
+    std::vector<Ref<ObjectBase>> CommandEncoder::AcquireObjectReferences() {
+        return mEncodingContext.AcquireObjectReferences();
+    }
+
     // Implementation of the API's command recording methods
 
     ComputePassEncoder* CommandEncoder::BeginComputePass(const ComputePassDescriptor* descriptor) {
@@ -609,6 +667,7 @@ namespace dawn_native {
         DeviceBase* device = GetDevice();
 
         PassResourceUsageTracker usageTracker(PassType::Render);
+        Ref<AttachmentState> attachmentState;
         bool success =
             mEncodingContext.TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
                 uint32_t width = 0;
@@ -623,7 +682,8 @@ namespace dawn_native {
                 BeginRenderPassCmd* cmd =
                     allocator->Allocate<BeginRenderPassCmd>(Command::BeginRenderPass);
 
-                cmd->attachmentState = device->GetOrCreateAttachmentState(descriptor);
+                attachmentState = device->GetOrCreateAttachmentState(descriptor);
+                cmd->attachmentState = attachmentState;
 
                 for (uint32_t i : IterateBitSet(cmd->attachmentState->GetColorAttachmentsMask())) {
                     TextureViewBase* view = descriptor->colorAttachments[i].attachment;
@@ -672,7 +732,8 @@ namespace dawn_native {
 
         if (success) {
             RenderPassEncoder* passEncoder =
-                new RenderPassEncoder(device, this, &mEncodingContext, std::move(usageTracker));
+                new RenderPassEncoder(device, this, &mEncodingContext, std::move(usageTracker),
+                                      std::move(attachmentState));
             mEncodingContext.EnterPass(passEncoder);
             return passEncoder;
         }
@@ -684,6 +745,9 @@ namespace dawn_native {
         RayTracingAccelerationContainerBase* container) {
         mEncodingContext.TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
             DAWN_TRY(GetDevice()->ValidateObject((ObjectBase*)container));
+            if (GetDevice()->IsValidationEnabled()) {
+                DAWN_TRY(ValidateRayTracingAccelerationContainerCanBuild(container));
+            }
 
             BuildRayTracingAccelerationContainerCmd* build =
                 allocator->Allocate<BuildRayTracingAccelerationContainerCmd>(
@@ -691,7 +755,58 @@ namespace dawn_native {
             build->container = container;
 
             if (GetDevice()->IsValidationEnabled()) {
-                mTopLevelAccelerationContainers.insert(container);
+                mTopLevelAccelerationContainers.Insert(container);
+            }
+
+            return {};
+        });
+    }
+
+    void CommandEncoder::BuildRayTracingAccelerationContainers(
+        uint32_t containerCount,
+        RayTracingAccelerationContainerBase* const* containers) {
+        mEncodingContext.TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
+            if (containerCount == 0) {
+                return DAWN_VALIDATION_ERROR("At least one acceleration container is required");
+            }
+            for (uint32_t i = 0; i < containerCount; ++i) {
+                DAWN_TRY(GetDevice()->ValidateObject(containers[i]));
+            }
+
+            if (GetDevice()->IsValidationEnabled()) {
+                for (uint32_t i = 0; i < containerCount; ++i) {
+                    DAWN_TRY(ValidateRayTracingAccelerationContainerCanBuild(containers[i]));
+                }
+            }
+
+            // Backends build the containers with a single call so they can't be built twice or
+            // depend on each other. This is checked even when validation is skipped because the
+            // backends rely on it.
+            FlatPointerSet<RayTracingAccelerationContainerBase> uniqueContainers;
+            for (uint32_t i = 0; i < containerCount; ++i) {
+                if (containers[i]->GetLevel() != containers[0]->GetLevel()) {
+                    return DAWN_VALIDATION_ERROR(
+                        "Acceleration containers built together must have the same level");
+                }
+                if (!uniqueContainers.Insert(containers[i]).second) {
+                    return DAWN_VALIDATION_ERROR(
+                        "Acceleration containers built together must be unique");
+                }
+            }
+
+            BuildRayTracingAccelerationContainersCmd* build =
+                allocator->Allocate<BuildRayTracingAccelerationContainersCmd>(
+                    Command::BuildRayTracingAccelerationContainers);
+            build->count = containerCount;
+
+            Ref<RayTracingAccelerationContainerBase>* data =
+                allocator->AllocateData<Ref<RayTracingAccelerationContainerBase>>(containerCount);
+            for (uint32_t i = 0; i < containerCount; ++i) {
+                data[i] = containers[i];
+            }
+
+            if (GetDevice()->IsValidationEnabled()) {
+                mTopLevelAccelerationContainers.Insert(containers, containers + containerCount);
             }
 
             return {};
@@ -700,20 +815,27 @@ namespace dawn_native {
 
     void CommandEncoder::CopyRayTracingAccelerationContainer(
         RayTracingAccelerationContainerBase* srcContainer,
-        RayTracingAccelerationContainerBase* dstContainer) {
+        RayTracingAccelerationContainerBase* dstContainer,
+        wgpu::RayTracingAccelerationContainerCopyMode mode) {
         mEncodingContext.TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
             DAWN_TRY(GetDevice()->ValidateObject((ObjectBase*)srcContainer));
             DAWN_TRY(GetDevice()->ValidateObject((ObjectBase*)dstContainer));
+            DAWN_TRY(ValidateRayTracingAccelerationContainerCopyMode(mode));
+            if (GetDevice()->IsValidationEnabled()) {
+                DAWN_TRY(ValidateRayTracingAccelerationContainerCanCopy(srcContainer,
+                                                                        dstContainer, mode));
+            }
 
             CopyRayTracingAccelerationContainerCmd* build =
                 allocator->Allocate<CopyRayTracingAccelerationContainerCmd>(
                     Command::CopyRayTracingAccelerationContainer);
             build->srcContainer = srcContainer;
             build->dstContainer = dstContainer;
+            build->mode = mode;
 
             if (GetDevice()->IsValidationEnabled()) {
-                mTopLevelAccelerationContainers.insert(srcContainer);
-                mTopLevelAccelerationContainers.insert(dstContainer);
+                mTopLevelAccelerationContainers.Insert(srcContainer);
+                mTopLevelAccelerationContainers.Insert(dstContainer);
             }
 
             return {};
@@ -721,17 +843,54 @@ namespace dawn_native {
     }
 
     void CommandEncoder::UpdateRayTracingAccelerationContainer(
-        RayTracingAccelerationContainerBase* container) {
+        RayTracingAccelerationContainerBase* container,
+        uint32_t dirtyRangeCount,
+        const RayTracingAccelerationContainerDirtyRange* dirtyRanges) {
         mEncodingContext.TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
             DAWN_TRY(GetDevice()->ValidateObject((ObjectBase*)container));
+            if (GetDevice()->IsValidationEnabled()) {
+                DAWN_TRY(ValidateRayTracingAccelerationContainerCanUpdate(container));
+            }
+
+            // Backends index the geometries of the container with the dirty ranges so they are
+            // checked even when validation is skipped. Skinning typically marks consecutive
+            // ranges so they are merged with the previous one.
+            std::vector<RayTracingAccelerationContainerDirtyRange> mergedRanges;
+            for (uint32_t i = 0; i < dirtyRangeCount; ++i) {
+                const RayTracingAccelerationContainerDirtyRange& range = dirtyRanges[i];
+                DAWN_TRY(container->ValidateDirtyRange(range));
+                if (range.vertexCount == 0) {
+                    continue;
+                }
+                if (!mergedRanges.empty()) {
+                    RayTracingAccelerationContainerDirtyRange& last = mergedRanges.back();
+                    uint64_t lastEnd = uint64_t(last.firstVertex) + last.vertexCount;
+                    uint64_t end = uint64_t(range.firstVertex) + range.vertexCount;
+                    if (last.geometryIndex == range.geometryIndex &&
+                        range.firstVertex <= lastEnd && last.firstVertex <= end) {
+                        uint32_t first = std::min(last.firstVertex, range.firstVertex);
+                        last.vertexCount = static_cast<uint32_t>(std::max(lastEnd, end) - first);
+                        last.firstVertex = first;
+                        continue;
+                    }
+                }
+                mergedRanges.push_back(range);
+            }
 
             UpdateRayTracingAccelerationContainerCmd* update =
                 allocator->Allocate<UpdateRayTracingAccelerationContainerCmd>(
                     Command::UpdateRayTracingAccelerationContainer);
             update->container = container;
+            update->dirtyRangeCount = static_cast<uint32_t>(mergedRanges.size());
+            if (!mergedRanges.empty()) {
+                RayTracingAccelerationContainerDirtyRange* data =
+                    allocator->AllocateData<RayTracingAccelerationContainerDirtyRange>(
+                        mergedRanges.size());
+                memcpy(data, mergedRanges.data(), mergedRanges.size() * sizeof(mergedRanges[0]));
+            }
 
             if (GetDevice()->IsValidationEnabled()) {
-                mTopLevelAccelerationContainers.insert(container);
+                mTopLevelAccelerationContainers.Insert(container);
             }
 
             return {};
@@ -760,8 +919,8 @@ namespace dawn_native {
                 DAWN_TRY(ValidateCanUseAs(source, wgpu::BufferUsage::CopySrc));
                 DAWN_TRY(ValidateCanUseAs(destination, wgpu::BufferUsage::CopyDst));
 
-                mTopLevelBuffers.insert(source);
-                mTopLevelBuffers.insert(destination);
+                mTopLevelBuffers.Insert(source);
+                mTopLevelBuffers.Insert(destination);
             }
 
             CopyBufferToBufferCmd* copy =
@@ -823,8 +982,8 @@ namespace dawn_native {
                 DAWN_TRY(ValidateCanUseAs(source->buffer, wgpu::BufferUsage::CopySrc));
                 DAWN_TRY(ValidateCanUseAs(destination->texture, wgpu::TextureUsage::CopyDst));
 
-                mTopLevelBuffers.insert(source->buffer);
-                mTopLevelTextures.insert(destination->texture);
+                mTopLevelBuffers.Insert(source->buffer);
+                mTopLevelTextures.Insert(destination->texture);
             }
 
             // Record the copy command.
@@ -889,8 +1048,8 @@ namespace dawn_native {
                 DAWN_TRY(ValidateCanUseAs(source->texture, wgpu::TextureUsage::CopySrc));
                 DAWN_TRY(ValidateCanUseAs(destination->buffer, wgpu::BufferUsage::CopyDst));
 
-                mTopLevelTextures.insert(source->texture);
-                mTopLevelBuffers.insert(destination->buffer);
+                mTopLevelTextures.Insert(source->texture);
+                mTopLevelBuffers.Insert(destination->buffer);
             }
 
             // Record the copy command.
@@ -933,8 +1092,8 @@ namespace dawn_native {
                 DAWN_TRY(ValidateCanUseAs(source->texture, wgpu::TextureUsage::CopySrc));
                 DAWN_TRY(ValidateCanUseAs(destination->texture, wgpu::TextureUsage::CopyDst));
 
-                mTopLevelTextures.insert(source->texture);
-                mTopLevelTextures.insert(destination->texture);
+                mTopLevelTextures.Insert(source->texture);
+                mTopLevelTextures.Insert(destination->texture);
             }
 
             CopyTextureToTextureCmd* copy =
@@ -968,6 +1127,11 @@ namespace dawn_native {
 
     void CommandEncoder::PopDebugGroup() {
         mEncodingContext.TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
+            if (GetDevice()->IsValidationEnabled()) {
+                DAWN_TRY(ValidateCanPopDebugGroup(mDebugGroupStackSize));
+                mDebugGroupStackSize--;
+            }
+
             allocator->Allocate<PopDebugGroupCmd>(Command::PopDebugGroup);
 
             return {};
@@ -983,6 +1147,10 @@ namespace dawn_native {
             char* label = allocator->AllocateData<char>(cmd->length + 1);
             memcpy(label, groupLabel, cmd->length + 1);
 
+            if (GetDevice()->IsValidationEnabled()) {
+                mDebugGroupStackSize++;
+            }
+
             return {};
         });
     }
@@ -995,17 +1163,16 @@ namespace dawn_native {
         if (device->ConsumedError(mEncodingContext.Finish()) ||
             device->ConsumedError(device->ValidateIsAlive()) ||
             (device->IsValidationEnabled() &&
-             device->ConsumedError(ValidateFinish(mEncodingContext.GetIterator(),
-                                                  mEncodingContext.GetPassUsages())))) {
+             device->ConsumedError(ValidateFinish(mEncodingContext.GetPassUsages())))) {
             return CommandBufferBase::MakeError(device);
         }
         ASSERT(!IsError());
         return device->CreateCommandBuffer(this, descriptor);
     }
 
-    // Implementation of the command buffer validation that can be precomputed before submit
-    MaybeError CommandEncoder::ValidateFinish(CommandIterator* commands,
-                                              const PerPassUsages& perPassUsages) const {
+    // Implementation of the command buffer validation that can be precomputed before submit.
+    // Commands are validated as they are recorded so this only needs to look at each pass.
+    MaybeError CommandEncoder::ValidateFinish(const PerPassUsages& perPassUsages) const {
         TRACE_EVENT0(GetDevice()->GetPlatform(), Validation, "CommandEncoder::ValidateFinish");
         DAWN_TRY(GetDevice()->ValidateObject(this));
 
@@ -1013,98 +1180,7 @@ namespace dawn_native {
             DAWN_TRY(ValidatePassResourceUsage(passUsage));
         }
 
-        uint64_t debugGroupStackSize = 0;
-
-        commands->Reset();
-        Command type;
-        while (commands->NextCommandId(&type)) {
-            switch (type) {
-                case Command::BeginComputePass: {
-                    commands->NextCommand<BeginComputePassCmd>();
-                    DAWN_TRY(ValidateComputePass(commands));
-                    break;
-                }
-
-                case Command::BeginRayTracingPass: {
-                    commands->NextCommand<BeginRayTracingPassCmd>();
-                    DAWN_TRY(ValidateRayTracingPass(commands));
-                } break;
-
-                case Command::BeginRenderPass: {
-                    const BeginRenderPassCmd* cmd = commands->NextCommand<BeginRenderPassCmd>();
-                    DAWN_TRY(ValidateRenderPass(commands, cmd));
-                    break;
-                }
-
-                case Command::BuildRayTracingAccelerationContainer: {
-                    const BuildRayTracingAccelerationContainerCmd* build =
-                        commands->NextCommand<BuildRayTracingAccelerationContainerCmd>();
-
-                    DAWN_TRY(
-                        ValidateRayTracingAccelerationContainerCanBuild(build->container.Get()));
-                } break;
-
-                case Command::UpdateRayTracingAccelerationContainer: {
-                    const UpdateRayTracingAccelerationContainerCmd* build =
-                        commands->NextCommand<UpdateRayTracingAccelerationContainerCmd>();
-
-                    DAWN_TRY(
-                        ValidateRayTracingAccelerationContainerCanUpdate(build->container.Get()));
-                } break;
-
-                case Command::CopyRayTracingAccelerationContainer: {
-                    const CopyRayTracingAccelerationContainerCmd* copy =
-                        commands->NextCommand<CopyRayTracingAccelerationContainerCmd>();
-
-                    DAWN_TRY(ValidateRayTracingAccelerationContainerCanCopy(
-                        copy->srcContainer.Get(), copy->dstContainer.Get()));
-                } break;
-
-                case Command::CopyBufferToBuffer: {
-                    commands->NextCommand<CopyBufferToBufferCmd>();
-                    break;
-                }
-
-                case Command::CopyBufferToTexture: {
-                    commands->NextCommand<CopyBufferToTextureCmd>();
-                    break;
-                }
-
-                case Command::CopyTextureToBuffer: {
-                    commands->NextCommand<CopyTextureToBufferCmd>();
-                    break;
-                }
-
-                case Command::CopyTextureToTexture: {
-                    commands->NextCommand<CopyTextureToTextureCmd>();
-                    break;
-                }
-
-                case Command::InsertDebugMarker: {
-                    const InsertDebugMarkerCmd* cmd = commands->NextCommand<InsertDebugMarkerCmd>();
-                    commands->NextData<char>(cmd->length + 1);
-                    break;
-                }
-
-                case Command::PopDebugGroup: {
-                    commands->NextCommand<PopDebugGroupCmd>();
-                    DAWN_TRY(ValidateCanPopDebugGroup(debugGroupStackSize));
-                    debugGroupStackSize--;
-                    break;
-                }
-
-                case Command::PushDebugGroup: {
-                    const PushDebugGroupCmd* cmd = commands->NextCommand<PushDebugGroupCmd>();
-                    commands->NextData<char>(cmd->length + 1);
-                    debugGroupStackSize++;
-                    break;
-                }
-                default:
-                    return DAWN_VALIDATION_ERROR("Command disallowed outside of a pass");
-            }
-        }
-
-        DAWN_TRY(ValidateFinalDebugGroupStackSize(debugGroupStackSize));
+        DAWN_TRY(ValidateFinalDebugGroupStackSize(mDebugGroupStackSize));
 
         return {};
     }
@@ -33,7 +33,9 @@ namespace dawn_native {
         CommandEncoder(DeviceBase* device, const CommandEncoderDescriptor* descriptor);
 
         CommandIterator AcquireCommands();
+        std::vector<Ref<ObjectBase>> AcquireObjectReferences();
         CommandBufferResourceUsage AcquireResourceUsages();
+        uint32_t GetEncodedCommandCount() const;
 
         // Dawn API
         ComputePassEncoder* BeginComputePass(const ComputePassDescriptor* descriptor);
@@ -41,11 +43,19 @@ namespace dawn_native {
         RenderPassEncoder* BeginRenderPass(const RenderPassDescriptor* descriptor);
 
         void BuildRayTracingAccelerationContainer(RayTracingAccelerationContainerBase* container);
+        void BuildRayTracingAccelerationContainers(
+            uint32_t containerCount,
+            RayTracingAccelerationContainerBase* const* containers);
 
-        void CopyRayTracingAccelerationContainer(RayTracingAccelerationContainerBase* srcContainer,
-                                                 RayTracingAccelerationContainerBase* dstContainer);
+        void CopyRayTracingAccelerationContainer(
+            RayTracingAccelerationContainerBase* srcContainer,
+            RayTracingAccelerationContainerBase* dstContainer,
+            wgpu::RayTracingAccelerationContainerCopyMode mode);
 
-        void UpdateRayTracingAccelerationContainer(RayTracingAccelerationContainerBase* container);
+        void UpdateRayTracingAccelerationContainer(
+            RayTracingAccelerationContainerBase* container,
+            uint32_t dirtyRangeCount,
+            const RayTracingAccelerationContainerDirtyRange* dirtyRanges);
 
         void CopyBufferToBuffer(BufferBase* source,
                                 uint64_t sourceOffset,
@@ -69,13 +79,14 @@ namespace dawn_native {
         CommandBufferBase* Finish(const CommandBufferDescriptor* descriptor);
 
       private:
-        MaybeError ValidateFinish(CommandIterator* commands,
-                                  const PerPassUsages& perPassUsages) const;
+        MaybeError ValidateFinish(const PerPassUsages& perPassUsages) const;
 
         EncodingContext mEncodingContext;
-        std::set<BufferBase*> mTopLevelBuffers;
-        std::set<TextureBase*> mTopLevelTextures;
-        std::set<RayTracingAccelerationContainerBase*> mTopLevelAccelerationContainers;
+        // Debug groups pushed outside of passes. Passes track their own debug groups.
+        uint64_t mDebugGroupStackSize = 0;
+        FlatPointerSet<BufferBase> mTopLevelBuffers;
+        FlatPointerSet<TextureBase> mTopLevelTextures;
+        FlatPointerSet<RayTracingAccelerationContainerBase> mTopLevelAccelerationContainers;
     };
 
 }  // namespace dawn_native
@@ -15,26 +15,17 @@
 #ifndef DAWNNATIVE_COMMANDVALIDATION_H_
 #define DAWNNATIVE_COMMANDVALIDATION_H_
 
-#include "dawn_native/CommandAllocator.h"
 #include "dawn_native/Error.h"
 
-#include <vector>
+#include <cstdint>
 
 namespace dawn_native {
 
-    class AttachmentState;
-    struct BeginRenderPassCmd;
     struct PassResourceUsage;
 
     MaybeError ValidateCanPopDebugGroup(uint64_t debugGroupStackSize);
     MaybeError ValidateFinalDebugGroupStackSize(uint64_t debugGroupStackSize);
 
-    MaybeError ValidateRenderBundle(CommandIterator* commands,
-                                    const AttachmentState* attachmentState);
-    MaybeError ValidateRenderPass(CommandIterator* commands, const BeginRenderPassCmd* renderPass);
-    MaybeError ValidateComputePass(CommandIterator* commands);
-    MaybeError ValidateRayTracingPass(CommandIterator* commands);
-
     MaybeError ValidatePassResourceUsage(const PassResourceUsage& usage);
 
 }  // namespace dawn_native
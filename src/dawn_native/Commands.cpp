@@ -54,6 +54,17 @@ namespace dawn_native {
                     build->~BuildRayTracingAccelerationContainerCmd();
                     break;
                 }
+                case Command::BuildRayTracingAccelerationContainers: {
+                    BuildRayTracingAccelerationContainersCmd* build =
+                        commands->NextCommand<BuildRayTracingAccelerationContainersCmd>();
+                    auto containers =
+                        commands->NextData<Ref<RayTracingAccelerationContainerBase>>(build->count);
+                    for (size_t i = 0; i < build->count; ++i) {
+                        (&containers[i])->~Ref<RayTracingAccelerationContainerBase>();
+                    }
+                    build->~BuildRayTracingAccelerationContainersCmd();
+                    break;
+                }
                 case Command::CopyRayTracingAccelerationContainer: {
                     CopyRayTracingAccelerationContainerCmd* build =
                         commands->NextCommand<CopyRayTracingAccelerationContainerCmd>();
@@ -63,6 +74,10 @@ namespace dawn_native {
                 case Command::UpdateRayTracingAccelerationContainer: {
                     UpdateRayTracingAccelerationContainerCmd* update =
                         commands->NextCommand<UpdateRayTracingAccelerationContainerCmd>();
+                    if (update->dirtyRangeCount > 0) {
+                        commands->NextData<RayTracingAccelerationContainerDirtyRange>(
+                            update->dirtyRangeCount);
+                    }
                     update->~UpdateRayTracingAccelerationContainerCmd();
                     break;
                 }
@@ -112,6 +127,16 @@ namespace dawn_native {
                     draw->~DrawIndirectCmd();
                     break;
                 }
+                case Command::RepeatDraw: {
+                    RepeatDrawCmd* draw = commands->NextCommand<RepeatDrawCmd>();
+                    draw->~RepeatDrawCmd();
+                    break;
+                }
+                case Command::RepeatDrawIndexed: {
+                    RepeatDrawIndexedCmd* draw = commands->NextCommand<RepeatDrawIndexedCmd>();
+                    draw->~RepeatDrawIndexedCmd();
+                    break;
+                }
                 case Command::DrawIndexedIndirect: {
                     DrawIndexedIndirectCmd* draw = commands->NextCommand<DrawIndexedIndirectCmd>();
                     draw->~DrawIndexedIndirectCmd();
@@ -240,13 +265,24 @@ namespace dawn_native {
                 commands->NextCommand<BuildRayTracingAccelerationContainerCmd>();
                 break;
 
+            case Command::BuildRayTracingAccelerationContainers: {
+                auto* cmd = commands->NextCommand<BuildRayTracingAccelerationContainersCmd>();
+                commands->NextData<Ref<RayTracingAccelerationContainerBase>>(cmd->count);
+                break;
+            }
+
             case Command::CopyRayTracingAccelerationContainer:
                 commands->NextCommand<CopyRayTracingAccelerationContainerCmd>();
                 break;
 
-            case Command::UpdateRayTracingAccelerationContainer:
-                commands->NextCommand<UpdateRayTracingAccelerationContainerCmd>();
+            case Command::UpdateRayTracingAccelerationContainer: {
+                auto* cmd = commands->NextCommand<UpdateRayTracingAccelerationContainerCmd>();
+                if (cmd->dirtyRangeCount > 0) {
+                    commands->NextData<RayTracingAccelerationContainerDirtyRange>(
+                        cmd->dirtyRangeCount);
+                }
                 break;
+            }
 
             case Command::CopyBufferToBuffer:
                 commands->NextCommand<CopyBufferToBufferCmd>();
@@ -280,6 +316,14 @@ namespace dawn_native {
                 commands->NextCommand<DrawIndexedCmd>();
                 break;
 
+            case Command::RepeatDraw:
+                commands->NextCommand<RepeatDrawCmd>();
+                break;
+
+            case Command::RepeatDrawIndexed:
+                commands->NextCommand<RepeatDrawIndexedCmd>();
+                break;
+
             case Command::DrawIndirect:
                 commands->NextCommand<DrawIndirectCmd>();
                 break;
@@ -372,4 +416,26 @@ namespace dawn_native {
         }
     }
 
+    DrawCmd* DrawCommandDecoder::NextDraw(CommandIterator* commands, Command type) {
+        if (type == Command::Draw) {
+            mLastDraw = commands->NextCommand<DrawCmd>();
+        } else {
+            ASSERT(type == Command::RepeatDraw);
+            commands->NextCommand<RepeatDrawCmd>();
+        }
+        ASSERT(mLastDraw != nullptr);
+        return mLastDraw;
+    }
+
+    DrawIndexedCmd* DrawCommandDecoder::NextDrawIndexed(CommandIterator* commands, Command type) {
+        if (type == Command::DrawIndexed) {
+            mLastDrawIndexed = commands->NextCommand<DrawIndexedCmd>();
+        } else {
+            ASSERT(type == Command::RepeatDrawIndexed);
+            commands->NextCommand<RepeatDrawIndexedCmd>();
+        }
+        ASSERT(mLastDrawIndexed != nullptr);
+        return mLastDrawIndexed;
+    }
+
 }  // namespace dawn_native
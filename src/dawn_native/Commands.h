@@ -30,12 +30,21 @@ namespace dawn_native {
     // Definition of the commands that are present in the CommandIterator given by the
     // CommandBufferBuilder. There are not defined in CommandBuffer.h to break some header
     // dependencies: Ref<Object> needs Object to be defined.
+    //
+    // The commands recorded the most often use a compact encoding:
+    //  - Their objects are raw pointers. The EncodingContext keeps one reference to each of them
+    //    for the whole command buffer or render bundle (see EncodingContext::ReferenceObject)
+    //    instead of a Ref<> per command.
+    //  - A draw with the same parameters as the previous draw of the same pass or render bundle
+    //    is a RepeatDraw or RepeatDrawIndexed command without parameters. Backends decode them with
+    //    a DrawCommandDecoder.
 
     enum class Command {
         BeginComputePass,
         BeginRayTracingPass,
         BeginRenderPass,
         BuildRayTracingAccelerationContainer,
+        BuildRayTracingAccelerationContainers,
         CopyRayTracingAccelerationContainer,
         UpdateRayTracingAccelerationContainer,
         CopyBufferToBuffer,
@@ -48,6 +57,8 @@ namespace dawn_native {
         DrawIndexed,
         DrawIndirect,
         DrawIndexedIndirect,
+        RepeatDraw,
+        RepeatDrawIndexed,
         EndComputePass,
         EndRayTracingPass,
         EndRenderPass,
@@ -103,13 +114,22 @@ namespace dawn_native {
         Ref<RayTracingAccelerationContainerBase> container;
     };
 
+    // Followed by |count| Ref<RayTracingAccelerationContainerBase>, all of the same level.
+    struct BuildRayTracingAccelerationContainersCmd {
+        uint32_t count;
+    };
+
     struct CopyRayTracingAccelerationContainerCmd {
         Ref<RayTracingAccelerationContainerBase> srcContainer;
         Ref<RayTracingAccelerationContainerBase> dstContainer;
+        wgpu::RayTracingAccelerationContainerCopyMode mode;
     };
 
+    // Followed by |dirtyRangeCount| RayTracingAccelerationContainerDirtyRange. When there are
+    // none, the whole container is refit.
     struct UpdateRayTracingAccelerationContainerCmd {
         Ref<RayTracingAccelerationContainerBase> container;
+        uint32_t dirtyRangeCount;
     };
 
     struct BufferCopy {
@@ -188,6 +208,10 @@ namespace dawn_native {
         uint64_t indirectOffset;
     };
 
+    struct RepeatDrawCmd {};
+
+    struct RepeatDrawIndexedCmd {};
+
     struct EndComputePassCmd {};
 
     struct EndRayTracingPassCmd {};
@@ -217,7 +241,7 @@ namespace dawn_native {
     };
 
     struct SetRenderPipelineCmd {
-        Ref<RenderPipelineBase> pipeline;
+        RenderPipelineBase* pipeline;
     };
 
     struct SetStencilReferenceCmd {
@@ -238,19 +262,19 @@ namespace dawn_native {
 
     struct SetBindGroupCmd {
         uint32_t index;
-        Ref<BindGroupBase> group;
+        BindGroupBase* group;
         uint32_t dynamicOffsetCount;
     };
 
     struct SetIndexBufferCmd {
-        Ref<BufferBase> buffer;
+        BufferBase* buffer;
         uint64_t offset;
         uint64_t size;
     };
 
     struct SetVertexBufferCmd {
         uint32_t slot;
-        Ref<BufferBase> buffer;
+        BufferBase* buffer;
         uint64_t offset;
         uint64_t size;
     };
@@ -273,6 +297,20 @@ namespace dawn_native {
     // consuming the correct amount of data from the command iterator.
     void SkipCommand(CommandIterator* commands, Command type);
 
+    // Returns the parameters of the Draw, DrawIndexed, RepeatDraw and RepeatDrawIndexed commands.
+    // A decoder must be used for all the draws of a render pass and of the render bundles it
+    // executes: the draws that follow ExecuteBundles are never repeated draws so the bundles
+    // don't need their own decoder.
+    class DrawCommandDecoder {
+      public:
+        DrawCmd* NextDraw(CommandIterator* commands, Command type);
+        DrawIndexedCmd* NextDrawIndexed(CommandIterator* commands, Command type);
+
+      private:
+        DrawCmd* mLastDraw = nullptr;
+        DrawIndexedCmd* mLastDrawIndexed = nullptr;
+    };
+
 }  // namespace dawn_native
 
 #endif  // DAWNNATIVE_COMMANDS_H_
@@ -0,0 +1,49 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/CompactedSizeRequestTracker.h"
+
+#include "dawn_native/Device.h"
+#include "dawn_native/RayTracingAccelerationContainer.h"
+
+namespace dawn_native {
+
+    CompactedSizeRequestTracker::CompactedSizeRequestTracker(DeviceBase* device)
+        : mDevice(device) {
+    }
+
+    CompactedSizeRequestTracker::~CompactedSizeRequestTracker() {
+        ASSERT(mInflightRequests.Empty());
+    }
+
+    void CompactedSizeRequestTracker::Track(
+        RayTracingAccelerationContainerBase* container,
+        WGPURayTracingAccelerationContainerCompactedSizeCallback callback,
+        void* userdata) {
+        Request request;
+        request.container = container;
+        request.callback = callback;
+        request.userdata = userdata;
+
+        mInflightRequests.Enqueue(std::move(request), mDevice->GetPendingCommandSerial());
+    }
+
+    void CompactedSizeRequestTracker::Tick(Serial finishedSerial) {
+        for (auto& request : mInflightRequests.IterateUpTo(finishedSerial)) {
+            request.container->OnCompactedSizeRequestFinished(request.callback, request.userdata);
+        }
+        mInflightRequests.ClearUpTo(finishedSerial);
+    }
+
+}  // namespace dawn_native
@@ -0,0 +1,48 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_COMPACTEDSIZEREQUESTTRACKER_H_
+#define DAWNNATIVE_COMPACTEDSIZEREQUESTTRACKER_H_
+
+#include "common/SerialQueue.h"
+#include "dawn_native/Device.h"
+
+namespace dawn_native {
+
+    // Keeps the GetCompactedSizeAsync requests of acceleration containers until the GPU is done
+    // with the commands submitted before them, which include the builds the sizes are queried for.
+    class CompactedSizeRequestTracker {
+      public:
+        CompactedSizeRequestTracker(DeviceBase* device);
+        ~CompactedSizeRequestTracker();
+
+        void Track(RayTracingAccelerationContainerBase* container,
+                   WGPURayTracingAccelerationContainerCompactedSizeCallback callback,
+                   void* userdata);
+        void Tick(Serial finishedSerial);
+
+      private:
+        DeviceBase* mDevice;
+
+        struct Request {
+            Ref<RayTracingAccelerationContainerBase> container;
+            WGPURayTracingAccelerationContainerCompactedSizeCallback callback;
+            void* userdata;
+        };
+        SerialQueue<Request> mInflightRequests;
+    };
+
+}  // namespace dawn_native
+
+#endif  // DAWNNATIVE_COMPACTEDSIZEREQUESTTRACKER_H_
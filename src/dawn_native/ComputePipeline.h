@@ -15,6 +15,7 @@
 #ifndef DAWNNATIVE_COMPUTEPIPELINE_H_
 #define DAWNNATIVE_COMPUTEPIPELINE_H_
 
+#include "dawn_native/DeviceStatisticsTracker.h"
 #include "dawn_native/Pipeline.h"
 
 namespace dawn_native {
@@ -45,6 +46,8 @@ namespace dawn_native {
         // TODO(cwallez@chromium.org): Store a crypto hash of the module instead.
         Ref<ShaderModuleBase> mModule;
         std::string mEntryPoint;
+
+        LiveObjectCounter mLiveObjectCounter{this, CountedObjectType::ComputePipeline};
     };
 
 }  // namespace dawn_native
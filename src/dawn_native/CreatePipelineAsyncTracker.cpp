@@ -0,0 +1,302 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/CreatePipelineAsyncTracker.h"
+
+#include "dawn_native/ComputePipeline.h"
+#include "dawn_native/Device.h"
+#include "dawn_native/ErrorData.h"
+#include "dawn_native/PipelineLayout.h"
+#include "dawn_native/RayTracingPipeline.h"
+#include "dawn_native/RenderPipeline.h"
+#include "dawn_native/ShaderModule.h"
+
+#include <thread>
+
+namespace dawn_native {
+
+    // CreatePipelineAsyncTaskBase
+
+    CreatePipelineAsyncTaskBase::CreatePipelineAsyncTaskBase(void* userdata)
+        : mUserdata(userdata) {
+    }
+
+    CreatePipelineAsyncTaskBase::~CreatePipelineAsyncTaskBase() {
+        ASSERT(mPipeline == nullptr);
+    }
+
+    void CreatePipelineAsyncTaskBase::SetResult(ResultOrError<PipelineBase*> result) {
+        ASSERT(!IsComplete());
+        if (result.IsError()) {
+            mError = result.AcquireError();
+        } else {
+            mPipeline = result.AcquireSuccess();
+        }
+        mIsComplete = true;
+    }
+
+    void CreatePipelineAsyncTaskBase::SetCreateFunction(CreateFunction createFunction) {
+        ASSERT(!IsComplete());
+        mCreateFunction = std::move(createFunction);
+    }
+
+    bool CreatePipelineAsyncTaskBase::HasCreateFunction() const {
+        return static_cast<bool>(mCreateFunction);
+    }
+
+    bool CreatePipelineAsyncTaskBase::IsComplete() const {
+        return mIsComplete;
+    }
+
+    void CreatePipelineAsyncTaskBase::Run() {
+        ASSERT(HasCreateFunction());
+        SetResult(mCreateFunction());
+    }
+
+    void CreatePipelineAsyncTaskBase::Finish(DeviceBase* device) {
+        ASSERT(IsComplete());
+        if (mError != nullptr) {
+            CallCallback(WGPUCreatePipelineAsyncStatus_Error, nullptr,
+                         mError->GetMessage().c_str());
+            return;
+        }
+
+        // Pipelines created by Run() aren't in the cache yet. An identical pipeline might have
+        // been created while this one was compiling, in which case the cached one is returned.
+        PipelineBase* pipeline = mPipeline;
+        mPipeline = nullptr;
+        if (HasCreateFunction()) {
+            pipeline = AddOrGetCachedPipeline(device, pipeline);
+        }
+
+        // The application owns the reference given to the callback.
+        CallCallback(WGPUCreatePipelineAsyncStatus_Success, pipeline, "");
+    }
+
+    void CreatePipelineAsyncTaskBase::HandleShutDown(WGPUCreatePipelineAsyncStatus status) {
+        ASSERT(IsComplete());
+        if (mPipeline != nullptr) {
+            mPipeline->Release();
+            mPipeline = nullptr;
+        }
+
+        const char* message = status == WGPUCreatePipelineAsyncStatus_DeviceLost
+                                  ? "Device lost before the pipeline creation completed"
+                                  : "Device destroyed before the pipeline creation completed";
+        CallCallback(status, nullptr, message);
+    }
+
+    // CreateComputePipelineAsyncTask
+
+    CreateComputePipelineAsyncTask::CreateComputePipelineAsyncTask(
+        WGPUCreateComputePipelineAsyncCallback callback,
+        void* userdata)
+        : CreatePipelineAsyncTaskBase(userdata), mCallback(callback) {
+    }
+
+    PipelineBase* CreateComputePipelineAsyncTask::AddOrGetCachedPipeline(DeviceBase* device,
+                                                                         PipelineBase* pipeline) {
+        return device->AddOrGetCachedComputePipeline(static_cast<ComputePipelineBase*>(pipeline));
+    }
+
+    void CreateComputePipelineAsyncTask::CallCallback(WGPUCreatePipelineAsyncStatus status,
+                                                      PipelineBase* pipeline,
+                                                      const char* message) {
+        mCallback(status,
+                  reinterpret_cast<WGPUComputePipeline>(
+                      static_cast<ComputePipelineBase*>(pipeline)),
+                  message, mUserdata);
+    }
+
+    // CreateRenderPipelineAsyncTask
+
+    CreateRenderPipelineAsyncTask::CreateRenderPipelineAsyncTask(
+        WGPUCreateRenderPipelineAsyncCallback callback,
+        void* userdata)
+        : CreatePipelineAsyncTaskBase(userdata), mCallback(callback) {
+    }
+
+    PipelineBase* CreateRenderPipelineAsyncTask::AddOrGetCachedPipeline(DeviceBase* device,
+                                                                        PipelineBase* pipeline) {
+        return device->AddOrGetCachedRenderPipeline(static_cast<RenderPipelineBase*>(pipeline));
+    }
+
+    void CreateRenderPipelineAsyncTask::CallCallback(WGPUCreatePipelineAsyncStatus status,
+                                                     PipelineBase* pipeline,
+                                                     const char* message) {
+        mCallback(status,
+                  reinterpret_cast<WGPURenderPipeline>(static_cast<RenderPipelineBase*>(pipeline)),
+                  message, mUserdata);
+    }
+
+    // CreateRayTracingPipelineAsyncTask
+
+    CreateRayTracingPipelineAsyncTask::CreateRayTracingPipelineAsyncTask(
+        WGPUCreateRayTracingPipelineAsyncCallback callback,
+        void* userdata)
+        : CreatePipelineAsyncTaskBase(userdata), mCallback(callback) {
+    }
+
+    PipelineBase* CreateRayTracingPipelineAsyncTask::AddOrGetCachedPipeline(
+        DeviceBase* device,
+        PipelineBase* pipeline) {
+        return device->AddOrGetCachedRayTracingPipeline(
+            static_cast<RayTracingPipelineBase*>(pipeline));
+    }
+
+    void CreateRayTracingPipelineAsyncTask::CallCallback(WGPUCreatePipelineAsyncStatus status,
+                                                         PipelineBase* pipeline,
+                                                         const char* message) {
+        mCallback(status,
+                  reinterpret_cast<WGPURayTracingPipeline>(
+                      static_cast<RayTracingPipelineBase*>(pipeline)),
+                  message, mUserdata);
+    }
+
+    // RenderPipelineDescriptorStorage
+
+    RenderPipelineDescriptorStorage::RenderPipelineDescriptorStorage(
+        const RenderPipelineDescriptor* descriptor)
+        : mDescriptor(*descriptor),
+          mLayout(descriptor->layout),
+          mVertexModule(descriptor->vertexStage.module),
+          mVertexEntryPoint(descriptor->vertexStage.entryPoint) {
+        mDescriptor.nextInChain = nullptr;
+        mDescriptor.label = nullptr;
+
+        mDescriptor.vertexStage.nextInChain = nullptr;
+        mDescriptor.vertexStage.entryPoint = mVertexEntryPoint.c_str();
+
+        if (descriptor->fragmentStage != nullptr) {
+            mFragmentModule = descriptor->fragmentStage->module;
+            mFragmentEntryPoint = descriptor->fragmentStage->entryPoint;
+            mFragmentStage = *descriptor->fragmentStage;
+            mFragmentStage.nextInChain = nullptr;
+            mFragmentStage.entryPoint = mFragmentEntryPoint.c_str();
+            mDescriptor.fragmentStage = &mFragmentStage;
+        }
+
+        if (descriptor->vertexState != nullptr) {
+            mVertexState = *descriptor->vertexState;
+            mVertexState.nextInChain = nullptr;
+
+            uint32_t vertexBufferCount = descriptor->vertexState->vertexBufferCount;
+            mVertexBuffers.assign(descriptor->vertexState->vertexBuffers,
+                                  descriptor->vertexState->vertexBuffers + vertexBufferCount);
+            mVertexAttributes.resize(vertexBufferCount);
+            for (uint32_t i = 0; i < vertexBufferCount; ++i) {
+                const VertexBufferLayoutDescriptor& buffer = mVertexBuffers[i];
+                mVertexAttributes[i].assign(buffer.attributes,
+                                            buffer.attributes + buffer.attributeCount);
+                mVertexBuffers[i].attributes = mVertexAttributes[i].data();
+            }
+            mVertexState.vertexBuffers = mVertexBuffers.data();
+            mDescriptor.vertexState = &mVertexState;
+        }
+
+        if (descriptor->rasterizationState != nullptr) {
+            mRasterizationState = *descriptor->rasterizationState;
+            mRasterizationState.nextInChain = nullptr;
+            mDescriptor.rasterizationState = &mRasterizationState;
+        }
+
+        if (descriptor->depthStencilState != nullptr) {
+            mDepthStencilState = *descriptor->depthStencilState;
+            mDepthStencilState.nextInChain = nullptr;
+            mDescriptor.depthStencilState = &mDepthStencilState;
+        }
+
+        mColorStates.assign(descriptor->colorStates,
+                            descriptor->colorStates + descriptor->colorStateCount);
+        for (ColorStateDescriptor& colorState : mColorStates) {
+            colorState.nextInChain = nullptr;
+        }
+        mDescriptor.colorStates = mColorStates.data();
+    }
+
+    RenderPipelineDescriptorStorage::~RenderPipelineDescriptorStorage() = default;
+
+    const RenderPipelineDescriptor* RenderPipelineDescriptorStorage::GetDescriptor() const {
+        return &mDescriptor;
+    }
+
+    // CreatePipelineAsyncTracker
+
+    CreatePipelineAsyncTracker::CreatePipelineAsyncTracker(DeviceBase* device) : mDevice(device) {
+    }
+
+    CreatePipelineAsyncTracker::~CreatePipelineAsyncTracker() {
+        ASSERT(mTasks.empty());
+    }
+
+    void CreatePipelineAsyncTracker::Track(std::unique_ptr<CreatePipelineAsyncTaskBase> task) {
+        if (!task->IsComplete()) {
+            if (mDevice->CanCreatePipelinesOnWorkerThreads()) {
+                // The tracker owns the task until it is finished, which happens on this thread
+                // after the worker marked it complete, or after waiting on mTaskGroup.
+                CreatePipelineAsyncTaskBase* taskPtr = task.get();
+                GetThreadPool()->Spawn(&mTaskGroup, [taskPtr]() { taskPtr->Run(); });
+            } else {
+                task->Run();
+            }
+        }
+        mTasks.push_back(std::move(task));
+    }
+
+    void CreatePipelineAsyncTracker::Tick() {
+        // Callbacks can create more pipelines, so remove the completed tasks from mTasks before
+        // calling any of them.
+        std::vector<std::unique_ptr<CreatePipelineAsyncTaskBase>> completedTasks;
+        size_t pendingTaskCount = 0;
+        for (size_t i = 0; i < mTasks.size(); ++i) {
+            if (mTasks[i]->IsComplete()) {
+                completedTasks.push_back(std::move(mTasks[i]));
+            } else {
+                if (i != pendingTaskCount) {
+                    mTasks[pendingTaskCount] = std::move(mTasks[i]);
+                }
+                pendingTaskCount++;
+            }
+        }
+        mTasks.resize(pendingTaskCount);
+
+        for (std::unique_ptr<CreatePipelineAsyncTaskBase>& task : completedTasks) {
+            task->Finish(mDevice);
+        }
+    }
+
+    void CreatePipelineAsyncTracker::ClearForShutDown(WGPUCreatePipelineAsyncStatus status) {
+        if (mThreadPool != nullptr) {
+            mThreadPool->Wait(&mTaskGroup);
+        }
+
+        std::vector<std::unique_ptr<CreatePipelineAsyncTaskBase>> tasks = std::move(mTasks);
+        mTasks.clear();
+        for (std::unique_ptr<CreatePipelineAsyncTaskBase>& task : tasks) {
+            task->HandleShutDown(status);
+        }
+    }
+
+    ThreadPool* CreatePipelineAsyncTracker::GetThreadPool() {
+        if (mThreadPool == nullptr) {
+            // Leave one hardware thread to the application but always have a worker, otherwise
+            // tasks would only run when the tracker waits on them.
+            uint32_t threadCount = std::thread::hardware_concurrency();
+            uint32_t workerCount = threadCount > 1 ? threadCount - 1 : 1;
+            mThreadPool = std::make_unique<ThreadPool>(workerCount);
+        }
+        return mThreadPool.get();
+    }
+
+}  // namespace dawn_native
@@ -0,0 +1,185 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_CREATEPIPELINEASYNCTRACKER_H_
+#define DAWNNATIVE_CREATEPIPELINEASYNCTRACKER_H_
+
+#include "common/RefCounted.h"
+#include "common/ThreadPool.h"
+#include "dawn_native/Error.h"
+#include "dawn_native/dawn_platform.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace dawn_native {
+
+    class DeviceBase;
+    class PipelineBase;
+    class PipelineLayoutBase;
+    class ShaderModuleBase;
+
+    // A request made with one of the Create*PipelineAsync functions. The pipeline is either
+    // known when the request is made (cache hits, errors, pipelines created on the calling thread)
+    // or created later by Run(), possibly on a worker thread. In both cases the callback is only
+    // called from Finish() when the device ticks.
+    class CreatePipelineAsyncTaskBase {
+      public:
+        using CreateFunction = std::function<ResultOrError<PipelineBase*>()>;
+
+        CreatePipelineAsyncTaskBase(void* userdata);
+        virtual ~CreatePipelineAsyncTaskBase();
+
+        // Sets the result of a request that completed on the calling thread. A pipeline passed
+        // here must already be in the device cache.
+        void SetResult(ResultOrError<PipelineBase*> result);
+        // Sets the function creating the pipeline. The function must only call the backend's
+        // Create*PipelineImpl and must keep the objects of its descriptor alive by itself.
+        void SetCreateFunction(CreateFunction createFunction);
+
+        bool HasCreateFunction() const;
+        bool IsComplete() const;
+
+        // Creates the pipeline, on a worker thread if the backend supports it.
+        void Run();
+        // Caches the created pipeline and calls the callback. Only called on the device thread.
+        void Finish(DeviceBase* device);
+        // Calls the callback with |status| without a pipeline.
+        void HandleShutDown(WGPUCreatePipelineAsyncStatus status);
+
+      protected:
+        virtual PipelineBase* AddOrGetCachedPipeline(DeviceBase* device,
+                                                     PipelineBase* pipeline) = 0;
+        virtual void CallCallback(WGPUCreatePipelineAsyncStatus status,
+                                  PipelineBase* pipeline,
+                                  const char* message) = 0;
+
+        void* mUserdata;
+
+      private:
+        CreateFunction mCreateFunction;
+        std::atomic<bool> mIsComplete{false};
+
+        // The result of the request, owning a reference to the pipeline.
+        PipelineBase* mPipeline = nullptr;
+        std::unique_ptr<ErrorData> mError;
+    };
+
+    class CreateComputePipelineAsyncTask final : public CreatePipelineAsyncTaskBase {
+      public:
+        CreateComputePipelineAsyncTask(WGPUCreateComputePipelineAsyncCallback callback,
+                                       void* userdata);
+
+      private:
+        PipelineBase* AddOrGetCachedPipeline(DeviceBase* device, PipelineBase* pipeline) override;
+        void CallCallback(WGPUCreatePipelineAsyncStatus status,
+                          PipelineBase* pipeline,
+                          const char* message) override;
+
+        WGPUCreateComputePipelineAsyncCallback mCallback;
+    };
+
+    class CreateRenderPipelineAsyncTask final : public CreatePipelineAsyncTaskBase {
+      public:
+        CreateRenderPipelineAsyncTask(WGPUCreateRenderPipelineAsyncCallback callback,
+                                      void* userdata);
+
+      private:
+        PipelineBase* AddOrGetCachedPipeline(DeviceBase* device, PipelineBase* pipeline) override;
+        void CallCallback(WGPUCreatePipelineAsyncStatus status,
+                          PipelineBase* pipeline,
+                          const char* message) override;
+
+        WGPUCreateRenderPipelineAsyncCallback mCallback;
+    };
+
+    class CreateRayTracingPipelineAsyncTask final : public CreatePipelineAsyncTaskBase {
+      public:
+        CreateRayTracingPipelineAsyncTask(WGPUCreateRayTracingPipelineAsyncCallback callback,
+                                          void* userdata);
+
+      private:
+        PipelineBase* AddOrGetCachedPipeline(DeviceBase* device, PipelineBase* pipeline) override;
+        void CallCallback(WGPUCreatePipelineAsyncStatus status,
+                          PipelineBase* pipeline,
+                          const char* message) override;
+
+        WGPUCreateRayTracingPipelineAsyncCallback mCallback;
+    };
+
+    // A deep copy of a validated RenderPipelineDescriptor, so that the pipeline can be created on
+    // a worker thread after the application's descriptor is gone. It keeps references to the
+    // layout and shader modules. Chained structs aren't copied: validation requires them to be
+    // nullptr.
+    class RenderPipelineDescriptorStorage {
+      public:
+        RenderPipelineDescriptorStorage(const RenderPipelineDescriptor* descriptor);
+        ~RenderPipelineDescriptorStorage();
+
+        RenderPipelineDescriptorStorage(const RenderPipelineDescriptorStorage&) = delete;
+        RenderPipelineDescriptorStorage& operator=(const RenderPipelineDescriptorStorage&) =
+            delete;
+
+        const RenderPipelineDescriptor* GetDescriptor() const;
+
+      private:
+        RenderPipelineDescriptor mDescriptor;
+
+        Ref<PipelineLayoutBase> mLayout;
+        Ref<ShaderModuleBase> mVertexModule;
+        Ref<ShaderModuleBase> mFragmentModule;
+        std::string mVertexEntryPoint;
+        std::string mFragmentEntryPoint;
+        ProgrammableStageDescriptor mFragmentStage;
+
+        VertexStateDescriptor mVertexState;
+        std::vector<VertexBufferLayoutDescriptor> mVertexBuffers;
+        std::vector<std::vector<VertexAttributeDescriptor>> mVertexAttributes;
+
+        RasterizationStateDescriptor mRasterizationState;
+        DepthStencilStateDescriptor mDepthStencilState;
+        std::vector<ColorStateDescriptor> mColorStates;
+    };
+
+    // Keeps the Create*PipelineAsync requests until the device ticks after their pipeline is
+    // created. Pipelines are created on a pool of worker threads owned by the tracker when the
+    // backend supports it, so that shader compilation doesn't block the application.
+    class CreatePipelineAsyncTracker {
+      public:
+        CreatePipelineAsyncTracker(DeviceBase* device);
+        ~CreatePipelineAsyncTracker();
+
+        void Track(std::unique_ptr<CreatePipelineAsyncTaskBase> task);
+        void Tick();
+        // Waits for the pipelines being created and calls all the remaining callbacks with
+        // |status|.
+        void ClearForShutDown(WGPUCreatePipelineAsyncStatus status);
+
+      private:
+        ThreadPool* GetThreadPool();
+
+        DeviceBase* mDevice;
+
+        std::vector<std::unique_ptr<CreatePipelineAsyncTaskBase>> mTasks;
+
+        std::unique_ptr<ThreadPool> mThreadPool;
+        ThreadPool::TaskGroup mTaskGroup;
+    };
+
+}  // namespace dawn_native
+
+#endif  // DAWNNATIVE_CREATEPIPELINEASYNCTRACKER_H_
@@ -15,6 +15,7 @@
 #include "dawn_native/DawnNative.h"
 #include "dawn_native/Device.h"
 #include "dawn_native/Instance.h"
+#include "dawn_native/RayTracingAccelerationContainer.h"
 #include "dawn_native/Texture.h"
 #include "dawn_platform/DawnPlatform.h"
 
@@ -171,6 +172,17 @@ namespace dawn_native {
         return deviceBase->GetDeprecationWarningCountForTesting();
     }
 
+    AccelerationContainerUpdateStats GetAccelerationContainerUpdateStats(
+        WGPURayTracingAccelerationContainer container) {
+        RayTracingAccelerationContainerBase* containerBase =
+            reinterpret_cast<RayTracingAccelerationContainerBase*>(container);
+        AccelerationContainerUpdateStats stats;
+        stats.buildCount = containerBase->GetBuildCount();
+        stats.refitCount = containerBase->GetRefitCount();
+        stats.refitCountSinceBuild = containerBase->GetRefitCountSinceBuild();
+        return stats;
+    }
+
     bool IsTextureSubresourceInitialized(WGPUTexture texture,
                                          uint32_t baseMipLevel,
                                          uint32_t levelCount,
@@ -20,9 +20,12 @@
 #include "dawn_native/BindGroup.h"
 #include "dawn_native/BindGroupLayout.h"
 #include "dawn_native/Buffer.h"
+#include "dawn_native/CommandAllocator.h"
 #include "dawn_native/CommandBuffer.h"
 #include "dawn_native/CommandEncoder.h"
+#include "dawn_native/CompactedSizeRequestTracker.h"
 #include "dawn_native/ComputePipeline.h"
+#include "dawn_native/CreatePipelineAsyncTracker.h"
 #include "dawn_native/DynamicUploader.h"
 #include "dawn_native/ErrorData.h"
 #include "dawn_native/ErrorScope.h"
@@ -31,6 +34,7 @@
 #include "dawn_native/FenceSignalTracker.h"
 #include "dawn_native/Instance.h"
 #include "dawn_native/MapRequestTracker.h"
+#include "dawn_native/PersistentCache.h"
 #include "dawn_native/PipelineLayout.h"
 #include "dawn_native/Queue.h"
 #include "dawn_native/RayTracingAccelerationContainer.h"
@@ -44,7 +48,11 @@
 #include "dawn_native/SwapChain.h"
 #include "dawn_native/Texture.h"
 #include "dawn_native/ValidationUtils_autogen.h"
+#include "dawn_platform/DawnPlatform.h"
+#include "dawn_platform/tracing/TraceEvent.h"
 
+#include <mutex>
+#include <string>
 #include <unordered_set>
 
 namespace dawn_native {
@@ -63,15 +71,20 @@ namespace dawn_native {
             ASSERT(bindGroupLayouts.empty());
             ASSERT(computePipelines.empty());
             ASSERT(pipelineLayouts.empty());
+            ASSERT(rayTracingPipelines.empty());
             ASSERT(renderPipelines.empty());
             ASSERT(samplers.empty());
             ASSERT(shaderModules.empty());
         }
 
+        // Render passes and render bundle encoders get attachment states while they are
+        // recorded, which can happen on any thread.
+        std::mutex attachmentStatesMutex;
         ContentLessObjectCache<AttachmentStateBlueprint> attachmentStates;
         ContentLessObjectCache<BindGroupLayoutBase> bindGroupLayouts;
         ContentLessObjectCache<ComputePipelineBase> computePipelines;
         ContentLessObjectCache<PipelineLayoutBase> pipelineLayouts;
+        ContentLessObjectCache<RayTracingPipelineBase> rayTracingPipelines;
         ContentLessObjectCache<RenderPipelineBase> renderPipelines;
         ContentLessObjectCache<SamplerBase> samplers;
         ContentLessObjectCache<ShaderModuleBase> shaderModules;
@@ -93,6 +106,12 @@ namespace dawn_native {
 
         mFormatTable = BuildFormatTable(this);
         SetDefaultToggles();
+
+        // Backends use the persistent cache during their initialization, before
+        // DeviceBase::Initialize is called.
+        mPersistentCache = std::make_unique<PersistentCache>(this);
+
+        mCommandBlockPool = std::make_unique<CommandBlockPool>();
     }
 
     DeviceBase::~DeviceBase() {
@@ -107,6 +126,8 @@ namespace dawn_native {
         mErrorScopeTracker = std::make_unique<ErrorScopeTracker>(this);
         mFenceSignalTracker = std::make_unique<FenceSignalTracker>(this);
         mMapRequestTracker = std::make_unique<MapRequestTracker>(this);
+        mCompactedSizeRequestTracker = std::make_unique<CompactedSizeRequestTracker>(this);
+        mCreatePipelineAsyncTracker = std::make_unique<CreatePipelineAsyncTracker>(this);
         mDynamicUploader = std::make_unique<DynamicUploader>(this);
         mDeprecationWarnings = std::make_unique<DeprecationWarnings>();
 
@@ -118,6 +139,8 @@ namespace dawn_native {
     }
 
     void DeviceBase::ShutDownBase() {
+        const bool wasLost = mState == State::Disconnected;
+
         // Disconnect the device, depending on which state we are currently in.
         switch (mState) {
             case State::BeingCreated:
@@ -152,6 +175,13 @@ namespace dawn_native {
             mErrorScopeTracker->Tick(GetCompletedCommandSerial());
             mFenceSignalTracker->Tick(GetCompletedCommandSerial());
             mMapRequestTracker->Tick(GetCompletedCommandSerial());
+            mCompactedSizeRequestTracker->Tick(GetCompletedCommandSerial());
+
+            // Pipelines might still be compiling on worker threads that use the backend, wait
+            // for them before the backend is shut down.
+            mCreatePipelineAsyncTracker->ClearForShutDown(
+                wasLost ? WGPUCreatePipelineAsyncStatus_DeviceLost
+                        : WGPUCreatePipelineAsyncStatus_DeviceDestroyed);
         }
 
         // At this point GPU operations are always finished, so we are in the disconnected state.
@@ -162,6 +192,8 @@ namespace dawn_native {
         mFenceSignalTracker = nullptr;
         mDynamicUploader = nullptr;
         mMapRequestTracker = nullptr;
+        mCompactedSizeRequestTracker = nullptr;
+        mCreatePipelineAsyncTracker = nullptr;
 
         // Tell the backend that it can free all the objects now that the GPU timeline is empty.
         ShutDownImpl();
@@ -170,14 +202,15 @@ namespace dawn_native {
     }
 
     void DeviceBase::HandleError(InternalErrorType type, const char* message) {
+        // Encoders consume their errors on the thread they are finished on.
+        std::lock_guard<std::recursive_mutex> lock(mErrorMutex);
+
         // If we receive an internal error, assume the backend can't recover and proceed with
         // device destruction. We first wait for all previous commands to be completed so that
         // backend objects can be freed immediately, before handling the loss.
         if (type == InternalErrorType::Internal) {
             // Move away from the Alive state so that the application cannot use this device
-            // anymore.
-            // TODO(cwallez@chromium.org): Do we need atomics for this to become visible to other
-            // threads in a multithreaded scenario?
+            // anymore. mState is atomic so that encoders on other threads see the change.
             mState = State::BeingDisconnected;
 
             // Assert that errors are device losses so that we can continue with destruction.
@@ -227,10 +260,12 @@ namespace dawn_native {
     }
 
     void DeviceBase::SetUncapturedErrorCallback(wgpu::ErrorCallback callback, void* userdata) {
+        std::lock_guard<std::recursive_mutex> lock(mErrorMutex);
         mRootErrorScope->SetCallback(callback, userdata);
     }
 
     void DeviceBase::SetDeviceLostCallback(wgpu::DeviceLostCallback callback, void* userdata) {
+        std::lock_guard<std::recursive_mutex> lock(mErrorMutex);
         mDeviceLostCallback = callback;
         mDeviceLostUserdata = userdata;
     }
@@ -239,10 +274,12 @@ namespace dawn_native {
         if (ConsumedError(ValidateErrorFilter(filter))) {
             return;
         }
+        std::lock_guard<std::recursive_mutex> lock(mErrorMutex);
         mCurrentErrorScope = AcquireRef(new ErrorScope(filter, mCurrentErrorScope.Get()));
     }
 
     bool DeviceBase::PopErrorScope(wgpu::ErrorCallback callback, void* userdata) {
+        std::lock_guard<std::recursive_mutex> lock(mErrorMutex);
         if (DAWN_UNLIKELY(mCurrentErrorScope.Get() == mRootErrorScope.Get())) {
             return false;
         }
@@ -252,6 +289,28 @@ namespace dawn_native {
         return true;
     }
 
+    void DeviceBase::GetStatistics(wgpu::DeviceStatisticsCallback callback, void* userdata) {
+        DeviceStatistics statistics;
+        if (mState != State::Alive) {
+            callback(WGPUDeviceStatisticsStatus_DeviceLost,
+                     reinterpret_cast<const WGPUDeviceStatistics*>(&statistics), userdata);
+            return;
+        }
+
+        mStatisticsTracker.Fill(&statistics);
+        statistics.stagingMemorySize = mDynamicUploader->GetStagingMemorySize();
+        statistics.stagingBytesInFlight = mDynamicUploader->GetStagingBytesInFlight();
+        statistics.completedSerial = GetCompletedCommandSerial();
+        statistics.lastSubmittedSerial = GetLastSubmittedCommandSerial();
+        FillStatisticsImpl(&statistics);
+
+        callback(WGPUDeviceStatisticsStatus_Success,
+                 reinterpret_cast<const WGPUDeviceStatistics*>(&statistics), userdata);
+    }
+
+    void DeviceBase::FillStatisticsImpl(DeviceStatistics* statistics) const {
+    }
+
     ErrorScope* DeviceBase::GetCurrentErrorScope() {
         ASSERT(mCurrentErrorScope.Get() != nullptr);
         return mCurrentErrorScope.Get();
@@ -312,6 +371,10 @@ namespace dawn_native {
         return mMapRequestTracker.get();
     }
 
+    CompactedSizeRequestTracker* DeviceBase::GetCompactedSizeRequestTracker() const {
+        return mCompactedSizeRequestTracker.get();
+    }
+
     Serial DeviceBase::GetCompletedCommandSerial() const {
         return mCompletedSerial;
     }
@@ -378,10 +441,12 @@ namespace dawn_native {
 
         auto iter = mCaches->bindGroupLayouts.find(&blueprint);
         if (iter != mCaches->bindGroupLayouts.end()) {
+            mStatisticsTracker.CacheHit(ObjectCacheType::BindGroupLayout);
             (*iter)->Reference();
             return *iter;
         }
 
+        mStatisticsTracker.CacheMiss(ObjectCacheType::BindGroupLayout);
         BindGroupLayoutBase* backendObj;
         DAWN_TRY_ASSIGN(backendObj, CreateBindGroupLayoutImpl(descriptor));
         backendObj->SetIsCachedReference();
@@ -401,10 +466,13 @@ namespace dawn_native {
 
         auto iter = mCaches->computePipelines.find(&blueprint);
         if (iter != mCaches->computePipelines.end()) {
+            mStatisticsTracker.CacheHit(ObjectCacheType::ComputePipeline);
             (*iter)->Reference();
             return *iter;
         }
 
+        mStatisticsTracker.CacheMiss(ObjectCacheType::ComputePipeline);
+        TRACE_EVENT0(GetPlatform(), General, "DeviceBase::CreateComputePipelineImpl");
         ComputePipelineBase* backendObj;
         DAWN_TRY_ASSIGN(backendObj, CreateComputePipelineImpl(descriptor));
         backendObj->SetIsCachedReference();
@@ -418,16 +486,34 @@ namespace dawn_native {
         ASSERT(removedCount == 1);
     }
 
+    ComputePipelineBase* DeviceBase::AddOrGetCachedComputePipeline(
+        ComputePipelineBase* pipeline) {
+        auto insertion = mCaches->computePipelines.insert(pipeline);
+        if (insertion.second) {
+            mStatisticsTracker.CacheMiss(ObjectCacheType::ComputePipeline);
+            pipeline->SetIsCachedReference();
+            return pipeline;
+        }
+
+        mStatisticsTracker.CacheHit(ObjectCacheType::ComputePipeline);
+        ComputePipelineBase* cachedPipeline = *insertion.first;
+        cachedPipeline->Reference();
+        pipeline->Release();
+        return cachedPipeline;
+    }
+
     ResultOrError<PipelineLayoutBase*> DeviceBase::GetOrCreatePipelineLayout(
         const PipelineLayoutDescriptor* descriptor) {
         PipelineLayoutBase blueprint(this, descriptor);
 
         auto iter = mCaches->pipelineLayouts.find(&blueprint);
         if (iter != mCaches->pipelineLayouts.end()) {
+            mStatisticsTracker.CacheHit(ObjectCacheType::PipelineLayout);
             (*iter)->Reference();
             return *iter;
         }
 
+        mStatisticsTracker.CacheMiss(ObjectCacheType::PipelineLayout);
         PipelineLayoutBase* backendObj;
         DAWN_TRY_ASSIGN(backendObj, CreatePipelineLayoutImpl(descriptor));
         backendObj->SetIsCachedReference();
@@ -441,16 +527,61 @@ namespace dawn_native {
         ASSERT(removedCount == 1);
     }
 
+    ResultOrError<RayTracingPipelineBase*> DeviceBase::GetOrCreateRayTracingPipeline(
+        const RayTracingPipelineDescriptor* descriptor) {
+        RayTracingPipelineBase blueprint(this, descriptor);
+
+        auto iter = mCaches->rayTracingPipelines.find(&blueprint);
+        if (iter != mCaches->rayTracingPipelines.end()) {
+            mStatisticsTracker.CacheHit(ObjectCacheType::RayTracingPipeline);
+            (*iter)->Reference();
+            return *iter;
+        }
+
+        mStatisticsTracker.CacheMiss(ObjectCacheType::RayTracingPipeline);
+        TRACE_EVENT0(GetPlatform(), General, "DeviceBase::CreateRayTracingPipelineImpl");
+        RayTracingPipelineBase* backendObj;
+        DAWN_TRY_ASSIGN(backendObj, CreateRayTracingPipelineImpl(descriptor));
+        backendObj->SetIsCachedReference();
+        mCaches->rayTracingPipelines.insert(backendObj);
+        return backendObj;
+    }
+
+    void DeviceBase::UncacheRayTracingPipeline(RayTracingPipelineBase* obj) {
+        ASSERT(obj->IsCachedReference());
+        size_t removedCount = mCaches->rayTracingPipelines.erase(obj);
+        ASSERT(removedCount == 1);
+    }
+
+    RayTracingPipelineBase* DeviceBase::AddOrGetCachedRayTracingPipeline(
+        RayTracingPipelineBase* pipeline) {
+        auto insertion = mCaches->rayTracingPipelines.insert(pipeline);
+        if (insertion.second) {
+            mStatisticsTracker.CacheMiss(ObjectCacheType::RayTracingPipeline);
+            pipeline->SetIsCachedReference();
+            return pipeline;
+        }
+
+        mStatisticsTracker.CacheHit(ObjectCacheType::RayTracingPipeline);
+        RayTracingPipelineBase* cachedPipeline = *insertion.first;
+        cachedPipeline->Reference();
+        pipeline->Release();
+        return cachedPipeline;
+    }
+
     ResultOrError<RenderPipelineBase*> DeviceBase::GetOrCreateRenderPipeline(
         const RenderPipelineDescriptor* descriptor) {
         RenderPipelineBase blueprint(this, descriptor);
 
         auto iter = mCaches->renderPipelines.find(&blueprint);
         if (iter != mCaches->renderPipelines.end()) {
+            mStatisticsTracker.CacheHit(ObjectCacheType::RenderPipeline);
             (*iter)->Reference();
             return *iter;
         }
 
+        mStatisticsTracker.CacheMiss(ObjectCacheType::RenderPipeline);
+        TRACE_EVENT0(GetPlatform(), General, "DeviceBase::CreateRenderPipelineImpl");
         RenderPipelineBase* backendObj;
         DAWN_TRY_ASSIGN(backendObj, CreateRenderPipelineImpl(descriptor));
         backendObj->SetIsCachedReference();
@@ -464,16 +595,33 @@ namespace dawn_native {
         ASSERT(removedCount == 1);
     }
 
+    RenderPipelineBase* DeviceBase::AddOrGetCachedRenderPipeline(RenderPipelineBase* pipeline) {
+        auto insertion = mCaches->renderPipelines.insert(pipeline);
+        if (insertion.second) {
+            mStatisticsTracker.CacheMiss(ObjectCacheType::RenderPipeline);
+            pipeline->SetIsCachedReference();
+            return pipeline;
+        }
+
+        mStatisticsTracker.CacheHit(ObjectCacheType::RenderPipeline);
+        RenderPipelineBase* cachedPipeline = *insertion.first;
+        cachedPipeline->Reference();
+        pipeline->Release();
+        return cachedPipeline;
+    }
+
     ResultOrError<SamplerBase*> DeviceBase::GetOrCreateSampler(
         const SamplerDescriptor* descriptor) {
         SamplerBase blueprint(this, descriptor);
 
         auto iter = mCaches->samplers.find(&blueprint);
         if (iter != mCaches->samplers.end()) {
+            mStatisticsTracker.CacheHit(ObjectCacheType::Sampler);
             (*iter)->Reference();
             return *iter;
         }
 
+        mStatisticsTracker.CacheMiss(ObjectCacheType::Sampler);
         SamplerBase* backendObj;
         DAWN_TRY_ASSIGN(backendObj, CreateSamplerImpl(descriptor));
         backendObj->SetIsCachedReference();
@@ -493,10 +641,13 @@ namespace dawn_native {
 
         auto iter = mCaches->shaderModules.find(&blueprint);
         if (iter != mCaches->shaderModules.end()) {
+            mStatisticsTracker.CacheHit(ObjectCacheType::ShaderModule);
             (*iter)->Reference();
             return *iter;
         }
 
+        mStatisticsTracker.CacheMiss(ObjectCacheType::ShaderModule);
+        TRACE_EVENT0(GetPlatform(), General, "DeviceBase::CreateShaderModuleImpl");
         ShaderModuleBase* backendObj;
         DAWN_TRY_ASSIGN(backendObj, CreateShaderModuleImpl(descriptor));
         backendObj->SetIsCachedReference();
@@ -512,9 +663,17 @@ namespace dawn_native {
 
     Ref<AttachmentState> DeviceBase::GetOrCreateAttachmentState(
         AttachmentStateBlueprint* blueprint) {
+        std::lock_guard<std::mutex> lock(mCaches->attachmentStatesMutex);
+
         auto iter = mCaches->attachmentStates.find(blueprint);
         if (iter != mCaches->attachmentStates.end()) {
-            return static_cast<AttachmentState*>(*iter);
+            // The cached attachment state might be being destroyed on another thread that is
+            // waiting to uncache it. In that case replace it with a new one.
+            AttachmentState* cachedState = static_cast<AttachmentState*>(*iter);
+            if (cachedState->TryReference()) {
+                return AcquireRef(cachedState);
+            }
+            mCaches->attachmentStates.erase(iter);
         }
 
         Ref<AttachmentState> attachmentState = AcquireRef(new AttachmentState(this, *blueprint));
@@ -543,8 +702,13 @@ namespace dawn_native {
 
     void DeviceBase::UncacheAttachmentState(AttachmentState* obj) {
         ASSERT(obj->IsCachedReference());
-        size_t removedCount = mCaches->attachmentStates.erase(obj);
-        ASSERT(removedCount == 1);
+        std::lock_guard<std::mutex> lock(mCaches->attachmentStatesMutex);
+
+        // Only remove |obj| if it wasn't already replaced by GetOrCreateAttachmentState.
+        auto iter = mCaches->attachmentStates.find(obj);
+        if (iter != mCaches->attachmentStates.end() && *iter == obj) {
+            mCaches->attachmentStates.erase(iter);
+        }
     }
 
     // Object creation API methods
@@ -580,6 +744,25 @@ namespace dawn_native {
 
         return result;
     }
+    void DeviceBase::CreateRayTracingPipelineAsync(
+        const RayTracingPipelineDescriptor* descriptor,
+        WGPUCreateRayTracingPipelineAsyncCallback callback,
+        void* userdata) {
+        std::unique_ptr<CreatePipelineAsyncTaskBase> task =
+            std::make_unique<CreateRayTracingPipelineAsyncTask>(callback, userdata);
+
+        // Errors are given to the callback instead of the error scopes.
+        MaybeError maybeError = CreateRayTracingPipelineAsyncInternal(task.get(), descriptor);
+        if (maybeError.IsError()) {
+            task->SetResult(maybeError.AcquireError());
+        } else if (!task->IsComplete()) {
+            // Ray tracing pipelines are created on the calling thread because backends allocate
+            // and write the memory of their shader group handles while creating them. Only the
+            // callback is deferred to the next Tick.
+            task->Run();
+        }
+        mCreatePipelineAsyncTracker->Track(std::move(task));
+    }
 
     BindGroupBase* DeviceBase::CreateBindGroup(const BindGroupDescriptor* descriptor) {
         BindGroupBase* result = nullptr;
@@ -654,6 +837,19 @@ namespace dawn_native {
 
         return result;
     }
+    void DeviceBase::CreateComputePipelineAsync(const ComputePipelineDescriptor* descriptor,
+                                                WGPUCreateComputePipelineAsyncCallback callback,
+                                                void* userdata) {
+        std::unique_ptr<CreatePipelineAsyncTaskBase> task =
+            std::make_unique<CreateComputePipelineAsyncTask>(callback, userdata);
+
+        // Errors are given to the callback instead of the error scopes.
+        MaybeError maybeError = CreateComputePipelineAsyncInternal(task.get(), descriptor);
+        if (maybeError.IsError()) {
+            task->SetResult(maybeError.AcquireError());
+        }
+        mCreatePipelineAsyncTracker->Track(std::move(task));
+    }
     PipelineLayoutBase* DeviceBase::CreatePipelineLayout(
         const PipelineLayoutDescriptor* descriptor) {
         PipelineLayoutBase* result = nullptr;
@@ -699,6 +895,19 @@ namespace dawn_native {
 
         return result;
     }
+    void DeviceBase::CreateRenderPipelineAsync(const RenderPipelineDescriptor* descriptor,
+                                               WGPUCreateRenderPipelineAsyncCallback callback,
+                                               void* userdata) {
+        std::unique_ptr<CreatePipelineAsyncTaskBase> task =
+            std::make_unique<CreateRenderPipelineAsyncTask>(callback, userdata);
+
+        // Errors are given to the callback instead of the error scopes.
+        MaybeError maybeError = CreateRenderPipelineAsyncInternal(task.get(), descriptor);
+        if (maybeError.IsError()) {
+            task->SetResult(maybeError.AcquireError());
+        }
+        mCreatePipelineAsyncTracker->Track(std::move(task));
+    }
     ShaderModuleBase* DeviceBase::CreateShaderModule(const ShaderModuleDescriptor* descriptor) {
         ShaderModuleBase* result = nullptr;
 
@@ -741,20 +950,32 @@ namespace dawn_native {
     // Other Device API methods
 
     void DeviceBase::Tick() {
+        TRACE_EVENT0(GetPlatform(), General, "DeviceBase::Tick");
         if (ConsumedError(ValidateIsAlive())) {
             return;
         }
-        if (ConsumedError(TickImpl())) {
-            return;
+        {
+            TRACE_EVENT0(GetPlatform(), General, "DeviceBase::TickImpl");
+            if (ConsumedError(TickImpl())) {
+                return;
+            }
         }
 
         // TODO(cwallez@chromium.org): decouple TickImpl from updating the serial so that we can
         // tick the dynamic uploader before the backend resource allocators. This would allow
         // reclaiming resources one tick earlier.
+        TRACE_EVENT1(GetPlatform(), General, "DeviceBase::TickTrackers", "completedSerial",
+                     GetCompletedCommandSerial());
         mDynamicUploader->Deallocate(GetCompletedCommandSerial());
         mErrorScopeTracker->Tick(GetCompletedCommandSerial());
         mFenceSignalTracker->Tick(GetCompletedCommandSerial());
         mMapRequestTracker->Tick(GetCompletedCommandSerial());
+        mCompactedSizeRequestTracker->Tick(GetCompletedCommandSerial());
+        mCreatePipelineAsyncTracker->Tick();
+    }
+
+    bool DeviceBase::CanCreatePipelinesOnWorkerThreads() const {
+        return false;
     }
 
     void DeviceBase::Reference() {
@@ -799,6 +1020,14 @@ namespace dawn_native {
         return !IsToggleEnabled(Toggle::SkipValidation);
     }
 
+    uint64_t DeviceBase::GetResourceStateGeneration() const {
+        return mResourceStateGeneration;
+    }
+
+    void DeviceBase::IncrementResourceStateGeneration() {
+        mResourceStateGeneration++;
+    }
+
     size_t DeviceBase::GetLazyClearCountForTesting() {
         return mLazyClearCountForTesting;
     }
@@ -874,6 +1103,51 @@ namespace dawn_native {
         return {};
     }
 
+    MaybeError DeviceBase::CreateComputePipelineAsyncInternal(
+        CreatePipelineAsyncTaskBase* task,
+        const ComputePipelineDescriptor* descriptor) {
+        DAWN_TRY(ValidateIsAlive());
+        if (IsValidationEnabled()) {
+            DAWN_TRY(ValidateComputePipelineDescriptor(this, descriptor));
+        }
+
+        Ref<PipelineLayoutBase> layout = descriptor->layout;
+        if (descriptor->layout == nullptr) {
+            PipelineLayoutBase* defaultLayout;
+            DAWN_TRY_ASSIGN(defaultLayout, PipelineLayoutBase::CreateDefault(
+                                               this, &descriptor->computeStage.module, 1));
+            layout = AcquireRef(defaultLayout);
+        }
+
+        ComputePipelineDescriptor descriptorWithLayout = *descriptor;
+        descriptorWithLayout.layout = layout.Get();
+
+        ComputePipelineBase blueprint(this, &descriptorWithLayout);
+        auto iter = mCaches->computePipelines.find(&blueprint);
+        if (iter != mCaches->computePipelines.end()) {
+            mStatisticsTracker.CacheHit(ObjectCacheType::ComputePipeline);
+            (*iter)->Reference();
+            task->SetResult(*iter);
+            return {};
+        }
+
+        // The creation might run after the descriptor is gone so it keeps its own references to
+        // the objects of the descriptor.
+        Ref<ShaderModuleBase> module = descriptor->computeStage.module;
+        std::string entryPoint = descriptor->computeStage.entryPoint;
+        task->SetCreateFunction(
+            [this, layout, module, entryPoint]() mutable -> ResultOrError<PipelineBase*> {
+                ComputePipelineDescriptor descriptor = {};
+                descriptor.layout = layout.Get();
+                descriptor.computeStage.module = module.Get();
+                descriptor.computeStage.entryPoint = entryPoint.c_str();
+
+                TRACE_EVENT0(GetPlatform(), General, "DeviceBase::CreateComputePipelineImpl");
+                return CreateComputePipelineImpl(&descriptor);
+            });
+        return {};
+    }
+
     MaybeError DeviceBase::CreatePipelineLayoutInternal(
         PipelineLayoutBase** result,
         const PipelineLayoutDescriptor* descriptor) {
@@ -891,6 +1165,10 @@ namespace dawn_native {
         if (IsValidationEnabled()) {
             DAWN_TRY(ValidateRayTracingAccelerationContainerDescriptor(this, descriptor));
         }
+
+        TRACE_EVENT2(GetPlatform(), General,
+                     "DeviceBase::CreateRayTracingAccelerationContainerImpl", "geometryCount",
+                     descriptor->geometryCount, "instanceCount", descriptor->instanceCount);
         DAWN_TRY_ASSIGN(*result, CreateRayTracingAccelerationContainerImpl(descriptor));
         return {};
     }
@@ -911,7 +1189,43 @@ namespace dawn_native {
         if (IsValidationEnabled()) {
             DAWN_TRY(ValidateRayTracingPipelineDescriptor(this, descriptor));
         }
-        DAWN_TRY_ASSIGN(*result, CreateRayTracingPipelineImpl(descriptor));
+        DAWN_TRY_ASSIGN(*result, GetOrCreateRayTracingPipeline(descriptor));
+        return {};
+    }
+
+    MaybeError DeviceBase::CreateRayTracingPipelineAsyncInternal(
+        CreatePipelineAsyncTaskBase* task,
+        const RayTracingPipelineDescriptor* descriptor) {
+        DAWN_TRY(ValidateIsAlive());
+        if (IsValidationEnabled()) {
+            DAWN_TRY(ValidateRayTracingPipelineDescriptor(this, descriptor));
+        }
+
+        RayTracingPipelineBase blueprint(this, descriptor);
+        auto iter = mCaches->rayTracingPipelines.find(&blueprint);
+        if (iter != mCaches->rayTracingPipelines.end()) {
+            mStatisticsTracker.CacheHit(ObjectCacheType::RayTracingPipeline);
+            (*iter)->Reference();
+            task->SetResult(*iter);
+            return {};
+        }
+
+        Ref<PipelineLayoutBase> layout = descriptor->layout;
+        Ref<RayTracingShaderBindingTableBase> shaderBindingTable =
+            descriptor->rayTracingState->shaderBindingTable;
+        RayTracingStateDescriptor rayTracingState = *descriptor->rayTracingState;
+        task->SetCreateFunction([this, layout, shaderBindingTable,
+                                 rayTracingState]() mutable -> ResultOrError<PipelineBase*> {
+            RayTracingStateDescriptor state = rayTracingState;
+            state.shaderBindingTable = shaderBindingTable.Get();
+
+            RayTracingPipelineDescriptor descriptor = {};
+            descriptor.layout = layout.Get();
+            descriptor.rayTracingState = &state;
+
+            TRACE_EVENT0(GetPlatform(), General, "DeviceBase::CreateRayTracingPipelineImpl");
+            return CreateRayTracingPipelineImpl(&descriptor);
+        });
         return {};
     }
 
@@ -960,6 +1274,53 @@ namespace dawn_native {
         return {};
     }
 
+    MaybeError DeviceBase::CreateRenderPipelineAsyncInternal(
+        CreatePipelineAsyncTaskBase* task,
+        const RenderPipelineDescriptor* descriptor) {
+        DAWN_TRY(ValidateIsAlive());
+        if (IsValidationEnabled()) {
+            DAWN_TRY(ValidateRenderPipelineDescriptor(this, descriptor));
+        }
+
+        Ref<PipelineLayoutBase> layout = descriptor->layout;
+        if (descriptor->layout == nullptr) {
+            const ShaderModuleBase* modules[2];
+            modules[0] = descriptor->vertexStage.module;
+            uint32_t count;
+            if (descriptor->fragmentStage == nullptr) {
+                count = 1;
+            } else {
+                modules[1] = descriptor->fragmentStage->module;
+                count = 2;
+            }
+
+            PipelineLayoutBase* defaultLayout;
+            DAWN_TRY_ASSIGN(defaultLayout, PipelineLayoutBase::CreateDefault(this, modules, count));
+            layout = AcquireRef(defaultLayout);
+        }
+
+        RenderPipelineDescriptor descriptorWithLayout = *descriptor;
+        descriptorWithLayout.layout = layout.Get();
+
+        RenderPipelineBase blueprint(this, &descriptorWithLayout);
+        auto iter = mCaches->renderPipelines.find(&blueprint);
+        if (iter != mCaches->renderPipelines.end()) {
+            mStatisticsTracker.CacheHit(ObjectCacheType::RenderPipeline);
+            (*iter)->Reference();
+            task->SetResult(*iter);
+            return {};
+        }
+
+        // The creation might run after the descriptor is gone so it uses a copy of it.
+        std::shared_ptr<RenderPipelineDescriptorStorage> storage =
+            std::make_shared<RenderPipelineDescriptorStorage>(&descriptorWithLayout);
+        task->SetCreateFunction([this, storage]() -> ResultOrError<PipelineBase*> {
+            TRACE_EVENT0(GetPlatform(), General, "DeviceBase::CreateRenderPipelineImpl");
+            return CreateRenderPipelineImpl(storage->GetDescriptor());
+        });
+        return {};
+    }
+
     MaybeError DeviceBase::CreateSamplerInternal(SamplerBase** result,
                                                  const SamplerDescriptor* descriptor) {
         DAWN_TRY(ValidateIsAlive());
@@ -1037,6 +1398,18 @@ namespace dawn_native {
         return mDynamicUploader.get();
     }
 
+    DeviceStatisticsTracker* DeviceBase::GetStatisticsTracker() {
+        return &mStatisticsTracker;
+    }
+
+    PersistentCache* DeviceBase::GetPersistentCache() const {
+        return mPersistentCache.get();
+    }
+
+    CommandBlockPool* DeviceBase::GetCommandBlockPool() const {
+        return mCommandBlockPool.get();
+    }
+
     // The Toggle device facility
 
     std::vector<const char*> DeviceBase::GetTogglesUsed() const {
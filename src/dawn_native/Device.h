@@ -16,6 +16,7 @@
 #define DAWNNATIVE_DEVICE_H_
 
 #include "common/Serial.h"
+#include "dawn_native/DeviceStatisticsTracker.h"
 #include "dawn_native/Error.h"
 #include "dawn_native/Extensions.h"
 #include "dawn_native/Format.h"
@@ -26,18 +27,25 @@
 #include "dawn_native/DawnNative.h"
 #include "dawn_native/dawn_platform.h"
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 
 namespace dawn_native {
     class AdapterBase;
     class AttachmentState;
     class AttachmentStateBlueprint;
     class BindGroupLayoutBase;
+    class CommandBlockPool;
     class DynamicUploader;
     class ErrorScope;
     class ErrorScopeTracker;
     class FenceSignalTracker;
+    class CompactedSizeRequestTracker;
+    class CreatePipelineAsyncTaskBase;
+    class CreatePipelineAsyncTracker;
     class MapRequestTracker;
+    class PersistentCache;
     class StagingBufferBase;
 
     class DeviceBase {
@@ -73,6 +81,7 @@ namespace dawn_native {
         ErrorScopeTracker* GetErrorScopeTracker() const;
         FenceSignalTracker* GetFenceSignalTracker() const;
         MapRequestTracker* GetMapRequestTracker() const;
+        CompactedSizeRequestTracker* GetCompactedSizeRequestTracker() const;
 
         // Returns the Format corresponding to the wgpu::TextureFormat or an error if the format
         // isn't a valid wgpu::TextureFormat or isn't supported by this device.
@@ -93,6 +102,11 @@ namespace dawn_native {
         Serial GetPendingCommandSerial() const;
         virtual MaybeError TickImpl() = 0;
 
+        // Whether the backend's Create{Compute,Render}PipelineImpl can run on worker threads
+        // concurrently with the rest of the device. Backends that can't have the pipelines of
+        // Create*PipelineAsync created on the calling thread instead.
+        virtual bool CanCreatePipelinesOnWorkerThreads() const;
+
         // Many Dawn objects are completely immutable once created which means that if two
         // creations are given the same arguments, they can return the same object. Reusing
         // objects will help make comparisons between objects by a single pointer comparison.
@@ -114,14 +128,23 @@ namespace dawn_native {
         ResultOrError<ComputePipelineBase*> GetOrCreateComputePipeline(
             const ComputePipelineDescriptor* descriptor);
         void UncacheComputePipeline(ComputePipelineBase* obj);
+        // Caches a pipeline created by Create*PipelineAsync, or returns the cached pipeline
+        // identical to it and releases |pipeline|.
+        ComputePipelineBase* AddOrGetCachedComputePipeline(ComputePipelineBase* pipeline);
 
         ResultOrError<PipelineLayoutBase*> GetOrCreatePipelineLayout(
             const PipelineLayoutDescriptor* descriptor);
         void UncachePipelineLayout(PipelineLayoutBase* obj);
 
+        ResultOrError<RayTracingPipelineBase*> GetOrCreateRayTracingPipeline(
+            const RayTracingPipelineDescriptor* descriptor);
+        void UncacheRayTracingPipeline(RayTracingPipelineBase* obj);
+        RayTracingPipelineBase* AddOrGetCachedRayTracingPipeline(RayTracingPipelineBase* pipeline);
+
         ResultOrError<RenderPipelineBase*> GetOrCreateRenderPipeline(
             const RenderPipelineDescriptor* descriptor);
         void UncacheRenderPipeline(RenderPipelineBase* obj);
+        RenderPipelineBase* AddOrGetCachedRenderPipeline(RenderPipelineBase* pipeline);
 
         ResultOrError<SamplerBase*> GetOrCreateSampler(const SamplerDescriptor* descriptor);
         void UncacheSampler(SamplerBase* obj);
@@ -144,17 +167,26 @@ namespace dawn_native {
             const RayTracingShaderBindingTableDescriptor* descriptor);
         RayTracingPipelineBase* CreateRayTracingPipeline(
             const RayTracingPipelineDescriptor* descriptor);
+        void CreateRayTracingPipelineAsync(const RayTracingPipelineDescriptor* descriptor,
+                                           WGPUCreateRayTracingPipelineAsyncCallback callback,
+                                           void* userdata);
         BindGroupBase* CreateBindGroup(const BindGroupDescriptor* descriptor);
         BindGroupLayoutBase* CreateBindGroupLayout(const BindGroupLayoutDescriptor* descriptor);
         BufferBase* CreateBuffer(const BufferDescriptor* descriptor);
         WGPUCreateBufferMappedResult CreateBufferMapped(const BufferDescriptor* descriptor);
         CommandEncoder* CreateCommandEncoder(const CommandEncoderDescriptor* descriptor);
         ComputePipelineBase* CreateComputePipeline(const ComputePipelineDescriptor* descriptor);
+        void CreateComputePipelineAsync(const ComputePipelineDescriptor* descriptor,
+                                        WGPUCreateComputePipelineAsyncCallback callback,
+                                        void* userdata);
         PipelineLayoutBase* CreatePipelineLayout(const PipelineLayoutDescriptor* descriptor);
         QueueBase* CreateQueue();
         RenderBundleEncoder* CreateRenderBundleEncoder(
             const RenderBundleEncoderDescriptor* descriptor);
         RenderPipelineBase* CreateRenderPipeline(const RenderPipelineDescriptor* descriptor);
+        void CreateRenderPipelineAsync(const RenderPipelineDescriptor* descriptor,
+                                       WGPUCreateRenderPipelineAsyncCallback callback,
+                                       void* userdata);
         SamplerBase* CreateSampler(const SamplerDescriptor* descriptor);
         ShaderModuleBase* CreateShaderModule(const ShaderModuleDescriptor* descriptor);
         SwapChainBase* CreateSwapChain(Surface* surface, const SwapChainDescriptor* descriptor);
@@ -171,6 +203,7 @@ namespace dawn_native {
         void SetUncapturedErrorCallback(wgpu::ErrorCallback callback, void* userdata);
         void PushErrorScope(wgpu::ErrorFilter filter);
         bool PopErrorScope(wgpu::ErrorCallback callback, void* userdata);
+        void GetStatistics(wgpu::DeviceStatisticsCallback callback, void* userdata);
 
         MaybeError ValidateIsAlive() const;
 
@@ -188,6 +221,11 @@ namespace dawn_native {
                                                    uint64_t size) = 0;
 
         DynamicUploader* GetDynamicUploader() const;
+        DeviceStatisticsTracker* GetStatisticsTracker();
+        PersistentCache* GetPersistentCache() const;
+        // The pool of the command blocks of all the encoders of the device. It can be used from
+        // any thread.
+        CommandBlockPool* GetCommandBlockPool() const;
 
         // The device state which is a combination of creation state and loss state.
         //
@@ -215,6 +253,14 @@ namespace dawn_native {
         bool IsExtensionEnabled(Extension extension) const;
         bool IsToggleEnabled(Toggle toggle) const;
         bool IsValidationEnabled() const;
+
+        // The resource state generation changes every time a buffer is mapped or a buffer, a
+        // texture or an acceleration container is destroyed, which are the only state changes
+        // that can make a command buffer invalid to submit. Command buffers that were valid to
+        // submit in the current generation don't need to check their resources again.
+        uint64_t GetResourceStateGeneration() const;
+        void IncrementResourceStateGeneration();
+
         size_t GetLazyClearCountForTesting();
         void IncrementLazyClearCountForTesting();
         size_t GetDeprecationWarningCountForTesting();
@@ -281,6 +327,9 @@ namespace dawn_native {
                                            const RayTracingShaderBindingTableDescriptor* descriptor);
         MaybeError CreateRayTracingPipelineInternal(RayTracingPipelineBase** result,
                                                     const RayTracingPipelineDescriptor* descriptor);
+        MaybeError CreateRayTracingPipelineAsyncInternal(
+            CreatePipelineAsyncTaskBase* task,
+            const RayTracingPipelineDescriptor* descriptor);
         MaybeError CreateBindGroupInternal(BindGroupBase** result,
                                            const BindGroupDescriptor* descriptor);
         MaybeError CreateBindGroupLayoutInternal(BindGroupLayoutBase** result,
@@ -288,6 +337,8 @@ namespace dawn_native {
         ResultOrError<BufferBase*> CreateBufferInternal(const BufferDescriptor* descriptor);
         MaybeError CreateComputePipelineInternal(ComputePipelineBase** result,
                                                  const ComputePipelineDescriptor* descriptor);
+        MaybeError CreateComputePipelineAsyncInternal(CreatePipelineAsyncTaskBase* task,
+                                                      const ComputePipelineDescriptor* descriptor);
         MaybeError CreatePipelineLayoutInternal(PipelineLayoutBase** result,
                                                 const PipelineLayoutDescriptor* descriptor);
         MaybeError CreateRenderBundleEncoderInternal(
@@ -295,6 +346,8 @@ namespace dawn_native {
             const RenderBundleEncoderDescriptor* descriptor);
         MaybeError CreateRenderPipelineInternal(RenderPipelineBase** result,
                                                 const RenderPipelineDescriptor* descriptor);
+        MaybeError CreateRenderPipelineAsyncInternal(CreatePipelineAsyncTaskBase* task,
+                                                     const RenderPipelineDescriptor* descriptor);
         MaybeError CreateSamplerInternal(SamplerBase** result, const SamplerDescriptor* descriptor);
         MaybeError CreateShaderModuleInternal(ShaderModuleBase** result,
                                               const ShaderModuleDescriptor* descriptor);
@@ -335,11 +388,22 @@ namespace dawn_native {
         // resources.
         virtual MaybeError WaitForIdleForDestruction() = 0;
 
+        // Lets the backend add the counters it tracks, like its memory usage and pending
+        // deletions, to the statistics returned by GetStatistics.
+        virtual void FillStatisticsImpl(DeviceStatistics* statistics) const;
+
         wgpu::DeviceLostCallback mDeviceLostCallback = nullptr;
         void* mDeviceLostUserdata = nullptr;
 
         AdapterBase* mAdapter = nullptr;
 
+        // Objects update the statistics until they are destroyed, so the tracker is declared
+        // before the members that can hold the last reference to an object.
+        DeviceStatisticsTracker mStatisticsTracker;
+
+        // Guards the error scopes and the error callbacks. It is recursive because the callbacks
+        // can call back into the device.
+        std::recursive_mutex mErrorMutex;
         Ref<ErrorScope> mRootErrorScope;
         Ref<ErrorScope> mCurrentErrorScope;
 
@@ -348,23 +412,28 @@ namespace dawn_native {
         struct Caches;
         std::unique_ptr<Caches> mCaches;
 
+        std::unique_ptr<CommandBlockPool> mCommandBlockPool;
         std::unique_ptr<DynamicUploader> mDynamicUploader;
         std::unique_ptr<ErrorScopeTracker> mErrorScopeTracker;
         std::unique_ptr<FenceSignalTracker> mFenceSignalTracker;
         std::unique_ptr<MapRequestTracker> mMapRequestTracker;
+        std::unique_ptr<PersistentCache> mPersistentCache;
+        std::unique_ptr<CompactedSizeRequestTracker> mCompactedSizeRequestTracker;
+        std::unique_ptr<CreatePipelineAsyncTracker> mCreatePipelineAsyncTracker;
         Ref<QueueBase> mDefaultQueue;
 
         struct DeprecationWarnings;
         std::unique_ptr<DeprecationWarnings> mDeprecationWarnings;
 
         uint32_t mRefCount = 1;
-        State mState = State::BeingCreated;
+        std::atomic<State> mState{State::BeingCreated};
 
         FormatTable mFormatTable;
 
         TogglesSet mEnabledToggles;
         TogglesSet mOverridenToggles;
         size_t mLazyClearCountForTesting = 0;
+        uint64_t mResourceStateGeneration = 1;
 
         ExtensionsSet mEnabledExtensions;
     };
@@ -0,0 +1,122 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/DeviceStatisticsTracker.h"
+
+#include "common/Assert.h"
+#include "dawn_native/Device.h"
+#include "dawn_native/ObjectBase.h"
+
+namespace dawn_native {
+
+    namespace {
+
+        template <typename Enum, size_t Size>
+        uint64_t Load(const std::array<std::atomic<uint64_t>, Size>& counters, Enum index) {
+            ASSERT(static_cast<size_t>(index) < Size);
+            return counters[static_cast<size_t>(index)].load(std::memory_order_relaxed);
+        }
+
+        template <typename Enum, size_t Size>
+        std::atomic<uint64_t>& At(std::array<std::atomic<uint64_t>, Size>& counters,
+                                  Enum index) {
+            ASSERT(static_cast<size_t>(index) < Size);
+            return counters[static_cast<size_t>(index)];
+        }
+
+    }  // anonymous namespace
+
+    void DeviceStatisticsTracker::ObjectCreated(CountedObjectType type) {
+        At(mLiveObjectCounts, type).fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void DeviceStatisticsTracker::ObjectDestroyed(CountedObjectType type) {
+        ASSERT(Load(mLiveObjectCounts, type) > 0);
+        At(mLiveObjectCounts, type).fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void DeviceStatisticsTracker::CacheHit(ObjectCacheType type) {
+        At(mCacheHits, type).fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void DeviceStatisticsTracker::CacheMiss(ObjectCacheType type) {
+        At(mCacheMisses, type).fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void DeviceStatisticsTracker::CommandsEncoded(uint64_t commandCount) {
+        mEncodedCommandCount.fetch_add(commandCount, std::memory_order_relaxed);
+    }
+
+    void DeviceStatisticsTracker::CommandBufferSubmitted(uint64_t commandCount) {
+        mSubmittedCommandBufferCount.fetch_add(1, std::memory_order_relaxed);
+        mSubmittedCommandCount.fetch_add(commandCount, std::memory_order_relaxed);
+    }
+
+    void DeviceStatisticsTracker::Fill(DeviceStatistics* statistics) const {
+        using Object = CountedObjectType;
+        statistics->bufferCount = Load(mLiveObjectCounts, Object::Buffer);
+        statistics->textureCount = Load(mLiveObjectCounts, Object::Texture);
+        statistics->textureViewCount = Load(mLiveObjectCounts, Object::TextureView);
+        statistics->samplerCount = Load(mLiveObjectCounts, Object::Sampler);
+        statistics->bindGroupCount = Load(mLiveObjectCounts, Object::BindGroup);
+        statistics->bindGroupLayoutCount = Load(mLiveObjectCounts, Object::BindGroupLayout);
+        statistics->pipelineLayoutCount = Load(mLiveObjectCounts, Object::PipelineLayout);
+        statistics->shaderModuleCount = Load(mLiveObjectCounts, Object::ShaderModule);
+        statistics->computePipelineCount = Load(mLiveObjectCounts, Object::ComputePipeline);
+        statistics->renderPipelineCount = Load(mLiveObjectCounts, Object::RenderPipeline);
+        statistics->rayTracingPipelineCount =
+            Load(mLiveObjectCounts, Object::RayTracingPipeline);
+        statistics->rayTracingAccelerationContainerCount =
+            Load(mLiveObjectCounts, Object::RayTracingAccelerationContainer);
+        statistics->rayTracingShaderBindingTableCount =
+            Load(mLiveObjectCounts, Object::RayTracingShaderBindingTable);
+        statistics->commandBufferCount = Load(mLiveObjectCounts, Object::CommandBuffer);
+        statistics->renderBundleCount = Load(mLiveObjectCounts, Object::RenderBundle);
+        statistics->fenceCount = Load(mLiveObjectCounts, Object::Fence);
+        statistics->swapChainCount = Load(mLiveObjectCounts, Object::SwapChain);
+
+        using Cache = ObjectCacheType;
+        statistics->bindGroupLayoutCacheHits = Load(mCacheHits, Cache::BindGroupLayout);
+        statistics->bindGroupLayoutCacheMisses = Load(mCacheMisses, Cache::BindGroupLayout);
+        statistics->computePipelineCacheHits = Load(mCacheHits, Cache::ComputePipeline);
+        statistics->computePipelineCacheMisses = Load(mCacheMisses, Cache::ComputePipeline);
+        statistics->pipelineLayoutCacheHits = Load(mCacheHits, Cache::PipelineLayout);
+        statistics->pipelineLayoutCacheMisses = Load(mCacheMisses, Cache::PipelineLayout);
+        statistics->rayTracingPipelineCacheHits = Load(mCacheHits, Cache::RayTracingPipeline);
+        statistics->rayTracingPipelineCacheMisses =
+            Load(mCacheMisses, Cache::RayTracingPipeline);
+        statistics->renderPipelineCacheHits = Load(mCacheHits, Cache::RenderPipeline);
+        statistics->renderPipelineCacheMisses = Load(mCacheMisses, Cache::RenderPipeline);
+        statistics->samplerCacheHits = Load(mCacheHits, Cache::Sampler);
+        statistics->samplerCacheMisses = Load(mCacheMisses, Cache::Sampler);
+        statistics->shaderModuleCacheHits = Load(mCacheHits, Cache::ShaderModule);
+        statistics->shaderModuleCacheMisses = Load(mCacheMisses, Cache::ShaderModule);
+
+        statistics->encodedCommandCount = mEncodedCommandCount.load(std::memory_order_relaxed);
+        statistics->submittedCommandBufferCount =
+            mSubmittedCommandBufferCount.load(std::memory_order_relaxed);
+        statistics->submittedCommandCount =
+            mSubmittedCommandCount.load(std::memory_order_relaxed);
+    }
+
+    LiveObjectCounter::LiveObjectCounter(const ObjectBase* object, CountedObjectType type)
+        : mTracker(object->GetDevice()->GetStatisticsTracker()), mType(type) {
+        mTracker->ObjectCreated(mType);
+    }
+
+    LiveObjectCounter::~LiveObjectCounter() {
+        mTracker->ObjectDestroyed(mType);
+    }
+
+}  // namespace dawn_native
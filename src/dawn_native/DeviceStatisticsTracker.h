@@ -0,0 +1,110 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_DEVICESTATISTICSTRACKER_H_
+#define DAWNNATIVE_DEVICESTATISTICSTRACKER_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace dawn_native {
+
+    class ObjectBase;
+    struct DeviceStatistics;
+
+    // The API objects whose live instances are counted by their device.
+    enum class CountedObjectType : uint32_t {
+        Buffer,
+        Texture,
+        TextureView,
+        Sampler,
+        BindGroup,
+        BindGroupLayout,
+        PipelineLayout,
+        ShaderModule,
+        ComputePipeline,
+        RenderPipeline,
+        RayTracingPipeline,
+        RayTracingAccelerationContainer,
+        RayTracingShaderBindingTable,
+        CommandBuffer,
+        RenderBundle,
+        Fence,
+        SwapChain,
+
+        Count,
+    };
+
+    // The GetOrCreate* caches of the device.
+    enum class ObjectCacheType : uint32_t {
+        BindGroupLayout,
+        ComputePipeline,
+        PipelineLayout,
+        RayTracingPipeline,
+        RenderPipeline,
+        Sampler,
+        ShaderModule,
+
+        Count,
+    };
+
+    // Keeps the frontend counters returned by Device::GetStatistics. The counters are atomic
+    // because objects are created and destroyed, and encoders are finished, on any thread.
+    class DeviceStatisticsTracker {
+      public:
+        void ObjectCreated(CountedObjectType type);
+        void ObjectDestroyed(CountedObjectType type);
+
+        void CacheHit(ObjectCacheType type);
+        void CacheMiss(ObjectCacheType type);
+
+        void CommandsEncoded(uint64_t commandCount);
+        void CommandBufferSubmitted(uint64_t commandCount);
+
+        // Writes the counters in |statistics|, leaving the ones tracked elsewhere untouched.
+        void Fill(DeviceStatistics* statistics) const;
+
+      private:
+        static constexpr size_t kCountedObjectTypeCount =
+            static_cast<size_t>(CountedObjectType::Count);
+        static constexpr size_t kObjectCacheTypeCount = static_cast<size_t>(ObjectCacheType::Count);
+
+        std::array<std::atomic<uint64_t>, kCountedObjectTypeCount> mLiveObjectCounts = {};
+        std::array<std::atomic<uint64_t>, kObjectCacheTypeCount> mCacheHits = {};
+        std::array<std::atomic<uint64_t>, kObjectCacheTypeCount> mCacheMisses = {};
+        std::atomic<uint64_t> mEncodedCommandCount{0};
+        std::atomic<uint64_t> mSubmittedCommandBufferCount{0};
+        std::atomic<uint64_t> mSubmittedCommandCount{0};
+    };
+
+    // Counts an API object as live in the statistics of its device for as long as it exists.
+    // Objects embed one as a member so that their constructors and destructors don't have to.
+    class LiveObjectCounter {
+      public:
+        LiveObjectCounter(const ObjectBase* object, CountedObjectType type);
+        ~LiveObjectCounter();
+
+        LiveObjectCounter(const LiveObjectCounter&) = delete;
+        LiveObjectCounter& operator=(const LiveObjectCounter&) = delete;
+
+      private:
+        DeviceStatisticsTracker* mTracker;
+        CountedObjectType mType;
+    };
+
+}  // namespace dawn_native
+
+#endif  // DAWNNATIVE_DEVICESTATISTICSTRACKER_H_
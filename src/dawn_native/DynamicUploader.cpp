@@ -15,6 +15,8 @@
 #include "dawn_native/DynamicUploader.h"
 #include "common/Math.h"
 #include "dawn_native/Device.h"
+#include "dawn_platform/DawnPlatform.h"
+#include "dawn_platform/tracing/TraceEvent.h"
 
 namespace dawn_native {
 
@@ -29,6 +31,10 @@ namespace dawn_native {
     }
 
     ResultOrError<UploadHandle> DynamicUploader::Allocate(uint64_t allocationSize, Serial serial) {
+        TRACE_EVENT1(mDevice->GetPlatform(), General, "DynamicUploader::Allocate", "size",
+                     allocationSize);
+        mUploadedSizeSinceDeallocate += allocationSize;
+
         // Disable further sub-allocation should the request be too large.
         if (allocationSize > kRingBufferSize) {
             std::unique_ptr<StagingBufferBase> stagingBuffer;
@@ -77,6 +83,7 @@ namespace dawn_native {
         // Allocate the staging buffer backing the ringbuffer.
         // Note: the first ringbuffer will be lazily created.
         if (targetRingBuffer->mStagingBuffer == nullptr) {
+            TRACE_EVENT0(mDevice->GetPlatform(), General, "DynamicUploader::CreateRingBuffer");
             std::unique_ptr<StagingBufferBase> stagingBuffer;
             DAWN_TRY_ASSIGN(stagingBuffer,
                             mDevice->CreateStagingBuffer(targetRingBuffer->mAllocator.GetSize()));
@@ -107,5 +114,37 @@ namespace dawn_native {
             }
         }
         mReleasedStagingBuffers.ClearUpTo(lastCompletedSerial);
+
+        // Deallocate is called once per device tick, so this traces the upload rate.
+        dawn_platform::Platform* platform = mDevice->GetPlatform();
+        TRACE_COUNTER_UINT64(platform, General, "DynamicUploader::UploadedBytes",
+                             mUploadedSizeSinceDeallocate);
+        TRACE_COUNTER_UINT64(platform, General, "DynamicUploader::RingBufferCount",
+                             mRingBuffers.size());
+        mUploadedSizeSinceDeallocate = 0;
+    }
+
+    uint64_t DynamicUploader::GetStagingMemorySize() const {
+        uint64_t size = 0;
+        for (const auto& ringBuffer : mRingBuffers) {
+            if (ringBuffer->mStagingBuffer != nullptr) {
+                size += ringBuffer->mStagingBuffer->GetSize();
+            }
+        }
+        for (const auto& stagingBuffer : mReleasedStagingBuffers.IterateAll()) {
+            size += stagingBuffer->GetSize();
+        }
+        return size;
+    }
+
+    uint64_t DynamicUploader::GetStagingBytesInFlight() const {
+        uint64_t size = 0;
+        for (const auto& ringBuffer : mRingBuffers) {
+            size += ringBuffer->mAllocator.GetUsedSize();
+        }
+        for (const auto& stagingBuffer : mReleasedStagingBuffers.IterateAll()) {
+            size += stagingBuffer->GetSize();
+        }
+        return size;
     }
 }  // namespace dawn_native
\ No newline at end of file
@@ -43,6 +43,11 @@ namespace dawn_native {
         ResultOrError<UploadHandle> Allocate(uint64_t allocationSize, Serial serial);
         void Deallocate(Serial lastCompletedSerial);
 
+        // The size of the staging buffers owned by the uploader, and of the parts of them the
+        // GPU may still be reading from, reported by Device::GetStatistics.
+        uint64_t GetStagingMemorySize() const;
+        uint64_t GetStagingBytesInFlight() const;
+
       private:
         static constexpr uint64_t kRingBufferSize = 4 * 1024 * 1024;
 
@@ -54,6 +59,9 @@ namespace dawn_native {
         std::vector<std::unique_ptr<RingBuffer>> mRingBuffers;
         SerialQueue<std::unique_ptr<StagingBufferBase>> mReleasedStagingBuffers;
         DeviceBase* mDevice;
+
+        // Reported to tracing and reset when the uploader is ticked.
+        uint64_t mUploadedSizeSinceDeallocate = 0;
     };
 }  // namespace dawn_native
 
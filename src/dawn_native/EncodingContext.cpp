@@ -20,17 +20,27 @@
 #include "dawn_native/Device.h"
 #include "dawn_native/ErrorData.h"
 #include "dawn_native/RenderBundleEncoder.h"
+#include "dawn_platform/DawnPlatform.h"
+#include "dawn_platform/tracing/TraceEvent.h"
 
 namespace dawn_native {
 
-    EncodingContext::EncodingContext(DeviceBase* device, const ObjectBase* initialEncoder)
-        : mDevice(device), mTopLevelEncoder(initialEncoder), mCurrentEncoder(initialEncoder) {
+    EncodingContext::EncodingContext(DeviceBase* device,
+                                     const ObjectBase* initialEncoder,
+                                     bool useCommandSizeHint)
+        : mDevice(device),
+          mTopLevelEncoder(initialEncoder),
+          mCurrentEncoder(initialEncoder),
+          mAllocator(device->GetCommandBlockPool(), useCommandSizeHint) {
     }
 
     EncodingContext::~EncodingContext() {
         if (!mWereCommandsAcquired) {
             FreeCommands(GetIterator());
         }
+        for (ObjectBase* object : mReferencedObjects) {
+            object->Release();
+        }
     }
 
     CommandIterator EncodingContext::AcquireCommands() {
@@ -40,6 +50,16 @@ namespace dawn_native {
         return std::move(mIterator);
     }
 
+    std::vector<Ref<ObjectBase>> EncodingContext::AcquireObjectReferences() {
+        std::vector<Ref<ObjectBase>> references;
+        references.reserve(mReferencedObjects.Size());
+        for (ObjectBase* object : mReferencedObjects) {
+            references.push_back(AcquireRef(object));
+        }
+        mReferencedObjects.Clear();
+        return references;
+    }
+
     CommandIterator* EncodingContext::GetIterator() {
         MoveToIterator();
         ASSERT(!mWereCommandsAcquired);
@@ -109,6 +129,10 @@ namespace dawn_native {
         mCurrentEncoder = nullptr;
         mTopLevelEncoder = nullptr;
 
+        TRACE_COUNTER_UINT64(mDevice->GetPlatform(), Recording,
+                             "EncodingContext::EncodedCommands", mEncodedCommandCount);
+        mDevice->GetStatisticsTracker()->CommandsEncoded(mEncodedCommandCount);
+
         if (mGotError) {
             return DAWN_VALIDATION_ERROR(mErrorMessage);
         }
@@ -118,6 +142,10 @@ namespace dawn_native {
         return {};
     }
 
+    uint32_t EncodingContext::GetEncodedCommandCount() const {
+        return mEncodedCommandCount;
+    }
+
     bool EncodingContext::IsFinished() const {
         return mTopLevelEncoder == nullptr;
     }
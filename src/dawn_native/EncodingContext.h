@@ -15,24 +15,30 @@
 #ifndef DAWNNATIVE_ENCODINGCONTEXT_H_
 #define DAWNNATIVE_ENCODINGCONTEXT_H_
 
+#include "common/FlatPointerMap.h"
 #include "dawn_native/CommandAllocator.h"
 #include "dawn_native/Error.h"
 #include "dawn_native/ErrorData.h"
+#include "dawn_native/ObjectBase.h"
 #include "dawn_native/PassResourceUsageTracker.h"
 #include "dawn_native/dawn_platform.h"
 
 #include <string>
+#include <vector>
 
 namespace dawn_native {
 
     class DeviceBase;
-    class ObjectBase;
 
     // Base class for allocating/iterating commands.
     // It performs error tracking as well as encoding state for render/compute passes.
     class EncodingContext {
       public:
-        EncodingContext(DeviceBase* device, const ObjectBase* initialEncoder);
+        // |useCommandSizeHint| sizes the first command block with the device's recent command
+        // buffers, see CommandAllocator.
+        EncodingContext(DeviceBase* device,
+                        const ObjectBase* initialEncoder,
+                        bool useCommandSizeHint);
         ~EncodingContext();
 
         CommandIterator AcquireCommands();
@@ -67,9 +73,24 @@ namespace dawn_native {
                 return false;
             }
             ASSERT(!mWasMovedToIterator);
-            return !ConsumedError(encodeFunction(&mAllocator));
+            if (ConsumedError(encodeFunction(&mAllocator))) {
+                return false;
+            }
+            mEncodedCommandCount++;
+            return true;
         }
 
+        // Keeps a reference to |object| until the commands are destroyed so that the commands can
+        // store a raw pointer to it. Only the first call for each object adds a reference, which
+        // avoids an atomic operation for each command using the object.
+        inline void ReferenceObject(ObjectBase* object) {
+            if (mReferencedObjects.Insert(object).second) {
+                object->Reference();
+            }
+        }
+        // The references must be kept by the object that owns the commands.
+        std::vector<Ref<ObjectBase>> AcquireObjectReferences();
+
         // Functions to set current encoder state
         void EnterPass(const ObjectBase* passEncoder);
         void ExitPass(const ObjectBase* passEncoder, PassResourceUsage passUsages);
@@ -78,6 +99,8 @@ namespace dawn_native {
         const PerPassUsages& GetPassUsages() const;
         PerPassUsages AcquirePassUsages();
 
+        uint32_t GetEncodedCommandCount() const;
+
       private:
         bool IsFinished() const;
         void MoveToIterator();
@@ -97,10 +120,15 @@ namespace dawn_native {
         PerPassUsages mPassUsages;
         bool mWerePassUsagesAcquired = false;
 
+        FlatPointerSet<ObjectBase> mReferencedObjects;
+
         CommandAllocator mAllocator;
         CommandIterator mIterator;
         bool mWasMovedToIterator = false;
         bool mWereCommandsAcquired = false;
+        // Number of successful TryEncode calls, reported to tracing and to the device statistics
+        // when encoding finishes.
+        uint32_t mEncodedCommandCount = 0;
 
         bool mGotError = false;
         std::string mErrorMessage;
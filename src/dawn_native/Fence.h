@@ -16,6 +16,7 @@
 #define DAWNNATIVE_FENCE_H_
 
 #include "common/SerialMap.h"
+#include "dawn_native/DeviceStatisticsTracker.h"
 #include "dawn_native/Error.h"
 #include "dawn_native/Forward.h"
 #include "dawn_native/ObjectBase.h"
@@ -62,6 +63,8 @@ namespace dawn_native {
         uint64_t mCompletedValue;
         Ref<QueueBase> mQueue;
         SerialMap<OnCompletionData> mRequests;
+
+        LiveObjectCounter mLiveObjectCounter{this, CountedObjectType::Fence};
     };
 
 }  // namespace dawn_native
@@ -19,6 +19,10 @@
 #include "dawn_native/ErrorData.h"
 #include "dawn_native/Surface.h"
 
+#if defined(DAWN_ENABLE_BACKEND_VULKAN)
+#    include "dawn_native/VulkanBackend.h"
+#endif  // defined(DAWN_ENABLE_BACKEND_VULKAN)
+
 namespace dawn_native {
 
     // Forward definitions of each backend's "Connect" function that creates new BackendConnection.
@@ -46,6 +50,7 @@ namespace dawn_native {
 #if defined(DAWN_ENABLE_BACKEND_VULKAN)
     namespace vulkan {
         BackendConnection* Connect(InstanceBase* instance, bool useSwiftshader);
+        BackendConnection* ConnectFakeDriver(InstanceBase* instance);
     }
 #endif  // defined(DAWN_ENABLE_BACKEND_VULKAN)
 
@@ -156,9 +161,32 @@ namespace dawn_native {
         mBackendsConnected = true;
     }
 
+    void InstanceBase::EnsureFakeVulkanDriverConnection() {
+        if (mFakeVulkanDriverConnected) {
+            return;
+        }
+
+#if defined(DAWN_ENABLE_BACKEND_VULKAN)
+        BackendConnection* connection = vulkan::ConnectFakeDriver(this);
+        if (connection != nullptr) {
+            ASSERT(connection->GetType() == wgpu::BackendType::Vulkan);
+            mBackends.push_back(std::unique_ptr<BackendConnection>(connection));
+        }
+#endif  // defined(DAWN_ENABLE_BACKEND_VULKAN)
+
+        mFakeVulkanDriverConnected = true;
+    }
+
     MaybeError InstanceBase::DiscoverAdaptersInternal(const AdapterDiscoveryOptionsBase* options) {
         EnsureBackendConnections();
 
+#if defined(DAWN_ENABLE_BACKEND_VULKAN)
+        if (options->backendType == WGPUBackendType_Vulkan &&
+            static_cast<const vulkan::AdapterDiscoveryOptions*>(options)->useFakeDriver) {
+            EnsureFakeVulkanDriverConnection();
+        }
+#endif  // defined(DAWN_ENABLE_BACKEND_VULKAN)
+
         bool foundBackend = false;
         for (std::unique_ptr<BackendConnection>& backend : mBackends) {
             if (backend->GetType() != static_cast<wgpu::BackendType>(options->backendType)) {
@@ -80,10 +80,14 @@ namespace dawn_native {
 
         // Lazily creates connections to all backends that have been compiled.
         void EnsureBackendConnections();
+        // The fake Vulkan driver is only connected when its adapters are discovered, which only
+        // tests do.
+        void EnsureFakeVulkanDriverConnection();
 
         MaybeError DiscoverAdaptersInternal(const AdapterDiscoveryOptionsBase* options);
 
         bool mBackendsConnected = false;
+        bool mFakeVulkanDriverConnected = false;
         bool mDiscoveredDefaultAdapters = false;
 
         bool mEnableBackendValidation = false;
@@ -15,6 +15,8 @@
 #include "dawn_native/MapRequestTracker.h"
 #include "dawn_native/Buffer.h"
 #include "dawn_native/Device.h"
+#include "dawn_platform/DawnPlatform.h"
+#include "dawn_platform/tracing/TraceEvent.h"
 
 namespace dawn_native {
     struct Request;
@@ -37,6 +39,7 @@ namespace dawn_native {
     }
 
     void MapRequestTracker::Tick(Serial finishedSerial) {
+        TRACE_EVENT0(mDevice->GetPlatform(), General, "MapRequestTracker::Tick");
         for (auto& request : mInflightRequests.IterateUpTo(finishedSerial)) {
             request.buffer->OnMapCommandSerialFinished(request.mapSerial, request.isWrite);
         }
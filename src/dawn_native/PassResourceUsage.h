@@ -15,9 +15,9 @@
 #ifndef DAWNNATIVE_PASSRESOURCEUSAGE_H
 #define DAWNNATIVE_PASSRESOURCEUSAGE_H
 
+#include "common/FlatPointerMap.h"
 #include "dawn_native/dawn_platform.h"
 
-#include <set>
 #include <vector>
 
 namespace dawn_native {
@@ -55,9 +55,9 @@ namespace dawn_native {
 
     struct CommandBufferResourceUsage {
         PerPassUsages perPass;
-        std::set<BufferBase*> topLevelBuffers;
-        std::set<TextureBase*> topLevelTextures;
-        std::set<RayTracingAccelerationContainerBase*> topLevelAccelerationContainers;
+        FlatPointerSet<BufferBase> topLevelBuffers;
+        FlatPointerSet<TextureBase> topLevelTextures;
+        FlatPointerSet<RayTracingAccelerationContainerBase> topLevelAccelerationContainers;
     };
 
 }  // namespace dawn_native
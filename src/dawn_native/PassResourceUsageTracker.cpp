@@ -22,7 +22,7 @@ namespace dawn_native {
     }
 
     void PassResourceUsageTracker::BufferUsedAs(BufferBase* buffer, wgpu::BufferUsage usage) {
-        // std::map's operator[] will create the key and return 0 if the key didn't exist
+        // FlatPointerMap's operator[] will create the key and return 0 if the key didn't exist
         // before.
         mBufferUsages[buffer] |= usage;
     }
@@ -35,9 +35,8 @@ namespace dawn_native {
         uint32_t baseArrayLayer = view->GetBaseArrayLayer();
         uint32_t layerCount = view->GetLayerCount();
 
-        // std::map's operator[] will create the key and return a PassTextureUsage with usage = 0
-        // and an empty vector for subresourceUsages.
-        // TODO (yunchao.he@intel.com): optimize this
+        // FlatPointerMap's operator[] will create the key and return a PassTextureUsage with
+        // usage = 0 and an empty vector for subresourceUsages.
         PassTextureUsage& textureUsage = mTextureUsages[texture];
 
         // Set usage for the whole texture
@@ -79,23 +78,11 @@ namespace dawn_native {
     PassResourceUsage PassResourceUsageTracker::AcquireResourceUsage() {
         PassResourceUsage result;
         result.passType = mPassType;
-        result.buffers.reserve(mBufferUsages.size());
-        result.bufferUsages.reserve(mBufferUsages.size());
-        result.textures.reserve(mTextureUsages.size());
-        result.textureUsages.reserve(mTextureUsages.size());
 
-        for (auto& it : mBufferUsages) {
-            result.buffers.push_back(it.first);
-            result.bufferUsages.push_back(it.second);
-        }
-
-        for (auto& it : mTextureUsages) {
-            result.textures.push_back(it.first);
-            result.textureUsages.push_back(std::move(it.second));
-        }
-
-        mBufferUsages.clear();
-        mTextureUsages.clear();
+        // The usages are stored in insertion order in the same layout as PassResourceUsage so
+        // they are moved into it without copies.
+        mBufferUsages.Acquire(&result.buffers, &result.bufferUsages);
+        mTextureUsages.Acquire(&result.textures, &result.textureUsages);
 
         return result;
     }
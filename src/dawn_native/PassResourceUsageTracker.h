@@ -15,12 +15,11 @@
 #ifndef DAWNNATIVE_PASSRESOURCEUSAGETRACKER_H_
 #define DAWNNATIVE_PASSRESOURCEUSAGETRACKER_H_
 
+#include "common/FlatPointerMap.h"
 #include "dawn_native/PassResourceUsage.h"
 
 #include "dawn_native/dawn_platform.h"
 
-#include <map>
-
 namespace dawn_native {
 
     class BufferBase;
@@ -42,8 +41,8 @@ namespace dawn_native {
 
       private:
         PassType mPassType;
-        std::map<BufferBase*, wgpu::BufferUsage> mBufferUsages;
-        std::map<TextureBase*, PassTextureUsage> mTextureUsages;
+        FlatPointerMap<BufferBase, wgpu::BufferUsage> mBufferUsages;
+        FlatPointerMap<TextureBase, PassTextureUsage> mTextureUsages;
     };
 
 }  // namespace dawn_native
@@ -0,0 +1,114 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/PersistentCache.h"
+
+#include "common/Assert.h"
+#include "dawn_native/Adapter.h"
+#include "dawn_native/Device.h"
+#include "dawn_platform/DawnPlatform.h"
+
+#include <sstream>
+
+namespace dawn_native {
+
+    // PersistentCacheKeyRecorder
+
+    PersistentCacheKeyRecorder::PersistentCacheKeyRecorder(const DeviceBase* device,
+                                                           PersistentKeyType type) {
+        Record(type);
+        for (const char* toggle : device->GetTogglesUsed()) {
+            Record(std::string(toggle));
+        }
+    }
+
+    PersistentCacheKeyRecorder& PersistentCacheKeyRecorder::Record(const std::string& value) {
+        return RecordBytes(value.data(), value.size());
+    }
+
+    PersistentCacheKeyRecorder& PersistentCacheKeyRecorder::Record(
+        const std::vector<uint32_t>& value) {
+        return RecordBytes(value.data(), value.size() * sizeof(uint32_t));
+    }
+
+    PersistentCacheKeyRecorder& PersistentCacheKeyRecorder::RecordBytes(const void* data,
+                                                                        size_t size) {
+        // Prefix variable-sized data with its size so that consecutive values can't be confused.
+        Record(size);
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        mKey.insert(mKey.end(), bytes, bytes + size);
+        return *this;
+    }
+
+    PersistentCacheKey PersistentCacheKeyRecorder::GetKey() {
+        return std::move(mKey);
+    }
+
+    // PersistentCache
+
+    PersistentCache::PersistentCache(DeviceBase* device) : mDevice(device) {
+    }
+
+    ScopedCachedBlob PersistentCache::LoadData(const PersistentCacheKey& key) {
+        ScopedCachedBlob blob = {};
+        dawn_platform::CachingInterface* cache = GetPlatformCache();
+        if (cache == nullptr) {
+            return blob;
+        }
+
+        blob.bufferSize = cache->LoadData(key.data(), key.size(), nullptr, 0);
+        if (blob.bufferSize > 0) {
+            blob.buffer.reset(new uint8_t[blob.bufferSize]);
+            const size_t bufferSize =
+                cache->LoadData(key.data(), key.size(), blob.buffer.get(), blob.bufferSize);
+            ASSERT(bufferSize == blob.bufferSize);
+        }
+        return blob;
+    }
+
+    void PersistentCache::StoreData(const PersistentCacheKey& key, const void* value, size_t size) {
+        dawn_platform::CachingInterface* cache = GetPlatformCache();
+        if (cache == nullptr) {
+            return;
+        }
+        ASSERT(value != nullptr);
+        ASSERT(size > 0);
+        cache->StoreData(key.data(), key.size(), value, size);
+    }
+
+    dawn_platform::CachingInterface* PersistentCache::GetPlatformCache() {
+        // The platform is only queried once, the first time the device needs the cache.
+        if (mIsPlatformCacheQueried) {
+            return mCache;
+        }
+        mIsPlatformCacheQueried = true;
+
+        dawn_platform::Platform* platform = mDevice->GetPlatform();
+        if (platform == nullptr) {
+            return nullptr;
+        }
+
+        // Values produced for one adapter must never be used on another one.
+        const AdapterBase* adapter = mDevice->GetAdapter();
+        std::ostringstream fingerprint;
+        fingerprint << static_cast<uint32_t>(adapter->GetBackendType()) << ":"
+                    << adapter->GetPCIInfo().vendorId << ":" << adapter->GetPCIInfo().deviceId
+                    << ":" << adapter->GetPCIInfo().name;
+        const std::string fingerprintString = fingerprint.str();
+
+        mCache = platform->GetCachingInterface(fingerprintString.data(), fingerprintString.size());
+        return mCache;
+    }
+
+}  // namespace dawn_native
@@ -0,0 +1,88 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_PERSISTENTCACHE_H_
+#define DAWNNATIVE_PERSISTENTCACHE_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace dawn_platform {
+    class CachingInterface;
+}
+
+namespace dawn_native {
+
+    using PersistentCacheKey = std::vector<uint8_t>;
+
+    struct ScopedCachedBlob {
+        std::unique_ptr<uint8_t[]> buffer;
+        size_t bufferSize = 0;
+    };
+
+    class DeviceBase;
+
+    enum class PersistentKeyType { Shader, PipelineCache };
+
+    // Serializes everything the result of a compilation depends on into a PersistentCacheKey.
+    // The key holds the inputs themselves rather than a hash of them so that a collision can
+    // never return the wrong binary. The device's enabled toggles are always part of the key.
+    class PersistentCacheKeyRecorder {
+      public:
+        PersistentCacheKeyRecorder(const DeviceBase* device, PersistentKeyType type);
+
+        template <typename T>
+        PersistentCacheKeyRecorder& Record(const T& value) {
+            static_assert(std::is_trivially_copyable<T>::value,
+                          "Only trivially copyable values can be recorded directly");
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+            mKey.insert(mKey.end(), bytes, bytes + sizeof(T));
+            return *this;
+        }
+        PersistentCacheKeyRecorder& Record(const std::string& value);
+        PersistentCacheKeyRecorder& Record(const std::vector<uint32_t>& value);
+        PersistentCacheKeyRecorder& RecordBytes(const void* data, size_t size);
+
+        PersistentCacheKey GetKey();
+
+      private:
+        PersistentCacheKey mKey;
+    };
+
+    // Stores the results of expensive compilations, such as translated shaders and backend
+    // pipeline caches, in the embedder-provided dawn_platform::CachingInterface so that they can
+    // be reused by later runs. All operations are no-ops if the platform doesn't provide one.
+    class PersistentCache {
+      public:
+        PersistentCache(DeviceBase* device);
+
+        // Returns an empty blob if there is no value for |key|.
+        ScopedCachedBlob LoadData(const PersistentCacheKey& key);
+        void StoreData(const PersistentCacheKey& key, const void* value, size_t size);
+
+      private:
+        dawn_platform::CachingInterface* GetPlatformCache();
+
+        DeviceBase* mDevice = nullptr;
+
+        bool mIsPlatformCacheQueried = false;
+        dawn_platform::CachingInterface* mCache = nullptr;
+    };
+
+}  // namespace dawn_native
+
+#endif  // DAWNNATIVE_PERSISTENTCACHE_H_
@@ -17,6 +17,7 @@
 
 #include "common/Constants.h"
 #include "dawn_native/CachedObject.h"
+#include "dawn_native/DeviceStatisticsTracker.h"
 #include "dawn_native/Error.h"
 #include "dawn_native/Forward.h"
 
@@ -66,6 +67,9 @@ namespace dawn_native {
 
         BindGroupLayoutArray mBindGroupLayouts;
         std::bitset<kMaxBindGroups> mMask;
+
+      private:
+        LiveObjectCounter mLiveObjectCounter{this, CountedObjectType::PipelineLayout};
     };
 
 }  // namespace dawn_native
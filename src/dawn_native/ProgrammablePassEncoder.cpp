@@ -20,6 +20,7 @@
 #include "dawn_native/BindGroup.h"
 #include "dawn_native/Buffer.h"
 #include "dawn_native/CommandBuffer.h"
+#include "dawn_native/CommandValidation.h"
 #include "dawn_native/Commands.h"
 #include "dawn_native/Device.h"
 #include "dawn_native/ValidationUtils_autogen.h"
@@ -113,6 +114,11 @@ namespace dawn_native {
 
     void ProgrammablePassEncoder::PopDebugGroup() {
         mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
+            if (GetDevice()->IsValidationEnabled()) {
+                DAWN_TRY(ValidateCanPopDebugGroup(mDebugGroupStackSize));
+                mDebugGroupStackSize--;
+            }
+
             allocator->Allocate<PopDebugGroupCmd>(Command::PopDebugGroup);
 
             return {};
@@ -128,6 +134,10 @@ namespace dawn_native {
             char* label = allocator->AllocateData<char>(cmd->length + 1);
             memcpy(label, groupLabel, cmd->length + 1);
 
+            if (GetDevice()->IsValidationEnabled()) {
+                mDebugGroupStackSize++;
+            }
+
             return {};
         });
     }
@@ -183,12 +193,15 @@ namespace dawn_native {
                         return DAWN_VALIDATION_ERROR("dynamic offset out of bounds");
                     }
                 }
+
+                mCommandBufferState.SetBindGroup(groupIndex, group);
             }
 
             SetBindGroupCmd* cmd = allocator->Allocate<SetBindGroupCmd>(Command::SetBindGroup);
             cmd->index = groupIndex;
             cmd->group = group;
             cmd->dynamicOffsetCount = dynamicOffsetCount;
+            mEncodingContext->ReferenceObject(group);
             if (dynamicOffsetCount > 0) {
                 uint32_t* offsets = allocator->AllocateData<uint32_t>(cmd->dynamicOffsetCount);
                 memcpy(offsets, dynamicOffsets, dynamicOffsetCount * sizeof(uint32_t));
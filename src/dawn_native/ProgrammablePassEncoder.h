@@ -15,6 +15,7 @@
 #ifndef DAWNNATIVE_PROGRAMMABLEPASSENCODER_H_
 #define DAWNNATIVE_PROGRAMMABLEPASSENCODER_H_
 
+#include "dawn_native/CommandBufferStateTracker.h"
 #include "dawn_native/CommandEncoder.h"
 #include "dawn_native/Error.h"
 #include "dawn_native/ObjectBase.h"
@@ -52,6 +53,11 @@ namespace dawn_native {
 
         EncodingContext* mEncodingContext = nullptr;
         PassResourceUsageTracker mUsageTracker;
+
+        // The validation state of the pass is updated as commands are recorded so that finishing
+        // the encoder doesn't need to iterate over the commands again.
+        CommandBufferStateTracker mCommandBufferState;
+        uint64_t mDebugGroupStackSize = 0;
     };
 
 }  // namespace dawn_native
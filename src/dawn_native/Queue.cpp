@@ -14,15 +14,12 @@
 
 #include "dawn_native/Queue.h"
 
-#include "dawn_native/Buffer.h"
 #include "dawn_native/CommandBuffer.h"
 #include "dawn_native/Device.h"
 #include "dawn_native/ErrorScope.h"
 #include "dawn_native/ErrorScopeTracker.h"
 #include "dawn_native/Fence.h"
 #include "dawn_native/FenceSignalTracker.h"
-#include "dawn_native/RayTracingAccelerationContainer.h"
-#include "dawn_native/Texture.h"
 #include "dawn_platform/DawnPlatform.h"
 #include "dawn_platform/tracing/TraceEvent.h"
 
@@ -53,7 +50,8 @@ namespace dawn_native {
             return;
         }
 
-        TRACE_EVENT0(device->GetPlatform(), General, "Queue::Submit");
+        TRACE_EVENT1(device->GetPlatform(), General, "Queue::Submit", "commandCount",
+                     commandCount);
         if (device->IsValidationEnabled() &&
             device->ConsumedError(ValidateSubmit(commandCount, commands))) {
             return;
@@ -63,6 +61,9 @@ namespace dawn_native {
         if (device->ConsumedError(SubmitImpl(commandCount, commands))) {
             return;
         }
+        for (uint32_t i = 0; i < commandCount; ++i) {
+            device->GetStatisticsTracker()->CommandBufferSubmitted(commands[i]->GetCommandCount());
+        }
         device->GetErrorScopeTracker()->TrackUntilLastSubmitComplete(
             device->GetCurrentErrorScope());
     }
@@ -99,31 +100,7 @@ namespace dawn_native {
 
         for (uint32_t i = 0; i < commandCount; ++i) {
             DAWN_TRY(GetDevice()->ValidateObject(commands[i]));
-
-            const CommandBufferResourceUsage& usages = commands[i]->GetResourceUsages();
-
-            for (const PassResourceUsage& passUsages : usages.perPass) {
-                for (const BufferBase* buffer : passUsages.buffers) {
-                    DAWN_TRY(buffer->ValidateCanUseInSubmitNow());
-                }
-                for (const TextureBase* texture : passUsages.textures) {
-                    DAWN_TRY(texture->ValidateCanUseInSubmitNow());
-                }
-                for (const RayTracingAccelerationContainerBase* container : passUsages.accelerationContainers) {
-                    DAWN_TRY(container->ValidateCanUseInSubmitNow());
-                }
-            }
-
-            for (const BufferBase* buffer : usages.topLevelBuffers) {
-                DAWN_TRY(buffer->ValidateCanUseInSubmitNow());
-            }
-            for (const TextureBase* texture : usages.topLevelTextures) {
-                DAWN_TRY(texture->ValidateCanUseInSubmitNow());
-            }
-            for (const RayTracingAccelerationContainerBase* container :
-                 usages.topLevelAccelerationContainers) {
-                DAWN_TRY(container->ValidateCanUseInSubmitNow());
-            }
+            DAWN_TRY(commands[i]->ValidateCanUseInSubmitNow());
         }
 
         return {};
@@ -17,6 +17,7 @@
 #include "common/Assert.h"
 #include "common/Math.h"
 #include "dawn_native/Buffer.h"
+#include "dawn_native/CompactedSizeRequestTracker.h"
 #include "dawn_native/Device.h"
 
 namespace dawn_native {
@@ -45,12 +46,17 @@ namespace dawn_native {
             void DestroyImpl() override {
                 UNREACHABLE();
             }
-            MaybeError UpdateInstanceImpl(
-                uint32_t instanceIndex,
-                const RayTracingAccelerationInstanceDescriptor* descriptor) override {
+            MaybeError UpdateInstancesImpl(
+                uint32_t firstInstance,
+                uint32_t instanceCount,
+                const RayTracingAccelerationInstanceDescriptor* descriptors) override {
                 UNREACHABLE();
                 return {};
             }
+            ResultOrError<uint64_t> GetCompactedSizeImpl() override {
+                UNREACHABLE();
+                return 0;
+            }
         };
 
     }  // anonymous namespace
@@ -63,6 +69,27 @@ namespace dawn_native {
             return DAWN_VALIDATION_ERROR(
                 "Invalid acceleration container level. Must be top-level or bottom-level");
         }
+        if ((descriptor->usage & wgpu::RayTracingAccelerationContainerUsage::AllowCompaction) &&
+            descriptor->level != wgpu::RayTracingAccelerationContainerLevel::Bottom) {
+            return DAWN_VALIDATION_ERROR("Only bottom-level containers can be compacted");
+        }
+        // Compacted containers only receive the result of a compacting copy so they don't have
+        // any geometry and their size is the one queried from the source container.
+        if (descriptor->compactedSize > 0) {
+            if (descriptor->level != wgpu::RayTracingAccelerationContainerLevel::Bottom) {
+                return DAWN_VALIDATION_ERROR("Only bottom-level containers can be compacted");
+            }
+            if (descriptor->geometryCount > 0 || descriptor->instanceCount > 0) {
+                return DAWN_VALIDATION_ERROR("Compacted containers must not have geometries");
+            }
+            if (descriptor->usage & wgpu::RayTracingAccelerationContainerUsage::AllowUpdate) {
+                return DAWN_VALIDATION_ERROR("Compacted containers can't be updated");
+            }
+            if (descriptor->usage & wgpu::RayTracingAccelerationContainerUsage::AllowCompaction) {
+                return DAWN_VALIDATION_ERROR("Compacted containers can't be compacted again");
+            }
+            return {};
+        }
         if (descriptor->level == wgpu::RayTracingAccelerationContainerLevel::Top) {
             if (descriptor->geometryCount > 0) {
                 return DAWN_VALIDATION_ERROR(
@@ -177,6 +204,7 @@ namespace dawn_native {
         }
         mUsage = descriptor->usage;
         mLevel = descriptor->level;
+        mCompactedSize = descriptor->compactedSize;
         if (descriptor->level == wgpu::RayTracingAccelerationContainerLevel::Bottom) {
             // save unique references to used vertex and index buffers
             for (unsigned int ii = 0; ii < descriptor->geometryCount; ++ii) {
@@ -195,9 +223,18 @@ namespace dawn_native {
                     !VectorReferenceAlreadyExists(mAABBBuffers, geometry.aabb->buffer)) {
                     mAABBBuffers.push_back(geometry.aabb->buffer);
                 }
+
+                if (geometry.aabb != nullptr) {
+                    mGeometryVertexCounts.push_back(geometry.aabb->count);
+                } else if (geometry.vertex != nullptr) {
+                    mGeometryVertexCounts.push_back(geometry.vertex->count);
+                } else {
+                    mGeometryVertexCounts.push_back(0);
+                }
             }
         }
         if (descriptor->level == wgpu::RayTracingAccelerationContainerLevel::Top) {
+            mInstanceCount = descriptor->instanceCount;
             // save unique references to used geometry containers
             for (unsigned int ii = 0; ii < descriptor->instanceCount; ++ii) {
                 const RayTracingAccelerationInstanceDescriptor& instance =
@@ -230,6 +267,7 @@ namespace dawn_native {
     void RayTracingAccelerationContainerBase::DestroyInternal() {
         if (!IsDestroyed()) {
             DestroyImpl();
+            GetDevice()->IncrementResourceStateGeneration();
         }
         SetDestroyState(true);
     }
@@ -237,36 +275,131 @@ namespace dawn_native {
     void RayTracingAccelerationContainerBase::UpdateInstance(
         uint32_t instanceIndex,
         const RayTracingAccelerationInstanceDescriptor* descriptor) {
-        if (GetDevice()->ConsumedError(ValidateUpdateInstance(instanceIndex, descriptor))) {
+        UpdateInstances(instanceIndex, 1, descriptor);
+    }
+
+    void RayTracingAccelerationContainerBase::UpdateInstances(
+        uint32_t firstInstance,
+        uint32_t instanceCount,
+        const RayTracingAccelerationInstanceDescriptor* descriptors) {
+        if (GetDevice()->ConsumedError(
+                ValidateUpdateInstances(firstInstance, instanceCount, descriptors))) {
             return;
         }
         ASSERT(!IsError());
 
-        if (GetDevice()->ConsumedError(UpdateInstanceImpl(instanceIndex, descriptor))) {
+        if (instanceCount == 0) {
+            return;
+        }
+
+        if (GetDevice()->ConsumedError(
+                UpdateInstancesImpl(firstInstance, instanceCount, descriptors))) {
             return;
         }
     }
 
-    MaybeError RayTracingAccelerationContainerBase::ValidateUpdateInstance(
-        uint32_t instanceIndex,
-        const RayTracingAccelerationInstanceDescriptor* descriptor) const {
+    MaybeError RayTracingAccelerationContainerBase::ValidateUpdateInstances(
+        uint32_t firstInstance,
+        uint32_t instanceCount,
+        const RayTracingAccelerationInstanceDescriptor* descriptors) const {
         DAWN_TRY(GetDevice()->ValidateIsAlive());
         DAWN_TRY(GetDevice()->ValidateObject(this));
 
         if (GetLevel() != wgpu::RayTracingAccelerationContainerLevel::Top) {
             return DAWN_VALIDATION_ERROR("Only top-level containers support instance updates");
         }
+        if (IsDestroyed()) {
+            return DAWN_VALIDATION_ERROR("Destroyed containers can't be updated");
+        }
 
-        RayTracingAccelerationContainerBase* geometryContainer = descriptor->geometryContainer;
-        if (geometryContainer == nullptr) {
-            return DAWN_VALIDATION_ERROR("Linked geometry container must not be empty");
+        if (uint64_t(firstInstance) + instanceCount > mInstanceCount) {
+            return DAWN_VALIDATION_ERROR("Instance range is out of bounds");
         }
-        if (geometryContainer->GetLevel() != wgpu::RayTracingAccelerationContainerLevel::Bottom) {
-            return DAWN_VALIDATION_ERROR(
-                "Linked geometry container must be a bottom-level container");
+
+        for (uint32_t i = 0; i < instanceCount; ++i) {
+            RayTracingAccelerationContainerBase* geometryContainer =
+                descriptors[i].geometryContainer;
+            if (geometryContainer == nullptr) {
+                return DAWN_VALIDATION_ERROR("Linked geometry container must not be empty");
+            }
+            DAWN_TRY(GetDevice()->ValidateObject(geometryContainer));
+            if (geometryContainer->GetLevel() !=
+                wgpu::RayTracingAccelerationContainerLevel::Bottom) {
+                return DAWN_VALIDATION_ERROR(
+                    "Linked geometry container must be a bottom-level container");
+            }
+            if (geometryContainer->IsDestroyed()) {
+                return DAWN_VALIDATION_ERROR("Linked geometry container must not be destroyed");
+            }
+        }
+
+        return {};
+    }
+
+    MaybeError RayTracingAccelerationContainerBase::ValidateDirtyRange(
+        const RayTracingAccelerationContainerDirtyRange& range) const {
+        if (GetLevel() != wgpu::RayTracingAccelerationContainerLevel::Bottom) {
+            return DAWN_VALIDATION_ERROR("Only bottom-level containers have dirty ranges");
+        }
+        if (range.geometryIndex >= mGeometryVertexCounts.size()) {
+            return DAWN_VALIDATION_ERROR("Geometry index out of bounds");
+        }
+        if (uint64_t(range.firstVertex) + uint64_t(range.vertexCount) >
+            mGeometryVertexCounts[range.geometryIndex]) {
+            return DAWN_VALIDATION_ERROR("Dirty range is out of the bounds of the geometry");
+        }
+
+        return {};
+    }
+
+    void RayTracingAccelerationContainerBase::GetCompactedSizeAsync(
+        WGPURayTracingAccelerationContainerCompactedSizeCallback callback,
+        void* userdata) {
+        if (GetDevice()->ConsumedError(ValidateGetCompactedSize())) {
+            callback(WGPURayTracingAccelerationContainerCompactedSizeStatus_Error, 0, userdata);
+            return;
+        }
+        ASSERT(!IsError());
+
+        GetDevice()->GetCompactedSizeRequestTracker()->Track(this, callback, userdata);
+    }
+
+    void RayTracingAccelerationContainerBase::OnCompactedSizeRequestFinished(
+        WGPURayTracingAccelerationContainerCompactedSizeCallback callback,
+        void* userdata) {
+        if (GetDevice()->IsLost()) {
+            callback(WGPURayTracingAccelerationContainerCompactedSizeStatus_DeviceLost, 0,
+                     userdata);
+            return;
+        }
+        // The container was destroyed while the request was in flight.
+        if (IsDestroyed()) {
+            callback(WGPURayTracingAccelerationContainerCompactedSizeStatus_Unknown, 0, userdata);
+            return;
+        }
+
+        uint64_t compactedSize = 0;
+        if (GetDevice()->ConsumedError(GetCompactedSizeImpl(), &compactedSize)) {
+            callback(WGPURayTracingAccelerationContainerCompactedSizeStatus_Error, 0, userdata);
+            return;
+        }
+        callback(WGPURayTracingAccelerationContainerCompactedSizeStatus_Success, compactedSize,
+                 userdata);
+    }
+
+    MaybeError RayTracingAccelerationContainerBase::ValidateGetCompactedSize() const {
+        DAWN_TRY(GetDevice()->ValidateIsAlive());
+        DAWN_TRY(GetDevice()->ValidateObject(this));
+
+        if ((GetUsage() & wgpu::RayTracingAccelerationContainerUsage::AllowCompaction) == 0) {
+            return DAWN_VALIDATION_ERROR("Acceleration Container does not support compaction");
         }
-        if (geometryContainer->IsDestroyed()) {
-            return DAWN_VALIDATION_ERROR("Linked geometry container must not be destroyed");
+        if (IsDestroyed()) {
+            return DAWN_VALIDATION_ERROR("Acceleration Container is destroyed");
+        }
+        if (!IsBuilt()) {
+            return DAWN_VALIDATION_ERROR(
+                "Acceleration Container must be built before querying its compacted size");
         }
 
         return {};
@@ -304,6 +437,28 @@ namespace dawn_native {
         return {};
     }
 
+    void RayTracingAccelerationContainerBase::IncrementBuildCount() {
+        mBuildCount++;
+        mRefitCountSinceBuild = 0;
+    }
+
+    void RayTracingAccelerationContainerBase::IncrementRefitCount() {
+        mRefitCount++;
+        mRefitCountSinceBuild++;
+    }
+
+    uint64_t RayTracingAccelerationContainerBase::GetBuildCount() const {
+        return mBuildCount;
+    }
+
+    uint64_t RayTracingAccelerationContainerBase::GetRefitCount() const {
+        return mRefitCount;
+    }
+
+    uint64_t RayTracingAccelerationContainerBase::GetRefitCountSinceBuild() const {
+        return mRefitCountSinceBuild;
+    }
+
     wgpu::RayTracingAccelerationContainerUsage RayTracingAccelerationContainerBase::GetUsage()
         const {
         return mUsage;
@@ -314,4 +469,8 @@ namespace dawn_native {
         return mLevel;
     }
 
+    uint64_t RayTracingAccelerationContainerBase::GetCompactedSize() const {
+        return mCompactedSize;
+    }
+
 }  // namespace dawn_native
\ No newline at end of file
@@ -18,6 +18,7 @@
 #include <memory>
 #include <vector>
 
+#include "dawn_native/DeviceStatisticsTracker.h"
 #include "dawn_native/Error.h"
 #include "dawn_native/Forward.h"
 #include "dawn_native/ObjectBase.h"
@@ -40,6 +41,23 @@ namespace dawn_native {
         void Destroy();
         void UpdateInstance(uint32_t instanceIndex,
                             const RayTracingAccelerationInstanceDescriptor* descriptor);
+        // Writes a contiguous range of instances with a single upload to the instance buffer.
+        void UpdateInstances(uint32_t firstInstance,
+                             uint32_t instanceCount,
+                             const RayTracingAccelerationInstanceDescriptor* descriptors);
+        void GetCompactedSizeAsync(
+            WGPURayTracingAccelerationContainerCompactedSizeCallback callback,
+            void* userdata);
+
+        // Called by the CompactedSizeRequestTracker once the commands submitted before the
+        // request, including the build of the container, are finished.
+        void OnCompactedSizeRequestFinished(
+            WGPURayTracingAccelerationContainerCompactedSizeCallback callback,
+            void* userdata);
+
+        // Checks that |range|, a range of vertices (or AABBs for AABB geometries) passed to an
+        // update of the container, is within one of its geometries.
+        MaybeError ValidateDirtyRange(const RayTracingAccelerationContainerDirtyRange& range) const;
 
         bool IsBuilt() const;
         bool IsUpdated() const;
@@ -50,8 +68,17 @@ namespace dawn_native {
 
         MaybeError ValidateCanUseInSubmitNow() const;
 
+        // Called by the backends when they execute build and update commands.
+        void IncrementBuildCount();
+        void IncrementRefitCount();
+        uint64_t GetBuildCount() const;
+        uint64_t GetRefitCount() const;
+        uint64_t GetRefitCountSinceBuild() const;
+
         wgpu::RayTracingAccelerationContainerUsage GetUsage() const;
         wgpu::RayTracingAccelerationContainerLevel GetLevel() const;
+        // Non-zero for the containers created to be the destination of a compacting copy.
+        uint64_t GetCompactedSize() const;
 
       protected:
         RayTracingAccelerationContainerBase(DeviceBase* device, ObjectBase::ErrorTag tag);
@@ -67,21 +94,39 @@ namespace dawn_native {
         // top-level references
         std::vector<Ref<RayTracingAccelerationContainerBase>> mGeometryContainers;
 
+        // The number of vertices, or AABBs, of each geometry.
+        std::vector<uint32_t> mGeometryVertexCounts;
+
+        uint64_t mBuildCount = 0;
+        uint64_t mRefitCount = 0;
+        uint64_t mRefitCountSinceBuild = 0;
+
         bool mIsBuilt = false;
         bool mIsUpdated = false;
         bool mIsDestroyed = false;
 
         wgpu::RayTracingAccelerationContainerUsage mUsage;
         wgpu::RayTracingAccelerationContainerLevel mLevel;
+        uint64_t mCompactedSize = 0;
+        uint32_t mInstanceCount = 0;
 
-        MaybeError ValidateUpdateInstance(
-            uint32_t instanceIndex,
-            const RayTracingAccelerationInstanceDescriptor* descriptor) const;
+        MaybeError ValidateUpdateInstances(
+            uint32_t firstInstance,
+            uint32_t instanceCount,
+            const RayTracingAccelerationInstanceDescriptor* descriptors) const;
+        MaybeError ValidateGetCompactedSize() const;
 
         virtual void DestroyImpl() = 0;
-        virtual MaybeError UpdateInstanceImpl(
-            uint32_t instanceIndex,
-            const RayTracingAccelerationInstanceDescriptor* descriptor) = 0;
+        virtual MaybeError UpdateInstancesImpl(
+            uint32_t firstInstance,
+            uint32_t instanceCount,
+            const RayTracingAccelerationInstanceDescriptor* descriptors) = 0;
+        // Returns the size the container would have once compacted, as of its last build. Only
+        // called after that build is finished on the GPU.
+        virtual ResultOrError<uint64_t> GetCompactedSizeImpl() = 0;
+
+        LiveObjectCounter mLiveObjectCounter{this,
+                                             CountedObjectType::RayTracingAccelerationContainer};
     };
 
 }  // namespace dawn_native
@@ -16,6 +16,7 @@
 
 #include "dawn_native/Buffer.h"
 #include "dawn_native/CommandEncoder.h"
+#include "dawn_native/CommandValidation.h"
 #include "dawn_native/Commands.h"
 #include "dawn_native/Device.h"
 #include "dawn_native/RayTracingPipeline.h"
@@ -46,6 +47,10 @@ namespace dawn_native {
 
     void RayTracingPassEncoder::EndPass() {
         if (mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
+                if (GetDevice()->IsValidationEnabled()) {
+                    DAWN_TRY(ValidateFinalDebugGroupStackSize(mDebugGroupStackSize));
+                }
+
                 allocator->Allocate<EndRayTracingPassCmd>(Command::EndRayTracingPass);
 
                 return {};
@@ -61,6 +66,10 @@ namespace dawn_native {
                                           uint32_t height,
                                           uint32_t depth) {
         mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
+            if (GetDevice()->IsValidationEnabled()) {
+                DAWN_TRY(mCommandBufferState.ValidateCanTraceRays());
+            }
+
             TraceRaysCmd* traceRays = allocator->Allocate<TraceRaysCmd>(Command::TraceRays);
             traceRays->rayGenerationOffset = rayGenerationOffset;
             traceRays->rayHitOffset = rayHitOffset;
@@ -76,8 +85,8 @@ namespace dawn_native {
         mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
             DAWN_TRY(GetDevice()->ValidateObject(pipeline));
 
-            if (pipeline->GetShaderBindingTable()->IsDestroyed()) {
-                return DAWN_VALIDATION_ERROR("Shader binding table is destroyed");
+            if (GetDevice()->IsValidationEnabled()) {
+                mCommandBufferState.SetRayTracingPipeline(pipeline);
             }
 
             SetRayTracingPipelineCmd* setPipeline =
@@ -41,7 +41,9 @@ namespace dawn_native {
     RayTracingPipelineBase::RayTracingPipelineBase(DeviceBase* device,
                                                    const RayTracingPipelineDescriptor* descriptor)
         : PipelineBase(device, descriptor->layout),
-          mShaderBindingTable(descriptor->rayTracingState->shaderBindingTable) {
+          mShaderBindingTable(descriptor->rayTracingState->shaderBindingTable),
+          mMaxRecursionDepth(descriptor->rayTracingState->maxRecursionDepth),
+          mMaxPayloadSize(descriptor->rayTracingState->maxPayloadSize) {
     }
 
     RayTracingPipelineBase::RayTracingPipelineBase(DeviceBase* device, ObjectBase::ErrorTag tag)
@@ -49,6 +51,10 @@ namespace dawn_native {
     }
 
     RayTracingPipelineBase::~RayTracingPipelineBase() {
+        // Do not uncache the actual cached object if we are a blueprint
+        if (IsCachedReference()) {
+            GetDevice()->UncacheRayTracingPipeline(this);
+        }
     }
 
     // static
@@ -60,4 +66,21 @@ namespace dawn_native {
         return mShaderBindingTable.Get();
     }
 
+    size_t RayTracingPipelineBase::HashFunc::operator()(
+        const RayTracingPipelineBase* pipeline) const {
+        size_t hash =
+            RayTracingShaderBindingTableBase::HashFunc()(pipeline->mShaderBindingTable.Get());
+        HashCombine(&hash, pipeline->mMaxRecursionDepth, pipeline->mMaxPayloadSize,
+                    pipeline->GetLayout());
+        return hash;
+    }
+
+    bool RayTracingPipelineBase::EqualityFunc::operator()(const RayTracingPipelineBase* a,
+                                                          const RayTracingPipelineBase* b) const {
+        return RayTracingShaderBindingTableBase::EqualityFunc()(a->mShaderBindingTable.Get(),
+                                                                b->mShaderBindingTable.Get()) &&
+               a->mMaxRecursionDepth == b->mMaxRecursionDepth &&
+               a->mMaxPayloadSize == b->mMaxPayloadSize && a->GetLayout() == b->GetLayout();
+    }
+
 }  // namespace dawn_native
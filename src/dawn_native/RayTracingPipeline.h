@@ -15,6 +15,7 @@
 #ifndef DAWNNATIVE_RAY_TRACING_PIPELINE_H_
 #define DAWNNATIVE_RAY_TRACING_PIPELINE_H_
 
+#include "dawn_native/DeviceStatisticsTracker.h"
 #include "dawn_native/Pipeline.h"
 #include "dawn_native/RayTracingShaderBindingTable.h"
 
@@ -34,10 +35,24 @@ namespace dawn_native {
 
         RayTracingShaderBindingTableBase* GetShaderBindingTable();
 
+        // Functors necessary for the unordered_set<RayTracingPipelineBase*>-based cache.
+        struct HashFunc {
+            size_t operator()(const RayTracingPipelineBase* pipeline) const;
+        };
+        struct EqualityFunc {
+            bool operator()(const RayTracingPipelineBase* a, const RayTracingPipelineBase* b) const;
+        };
+
       private:
         RayTracingPipelineBase(DeviceBase* device, ObjectBase::ErrorTag tag);
 
+        // Backends keep the group handles in the pipeline and only read the table's stages and
+        // groups when it is created, so tables with the same contents can share a pipeline.
         Ref<RayTracingShaderBindingTableBase> mShaderBindingTable;
+        uint32_t mMaxRecursionDepth = 0;
+        uint32_t mMaxPayloadSize = 0;
+
+        LiveObjectCounter mLiveObjectCounter{this, CountedObjectType::RayTracingPipeline};
     };
 
 }  // namespace dawn_native
@@ -15,6 +15,7 @@
 #include "dawn_native/RayTracingShaderBindingTable.h"
 
 #include "common/Assert.h"
+#include "common/HashUtils.h"
 #include "common/Math.h"
 #include "dawn_native/Device.h"
 
@@ -41,6 +42,9 @@ namespace dawn_native {
     MaybeError ValidateRayTracingShaderBindingTableDescriptor(
         DeviceBase* device,
         const RayTracingShaderBindingTableDescriptor* descriptor) {
+        if (!device->IsExtensionEnabled(Extension::RayTracing)) {
+            return DAWN_VALIDATION_ERROR("Ray Tracing extension is not enabled");
+        }
         if (descriptor->stageCount == 0) {
             return DAWN_VALIDATION_ERROR("Shader binding table stages must not be empty");
         }
@@ -122,6 +126,11 @@ namespace dawn_native {
                 DAWN_VALIDATION_ERROR("Ray Tracing extension is not enabled"));
             return;
         }
+        mStages.reserve(descriptor->stageCount);
+        for (uint32_t i = 0; i < descriptor->stageCount; ++i) {
+            mStages.push_back({descriptor->stages[i].stage, descriptor->stages[i].module});
+        }
+        mGroups.assign(descriptor->groups, descriptor->groups + descriptor->groupCount);
     }
 
     RayTracingShaderBindingTableBase::RayTracingShaderBindingTableBase(DeviceBase* device,
@@ -161,4 +170,42 @@ namespace dawn_native {
         return new ErrorRayTracingShaderBindingTable(device);
     }
 
+    size_t RayTracingShaderBindingTableBase::HashFunc::operator()(
+        const RayTracingShaderBindingTableBase* table) const {
+        size_t hash = 0;
+        for (const StageInfo& stage : table->mStages) {
+            HashCombine(&hash, stage.stage, stage.module.Get());
+        }
+        for (const RayTracingShaderBindingTableGroupDescriptor& group : table->mGroups) {
+            HashCombine(&hash, group.type, group.generalIndex, group.closestHitIndex,
+                        group.anyHitIndex, group.intersectionIndex);
+        }
+        return hash;
+    }
+
+    bool RayTracingShaderBindingTableBase::EqualityFunc::operator()(
+        const RayTracingShaderBindingTableBase* a,
+        const RayTracingShaderBindingTableBase* b) const {
+        if (a->mStages.size() != b->mStages.size() || a->mGroups.size() != b->mGroups.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < a->mStages.size(); ++i) {
+            if (a->mStages[i].stage != b->mStages[i].stage ||
+                a->mStages[i].module.Get() != b->mStages[i].module.Get()) {
+                return false;
+            }
+        }
+        for (size_t i = 0; i < a->mGroups.size(); ++i) {
+            const RayTracingShaderBindingTableGroupDescriptor& groupA = a->mGroups[i];
+            const RayTracingShaderBindingTableGroupDescriptor& groupB = b->mGroups[i];
+            if (groupA.type != groupB.type || groupA.generalIndex != groupB.generalIndex ||
+                groupA.closestHitIndex != groupB.closestHitIndex ||
+                groupA.anyHitIndex != groupB.anyHitIndex ||
+                groupA.intersectionIndex != groupB.intersectionIndex) {
+                return false;
+            }
+        }
+        return true;
+    }
+
 }  // namespace dawn_native
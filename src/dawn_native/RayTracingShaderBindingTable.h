@@ -15,13 +15,16 @@
 #ifndef DAWNNATIVE_RAY_TRACING_SHADER_BINDING_TABLE_H_
 #define DAWNNATIVE_RAY_TRACING_SHADER_BINDING_TABLE_H_
 
+#include "dawn_native/DeviceStatisticsTracker.h"
 #include "dawn_native/Error.h"
 #include "dawn_native/Forward.h"
 #include "dawn_native/ObjectBase.h"
+#include "dawn_native/ShaderModule.h"
 
 #include "dawn_native/dawn_platform.h"
 
 #include <memory>
+#include <vector>
 
 namespace dawn_native {
 
@@ -41,6 +44,15 @@ namespace dawn_native {
 
         static RayTracingShaderBindingTableBase* MakeError(DeviceBase* device);
 
+        // Functors comparing the contents of tables, used by the ray tracing pipeline cache.
+        struct HashFunc {
+            size_t operator()(const RayTracingShaderBindingTableBase* table) const;
+        };
+        struct EqualityFunc {
+            bool operator()(const RayTracingShaderBindingTableBase* a,
+                            const RayTracingShaderBindingTableBase* b) const;
+        };
+
       protected:
         RayTracingShaderBindingTableBase(DeviceBase* device, ObjectBase::ErrorTag tag);
 
@@ -52,6 +64,15 @@ namespace dawn_native {
         bool mIsDestroyed = false;
 
         virtual void DestroyImpl() = 0;
+
+        struct StageInfo {
+            wgpu::ShaderStage stage;
+            Ref<ShaderModuleBase> module;
+        };
+        std::vector<StageInfo> mStages;
+        std::vector<RayTracingShaderBindingTableGroupDescriptor> mGroups;
+
+        LiveObjectCounter mLiveObjectCounter{this, CountedObjectType::RayTracingShaderBindingTable};
     };
 
 }  // namespace dawn_native
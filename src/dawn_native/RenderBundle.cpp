@@ -27,6 +27,7 @@ namespace dawn_native {
                                        PassResourceUsage resourceUsage)
         : ObjectBase(encoder->GetDevice()),
           mCommands(encoder->AcquireCommands()),
+          mReferencedObjects(encoder->AcquireObjectReferences()),
           mAttachmentState(attachmentState),
           mResourceUsage(std::move(resourceUsage)) {
     }
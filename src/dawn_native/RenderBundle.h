@@ -18,6 +18,7 @@
 #include "common/Constants.h"
 #include "dawn_native/AttachmentState.h"
 #include "dawn_native/CommandAllocator.h"
+#include "dawn_native/DeviceStatisticsTracker.h"
 #include "dawn_native/Error.h"
 #include "dawn_native/ObjectBase.h"
 #include "dawn_native/PassResourceUsage.h"
@@ -25,6 +26,7 @@
 #include "dawn_native/dawn_platform.h"
 
 #include <bitset>
+#include <vector>
 
 namespace dawn_native {
 
@@ -53,8 +55,12 @@ namespace dawn_native {
         RenderBundleBase(DeviceBase* device, ErrorTag errorTag);
 
         CommandIterator mCommands;
+        // The references to the objects that the commands store as raw pointers.
+        std::vector<Ref<ObjectBase>> mReferencedObjects;
         Ref<AttachmentState> mAttachmentState;
         PassResourceUsage mResourceUsage;
+
+        LiveObjectCounter mLiveObjectCounter{this, CountedObjectType::RenderBundle};
     };
 
 }  // namespace dawn_native
@@ -79,14 +79,15 @@ namespace dawn_native {
 
     RenderBundleEncoder::RenderBundleEncoder(DeviceBase* device,
                                              const RenderBundleEncoderDescriptor* descriptor)
-        : RenderEncoderBase(device, &mBundleEncodingContext),
-          mBundleEncodingContext(device, this),
-          mAttachmentState(device->GetOrCreateAttachmentState(descriptor)) {
+        : RenderEncoderBase(device,
+                            &mBundleEncodingContext,
+                            device->GetOrCreateAttachmentState(descriptor)),
+          mBundleEncodingContext(device, this, false) {
     }
 
     RenderBundleEncoder::RenderBundleEncoder(DeviceBase* device, ErrorTag errorTag)
         : RenderEncoderBase(device, &mBundleEncodingContext, errorTag),
-          mBundleEncodingContext(device, this) {
+          mBundleEncodingContext(device, this, false) {
     }
 
     // static
@@ -94,14 +95,14 @@ namespace dawn_native {
         return new RenderBundleEncoder(device, ObjectBase::kError);
     }
 
-    const AttachmentState* RenderBundleEncoder::GetAttachmentState() const {
-        return mAttachmentState.Get();
-    }
-
     CommandIterator RenderBundleEncoder::AcquireCommands() {
         return mBundleEncodingContext.AcquireCommands();
     }
 
+    std::vector<Ref<ObjectBase>> RenderBundleEncoder::AcquireObjectReferences() {
+        return mBundleEncodingContext.AcquireObjectReferences();
+    }
+
     RenderBundleBase* RenderBundleEncoder::Finish(const RenderBundleDescriptor* descriptor) {
         PassResourceUsage usages = mUsageTracker.AcquireResourceUsage();
 
@@ -110,8 +111,7 @@ namespace dawn_native {
         // internal state of the encoding context. Subsequent calls to encode commands will generate
         // errors.
         if (device->ConsumedError(mBundleEncodingContext.Finish()) ||
-            (device->IsValidationEnabled() &&
-             device->ConsumedError(ValidateFinish(mBundleEncodingContext.GetIterator(), usages)))) {
+            (device->IsValidationEnabled() && device->ConsumedError(ValidateFinish(usages)))) {
             return RenderBundleBase::MakeError(device);
         }
 
@@ -119,12 +119,12 @@ namespace dawn_native {
         return new RenderBundleBase(this, descriptor, mAttachmentState.Get(), std::move(usages));
     }
 
-    MaybeError RenderBundleEncoder::ValidateFinish(CommandIterator* commands,
-                                                   const PassResourceUsage& usages) const {
+    MaybeError RenderBundleEncoder::ValidateFinish(const PassResourceUsage& usages) const {
         TRACE_EVENT0(GetDevice()->GetPlatform(), Validation, "RenderBundleEncoder::ValidateFinish");
         DAWN_TRY(GetDevice()->ValidateObject(this));
         DAWN_TRY(ValidatePassResourceUsage(usages));
-        DAWN_TRY(ValidateRenderBundle(commands, mAttachmentState.Get()));
+        // The commands were validated as they were recorded.
+        DAWN_TRY(ValidateFinalDebugGroupStackSize(mDebugGroupStackSize));
         return {};
     }
 
@@ -33,19 +33,17 @@ namespace dawn_native {
 
         static RenderBundleEncoder* MakeError(DeviceBase* device);
 
-        const AttachmentState* GetAttachmentState() const;
-
         RenderBundleBase* Finish(const RenderBundleDescriptor* descriptor);
 
         CommandIterator AcquireCommands();
+        std::vector<Ref<ObjectBase>> AcquireObjectReferences();
 
       private:
         RenderBundleEncoder(DeviceBase* device, ErrorTag errorTag);
 
-        MaybeError ValidateFinish(CommandIterator* commands, const PassResourceUsage& usages) const;
+        MaybeError ValidateFinish(const PassResourceUsage& usages) const;
 
         EncodingContext mBundleEncodingContext;
-        Ref<AttachmentState> mAttachmentState;
     };
 }  // namespace dawn_native
 
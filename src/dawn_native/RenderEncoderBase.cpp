@@ -26,8 +26,11 @@
 
 namespace dawn_native {
 
-    RenderEncoderBase::RenderEncoderBase(DeviceBase* device, EncodingContext* encodingContext)
+    RenderEncoderBase::RenderEncoderBase(DeviceBase* device,
+                                         EncodingContext* encodingContext,
+                                         Ref<AttachmentState> attachmentState)
         : ProgrammablePassEncoder(device, encodingContext, PassType::Render),
+          mAttachmentState(std::move(attachmentState)),
           mDisableBaseVertex(device->IsToggleEnabled(Toggle::DisableBaseVertex)),
           mDisableBaseInstance(device->IsToggleEnabled(Toggle::DisableBaseInstance)) {
     }
@@ -40,6 +43,15 @@ namespace dawn_native {
           mDisableBaseInstance(device->IsToggleEnabled(Toggle::DisableBaseInstance)) {
     }
 
+    const AttachmentState* RenderEncoderBase::GetAttachmentState() const {
+        return mAttachmentState.Get();
+    }
+
+    void RenderEncoderBase::ResetLastDraws() {
+        mHasLastDraw = false;
+        mHasLastDrawIndexed = false;
+    }
+
     void RenderEncoderBase::Draw(uint32_t vertexCount,
                                  uint32_t instanceCount,
                                  uint32_t firstVertex,
@@ -48,6 +60,17 @@ namespace dawn_native {
             if (mDisableBaseInstance && firstInstance != 0) {
                 return DAWN_VALIDATION_ERROR("Non-zero first instance not supported");
             }
+            if (GetDevice()->IsValidationEnabled()) {
+                DAWN_TRY(mCommandBufferState.ValidateCanDraw());
+            }
+
+            if (mHasLastDraw && mLastDraw.vertexCount == vertexCount &&
+                mLastDraw.instanceCount == instanceCount &&
+                mLastDraw.firstVertex == firstVertex &&
+                mLastDraw.firstInstance == firstInstance) {
+                allocator->Allocate<RepeatDrawCmd>(Command::RepeatDraw);
+                return {};
+            }
 
             DrawCmd* draw = allocator->Allocate<DrawCmd>(Command::Draw);
             draw->vertexCount = vertexCount;
@@ -55,6 +78,9 @@ namespace dawn_native {
             draw->firstVertex = firstVertex;
             draw->firstInstance = firstInstance;
 
+            mLastDraw = *draw;
+            mHasLastDraw = true;
+
             return {};
         });
     }
@@ -71,6 +97,18 @@ namespace dawn_native {
             if (mDisableBaseInstance && baseVertex != 0) {
                 return DAWN_VALIDATION_ERROR("Non-zero base vertex not supported");
             }
+            if (GetDevice()->IsValidationEnabled()) {
+                DAWN_TRY(mCommandBufferState.ValidateCanDrawIndexed());
+            }
+
+            if (mHasLastDrawIndexed && mLastDrawIndexed.indexCount == indexCount &&
+                mLastDrawIndexed.instanceCount == instanceCount &&
+                mLastDrawIndexed.firstIndex == firstIndex &&
+                mLastDrawIndexed.baseVertex == baseVertex &&
+                mLastDrawIndexed.firstInstance == firstInstance) {
+                allocator->Allocate<RepeatDrawIndexedCmd>(Command::RepeatDrawIndexed);
+                return {};
+            }
 
             DrawIndexedCmd* draw = allocator->Allocate<DrawIndexedCmd>(Command::DrawIndexed);
             draw->indexCount = indexCount;
@@ -79,6 +117,9 @@ namespace dawn_native {
             draw->baseVertex = baseVertex;
             draw->firstInstance = firstInstance;
 
+            mLastDrawIndexed = *draw;
+            mHasLastDrawIndexed = true;
+
             return {};
         });
     }
@@ -91,6 +132,9 @@ namespace dawn_native {
                 indirectOffset + kDrawIndirectSize > indirectBuffer->GetSize()) {
                 return DAWN_VALIDATION_ERROR("Indirect offset out of bounds");
             }
+            if (GetDevice()->IsValidationEnabled()) {
+                DAWN_TRY(mCommandBufferState.ValidateCanDraw());
+            }
 
             DrawIndirectCmd* cmd = allocator->Allocate<DrawIndirectCmd>(Command::DrawIndirect);
             cmd->indirectBuffer = indirectBuffer;
@@ -111,6 +155,9 @@ namespace dawn_native {
                  indirectOffset + kDrawIndexedIndirectSize > indirectBuffer->GetSize())) {
                 return DAWN_VALIDATION_ERROR("Indirect offset out of bounds");
             }
+            if (GetDevice()->IsValidationEnabled()) {
+                DAWN_TRY(mCommandBufferState.ValidateCanDrawIndexed());
+            }
 
             DrawIndexedIndirectCmd* cmd =
                 allocator->Allocate<DrawIndexedIndirectCmd>(Command::DrawIndexedIndirect);
@@ -127,9 +174,17 @@ namespace dawn_native {
         mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
             DAWN_TRY(GetDevice()->ValidateObject(pipeline));
 
+            if (GetDevice()->IsValidationEnabled()) {
+                if (DAWN_UNLIKELY(pipeline->GetAttachmentState() != mAttachmentState.Get())) {
+                    return DAWN_VALIDATION_ERROR("Pipeline attachment state is not compatible");
+                }
+                mCommandBufferState.SetRenderPipeline(pipeline);
+            }
+
             SetRenderPipelineCmd* cmd =
                 allocator->Allocate<SetRenderPipelineCmd>(Command::SetRenderPipeline);
             cmd->pipeline = pipeline;
+            mEncodingContext->ReferenceObject(pipeline);
 
             return {};
         });
@@ -158,8 +213,12 @@ namespace dawn_native {
             cmd->buffer = buffer;
             cmd->offset = offset;
             cmd->size = size;
+            mEncodingContext->ReferenceObject(buffer);
 
             mUsageTracker.BufferUsedAs(buffer, wgpu::BufferUsage::Index);
+            if (GetDevice()->IsValidationEnabled()) {
+                mCommandBufferState.SetIndexBuffer();
+            }
 
             return {};
         });
@@ -196,8 +255,12 @@ namespace dawn_native {
             cmd->buffer = buffer;
             cmd->offset = offset;
             cmd->size = size;
+            mEncodingContext->ReferenceObject(buffer);
 
             mUsageTracker.BufferUsedAs(buffer, wgpu::BufferUsage::Vertex);
+            if (GetDevice()->IsValidationEnabled()) {
+                mCommandBufferState.SetVertexBuffer(slot);
+            }
 
             return {};
         });
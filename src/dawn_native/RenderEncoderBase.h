@@ -15,6 +15,8 @@
 #ifndef DAWNNATIVE_RENDERENCODERBASE_H_
 #define DAWNNATIVE_RENDERENCODERBASE_H_
 
+#include "dawn_native/AttachmentState.h"
+#include "dawn_native/Commands.h"
 #include "dawn_native/Error.h"
 #include "dawn_native/ProgrammablePassEncoder.h"
 
@@ -22,7 +24,9 @@ namespace dawn_native {
 
     class RenderEncoderBase : public ProgrammablePassEncoder {
       public:
-        RenderEncoderBase(DeviceBase* device, EncodingContext* encodingContext);
+        RenderEncoderBase(DeviceBase* device,
+                          EncodingContext* encodingContext,
+                          Ref<AttachmentState> attachmentState);
 
         void Draw(uint32_t vertexCount,
                   uint32_t instanceCount,
@@ -42,13 +46,31 @@ namespace dawn_native {
         void SetVertexBuffer(uint32_t slot, BufferBase* buffer, uint64_t offset, uint64_t size);
         void SetIndexBuffer(BufferBase* buffer, uint64_t offset, uint64_t size);
 
+        const AttachmentState* GetAttachmentState() const;
+
       protected:
         // Construct an "error" render encoder base.
         RenderEncoderBase(DeviceBase* device, EncodingContext* encodingContext, ErrorTag errorTag);
 
+        // Makes the next draws be encoded with all their parameters. It must be called when
+        // commands are recorded that make the backends decode other draws in between, like
+        // ExecuteBundles.
+        void ResetLastDraws();
+
+        // Pipelines set in the pass must have this attachment state. It is null for error
+        // encoders.
+        Ref<AttachmentState> mAttachmentState;
+
       private:
         const bool mDisableBaseVertex;
         const bool mDisableBaseInstance;
+
+        // The parameters of the previous draws, to encode the draws with the same parameters as
+        // RepeatDraw and RepeatDrawIndexed.
+        DrawCmd mLastDraw;
+        bool mHasLastDraw = false;
+        DrawIndexedCmd mLastDrawIndexed;
+        bool mHasLastDrawIndexed = false;
     };
 
 }  // namespace dawn_native
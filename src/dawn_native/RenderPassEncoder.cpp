@@ -17,6 +17,7 @@
 #include "common/Constants.h"
 #include "dawn_native/Buffer.h"
 #include "dawn_native/CommandEncoder.h"
+#include "dawn_native/CommandValidation.h"
 #include "dawn_native/Commands.h"
 #include "dawn_native/Device.h"
 #include "dawn_native/RenderBundle.h"
@@ -33,8 +34,10 @@ namespace dawn_native {
     RenderPassEncoder::RenderPassEncoder(DeviceBase* device,
                                          CommandEncoder* commandEncoder,
                                          EncodingContext* encodingContext,
-                                         PassResourceUsageTracker usageTracker)
-        : RenderEncoderBase(device, encodingContext), mCommandEncoder(commandEncoder) {
+                                         PassResourceUsageTracker usageTracker,
+                                         Ref<AttachmentState> attachmentState)
+        : RenderEncoderBase(device, encodingContext, std::move(attachmentState)),
+          mCommandEncoder(commandEncoder) {
         mUsageTracker = std::move(usageTracker);
     }
 
@@ -53,6 +56,10 @@ namespace dawn_native {
 
     void RenderPassEncoder::EndPass() {
         if (mEncodingContext->TryEncode(this, [&](CommandAllocator* allocator) -> MaybeError {
+                if (GetDevice()->IsValidationEnabled()) {
+                    DAWN_TRY(ValidateFinalDebugGroupStackSize(mDebugGroupStackSize));
+                }
+
                 allocator->Allocate<EndRenderPassCmd>(Command::EndRenderPass);
 
                 return {};
@@ -141,10 +148,28 @@ namespace dawn_native {
                 DAWN_TRY(GetDevice()->ValidateObject(renderBundles[i]));
             }
 
+            if (GetDevice()->IsValidationEnabled()) {
+                for (uint32_t i = 0; i < count; ++i) {
+                    if (DAWN_UNLIKELY(renderBundles[i]->GetAttachmentState() !=
+                                      mAttachmentState.Get())) {
+                        return DAWN_VALIDATION_ERROR(
+                            "Render bundle is not compatible with render pass");
+                    }
+                }
+
+                if (count > 0) {
+                    // Reset state. It is invalidated after render bundle execution.
+                    mCommandBufferState = CommandBufferStateTracker{};
+                }
+            }
+
             ExecuteBundlesCmd* cmd =
                 allocator->Allocate<ExecuteBundlesCmd>(Command::ExecuteBundles);
             cmd->count = count;
 
+            // Backends decode the draws of the bundles with the draws of the pass.
+            ResetLastDraws();
+
             Ref<RenderBundleBase>* bundles = allocator->AllocateData<Ref<RenderBundleBase>>(count);
             for (uint32_t i = 0; i < count; ++i) {
                 bundles[i] = renderBundles[i];
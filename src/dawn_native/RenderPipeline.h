@@ -16,6 +16,7 @@
 #define DAWNNATIVE_RENDERPIPELINE_H_
 
 #include "dawn_native/AttachmentState.h"
+#include "dawn_native/DeviceStatisticsTracker.h"
 #include "dawn_native/Pipeline.h"
 
 #include "dawn_native/dawn_platform.h"
@@ -118,6 +119,8 @@ namespace dawn_native {
         std::string mVertexEntryPoint;
         Ref<ShaderModuleBase> mFragmentModule;
         std::string mFragmentEntryPoint;
+
+        LiveObjectCounter mLiveObjectCounter{this, CountedObjectType::RenderPipeline};
     };
 
 }  // namespace dawn_native
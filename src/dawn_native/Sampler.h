@@ -16,6 +16,7 @@
 #define DAWNNATIVE_SAMPLER_H_
 
 #include "dawn_native/CachedObject.h"
+#include "dawn_native/DeviceStatisticsTracker.h"
 #include "dawn_native/Error.h"
 
 #include "dawn_native/dawn_platform.h"
@@ -56,6 +57,8 @@ namespace dawn_native {
         float mLodMinClamp;
         float mLodMaxClamp;
         wgpu::CompareFunction mCompareFunction;
+
+        LiveObjectCounter mLiveObjectCounter{this, CountedObjectType::Sampler};
     };
 
 }  // namespace dawn_native
@@ -19,6 +19,8 @@
 #include "dawn_native/Device.h"
 #include "dawn_native/Pipeline.h"
 #include "dawn_native/PipelineLayout.h"
+#include "dawn_platform/DawnPlatform.h"
+#include "dawn_platform/tracing/TraceEvent.h"
 
 #include <spirv-tools/libspirv.hpp>
 #include <spirv_cross.hpp>
@@ -483,6 +485,8 @@ namespace dawn_native {
 
     MaybeError ShaderModuleBase::ExtractSpirvInfo(const spirv_cross::Compiler& compiler) {
         ASSERT(!IsError());
+        TRACE_EVENT1(GetDevice()->GetPlatform(), General, "ShaderModuleBase::ExtractSpirvInfo",
+                     "spirvWordCount", mSpirv.size());
         if (GetDevice()->IsToggleEnabled(Toggle::UseSpvc)) {
             DAWN_TRY(ExtractSpirvInfoWithSpvc());
         } else {
@@ -1035,6 +1039,8 @@ namespace dawn_native {
     MaybeError ShaderModuleBase::InitializeBase() {
         if (mType == Type::Wgsl) {
 #ifdef DAWN_ENABLE_WGSL
+            TRACE_EVENT0(GetDevice()->GetPlatform(), General,
+                         "ShaderModuleBase::ConvertWGSLToSPIRV");
             DAWN_TRY_ASSIGN(mSpirv, ConvertWGSLToSPIRV(mWgsl.c_str()));
 #else
             return DAWN_VALIDATION_ERROR("WGSL not supported (yet)");
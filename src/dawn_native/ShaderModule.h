@@ -18,6 +18,7 @@
 #include "common/Constants.h"
 #include "dawn_native/BindingInfo.h"
 #include "dawn_native/CachedObject.h"
+#include "dawn_native/DeviceStatisticsTracker.h"
 #include "dawn_native/Error.h"
 #include "dawn_native/Format.h"
 #include "dawn_native/Forward.h"
@@ -114,6 +115,8 @@ namespace dawn_native {
         SingleShaderStage mExecutionModel;
 
         FragmentOutputBaseTypes mFragmentOutputFormatBaseTypes;
+
+        LiveObjectCounter mLiveObjectCounter{this, CountedObjectType::ShaderModule};
     };
 
 }  // namespace dawn_native
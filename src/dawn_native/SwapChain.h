@@ -15,6 +15,7 @@
 #ifndef DAWNNATIVE_SWAPCHAIN_H_
 #define DAWNNATIVE_SWAPCHAIN_H_
 
+#include "dawn_native/DeviceStatisticsTracker.h"
 #include "dawn_native/Error.h"
 #include "dawn_native/Forward.h"
 #include "dawn_native/ObjectBase.h"
@@ -47,6 +48,9 @@ namespace dawn_native {
       protected:
         SwapChainBase(DeviceBase* device, ObjectBase::ErrorTag tag);
         ~SwapChainBase() override;
+
+      private:
+        LiveObjectCounter mLiveObjectCounter{this, CountedObjectType::SwapChain};
     };
 
     // The base class for implementation-based SwapChains that are deprecated.
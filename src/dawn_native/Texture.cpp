@@ -512,6 +512,7 @@ namespace dawn_native {
     void TextureBase::DestroyInternal() {
         DestroyImpl();
         mState = TextureState::Destroyed;
+        GetDevice()->IncrementResourceStateGeneration();
     }
 
     MaybeError TextureBase::ValidateDestroy() const {
@@ -15,6 +15,7 @@
 #ifndef DAWNNATIVE_TEXTURE_H_
 #define DAWNNATIVE_TEXTURE_H_
 
+#include "dawn_native/DeviceStatisticsTracker.h"
 #include "dawn_native/Error.h"
 #include "dawn_native/Forward.h"
 #include "dawn_native/ObjectBase.h"
@@ -105,6 +106,8 @@ namespace dawn_native {
 
         // TODO(natlee@microsoft.com): Use a more optimized data structure to save space
         std::vector<bool> mIsSubresourceContentInitializedAtIndex;
+
+        LiveObjectCounter mLiveObjectCounter{this, CountedObjectType::Texture};
     };
 
     class TextureViewBase : public ObjectBase {
@@ -135,6 +138,8 @@ namespace dawn_native {
         uint32_t mMipLevelCount;
         uint32_t mBaseArrayLayer;
         uint32_t mArrayLayerCount;
+
+        LiveObjectCounter mLiveObjectCounter{this, CountedObjectType::TextureView};
     };
 
 }  // namespace dawn_native
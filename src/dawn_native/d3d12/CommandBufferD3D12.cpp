@@ -457,6 +457,109 @@ namespace dawn_native { namespace d3d12 {
             }
         }
 
+        D3D12_RESOURCE_BARRIER TransitionBarrier(ID3D12Resource* resource,
+                                                 D3D12_RESOURCE_STATES before,
+                                                 D3D12_RESOURCE_STATES after) {
+            D3D12_RESOURCE_BARRIER barrier;
+            barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+            barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+            barrier.Transition.pResource = resource;
+            barrier.Transition.StateBefore = before;
+            barrier.Transition.StateAfter = after;
+            barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+            return barrier;
+        }
+
+        // Copies the compacted size emitted by the last build of the container to its readback
+        // buffer, so that it can be read once the commands are finished.
+        void RecordCompactedSizeReadback(ID3D12GraphicsCommandList* commandList,
+                                         RayTracingAccelerationContainer* container) {
+            MemoryEntry* sizeMemory = &container->GetCompactedSizeMemory();
+            MemoryEntry* readbackMemory = &container->GetCompactedSizeReadbackMemory();
+
+            D3D12_RESOURCE_BARRIER barrier =
+                TransitionBarrier(sizeMemory->buffer.Get(), D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+                                  D3D12_RESOURCE_STATE_COPY_SOURCE);
+            commandList->ResourceBarrier(1, &barrier);
+
+            commandList->CopyBufferRegion(
+                readbackMemory->buffer.Get(), 0, sizeMemory->buffer.Get(), 0,
+                sizeof(D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_COMPACTED_SIZE_DESC));
+
+            barrier =
+                TransitionBarrier(sizeMemory->buffer.Get(), D3D12_RESOURCE_STATE_COPY_SOURCE,
+                                  D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+            commandList->ResourceBarrier(1, &barrier);
+        }
+
+        // D3D12 has no call to build several containers at once, so the builds are recorded back
+        // to back and synchronized with a single UAV barrier. The build scratch memory of each
+        // container is sub-allocated from one shared buffer.
+        MaybeError RecordBuildAccelerationContainers(
+            Device* device,
+            CommandRecordingContext* commandContext,
+            Ref<RayTracingAccelerationContainerBase>* containers,
+            uint32_t count) {
+            ID3D12GraphicsCommandList* commandList = commandContext->GetCommandList();
+            ID3D12GraphicsCommandList4* commandList4 = commandContext->GetCommandList4();
+
+            std::vector<uint64_t> scratchOffsets(count);
+            uint64_t scratchSize = 0;
+            for (uint32_t i = 0; i < count; ++i) {
+                RayTracingAccelerationContainer* container = ToBackend(containers[i].Get());
+                ASSERT(container->GetLevel() == containers[0]->GetLevel());
+                scratchOffsets[i] = scratchSize;
+                scratchSize += Align(container->GetScratchBuildMemorySize(),
+                                     D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BYTE_ALIGNMENT);
+            }
+
+            MemoryEntry scratchMemory;
+            DAWN_TRY(AllocateScratchMemory(device, scratchMemory, scratchSize,
+                                           D3D12_RESOURCE_STATE_UNORDERED_ACCESS));
+
+            for (uint32_t i = 0; i < count; ++i) {
+                RayTracingAccelerationContainer* container = ToBackend(containers[i].Get());
+
+                D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_DESC buildDesc;
+                buildDesc.Inputs = container->GetBuildInformation();
+                buildDesc.SourceAccelerationStructureData = 0;
+                buildDesc.DestAccelerationStructureData =
+                    container->GetScratchMemory().result.address;
+                buildDesc.ScratchAccelerationStructureData =
+                    scratchMemory.address + scratchOffsets[i];
+
+                MemoryEntry* compactedSizeMemory = &container->GetCompactedSizeMemory();
+                D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_DESC postbuildInfo;
+                postbuildInfo.DestBuffer = compactedSizeMemory->address;
+                postbuildInfo.InfoType =
+                    D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_COMPACTED_SIZE;
+                bool emitCompactedSize = compactedSizeMemory->buffer != nullptr;
+
+                commandList4->BuildRaytracingAccelerationStructure(
+                    &buildDesc, emitCompactedSize ? 1 : 0,
+                    emitCompactedSize ? &postbuildInfo : nullptr);
+            }
+
+            // a null resource synchronizes all UAV accesses
+            D3D12_RESOURCE_BARRIER uavBarrier;
+            uavBarrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+            uavBarrier.Type = D3D12_RESOURCE_BARRIER_TYPE_UAV;
+            uavBarrier.UAV.pResource = nullptr;
+            commandList->ResourceBarrier(1, &uavBarrier);
+
+            for (uint32_t i = 0; i < count; ++i) {
+                RayTracingAccelerationContainer* container = ToBackend(containers[i].Get());
+                if (container->GetCompactedSizeMemory().buffer != nullptr) {
+                    RecordCompactedSizeReadback(commandList, container);
+                }
+                container->SetBuildState(true);
+                container->IncrementBuildCount();
+            }
+
+            ReleaseScratchMemory(device, scratchMemory);
+            return {};
+        }
+
     }  // anonymous namespace
 
     CommandBuffer::CommandBuffer(CommandEncoder* encoder, const CommandBufferDescriptor* descriptor)
@@ -583,6 +686,9 @@ namespace dawn_native { namespace d3d12 {
                         mCommands.NextCommand<BuildRayTracingAccelerationContainerCmd>();
                     RayTracingAccelerationContainer* container = ToBackend(build->container.Get());
 
+                    // the scratch build memory is released after the first update
+                    DAWN_TRY(container->EnsureScratchBuildMemory());
+
                     MemoryEntry* resultMemory = &container->GetScratchMemory().result;
                     MemoryEntry* buildMemory = &container->GetScratchMemory().build;
 
@@ -592,7 +698,17 @@ namespace dawn_native { namespace d3d12 {
                     buildDesc.DestAccelerationStructureData = resultMemory->address;
                     buildDesc.ScratchAccelerationStructureData = buildMemory->address;
 
-                    commandList4->BuildRaytracingAccelerationStructure(&buildDesc, 0, nullptr);
+                    // the compacted size is emitted as part of the build
+                    MemoryEntry* compactedSizeMemory = &container->GetCompactedSizeMemory();
+                    D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_DESC postbuildInfo;
+                    postbuildInfo.DestBuffer = compactedSizeMemory->address;
+                    postbuildInfo.InfoType =
+                        D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_COMPACTED_SIZE;
+                    bool emitCompactedSize = compactedSizeMemory->buffer != nullptr;
+
+                    commandList4->BuildRaytracingAccelerationStructure(
+                        &buildDesc, emitCompactedSize ? 1 : 0,
+                        emitCompactedSize ? &postbuildInfo : nullptr);
 
                     // barrier for result memory
                     D3D12_RESOURCE_BARRIER uavBarrier;
@@ -601,7 +717,12 @@ namespace dawn_native { namespace d3d12 {
                     uavBarrier.UAV.pResource = resultMemory->buffer.Get();
                     commandList->ResourceBarrier(1, &uavBarrier);
 
+                    if (emitCompactedSize) {
+                        RecordCompactedSizeReadback(commandList, container);
+                    }
+
                     container->SetBuildState(true);
+                    container->IncrementBuildCount();
 
                     if (lastUpdateContainer != nullptr) {
                         return DAWN_VALIDATION_ERROR(
@@ -618,6 +739,31 @@ namespace dawn_native { namespace d3d12 {
                     break;
                 }
 
+                case Command::BuildRayTracingAccelerationContainers: {
+                    BuildRayTracingAccelerationContainersCmd* build =
+                        mCommands.NextCommand<BuildRayTracingAccelerationContainersCmd>();
+                    Ref<RayTracingAccelerationContainerBase>* containers =
+                        mCommands.NextData<Ref<RayTracingAccelerationContainerBase>>(build->count);
+                    RayTracingAccelerationContainer* container = ToBackend(containers[0].Get());
+
+                    if (lastUpdateContainer != nullptr) {
+                        return DAWN_VALIDATION_ERROR(
+                            "Build and update passes for acceleration containers must be "
+                            "separated");
+                    }
+                    if (lastBuildContainer != nullptr &&
+                        lastBuildContainer->GetLevel() != container->GetLevel()) {
+                        return DAWN_VALIDATION_ERROR(
+                            "Acceleration containers of different levels must be built in "
+                            "separate passes");
+                    }
+
+                    DAWN_TRY(RecordBuildAccelerationContainers(device, commandContext, containers,
+                                                               build->count));
+                    lastBuildContainer = container;
+                    break;
+                }
+
                 case Command::CopyRayTracingAccelerationContainer: {
                     CopyRayTracingAccelerationContainerCmd* copy =
                         mCommands.NextCommand<CopyRayTracingAccelerationContainerCmd>();
@@ -629,9 +775,25 @@ namespace dawn_native { namespace d3d12 {
                     MemoryEntry* srcMemory = &srcContainer->GetScratchMemory().result;
                     MemoryEntry* dstMemory = &dstContainer->GetScratchMemory().result;
 
+                    D3D12_RAYTRACING_ACCELERATION_STRUCTURE_COPY_MODE copyMode =
+                        D3D12_RAYTRACING_ACCELERATION_STRUCTURE_COPY_MODE_CLONE;
+                    if (copy->mode == wgpu::RayTracingAccelerationContainerCopyMode::Compact) {
+                        copyMode = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_COPY_MODE_COMPACT;
+                    }
+
                     commandList4->CopyRaytracingAccelerationStructure(
-                        dstMemory->address, srcMemory->address,
-                        D3D12_RAYTRACING_ACCELERATION_STRUCTURE_COPY_MODE_CLONE);
+                        dstMemory->address, srcMemory->address, copyMode);
+
+                    // barrier for the destination memory
+                    D3D12_RESOURCE_BARRIER uavBarrier;
+                    uavBarrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+                    uavBarrier.Type = D3D12_RESOURCE_BARRIER_TYPE_UAV;
+                    uavBarrier.UAV.pResource = dstMemory->buffer.Get();
+                    commandList->ResourceBarrier(1, &uavBarrier);
+
+                    if (copy->mode == wgpu::RayTracingAccelerationContainerCopyMode::Compact) {
+                        dstContainer->SetBuildState(true);
+                    }
                     break;
                 }
 
@@ -640,6 +802,12 @@ namespace dawn_native { namespace d3d12 {
                         mCommands.NextCommand<UpdateRayTracingAccelerationContainerCmd>();
                     RayTracingAccelerationContainer* container = ToBackend(update->container.Get());
 
+                    // the driver always refits the whole container
+                    if (update->dirtyRangeCount > 0) {
+                        mCommands.NextData<RayTracingAccelerationContainerDirtyRange>(
+                            update->dirtyRangeCount);
+                    }
+
                     // we can destroy the scratch build memory after the first update
                     if (container->IsBuilt() && !container->IsUpdated()) {
                         container->DestroyScratchBuildMemory();
@@ -668,6 +836,7 @@ namespace dawn_native { namespace d3d12 {
                     commandList->ResourceBarrier(1, &uavBarrier);
 
                     container->SetBuildState(true);
+                    container->IncrementRefitCount();
 
                     if (lastBuildContainer != nullptr) {
                         return DAWN_VALIDATION_ERROR(
@@ -888,7 +1057,7 @@ namespace dawn_native { namespace d3d12 {
 
                 case Command::SetBindGroup: {
                     SetBindGroupCmd* cmd = mCommands.NextCommand<SetBindGroupCmd>();
-                    BindGroup* group = ToBackend(cmd->group.Get());
+                    BindGroup* group = ToBackend(cmd->group);
                     uint32_t* dynamicOffsets = nullptr;
 
                     if (cmd->dynamicOffsetCount > 0) {
@@ -965,11 +1134,8 @@ namespace dawn_native { namespace d3d12 {
 
                     ASSERT(usedPipeline != nullptr);
 
-                    RayTracingShaderBindingTable* sbt =
-                        ToBackend(usedPipeline->GetShaderBindingTable());
-
-                    uint32_t sbtTableSize = sbt->GetTableSize();
-                    ComPtr<ID3D12Resource> sbtTableBuffer = sbt->GetTableBuffer();
+                    uint32_t sbtTableSize = usedPipeline->GetShaderTableSize();
+                    ComPtr<ID3D12Resource> sbtTableBuffer = usedPipeline->GetShaderTableBuffer();
                     D3D12_GPU_VIRTUAL_ADDRESS sbtTableBufferAddress =
                         sbtTableBuffer.Get()->GetGPUVirtualAddress();
 
@@ -1028,7 +1194,7 @@ namespace dawn_native { namespace d3d12 {
 
                 case Command::SetBindGroup: {
                     SetBindGroupCmd* cmd = mCommands.NextCommand<SetBindGroupCmd>();
-                    BindGroup* group = ToBackend(cmd->group.Get());
+                    BindGroup* group = ToBackend(cmd->group);
                     uint32_t* dynamicOffsets = nullptr;
 
                     if (cmd->dynamicOffsetCount > 0) {
@@ -1277,11 +1443,13 @@ namespace dawn_native { namespace d3d12 {
         PipelineLayout* lastLayout = nullptr;
         VertexBufferTracker vertexBufferTracker = {};
         IndexBufferTracker indexBufferTracker = {};
+        DrawCommandDecoder drawDecoder;
 
         auto EncodeRenderBundleCommand = [&](CommandIterator* iter, Command type) -> MaybeError {
             switch (type) {
-                case Command::Draw: {
-                    DrawCmd* draw = iter->NextCommand<DrawCmd>();
+                case Command::Draw:
+                case Command::RepeatDraw: {
+                    DrawCmd* draw = drawDecoder.NextDraw(iter, type);
 
                     DAWN_TRY(bindingTracker->Apply(commandContext));
                     vertexBufferTracker.Apply(commandList, lastPipeline);
@@ -1290,8 +1458,9 @@ namespace dawn_native { namespace d3d12 {
                     break;
                 }
 
-                case Command::DrawIndexed: {
-                    DrawIndexedCmd* draw = iter->NextCommand<DrawIndexedCmd>();
+                case Command::DrawIndexed:
+                case Command::RepeatDrawIndexed: {
+                    DrawIndexedCmd* draw = drawDecoder.NextDrawIndexed(iter, type);
 
                     DAWN_TRY(bindingTracker->Apply(commandContext));
                     indexBufferTracker.Apply(commandList);
@@ -1372,7 +1541,7 @@ namespace dawn_native { namespace d3d12 {
 
                 case Command::SetRenderPipeline: {
                     SetRenderPipelineCmd* cmd = iter->NextCommand<SetRenderPipelineCmd>();
-                    RenderPipeline* pipeline = ToBackend(cmd->pipeline).Get();
+                    RenderPipeline* pipeline = ToBackend(cmd->pipeline);
                     PipelineLayout* layout = ToBackend(pipeline->GetLayout());
 
                     commandList->SetGraphicsRootSignature(layout->GetRootSignature());
@@ -1389,7 +1558,7 @@ namespace dawn_native { namespace d3d12 {
 
                 case Command::SetBindGroup: {
                     SetBindGroupCmd* cmd = iter->NextCommand<SetBindGroupCmd>();
-                    BindGroup* group = ToBackend(cmd->group.Get());
+                    BindGroup* group = ToBackend(cmd->group);
                     uint32_t* dynamicOffsets = nullptr;
 
                     if (cmd->dynamicOffsetCount > 0) {
@@ -1404,7 +1573,7 @@ namespace dawn_native { namespace d3d12 {
                 case Command::SetIndexBuffer: {
                     SetIndexBufferCmd* cmd = iter->NextCommand<SetIndexBufferCmd>();
 
-                    indexBufferTracker.OnSetIndexBuffer(ToBackend(cmd->buffer.Get()), cmd->offset,
+                    indexBufferTracker.OnSetIndexBuffer(ToBackend(cmd->buffer), cmd->offset,
                                                         cmd->size);
                     break;
                 }
@@ -1412,7 +1581,7 @@ namespace dawn_native { namespace d3d12 {
                 case Command::SetVertexBuffer: {
                     SetVertexBufferCmd* cmd = iter->NextCommand<SetVertexBufferCmd>();
 
-                    vertexBufferTracker.OnSetVertexBuffer(cmd->slot, ToBackend(cmd->buffer.Get()),
+                    vertexBufferTracker.OnSetVertexBuffer(cmd->slot, ToBackend(cmd->buffer),
                                                           cmd->offset, cmd->size);
                     break;
                 }
@@ -42,31 +42,14 @@ namespace dawn_native { namespace d3d12 {
         compileFlags |= D3DCOMPILE_PACK_MATRIX_ROW_MAJOR;
 
         ShaderModule* module = ToBackend(descriptor->computeStage.module);
-        std::string hlslSource;
-        DAWN_TRY_ASSIGN(hlslSource, module->GetHLSLSource(ToBackend(GetLayout())));
-
         D3D12_COMPUTE_PIPELINE_STATE_DESC d3dDesc = {};
         d3dDesc.pRootSignature = ToBackend(GetLayout())->GetRootSignature();
 
-        ComPtr<IDxcBlob> compiledDXCShader;
-        ComPtr<ID3DBlob> compiledFXCShader;
-
-        if (device->IsToggleEnabled(Toggle::UseDXC)) {
-            DAWN_TRY_ASSIGN(
-                compiledDXCShader,
-                module->CompileShaderDXC(SingleShaderStage::Compute, hlslSource,
-                                         descriptor->computeStage.entryPoint, compileFlags));
-
-            d3dDesc.CS.pShaderBytecode = compiledDXCShader->GetBufferPointer();
-            d3dDesc.CS.BytecodeLength = compiledDXCShader->GetBufferSize();
-        } else {
-            DAWN_TRY_ASSIGN(
-                compiledFXCShader,
-                module->CompileShaderFXC(SingleShaderStage::Compute, hlslSource,
-                                         descriptor->computeStage.entryPoint, compileFlags));
-            d3dDesc.CS.pShaderBytecode = compiledFXCShader->GetBufferPointer();
-            d3dDesc.CS.BytecodeLength = compiledFXCShader->GetBufferSize();
-        }
+        CompiledShader compiledShader;
+        DAWN_TRY_ASSIGN(compiledShader,
+                        module->Compile(SingleShaderStage::Compute, ToBackend(GetLayout()),
+                                        descriptor->computeStage.entryPoint, compileFlags));
+        d3dDesc.CS = compiledShader.GetD3D12ShaderBytecode();
 
         device->GetD3D12Device()->CreateComputePipelineState(&d3dDesc,
                                                              IID_PPV_ARGS(&mPipelineState));
@@ -44,6 +44,8 @@
 #include "dawn_native/d3d12/StagingDescriptorAllocatorD3D12.h"
 #include "dawn_native/d3d12/SwapChainD3D12.h"
 #include "dawn_native/d3d12/TextureD3D12.h"
+#include "dawn_platform/DawnPlatform.h"
+#include "dawn_platform/tracing/TraceEvent.h"
 
 namespace dawn_native { namespace d3d12 {
 
@@ -212,6 +214,17 @@ namespace dawn_native { namespace d3d12 {
         return mResidencyManager.get();
     }
 
+    void Device::FillStatisticsImpl(DeviceStatistics* statistics) const {
+        statistics->allocatedMemorySize = mResourceAllocatorManager->GetAllocatedMemorySize();
+
+        uint64_t pendingDeletionCount = mResourceAllocatorManager->GetPendingDeallocationCount();
+        for (const ComPtr<IUnknown>& object : mUsedComObjectRefs.IterateAll()) {
+            DAWN_UNUSED(object);
+            pendingDeletionCount++;
+        }
+        statistics->pendingDeletionCount = pendingDeletionCount;
+    }
+
     ResultOrError<CommandRecordingContext*> Device::GetPendingCommandContext() {
         // Callers of GetPendingCommandList do so to record commands. Only reserve a command
         // allocator when it is needed so we don't submit empty command lists
@@ -227,13 +240,17 @@ namespace dawn_native { namespace d3d12 {
         // Perform cleanup operations to free unused objects
         Serial completedSerial = GetCompletedCommandSerial();
 
-        mResourceAllocatorManager->Tick(completedSerial);
-        DAWN_TRY(mCommandAllocatorManager->Tick(completedSerial));
-        mViewShaderVisibleDescriptorAllocator->Tick(completedSerial);
-        mSamplerShaderVisibleDescriptorAllocator->Tick(completedSerial);
-        mRenderTargetViewAllocator->Tick(completedSerial);
-        mDepthStencilViewAllocator->Tick(completedSerial);
-        mUsedComObjectRefs.ClearUpTo(completedSerial);
+        {
+            TRACE_EVENT1(GetPlatform(), General, "DeviceD3D12::DeallocateCompletedResources",
+                         "completedSerial", completedSerial);
+            mResourceAllocatorManager->Tick(completedSerial);
+            DAWN_TRY(mCommandAllocatorManager->Tick(completedSerial));
+            mViewShaderVisibleDescriptorAllocator->Tick(completedSerial);
+            mSamplerShaderVisibleDescriptorAllocator->Tick(completedSerial);
+            mRenderTargetViewAllocator->Tick(completedSerial);
+            mDepthStencilViewAllocator->Tick(completedSerial);
+            mUsedComObjectRefs.ClearUpTo(completedSerial);
+        }
         DAWN_TRY(ExecutePendingCommandContext());
         DAWN_TRY(NextSerial());
         return {};
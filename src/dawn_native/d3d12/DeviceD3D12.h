@@ -164,6 +164,7 @@ namespace dawn_native { namespace d3d12 {
 
         void ShutDownImpl() override;
         MaybeError WaitForIdleForDestruction() override;
+        void FillStatisticsImpl(DeviceStatistics* statistics) const override;
 
         ComPtr<ID3D12Fence> mFence;
         HANDLE mFenceEvent = nullptr;
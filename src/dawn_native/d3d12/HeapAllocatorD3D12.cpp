@@ -61,11 +61,19 @@ namespace dawn_native { namespace d3d12 {
         // Calling CreateHeap implicitly calls MakeResident on the new heap. We must track this to
         // avoid calling MakeResident a second time.
         mDevice->GetResidencyManager()->TrackResidentAllocation(ToBackend(heapBase.get()));
+        mAllocatedSize += size;
         return std::move(heapBase);
     }
 
     void HeapAllocator::DeallocateResourceHeap(std::unique_ptr<ResourceHeapBase> heap) {
-        mDevice->ReferenceUntilUnused(static_cast<Heap*>(heap.get())->GetD3D12Heap());
+        Heap* d3d12Heap = static_cast<Heap*>(heap.get());
+        ASSERT(mAllocatedSize >= d3d12Heap->GetSize());
+        mAllocatedSize -= d3d12Heap->GetSize();
+        mDevice->ReferenceUntilUnused(d3d12Heap->GetD3D12Heap());
+    }
+
+    uint64_t HeapAllocator::GetAllocatedSize() const {
+        return mAllocatedSize;
     }
 
 }}  // namespace dawn_native::d3d12
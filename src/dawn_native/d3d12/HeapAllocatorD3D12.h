@@ -36,11 +36,15 @@ namespace dawn_native { namespace d3d12 {
             uint64_t size) override;
         void DeallocateResourceHeap(std::unique_ptr<ResourceHeapBase> allocation) override;
 
+        // The total size of the heaps currently allocated.
+        uint64_t GetAllocatedSize() const;
+
       private:
         Device* mDevice;
         D3D12_HEAP_TYPE mHeapType;
         D3D12_HEAP_FLAGS mHeapFlags;
         MemorySegment mMemorySegment;
+        uint64_t mAllocatedSize = 0;
     };
 
 }}  // namespace dawn_native::d3d12
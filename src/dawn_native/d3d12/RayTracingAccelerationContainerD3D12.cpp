@@ -16,6 +16,7 @@
 
 #include "common/Assert.h"
 #include "common/Math.h"
+#include "dawn_native/DynamicUploader.h"
 #include "dawn_native/d3d12/D3D12Error.h"
 #include "dawn_native/d3d12/DeviceD3D12.h"
 #include "dawn_native/d3d12/HeapD3D12.h"
@@ -70,14 +71,10 @@ namespace dawn_native { namespace d3d12 {
         Device* device = ToBackend(GetDevice());
         DestroyScratchBuildMemory();
 
-        if (mScratchMemory.result.buffer != nullptr) {
-            device->DeallocateMemory(mScratchMemory.result.resource);
-            mScratchMemory.result.buffer = nullptr;
-        }
-        if (mScratchMemory.update.buffer != nullptr) {
-            device->DeallocateMemory(mScratchMemory.update.resource);
-            mScratchMemory.update.buffer = nullptr;
-        }
+        ReleaseScratchMemory(device, mScratchMemory.result);
+        ReleaseScratchMemory(device, mScratchMemory.update);
+        ReleaseScratchMemory(device, mCompactedSizeMemory);
+        ReleaseScratchMemory(device, mCompactedSizeReadbackMemory);
         if (mInstanceMemory.buffer != nullptr) {
             Buffer* buffer = mInstanceMemory.allocation.Get();
             if (buffer != nullptr) {
@@ -194,26 +191,45 @@ namespace dawn_native { namespace d3d12 {
                 Align(prebuildInfo.UpdateScratchDataSizeInBytes,
                       D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BYTE_ALIGNMENT);
 
-            // allocate memory
-            DAWN_TRY(AllocateScratchMemory(mScratchMemory.result, resultMemorySize,
+            // compacted containers are only written by a compacting copy, so they only need
+            // memory for the compacted result
+            if (descriptor->compactedSize > 0) {
+                resultMemorySize = Align(descriptor->compactedSize,
+                                         D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BYTE_ALIGNMENT);
+                return AllocateScratchMemory(
+                    device, mScratchMemory.result, resultMemorySize,
+                    D3D12_RESOURCE_STATE_RAYTRACING_ACCELERATION_STRUCTURE);
+            }
+
+            // allocate memory, build memory is allocated lazily since batched builds share one
+            // scratch buffer
+            DAWN_TRY(AllocateScratchMemory(device, mScratchMemory.result, resultMemorySize,
                                            D3D12_RESOURCE_STATE_RAYTRACING_ACCELERATION_STRUCTURE));
-            DAWN_TRY(AllocateScratchMemory(mScratchMemory.build, buildMemorySize,
-                                           D3D12_RESOURCE_STATE_UNORDERED_ACCESS));
+            mScratchBuildMemorySize = buildMemorySize;
             if (prebuildInfo.UpdateScratchDataSizeInBytes > 0) {
-                DAWN_TRY(AllocateScratchMemory(mScratchMemory.update, updateMemorySize,
+                DAWN_TRY(AllocateScratchMemory(device, mScratchMemory.update, updateMemorySize,
                                                D3D12_RESOURCE_STATE_UNORDERED_ACCESS));
             }
         }
 
+        if (descriptor->usage & wgpu::RayTracingAccelerationContainerUsage::AllowCompaction) {
+            DAWN_TRY(AllocateCompactedSizeMemory());
+        }
+
         return {};
     }
 
-    MaybeError RayTracingAccelerationContainer::AllocateScratchMemory(
-        MemoryEntry& memoryEntry,
-        uint64_t size,
-        D3D12_RESOURCE_STATES initialUsage) {
-        Device* device = ToBackend(GetDevice());
+    void ReleaseScratchMemory(Device* device, MemoryEntry& memoryEntry) {
+        if (memoryEntry.buffer != nullptr) {
+            device->DeallocateMemory(memoryEntry.resource);
+            memoryEntry.buffer = nullptr;
+        }
+    }
 
+    MaybeError AllocateScratchMemory(Device* device,
+                                     MemoryEntry& memoryEntry,
+                                     uint64_t size,
+                                     D3D12_RESOURCE_STATES initialUsage) {
         D3D12_RESOURCE_DESC resourceDesc;
         resourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
         resourceDesc.Alignment = 0;
@@ -236,6 +252,63 @@ namespace dawn_native { namespace d3d12 {
         return {};
     }
 
+    MaybeError RayTracingAccelerationContainer::AllocateCompactedSizeMemory() {
+        Device* device = ToBackend(GetDevice());
+
+        uint64_t size =
+            sizeof(D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_COMPACTED_SIZE_DESC);
+        DAWN_TRY(AllocateScratchMemory(device, mCompactedSizeMemory, size,
+                                       D3D12_RESOURCE_STATE_UNORDERED_ACCESS));
+
+        D3D12_RESOURCE_DESC resourceDesc;
+        resourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+        resourceDesc.Alignment = 0;
+        resourceDesc.Width = size;
+        resourceDesc.Height = 1;
+        resourceDesc.DepthOrArraySize = 1;
+        resourceDesc.MipLevels = 1;
+        resourceDesc.Format = DXGI_FORMAT_UNKNOWN;
+        resourceDesc.SampleDesc.Count = 1;
+        resourceDesc.SampleDesc.Quality = 0;
+        resourceDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+        resourceDesc.Flags = D3D12_RESOURCE_FLAG_NONE;
+
+        // D3D12 requires buffers on the READBACK heap to be in the COPY_DEST state
+        DAWN_TRY_ASSIGN(mCompactedSizeReadbackMemory.resource,
+                        device->AllocateMemory(D3D12_HEAP_TYPE_READBACK, resourceDesc,
+                                               D3D12_RESOURCE_STATE_COPY_DEST));
+        mCompactedSizeReadbackMemory.buffer =
+            mCompactedSizeReadbackMemory.resource.GetD3D12Resource();
+        mCompactedSizeReadbackMemory.address =
+            mCompactedSizeReadbackMemory.buffer.Get()->GetGPUVirtualAddress();
+
+        return {};
+    }
+
+    ResultOrError<uint64_t> RayTracingAccelerationContainer::GetCompactedSizeImpl() {
+        ASSERT(mCompactedSizeReadbackMemory.buffer != nullptr);
+
+        D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_COMPACTED_SIZE_DESC* data = nullptr;
+        D3D12_RANGE readRange = {0, sizeof(*data)};
+        DAWN_TRY(CheckHRESULT(mCompactedSizeReadbackMemory.buffer->Map(
+                                  0, &readRange, reinterpret_cast<void**>(&data)),
+                              "D3D12 map compacted size"));
+        uint64_t compactedSize = data->CompactedSizeInBytes;
+
+        D3D12_RANGE writeRange = {0, 0};
+        mCompactedSizeReadbackMemory.buffer->Unmap(0, &writeRange);
+
+        return compactedSize;
+    }
+
+    MemoryEntry& RayTracingAccelerationContainer::GetCompactedSizeMemory() {
+        return mCompactedSizeMemory;
+    }
+
+    MemoryEntry& RayTracingAccelerationContainer::GetCompactedSizeReadbackMemory() {
+        return mCompactedSizeReadbackMemory;
+    }
+
     ScratchMemoryPool& RayTracingAccelerationContainer::GetScratchMemory() {
         return mScratchMemory;
     }
@@ -250,23 +323,43 @@ namespace dawn_native { namespace d3d12 {
     }
 
     void RayTracingAccelerationContainer::DestroyScratchBuildMemory() {
-        Device* device = ToBackend(GetDevice());
-        // delete scratch build memory
+        ReleaseScratchMemory(ToBackend(GetDevice()), mScratchMemory.build);
+    }
+
+    MaybeError RayTracingAccelerationContainer::EnsureScratchBuildMemory() {
         if (mScratchMemory.build.buffer != nullptr) {
-            device->DeallocateMemory(mScratchMemory.build.resource);
-            mScratchMemory.build.buffer = nullptr;
+            return {};
         }
+        return AllocateScratchMemory(ToBackend(GetDevice()), mScratchMemory.build,
+                                     mScratchBuildMemorySize,
+                                     D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
     }
 
-    MaybeError RayTracingAccelerationContainer::UpdateInstanceImpl(
-        uint32_t instanceIndex,
-        const RayTracingAccelerationInstanceDescriptor* descriptor) {
-        uint32_t start = instanceIndex * sizeof(D3D12_RAYTRACING_INSTANCE_DESC);
-        uint32_t count = sizeof(D3D12_RAYTRACING_INSTANCE_DESC);
-        D3D12_RAYTRACING_INSTANCE_DESC instanceData = GetD3D12AccelerationInstance(*descriptor);
-        mInstanceMemory.allocation.Get()->SetSubData(start, count,
-                                                     reinterpret_cast<void*>(&instanceData));
-        return {};
+    uint64_t RayTracingAccelerationContainer::GetScratchBuildMemorySize() const {
+        return mScratchBuildMemorySize;
+    }
+
+    MaybeError RayTracingAccelerationContainer::UpdateInstancesImpl(
+        uint32_t firstInstance,
+        uint32_t instanceCount,
+        const RayTracingAccelerationInstanceDescriptor* descriptors) {
+        Device* device = ToBackend(GetDevice());
+        constexpr uint64_t kInstanceSize = sizeof(D3D12_RAYTRACING_INSTANCE_DESC);
+        uint64_t size = uint64_t(instanceCount) * kInstanceSize;
+
+        // write all instances to one staging region and flush them with a single copy
+        UploadHandle uploadHandle;
+        DAWN_TRY_ASSIGN(uploadHandle, device->GetDynamicUploader()->Allocate(
+                                          size, device->GetPendingCommandSerial()));
+        for (uint32_t i = 0; i < instanceCount; ++i) {
+            D3D12_RAYTRACING_INSTANCE_DESC instanceData =
+                GetD3D12AccelerationInstance(descriptors[i]);
+            memcpy(uploadHandle.mappedBuffer + i * kInstanceSize, &instanceData, kInstanceSize);
+        }
+
+        return device->CopyFromStagingToBuffer(uploadHandle.stagingBuffer, uploadHandle.startOffset,
+                                               mInstanceMemory.allocation.Get(),
+                                               firstInstance * kInstanceSize, size);
     }
 
 }}  // namespace dawn_native::d3d12
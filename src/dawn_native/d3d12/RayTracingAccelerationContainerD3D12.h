@@ -36,6 +36,14 @@ namespace dawn_native { namespace d3d12 {
         MemoryEntry build;
     };
 
+    // Allocates a UAV buffer acceleration containers can be built in or use as scratch memory.
+    MaybeError AllocateScratchMemory(Device* device,
+                                     MemoryEntry& memoryEntry,
+                                     uint64_t size,
+                                     D3D12_RESOURCE_STATES initialResourceState);
+    // Releases the buffer once the pending commands are finished.
+    void ReleaseScratchMemory(Device* device, MemoryEntry& memoryEntry);
+
     class RayTracingAccelerationContainer : public RayTracingAccelerationContainerBase {
       public:
         static ResultOrError<RayTracingAccelerationContainer*> Create(
@@ -47,29 +55,41 @@ namespace dawn_native { namespace d3d12 {
         D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_INPUTS& GetBuildInformation();
 
         void DestroyScratchBuildMemory();
+        // Reallocates the scratch build memory if it was destroyed, to rebuild the container.
+        MaybeError EnsureScratchBuildMemory();
+        uint64_t GetScratchBuildMemorySize() const;
+
+        // Buffers the compacted size is emitted to after each build and read back from. Only
+        // allocated for containers that allow compaction.
+        MemoryEntry& GetCompactedSizeMemory();
+        MemoryEntry& GetCompactedSizeReadbackMemory();
 
       private:
         using RayTracingAccelerationContainerBase::RayTracingAccelerationContainerBase;
 
         void DestroyImpl() override;
-        MaybeError UpdateInstanceImpl(
-            uint32_t instanceIndex,
-            const RayTracingAccelerationInstanceDescriptor* descriptor) override;
-
-        MaybeError AllocateScratchMemory(MemoryEntry& memoryEntry,
-                                         uint64_t size,
-                                         D3D12_RESOURCE_STATES initialResourceState);
+        MaybeError UpdateInstancesImpl(
+            uint32_t firstInstance,
+            uint32_t instanceCount,
+            const RayTracingAccelerationInstanceDescriptor* descriptors) override;
+        ResultOrError<uint64_t> GetCompactedSizeImpl() override;
 
         // scratch memory
         ScratchMemoryPool mScratchMemory;
+        uint64_t mScratchBuildMemorySize = 0;
 
         MemoryEntry mInstanceMemory;
 
+        MemoryEntry mCompactedSizeMemory;
+        MemoryEntry mCompactedSizeReadbackMemory;
+
         std::vector<D3D12_RAYTRACING_GEOMETRY_DESC> mGeometries;
         std::vector<D3D12_RAYTRACING_INSTANCE_DESC> mInstances;
 
         D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_INPUTS mBuildInformation;
 
+        MaybeError AllocateCompactedSizeMemory();
+
         MaybeError Initialize(const RayTracingAccelerationContainerDescriptor* descriptor);
     };
 
@@ -15,6 +15,7 @@
 #include "dawn_native/d3d12/RayTracingPipelineD3D12.h"
 
 #include "common/Assert.h"
+#include "common/Math.h"
 #include "dawn_native/d3d12/D3D12Error.h"
 #include "dawn_native/d3d12/DeviceD3D12.h"
 #include "dawn_native/d3d12/PipelineLayoutD3D12.h"
@@ -120,23 +121,20 @@ namespace dawn_native { namespace d3d12 {
         std::vector<D3D12_STATE_SUBOBJECT> subObjects(subObjectCount);
 
         // Lifetime objects
-        std::vector<ComPtr<IDxcBlob>> shaderBlobs(stages.size());
+        std::vector<CompiledShader> compiledShaders(stages.size());
         std::vector<D3D12_EXPORT_DESC> shaderExportDescs(stages.size());
         std::vector<D3D12_DXIL_LIBRARY_DESC> dxilLibraryDescs(stages.size());
         // Write shaders into subobjects
         for (unsigned int ii = 0; ii < stages.size(); ++ii) {
             RayTracingShaderBindingTableStageDescriptor& stage = stages[ii];
             ShaderModule* module = ToBackend(stage.module);
-            // Generate HLSL
-            std::string shaderSource;
-            uint32_t compileFlags = D3DCOMPILE_OPTIMIZATION_LEVEL2;
-            DAWN_TRY_ASSIGN(shaderSource, module->GetHLSLSource(layout));
             // Compile to DXBC
-            DAWN_TRY_ASSIGN(shaderBlobs[ii],
-                            module->CompileShaderDXC(module->GetExecutionModel(), shaderSource,
-                                                     "main", compileFlags));
+            uint32_t compileFlags = D3DCOMPILE_OPTIMIZATION_LEVEL2;
+            DAWN_TRY_ASSIGN(compiledShaders[ii], module->Compile(module->GetExecutionModel(),
+                                                                 layout, "main", compileFlags));
+            D3D12_SHADER_BYTECODE shaderBytecode = compiledShaders[ii].GetD3D12ShaderBytecode();
             // Validate DXBC
-            if (!IsValidDXBC(shaderBlobs[ii]->GetBufferPointer())) {
+            if (!IsValidDXBC(shaderBytecode.pShaderBytecode)) {
                 return DAWN_VALIDATION_ERROR("DXBC is corrupted or unsigned");
             }
             // Shader export
@@ -144,8 +142,7 @@ namespace dawn_native { namespace d3d12 {
             shaderExportDescs[ii].ExportToRename = mainShaderEntry;
             shaderExportDescs[ii].Flags = D3D12_EXPORT_FLAG_NONE;
             // Shader library
-            dxilLibraryDescs[ii].DXILLibrary.BytecodeLength = shaderBlobs[ii]->GetBufferSize();
-            dxilLibraryDescs[ii].DXILLibrary.pShaderBytecode = shaderBlobs[ii]->GetBufferPointer();
+            dxilLibraryDescs[ii].DXILLibrary = shaderBytecode;
             dxilLibraryDescs[ii].NumExports = 1;
             dxilLibraryDescs[ii].pExports = &shaderExportDescs[ii];
             // Write shader object
@@ -245,13 +242,86 @@ namespace dawn_native { namespace d3d12 {
             mShaderExportIdentifiers.push_back(shaderIdentifier);
         }
 
-        DAWN_TRY(sbt->Generate(this, layout));
+        DAWN_TRY(InitializeShaderTable(sbt));
 
         return {};
     }
 
+    MaybeError RayTracingPipeline::InitializeShaderTable(RayTracingShaderBindingTable* sbt) {
+        Device* device = ToBackend(GetDevice());
+
+        std::vector<RayTracingShaderBindingTableStageDescriptor>& stages = sbt->GetStages();
+        std::vector<RayTracingShaderBindingTableGroupDescriptor>& groups = sbt->GetGroups();
+
+        uint32_t genSectionSize = 0;
+        uint32_t hitSectionSize = 0;
+        uint32_t missSectionSize = 0;
+        for (unsigned int ii = 0; ii < groups.size(); ++ii) {
+            RayTracingShaderBindingTableGroupDescriptor& group = groups[ii];
+            // we don't use local root sigs yet, so the entry size is the same for all entries
+            uint32_t baseEntrySize = D3D12_SHADER_IDENTIFIER_SIZE_IN_BYTES;
+            // general
+            if (group.generalIndex != -1) {
+                auto& stage = stages.at(group.generalIndex);
+                // gen
+                if (stage.stage == wgpu::ShaderStage::RayGeneration) {
+                    genSectionSize += baseEntrySize;
+                }
+                // miss
+                else if (stage.stage == wgpu::ShaderStage::RayMiss) {
+                    missSectionSize += baseEntrySize;
+                }
+            }
+            // hit
+            else {
+                hitSectionSize += baseEntrySize;
+            }
+        }
+        // align each section
+        genSectionSize = Align(genSectionSize, D3D12_RAYTRACING_SHADER_TABLE_BYTE_ALIGNMENT);
+        hitSectionSize = Align(hitSectionSize, D3D12_RAYTRACING_SHADER_TABLE_BYTE_ALIGNMENT);
+        missSectionSize = Align(missSectionSize, D3D12_RAYTRACING_SHADER_TABLE_BYTE_ALIGNMENT);
+
+        mShaderTableSize = genSectionSize + hitSectionSize + missSectionSize;
+
+        D3D12_RESOURCE_DESC resourceDesc;
+        resourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+        resourceDesc.Alignment = 0;
+        resourceDesc.Width = mShaderTableSize;
+        resourceDesc.Height = 1;
+        resourceDesc.DepthOrArraySize = 1;
+        resourceDesc.MipLevels = 1;
+        resourceDesc.Format = DXGI_FORMAT_UNKNOWN;
+        resourceDesc.SampleDesc.Count = 1;
+        resourceDesc.SampleDesc.Quality = 0;
+        resourceDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+        resourceDesc.Flags = D3D12_RESOURCE_FLAG_NONE;
+
+        DAWN_TRY_ASSIGN(mShaderTableResource,
+                        device->AllocateMemory(D3D12_HEAP_TYPE_UPLOAD, resourceDesc,
+                                               D3D12_RESOURCE_STATE_GENERIC_READ));
+        mShaderTableBuffer = mShaderTableResource.GetD3D12Resource();
+
+        // Map the SBT
+        uint8_t* pData;
+        DAWN_TRY(CheckHRESULT(mShaderTableBuffer->Map(0, nullptr, (void**)&pData), "Map SBT"));
+
+        uint32_t offset = 0;
+        for (unsigned int ii = 0; ii < groups.size(); ++ii) {
+            memcpy(pData + offset, GetShaderIdentifier(ii),
+                   D3D12_SHADER_IDENTIFIER_SIZE_IN_BYTES);
+            offset = Align(offset + mShaderTableSize, D3D12_RAYTRACING_SHADER_TABLE_BYTE_ALIGNMENT);
+        }
+
+        // Unmap the SBT
+        mShaderTableBuffer->Unmap(0, nullptr);
+        return {};
+    }
+
     RayTracingPipeline::~RayTracingPipeline() {
-        ToBackend(GetDevice())->ReferenceUntilUnused(mPipelineState);
+        Device* device = ToBackend(GetDevice());
+        device->DeallocateMemory(mShaderTableResource);
+        device->ReferenceUntilUnused(mPipelineState);
     }
 
     void* RayTracingPipeline::GetShaderIdentifier(uint32_t index) {
@@ -266,4 +336,12 @@ namespace dawn_native { namespace d3d12 {
         return mPipelineInfo.Get();
     }
 
+    uint32_t RayTracingPipeline::GetShaderTableSize() const {
+        return mShaderTableSize;
+    }
+
+    ID3D12Resource* RayTracingPipeline::GetShaderTableBuffer() {
+        return mShaderTableBuffer.Get();
+    }
+
 }}  // namespace dawn_native::d3d12
@@ -21,11 +21,13 @@
 #include <vector>
 
 #include "dawn_native/RayTracingPipeline.h"
+#include "dawn_native/d3d12/ResourceHeapAllocationD3D12.h"
 #include "dawn_native/d3d12/d3d12_platform.h"
 
 namespace dawn_native { namespace d3d12 {
 
     class Device;
+    class RayTracingShaderBindingTable;
 
     class RayTracingPipeline : public RayTracingPipelineBase {
       public:
@@ -39,14 +41,24 @@ namespace dawn_native { namespace d3d12 {
         ID3D12StateObject* GetPipelineState();
         ID3D12StateObjectProperties* GetPipelineInfo();
 
+        uint32_t GetShaderTableSize() const;
+        ID3D12Resource* GetShaderTableBuffer();
+
       private:
         using RayTracingPipelineBase::RayTracingPipelineBase;
         MaybeError Initialize(const RayTracingPipelineDescriptor* descriptor);
+        MaybeError InitializeShaderTable(RayTracingShaderBindingTable* sbt);
 
         ComPtr<ID3D12StateObject> mPipelineState;
         ComPtr<ID3D12StateObjectProperties> mPipelineInfo;
 
         std::vector<void*> mShaderExportIdentifiers;
+
+        // The shader table holds the identifiers of this pipeline's groups, so pipelines created
+        // with the same shader binding table don't overwrite each other's.
+        ResourceHeapAllocation mShaderTableResource;
+        ComPtr<ID3D12Resource> mShaderTableBuffer;
+        uint32_t mShaderTableSize = 0;
     };
 
 }}  // namespace dawn_native::d3d12
@@ -18,9 +18,6 @@
 #include <vector>
 
 #include "dawn_native/RayTracingShaderBindingTable.h"
-#include "dawn_native/d3d12/BufferD3D12.h"
-#include "dawn_native/d3d12/PipelineLayoutD3D12.h"
-#include "dawn_native/d3d12/RayTracingPipelineD3D12.h"
 #include "dawn_native/d3d12/ShaderModuleD3D12.h"
 #include "dawn_native/d3d12/d3d12_platform.h"
 
@@ -35,11 +32,6 @@ namespace dawn_native { namespace d3d12 {
             const RayTracingShaderBindingTableDescriptor* descriptor);
         ~RayTracingShaderBindingTable() override;
 
-        uint32_t GetTableSize() const;
-        ID3D12Resource* GetTableBuffer();
-
-        MaybeError Generate(RayTracingPipeline* pipeline, PipelineLayout* pipelineLayout);
-
         std::vector<RayTracingShaderBindingTableStageDescriptor>& GetStages();
         std::vector<RayTracingShaderBindingTableGroupDescriptor>& GetGroups();
 
@@ -49,10 +41,6 @@ namespace dawn_native { namespace d3d12 {
         std::vector<RayTracingShaderBindingTableStageDescriptor> mStages;
         std::vector<RayTracingShaderBindingTableGroupDescriptor> mGroups;
 
-        ResourceHeapAllocation mTableResource;
-        ComPtr<ID3D12Resource> mTableBuffer;
-        uint32_t mTableSize;
-
         void DestroyImpl() override;
 
         MaybeError Initialize(const RayTracingShaderBindingTableDescriptor* descriptor);
@@ -210,7 +210,10 @@ namespace dawn_native { namespace d3d12 {
         // manually deleted upon deallocation. See ResourceAllocatorManager::CreateCommittedResource
         // for more information.
         if (allocation.GetInfo().mMethod == AllocationMethod::kDirect) {
-            delete allocation.GetResourceHeap();
+            Heap* heap = ToBackend(allocation.GetResourceHeap());
+            ASSERT(mCommittedResourceSize >= heap->GetSize());
+            mCommittedResourceSize -= heap->GetSize();
+            delete heap;
         }
 
         // Invalidate the allocation immediately in case one accidentally
@@ -220,6 +223,23 @@ namespace dawn_native { namespace d3d12 {
         ASSERT(allocation.GetD3D12Resource().Get() == nullptr);
     }
 
+    uint64_t ResourceAllocatorManager::GetAllocatedMemorySize() const {
+        uint64_t size = mCommittedResourceSize;
+        for (const std::unique_ptr<HeapAllocator>& allocator : mHeapAllocators) {
+            size += allocator->GetAllocatedSize();
+        }
+        return size;
+    }
+
+    uint64_t ResourceAllocatorManager::GetPendingDeallocationCount() const {
+        uint64_t count = 0;
+        for (const ResourceHeapAllocation& allocation : mAllocationsToDelete.IterateAll()) {
+            DAWN_UNUSED(allocation);
+            count++;
+        }
+        return count;
+    }
+
     void ResourceAllocatorManager::FreeMemory(ResourceHeapAllocation& allocation) {
         ASSERT(allocation.GetInfo().mMethod == AllocationMethod::kSubAllocated);
 
@@ -358,6 +378,7 @@ namespace dawn_native { namespace d3d12 {
         // Calling CreateCommittedResource implicitly calls MakeResident on the resource. We must
         // track this to avoid calling MakeResident a second time.
         mDevice->GetResidencyManager()->TrackResidentAllocation(heap);
+        mCommittedResourceSize += resourceInfo.SizeInBytes;
 
         AllocationInfo info;
         info.mMethod = AllocationMethod::kDirect;
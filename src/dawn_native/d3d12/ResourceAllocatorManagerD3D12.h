@@ -67,6 +67,11 @@ namespace dawn_native { namespace d3d12 {
 
         void Tick(Serial lastCompletedSerial);
 
+        // The size of the heaps and committed resources currently allocated, and the number of
+        // allocations waiting for the GPU to be done with them, for the device statistics.
+        uint64_t GetAllocatedMemorySize() const;
+        uint64_t GetPendingDeallocationCount() const;
+
       private:
         void FreeMemory(ResourceHeapAllocation& allocation);
 
@@ -91,6 +96,8 @@ namespace dawn_native { namespace d3d12 {
         std::array<std::unique_ptr<HeapAllocator>, ResourceHeapKind::EnumCount> mHeapAllocators;
 
         SerialQueue<ResourceHeapAllocation> mAllocationsToDelete;
+
+        uint64_t mCommittedResourceSize = 0;
     };
 
 }}  // namespace dawn_native::d3d12
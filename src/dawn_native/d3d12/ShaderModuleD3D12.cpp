@@ -76,6 +76,20 @@ namespace dawn_native { namespace d3d12 {
             return arguments;
         }
 
+        // FXC has no target profile for ray tracing shaders.
+        bool RequiresDXC(SingleShaderStage stage) {
+            switch (stage) {
+                case SingleShaderStage::RayGeneration:
+                case SingleShaderStage::RayAnyHit:
+                case SingleShaderStage::RayClosestHit:
+                case SingleShaderStage::RayMiss:
+                case SingleShaderStage::RayIntersection:
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
     }  // anonymous namespace
 
     // static
@@ -123,6 +137,64 @@ namespace dawn_native { namespace d3d12 {
         return {};
     }
 
+    ResultOrError<CompiledShader> ShaderModule::Compile(SingleShaderStage stage,
+                                                        PipelineLayout* layout,
+                                                        const char* entryPoint,
+                                                        uint32_t compileFlags) {
+        Device* device = ToBackend(GetDevice());
+        PersistentCache* persistentCache = device->GetPersistentCache();
+
+        // Both the translation to HLSL and the compilation are skipped on a cache hit.
+        const PersistentCacheKey shaderCacheKey =
+            CreateHLSLKey(stage, layout, entryPoint, compileFlags);
+
+        CompiledShader compiledShader = {};
+        compiledShader.cachedShader = persistentCache->LoadData(shaderCacheKey);
+        if (compiledShader.cachedShader.buffer != nullptr) {
+            return std::move(compiledShader);
+        }
+
+        std::string hlslSource;
+        DAWN_TRY_ASSIGN(hlslSource, GetHLSLSource(layout));
+
+        if (device->IsToggleEnabled(Toggle::UseDXC) || RequiresDXC(stage)) {
+            DAWN_TRY_ASSIGN(compiledShader.compiledDXCShader,
+                            CompileShaderDXC(stage, hlslSource, entryPoint, compileFlags));
+        } else {
+            DAWN_TRY_ASSIGN(compiledShader.compiledFXCShader,
+                            CompileShaderFXC(stage, hlslSource, entryPoint, compileFlags));
+        }
+
+        const D3D12_SHADER_BYTECODE shader = compiledShader.GetD3D12ShaderBytecode();
+        persistentCache->StoreData(shaderCacheKey, shader.pShaderBytecode, shader.BytecodeLength);
+
+        return std::move(compiledShader);
+    }
+
+    PersistentCacheKey ShaderModule::CreateHLSLKey(SingleShaderStage stage,
+                                                   PipelineLayout* layout,
+                                                   const char* entryPoint,
+                                                   uint32_t compileFlags) const {
+        // The toggles recorded by PersistentCacheKeyRecorder select between spvc, SPIRV-Cross,
+        // FXC and DXC. Besides them, the binary only depends on the SPIR-V, the registers the
+        // layout assigns to the bindings, and the compilation parameters.
+        PersistentCacheKeyRecorder recorder(GetDevice(), PersistentKeyType::Shader);
+        recorder.Record(GetSpirv()).Record(stage).Record(std::string(entryPoint));
+        recorder.Record(compileFlags);
+
+        const ModuleBindingInfo& moduleBindingInfo = GetBindingInfo();
+        for (uint32_t group : IterateBitSet(layout->GetBindGroupLayoutsMask())) {
+            const BindGroupLayout* bgl = ToBackend(layout->GetBindGroupLayout(group));
+            const auto& bindingOffsets = bgl->GetBindingOffsets();
+            for (const auto& it : moduleBindingInfo[group]) {
+                BindingNumber bindingNumber = it.first;
+                BindingIndex bindingIndex = bgl->GetBindingIndex(bindingNumber);
+                recorder.Record(group).Record(bindingNumber).Record(bindingOffsets[bindingIndex]);
+            }
+        }
+        return recorder.GetKey();
+    }
+
     ResultOrError<std::string> ShaderModule::GetHLSLSource(PipelineLayout* layout) {
         ASSERT(!IsError());
         const std::vector<uint32_t>& spirv = GetSpirv();
@@ -290,4 +362,16 @@ namespace dawn_native { namespace d3d12 {
         return std::move(compiledShader);
     }
 
+    D3D12_SHADER_BYTECODE CompiledShader::GetD3D12ShaderBytecode() const {
+        if (cachedShader.buffer != nullptr) {
+            return {cachedShader.buffer.get(), cachedShader.bufferSize};
+        } else if (compiledFXCShader != nullptr) {
+            return {compiledFXCShader->GetBufferPointer(), compiledFXCShader->GetBufferSize()};
+        } else if (compiledDXCShader != nullptr) {
+            return {compiledDXCShader->GetBufferPointer(), compiledDXCShader->GetBufferSize()};
+        }
+        UNREACHABLE();
+        return {};
+    }
+
 }}  // namespace dawn_native::d3d12
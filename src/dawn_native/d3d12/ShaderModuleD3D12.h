@@ -15,6 +15,7 @@
 #ifndef DAWNNATIVE_D3D12_SHADERMODULED3D12_H_
 #define DAWNNATIVE_D3D12_SHADERMODULED3D12_H_
 
+#include "dawn_native/PersistentCache.h"
 #include "dawn_native/ShaderModule.h"
 
 #include "dawn_native/d3d12/d3d12_platform.h"
@@ -24,11 +25,27 @@ namespace dawn_native { namespace d3d12 {
     class Device;
     class PipelineLayout;
 
+    // Manages a ref to one of the various representations of shader blobs.
+    struct CompiledShader {
+        ScopedCachedBlob cachedShader;
+        ComPtr<ID3DBlob> compiledFXCShader;
+        ComPtr<IDxcBlob> compiledDXCShader;
+        D3D12_SHADER_BYTECODE GetD3D12ShaderBytecode() const;
+    };
+
     class ShaderModule final : public ShaderModuleBase {
       public:
         static ResultOrError<ShaderModule*> Create(Device* device,
                                                    const ShaderModuleDescriptor* descriptor);
 
+        // Returns the shader compiled with DXC if the UseDXC toggle is enabled or the stage is a
+        // ray tracing stage, and with FXC otherwise. The result is loaded from the device's
+        // persistent cache when a previous run already compiled it.
+        ResultOrError<CompiledShader> Compile(SingleShaderStage stage,
+                                              PipelineLayout* layout,
+                                              const char* entryPoint,
+                                              uint32_t compileFlags);
+
         ResultOrError<std::string> GetHLSLSource(PipelineLayout* layout);
 
         ResultOrError<ComPtr<IDxcBlob>> CompileShaderDXC(SingleShaderStage stage,
@@ -44,6 +61,11 @@ namespace dawn_native { namespace d3d12 {
         ShaderModule(Device* device, const ShaderModuleDescriptor* descriptor);
         ~ShaderModule() override = default;
         MaybeError Initialize();
+
+        PersistentCacheKey CreateHLSLKey(SingleShaderStage stage,
+                                         PipelineLayout* layout,
+                                         const char* entryPoint,
+                                         uint32_t compileFlags) const;
     };
 
 }}  // namespace dawn_native::d3d12
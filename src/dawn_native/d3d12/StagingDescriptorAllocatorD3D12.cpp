@@ -17,6 +17,8 @@
 #include "dawn_native/d3d12/D3D12Error.h"
 #include "dawn_native/d3d12/DeviceD3D12.h"
 #include "dawn_native/d3d12/StagingDescriptorAllocatorD3D12.h"
+#include "dawn_platform/DawnPlatform.h"
+#include "dawn_platform/tracing/TraceEvent.h"
 
 namespace dawn_native { namespace d3d12 {
 
@@ -68,6 +70,8 @@ namespace dawn_native { namespace d3d12 {
     }
 
     MaybeError StagingDescriptorAllocator::AllocateCPUHeap() {
+        TRACE_EVENT1(mDevice->GetPlatform(), General, "StagingDescriptorAllocator::AllocateCPUHeap",
+                     "heapSize", mHeapSize);
         D3D12_DESCRIPTOR_HEAP_DESC heapDescriptor;
         heapDescriptor.Type = mHeapType;
         heapDescriptor.NumDescriptors = mHeapSize;
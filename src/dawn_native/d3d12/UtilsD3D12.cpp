@@ -138,6 +138,9 @@ namespace dawn_native { namespace d3d12 {
         if (buildUsage & wgpu::RayTracingAccelerationContainerUsage::LowMemory) {
             flags |= D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_MINIMIZE_MEMORY;
         }
+        if (buildUsage & wgpu::RayTracingAccelerationContainerUsage::AllowCompaction) {
+            flags |= D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_ALLOW_COMPACTION;
+        }
         return static_cast<D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAGS>(flags);
     }
 
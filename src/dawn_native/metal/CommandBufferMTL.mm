@@ -895,7 +895,7 @@ namespace dawn_native { namespace metal {
                         dynamicOffsets = mCommands.NextData<uint32_t>(cmd->dynamicOffsetCount);
                     }
 
-                    bindGroups.OnSetBindGroup(cmd->index, ToBackend(cmd->group.Get()),
+                    bindGroups.OnSetBindGroup(cmd->index, ToBackend(cmd->group),
                                               cmd->dynamicOffsetCount, dynamicOffsets);
                     break;
                 }
@@ -1040,13 +1040,15 @@ namespace dawn_native { namespace metal {
         VertexBufferTracker vertexBuffers;
         StorageBufferLengthTracker storageBufferLengths = {};
         BindGroupTracker bindGroups(&storageBufferLengths);
+        DrawCommandDecoder drawDecoder;
 
         id<MTLRenderCommandEncoder> encoder = commandContext->BeginRender(mtlRenderPass);
 
         auto EncodeRenderBundleCommand = [&](CommandIterator* iter, Command type) {
             switch (type) {
-                case Command::Draw: {
-                    DrawCmd* draw = iter->NextCommand<DrawCmd>();
+                case Command::Draw:
+                case Command::RepeatDraw: {
+                    DrawCmd* draw = drawDecoder.NextDraw(iter, type);
 
                     vertexBuffers.Apply(encoder, lastPipeline);
                     bindGroups.Apply(encoder);
@@ -1071,8 +1073,9 @@ namespace dawn_native { namespace metal {
                     break;
                 }
 
-                case Command::DrawIndexed: {
-                    DrawIndexedCmd* draw = iter->NextCommand<DrawIndexedCmd>();
+                case Command::DrawIndexed:
+                case Command::RepeatDrawIndexed: {
+                    DrawIndexedCmd* draw = drawDecoder.NextDrawIndexed(iter, type);
                     size_t formatSize =
                         IndexFormatSize(lastPipeline->GetVertexStateDescriptor()->indexFormat);
 
@@ -1169,7 +1172,7 @@ namespace dawn_native { namespace metal {
 
                 case Command::SetRenderPipeline: {
                     SetRenderPipelineCmd* cmd = iter->NextCommand<SetRenderPipelineCmd>();
-                    RenderPipeline* newPipeline = ToBackend(cmd->pipeline).Get();
+                    RenderPipeline* newPipeline = ToBackend(cmd->pipeline);
 
                     vertexBuffers.OnSetPipeline(lastPipeline, newPipeline);
                     bindGroups.OnSetPipeline(newPipeline);
@@ -1190,14 +1193,14 @@ namespace dawn_native { namespace metal {
                         dynamicOffsets = iter->NextData<uint32_t>(cmd->dynamicOffsetCount);
                     }
 
-                    bindGroups.OnSetBindGroup(cmd->index, ToBackend(cmd->group.Get()),
+                    bindGroups.OnSetBindGroup(cmd->index, ToBackend(cmd->group),
                                               cmd->dynamicOffsetCount, dynamicOffsets);
                     break;
                 }
 
                 case Command::SetIndexBuffer: {
                     SetIndexBufferCmd* cmd = iter->NextCommand<SetIndexBufferCmd>();
-                    auto b = ToBackend(cmd->buffer.Get());
+                    auto b = ToBackend(cmd->buffer);
                     indexBuffer = b->GetMTLBuffer();
                     indexBufferBaseOffset = cmd->offset;
                     break;
@@ -1206,7 +1209,7 @@ namespace dawn_native { namespace metal {
                 case Command::SetVertexBuffer: {
                     SetVertexBufferCmd* cmd = iter->NextCommand<SetVertexBufferCmd>();
 
-                    vertexBuffers.OnSetVertexBuffer(cmd->slot, ToBackend(cmd->buffer.Get()),
+                    vertexBuffers.OnSetVertexBuffer(cmd->slot, ToBackend(cmd->buffer),
                                                     cmd->offset);
                     break;
                 }
@@ -0,0 +1,689 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/null/BVHNull.h"
+
+#include "common/Assert.h"
+#include "common/Math.h"
+#include "common/ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+
+namespace dawn_native { namespace null {
+
+    namespace {
+
+        constexpr float kInfinity = std::numeric_limits<float>::infinity();
+
+        void Cross(const float a[3], const float b[3], float out[3]) {
+            out[0] = a[1] * b[2] - a[2] * b[1];
+            out[1] = a[2] * b[0] - a[0] * b[2];
+            out[2] = a[0] * b[1] - a[1] * b[0];
+        }
+
+        float Dot(const float a[3], const float b[3]) {
+            return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+        }
+
+    }  // anonymous namespace
+
+    // BVHBounds
+
+    // static
+    BVHBounds BVHBounds::Empty() {
+        return {{kInfinity, kInfinity, kInfinity}, {-kInfinity, -kInfinity, -kInfinity}};
+    }
+
+    // BVHRayInverse
+
+    BVHRayInverse::BVHRayInverse(const BVHRay& ray) {
+        for (uint32_t axis = 0; axis < 3; ++axis) {
+            origin[axis] = ray.origin[axis];
+            // Division by zero gives an infinity of the right sign which the slab test handles.
+            invDirection[axis] = 1.0f / ray.direction[axis];
+        }
+    }
+
+    // BVHKernel
+
+    bool IsBVHKernelSupported(BVHKernel kernel) {
+        switch (kernel) {
+            case BVHKernel::Scalar:
+                return true;
+            case BVHKernel::SSE2:
+#if defined(DAWN_NULL_BVH_SSE2)
+                return true;
+#else
+                return false;
+#endif
+            default:
+                UNREACHABLE();
+        }
+    }
+
+    BVHKernel GetPreferredBVHKernel() {
+        return IsBVHKernelSupported(BVHKernel::SSE2) ? BVHKernel::SSE2 : BVHKernel::Scalar;
+    }
+
+    // Intersection routines
+
+    bool IntersectRayBounds(const BVHRayInverse& ray,
+                            const BVHBounds& bounds,
+                            float tMin,
+                            float tMax,
+                            float* tEntry) {
+        for (uint32_t axis = 0; axis < 3; ++axis) {
+            float t0 = (bounds.min[axis] - ray.origin[axis]) * ray.invDirection[axis];
+            float t1 = (bounds.max[axis] - ray.origin[axis]) * ray.invDirection[axis];
+            if (t0 > t1) {
+                std::swap(t0, t1);
+            }
+            // Written so that NaNs (0 * inf on a slab boundary) keep the previous interval.
+            tMin = t0 > tMin ? t0 : tMin;
+            tMax = t1 < tMax ? t1 : tMax;
+            if (tMin > tMax) {
+                return false;
+            }
+        }
+        *tEntry = tMin;
+        return true;
+    }
+
+    bool IntersectRayTriangle(const BVHRay& ray,
+                              const BVHTriangle& triangle,
+                              float tMin,
+                              float tMax,
+                              float* t,
+                              float* u,
+                              float* v) {
+        float p[3];
+        Cross(ray.direction, triangle.e2, p);
+        float determinant = Dot(triangle.e1, p);
+        // Both faces are reported, culling is left to the shaders.
+        if (std::fabs(determinant) < std::numeric_limits<float>::min()) {
+            return false;
+        }
+        float invDeterminant = 1.0f / determinant;
+
+        float s[3] = {ray.origin[0] - triangle.v0[0], ray.origin[1] - triangle.v0[1],
+                      ray.origin[2] - triangle.v0[2]};
+        float hitU = Dot(s, p) * invDeterminant;
+        if (hitU < 0.0f || hitU > 1.0f) {
+            return false;
+        }
+
+        float q[3];
+        Cross(s, triangle.e1, q);
+        float hitV = Dot(ray.direction, q) * invDeterminant;
+        if (hitV < 0.0f || hitU + hitV > 1.0f) {
+            return false;
+        }
+
+        float hitT = Dot(triangle.e2, q) * invDeterminant;
+        if (hitT < tMin || hitT > tMax) {
+            return false;
+        }
+
+        *t = hitT;
+        *u = hitU;
+        *v = hitV;
+        return true;
+    }
+
+    BVHTriangle MakeBVHTriangle(const float v0[3], const float v1[3], const float v2[3]) {
+        BVHTriangle triangle;
+        for (uint32_t axis = 0; axis < 3; ++axis) {
+            triangle.v0[axis] = v0[axis];
+            triangle.e1[axis] = v1[axis] - v0[axis];
+            triangle.e2[axis] = v2[axis] - v0[axis];
+        }
+        return triangle;
+    }
+
+    BVHBounds GetBVHTriangleBounds(const BVHTriangle& triangle) {
+        BVHBounds bounds = BVHBounds::Empty();
+        float v1[3];
+        float v2[3];
+        for (uint32_t axis = 0; axis < 3; ++axis) {
+            v1[axis] = triangle.v0[axis] + triangle.e1[axis];
+            v2[axis] = triangle.v0[axis] + triangle.e2[axis];
+        }
+        bounds.Extend(triangle.v0);
+        bounds.Extend(v1);
+        bounds.Extend(v2);
+        return bounds;
+    }
+
+    // BVH::Node
+
+    BVHBounds BVH::Node::GetChildBounds(uint32_t slot) const {
+        return {{minX[slot], minY[slot], minZ[slot]}, {maxX[slot], maxY[slot], maxZ[slot]}};
+    }
+
+    void BVH::Node::SetChildBounds(uint32_t slot, const BVHBounds& bounds) {
+        minX[slot] = bounds.min[0];
+        minY[slot] = bounds.min[1];
+        minZ[slot] = bounds.min[2];
+        maxX[slot] = bounds.max[0];
+        maxY[slot] = bounds.max[1];
+        maxZ[slot] = bounds.max[2];
+    }
+
+    // BVH::Builder
+
+    struct BVH::Builder {
+        // Binning resolution of the surface area heuristic, per axis.
+        static constexpr uint32_t kBinCount = 16;
+        // Subtrees with at least this many primitives are built in their own task.
+        static constexpr uint32_t kParallelSubtreeThreshold = 4096;
+        // Ranges with at least this many primitives are binned by several tasks.
+        static constexpr uint32_t kParallelBinningThreshold = 64 * 1024;
+        static constexpr uint32_t kBinningChunkSize = 16 * 1024;
+
+        // The primitives are reordered in place during the build so that every range of the
+        // build is contiguous in memory.
+        struct Primitive {
+            BVHBounds bounds;
+            uint32_t index;
+
+            void GetCentroid(float centroid[3]) const {
+                centroid[0] = bounds.Centroid(0);
+                centroid[1] = bounds.Centroid(1);
+                centroid[2] = bounds.Centroid(2);
+            }
+        };
+
+        struct Range {
+            uint32_t begin;
+            uint32_t end;
+            BVHBounds bounds;
+            BVHBounds centroidBounds;
+
+            uint32_t Count() const {
+                return end - begin;
+            }
+        };
+
+        // Maps centroids to the bins of a range. Small ranges use fewer bins since the cost of
+        // evaluating the splits would dominate.
+        struct BinMapping {
+            explicit BinMapping(const Range& range)
+                : binCount(std::min(kBinCount, range.Count())) {
+                for (uint32_t axis = 0; axis < 3; ++axis) {
+                    float extent = range.centroidBounds.max[axis] - range.centroidBounds.min[axis];
+                    offset[axis] = range.centroidBounds.min[axis];
+                    scale[axis] = extent > 0.0f ? binCount / extent : 0.0f;
+                }
+            }
+
+            uint32_t GetBin(uint32_t axis, float centroid) const {
+                uint32_t bin = static_cast<uint32_t>((centroid - offset[axis]) * scale[axis]);
+                return std::min(bin, binCount - 1);
+            }
+
+            uint32_t binCount;
+            float offset[3];
+            float scale[3];
+        };
+
+        struct Bins {
+            BVHBounds bounds[3][kBinCount];
+            uint32_t counts[3][kBinCount];
+
+            void Reset(uint32_t binCount) {
+                for (uint32_t axis = 0; axis < 3; ++axis) {
+                    for (uint32_t i = 0; i < binCount; ++i) {
+                        bounds[axis][i] = BVHBounds::Empty();
+                        counts[axis][i] = 0;
+                    }
+                }
+            }
+
+            void Merge(const Bins& other, uint32_t binCount) {
+                for (uint32_t axis = 0; axis < 3; ++axis) {
+                    for (uint32_t i = 0; i < binCount; ++i) {
+                        bounds[axis][i].Extend(other.bounds[axis][i]);
+                        counts[axis][i] += other.counts[axis][i];
+                    }
+                }
+            }
+        };
+
+        BVH* bvh;
+        ThreadPool* pool;
+        std::vector<Primitive> primitives;
+        std::atomic<uint32_t> nodeCount{0};
+
+        Builder(BVH* bvh, ThreadPool* pool) : bvh(bvh), pool(pool) {
+        }
+
+        void BinPrimitives(const BinMapping& mapping,
+                           uint32_t begin,
+                           uint32_t end,
+                           Bins* bins) const {
+            bins->Reset(mapping.binCount);
+            for (uint32_t i = begin; i < end; ++i) {
+                const Primitive& primitive = primitives[i];
+                float centroid[3];
+                primitive.GetCentroid(centroid);
+                for (uint32_t axis = 0; axis < 3; ++axis) {
+                    uint32_t bin = mapping.GetBin(axis, centroid[axis]);
+                    bins->bounds[axis][bin].Extend(primitive.bounds);
+                    bins->counts[axis][bin]++;
+                }
+            }
+        }
+
+        void BinRange(const Range& range, const BinMapping& mapping, Bins* bins) {
+            uint32_t count = range.Count();
+            if (pool == nullptr || count < kParallelBinningThreshold) {
+                BinPrimitives(mapping, range.begin, range.end, bins);
+                return;
+            }
+
+            uint32_t chunkCount = (count + kBinningChunkSize - 1) / kBinningChunkSize;
+            std::vector<Bins> chunkBins(chunkCount);
+            pool->ParallelFor(count, kBinningChunkSize, [&](uint32_t begin, uint32_t end) {
+                BinPrimitives(mapping, range.begin + begin, range.begin + end,
+                              &chunkBins[begin / kBinningChunkSize]);
+            });
+
+            bins->Reset(mapping.binCount);
+            for (const Bins& chunkBin : chunkBins) {
+                bins->Merge(chunkBin, mapping.binCount);
+            }
+        }
+
+        // Splits |range| in two with the binned surface area heuristic. The primitives of the
+        // range are partitioned in place.
+        void SplitRange(const Range& range, Range* left, Range* right) {
+            ASSERT(range.Count() >= 2);
+
+            bool hasExtent = false;
+            for (uint32_t axis = 0; axis < 3; ++axis) {
+                hasExtent |= range.centroidBounds.max[axis] > range.centroidBounds.min[axis];
+            }
+
+            // All the centroids are at the same position, split in the middle of the range.
+            if (!hasExtent) {
+                uint32_t middle = range.begin + range.Count() / 2;
+                *left = {range.begin, middle, BVHBounds::Empty(), range.centroidBounds};
+                *right = {middle, range.end, BVHBounds::Empty(), range.centroidBounds};
+                for (uint32_t i = left->begin; i < left->end; ++i) {
+                    left->bounds.Extend(primitives[i].bounds);
+                }
+                for (uint32_t i = right->begin; i < right->end; ++i) {
+                    right->bounds.Extend(primitives[i].bounds);
+                }
+                return;
+            }
+
+            BinMapping mapping(range);
+            Bins bins;
+            BinRange(range, mapping, &bins);
+
+            // Sweep the bins from the right to get the cost of every right side, then from the
+            // left to find the cheapest split.
+            float bestCost = std::numeric_limits<float>::infinity();
+            uint32_t bestAxis = 0;
+            uint32_t bestSplit = 0;
+            for (uint32_t axis = 0; axis < 3; ++axis) {
+                if (mapping.scale[axis] == 0.0f) {
+                    continue;
+                }
+
+                float rightCost[kBinCount];
+                BVHBounds rightBounds = BVHBounds::Empty();
+                uint32_t rightCount = 0;
+                for (uint32_t i = mapping.binCount - 1; i > 0; --i) {
+                    rightBounds.Extend(bins.bounds[axis][i]);
+                    rightCount += bins.counts[axis][i];
+                    rightCost[i] = rightBounds.SurfaceArea() * rightCount;
+                }
+
+                BVHBounds leftBounds = BVHBounds::Empty();
+                uint32_t leftCount = 0;
+                for (uint32_t split = 1; split < mapping.binCount; ++split) {
+                    leftBounds.Extend(bins.bounds[axis][split - 1]);
+                    leftCount += bins.counts[axis][split - 1];
+                    if (leftCount == 0 || leftCount == range.Count()) {
+                        continue;
+                    }
+                    float cost = leftBounds.SurfaceArea() * leftCount + rightCost[split];
+                    if (cost < bestCost) {
+                        bestCost = cost;
+                        bestAxis = axis;
+                        bestSplit = split;
+                    }
+                }
+            }
+            // The lowest and highest centroids are in the first and last bins of an axis with an
+            // extent so there is always a split with primitives on both sides.
+            ASSERT(bestSplit != 0);
+
+            // Partition the primitives and gather the centroid bounds of both sides on the way.
+            *left = {range.begin, range.begin, BVHBounds::Empty(), BVHBounds::Empty()};
+            *right = {range.end, range.end, BVHBounds::Empty(), BVHBounds::Empty()};
+            for (uint32_t i = 0; i < mapping.binCount; ++i) {
+                (i < bestSplit ? left : right)->bounds.Extend(bins.bounds[bestAxis][i]);
+            }
+
+            uint32_t i = range.begin;
+            uint32_t j = range.end;
+            float centroid[3];
+            while (true) {
+                while (i < j) {
+                    primitives[i].GetCentroid(centroid);
+                    if (mapping.GetBin(bestAxis, centroid[bestAxis]) >= bestSplit) {
+                        break;
+                    }
+                    left->centroidBounds.Extend(centroid);
+                    i++;
+                }
+                while (i < j) {
+                    primitives[j - 1].GetCentroid(centroid);
+                    if (mapping.GetBin(bestAxis, centroid[bestAxis]) < bestSplit) {
+                        break;
+                    }
+                    right->centroidBounds.Extend(centroid);
+                    j--;
+                }
+                if (i == j) {
+                    break;
+                }
+                std::swap(primitives[i], primitives[j - 1]);
+            }
+            left->end = i;
+            right->begin = i;
+            ASSERT(left->Count() != 0 && right->Count() != 0);
+        }
+
+        void BuildNode(uint32_t nodeIndex, const Range& range, uint32_t depth) {
+            // Split the child with the largest surface area until there are four children or
+            // all of them are small enough to be leaves.
+            Range children[kWidth];
+            uint32_t childCount = 1;
+            children[0] = range;
+            while (childCount < kWidth) {
+                uint32_t largest = kWidth;
+                float largestArea = -1.0f;
+                for (uint32_t i = 0; i < childCount; ++i) {
+                    float area = children[i].bounds.SurfaceArea();
+                    if (children[i].Count() > kMaxLeafSize && area > largestArea) {
+                        largest = i;
+                        largestArea = area;
+                    }
+                }
+                if (largest == kWidth) {
+                    break;
+                }
+
+                Range toSplit = children[largest];
+                SplitRange(toSplit, &children[largest], &children[childCount]);
+                childCount++;
+            }
+
+            ThreadPool::TaskGroup group;
+            Node& node = bvh->mNodes[nodeIndex];
+            for (uint32_t slot = 0; slot < kWidth; ++slot) {
+                if (slot >= childCount) {
+                    node.SetChildBounds(slot, BVHBounds::Empty());
+                    node.child[slot] = 0;
+                    node.primitiveCount[slot] = kEmptySlot;
+                    continue;
+                }
+
+                const Range& child = children[slot];
+                node.SetChildBounds(slot, child.bounds);
+                if (child.Count() <= kMaxLeafSize || depth + 1 >= kMaxDepth) {
+                    node.child[slot] = child.begin;
+                    node.primitiveCount[slot] = child.Count();
+                    continue;
+                }
+
+                uint32_t childIndex = nodeCount.fetch_add(1, std::memory_order_relaxed);
+                node.child[slot] = childIndex;
+                node.primitiveCount[slot] = kInnerSlot;
+
+                if (pool != nullptr && child.Count() >= kParallelSubtreeThreshold) {
+                    pool->Spawn(&group, [this, childIndex, child, depth] {
+                        BuildNode(childIndex, child, depth + 1);
+                    });
+                } else {
+                    BuildNode(childIndex, child, depth + 1);
+                }
+            }
+
+            if (pool != nullptr) {
+                pool->Wait(&group);
+            }
+        }
+    };
+
+    constexpr uint32_t BVH::Builder::kBinCount;
+    constexpr uint32_t BVH::Builder::kParallelSubtreeThreshold;
+    constexpr uint32_t BVH::Builder::kParallelBinningThreshold;
+    constexpr uint32_t BVH::Builder::kBinningChunkSize;
+
+    // BVH
+
+    constexpr uint32_t BVH::kWidth;
+    constexpr uint32_t BVH::kMaxLeafSize;
+    constexpr uint32_t BVH::kMaxDepth;
+    constexpr uint32_t BVH::kEmptySlot;
+    constexpr uint32_t BVH::kInnerSlot;
+
+    BVH::BVH(const BVH& other) {
+        *this = other;
+    }
+
+    BVH& BVH::operator=(const BVH& other) {
+        if (this == &other) {
+            return *this;
+        }
+        AllocateNodes(other.mNodeCount);
+        memcpy(mNodes, other.mNodes, other.mNodeCount * sizeof(Node));
+        mNodeCount = other.mNodeCount;
+        mBounds = other.mBounds;
+        mPrimitiveIndices = other.mPrimitiveIndices;
+        mPrimitiveCount = other.mPrimitiveCount;
+        mParentNodes = other.mParentNodes;
+        mPrimitiveNodes = other.mPrimitiveNodes;
+        return *this;
+    }
+
+    void BVH::AllocateNodes(uint32_t count) {
+        mNodeAllocation.reset();
+        mNodes = nullptr;
+        if (count == 0) {
+            return;
+        }
+        mNodeAllocation.reset(new char[count * sizeof(Node) + alignof(Node) - 1]);
+        mNodes = AlignPtr(reinterpret_cast<Node*>(mNodeAllocation.get()), alignof(Node));
+    }
+
+    void BVH::Build(const std::vector<BVHBounds>& primitiveBounds, ThreadPool* pool) {
+        Clear();
+        mPrimitiveCount = static_cast<uint32_t>(primitiveBounds.size());
+
+        Builder builder(this, pool);
+
+        // Primitives with empty bounds (degenerate or inactive) are left out of the hierarchy.
+        Builder::Range root = {0, 0, BVHBounds::Empty(), BVHBounds::Empty()};
+        builder.primitives.reserve(primitiveBounds.size());
+        for (uint32_t i = 0; i < primitiveBounds.size(); ++i) {
+            const BVHBounds& bounds = primitiveBounds[i];
+            if (bounds.IsEmpty()) {
+                continue;
+            }
+            float centroid[3] = {bounds.Centroid(0), bounds.Centroid(1), bounds.Centroid(2)};
+            root.bounds.Extend(bounds);
+            root.centroidBounds.Extend(centroid);
+            builder.primitives.push_back({bounds, i});
+        }
+        if (builder.primitives.empty()) {
+            return;
+        }
+        root.end = static_cast<uint32_t>(builder.primitives.size());
+
+        // Every node but the root has at least two children so there are at most as many nodes
+        // as primitives.
+        AllocateNodes(root.end);
+
+        builder.nodeCount = 1;
+        builder.BuildNode(0, root, 0);
+
+        mNodeCount = builder.nodeCount.load();
+        mBounds = root.bounds;
+        mPrimitiveIndices.resize(builder.primitives.size());
+        for (uint32_t i = 0; i < builder.primitives.size(); ++i) {
+            mPrimitiveIndices[i] = builder.primitives[i].index;
+        }
+    }
+
+    void BVH::Clear() {
+        mNodeAllocation.reset();
+        mNodes = nullptr;
+        mNodeCount = 0;
+        mBounds = BVHBounds::Empty();
+        mPrimitiveIndices.clear();
+        mPrimitiveCount = 0;
+        mParentNodes.clear();
+        mPrimitiveNodes.clear();
+    }
+
+    void BVH::Refit(const std::vector<BVHBounds>& primitiveBounds) {
+        ASSERT(primitiveBounds.size() == mPrimitiveCount);
+        if (IsEmpty()) {
+            return;
+        }
+
+        // Children have larger indices than their parent so walking the nodes backwards
+        // refits every node after its children.
+        for (uint32_t nodeIndex = mNodeCount; nodeIndex-- > 0;) {
+            RefitNode(nodeIndex, primitiveBounds);
+        }
+        mBounds = GetNodeBounds(0);
+    }
+
+    void BVH::Refit(const std::vector<BVHBounds>& primitiveBounds,
+                    const std::vector<uint32_t>& dirtyPrimitives) {
+        ASSERT(primitiveBounds.size() == mPrimitiveCount);
+        if (IsEmpty() || dirtyPrimitives.empty()) {
+            return;
+        }
+        if (mParentNodes.empty()) {
+            ComputeRefitLinks();
+        }
+
+        // Gather the leaves of the dirty primitives and their ancestors, stopping at the first
+        // ancestor that is already gathered.
+        std::vector<bool> isDirty(mNodeCount, false);
+        std::vector<uint32_t> dirtyNodes;
+        for (uint32_t primitive : dirtyPrimitives) {
+            ASSERT(primitive < mPrimitiveCount);
+            uint32_t nodeIndex = mPrimitiveNodes[primitive];
+            while (nodeIndex != kInnerSlot && !isDirty[nodeIndex]) {
+                isDirty[nodeIndex] = true;
+                dirtyNodes.push_back(nodeIndex);
+                nodeIndex = mParentNodes[nodeIndex];
+            }
+        }
+
+        std::sort(dirtyNodes.begin(), dirtyNodes.end(), std::greater<uint32_t>());
+        for (uint32_t nodeIndex : dirtyNodes) {
+            RefitNode(nodeIndex, primitiveBounds);
+        }
+        mBounds = GetNodeBounds(0);
+    }
+
+    BVHBounds BVH::GetNodeBounds(uint32_t nodeIndex) const {
+        const Node& node = mNodes[nodeIndex];
+        BVHBounds bounds = BVHBounds::Empty();
+        for (uint32_t slot = 0; slot < kWidth; ++slot) {
+            if (node.primitiveCount[slot] != kEmptySlot) {
+                bounds.Extend(node.GetChildBounds(slot));
+            }
+        }
+        return bounds;
+    }
+
+    void BVH::RefitNode(uint32_t nodeIndex, const std::vector<BVHBounds>& primitiveBounds) {
+        Node& node = mNodes[nodeIndex];
+        for (uint32_t slot = 0; slot < kWidth; ++slot) {
+            uint32_t count = node.primitiveCount[slot];
+            if (count == kEmptySlot) {
+                continue;
+            }
+            if (count == kInnerSlot) {
+                node.SetChildBounds(slot, GetNodeBounds(node.child[slot]));
+                continue;
+            }
+
+            // Leaves whose primitives all became empty get empty bounds and don't grow the
+            // bounds of their ancestors.
+            BVHBounds bounds = BVHBounds::Empty();
+            for (uint32_t i = 0; i < count; ++i) {
+                bounds.Extend(primitiveBounds[mPrimitiveIndices[node.child[slot] + i]]);
+            }
+            node.SetChildBounds(slot, bounds);
+        }
+    }
+
+    void BVH::ComputeRefitLinks() {
+        // kInnerSlot marks the parent of the root and the primitives left out of the hierarchy.
+        mParentNodes.assign(mNodeCount, kInnerSlot);
+        mPrimitiveNodes.assign(mPrimitiveCount, kInnerSlot);
+        for (uint32_t nodeIndex = 0; nodeIndex < mNodeCount; ++nodeIndex) {
+            const Node& node = mNodes[nodeIndex];
+            for (uint32_t slot = 0; slot < kWidth; ++slot) {
+                uint32_t count = node.primitiveCount[slot];
+                if (count == kInnerSlot) {
+                    mParentNodes[node.child[slot]] = nodeIndex;
+                } else {
+                    for (uint32_t i = 0; i < count; ++i) {
+                        mPrimitiveNodes[mPrimitiveIndices[node.child[slot] + i]] = nodeIndex;
+                    }
+                }
+            }
+        }
+    }
+
+    bool BVH::IsEmpty() const {
+        return mNodeCount == 0;
+    }
+
+    const BVHBounds& BVH::GetBounds() const {
+        ASSERT(!IsEmpty());
+        return mBounds;
+    }
+
+    const BVH::Node* BVH::GetNodes() const {
+        return mNodes;
+    }
+
+    uint32_t BVH::GetNodeCount() const {
+        return mNodeCount;
+    }
+
+    const std::vector<uint32_t>& BVH::GetPrimitiveIndices() const {
+        return mPrimitiveIndices;
+    }
+
+}}  // namespace dawn_native::null
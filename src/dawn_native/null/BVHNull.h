@@ -0,0 +1,618 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_NULL_BVHNULL_H_
+#define DAWNNATIVE_NULL_BVHNULL_H_
+
+#include "common/Assert.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// The SSE2 kernels are compiled when the target guarantees SSE2, which is every x86-64 target.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define DAWN_NULL_BVH_SSE2 1
+#    include <emmintrin.h>
+#endif
+
+class ThreadPool;
+
+// The BVH used by the CPU implementation of acceleration containers in the Null backend. It is
+// independent of the WebGPU objects so that it can be built and traversed for both bottom-level
+// containers (primitives are triangles and AABBs) and top-level containers (primitives are
+// instances of bottom-level containers).
+namespace dawn_native { namespace null {
+
+    struct BVHBounds {
+        float min[3];
+        float max[3];
+
+        static BVHBounds Empty();
+
+        // Defined inline because they are in the inner loops of the builder.
+        bool IsEmpty() const {
+            return min[0] > max[0] || min[1] > max[1] || min[2] > max[2];
+        }
+
+        void Extend(const float point[3]) {
+            for (uint32_t axis = 0; axis < 3; ++axis) {
+                min[axis] = point[axis] < min[axis] ? point[axis] : min[axis];
+                max[axis] = point[axis] > max[axis] ? point[axis] : max[axis];
+            }
+        }
+
+        void Extend(const BVHBounds& other) {
+            for (uint32_t axis = 0; axis < 3; ++axis) {
+                min[axis] = other.min[axis] < min[axis] ? other.min[axis] : min[axis];
+                max[axis] = other.max[axis] > max[axis] ? other.max[axis] : max[axis];
+            }
+        }
+
+        float Centroid(uint32_t axis) const {
+            return 0.5f * (min[axis] + max[axis]);
+        }
+
+        float SurfaceArea() const {
+            if (IsEmpty()) {
+                return 0.0f;
+            }
+            float dx = max[0] - min[0];
+            float dy = max[1] - min[1];
+            float dz = max[2] - min[2];
+            return 2.0f * (dx * dy + dy * dz + dz * dx);
+        }
+    };
+
+    struct BVHRay {
+        float origin[3];
+        float tMin;
+        float direction[3];
+        float tMax;
+    };
+
+    // Precomputed reciprocal of the ray direction used by the slab tests.
+    struct BVHRayInverse {
+        BVHRayInverse() = default;
+        explicit BVHRayInverse(const BVHRay& ray);
+
+        float origin[3];
+        float invDirection[3];
+    };
+
+    // A triangle in the Moller-Trumbore layout: a vertex and the two edges originating from it.
+    struct BVHTriangle {
+        float v0[3];
+        float e1[3];
+        float e2[3];
+    };
+
+    // Returns true if the ray hits the box in [tMin, tMax] and writes the entry distance to
+    // |tEntry|.
+    bool IntersectRayBounds(const BVHRayInverse& ray,
+                            const BVHBounds& bounds,
+                            float tMin,
+                            float tMax,
+                            float* tEntry);
+
+    // Returns true if the ray hits the triangle in [tMin, tMax] and writes the distance and the
+    // barycentric coordinates of the hit.
+    bool IntersectRayTriangle(const BVHRay& ray,
+                              const BVHTriangle& triangle,
+                              float tMin,
+                              float tMax,
+                              float* t,
+                              float* u,
+                              float* v);
+
+    BVHTriangle MakeBVHTriangle(const float v0[3], const float v1[3], const float v2[3]);
+    BVHBounds GetBVHTriangleBounds(const BVHTriangle& triangle);
+
+    // The implementations of the ray / node tests used by traversal. They all visit the same
+    // nodes, up to rounding on the boundaries of the boxes.
+    enum class BVHKernel {
+        // Tests the children of a node one at a time.
+        Scalar,
+        // Tests a ray against the four children of a node at once, or a packet of four rays
+        // against one child at once.
+        SSE2,
+    };
+
+    bool IsBVHKernelSupported(BVHKernel kernel);
+    // Returns the fastest kernel supported by the CPU.
+    BVHKernel GetPreferredBVHKernel();
+
+    // The number of rays traversed together by BVH::TraversePacket.
+    static constexpr uint32_t kBVHPacketSize = 4;
+
+    // A 4-wide BVH stored in a flat array of cache-line aligned nodes. Each node holds the bounds
+    // of its four children in structure-of-arrays layout so that traversal tests a ray against
+    // all of them at once.
+    //
+    // The hierarchy is built top-down with a binned surface area heuristic. Each node is split up
+    // to three times, always splitting the child with the largest surface area, to produce four
+    // children. When a ThreadPool is given, subtrees with enough primitives are built as separate
+    // tasks and the binning of the largest ranges is itself split across tasks.
+    class BVH {
+      public:
+        static constexpr uint32_t kWidth = 4;
+        static constexpr uint32_t kMaxLeafSize = 4;
+        static constexpr uint32_t kMaxDepth = 48;
+
+        // Values of Node::primitiveCount for the slots that are not leaves.
+        static constexpr uint32_t kEmptySlot = 0;
+        static constexpr uint32_t kInnerSlot = 0xFFFFFFFF;
+
+        struct alignas(64) Node {
+            float minX[kWidth];
+            float minY[kWidth];
+            float minZ[kWidth];
+            float maxX[kWidth];
+            float maxY[kWidth];
+            float maxZ[kWidth];
+            // For inner slots, the index of the child node. For leaves, the index of the first
+            // primitive in the primitive index list.
+            uint32_t child[kWidth];
+            // The number of primitives for leaves, or kEmptySlot / kInnerSlot.
+            uint32_t primitiveCount[kWidth];
+
+            BVHBounds GetChildBounds(uint32_t slot) const;
+            void SetChildBounds(uint32_t slot, const BVHBounds& bounds);
+        };
+        static_assert(sizeof(Node) == 128, "BVH nodes must fill exactly two cache lines");
+
+        BVH() = default;
+        BVH(const BVH& other);
+        BVH& operator=(const BVH& other);
+
+        // Builds the hierarchy over primitives described by their bounds. Empty bounds are
+        // allowed and are never returned by traversal. |pool| may be null in which case the
+        // hierarchy is built on the calling thread.
+        void Build(const std::vector<BVHBounds>& primitiveBounds, ThreadPool* pool = nullptr);
+        void Clear();
+
+        // Recomputes the bounds of the nodes bottom-up from the new bounds of the primitives,
+        // keeping the topology of the hierarchy. |primitiveBounds| must have as many elements as
+        // when the hierarchy was built. Primitives that had empty bounds at build time stay out of
+        // the hierarchy until the next build.
+        void Refit(const std::vector<BVHBounds>& primitiveBounds);
+        // Same as above when only the primitives in |dirtyPrimitives| changed. Only the leaves
+        // referencing them and their ancestors are refit.
+        void Refit(const std::vector<BVHBounds>& primitiveBounds,
+                   const std::vector<uint32_t>& dirtyPrimitives);
+
+        bool IsEmpty() const;
+        const BVHBounds& GetBounds() const;
+        // Nodes are allocated before their children so children always have larger indices than
+        // their parent. The root is node 0.
+        const Node* GetNodes() const;
+        uint32_t GetNodeCount() const;
+        const std::vector<uint32_t>& GetPrimitiveIndices() const;
+
+        // Walks the nodes hit by |ray| front to back and calls |intersect(primitiveIndex, &tMax)|
+        // for every candidate primitive. The callback shrinks |tMax| when it records a closer hit
+        // so that farther subtrees are culled. |kernel| must be supported by the CPU.
+        template <typename IntersectFunc>
+        void Traverse(const BVHRay& ray, BVHKernel kernel, IntersectFunc&& intersect) const;
+
+        // Walks the hierarchy with a packet of kBVHPacketSize rays, of which only the rays in
+        // |activeMask| are traced, and calls |intersect(primitiveIndex, rayMask, tMax)| for every
+        // candidate primitive with the mask of the rays that reach it. |tMax| holds the current
+        // distance of every ray of the packet, the callback shrinks it like for Traverse. Nodes
+        // are visited once for all the rays that hit them, which amortizes the memory accesses
+        // when the rays are coherent, such as neighboring primary rays.
+        template <typename IntersectFunc>
+        void TraversePacket(const BVHRay* rays,
+                            uint32_t activeMask,
+                            BVHKernel kernel,
+                            IntersectFunc&& intersect) const;
+
+      private:
+        struct Builder;
+
+        void AllocateNodes(uint32_t count);
+
+        BVHBounds GetNodeBounds(uint32_t nodeIndex) const;
+        void RefitNode(uint32_t nodeIndex, const std::vector<BVHBounds>& primitiveBounds);
+        // Computes the parent of each node and the leaf node of each primitive, which partial
+        // refits walk up from.
+        void ComputeRefitLinks();
+
+        template <typename NodeTester, typename IntersectFunc>
+        void TraverseWith(const BVHRay& ray,
+                          const NodeTester& tester,
+                          IntersectFunc&& intersect) const;
+        template <typename PacketTester, typename IntersectFunc>
+        void TraversePacketWith(const BVHRay* rays,
+                                uint32_t activeMask,
+                                const PacketTester& tester,
+                                IntersectFunc&& intersect) const;
+
+        std::unique_ptr<char[]> mNodeAllocation;
+        Node* mNodes = nullptr;
+        uint32_t mNodeCount = 0;
+        BVHBounds mBounds = BVHBounds::Empty();
+        std::vector<uint32_t> mPrimitiveIndices;
+        uint32_t mPrimitiveCount = 0;
+
+        // Computed on the first partial refit after a build.
+        std::vector<uint32_t> mParentNodes;
+        std::vector<uint32_t> mPrimitiveNodes;
+    };
+
+    namespace detail {
+
+        // Node testers return the mask of the children of |node| hit by the ray before |tMax|
+        // and write their entry distance to |tEntry|.
+        class ScalarNodeTester {
+          public:
+            explicit ScalarNodeTester(const BVHRay& ray) : mRay(ray), mTMin(ray.tMin) {
+            }
+
+            uint32_t Test(const BVH::Node& node, float tMax, float tEntry[BVH::kWidth]) const {
+                uint32_t mask = 0;
+                for (uint32_t slot = 0; slot < BVH::kWidth; ++slot) {
+                    if (node.primitiveCount[slot] != BVH::kEmptySlot &&
+                        IntersectRayBounds(mRay, node.GetChildBounds(slot), mTMin, tMax,
+                                           &tEntry[slot])) {
+                        mask |= 1u << slot;
+                    }
+                }
+                return mask;
+            }
+
+          private:
+            BVHRayInverse mRay;
+            float mTMin;
+        };
+
+        // Packet testers return the mask of the rays of |rayMask| that hit the child in |slot|
+        // and write the smallest entry distance of these rays to |tEntry|.
+        class ScalarPacketTester {
+          public:
+            explicit ScalarPacketTester(const BVHRay* rays) {
+                for (uint32_t i = 0; i < kBVHPacketSize; ++i) {
+                    mRays[i] = BVHRayInverse(rays[i]);
+                    mTMin[i] = rays[i].tMin;
+                }
+            }
+
+            uint32_t Test(const BVH::Node& node,
+                          uint32_t slot,
+                          const float tMax[kBVHPacketSize],
+                          uint32_t rayMask,
+                          float* tEntry) const {
+                BVHBounds bounds = node.GetChildBounds(slot);
+                uint32_t mask = 0;
+                for (uint32_t i = 0; i < kBVHPacketSize; ++i) {
+                    float tRay;
+                    if ((rayMask & (1u << i)) != 0 &&
+                        IntersectRayBounds(mRays[i], bounds, mTMin[i], tMax[i], &tRay)) {
+                        *tEntry = mask == 0 || tRay < *tEntry ? tRay : *tEntry;
+                        mask |= 1u << i;
+                    }
+                }
+                return mask;
+            }
+
+          private:
+            BVHRayInverse mRays[kBVHPacketSize];
+            float mTMin[kBVHPacketSize];
+        };
+
+#if defined(DAWN_NULL_BVH_SSE2)
+        // Zero direction components are replaced by a tiny value of the same sign so that the
+        // reciprocals stay finite and the slab tests never compute 0 * inf, which would give a
+        // NaN that the SSE min / max don't propagate consistently.
+        inline float SafeReciprocal(float direction) {
+            constexpr float kEpsilon = 1e-18f;
+            if (std::fabs(direction) < kEpsilon) {
+                direction = std::copysign(kEpsilon, direction);
+            }
+            return 1.0f / direction;
+        }
+
+        class SSE2NodeTester {
+          public:
+            explicit SSE2NodeTester(const BVHRay& ray) : mTMin(_mm_set1_ps(ray.tMin)) {
+                for (uint32_t axis = 0; axis < 3; ++axis) {
+                    float invDirection = SafeReciprocal(ray.direction[axis]);
+                    mOrigin[axis] = _mm_set1_ps(ray.origin[axis]);
+                    mInvDirection[axis] = _mm_set1_ps(invDirection);
+                    mNegative[axis] = invDirection < 0.0f;
+                }
+            }
+
+            uint32_t Test(const BVH::Node& node, float tMax, float tEntry[BVH::kWidth]) const {
+                // The slab planes are picked based on the direction of the ray so that the near
+                // and far distances don't need to be sorted.
+                __m128 nearX = Slab(mNegative[0] ? node.maxX : node.minX, 0);
+                __m128 farX = Slab(mNegative[0] ? node.minX : node.maxX, 0);
+                __m128 nearY = Slab(mNegative[1] ? node.maxY : node.minY, 1);
+                __m128 farY = Slab(mNegative[1] ? node.minY : node.maxY, 1);
+                __m128 nearZ = Slab(mNegative[2] ? node.maxZ : node.minZ, 2);
+                __m128 farZ = Slab(mNegative[2] ? node.minZ : node.maxZ, 2);
+
+                __m128 tNear = _mm_max_ps(_mm_max_ps(nearX, nearY), _mm_max_ps(nearZ, mTMin));
+                __m128 tFar =
+                    _mm_min_ps(_mm_min_ps(farX, farY), _mm_min_ps(farZ, _mm_set1_ps(tMax)));
+                _mm_storeu_ps(tEntry, tNear);
+
+                __m128i counts =
+                    _mm_load_si128(reinterpret_cast<const __m128i*>(node.primitiveCount));
+                int emptyMask =
+                    _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(counts, _mm_setzero_si128())));
+                int hitMask = _mm_movemask_ps(_mm_cmple_ps(tNear, tFar));
+                return static_cast<uint32_t>(hitMask & ~emptyMask);
+            }
+
+          private:
+            __m128 Slab(const float* planes, uint32_t axis) const {
+                return _mm_mul_ps(_mm_sub_ps(_mm_load_ps(planes), mOrigin[axis]),
+                                  mInvDirection[axis]);
+            }
+
+            __m128 mOrigin[3];
+            __m128 mInvDirection[3];
+            __m128 mTMin;
+            bool mNegative[3];
+        };
+
+        // Holds the packet in structure-of-arrays layout with one ray per lane.
+        class SSE2PacketTester {
+          public:
+            explicit SSE2PacketTester(const BVHRay* rays) {
+                float origin[3][kBVHPacketSize];
+                float invDirection[3][kBVHPacketSize];
+                float tMin[kBVHPacketSize];
+                for (uint32_t i = 0; i < kBVHPacketSize; ++i) {
+                    for (uint32_t axis = 0; axis < 3; ++axis) {
+                        origin[axis][i] = rays[i].origin[axis];
+                        invDirection[axis][i] = SafeReciprocal(rays[i].direction[axis]);
+                    }
+                    tMin[i] = rays[i].tMin;
+                }
+                for (uint32_t axis = 0; axis < 3; ++axis) {
+                    mOrigin[axis] = _mm_loadu_ps(origin[axis]);
+                    mInvDirection[axis] = _mm_loadu_ps(invDirection[axis]);
+                }
+                mTMin = _mm_loadu_ps(tMin);
+
+                for (uint32_t mask = 0; mask < (1u << kBVHPacketSize); ++mask) {
+                    mLaneMasks[mask] = _mm_castsi128_ps(
+                        _mm_set_epi32(-int32_t((mask >> 3) & 1), -int32_t((mask >> 2) & 1),
+                                      -int32_t((mask >> 1) & 1), -int32_t(mask & 1)));
+                }
+            }
+
+            uint32_t Test(const BVH::Node& node,
+                          uint32_t slot,
+                          const float tMax[kBVHPacketSize],
+                          uint32_t rayMask,
+                          float* tEntry) const {
+                __m128 tNear = mTMin;
+                __m128 tFar = _mm_loadu_ps(tMax);
+                const float* mins[3] = {node.minX, node.minY, node.minZ};
+                const float* maxs[3] = {node.maxX, node.maxY, node.maxZ};
+                for (uint32_t axis = 0; axis < 3; ++axis) {
+                    __m128 t0 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(mins[axis][slot]), mOrigin[axis]),
+                                           mInvDirection[axis]);
+                    __m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(maxs[axis][slot]), mOrigin[axis]),
+                                           mInvDirection[axis]);
+                    tNear = _mm_max_ps(tNear, _mm_min_ps(t0, t1));
+                    tFar = _mm_min_ps(tFar, _mm_max_ps(t0, t1));
+                }
+
+                __m128 hits = _mm_and_ps(_mm_cmple_ps(tNear, tFar), mLaneMasks[rayMask]);
+                uint32_t mask = static_cast<uint32_t>(_mm_movemask_ps(hits));
+                if (mask != 0) {
+                    // Horizontal minimum of the entry distances of the rays that hit.
+                    __m128 t = _mm_or_ps(_mm_and_ps(hits, tNear),
+                                         _mm_andnot_ps(hits, _mm_set1_ps(HUGE_VALF)));
+                    t = _mm_min_ps(t, _mm_shuffle_ps(t, t, _MM_SHUFFLE(2, 3, 0, 1)));
+                    t = _mm_min_ps(t, _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 0, 3, 2)));
+                    *tEntry = _mm_cvtss_f32(t);
+                }
+                return mask;
+            }
+
+          private:
+            __m128 mOrigin[3];
+            __m128 mInvDirection[3];
+            __m128 mTMin;
+            // The lanes of every ray mask, expanded to SSE masks.
+            __m128 mLaneMasks[1u << kBVHPacketSize];
+        };
+#endif  // defined(DAWN_NULL_BVH_SSE2)
+
+    }  // namespace detail
+
+    template <typename IntersectFunc>
+    void BVH::Traverse(const BVHRay& ray, BVHKernel kernel, IntersectFunc&& intersect) const {
+        ASSERT(IsBVHKernelSupported(kernel));
+#if defined(DAWN_NULL_BVH_SSE2)
+        if (kernel == BVHKernel::SSE2) {
+            TraverseWith(ray, detail::SSE2NodeTester(ray), intersect);
+            return;
+        }
+#endif
+        TraverseWith(ray, detail::ScalarNodeTester(ray), intersect);
+    }
+
+    template <typename IntersectFunc>
+    void BVH::TraversePacket(const BVHRay* rays,
+                             uint32_t activeMask,
+                             BVHKernel kernel,
+                             IntersectFunc&& intersect) const {
+        ASSERT(IsBVHKernelSupported(kernel));
+#if defined(DAWN_NULL_BVH_SSE2)
+        if (kernel == BVHKernel::SSE2) {
+            TraversePacketWith(rays, activeMask, detail::SSE2PacketTester(rays), intersect);
+            return;
+        }
+#endif
+        TraversePacketWith(rays, activeMask, detail::ScalarPacketTester(rays), intersect);
+    }
+
+    template <typename NodeTester, typename IntersectFunc>
+    void BVH::TraverseWith(const BVHRay& ray,
+                           const NodeTester& tester,
+                           IntersectFunc&& intersect) const {
+        if (mNodeCount == 0) {
+            return;
+        }
+
+        float tMax = ray.tMax;
+        float tEntry;
+        if (!IntersectRayBounds(BVHRayInverse(ray), mBounds, ray.tMin, tMax, &tEntry)) {
+            return;
+        }
+
+        // Leaves are pushed on the stack like nodes so that all the children are visited in
+        // order of distance.
+        struct StackEntry {
+            uint32_t child;
+            uint32_t primitiveCount;
+            float tEntry;
+        };
+        StackEntry stack[(kWidth - 1) * kMaxDepth + 1];
+        uint32_t stackSize = 0;
+        stack[stackSize++] = {0, kInnerSlot, tEntry};
+
+        while (stackSize > 0) {
+            StackEntry entry = stack[--stackSize];
+            if (entry.tEntry > tMax) {
+                continue;
+            }
+
+            if (entry.primitiveCount != kInnerSlot) {
+                for (uint32_t i = 0; i < entry.primitiveCount; ++i) {
+                    intersect(mPrimitiveIndices[entry.child + i], &tMax);
+                }
+                continue;
+            }
+
+            const Node& node = mNodes[entry.child];
+            float tChildren[kWidth];
+            uint32_t hitMask = tester.Test(node, tMax, tChildren);
+
+            StackEntry hits[kWidth];
+            uint32_t hitCount = 0;
+            for (uint32_t slot = 0; slot < kWidth; ++slot) {
+                if ((hitMask & (1u << slot)) == 0) {
+                    continue;
+                }
+                // Insertion sort from the farthest to the closest hit.
+                uint32_t i = hitCount++;
+                for (; i > 0 && hits[i - 1].tEntry < tChildren[slot]; --i) {
+                    hits[i] = hits[i - 1];
+                }
+                hits[i] = {node.child[slot], node.primitiveCount[slot], tChildren[slot]};
+            }
+
+            // Push the farther children first so that the closest one is visited first.
+            for (uint32_t i = 0; i < hitCount; ++i) {
+                stack[stackSize++] = hits[i];
+            }
+        }
+    }
+
+    template <typename PacketTester, typename IntersectFunc>
+    void BVH::TraversePacketWith(const BVHRay* rays,
+                                 uint32_t activeMask,
+                                 const PacketTester& tester,
+                                 IntersectFunc&& intersect) const {
+        if (mNodeCount == 0) {
+            return;
+        }
+
+        float tMax[kBVHPacketSize];
+        uint32_t rayMask = 0;
+        float tEntry = 0.0f;
+        for (uint32_t i = 0; i < kBVHPacketSize; ++i) {
+            tMax[i] = rays[i].tMax;
+            float tRay;
+            if ((activeMask & (1u << i)) != 0 &&
+                IntersectRayBounds(BVHRayInverse(rays[i]), mBounds, rays[i].tMin, tMax[i],
+                                   &tRay)) {
+                tEntry = rayMask == 0 || tRay < tEntry ? tRay : tEntry;
+                rayMask |= 1u << i;
+            }
+        }
+        if (rayMask == 0) {
+            return;
+        }
+
+        // Same as the single ray traversal, except that entries also record which rays of the
+        // packet hit them. Children are ordered by the closest entry of these rays.
+        struct StackEntry {
+            uint32_t child;
+            uint32_t primitiveCount;
+            uint32_t rayMask;
+            float tEntry;
+        };
+        StackEntry stack[(kWidth - 1) * kMaxDepth + 1];
+        uint32_t stackSize = 0;
+        stack[stackSize++] = {0, kInnerSlot, rayMask, tEntry};
+
+        while (stackSize > 0) {
+            StackEntry entry = stack[--stackSize];
+
+            // Drop the rays that found a hit closer than the entry of the node.
+            for (uint32_t i = 0; i < kBVHPacketSize; ++i) {
+                if (entry.tEntry > tMax[i]) {
+                    entry.rayMask &= ~(1u << i);
+                }
+            }
+            if (entry.rayMask == 0) {
+                continue;
+            }
+
+            if (entry.primitiveCount != kInnerSlot) {
+                for (uint32_t i = 0; i < entry.primitiveCount; ++i) {
+                    intersect(mPrimitiveIndices[entry.child + i], entry.rayMask, tMax);
+                }
+                continue;
+            }
+
+            const Node& node = mNodes[entry.child];
+            StackEntry hits[kWidth];
+            uint32_t hitCount = 0;
+            for (uint32_t slot = 0; slot < kWidth; ++slot) {
+                if (node.primitiveCount[slot] == kEmptySlot) {
+                    continue;
+                }
+                float tChild;
+                uint32_t childRayMask = tester.Test(node, slot, tMax, entry.rayMask, &tChild);
+                if (childRayMask == 0) {
+                    continue;
+                }
+                uint32_t i = hitCount++;
+                for (; i > 0 && hits[i - 1].tEntry < tChild; --i) {
+                    hits[i] = hits[i - 1];
+                }
+                hits[i] = {node.child[slot], node.primitiveCount[slot], childRayMask, tChild};
+            }
+
+            for (uint32_t i = 0; i < hitCount; ++i) {
+                stack[stackSize++] = hits[i];
+            }
+        }
+    }
+
+}}  // namespace dawn_native::null
+
+#endif  // DAWNNATIVE_NULL_BVHNULL_H_
@@ -19,9 +19,12 @@
 #include "dawn_native/ErrorData.h"
 #include "dawn_native/Instance.h"
 #include "dawn_native/Surface.h"
+#include "dawn_native/null/RayTracingAccelerationContainerNull.h"
 
 #include <spirv_cross.hpp>
 
+#include <algorithm>
+
 namespace dawn_native { namespace null {
 
     // Implementation of pre-Device objects: the null adapter, null backend connection and Connect()
@@ -116,6 +119,19 @@ namespace dawn_native { namespace null {
         const PipelineLayoutDescriptor* descriptor) {
         return new PipelineLayout(this, descriptor);
     }
+    ResultOrError<RayTracingAccelerationContainerBase*>
+    Device::CreateRayTracingAccelerationContainerImpl(
+        const RayTracingAccelerationContainerDescriptor* descriptor) {
+        return new RayTracingAccelerationContainer(this, descriptor);
+    }
+    ResultOrError<RayTracingShaderBindingTableBase*> Device::CreateRayTracingShaderBindingTableImpl(
+        const RayTracingShaderBindingTableDescriptor* descriptor) {
+        return new RayTracingShaderBindingTable(this, descriptor);
+    }
+    ResultOrError<RayTracingPipelineBase*> Device::CreateRayTracingPipelineImpl(
+        const RayTracingPipelineDescriptor* descriptor) {
+        return new RayTracingPipeline(this, descriptor);
+    }
     ResultOrError<RenderPipelineBase*> Device::CreateRenderPipelineImpl(
         const RenderPipelineDescriptor* descriptor) {
         return new RenderPipeline(this, descriptor);
@@ -221,11 +237,36 @@ namespace dawn_native { namespace null {
         mMemoryUsage -= bytes;
     }
 
+    void Device::FillStatisticsImpl(DeviceStatistics* statistics) const {
+        statistics->allocatedMemorySize = mMemoryUsage;
+    }
+
+    ThreadPool* Device::GetBuildThreadPool() {
+        if (mBuildThreadPool == nullptr) {
+            uint32_t threadCount = mBuildThreadCount;
+            if (threadCount == 0) {
+                threadCount = std::max(1u, std::thread::hardware_concurrency());
+            }
+            mBuildThreadPool = std::make_unique<ThreadPool>(threadCount - 1);
+        }
+        return mBuildThreadPool.get();
+    }
+
+    void Device::SetBuildThreadCount(uint32_t threadCount) {
+        mBuildThreadCount = threadCount;
+        mBuildThreadPool = nullptr;
+    }
+
     MaybeError Device::TickImpl() {
         SubmitPendingOperations();
         return {};
     }
 
+    bool Device::CanCreatePipelinesOnWorkerThreads() const {
+        // Null pipelines only hold references to the objects of their descriptor.
+        return true;
+    }
+
     Serial Device::CheckAndUpdateCompletedSerials() {
         return GetLastSubmittedCommandSerial();
     }
@@ -304,6 +345,10 @@ namespace dawn_native { namespace null {
         memcpy(mBackingData.get() + destinationOffset, ptr + sourceOffset, size);
     }
 
+    const uint8_t* Buffer::GetBackingData() const {
+        return mBackingData.get();
+    }
+
     MaybeError Buffer::SetSubDataImpl(uint32_t start, uint32_t count, const void* data) {
         ASSERT(start + count <= GetSize());
         ASSERT(mBackingData);
@@ -353,6 +398,83 @@ namespace dawn_native { namespace null {
         FreeCommands(&mCommands);
     }
 
+    void CommandBuffer::Execute() {
+        Command type;
+        while (mCommands.NextCommandId(&type)) {
+            switch (type) {
+                case Command::BuildRayTracingAccelerationContainer: {
+                    BuildRayTracingAccelerationContainerCmd* build =
+                        mCommands.NextCommand<BuildRayTracingAccelerationContainerCmd>();
+                    RayTracingAccelerationContainer* container = ToBackend(build->container.Get());
+                    container->BuildHierarchy();
+                    container->SetBuildState(true);
+                    container->IncrementBuildCount();
+                    break;
+                }
+
+                case Command::BuildRayTracingAccelerationContainers: {
+                    BuildRayTracingAccelerationContainersCmd* build =
+                        mCommands.NextCommand<BuildRayTracingAccelerationContainersCmd>();
+                    Ref<RayTracingAccelerationContainerBase>* containers =
+                        mCommands.NextData<Ref<RayTracingAccelerationContainerBase>>(build->count);
+                    for (uint32_t i = 0; i < build->count; ++i) {
+                        RayTracingAccelerationContainer* container =
+                            ToBackend(containers[i].Get());
+                        container->BuildHierarchy();
+                        container->SetBuildState(true);
+                        container->IncrementBuildCount();
+                    }
+                    break;
+                }
+
+                case Command::UpdateRayTracingAccelerationContainer: {
+                    UpdateRayTracingAccelerationContainerCmd* update =
+                        mCommands.NextCommand<UpdateRayTracingAccelerationContainerCmd>();
+                    RayTracingAccelerationContainer* container =
+                        ToBackend(update->container.Get());
+                    RayTracingAccelerationContainerDirtyRange* dirtyRanges = nullptr;
+                    if (update->dirtyRangeCount > 0) {
+                        dirtyRanges = mCommands.NextData<RayTracingAccelerationContainerDirtyRange>(
+                            update->dirtyRangeCount);
+                    }
+                    container->RefitHierarchy(dirtyRanges, update->dirtyRangeCount);
+                    container->SetUpdateState(true);
+                    container->IncrementRefitCount();
+                    break;
+                }
+
+                case Command::CopyRayTracingAccelerationContainer: {
+                    CopyRayTracingAccelerationContainerCmd* copy =
+                        mCommands.NextCommand<CopyRayTracingAccelerationContainerCmd>();
+                    RayTracingAccelerationContainer* dstContainer =
+                        ToBackend(copy->dstContainer.Get());
+                    // Compacting only differs from cloning by the memory the GPU backends
+                    // allocate for the destination.
+                    dstContainer->CopyHierarchyFrom(ToBackend(copy->srcContainer.Get()));
+                    if (copy->mode == wgpu::RayTracingAccelerationContainerCopyMode::Compact) {
+                        dstContainer->SetBuildState(true);
+                    }
+                    break;
+                }
+
+                // Shaders can't run on the CPU so ray tracing passes and every other command are
+                // only validated. Traversal is exposed with dawn_native::null::TraceRays instead.
+                default:
+                    SkipCommand(&mCommands, type);
+                    break;
+            }
+        }
+    }
+
+    // RayTracingShaderBindingTable
+
+    RayTracingShaderBindingTable::~RayTracingShaderBindingTable() {
+        DestroyInternal();
+    }
+
+    void RayTracingShaderBindingTable::DestroyImpl() {
+    }
+
     // Queue
 
     Queue::Queue(Device* device) : QueueBase(device) {
@@ -361,8 +483,11 @@ namespace dawn_native { namespace null {
     Queue::~Queue() {
     }
 
-    MaybeError Queue::SubmitImpl(uint32_t, CommandBufferBase* const*) {
+    MaybeError Queue::SubmitImpl(uint32_t commandCount, CommandBufferBase* const* commands) {
         ToBackend(GetDevice())->SubmitPendingOperations();
+        for (uint32_t i = 0; i < commandCount; ++i) {
+            ToBackend(commands[i])->Execute();
+        }
         return {};
     }
 
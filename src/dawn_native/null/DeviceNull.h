@@ -15,6 +15,7 @@
 #ifndef DAWNNATIVE_NULL_DEVICENULL_H_
 #define DAWNNATIVE_NULL_DEVICENULL_H_
 
+#include "common/ThreadPool.h"
 #include "dawn_native/Adapter.h"
 #include "dawn_native/BindGroup.h"
 #include "dawn_native/BindGroupLayout.h"
@@ -50,9 +51,9 @@ namespace dawn_native { namespace null {
     class Device;
     using PipelineLayout = PipelineLayoutBase;
     class Queue;
-    using RayTracingAccelerationContainer = RayTracingAccelerationContainerBase;
+    class RayTracingAccelerationContainer;
     using RayTracingPipeline = RayTracingPipelineBase;
-    using RayTracingShaderBindingTable = RayTracingShaderBindingTableBase;
+    class RayTracingShaderBindingTable;
     using RenderPipeline = RenderPipelineBase;
     using Sampler = SamplerBase;
     using ShaderModule = ShaderModuleBase;
@@ -70,7 +71,9 @@ namespace dawn_native { namespace null {
         using DeviceType = Device;
         using PipelineLayoutType = PipelineLayout;
         using QueueType = Queue;
+        using RayTracingAccelerationContainerType = RayTracingAccelerationContainer;
         using RayTracingPipelineType = RayTracingPipeline;
+        using RayTracingShaderBindingTableType = RayTracingShaderBindingTable;
         using RenderPipelineType = RenderPipeline;
         using SamplerType = Sampler;
         using ShaderModuleType = ShaderModule;
@@ -100,6 +103,7 @@ namespace dawn_native { namespace null {
                                                const CommandBufferDescriptor* descriptor) override;
 
         MaybeError TickImpl() override;
+        bool CanCreatePipelinesOnWorkerThreads() const override;
 
         void AddPendingOperation(std::unique_ptr<PendingOperation> operation);
         void SubmitPendingOperations();
@@ -114,22 +118,21 @@ namespace dawn_native { namespace null {
         MaybeError IncrementMemoryUsage(size_t bytes);
         void DecrementMemoryUsage(size_t bytes);
 
+        // Pool used to build acceleration containers. |threadCount| includes the thread that
+        // submits the commands, zero means using all the hardware threads.
+        ThreadPool* GetBuildThreadPool();
+        void SetBuildThreadCount(uint32_t threadCount);
+
       private:
         using DeviceBase::DeviceBase;
 
         ResultOrError<RayTracingAccelerationContainerBase*>
         CreateRayTracingAccelerationContainerImpl(
-            const RayTracingAccelerationContainerDescriptor* descriptor) override {
-            UNREACHABLE();
-        }
+            const RayTracingAccelerationContainerDescriptor* descriptor) override;
         ResultOrError<RayTracingShaderBindingTableBase*> CreateRayTracingShaderBindingTableImpl(
-            const RayTracingShaderBindingTableDescriptor* descriptor) override {
-            UNREACHABLE();
-        }
+            const RayTracingShaderBindingTableDescriptor* descriptor) override;
         ResultOrError<RayTracingPipelineBase*> CreateRayTracingPipelineImpl(
-            const RayTracingPipelineDescriptor* descriptor) override {
-            UNREACHABLE();
-        }
+            const RayTracingPipelineDescriptor* descriptor) override;
         ResultOrError<BindGroupBase*> CreateBindGroupImpl(
             const BindGroupDescriptor* descriptor) override;
         ResultOrError<BindGroupLayoutBase*> CreateBindGroupLayoutImpl(
@@ -160,11 +163,15 @@ namespace dawn_native { namespace null {
 
         void ShutDownImpl() override;
         MaybeError WaitForIdleForDestruction() override;
+        void FillStatisticsImpl(DeviceStatistics* statistics) const override;
 
         std::vector<std::unique_ptr<PendingOperation>> mPendingOperations;
 
         static constexpr size_t kMaxMemoryUsage = 256 * 1024 * 1024;
         size_t mMemoryUsage = 0;
+
+        uint32_t mBuildThreadCount = 0;
+        std::unique_ptr<ThreadPool> mBuildThreadPool;
     };
 
     class Adapter : public AdapterBase {
@@ -208,6 +215,9 @@ namespace dawn_native { namespace null {
                              uint64_t destinationOffset,
                              uint64_t size);
 
+        // Used by the CPU implementation of acceleration containers to read geometry data.
+        const uint8_t* GetBackingData() const;
+
       private:
         ~Buffer() override;
 
@@ -230,6 +240,8 @@ namespace dawn_native { namespace null {
       public:
         CommandBuffer(CommandEncoder* encoder, const CommandBufferDescriptor* descriptor);
 
+        void Execute();
+
       private:
         ~CommandBuffer() override;
 
@@ -245,6 +257,18 @@ namespace dawn_native { namespace null {
         MaybeError SubmitImpl(uint32_t commandCount, CommandBufferBase* const* commands) override;
     };
 
+    // Shader binding tables only hold references to the pipeline stages, there is nothing to
+    // allocate on the CPU.
+    class RayTracingShaderBindingTable final : public RayTracingShaderBindingTableBase {
+      public:
+        using RayTracingShaderBindingTableBase::RayTracingShaderBindingTableBase;
+
+      private:
+        ~RayTracingShaderBindingTable() override;
+
+        void DestroyImpl() override;
+    };
+
     class SwapChain final : public NewSwapChainBase {
       public:
         SwapChain(Device* device,
@@ -19,6 +19,9 @@
 
 #include "common/SwapChainUtils.h"
 #include "dawn_native/null/DeviceNull.h"
+#include "dawn_native/null/RayTracingAccelerationContainerNull.h"
+
+#include <cstring>
 
 namespace dawn_native { namespace null {
 
@@ -29,4 +32,83 @@ namespace dawn_native { namespace null {
         return impl;
     }
 
+    void SetAccelerationContainerBuildThreadCount(WGPUDevice cDevice, uint32_t threadCount) {
+        Device* device = reinterpret_cast<Device*>(cDevice);
+        device->SetBuildThreadCount(threadCount);
+    }
+
+    namespace {
+
+        BVHRay ToBVHRay(const Ray& ray) {
+            BVHRay bvhRay;
+            memcpy(bvhRay.origin, ray.origin, sizeof(bvhRay.origin));
+            memcpy(bvhRay.direction, ray.direction, sizeof(bvhRay.direction));
+            bvhRay.tMin = ray.tMin;
+            bvhRay.tMax = ray.tMax;
+            return bvhRay;
+        }
+
+        RayHit ToRayHit(bool hasHit, const RayHitInfo& info) {
+            RayHit hit = {};
+            hit.hit = hasHit;
+            if (hasHit) {
+                hit.t = info.t;
+                hit.u = info.u;
+                hit.v = info.v;
+                hit.primitiveIndex = info.primitiveIndex;
+                hit.geometryIndex = info.geometryIndex;
+                hit.instanceIndex = info.instanceIndex;
+                hit.instanceId = info.instanceId;
+            }
+            return hit;
+        }
+
+    }  // anonymous namespace
+
+    void TraceRays(WGPURayTracingAccelerationContainer cContainer,
+                   const Ray* rays,
+                   RayHit* hits,
+                   uint32_t rayCount,
+                   const TraceRaysOptions* options) {
+        const RayTracingAccelerationContainer* container =
+            reinterpret_cast<RayTracingAccelerationContainer*>(cContainer);
+
+        TraceRaysOptions defaultOptions;
+        if (options == nullptr) {
+            options = &defaultOptions;
+        }
+        BVHKernel kernel = options->useSIMD ? GetPreferredBVHKernel() : BVHKernel::Scalar;
+
+        if (!options->usePackets) {
+            for (uint32_t i = 0; i < rayCount; ++i) {
+                RayHitInfo info = {};
+                bool hasHit = container->TraceRay(ToBVHRay(rays[i]), rays[i].cullMask, kernel,
+                                                  &info);
+                hits[i] = ToRayHit(hasHit, info);
+            }
+            return;
+        }
+
+        for (uint32_t first = 0; first < rayCount; first += kBVHPacketSize) {
+            // The last packet is padded with copies of its first ray which are left inactive.
+            BVHRay packet[kBVHPacketSize];
+            uint32_t cullMasks[kBVHPacketSize];
+            uint32_t activeMask = 0;
+            for (uint32_t i = 0; i < kBVHPacketSize; ++i) {
+                uint32_t rayIndex = first + i < rayCount ? first + i : first;
+                packet[i] = ToBVHRay(rays[rayIndex]);
+                cullMasks[i] = rays[rayIndex].cullMask;
+                if (first + i < rayCount) {
+                    activeMask |= 1u << i;
+                }
+            }
+
+            RayHitInfo infos[kBVHPacketSize] = {};
+            uint32_t hitMask = container->TracePacket(packet, cullMasks, activeMask, kernel, infos);
+            for (uint32_t i = 0; first + i < rayCount && i < kBVHPacketSize; ++i) {
+                hits[first + i] = ToRayHit((hitMask & (1u << i)) != 0, infos[i]);
+            }
+        }
+    }
+
 }}  // namespace dawn_native::null
@@ -0,0 +1,720 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/null/RayTracingAccelerationContainerNull.h"
+
+#include "common/Math.h"
+#include "common/ThreadPool.h"
+#include "dawn_native/null/DeviceNull.h"
+#include "dawn_platform/DawnPlatform.h"
+#include "dawn_platform/tracing/TraceEvent.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace dawn_native { namespace null {
+
+    namespace {
+
+        // Number of primitives read from the geometry buffers by each task of a build.
+        constexpr uint32_t kGatherChunkSize = 16 * 1024;
+
+        constexpr float kIdentityTransform[12] = {1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f,
+                                                  0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f};
+
+        void TransformPoint(const float m[12], const float p[3], float out[3]) {
+            for (uint32_t row = 0; row < 3; ++row) {
+                out[row] = m[4 * row + 0] * p[0] + m[4 * row + 1] * p[1] +
+                           m[4 * row + 2] * p[2] + m[4 * row + 3];
+            }
+        }
+
+        void TransformDirection(const float m[12], const float d[3], float out[3]) {
+            for (uint32_t row = 0; row < 3; ++row) {
+                out[row] = m[4 * row + 0] * d[0] + m[4 * row + 1] * d[1] + m[4 * row + 2] * d[2];
+            }
+        }
+
+        // Inverts an affine row-major 3x4 matrix, returns false if it is singular.
+        bool InvertAffineTransform(const float m[12], float out[12]) {
+            float a = m[0], b = m[1], c = m[2];
+            float d = m[4], e = m[5], f = m[6];
+            float g = m[8], h = m[9], i = m[10];
+
+            float cofactor0 = e * i - f * h;
+            float cofactor1 = f * g - d * i;
+            float cofactor2 = d * h - e * g;
+            float determinant = a * cofactor0 + b * cofactor1 + c * cofactor2;
+            if (std::fabs(determinant) < std::numeric_limits<float>::min()) {
+                return false;
+            }
+            float invDeterminant = 1.0f / determinant;
+
+            out[0] = cofactor0 * invDeterminant;
+            out[1] = (c * h - b * i) * invDeterminant;
+            out[2] = (b * f - c * e) * invDeterminant;
+            out[4] = cofactor1 * invDeterminant;
+            out[5] = (a * i - c * g) * invDeterminant;
+            out[6] = (c * d - a * f) * invDeterminant;
+            out[8] = cofactor2 * invDeterminant;
+            out[9] = (b * g - a * h) * invDeterminant;
+            out[10] = (a * e - b * d) * invDeterminant;
+
+            float translation[3] = {m[3], m[7], m[11]};
+            float inverseTranslation[3];
+            TransformDirection(out, translation, inverseTranslation);
+            out[3] = -inverseTranslation[0];
+            out[7] = -inverseTranslation[1];
+            out[11] = -inverseTranslation[2];
+            return true;
+        }
+
+        BVHBounds TransformBounds(const float m[12], const BVHBounds& bounds) {
+            BVHBounds result = BVHBounds::Empty();
+            for (uint32_t corner = 0; corner < 8; ++corner) {
+                float p[3] = {(corner & 1) ? bounds.max[0] : bounds.min[0],
+                              (corner & 2) ? bounds.max[1] : bounds.min[1],
+                              (corner & 4) ? bounds.max[2] : bounds.min[2]};
+                float transformed[3];
+                TransformPoint(m, p, transformed);
+                result.Extend(transformed);
+            }
+            return result;
+        }
+
+        // Reads the position of a vertex, returns false if it is outside of the buffer or if the
+        // format can't be used as a position.
+        bool ReadVertexPosition(const RayTracingAccelerationGeometryVertexDescriptor& vertex,
+                                uint32_t vertexIndex,
+                                float out[3]) {
+            uint32_t componentCount = 0;
+            switch (vertex.format) {
+                case wgpu::VertexFormat::Float2:
+                    componentCount = 2;
+                    break;
+                case wgpu::VertexFormat::Float3:
+                case wgpu::VertexFormat::Float4:
+                    componentCount = 3;
+                    break;
+                default:
+                    return false;
+            }
+
+            if (vertexIndex >= vertex.count) {
+                return false;
+            }
+            uint64_t offset = uint64_t(vertex.offset) + uint64_t(vertexIndex) * vertex.stride;
+            if (offset + componentCount * sizeof(float) > vertex.buffer->GetSize()) {
+                return false;
+            }
+
+            const uint8_t* data = ToBackend(vertex.buffer)->GetBackingData() + offset;
+            out[2] = 0.0f;
+            memcpy(out, data, componentCount * sizeof(float));
+            return true;
+        }
+
+        bool ReadIndex(const RayTracingAccelerationGeometryIndexDescriptor& index,
+                       uint32_t i,
+                       uint32_t* out) {
+            uint64_t indexSize = index.format == wgpu::IndexFormat::Uint16 ? sizeof(uint16_t)
+                                                                            : sizeof(uint32_t);
+            uint64_t offset = uint64_t(index.offset) + uint64_t(i) * indexSize;
+            if (offset + indexSize > index.buffer->GetSize()) {
+                return false;
+            }
+
+            const uint8_t* data = ToBackend(index.buffer)->GetBackingData() + offset;
+            if (index.format == wgpu::IndexFormat::Uint16) {
+                uint16_t value;
+                memcpy(&value, data, sizeof(value));
+                *out = value;
+            } else {
+                memcpy(out, data, sizeof(uint32_t));
+            }
+            return true;
+        }
+
+        bool ReadAABB(const RayTracingAccelerationGeometryAabbDescriptor& aabb,
+                      uint32_t i,
+                      BVHBounds* out) {
+            uint64_t offset = uint64_t(aabb.offset) + uint64_t(i) * aabb.stride;
+            if (offset + 6 * sizeof(float) > aabb.buffer->GetSize()) {
+                return false;
+            }
+
+            const uint8_t* data = ToBackend(aabb.buffer)->GetBackingData() + offset;
+            memcpy(out->min, data, 3 * sizeof(float));
+            memcpy(out->max, data + 3 * sizeof(float), 3 * sizeof(float));
+            return true;
+        }
+
+    }  // anonymous namespace
+
+    RayTracingAccelerationContainer::RayTracingAccelerationContainer(
+        Device* device,
+        const RayTracingAccelerationContainerDescriptor* descriptor)
+        : RayTracingAccelerationContainerBase(device, descriptor) {
+        if (descriptor->level == wgpu::RayTracingAccelerationContainerLevel::Bottom) {
+            mGeometries.resize(descriptor->geometryCount);
+            for (uint32_t ii = 0; ii < descriptor->geometryCount; ++ii) {
+                const RayTracingAccelerationGeometryDescriptor& geometry =
+                    descriptor->geometries[ii];
+                Geometry& out = mGeometries[ii];
+                out.type = geometry.type;
+                out.hasVertex = geometry.vertex != nullptr;
+                out.hasIndex = geometry.index != nullptr &&
+                               geometry.index->format != wgpu::IndexFormat::None;
+                out.hasAABB = geometry.aabb != nullptr;
+                if (out.hasVertex) {
+                    out.vertex = *geometry.vertex;
+                }
+                if (out.hasIndex) {
+                    out.index = *geometry.index;
+                }
+                if (out.hasAABB) {
+                    out.aabb = *geometry.aabb;
+                }
+            }
+        }
+        if (descriptor->level == wgpu::RayTracingAccelerationContainerLevel::Top) {
+            mInstances.resize(descriptor->instanceCount);
+            for (uint32_t ii = 0; ii < descriptor->instanceCount; ++ii) {
+                SetInstance(ii, descriptor->instances[ii]);
+            }
+        }
+    }
+
+    RayTracingAccelerationContainer::~RayTracingAccelerationContainer() {
+        DestroyInternal();
+    }
+
+    void RayTracingAccelerationContainer::DestroyImpl() {
+        mBVH.Clear();
+        mPrimitives.clear();
+        mPrimitiveBounds.clear();
+        mTriangles.clear();
+        mInstances.clear();
+    }
+
+    MaybeError RayTracingAccelerationContainer::UpdateInstancesImpl(
+        uint32_t firstInstance,
+        uint32_t instanceCount,
+        const RayTracingAccelerationInstanceDescriptor* descriptors) {
+        ASSERT(uint64_t(firstInstance) + instanceCount <= mInstances.size());
+        // Like the instance buffer of the GPU backends, the changes are only visible to traversal
+        // once the container is built or updated again.
+        for (uint32_t i = 0; i < instanceCount; ++i) {
+            SetInstance(firstInstance + i, descriptors[i]);
+        }
+        return {};
+    }
+
+    ResultOrError<uint64_t> RayTracingAccelerationContainer::GetCompactedSizeImpl() {
+        uint64_t size = uint64_t(mBVH.GetNodeCount()) * sizeof(BVH::Node);
+        size += mBVH.GetPrimitiveIndices().size() * sizeof(uint32_t);
+        size += mGeometries.size() * sizeof(Geometry);
+        size += mPrimitives.size() * sizeof(Primitive);
+        size += mPrimitiveBounds.size() * sizeof(BVHBounds);
+        size += mTriangles.size() * sizeof(BVHTriangle);
+        return size;
+    }
+
+    void RayTracingAccelerationContainer::SetInstance(
+        uint32_t instanceIndex,
+        const RayTracingAccelerationInstanceDescriptor& descriptor) {
+        Instance& instance = mInstances[instanceIndex];
+
+        if (descriptor.transform != nullptr) {
+            // Missing components default to no translation, no rotation and a unit scale.
+            Transform3DDescriptor zero;
+            Transform3DDescriptor one;
+            one.x = one.y = one.z = 1.0f;
+            const RayTracingAccelerationInstanceTransformDescriptor* t = descriptor.transform;
+            const Transform3DDescriptor* tr = t->translation != nullptr ? t->translation : &zero;
+            const Transform3DDescriptor* ro = t->rotation != nullptr ? t->rotation : &zero;
+            const Transform3DDescriptor* sc = t->scale != nullptr ? t->scale : &one;
+            float transform[16] = {};
+            Fill4x3TransformMatrix(transform, tr->x, tr->y, tr->z, ro->x, ro->y, ro->z, sc->x,
+                                   sc->y, sc->z);
+            memcpy(instance.transform, transform, sizeof(instance.transform));
+        } else if (descriptor.transformMatrix != nullptr && descriptor.transformMatrixSize >= 12) {
+            memcpy(instance.transform, descriptor.transformMatrix, sizeof(instance.transform));
+        } else {
+            memcpy(instance.transform, kIdentityTransform, sizeof(instance.transform));
+        }
+
+        // Singular transforms flatten the instance, it can't be hit so its mask is cleared.
+        instance.mask = descriptor.mask & 0xFF;
+        if (!InvertAffineTransform(instance.transform, instance.inverseTransform)) {
+            instance.mask = 0;
+        }
+        instance.instanceId = descriptor.instanceId;
+        instance.instanceOffset = descriptor.instanceOffset;
+        instance.usage = descriptor.usage;
+        instance.geometryContainer = ToBackend(descriptor.geometryContainer);
+    }
+
+    void RayTracingAccelerationContainer::BuildHierarchy() {
+        mVertexPrimitiveMaps.clear();
+
+        ThreadPool* pool = ToBackend(GetDevice())->GetBuildThreadPool();
+        if (GetLevel() == wgpu::RayTracingAccelerationContainerLevel::Bottom) {
+            GatherGeometryPrimitives(pool);
+        } else {
+            GatherInstancePrimitives();
+        }
+
+        // The node count is only known once the build is done, so it is an argument of the end
+        // of the event.
+        dawn_platform::Platform* platform = GetDevice()->GetPlatform();
+        TRACE_EVENT_BEGIN1(platform, GPUWork, "BVH::Build", "primitives",
+                           mPrimitiveBounds.size());
+        mBVH.Build(mPrimitiveBounds, pool);
+        TRACE_EVENT_END1(platform, GPUWork, "BVH::Build", "nodes", mBVH.GetNodeCount());
+    }
+
+    void RayTracingAccelerationContainer::RefitHierarchy(
+        const RayTracingAccelerationContainerDirtyRange* dirtyRanges,
+        uint32_t dirtyRangeCount) {
+        dawn_platform::Platform* platform = GetDevice()->GetPlatform();
+
+        if (GetLevel() == wgpu::RayTracingAccelerationContainerLevel::Top) {
+            GatherInstancePrimitives();
+            TRACE_EVENT2(platform, GPUWork, "BVH::Refit", "primitives", mPrimitiveBounds.size(),
+                         "nodes", mBVH.GetNodeCount());
+            mBVH.Refit(mPrimitiveBounds);
+            return;
+        }
+
+        if (dirtyRangeCount == 0) {
+            GatherGeometryPrimitives(ToBackend(GetDevice())->GetBuildThreadPool());
+            TRACE_EVENT2(platform, GPUWork, "BVH::Refit", "primitives", mPrimitiveBounds.size(),
+                         "nodes", mBVH.GetNodeCount());
+            mBVH.Refit(mPrimitiveBounds);
+            return;
+        }
+
+        TRACE_EVENT1(platform, GPUWork, "RayTracingAccelerationContainerNull::RefitDirtyRanges",
+                     "ranges", dirtyRangeCount);
+
+        std::vector<uint32_t> firstPrimitives(mGeometries.size());
+        uint32_t primitiveCount = 0;
+        for (uint32_t geometryIndex = 0; geometryIndex < mGeometries.size(); ++geometryIndex) {
+            firstPrimitives[geometryIndex] = primitiveCount;
+            primitiveCount += GetPrimitiveCount(mGeometries[geometryIndex]);
+        }
+
+        std::vector<uint32_t> dirtyPrimitives;
+        for (uint32_t i = 0; i < dirtyRangeCount; ++i) {
+            const RayTracingAccelerationContainerDirtyRange& range = dirtyRanges[i];
+            GetDirtyPrimitives(range, firstPrimitives[range.geometryIndex], &dirtyPrimitives);
+        }
+
+        // Ranges of different geometries never share primitives but indexed triangles can be
+        // found by several ranges of the same geometry.
+        std::sort(dirtyPrimitives.begin(), dirtyPrimitives.end());
+        dirtyPrimitives.erase(std::unique(dirtyPrimitives.begin(), dirtyPrimitives.end()),
+                              dirtyPrimitives.end());
+        for (uint32_t primitive : dirtyPrimitives) {
+            const Primitive& info = mPrimitives[primitive];
+            GatherPrimitives(info.geometryIndex, primitive - info.primitiveIndex,
+                             info.primitiveIndex, info.primitiveIndex + 1);
+        }
+
+        TRACE_EVENT2(platform, GPUWork, "BVH::Refit", "primitives", dirtyPrimitives.size(),
+                     "nodes", mBVH.GetNodeCount());
+        mBVH.Refit(mPrimitiveBounds, dirtyPrimitives);
+    }
+
+    void RayTracingAccelerationContainer::GetDirtyPrimitives(
+        const RayTracingAccelerationContainerDirtyRange& range,
+        uint32_t firstPrimitive,
+        std::vector<uint32_t>* primitives) {
+        const Geometry& geometry = mGeometries[range.geometryIndex];
+        uint64_t rangeEnd = uint64_t(range.firstVertex) + range.vertexCount;
+
+        // AABB geometries have one "vertex" per box.
+        if (geometry.type == wgpu::RayTracingAccelerationGeometryType::Aabbs) {
+            for (uint64_t i = range.firstVertex; i < rangeEnd; ++i) {
+                primitives->push_back(firstPrimitive + static_cast<uint32_t>(i));
+            }
+            return;
+        }
+
+        uint32_t primitiveCount = GetPrimitiveCount(geometry);
+        if (!geometry.hasIndex) {
+            uint64_t end = std::min(uint64_t(primitiveCount), (rangeEnd + 2) / 3);
+            for (uint64_t i = range.firstVertex / 3; i < end; ++i) {
+                primitives->push_back(firstPrimitive + static_cast<uint32_t>(i));
+            }
+            return;
+        }
+
+        // Indexed triangles can reference the vertices from anywhere so they are looked up in
+        // the map of the geometry.
+        const VertexPrimitiveMap& map = GetVertexPrimitiveMap(range.geometryIndex);
+        for (uint64_t vertex = range.firstVertex; vertex < rangeEnd; ++vertex) {
+            for (uint32_t i = map.offsets[vertex]; i < map.offsets[vertex + 1]; ++i) {
+                primitives->push_back(firstPrimitive + map.primitives[i]);
+            }
+        }
+    }
+
+    const RayTracingAccelerationContainer::VertexPrimitiveMap&
+    RayTracingAccelerationContainer::GetVertexPrimitiveMap(uint32_t geometryIndex) {
+        if (mVertexPrimitiveMaps.empty()) {
+            mVertexPrimitiveMaps.resize(mGeometries.size());
+        }
+        VertexPrimitiveMap& map = mVertexPrimitiveMaps[geometryIndex];
+        if (map.isComputed) {
+            return map;
+        }
+
+        const Geometry& geometry = mGeometries[geometryIndex];
+        ASSERT(geometry.hasVertex && geometry.hasIndex);
+        uint32_t vertexCount = geometry.vertex.count;
+        uint32_t primitiveCount = GetPrimitiveCount(geometry);
+
+        // Count the primitives of each vertex then store them with a prefix sum of the counts.
+        // Indices that can't be read or are out of the vertices were gathered as inactive
+        // primitives and stay that way.
+        std::vector<uint32_t> vertexIndices(3 * uint64_t(primitiveCount));
+        map.offsets.assign(uint64_t(vertexCount) + 1, 0);
+        for (uint32_t i = 0; i < vertexIndices.size(); ++i) {
+            if (!ReadIndex(geometry.index, i, &vertexIndices[i]) ||
+                vertexIndices[i] >= vertexCount) {
+                vertexIndices[i] = vertexCount;
+                continue;
+            }
+            map.offsets[vertexIndices[i] + 1]++;
+        }
+        for (uint32_t vertex = 0; vertex < vertexCount; ++vertex) {
+            map.offsets[vertex + 1] += map.offsets[vertex];
+        }
+
+        map.primitives.resize(map.offsets[vertexCount]);
+        std::vector<uint32_t> nextSlots(map.offsets.begin(), map.offsets.end() - 1);
+        for (uint32_t i = 0; i < vertexIndices.size(); ++i) {
+            if (vertexIndices[i] != vertexCount) {
+                map.primitives[nextSlots[vertexIndices[i]]++] = i / 3;
+            }
+        }
+
+        map.isComputed = true;
+        return map;
+    }
+
+    void RayTracingAccelerationContainer::GatherGeometryPrimitives(ThreadPool* pool) {
+        std::vector<uint32_t> firstPrimitives(mGeometries.size());
+        uint32_t primitiveCount = 0;
+        for (uint32_t geometryIndex = 0; geometryIndex < mGeometries.size(); ++geometryIndex) {
+            firstPrimitives[geometryIndex] = primitiveCount;
+            primitiveCount += GetPrimitiveCount(mGeometries[geometryIndex]);
+        }
+
+        TRACE_EVENT2(GetDevice()->GetPlatform(), GPUWork,
+                     "RayTracingAccelerationContainerNull::GatherGeometryPrimitives", "geometries",
+                     mGeometries.size(), "primitives", primitiveCount);
+
+        mPrimitives.resize(primitiveCount);
+        mPrimitiveBounds.resize(primitiveCount);
+        mTriangles.resize(primitiveCount);
+
+        for (uint32_t geometryIndex = 0; geometryIndex < mGeometries.size(); ++geometryIndex) {
+            pool->ParallelFor(GetPrimitiveCount(mGeometries[geometryIndex]), kGatherChunkSize,
+                              [&](uint32_t begin, uint32_t end) {
+                                  GatherPrimitives(geometryIndex, firstPrimitives[geometryIndex],
+                                                   begin, end);
+                              });
+        }
+    }
+
+    // static
+    uint32_t RayTracingAccelerationContainer::GetPrimitiveCount(const Geometry& geometry) {
+        if (geometry.type == wgpu::RayTracingAccelerationGeometryType::Aabbs) {
+            ASSERT(geometry.hasAABB);
+            return geometry.aabb.count;
+        }
+        ASSERT(geometry.hasVertex);
+        return geometry.hasIndex ? geometry.index.count / 3 : geometry.vertex.count / 3;
+    }
+
+    void RayTracingAccelerationContainer::GatherPrimitives(uint32_t geometryIndex,
+                                                           uint32_t firstPrimitive,
+                                                           uint32_t begin,
+                                                           uint32_t end) {
+        const Geometry& geometry = mGeometries[geometryIndex];
+
+        for (uint32_t i = begin; i < end; ++i) {
+            uint32_t primitive = firstPrimitive + i;
+            mPrimitives[primitive] = {geometryIndex, i};
+
+            // Primitives that can't be read are kept as inactive primitives so that primitive
+            // indices match the ones of the GPU backends.
+            BVHTriangle triangle = {};
+            BVHBounds bounds = BVHBounds::Empty();
+
+            if (geometry.type == wgpu::RayTracingAccelerationGeometryType::Aabbs) {
+                ReadAABB(geometry.aabb, i, &bounds);
+            } else {
+                uint32_t indices[3] = {3 * i + 0, 3 * i + 1, 3 * i + 2};
+                float positions[3][3];
+
+                bool isValid = true;
+                for (uint32_t corner = 0; corner < 3 && isValid; ++corner) {
+                    if (geometry.hasIndex) {
+                        isValid = ReadIndex(geometry.index, 3 * i + corner, &indices[corner]);
+                    }
+                    isValid = isValid && ReadVertexPosition(geometry.vertex, indices[corner],
+                                                            positions[corner]);
+                }
+
+                if (isValid) {
+                    triangle = MakeBVHTriangle(positions[0], positions[1], positions[2]);
+                    bounds = GetBVHTriangleBounds(triangle);
+                }
+            }
+
+            mPrimitiveBounds[primitive] = bounds;
+            mTriangles[primitive] = triangle;
+        }
+    }
+
+    void RayTracingAccelerationContainer::GatherInstancePrimitives() {
+        TRACE_EVENT1(GetDevice()->GetPlatform(), GPUWork,
+                     "RayTracingAccelerationContainerNull::GatherInstancePrimitives", "instances",
+                     mInstances.size());
+        mPrimitiveBounds.resize(mInstances.size());
+        for (uint32_t i = 0; i < mInstances.size(); ++i) {
+            const Instance& instance = mInstances[i];
+            const RayTracingAccelerationContainer* geometryContainer =
+                instance.geometryContainer.Get();
+
+            // Instances of containers that are not built yet are skipped like on the GPU where
+            // they would reference an empty acceleration structure.
+            if (instance.mask == 0 || !geometryContainer->HasHierarchy()) {
+                mPrimitiveBounds[i] = BVHBounds::Empty();
+                continue;
+            }
+            mPrimitiveBounds[i] =
+                TransformBounds(instance.transform, geometryContainer->GetBounds());
+        }
+    }
+
+    void RayTracingAccelerationContainer::CopyHierarchyFrom(
+        const RayTracingAccelerationContainer* source) {
+        mGeometries = source->mGeometries;
+        mInstances = source->mInstances;
+        mPrimitives = source->mPrimitives;
+        mPrimitiveBounds = source->mPrimitiveBounds;
+        mTriangles = source->mTriangles;
+        mBVH = source->mBVH;
+        mVertexPrimitiveMaps.clear();
+    }
+
+    bool RayTracingAccelerationContainer::HasHierarchy() const {
+        return !IsDestroyed() && !mBVH.IsEmpty();
+    }
+
+    const BVHBounds& RayTracingAccelerationContainer::GetBounds() const {
+        return mBVH.GetBounds();
+    }
+
+    bool RayTracingAccelerationContainer::TraceRay(const BVHRay& ray,
+                                                   uint32_t cullMask,
+                                                   BVHKernel kernel,
+                                                   RayHitInfo* hit) const {
+        if (!HasHierarchy()) {
+            return false;
+        }
+        if (GetLevel() == wgpu::RayTracingAccelerationContainerLevel::Bottom) {
+            if (!TraceRayBottomLevel(ray, kernel, hit)) {
+                return false;
+            }
+            hit->instanceIndex = 0;
+            hit->instanceId = 0;
+            return true;
+        }
+        return TraceRayTopLevel(ray, cullMask, kernel, hit);
+    }
+
+    uint32_t RayTracingAccelerationContainer::TracePacket(const BVHRay* rays,
+                                                          const uint32_t* cullMasks,
+                                                          uint32_t activeMask,
+                                                          BVHKernel kernel,
+                                                          RayHitInfo* hits) const {
+        if (!HasHierarchy()) {
+            return 0;
+        }
+        if (GetLevel() == wgpu::RayTracingAccelerationContainerLevel::Bottom) {
+            uint32_t hitMask = TracePacketBottomLevel(rays, activeMask, kernel, hits);
+            // Like TraceRay, the hits of the rays that missed are left untouched.
+            for (uint32_t i = 0; i < kBVHPacketSize; ++i) {
+                if ((hitMask & (1u << i)) == 0) {
+                    continue;
+                }
+                hits[i].instanceIndex = 0;
+                hits[i].instanceId = 0;
+            }
+            return hitMask;
+        }
+        return TracePacketTopLevel(rays, cullMasks, activeMask, kernel, hits);
+    }
+
+    bool RayTracingAccelerationContainer::IntersectPrimitive(uint32_t primitive,
+                                                             const BVHRay& ray,
+                                                             float* tMax,
+                                                             RayHitInfo* hit) const {
+        const Primitive& info = mPrimitives[primitive];
+        float t;
+        float u = 0.0f;
+        float v = 0.0f;
+
+        if (mGeometries[info.geometryIndex].type ==
+            wgpu::RayTracingAccelerationGeometryType::Aabbs) {
+            // Without intersection shaders, procedural primitives are hit at the entry of their
+            // box.
+            if (!IntersectRayBounds(BVHRayInverse(ray), mPrimitiveBounds[primitive], ray.tMin,
+                                    *tMax, &t)) {
+                return false;
+            }
+        } else if (!IntersectRayTriangle(ray, mTriangles[primitive], ray.tMin, *tMax, &t, &u,
+                                         &v)) {
+            return false;
+        }
+
+        *tMax = t;
+        hit->t = t;
+        hit->u = u;
+        hit->v = v;
+        hit->primitiveIndex = info.primitiveIndex;
+        hit->geometryIndex = info.geometryIndex;
+        return true;
+    }
+
+    // static
+    BVHRay RayTracingAccelerationContainer::GetObjectRay(const Instance& instance,
+                                                         const BVHRay& ray,
+                                                         float tMax) {
+        // The direction isn't normalized so that distances are the same in both spaces.
+        BVHRay objectRay;
+        TransformPoint(instance.inverseTransform, ray.origin, objectRay.origin);
+        TransformDirection(instance.inverseTransform, ray.direction, objectRay.direction);
+        objectRay.tMin = ray.tMin;
+        objectRay.tMax = tMax;
+        return objectRay;
+    }
+
+    bool RayTracingAccelerationContainer::TraceRayBottomLevel(const BVHRay& ray,
+                                                              BVHKernel kernel,
+                                                              RayHitInfo* hit) const {
+        bool hasHit = false;
+        mBVH.Traverse(ray, kernel, [&](uint32_t primitive, float* tMax) {
+            hasHit |= IntersectPrimitive(primitive, ray, tMax, hit);
+        });
+        return hasHit;
+    }
+
+    bool RayTracingAccelerationContainer::TraceRayTopLevel(const BVHRay& ray,
+                                                           uint32_t cullMask,
+                                                           BVHKernel kernel,
+                                                           RayHitInfo* hit) const {
+        bool hasHit = false;
+
+        mBVH.Traverse(ray, kernel, [&](uint32_t instanceIndex, float* tMax) {
+            const Instance& instance = mInstances[instanceIndex];
+            if ((instance.mask & cullMask) == 0) {
+                return;
+            }
+
+            RayHitInfo instanceHit;
+            if (!instance.geometryContainer->TraceRayBottomLevel(
+                    GetObjectRay(instance, ray, *tMax), kernel, &instanceHit)) {
+                return;
+            }
+
+            *tMax = instanceHit.t;
+            *hit = instanceHit;
+            hit->instanceIndex = instanceIndex;
+            hit->instanceId = instance.instanceId;
+            hasHit = true;
+        });
+
+        return hasHit;
+    }
+
+    uint32_t RayTracingAccelerationContainer::TracePacketBottomLevel(const BVHRay* rays,
+                                                                     uint32_t activeMask,
+                                                                     BVHKernel kernel,
+                                                                     RayHitInfo* hits) const {
+        uint32_t hitMask = 0;
+        mBVH.TraversePacket(rays, activeMask, kernel,
+                            [&](uint32_t primitive, uint32_t rayMask, float* tMax) {
+                                for (uint32_t i = 0; i < kBVHPacketSize; ++i) {
+                                    if ((rayMask & (1u << i)) != 0 &&
+                                        IntersectPrimitive(primitive, rays[i], &tMax[i],
+                                                           &hits[i])) {
+                                        hitMask |= 1u << i;
+                                    }
+                                }
+                            });
+        return hitMask;
+    }
+
+    uint32_t RayTracingAccelerationContainer::TracePacketTopLevel(const BVHRay* rays,
+                                                                  const uint32_t* cullMasks,
+                                                                  uint32_t activeMask,
+                                                                  BVHKernel kernel,
+                                                                  RayHitInfo* hits) const {
+        uint32_t hitMask = 0;
+
+        // The rays that reach an instance together traverse its bottom-level container as a
+        // packet so that they stay coherent.
+        mBVH.TraversePacket(rays, activeMask, kernel, [&](uint32_t instanceIndex,
+                                                          uint32_t rayMask, float* tMax) {
+            const Instance& instance = mInstances[instanceIndex];
+            BVHRay objectRays[kBVHPacketSize];
+            uint32_t instanceRayMask = 0;
+            for (uint32_t i = 0; i < kBVHPacketSize; ++i) {
+                objectRays[i] = GetObjectRay(instance, rays[i], tMax[i]);
+                if ((rayMask & (1u << i)) != 0 && (instance.mask & cullMasks[i]) != 0) {
+                    instanceRayMask |= 1u << i;
+                }
+            }
+            if (instanceRayMask == 0) {
+                return;
+            }
+
+            RayHitInfo instanceHits[kBVHPacketSize];
+            uint32_t instanceHitMask = instance.geometryContainer->TracePacketBottomLevel(
+                objectRays, instanceRayMask, kernel, instanceHits);
+            for (uint32_t i = 0; i < kBVHPacketSize; ++i) {
+                if ((instanceHitMask & (1u << i)) == 0) {
+                    continue;
+                }
+                tMax[i] = instanceHits[i].t;
+                hits[i] = instanceHits[i];
+                hits[i].instanceIndex = instanceIndex;
+                hits[i].instanceId = instance.instanceId;
+            }
+            hitMask |= instanceHitMask;
+        });
+
+        return hitMask;
+    }
+
+}}  // namespace dawn_native::null
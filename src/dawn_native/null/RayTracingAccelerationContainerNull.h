@@ -0,0 +1,177 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_NULL_RAYTRACINGACCELERATIONCONTAINERNULL_H_
+#define DAWNNATIVE_NULL_RAYTRACINGACCELERATIONCONTAINERNULL_H_
+
+#include "dawn_native/RayTracingAccelerationContainer.h"
+#include "dawn_native/null/BVHNull.h"
+
+#include <vector>
+
+namespace dawn_native { namespace null {
+
+    class Device;
+
+    struct RayHitInfo {
+        float t;
+        float u;
+        float v;
+        uint32_t primitiveIndex;
+        uint32_t geometryIndex;
+        uint32_t instanceIndex;
+        uint32_t instanceId;
+    };
+
+    // CPU implementation of acceleration containers. Bottom-level containers gather their
+    // triangles and AABBs from the backing data of the geometry buffers when they are built, the
+    // same way a driver reads the buffers on the GPU timeline. Top-level containers build their
+    // hierarchy over the world-space bounds of their instances and reference the bottom-level
+    // containers for traversal.
+    class RayTracingAccelerationContainer final : public RayTracingAccelerationContainerBase {
+      public:
+        RayTracingAccelerationContainer(
+            Device* device,
+            const RayTracingAccelerationContainerDescriptor* descriptor);
+
+        // Called when the build / update / copy commands are executed at submit.
+        void BuildHierarchy();
+        // Refits the hierarchy instead of rebuilding it. For bottom-level containers, only the
+        // primitives using the vertices of |dirtyRanges| are gathered again, or all of them if
+        // there are no dirty ranges.
+        void RefitHierarchy(const RayTracingAccelerationContainerDirtyRange* dirtyRanges,
+                            uint32_t dirtyRangeCount);
+        void CopyHierarchyFrom(const RayTracingAccelerationContainer* source);
+
+        // Returns true and fills |hit| if |ray| hits a primitive of the container.
+        bool TraceRay(const BVHRay& ray,
+                      uint32_t cullMask,
+                      BVHKernel kernel,
+                      RayHitInfo* hit) const;
+
+        // Traces the rays of |activeMask| in a packet of kBVHPacketSize rays and returns the mask
+        // of the rays that hit a primitive, for which |hits| is filled.
+        uint32_t TracePacket(const BVHRay* rays,
+                             const uint32_t* cullMasks,
+                             uint32_t activeMask,
+                             BVHKernel kernel,
+                             RayHitInfo* hits) const;
+
+        bool HasHierarchy() const;
+        const BVHBounds& GetBounds() const;
+
+      private:
+        ~RayTracingAccelerationContainer() override;
+
+        void DestroyImpl() override;
+        MaybeError UpdateInstancesImpl(
+            uint32_t firstInstance,
+            uint32_t instanceCount,
+            const RayTracingAccelerationInstanceDescriptor* descriptors) override;
+        // The size of the data traversal needs, without the unused capacity of the vectors.
+        ResultOrError<uint64_t> GetCompactedSizeImpl() override;
+
+        struct Geometry {
+            wgpu::RayTracingAccelerationGeometryType type;
+            bool hasVertex;
+            bool hasIndex;
+            bool hasAABB;
+            RayTracingAccelerationGeometryVertexDescriptor vertex;
+            RayTracingAccelerationGeometryIndexDescriptor index;
+            RayTracingAccelerationGeometryAabbDescriptor aabb;
+        };
+
+        struct Instance {
+            // Row-major 3x4 object-to-world matrix and its inverse.
+            float transform[12];
+            float inverseTransform[12];
+            uint32_t mask;
+            uint32_t instanceId;
+            uint32_t instanceOffset;
+            wgpu::RayTracingAccelerationInstanceUsage usage;
+            Ref<RayTracingAccelerationContainer> geometryContainer;
+        };
+
+        struct Primitive {
+            uint32_t geometryIndex;
+            uint32_t primitiveIndex;
+        };
+
+        void SetInstance(uint32_t instanceIndex,
+                         const RayTracingAccelerationInstanceDescriptor& descriptor);
+
+        static uint32_t GetPrimitiveCount(const Geometry& geometry);
+        void GatherGeometryPrimitives(ThreadPool* pool);
+        void GatherPrimitives(uint32_t geometryIndex,
+                              uint32_t firstPrimitive,
+                              uint32_t begin,
+                              uint32_t end);
+        void GatherInstancePrimitives();
+        // Appends to |primitives| the primitives of the geometry that use vertices of |range|.
+        void GetDirtyPrimitives(const RayTracingAccelerationContainerDirtyRange& range,
+                                uint32_t firstPrimitive,
+                                std::vector<uint32_t>* primitives);
+
+        // Intersects a primitive of a bottom-level container and records the hit if it is closer
+        // than |tMax|.
+        bool IntersectPrimitive(uint32_t primitive,
+                                const BVHRay& ray,
+                                float* tMax,
+                                RayHitInfo* hit) const;
+        // Returns the ray in the object space of |instance|, clipped to |tMax|.
+        static BVHRay GetObjectRay(const Instance& instance, const BVHRay& ray, float tMax);
+
+        bool TraceRayBottomLevel(const BVHRay& ray, BVHKernel kernel, RayHitInfo* hit) const;
+        bool TraceRayTopLevel(const BVHRay& ray,
+                              uint32_t cullMask,
+                              BVHKernel kernel,
+                              RayHitInfo* hit) const;
+        uint32_t TracePacketBottomLevel(const BVHRay* rays,
+                                        uint32_t activeMask,
+                                        BVHKernel kernel,
+                                        RayHitInfo* hits) const;
+        uint32_t TracePacketTopLevel(const BVHRay* rays,
+                                     const uint32_t* cullMasks,
+                                     uint32_t activeMask,
+                                     BVHKernel kernel,
+                                     RayHitInfo* hits) const;
+
+        std::vector<Geometry> mGeometries;
+        std::vector<Instance> mInstances;
+
+        // Data gathered at build time, indexed by primitive. For AABB geometries the bounds are
+        // the primitive itself and |mTriangles| is left unused.
+        std::vector<Primitive> mPrimitives;
+        std::vector<BVHBounds> mPrimitiveBounds;
+        std::vector<BVHTriangle> mTriangles;
+
+        BVH mBVH;
+
+        // The primitives using each vertex of the indexed geometries, so that refits don't scan
+        // all the indices for every dirty range. The primitives using vertex v are in
+        // [offsets[v], offsets[v + 1]) of |primitives|. They are computed at the first refit with
+        // dirty ranges after a build, as refits can't change the topology.
+        struct VertexPrimitiveMap {
+            bool isComputed = false;
+            std::vector<uint32_t> offsets;
+            std::vector<uint32_t> primitives;
+        };
+        const VertexPrimitiveMap& GetVertexPrimitiveMap(uint32_t geometryIndex);
+
+        std::vector<VertexPrimitiveMap> mVertexPrimitiveMaps;
+    };
+
+}}  // namespace dawn_native::null
+
+#endif  // DAWNNATIVE_NULL_RAYTRACINGACCELERATIONCONTAINERNULL_H_
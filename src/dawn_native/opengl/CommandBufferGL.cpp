@@ -700,7 +700,7 @@ namespace dawn_native { namespace opengl {
                     if (cmd->dynamicOffsetCount > 0) {
                         dynamicOffsets = mCommands.NextData<uint32_t>(cmd->dynamicOffsetCount);
                     }
-                    bindGroupTracker.OnSetBindGroup(cmd->index, cmd->group.Get(),
+                    bindGroupTracker.OnSetBindGroup(cmd->index, cmd->group,
                                                     cmd->dynamicOffsetCount, dynamicOffsets);
                     break;
                 }
@@ -863,11 +863,13 @@ namespace dawn_native { namespace opengl {
 
         VertexStateBufferBindingTracker vertexStateBufferBindingTracker;
         BindGroupTracker bindGroupTracker = {};
+        DrawCommandDecoder drawDecoder;
 
         auto DoRenderBundleCommand = [&](CommandIterator* iter, Command type) {
             switch (type) {
-                case Command::Draw: {
-                    DrawCmd* draw = iter->NextCommand<DrawCmd>();
+                case Command::Draw:
+                case Command::RepeatDraw: {
+                    DrawCmd* draw = drawDecoder.NextDraw(iter, type);
                     vertexStateBufferBindingTracker.Apply(gl);
                     bindGroupTracker.Apply(gl);
 
@@ -884,8 +886,9 @@ namespace dawn_native { namespace opengl {
                     break;
                 }
 
-                case Command::DrawIndexed: {
-                    DrawIndexedCmd* draw = iter->NextCommand<DrawIndexedCmd>();
+                case Command::DrawIndexed:
+                case Command::RepeatDrawIndexed: {
+                    DrawIndexedCmd* draw = drawDecoder.NextDrawIndexed(iter, type);
                     vertexStateBufferBindingTracker.Apply(gl);
                     bindGroupTracker.Apply(gl);
 
@@ -967,7 +970,7 @@ namespace dawn_native { namespace opengl {
 
                 case Command::SetRenderPipeline: {
                     SetRenderPipelineCmd* cmd = iter->NextCommand<SetRenderPipelineCmd>();
-                    lastPipeline = ToBackend(cmd->pipeline).Get();
+                    lastPipeline = ToBackend(cmd->pipeline);
                     lastPipeline->ApplyNow(persistentPipelineState);
 
                     vertexStateBufferBindingTracker.OnSetPipeline(lastPipeline);
@@ -981,7 +984,7 @@ namespace dawn_native { namespace opengl {
                     if (cmd->dynamicOffsetCount > 0) {
                         dynamicOffsets = iter->NextData<uint32_t>(cmd->dynamicOffsetCount);
                     }
-                    bindGroupTracker.OnSetBindGroup(cmd->index, cmd->group.Get(),
+                    bindGroupTracker.OnSetBindGroup(cmd->index, cmd->group,
                                                     cmd->dynamicOffsetCount, dynamicOffsets);
                     break;
                 }
@@ -989,13 +992,13 @@ namespace dawn_native { namespace opengl {
                 case Command::SetIndexBuffer: {
                     SetIndexBufferCmd* cmd = iter->NextCommand<SetIndexBufferCmd>();
                     indexBufferBaseOffset = cmd->offset;
-                    vertexStateBufferBindingTracker.OnSetIndexBuffer(cmd->buffer.Get());
+                    vertexStateBufferBindingTracker.OnSetIndexBuffer(cmd->buffer);
                     break;
                 }
 
                 case Command::SetVertexBuffer: {
                     SetVertexBufferCmd* cmd = iter->NextCommand<SetVertexBufferCmd>();
-                    vertexStateBufferBindingTracker.OnSetVertexBuffer(cmd->slot, cmd->buffer.Get(),
+                    vertexStateBufferBindingTracker.OnSetVertexBuffer(cmd->slot, cmd->buffer,
                                                                       cmd->offset);
                     break;
                 }
@@ -19,6 +19,7 @@
 #include "dawn_native/Instance.h"
 #include "dawn_native/VulkanBackend.h"
 #include "dawn_native/vulkan/AdapterVk.h"
+#include "dawn_native/vulkan/FakeVulkanDriver.h"
 #include "dawn_native/vulkan/VulkanError.h"
 
 // TODO(crbug.com/dawn/283): Link against the Vulkan Loader and remove this.
@@ -81,6 +82,10 @@ namespace dawn_native { namespace vulkan {
         return mGlobalInfo;
     }
 
+    bool Backend::UsesFakeDriver() const {
+        return mUsesFakeDriver;
+    }
+
     MaybeError Backend::LoadVulkan(bool useSwiftshader) {
         // First try to load the system Vulkan driver, if that fails,
         // try to load with Swiftshader. Note: The system driver could potentially be Swiftshader
@@ -139,6 +144,17 @@ namespace dawn_native { namespace vulkan {
 
         DAWN_TRY(mFunctions.LoadGlobalProcs(mVulkanLib));
 
+        return InitializeInstance();
+    }
+
+    MaybeError Backend::InitializeWithFakeDriver() {
+        mUsesFakeDriver = true;
+        DAWN_TRY(mFunctions.LoadGlobalProcs(GetFakeDriverInstanceProcAddr()));
+
+        return InitializeInstance();
+    }
+
+    MaybeError Backend::InitializeInstance() {
         DAWN_TRY_ASSIGN(mGlobalInfo, GatherGlobalInfo(*this));
 
         VulkanGlobalKnobs usedGlobalKnobs = {};
@@ -159,6 +175,11 @@ namespace dawn_native { namespace vulkan {
     std::vector<std::unique_ptr<AdapterBase>> Backend::DiscoverDefaultAdapters() {
         std::vector<std::unique_ptr<AdapterBase>> adapters;
 
+        // The fake driver is only used when it is requested explicitly.
+        if (mUsesFakeDriver) {
+            return adapters;
+        }
+
         for (VkPhysicalDevice physicalDevice : mPhysicalDevices) {
             std::unique_ptr<Adapter> adapter = std::make_unique<Adapter>(this, physicalDevice);
 
@@ -172,6 +193,32 @@ namespace dawn_native { namespace vulkan {
         return adapters;
     }
 
+    ResultOrError<std::vector<std::unique_ptr<AdapterBase>>> Backend::DiscoverAdapters(
+        const AdapterDiscoveryOptionsBase* optionsBase) {
+        ASSERT(optionsBase->backendType == WGPUBackendType_Vulkan);
+        const AdapterDiscoveryOptions* options =
+            static_cast<const AdapterDiscoveryOptions*>(optionsBase);
+
+        if (!options->useFakeDriver) {
+            return DAWN_VALIDATION_ERROR(
+                "AdapterDiscoveryOptions::useFakeDriver must be set to discover Vulkan adapters");
+        }
+
+        // Every Vulkan backend connection sees the options, only the fake driver's one creates
+        // adapters for them.
+        std::vector<std::unique_ptr<AdapterBase>> adapters;
+        if (!mUsesFakeDriver) {
+            return adapters;
+        }
+
+        for (VkPhysicalDevice physicalDevice : mPhysicalDevices) {
+            std::unique_ptr<Adapter> adapter = std::make_unique<Adapter>(this, physicalDevice);
+            DAWN_TRY(adapter->Initialize());
+            adapters.push_back(std::move(adapter));
+        }
+        return adapters;
+    }
+
     ResultOrError<VulkanGlobalKnobs> Backend::CreateInstance() {
         VulkanGlobalKnobs usedKnobs = {};
 
@@ -330,4 +377,15 @@ namespace dawn_native { namespace vulkan {
         return backend;
     }
 
+    BackendConnection* ConnectFakeDriver(InstanceBase* instance) {
+        Backend* backend = new Backend(instance);
+
+        if (instance->ConsumedError(backend->InitializeWithFakeDriver())) {
+            delete backend;
+            return nullptr;
+        }
+
+        return backend;
+    }
+
 }}  // namespace dawn_native::vulkan
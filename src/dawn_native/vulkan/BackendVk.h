@@ -32,12 +32,18 @@ namespace dawn_native { namespace vulkan {
         VkInstance GetVkInstance() const;
         const VulkanGlobalInfo& GetGlobalInfo() const;
 
+        bool UsesFakeDriver() const;
+
         MaybeError Initialize(bool useSwiftshader);
+        MaybeError InitializeWithFakeDriver();
 
         std::vector<std::unique_ptr<AdapterBase>> DiscoverDefaultAdapters() override;
+        ResultOrError<std::vector<std::unique_ptr<AdapterBase>>> DiscoverAdapters(
+            const AdapterDiscoveryOptionsBase* optionsBase) override;
 
       private:
         MaybeError LoadVulkan(bool useSwiftshader);
+        MaybeError InitializeInstance();
         ResultOrError<VulkanGlobalKnobs> CreateInstance();
 
         MaybeError RegisterDebugUtils();
@@ -60,6 +66,7 @@ namespace dawn_native { namespace vulkan {
                               void* pUserdata);
 
         DynamicLib mVulkanLib;
+        bool mUsesFakeDriver = false;
         VulkanGlobalInfo mGlobalInfo = {};
         VkInstance mInstance = VK_NULL_HANDLE;
         VulkanFunctions mFunctions;
@@ -39,8 +39,15 @@ namespace dawn_native { namespace vulkan {
 
         // Transitions the buffer to be used as `usage`, recording any necessary barrier in
         // `commands`.
-        // TODO(cwallez@chromium.org): coalesce barriers and do them early when possible.
         void TransitionUsageNow(CommandRecordingContext* recordingContext, wgpu::BufferUsage usage);
+        // Transitions the buffer to be used as `usage` without recording the barrier. Returns
+        // whether a barrier is needed, in which case it is written to `barrier` and its stages
+        // are merged in `srcStages` and `dstStages`, so that the barriers of several resources
+        // can be recorded at once.
+        bool TransitionUsageAndGetResourceBarrier(wgpu::BufferUsage usage,
+                                                  VkBufferMemoryBarrier* barrier,
+                                                  VkPipelineStageFlags* srcStages,
+                                                  VkPipelineStageFlags* dstStages);
 
       private:
         ~Buffer() override;
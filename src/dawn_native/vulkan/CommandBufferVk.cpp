@@ -31,9 +31,12 @@
 #include "dawn_native/vulkan/RenderPassCache.h"
 #include "dawn_native/vulkan/RenderPipelineVk.h"
 #include "dawn_native/vulkan/ResourceHeapVk.h"
+#include "dawn_native/vulkan/ScratchBufferAllocatorVk.h"
 #include "dawn_native/vulkan/TextureVk.h"
 #include "dawn_native/vulkan/UtilsVulkan.h"
 #include "dawn_native/vulkan/VulkanError.h"
+#include "dawn_platform/DawnPlatform.h"
+#include "dawn_platform/tracing/TraceEvent.h"
 
 namespace dawn_native { namespace vulkan {
 
@@ -184,13 +187,15 @@ namespace dawn_native { namespace vulkan {
             }
         };
 
+        // Begins the render pass and returns the VkRenderPass it uses in |renderPassVK|.
         MaybeError RecordBeginRenderPass(CommandRecordingContext* recordingContext,
                                          Device* device,
-                                         BeginRenderPassCmd* renderPass) {
+                                         BeginRenderPassCmd* renderPass,
+                                         VkSubpassContents subpassContents,
+                                         VkRenderPass* renderPassVK) {
             VkCommandBuffer commands = recordingContext->commandBuffer;
 
             // Query a VkRenderPass from the cache
-            VkRenderPass renderPassVK = VK_NULL_HANDLE;
             {
                 RenderPassCacheQuery query;
 
@@ -214,7 +219,7 @@ namespace dawn_native { namespace vulkan {
 
                 query.SetSampleCount(renderPass->attachmentState->GetSampleCount());
 
-                DAWN_TRY_ASSIGN(renderPassVK, device->GetRenderPassCache()->GetRenderPass(query));
+                DAWN_TRY_ASSIGN(*renderPassVK, device->GetRenderPassCache()->GetRenderPass(query));
             }
 
             // Create a framebuffer that will be used once for the render pass and gather the clear
@@ -270,7 +275,7 @@ namespace dawn_native { namespace vulkan {
                 createInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
                 createInfo.pNext = nullptr;
                 createInfo.flags = 0;
-                createInfo.renderPass = renderPassVK;
+                createInfo.renderPass = *renderPassVK;
                 createInfo.attachmentCount = attachmentCount;
                 createInfo.pAttachments = AsVkArray(attachments.data());
                 createInfo.width = renderPass->width;
@@ -290,7 +295,7 @@ namespace dawn_native { namespace vulkan {
             VkRenderPassBeginInfo beginInfo;
             beginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
             beginInfo.pNext = nullptr;
-            beginInfo.renderPass = renderPassVK;
+            beginInfo.renderPass = *renderPassVK;
             beginInfo.framebuffer = framebuffer;
             beginInfo.renderArea.offset.x = 0;
             beginInfo.renderArea.offset.y = 0;
@@ -299,7 +304,97 @@ namespace dawn_native { namespace vulkan {
             beginInfo.clearValueCount = attachmentCount;
             beginInfo.pClearValues = clearValues.data();
 
-            device->fn.CmdBeginRenderPass(commands, &beginInfo, VK_SUBPASS_CONTENTS_INLINE);
+            device->fn.CmdBeginRenderPass(commands, &beginInfo, subpassContents);
+
+            return {};
+        }
+
+        // Makes the result of previous acceleration container builds visible to the following
+        // commands reading them, like copies and property queries.
+        void RecordAccelerationContainerBuildBarrier(Device* device, VkCommandBuffer commands) {
+            VkMemoryBarrier barrier;
+            barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+            barrier.pNext = nullptr;
+            barrier.srcAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR;
+            barrier.dstAccessMask = VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR;
+
+            device->fn.CmdPipelineBarrier(commands,
+                                          VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+                                          VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+                                          0, 1, &barrier, 0, nullptr, 0, nullptr);
+        }
+
+        void RecordCompactedSizeQuery(Device* device,
+                                      VkCommandBuffer commands,
+                                      RayTracingAccelerationContainer* container) {
+            VkQueryPool queryPool = container->GetCompactedSizeQueryPool();
+            VkAccelerationStructureKHR accelerationStructure =
+                container->GetAccelerationStructure();
+            device->fn.CmdResetQueryPool(commands, queryPool, 0, 1);
+            device->fn.CmdWriteAccelerationStructuresPropertiesKHR(
+                commands, 1, &*accelerationStructure,
+                VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR, queryPool, 0);
+        }
+
+        // Builds all containers with a single vkCmdBuildAccelerationStructureKHR call. The build
+        // scratch memory of each container is sub-allocated from one scratch allocation.
+        MaybeError RecordBuildAccelerationContainers(
+            Device* device,
+            VkCommandBuffer commands,
+            Ref<RayTracingAccelerationContainerBase>* containers,
+            uint32_t count) {
+            TRACE_EVENT1(device->GetPlatform(), Recording,
+                         "CommandBufferVk::RecordBuildAccelerationContainers", "count", count);
+            constexpr uint64_t kAlignment = ScratchBufferAllocator::kScratchAlignment;
+
+            std::vector<uint64_t> scratchOffsets(count);
+            uint64_t scratchSize = 0;
+            for (uint32_t i = 0; i < count; ++i) {
+                RayTracingAccelerationContainer* container = ToBackend(containers[i].Get());
+                ASSERT(container->GetLevel() == containers[0]->GetLevel());
+                uint64_t size = container->GetScratchBuildMemoryRequirements().size;
+                scratchOffsets[i] = scratchSize;
+                scratchSize += (size + kAlignment - 1) & ~(kAlignment - 1);
+            }
+
+            ScratchAllocation scratchMemory;
+            DAWN_TRY_ASSIGN(scratchMemory,
+                            device->GetScratchBufferAllocator()->Allocate(scratchSize));
+
+            std::vector<VkAccelerationStructureBuildGeometryInfoKHR> infos(count);
+            std::vector<const VkAccelerationStructureGeometryKHR*> ppGeometries(count);
+            std::vector<const VkAccelerationStructureBuildOffsetInfoKHR*> ppBuildOffsets(count);
+            for (uint32_t i = 0; i < count; ++i) {
+                RayTracingAccelerationContainer* container = ToBackend(containers[i].Get());
+                ppGeometries[i] = container->GetGeometries().data();
+                ppBuildOffsets[i] = container->GetBuildOffsets().data();
+
+                VkAccelerationStructureBuildGeometryInfoKHR& asInfo = infos[i];
+                asInfo.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR;
+                asInfo.pNext = nullptr;
+                asInfo.type = ToVulkanAccelerationContainerLevel(container->GetLevel());
+                asInfo.flags = ToVulkanBuildAccelerationContainerFlags(container->GetUsage());
+                asInfo.update = VK_FALSE;
+                asInfo.srcAccelerationStructure = VK_NULL_HANDLE;
+                asInfo.dstAccelerationStructure = container->GetAccelerationStructure();
+                asInfo.geometryArrayOfPointers = VK_FALSE;
+                asInfo.geometryCount = container->GetGeometries().size();
+                asInfo.ppGeometries = &ppGeometries[i];
+                asInfo.scratchData.deviceAddress = scratchMemory.deviceAddress + scratchOffsets[i];
+            }
+
+            device->fn.CmdBuildAccelerationStructureKHR(commands, count, infos.data(),
+                                                        ppBuildOffsets.data());
+            RecordAccelerationContainerBuildBarrier(device, commands);
+
+            for (uint32_t i = 0; i < count; ++i) {
+                RayTracingAccelerationContainer* container = ToBackend(containers[i].Get());
+                if (container->GetCompactedSizeQueryPool() != VK_NULL_HANDLE) {
+                    RecordCompactedSizeQuery(device, commands, container);
+                }
+                container->SetBuildState(true);
+                container->IncrementBuildCount();
+            }
 
             return {};
         }
@@ -317,6 +412,11 @@ namespace dawn_native { namespace vulkan {
 
     CommandBuffer::~CommandBuffer() {
         FreeCommands(&mCommands);
+
+        if (mRenderPassContentsPool != VK_NULL_HANDLE) {
+            // Destroying the pool frees the secondary command buffers allocated from it.
+            ToBackend(GetDevice())->GetFencedDeleter()->DeleteWhenUnused(mRenderPassContentsPool);
+        }
     }
 
     void CommandBuffer::RecordCopyImageWithTemporaryBuffer(
@@ -376,25 +476,52 @@ namespace dawn_native { namespace vulkan {
         Device* device = ToBackend(GetDevice());
         VkCommandBuffer commands = recordingContext->commandBuffer;
 
-        // Records the necessary barriers for the resource usage pre-computed by the frontend
-        auto TransitionForPass = [](CommandRecordingContext* recordingContext,
-                                    const PassResourceUsage& usages) {
-            for (size_t i = 0; i < usages.buffers.size(); ++i) {
-                Buffer* buffer = ToBackend(usages.buffers[i]);
-                buffer->TransitionUsageNow(recordingContext, usages.bufferUsages[i]);
-            }
+        // Records the necessary barriers for the resource usage pre-computed by the frontend.
+        // The barriers of all the resources of the pass are batched in a single
+        // vkCmdPipelineBarrier, in arrays that are reused for all the passes.
+        std::vector<VkBufferMemoryBarrier> bufferBarriers;
+        std::vector<VkImageMemoryBarrier> imageBarriers;
+        auto TransitionForPass = [&](CommandRecordingContext* recordingContext,
+                                     const PassResourceUsage& usages) {
+            // Clear textures that are not output attachments. Output attachments will be cleared
+            // in RecordBeginRenderPass by setting the loadop to clear when the texture
+            // subresource has not been initialized before the render pass. Clears record their
+            // own barriers so they are done before the barriers of the pass are gathered.
             for (size_t i = 0; i < usages.textures.size(); ++i) {
                 Texture* texture = ToBackend(usages.textures[i]);
-                // Clear textures that are not output attachments. Output attachments will be
-                // cleared in RecordBeginRenderPass by setting the loadop to clear when the
-                // texture subresource has not been initialized before the render pass.
                 if (!(usages.textureUsages[i].usage & wgpu::TextureUsage::OutputAttachment)) {
                     texture->EnsureSubresourceContentInitialized(recordingContext, 0,
                                                                  texture->GetNumMipLevels(), 0,
                                                                  texture->GetArrayLayers());
                 }
+            }
+
+            VkPipelineStageFlags srcStages = 0;
+            VkPipelineStageFlags dstStages = 0;
+            bufferBarriers.clear();
+            imageBarriers.clear();
+
+            for (size_t i = 0; i < usages.buffers.size(); ++i) {
+                Buffer* buffer = ToBackend(usages.buffers[i]);
+                VkBufferMemoryBarrier barrier;
+                if (buffer->TransitionUsageAndGetResourceBarrier(usages.bufferUsages[i], &barrier,
+                                                                 &srcStages, &dstStages)) {
+                    bufferBarriers.push_back(barrier);
+                }
+            }
+            for (size_t i = 0; i < usages.textures.size(); ++i) {
+                Texture* texture = ToBackend(usages.textures[i]);
                 texture->TransitionUsageForPass(recordingContext,
-                                                usages.textureUsages[i].subresourceUsages);
+                                                usages.textureUsages[i].subresourceUsages,
+                                                &imageBarriers, &srcStages, &dstStages);
+            }
+
+            if (!bufferBarriers.empty() || !imageBarriers.empty()) {
+                ASSERT(srcStages != 0 && dstStages != 0);
+                device->fn.CmdPipelineBarrier(recordingContext->commandBuffer, srcStages,
+                                              dstStages, 0, 0, nullptr, bufferBarriers.size(),
+                                              bufferBarriers.data(), imageBarriers.size(),
+                                              imageBarriers.data());
             }
         };
         const std::vector<PassResourceUsage>& passResourceUsages = GetResourceUsages().perPass;
@@ -410,6 +537,13 @@ namespace dawn_native { namespace vulkan {
                     BuildRayTracingAccelerationContainerCmd* build =
                         mCommands.NextCommand<BuildRayTracingAccelerationContainerCmd>();
                     RayTracingAccelerationContainer* container = ToBackend(build->container.Get());
+                    TRACE_EVENT0(device->GetPlatform(), Recording,
+                                 "CommandBufferVk::RecordBuildAccelerationContainer");
+
+                    ScratchAllocation scratchMemory;
+                    DAWN_TRY_ASSIGN(scratchMemory,
+                                    device->GetScratchBufferAllocator()->Allocate(
+                                        container->GetScratchBuildMemoryRequirements().size));
 
                     std::vector<VkAccelerationStructureGeometryKHR>& geometries =
                         container->GetGeometries();
@@ -426,8 +560,7 @@ namespace dawn_native { namespace vulkan {
                     asInfo.geometryArrayOfPointers = VK_FALSE;
                     asInfo.geometryCount = geometries.size();
                     asInfo.ppGeometries = &ppGeometries;
-                    asInfo.scratchData.deviceAddress =
-                        container->GetScratchMemory().build.deviceAddress;
+                    asInfo.scratchData.deviceAddress = scratchMemory.deviceAddress;
 
                     std::vector<VkAccelerationStructureBuildOffsetInfoKHR>& buildOffsets =
                         container->GetBuildOffsets();
@@ -437,7 +570,13 @@ namespace dawn_native { namespace vulkan {
                     device->fn.CmdBuildAccelerationStructureKHR(commands, 1, &asInfo,
                                                                 &ppBuildOffsets);
 
+                    if (container->GetCompactedSizeQueryPool() != VK_NULL_HANDLE) {
+                        RecordAccelerationContainerBuildBarrier(device, commands);
+                        RecordCompactedSizeQuery(device, commands, container);
+                    }
+
                     container->SetBuildState(true);
+                    container->IncrementBuildCount();
 
                     if (lastUpdateContainer != nullptr) {
                         return DAWN_VALIDATION_ERROR(
@@ -454,6 +593,31 @@ namespace dawn_native { namespace vulkan {
                     break;
                 }
 
+                case Command::BuildRayTracingAccelerationContainers: {
+                    BuildRayTracingAccelerationContainersCmd* build =
+                        mCommands.NextCommand<BuildRayTracingAccelerationContainersCmd>();
+                    Ref<RayTracingAccelerationContainerBase>* containers =
+                        mCommands.NextData<Ref<RayTracingAccelerationContainerBase>>(build->count);
+                    RayTracingAccelerationContainer* container = ToBackend(containers[0].Get());
+
+                    if (lastUpdateContainer != nullptr) {
+                        return DAWN_VALIDATION_ERROR(
+                            "Build and update passes for acceleration containers must be "
+                            "separated");
+                    }
+                    if (lastBuildContainer != nullptr &&
+                        lastBuildContainer->GetLevel() != container->GetLevel()) {
+                        return DAWN_VALIDATION_ERROR(
+                            "Acceleration containers of different levels must be built in "
+                            "separate passes");
+                    }
+
+                    DAWN_TRY(RecordBuildAccelerationContainers(device, commands, containers,
+                                                               build->count));
+                    lastBuildContainer = container;
+                    break;
+                }
+
                 case Command::CopyRayTracingAccelerationContainer: {
                     CopyRayTracingAccelerationContainerCmd* copy =
                         mCommands.NextCommand<CopyRayTracingAccelerationContainerCmd>();
@@ -468,8 +632,17 @@ namespace dawn_native { namespace vulkan {
                     copyInfo.src = srcContainer->GetAccelerationStructure();
                     copyInfo.dst = dstContainer->GetAccelerationStructure();
                     copyInfo.mode = VK_COPY_ACCELERATION_STRUCTURE_MODE_CLONE_KHR;
+                    if (copy->mode == wgpu::RayTracingAccelerationContainerCopyMode::Compact) {
+                        copyInfo.mode = VK_COPY_ACCELERATION_STRUCTURE_MODE_COMPACT_KHR;
+                    }
 
+                    // the source may have been built earlier in the same command buffer
+                    RecordAccelerationContainerBuildBarrier(device, commands);
                     device->fn.CmdCopyAccelerationStructureKHR(commands, &copyInfo);
+
+                    if (copy->mode == wgpu::RayTracingAccelerationContainerCopyMode::Compact) {
+                        dstContainer->SetBuildState(true);
+                    }
                     break;
                 }
 
@@ -477,13 +650,24 @@ namespace dawn_native { namespace vulkan {
                     UpdateRayTracingAccelerationContainerCmd* update =
                         mCommands.NextCommand<UpdateRayTracingAccelerationContainerCmd>();
                     RayTracingAccelerationContainer* container = ToBackend(update->container.Get());
+                    TRACE_EVENT0(device->GetPlatform(), Recording,
+                                 "CommandBufferVk::RecordUpdateAccelerationContainer");
+
+                    // the driver always refits the whole container
+                    if (update->dirtyRangeCount > 0) {
+                        mCommands.NextData<RayTracingAccelerationContainerDirtyRange>(
+                            update->dirtyRangeCount);
+                    }
 
-                    // we can destroy the scratch build memory after the first update
                     if (container->IsBuilt() && !container->IsUpdated()) {
-                        container->DestroyScratchBuildMemory();
                         container->SetUpdateState(true);
                     }
 
+                    ScratchAllocation scratchMemory;
+                    DAWN_TRY_ASSIGN(scratchMemory,
+                                    device->GetScratchBufferAllocator()->Allocate(
+                                        container->GetScratchUpdateMemoryRequirements().size));
+
                     std::vector<VkAccelerationStructureGeometryKHR>& geometries =
                         container->GetGeometries();
                     const VkAccelerationStructureGeometryKHR* ppGeometries = geometries.data();
@@ -499,8 +683,7 @@ namespace dawn_native { namespace vulkan {
                     asInfo.geometryArrayOfPointers = VK_FALSE;
                     asInfo.geometryCount = geometries.size();
                     asInfo.ppGeometries = &ppGeometries;
-                    asInfo.scratchData.deviceAddress =
-                        container->GetScratchMemory().update.deviceAddress;
+                    asInfo.scratchData.deviceAddress = scratchMemory.deviceAddress;
 
                     std::vector<VkAccelerationStructureBuildOffsetInfoKHR>& buildOffsets =
                         container->GetBuildOffsets();
@@ -511,6 +694,7 @@ namespace dawn_native { namespace vulkan {
                                                                 &ppBuildOffsets);
 
                     container->SetBuildState(true);
+                    container->IncrementRefitCount();
 
                     if (lastBuildContainer != nullptr) {
                         return DAWN_VALIDATION_ERROR(
@@ -679,8 +863,17 @@ namespace dawn_native { namespace vulkan {
 
                     TransitionForPass(recordingContext, passResourceUsages[nextPassNumber]);
 
+                    // LazyClearRenderPassAttachments changes the load operations depending on the
+                    // current content of the attachments, so reusable command buffers give it a
+                    // copy to keep the recorded load operations for the next submits.
+                    BeginRenderPassCmd lazyClearedCmd;
+                    if (IsReusable()) {
+                        lazyClearedCmd = *cmd;
+                        cmd = &lazyClearedCmd;
+                    }
+
                     LazyClearRenderPassAttachments(cmd);
-                    DAWN_TRY(RecordRenderPass(recordingContext, cmd));
+                    DAWN_TRY(RecordRenderPass(recordingContext, cmd, nextPassNumber));
 
                     nextPassNumber++;
                     break;
@@ -751,7 +944,7 @@ namespace dawn_native { namespace vulkan {
                 case Command::SetBindGroup: {
                     SetBindGroupCmd* cmd = mCommands.NextCommand<SetBindGroupCmd>();
 
-                    BindGroup* bindGroup = ToBackend(cmd->group.Get());
+                    BindGroup* bindGroup = ToBackend(cmd->group);
                     uint32_t* dynamicOffsets = nullptr;
                     if (cmd->dynamicOffsetCount > 0) {
                         dynamicOffsets = mCommands.NextData<uint32_t>(cmd->dynamicOffsetCount);
@@ -854,13 +1047,10 @@ namespace dawn_native { namespace vulkan {
 
                     ASSERT(usedPipeline != nullptr);
 
-                    RayTracingShaderBindingTable* sbt =
-                        ToBackend(usedPipeline->GetShaderBindingTable());
-
-                    VkBuffer sbtBuffer = sbt->GetGroupBufferHandle();
+                    VkBuffer sbtBuffer = usedPipeline->GetGroupBufferHandle();
 
-                    uint32_t groupHandleSize = sbt->GetShaderGroupHandleSize();
-                    uint32_t groupSize = sbt->GetGroups().size();
+                    uint32_t groupHandleSize = usedPipeline->GetGroupHandleSize();
+                    uint32_t groupSize = usedPipeline->GetGroupCount();
                     uint32_t sbtSize = groupSize * groupHandleSize;
 
                     uint32_t rayGenOffset = traceRays->rayGenerationOffset;
@@ -893,7 +1083,7 @@ namespace dawn_native { namespace vulkan {
                 case Command::SetBindGroup: {
                     SetBindGroupCmd* cmd = mCommands.NextCommand<SetBindGroupCmd>();
 
-                    BindGroup* bindGroup = ToBackend(cmd->group.Get());
+                    BindGroup* bindGroup = ToBackend(cmd->group);
                     uint32_t* dynamicOffsets = nullptr;
                     if (cmd->dynamicOffsetCount > 0) {
                         dynamicOffsets = mCommands.NextData<uint32_t>(cmd->dynamicOffsetCount);
@@ -974,11 +1164,121 @@ namespace dawn_native { namespace vulkan {
     }
 
     MaybeError CommandBuffer::RecordRenderPass(CommandRecordingContext* recordingContext,
-                                               BeginRenderPassCmd* renderPassCmd) {
+                                               BeginRenderPassCmd* renderPassCmd,
+                                               size_t passIndex) {
         Device* device = ToBackend(GetDevice());
         VkCommandBuffer commands = recordingContext->commandBuffer;
+        VkRenderPass renderPassVK = VK_NULL_HANDLE;
 
-        DAWN_TRY(RecordBeginRenderPass(recordingContext, device, renderPassCmd));
+        if (!IsReusable()) {
+            DAWN_TRY(RecordBeginRenderPass(recordingContext, device, renderPassCmd,
+                                           VK_SUBPASS_CONTENTS_INLINE, &renderPassVK));
+            RecordRenderPassContents(recordingContext, renderPassCmd);
+            device->fn.CmdEndRenderPass(commands);
+            return {};
+        }
+
+        DAWN_TRY(RecordBeginRenderPass(recordingContext, device, renderPassCmd,
+                                       VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS,
+                                       &renderPassVK));
+        VkCommandBuffer contents = VK_NULL_HANDLE;
+        DAWN_TRY_ASSIGN(contents,
+                        GetOrRecordRenderPassContents(renderPassCmd, passIndex, renderPassVK));
+        device->fn.CmdExecuteCommands(commands, 1, &contents);
+        device->fn.CmdEndRenderPass(commands);
+        return {};
+    }
+
+    ResultOrError<VkCommandBuffer> CommandBuffer::GetOrRecordRenderPassContents(
+        BeginRenderPassCmd* renderPassCmd,
+        size_t passIndex,
+        VkRenderPass renderPassVK) {
+        Device* device = ToBackend(GetDevice());
+
+        if (mRenderPassContents.empty()) {
+            mRenderPassContents.resize(GetResourceUsages().perPass.size());
+        }
+        if (mRenderPassContents[passIndex] != VK_NULL_HANDLE) {
+            SkipRenderPassContents();
+            return mRenderPassContents[passIndex];
+        }
+
+        if (mRenderPassContentsPool == VK_NULL_HANDLE) {
+            VkCommandPoolCreateInfo createInfo;
+            createInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+            createInfo.pNext = nullptr;
+            createInfo.flags = 0;
+            createInfo.queueFamilyIndex = device->GetGraphicsQueueFamily();
+
+            DAWN_TRY(CheckVkSuccess(device->fn.CreateCommandPool(device->GetVkDevice(), &createInfo,
+                                                                 nullptr,
+                                                                 &*mRenderPassContentsPool),
+                                    "vkCreateCommandPool"));
+        }
+
+        VkCommandBufferAllocateInfo allocateInfo;
+        allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocateInfo.pNext = nullptr;
+        allocateInfo.commandPool = mRenderPassContentsPool;
+        allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+        allocateInfo.commandBufferCount = 1;
+
+        VkCommandBuffer contents = VK_NULL_HANDLE;
+        DAWN_TRY(CheckVkSuccess(
+            device->fn.AllocateCommandBuffers(device->GetVkDevice(), &allocateInfo, &contents),
+            "vkAllocateCommandBuffers"));
+
+        // The contents only need a compatible render pass so they can be executed in the render
+        // passes of the next submits even if their load operations are different. They can be
+        // pending in several submits at once.
+        VkCommandBufferInheritanceInfo inheritanceInfo;
+        inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+        inheritanceInfo.pNext = nullptr;
+        inheritanceInfo.renderPass = renderPassVK;
+        inheritanceInfo.subpass = 0;
+        inheritanceInfo.framebuffer = VK_NULL_HANDLE;
+        inheritanceInfo.occlusionQueryEnable = VK_FALSE;
+        inheritanceInfo.queryFlags = 0;
+        inheritanceInfo.pipelineStatistics = 0;
+
+        VkCommandBufferBeginInfo beginInfo;
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.pNext = nullptr;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT |
+                          VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
+        beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+        DAWN_TRY(CheckVkSuccess(device->fn.BeginCommandBuffer(contents, &beginInfo),
+                                "vkBeginCommandBuffer"));
+
+        CommandRecordingContext contentsContext;
+        contentsContext.commandBuffer = contents;
+        RecordRenderPassContents(&contentsContext, renderPassCmd);
+
+        DAWN_TRY(CheckVkSuccess(device->fn.EndCommandBuffer(contents), "vkEndCommandBuffer"));
+
+        mRenderPassContents[passIndex] = contents;
+        return contents;
+    }
+
+    void CommandBuffer::SkipRenderPassContents() {
+        Command type;
+        while (mCommands.NextCommandId(&type)) {
+            if (type == Command::EndRenderPass) {
+                mCommands.NextCommand<EndRenderPassCmd>();
+                return;
+            }
+            SkipCommand(&mCommands, type);
+        }
+
+        // EndRenderPass should have been called
+        UNREACHABLE();
+    }
+
+    void CommandBuffer::RecordRenderPassContents(CommandRecordingContext* recordingContext,
+                                                 BeginRenderPassCmd* renderPassCmd) {
+        Device* device = ToBackend(GetDevice());
+        VkCommandBuffer commands = recordingContext->commandBuffer;
 
         // Set the default value for the dynamic state
         {
@@ -1015,11 +1315,13 @@ namespace dawn_native { namespace vulkan {
 
         RenderDescriptorSetTracker descriptorSets = {};
         RenderPipeline* lastPipeline = nullptr;
+        DrawCommandDecoder drawDecoder;
 
         auto EncodeRenderBundleCommand = [&](CommandIterator* iter, Command type) {
             switch (type) {
-                case Command::Draw: {
-                    DrawCmd* draw = iter->NextCommand<DrawCmd>();
+                case Command::Draw:
+                case Command::RepeatDraw: {
+                    DrawCmd* draw = drawDecoder.NextDraw(iter, type);
 
                     descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_GRAPHICS);
                     device->fn.CmdDraw(commands, draw->vertexCount, draw->instanceCount,
@@ -1027,8 +1329,9 @@ namespace dawn_native { namespace vulkan {
                     break;
                 }
 
-                case Command::DrawIndexed: {
-                    DrawIndexedCmd* draw = iter->NextCommand<DrawIndexedCmd>();
+                case Command::DrawIndexed:
+                case Command::RepeatDrawIndexed: {
+                    DrawIndexedCmd* draw = drawDecoder.NextDrawIndexed(iter, type);
 
                     descriptorSets.Apply(device, recordingContext, VK_PIPELINE_BIND_POINT_GRAPHICS);
                     device->fn.CmdDrawIndexed(commands, draw->indexCount, draw->instanceCount,
@@ -1111,7 +1414,7 @@ namespace dawn_native { namespace vulkan {
 
                 case Command::SetBindGroup: {
                     SetBindGroupCmd* cmd = iter->NextCommand<SetBindGroupCmd>();
-                    BindGroup* bindGroup = ToBackend(cmd->group.Get());
+                    BindGroup* bindGroup = ToBackend(cmd->group);
                     uint32_t* dynamicOffsets = nullptr;
                     if (cmd->dynamicOffsetCount > 0) {
                         dynamicOffsets = iter->NextData<uint32_t>(cmd->dynamicOffsetCount);
@@ -1138,7 +1441,7 @@ namespace dawn_native { namespace vulkan {
 
                 case Command::SetRenderPipeline: {
                     SetRenderPipelineCmd* cmd = iter->NextCommand<SetRenderPipelineCmd>();
-                    RenderPipeline* pipeline = ToBackend(cmd->pipeline).Get();
+                    RenderPipeline* pipeline = ToBackend(cmd->pipeline);
 
                     device->fn.CmdBindPipeline(commands, VK_PIPELINE_BIND_POINT_GRAPHICS,
                                                pipeline->GetHandle());
@@ -1168,8 +1471,7 @@ namespace dawn_native { namespace vulkan {
             switch (type) {
                 case Command::EndRenderPass: {
                     mCommands.NextCommand<EndRenderPassCmd>();
-                    device->fn.CmdEndRenderPass(commands);
-                    return {};
+                    return;
                 }
 
                 case Command::SetBlendColor: {
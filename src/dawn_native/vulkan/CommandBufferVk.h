@@ -21,6 +21,8 @@
 
 #include "common/vulkan_platform.h"
 
+#include <vector>
+
 namespace dawn_native {
     struct BeginRenderPassCmd;
     struct TextureCopy;
@@ -45,13 +47,32 @@ namespace dawn_native { namespace vulkan {
         void RecordComputePass(CommandRecordingContext* recordingContext);
         void RecordRayTracingPass(CommandRecordingContext* recordingContext);
         MaybeError RecordRenderPass(CommandRecordingContext* recordingContext,
-                                    BeginRenderPassCmd* renderPass);
+                                    BeginRenderPassCmd* renderPass,
+                                    size_t passIndex);
+        // Records the commands of a render pass up to its EndRenderPass, without ending the
+        // VkRenderPass.
+        void RecordRenderPassContents(CommandRecordingContext* recordingContext,
+                                      BeginRenderPassCmd* renderPass);
+        void SkipRenderPassContents();
+        // Returns the secondary command buffer with the contents of the render pass, recording it
+        // the first time the command buffer is submitted.
+        ResultOrError<VkCommandBuffer> GetOrRecordRenderPassContents(
+            BeginRenderPassCmd* renderPass,
+            size_t passIndex,
+            VkRenderPass renderPassVK);
         void RecordCopyImageWithTemporaryBuffer(CommandRecordingContext* recordingContext,
                                                 const TextureCopy& srcCopy,
                                                 const TextureCopy& dstCopy,
                                                 const Extent3D& copySize);
 
         CommandIterator mCommands;
+
+        // For reusable command buffers, the secondary command buffers with the contents of each
+        // render pass, indexed like the per-pass resource usages, and the pool they come from.
+        // The barriers, clears and framebuffers depend on the state of the resources so they are
+        // still recorded at every submit.
+        VkCommandPool mRenderPassContentsPool = VK_NULL_HANDLE;
+        std::vector<VkCommandBuffer> mRenderPassContents;
     };
 
 }}  // namespace dawn_native::vulkan
@@ -50,8 +50,8 @@ namespace dawn_native { namespace vulkan {
 
         Device* device = ToBackend(GetDevice());
         return CheckVkSuccess(
-            device->fn.CreateComputePipelines(device->GetVkDevice(), ::VK_NULL_HANDLE, 1,
-                                              &createInfo, nullptr, &*mHandle),
+            device->fn.CreateComputePipelines(device->GetVkDevice(), device->GetVkPipelineCache(),
+                                              1, &createInfo, nullptr, &*mHandle),
             "CreateComputePipeline");
     }
 
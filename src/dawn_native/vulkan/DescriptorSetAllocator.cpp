@@ -18,6 +18,8 @@
 #include "dawn_native/vulkan/DeviceVk.h"
 #include "dawn_native/vulkan/FencedDeleter.h"
 #include "dawn_native/vulkan/VulkanError.h"
+#include "dawn_platform/DawnPlatform.h"
+#include "dawn_platform/tracing/TraceEvent.h"
 
 namespace dawn_native { namespace vulkan {
 
@@ -127,6 +129,11 @@ namespace dawn_native { namespace vulkan {
     }
 
     MaybeError DescriptorSetAllocator::AllocateDescriptorPool() {
+        Device* device = ToBackend(mLayout->GetDevice());
+        TRACE_EVENT2(device->GetPlatform(), General,
+                     "DescriptorSetAllocator::AllocateDescriptorPool", "maxSets", mMaxSets,
+                     "poolCount", mDescriptorPools.size());
+
         VkDescriptorPoolCreateInfo createInfo;
         createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
         createInfo.pNext = nullptr;
@@ -135,8 +142,6 @@ namespace dawn_native { namespace vulkan {
         createInfo.poolSizeCount = static_cast<PoolIndex>(mPoolSizes.size());
         createInfo.pPoolSizes = mPoolSizes.data();
 
-        Device* device = ToBackend(mLayout->GetDevice());
-
         VkDescriptorPool descriptorPool;
         DAWN_TRY(CheckVkSuccess(device->fn.CreateDescriptorPool(device->GetVkDevice(), &createInfo,
                                                                 nullptr, &*descriptorPool),
@@ -37,11 +37,14 @@
 #include "dawn_native/vulkan/RenderPipelineVk.h"
 #include "dawn_native/vulkan/ResourceMemoryAllocatorVk.h"
 #include "dawn_native/vulkan/SamplerVk.h"
+#include "dawn_native/vulkan/ScratchBufferAllocatorVk.h"
 #include "dawn_native/vulkan/ShaderModuleVk.h"
 #include "dawn_native/vulkan/StagingBufferVk.h"
 #include "dawn_native/vulkan/SwapChainVk.h"
 #include "dawn_native/vulkan/TextureVk.h"
 #include "dawn_native/vulkan/VulkanError.h"
+#include "dawn_platform/DawnPlatform.h"
+#include "dawn_platform/tracing/TraceEvent.h"
 
 namespace dawn_native { namespace vulkan {
 
@@ -87,6 +90,9 @@ namespace dawn_native { namespace vulkan {
 
         mRenderPassCache = std::make_unique<RenderPassCache>(this);
         mResourceMemoryAllocator = std::make_unique<ResourceMemoryAllocator>(this);
+        mScratchBufferAllocator = std::make_unique<ScratchBufferAllocator>(this);
+
+        DAWN_TRY(CreatePipelineCache());
 
         mExternalMemoryService = std::make_unique<external_memory::Service>(this);
         mExternalSemaphoreService = std::make_unique<external_semaphore::Service>(this);
@@ -170,20 +176,31 @@ namespace dawn_native { namespace vulkan {
         return TextureView::Create(texture, descriptor);
     }
 
+    bool Device::CanCreatePipelinesOnWorkerThreads() const {
+        // Compute and render pipelines only use immutable handles of their layout and shaders,
+        // the render pass cache is locked, and VkPipelineCache is internally synchronized.
+        return true;
+    }
+
     MaybeError Device::TickImpl() {
         CheckPassedSerials();
         RecycleCompletedCommands();
 
         Serial completedSerial = GetCompletedCommandSerial();
 
-        for (Ref<BindGroupLayout>& bgl :
-             mBindGroupLayoutsPendingDeallocation.IterateUpTo(completedSerial)) {
-            bgl->FinishDeallocation(completedSerial);
-        }
-        mBindGroupLayoutsPendingDeallocation.ClearUpTo(completedSerial);
+        {
+            TRACE_EVENT1(GetPlatform(), General, "DeviceVk::DeallocateCompletedResources",
+                         "completedSerial", completedSerial);
+            for (Ref<BindGroupLayout>& bgl :
+                 mBindGroupLayoutsPendingDeallocation.IterateUpTo(completedSerial)) {
+                bgl->FinishDeallocation(completedSerial);
+            }
+            mBindGroupLayoutsPendingDeallocation.ClearUpTo(completedSerial);
 
-        mResourceMemoryAllocator->Tick(completedSerial);
-        mDeleter->Tick(completedSerial);
+            mScratchBufferAllocator->Deallocate(completedSerial);
+            mResourceMemoryAllocator->Tick(completedSerial);
+            mDeleter->Tick(completedSerial);
+        }
 
         if (mRecordingContext.used) {
             DAWN_TRY(SubmitPendingCommands());
@@ -219,6 +236,14 @@ namespace dawn_native { namespace vulkan {
         return mDeleter.get();
     }
 
+    ScratchBufferAllocator* Device::GetScratchBufferAllocator() const {
+        return mScratchBufferAllocator.get();
+    }
+
+    VkPipelineCache Device::GetVkPipelineCache() const {
+        return mPipelineCache;
+    }
+
     RenderPassCache* Device::GetRenderPassCache() const {
         return mRenderPassCache.get();
     }
@@ -237,6 +262,7 @@ namespace dawn_native { namespace vulkan {
         if (!mRecordingContext.used) {
             return {};
         }
+        TRACE_EVENT0(GetPlatform(), General, "DeviceVk::SubmitPendingCommands");
 
         DAWN_TRY(CheckVkSuccess(fn.EndCommandBuffer(mRecordingContext.commandBuffer),
                                 "vkEndCommandBuffer"));
@@ -261,14 +287,16 @@ namespace dawn_native { namespace vulkan {
         DAWN_TRY_ASSIGN(fence, GetUnusedFence());
         DAWN_TRY(CheckVkSuccess(fn.QueueSubmit(mQueue, 1, &submitInfo, fence), "vkQueueSubmit"));
 
-        // Enqueue the semaphores before incrementing the serial, so that they can be deleted as
-        // soon as the current submission is finished.
+        // Enqueue the semaphores, and the handles released since the last submit, before
+        // incrementing the serial, so that they can be deleted as soon as the current submission
+        // is finished.
         for (VkSemaphore semaphore : mRecordingContext.waitSemaphores) {
             mDeleter->DeleteWhenUnused(semaphore);
         }
         for (VkSemaphore semaphore : mRecordingContext.signalSemaphores) {
             mDeleter->DeleteWhenUnused(semaphore);
         }
+        mDeleter->EnqueueReleasedHandles();
 
         IncrementLastSubmittedCommandSerial();
         Serial lastSubmittedSerial = GetLastSubmittedCommandSerial();
@@ -792,6 +820,12 @@ namespace dawn_native { namespace vulkan {
         return mResourceMemoryAllocator.get();
     }
 
+    void Device::FillStatisticsImpl(DeviceStatistics* statistics) const {
+        statistics->allocatedMemorySize = mResourceMemoryAllocator->GetAllocatedMemorySize();
+        statistics->pendingDeletionCount = mDeleter->GetPendingDeletionCount() +
+                                           mResourceMemoryAllocator->GetPendingDeallocationCount();
+    }
+
     MaybeError Device::WaitForIdleForDestruction() {
         VkResult waitIdleResult = VkResult::WrapUnsafe(fn.QueueWaitIdle(mQueue));
         // Ignore the result of QueueWaitIdle: it can return OOM which we can't really do anything
@@ -824,6 +858,45 @@ namespace dawn_native { namespace vulkan {
         return {};
     }
 
+    PersistentCacheKey Device::CreatePipelineCacheKey() const {
+        // Drivers also reject initial data from other drivers, but the key makes sure that a
+        // driver update doesn't leave the stale data in the persistent cache forever.
+        PersistentCacheKeyRecorder recorder(this, PersistentKeyType::PipelineCache);
+        recorder.Record(mDeviceInfo.properties.pipelineCacheUUID)
+            .Record(mDeviceInfo.properties.driverVersion);
+        return recorder.GetKey();
+    }
+
+    MaybeError Device::CreatePipelineCache() {
+        ScopedCachedBlob initialData = GetPersistentCache()->LoadData(CreatePipelineCacheKey());
+
+        VkPipelineCacheCreateInfo createInfo;
+        createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        createInfo.pNext = nullptr;
+        createInfo.flags = 0;
+        createInfo.initialDataSize = initialData.bufferSize;
+        createInfo.pInitialData = initialData.buffer.get();
+
+        return CheckVkSuccess(
+            fn.CreatePipelineCache(mVkDevice, &createInfo, nullptr, &*mPipelineCache),
+            "vkCreatePipelineCache");
+    }
+
+    void Device::StorePipelineCache() {
+        size_t dataSize = 0;
+        if (fn.GetPipelineCacheData(mVkDevice, mPipelineCache, &dataSize, nullptr) != VK_SUCCESS ||
+            dataSize == 0) {
+            return;
+        }
+
+        std::vector<uint8_t> data(dataSize);
+        if (fn.GetPipelineCacheData(mVkDevice, mPipelineCache, &dataSize, data.data()) !=
+            VK_SUCCESS) {
+            return;
+        }
+        GetPersistentCache()->StoreData(CreatePipelineCacheKey(), data.data(), dataSize);
+    }
+
     void Device::ShutDownImpl() {
         ASSERT(GetState() == State::Disconnected);
 
@@ -879,14 +952,23 @@ namespace dawn_native { namespace vulkan {
         }
         mUnusedFences.clear();
 
-        // Releasing the uploader enqueues buffers to be released.
+        // Releasing the uploader and the scratch buffers enqueues buffers to be released.
         // Call Tick() again to clear them before releasing the deleter.
+        mScratchBufferAllocator = nullptr;
         mDeleter->Tick(GetCompletedCommandSerial());
 
         // The VkRenderPasses in the cache can be destroyed immediately since all commands referring
         // to them are guaranteed to be finished executing.
         mRenderPassCache = nullptr;
 
+        // Pipelines only read the VkPipelineCache while they are being created, so it can be
+        // destroyed immediately as well.
+        if (mPipelineCache != VK_NULL_HANDLE) {
+            StorePipelineCache();
+            fn.DestroyPipelineCache(mVkDevice, mPipelineCache, nullptr);
+            mPipelineCache = VK_NULL_HANDLE;
+        }
+
         // We need handle deleting all child objects by calling Tick() again with a large serial to
         // force all operations to look as if they were completed, and delete all objects before
         // destroying the Deleter and vkDevice.
@@ -21,6 +21,7 @@
 #include "common/Serial.h"
 #include "common/SerialQueue.h"
 #include "dawn_native/Device.h"
+#include "dawn_native/PersistentCache.h"
 #include "dawn_native/dawn_platform.h"
 #include "dawn_native/vulkan/CommandRecordingContext.h"
 #include "dawn_native/vulkan/Forward.h"
@@ -37,6 +38,7 @@ namespace dawn_native { namespace vulkan {
     class FencedDeleter;
     class RenderPassCache;
     class ResourceMemoryAllocator;
+    class ScratchBufferAllocator;
 
     class Device : public DeviceBase {
       public:
@@ -53,10 +55,12 @@ namespace dawn_native { namespace vulkan {
         VkDevice GetVkDevice() const;
         uint32_t GetGraphicsQueueFamily() const;
         VkQueue GetQueue() const;
+        VkPipelineCache GetVkPipelineCache() const;
 
         BufferUploader* GetBufferUploader() const;
         FencedDeleter* GetFencedDeleter() const;
         RenderPassCache* GetRenderPassCache() const;
+        ScratchBufferAllocator* GetScratchBufferAllocator() const;
 
         CommandRecordingContext* GetPendingRecordingContext();
         MaybeError SubmitPendingCommands();
@@ -78,6 +82,7 @@ namespace dawn_native { namespace vulkan {
                                                const CommandBufferDescriptor* descriptor) override;
 
         MaybeError TickImpl() override;
+        bool CanCreatePipelinesOnWorkerThreads() const override;
 
         ResultOrError<std::unique_ptr<StagingBufferBase>> CreateStagingBuffer(size_t size) override;
         MaybeError CopyFromStagingToBuffer(StagingBufferBase* source,
@@ -136,8 +141,15 @@ namespace dawn_native { namespace vulkan {
         void InitTogglesFromDriver();
         void ApplyDepth24PlusS8Toggle();
 
+        // The VkPipelineCache is seeded from the device's persistent cache and written back to
+        // it when the device is destroyed, so that pipelines are reused across runs.
+        PersistentCacheKey CreatePipelineCacheKey() const;
+        MaybeError CreatePipelineCache();
+        void StorePipelineCache();
+
         void ShutDownImpl() override;
         MaybeError WaitForIdleForDestruction() override;
+        void FillStatisticsImpl(DeviceStatistics* statistics) const override;
 
         // To make it easier to use fn it is a public const member. However
         // the Device is allowed to mutate them through these private methods.
@@ -145,6 +157,7 @@ namespace dawn_native { namespace vulkan {
 
         VulkanDeviceInfo mDeviceInfo = {};
         VkDevice mVkDevice = VK_NULL_HANDLE;
+        VkPipelineCache mPipelineCache = VK_NULL_HANDLE;
         uint32_t mQueueFamily = 0;
         VkQueue mQueue = VK_NULL_HANDLE;
 
@@ -152,6 +165,7 @@ namespace dawn_native { namespace vulkan {
         std::unique_ptr<FencedDeleter> mDeleter;
         std::unique_ptr<ResourceMemoryAllocator> mResourceMemoryAllocator;
         std::unique_ptr<RenderPassCache> mRenderPassCache;
+        std::unique_ptr<ScratchBufferAllocator> mScratchBufferAllocator;
 
         std::unique_ptr<external_memory::Service> mExternalMemoryService;
         std::unique_ptr<external_semaphore::Service> mExternalSemaphoreService;
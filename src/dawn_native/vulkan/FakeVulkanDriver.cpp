@@ -0,0 +1,2074 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/vulkan/FakeVulkanDriver.h"
+
+#include "common/Assert.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <vector>
+
+// The entry points are defined outside of dawn_native::vulkan so that they use the native
+// non-dispatchable handle types, like the PFN_vk* types they are cast to.
+namespace {
+
+    // The device-level entry points, for which the fake driver records call counts.
+#define FAKE_DEVICE_ENTRY_POINTS(X)                  \
+    X(AllocateCommandBuffers)                        \
+    X(AllocateDescriptorSets)                        \
+    X(AllocateMemory)                                \
+    X(BeginCommandBuffer)                            \
+    X(BindAccelerationStructureMemoryKHR)            \
+    X(BindBufferMemory)                              \
+    X(BindImageMemory)                               \
+    X(CmdBeginQuery)                                 \
+    X(CmdBeginRenderPass)                            \
+    X(CmdBindDescriptorSets)                         \
+    X(CmdBindIndexBuffer)                            \
+    X(CmdBindPipeline)                               \
+    X(CmdBindVertexBuffers)                          \
+    X(CmdBlitImage)                                  \
+    X(CmdBuildAccelerationStructureKHR)              \
+    X(CmdClearAttachments)                           \
+    X(CmdClearColorImage)                            \
+    X(CmdClearDepthStencilImage)                     \
+    X(CmdCopyAccelerationStructureKHR)               \
+    X(CmdCopyBuffer)                                 \
+    X(CmdCopyBufferToImage)                          \
+    X(CmdCopyImage)                                  \
+    X(CmdCopyImageToBuffer)                          \
+    X(CmdCopyQueryPoolResults)                       \
+    X(CmdDispatch)                                   \
+    X(CmdDispatchIndirect)                           \
+    X(CmdDraw)                                       \
+    X(CmdDrawIndexed)                                \
+    X(CmdDrawIndexedIndirect)                        \
+    X(CmdDrawIndirect)                               \
+    X(CmdEndQuery)                                   \
+    X(CmdEndRenderPass)                              \
+    X(CmdExecuteCommands)                            \
+    X(CmdFillBuffer)                                 \
+    X(CmdNextSubpass)                                \
+    X(CmdPipelineBarrier)                            \
+    X(CmdPushConstants)                              \
+    X(CmdResetEvent)                                 \
+    X(CmdResetQueryPool)                             \
+    X(CmdResolveImage)                               \
+    X(CmdSetBlendConstants)                          \
+    X(CmdSetDepthBias)                               \
+    X(CmdSetDepthBounds)                             \
+    X(CmdSetEvent)                                   \
+    X(CmdSetLineWidth)                               \
+    X(CmdSetScissor)                                 \
+    X(CmdSetStencilCompareMask)                      \
+    X(CmdSetStencilReference)                        \
+    X(CmdSetStencilWriteMask)                        \
+    X(CmdSetViewport)                                \
+    X(CmdTraceRaysKHR)                               \
+    X(CmdUpdateBuffer)                               \
+    X(CmdWaitEvents)                                 \
+    X(CmdWriteAccelerationStructuresPropertiesKHR)   \
+    X(CmdWriteTimestamp)                             \
+    X(CreateAccelerationStructureKHR)                \
+    X(CreateBuffer)                                  \
+    X(CreateBufferView)                              \
+    X(CreateCommandPool)                             \
+    X(CreateComputePipelines)                        \
+    X(CreateDescriptorPool)                          \
+    X(CreateDescriptorSetLayout)                     \
+    X(CreateEvent)                                   \
+    X(CreateFence)                                   \
+    X(CreateFramebuffer)                             \
+    X(CreateGraphicsPipelines)                       \
+    X(CreateImage)                                   \
+    X(CreateImageView)                               \
+    X(CreatePipelineCache)                           \
+    X(CreatePipelineLayout)                          \
+    X(CreateQueryPool)                               \
+    X(CreateRayTracingPipelinesKHR)                  \
+    X(CreateRenderPass)                              \
+    X(CreateSampler)                                 \
+    X(CreateSemaphore)                               \
+    X(CreateShaderModule)                            \
+    X(DestroyAccelerationStructureKHR)               \
+    X(DestroyBuffer)                                 \
+    X(DestroyBufferView)                             \
+    X(DestroyCommandPool)                            \
+    X(DestroyDescriptorPool)                         \
+    X(DestroyDescriptorSetLayout)                    \
+    X(DestroyEvent)                                  \
+    X(DestroyFence)                                  \
+    X(DestroyFramebuffer)                            \
+    X(DestroyImage)                                  \
+    X(DestroyImageView)                              \
+    X(DestroyPipeline)                               \
+    X(DestroyPipelineCache)                          \
+    X(DestroyPipelineLayout)                         \
+    X(DestroyQueryPool)                              \
+    X(DestroyRenderPass)                             \
+    X(DestroySampler)                                \
+    X(DestroySemaphore)                              \
+    X(DestroyShaderModule)                           \
+    X(DeviceWaitIdle)                                \
+    X(EndCommandBuffer)                              \
+    X(FlushMappedMemoryRanges)                       \
+    X(FreeCommandBuffers)                            \
+    X(FreeDescriptorSets)                            \
+    X(FreeMemory)                                    \
+    X(GetAccelerationStructureDeviceAddressKHR)      \
+    X(GetAccelerationStructureMemoryRequirementsKHR) \
+    X(GetBufferDeviceAddressKHR)                     \
+    X(GetBufferMemoryRequirements)                   \
+    X(GetBufferMemoryRequirements2)                  \
+    X(GetDeviceMemoryCommitment)                     \
+    X(GetDeviceQueue)                                \
+    X(GetEventStatus)                                \
+    X(GetFenceStatus)                                \
+    X(GetImageMemoryRequirements)                    \
+    X(GetImageSparseMemoryRequirements)              \
+    X(GetImageSubresourceLayout)                     \
+    X(GetPipelineCacheData)                          \
+    X(GetQueryPoolResults)                           \
+    X(GetRayTracingShaderGroupHandlesKHR)            \
+    X(GetRenderAreaGranularity)                      \
+    X(InvalidateMappedMemoryRanges)                  \
+    X(MapMemory)                                     \
+    X(MergePipelineCaches)                           \
+    X(QueueBindSparse)                               \
+    X(QueueSubmit)                                   \
+    X(QueueWaitIdle)                                 \
+    X(ResetCommandBuffer)                            \
+    X(ResetCommandPool)                              \
+    X(ResetDescriptorPool)                           \
+    X(ResetEvent)                                    \
+    X(ResetFences)                                   \
+    X(SetEvent)                                      \
+    X(UnmapMemory)                                   \
+    X(UpdateDescriptorSets)                          \
+    X(WaitForFences)
+
+    enum class EntryPoint : uint32_t {
+#define FAKE_ENTRY_POINT_ENUM(name) name,
+        FAKE_DEVICE_ENTRY_POINTS(FAKE_ENTRY_POINT_ENUM)
+#undef FAKE_ENTRY_POINT_ENUM
+    };
+
+    constexpr const char* kEntryPointNames[] = {
+#define FAKE_ENTRY_POINT_NAME(name) "vk" #name,
+        FAKE_DEVICE_ENTRY_POINTS(FAKE_ENTRY_POINT_NAME)
+#undef FAKE_ENTRY_POINT_NAME
+    };
+    constexpr size_t kEntryPointCount = sizeof(kEntryPointNames) / sizeof(kEntryPointNames[0]);
+
+    // The properties of the fake physical device.
+    constexpr uint32_t kMemoryTypeBits = 1;
+    constexpr VkDeviceSize kHeapSize = 64ull * 1024ull * 1024ull * 1024ull;
+    constexpr VkDeviceSize kResourceAlignment = 256;
+    // Images are given enough memory for any format, and mipmaps.
+    constexpr VkDeviceSize kMaxTexelBlockSize = 16;
+    // Acceleration structures are given memory for one node per primitive.
+    constexpr VkDeviceSize kAccelerationStructureNodeSize = 64;
+    constexpr uint32_t kShaderGroupHandleSize = 32;
+
+    struct ExtensionInfo {
+        const char* name;
+        uint32_t specVersion;
+    };
+
+    // KHR_get_physical_device_properties2 is needed to query the ray tracing properties.
+    constexpr ExtensionInfo kInstanceExtensions[] = {
+        {VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME,
+         VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_SPEC_VERSION},
+    };
+
+    // KHR_maintenance1 is required by the backend, and the other extensions are the ones it
+    // requires for KHR_ray_tracing. Apart from the entry points of KHR_ray_tracing and
+    // KHR_buffer_device_address, they only add behavior that the fake driver doesn't have to do
+    // anything for.
+    constexpr ExtensionInfo kDeviceExtensions[] = {
+        {VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME, VK_EXT_DESCRIPTOR_INDEXING_SPEC_VERSION},
+        {VK_KHR_BUFFER_DEVICE_ADDRESS_EXTENSION_NAME, VK_KHR_BUFFER_DEVICE_ADDRESS_SPEC_VERSION},
+        {VK_KHR_DEFERRED_HOST_OPERATIONS_EXTENSION_NAME,
+         VK_KHR_DEFERRED_HOST_OPERATIONS_SPEC_VERSION},
+        {VK_KHR_GET_MEMORY_REQUIREMENTS_2_EXTENSION_NAME,
+         VK_KHR_GET_MEMORY_REQUIREMENTS_2_SPEC_VERSION},
+        {VK_KHR_MAINTENANCE1_EXTENSION_NAME, VK_KHR_MAINTENANCE1_SPEC_VERSION},
+        {VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME, VK_KHR_PIPELINE_LIBRARY_SPEC_VERSION},
+        {VK_KHR_RAY_TRACING_EXTENSION_NAME, VK_KHR_RAY_TRACING_SPEC_VERSION},
+    };
+
+    // Counters of FakeDriverStatistics that can be updated concurrently.
+    struct AtomicStatistics {
+        std::atomic<uint64_t> queueSubmitCount{0};
+        std::atomic<uint64_t> submittedCommandBufferCount{0};
+        std::atomic<uint64_t> pipelineBarrierCount{0};
+        std::atomic<uint64_t> memoryBarrierCount{0};
+        std::atomic<uint64_t> bufferMemoryBarrierCount{0};
+        std::atomic<uint64_t> imageMemoryBarrierCount{0};
+        std::atomic<uint64_t> descriptorSetAllocationCount{0};
+        std::atomic<uint64_t> descriptorWriteCount{0};
+        std::atomic<uint64_t> descriptorCopyCount{0};
+        std::atomic<uint64_t> memoryAllocationCount{0};
+        std::atomic<uint64_t> memoryAllocationSize{0};
+        std::atomic<uint64_t> liveMemorySize{0};
+        std::atomic<uint64_t> liveObjectCount{0};
+        std::atomic<uint64_t> renderPassCount{0};
+        std::atomic<uint64_t> drawCount{0};
+        std::atomic<uint64_t> dispatchCount{0};
+        std::atomic<uint64_t> copyCount{0};
+    };
+
+    void Add(std::atomic<uint64_t>* counter, uint64_t value) {
+        counter->fetch_add(value, std::memory_order_relaxed);
+    }
+
+    void Subtract(std::atomic<uint64_t>* counter, uint64_t value) {
+        counter->fetch_sub(value, std::memory_order_relaxed);
+    }
+
+    uint64_t Load(const std::atomic<uint64_t>& counter) {
+        return counter.load(std::memory_order_relaxed);
+    }
+
+    void Store(std::atomic<uint64_t>* counter, uint64_t value) {
+        counter->store(value, std::memory_order_relaxed);
+    }
+
+    struct FakeDevice;
+
+    struct FakePhysicalDevice {};
+
+    struct FakeInstance {
+        FakePhysicalDevice physicalDevice;
+    };
+
+    struct FakeQueue {
+        FakeDevice* device;
+    };
+
+    struct FakeDevice {
+        FakeDevice() : queue{this} {
+        }
+
+        void Record(EntryPoint entryPoint) {
+            Add(&callCounts[static_cast<uint32_t>(entryPoint)], 1);
+        }
+
+        FakeQueue queue;
+        std::array<std::atomic<uint64_t>, kEntryPointCount> callCounts = {};
+        AtomicStatistics statistics;
+    };
+
+    // Objects that don't have any state. They are still allocated so that they get unique
+    // handles.
+    struct FakeObject {};
+
+    struct FakeBuffer {
+        VkDeviceSize size;
+    };
+
+    struct FakeImage {
+        VkDeviceSize size;
+    };
+
+    struct FakeMemory {
+        VkDeviceSize size;
+        // Only allocated when the memory is mapped.
+        std::unique_ptr<uint8_t[]> data;
+    };
+
+    struct FakeCommandBuffer {
+        FakeDevice* device;
+    };
+
+    struct FakeCommandPool {
+        std::vector<std::unique_ptr<FakeCommandBuffer>> commandBuffers;
+    };
+
+    struct FakeDescriptorPool {
+        std::vector<std::unique_ptr<FakeObject>> descriptorSets;
+    };
+
+    // Query results are written when their command is recorded since no work is ever pending.
+    struct FakeQueryPool {
+        explicit FakeQueryPool(uint32_t queryCount)
+            : results(new std::atomic<uint64_t>[queryCount]()) {
+        }
+
+        std::unique_ptr<std::atomic<uint64_t>[]> results;
+    };
+
+    struct FakeAccelerationStructure {
+        VkDeviceSize size;
+    };
+
+    // Non-dispatchable handles are 64-bit on all platforms, either as pointers or integers.
+    template <typename Handle, typename Object>
+    Handle ToHandle(Object* object) {
+        static_assert(sizeof(Handle) == sizeof(uint64_t), "");
+        uint64_t value = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(object));
+        Handle handle;
+        memcpy(&handle, &value, sizeof(handle));
+        return handle;
+    }
+
+    template <typename Object, typename Handle>
+    Object* FromHandle(Handle handle) {
+        static_assert(sizeof(Handle) == sizeof(uint64_t), "");
+        uint64_t value;
+        memcpy(&value, &handle, sizeof(value));
+        return reinterpret_cast<Object*>(static_cast<uintptr_t>(value));
+    }
+
+    FakeDevice* FromDevice(VkDevice device) {
+        return reinterpret_cast<FakeDevice*>(device);
+    }
+
+    FakeDevice* FromCommandBuffer(VkCommandBuffer commandBuffer) {
+        return reinterpret_cast<FakeCommandBuffer*>(commandBuffer)->device;
+    }
+
+    FakeDevice* FromQueue(VkQueue queue) {
+        return reinterpret_cast<FakeQueue*>(queue)->device;
+    }
+
+    VkDeviceSize AlignResourceSize(VkDeviceSize size) {
+        return std::max(kResourceAlignment,
+                        (size + kResourceAlignment - 1) & ~(kResourceAlignment - 1));
+    }
+
+    VkMemoryRequirements MakeMemoryRequirements(VkDeviceSize size) {
+        VkMemoryRequirements requirements;
+        requirements.size = size;
+        requirements.alignment = kResourceAlignment;
+        requirements.memoryTypeBits = kMemoryTypeBits;
+        return requirements;
+    }
+
+    // Implements the two-call idiom of the vkEnumerate* and vkGet* entry points that return
+    // arrays.
+    template <typename T>
+    VkResult ReturnArray(const T* values, uint32_t valueCount, uint32_t* pCount, T* pValues) {
+        if (pValues == nullptr) {
+            *pCount = valueCount;
+            return VK_SUCCESS;
+        }
+
+        uint32_t count = std::min(*pCount, valueCount);
+        std::copy(values, values + count, pValues);
+        *pCount = count;
+        return count < valueCount ? VK_INCOMPLETE : VK_SUCCESS;
+    }
+
+    template <size_t kExtensionCount>
+    VkResult ReturnExtensions(const ExtensionInfo (&extensions)[kExtensionCount],
+                              uint32_t* pPropertyCount,
+                              VkExtensionProperties* pProperties) {
+        std::array<VkExtensionProperties, kExtensionCount> properties = {};
+        for (size_t i = 0; i < kExtensionCount; ++i) {
+            strncpy(properties[i].extensionName, extensions[i].name,
+                    VK_MAX_EXTENSION_NAME_SIZE - 1);
+            properties[i].specVersion = extensions[i].specVersion;
+        }
+        return ReturnArray(properties.data(), static_cast<uint32_t>(kExtensionCount),
+                           pPropertyCount, pProperties);
+    }
+
+    template <size_t kExtensionCount>
+    bool HasExtensions(const ExtensionInfo (&extensions)[kExtensionCount],
+                       uint32_t nameCount,
+                       const char* const* names) {
+        for (uint32_t i = 0; i < nameCount; ++i) {
+            if (std::none_of(extensions, extensions + kExtensionCount,
+                             [&](const ExtensionInfo& extension) {
+                                 return strcmp(extension.name, names[i]) == 0;
+                             })) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Returns the structure of type |sType| in the pNext chain |next|, or nullptr. The fake
+    // driver leaves the other structures untouched since it doesn't support their extensions.
+    template <typename T>
+    T* FindInChain(void* next, VkStructureType sType) {
+        for (VkBaseOutStructure* structure = static_cast<VkBaseOutStructure*>(next);
+             structure != nullptr; structure = structure->pNext) {
+            if (structure->sType == sType) {
+                return reinterpret_cast<T*>(structure);
+            }
+        }
+        return nullptr;
+    }
+
+    // Creates objects for the vkCreate* entry points that only return a handle.
+    template <EntryPoint kEntryPoint, typename CreateInfo, typename Handle>
+    VKAPI_ATTR VkResult VKAPI_CALL CreateObject(VkDevice device,
+                                                const CreateInfo*,
+                                                const VkAllocationCallbacks*,
+                                                Handle* pHandle) {
+        FakeDevice* fakeDevice = FromDevice(device);
+        fakeDevice->Record(kEntryPoint);
+        Add(&fakeDevice->statistics.liveObjectCount, 1);
+        *pHandle = ToHandle<Handle>(new FakeObject);
+        return VK_SUCCESS;
+    }
+
+    template <EntryPoint kEntryPoint, typename Object, typename Handle>
+    VKAPI_ATTR void VKAPI_CALL DestroyObject(VkDevice device,
+                                             Handle handle,
+                                             const VkAllocationCallbacks*) {
+        FakeDevice* fakeDevice = FromDevice(device);
+        fakeDevice->Record(kEntryPoint);
+
+        Object* object = FromHandle<Object>(handle);
+        if (object == nullptr) {
+            return;
+        }
+        Subtract(&fakeDevice->statistics.liveObjectCount, 1);
+        delete object;
+    }
+
+    template <typename CreateInfo>
+    VkResult CreatePipelines(FakeDevice* device,
+                             uint32_t createInfoCount,
+                             const CreateInfo*,
+                             VkPipeline* pPipelines) {
+        Add(&device->statistics.liveObjectCount, createInfoCount);
+        for (uint32_t i = 0; i < createInfoCount; ++i) {
+            pPipelines[i] = ToHandle<VkPipeline>(new FakeObject);
+        }
+        return VK_SUCCESS;
+    }
+
+    // Global and instance entry points
+
+    VKAPI_ATTR VkResult VKAPI_CALL vkCreateInstance(const VkInstanceCreateInfo* pCreateInfo,
+                                                    const VkAllocationCallbacks*,
+                                                    VkInstance* pInstance) {
+        // The fake driver doesn't have any layers.
+        if (pCreateInfo->enabledLayerCount != 0) {
+            return VK_ERROR_LAYER_NOT_PRESENT;
+        }
+        if (!HasExtensions(kInstanceExtensions, pCreateInfo->enabledExtensionCount,
+                           pCreateInfo->ppEnabledExtensionNames)) {
+            return VK_ERROR_EXTENSION_NOT_PRESENT;
+        }
+
+        *pInstance = reinterpret_cast<VkInstance>(new FakeInstance);
+        return VK_SUCCESS;
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkDestroyInstance(VkInstance instance,
+                                                 const VkAllocationCallbacks*) {
+        delete reinterpret_cast<FakeInstance*>(instance);
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL
+    vkEnumerateInstanceExtensionProperties(const char* pLayerName,
+                                           uint32_t* pPropertyCount,
+                                           VkExtensionProperties* pProperties) {
+        if (pLayerName != nullptr) {
+            return VK_ERROR_LAYER_NOT_PRESENT;
+        }
+        return ReturnExtensions(kInstanceExtensions, pPropertyCount, pProperties);
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL vkEnumerateInstanceLayerProperties(
+        uint32_t* pPropertyCount,
+        VkLayerProperties* pProperties) {
+        return ReturnArray<VkLayerProperties>(nullptr, 0, pPropertyCount, pProperties);
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL
+    vkEnumeratePhysicalDevices(VkInstance instance,
+                               uint32_t* pPhysicalDeviceCount,
+                               VkPhysicalDevice* pPhysicalDevices) {
+        VkPhysicalDevice physicalDevice = reinterpret_cast<VkPhysicalDevice>(
+            &reinterpret_cast<FakeInstance*>(instance)->physicalDevice);
+        return ReturnArray(&physicalDevice, 1, pPhysicalDeviceCount, pPhysicalDevices);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkGetPhysicalDeviceFeatures(VkPhysicalDevice,
+                                                           VkPhysicalDeviceFeatures* pFeatures) {
+        // VkPhysicalDeviceFeatures only contains VkBool32 members, enable all of them.
+        static_assert(sizeof(VkPhysicalDeviceFeatures) % sizeof(VkBool32) == 0, "");
+        VkBool32* features = reinterpret_cast<VkBool32*>(pFeatures);
+        std::fill(features, features + sizeof(VkPhysicalDeviceFeatures) / sizeof(VkBool32),
+                  VK_TRUE);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL
+    vkGetPhysicalDeviceFormatProperties(VkPhysicalDevice,
+                                        VkFormat,
+                                        VkFormatProperties* pFormatProperties) {
+        constexpr VkFormatFeatureFlags kAllFeatures = ~VkFormatFeatureFlags(0);
+        pFormatProperties->linearTilingFeatures = kAllFeatures;
+        pFormatProperties->optimalTilingFeatures = kAllFeatures;
+        pFormatProperties->bufferFeatures = kAllFeatures;
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL
+    vkGetPhysicalDeviceImageFormatProperties(VkPhysicalDevice,
+                                             VkFormat,
+                                             VkImageType,
+                                             VkImageTiling,
+                                             VkImageUsageFlags,
+                                             VkImageCreateFlags,
+                                             VkImageFormatProperties* pImageFormatProperties) {
+        pImageFormatProperties->maxExtent = {16384, 16384, 2048};
+        pImageFormatProperties->maxMipLevels = 15;
+        pImageFormatProperties->maxArrayLayers = 2048;
+        pImageFormatProperties->sampleCounts = VK_SAMPLE_COUNT_1_BIT | VK_SAMPLE_COUNT_4_BIT;
+        pImageFormatProperties->maxResourceSize = kHeapSize;
+        return VK_SUCCESS;
+    }
+
+    VKAPI_ATTR void VKAPI_CALL
+    vkGetPhysicalDeviceMemoryProperties(VkPhysicalDevice,
+                                        VkPhysicalDeviceMemoryProperties* pMemoryProperties) {
+        *pMemoryProperties = {};
+        pMemoryProperties->memoryTypeCount = 1;
+        pMemoryProperties->memoryTypes[0].propertyFlags =
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+            VK_MEMORY_PROPERTY_HOST_COHERENT_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+        pMemoryProperties->memoryTypes[0].heapIndex = 0;
+        pMemoryProperties->memoryHeapCount = 1;
+        pMemoryProperties->memoryHeaps[0].size = kHeapSize;
+        pMemoryProperties->memoryHeaps[0].flags = VK_MEMORY_HEAP_DEVICE_LOCAL_BIT;
+    }
+
+    VKAPI_ATTR void VKAPI_CALL
+    vkGetPhysicalDeviceProperties(VkPhysicalDevice, VkPhysicalDeviceProperties* pProperties) {
+        *pProperties = {};
+        pProperties->apiVersion = VK_MAKE_VERSION(1, 0, 0);
+        pProperties->driverVersion = 1;
+        pProperties->deviceType = VK_PHYSICAL_DEVICE_TYPE_CPU;
+        strncpy(pProperties->deviceName, "Dawn Fake Vulkan Driver",
+                VK_MAX_PHYSICAL_DEVICE_NAME_SIZE - 1);
+
+        VkPhysicalDeviceLimits* limits = &pProperties->limits;
+        limits->maxImageDimension1D = 16384;
+        limits->maxImageDimension2D = 16384;
+        limits->maxImageDimension3D = 2048;
+        limits->maxImageDimensionCube = 16384;
+        limits->maxImageArrayLayers = 2048;
+        limits->maxTexelBufferElements = 1u << 27;
+        limits->maxUniformBufferRange = 65536;
+        limits->maxStorageBufferRange = 1u << 30;
+        limits->maxPushConstantsSize = 128;
+        limits->maxMemoryAllocationCount = 1u << 20;
+        limits->maxSamplerAllocationCount = 1u << 20;
+        limits->bufferImageGranularity = 1;
+        limits->maxBoundDescriptorSets = 8;
+        limits->maxPerStageDescriptorSamplers = 1u << 20;
+        limits->maxPerStageDescriptorUniformBuffers = 1u << 20;
+        limits->maxPerStageDescriptorStorageBuffers = 1u << 20;
+        limits->maxPerStageDescriptorSampledImages = 1u << 20;
+        limits->maxPerStageDescriptorStorageImages = 1u << 20;
+        limits->maxPerStageResources = 1u << 20;
+        limits->maxDescriptorSetSamplers = 1u << 20;
+        limits->maxDescriptorSetUniformBuffers = 1u << 20;
+        limits->maxDescriptorSetUniformBuffersDynamic = 8;
+        limits->maxDescriptorSetStorageBuffers = 1u << 20;
+        limits->maxDescriptorSetStorageBuffersDynamic = 4;
+        limits->maxDescriptorSetSampledImages = 1u << 20;
+        limits->maxDescriptorSetStorageImages = 1u << 20;
+        limits->maxVertexInputAttributes = 32;
+        limits->maxVertexInputBindings = 32;
+        limits->maxVertexInputAttributeOffset = 2047;
+        limits->maxVertexInputBindingStride = 2048;
+        limits->maxVertexOutputComponents = 128;
+        limits->maxFragmentInputComponents = 128;
+        limits->maxFragmentOutputAttachments = 8;
+        limits->maxComputeSharedMemorySize = 32768;
+        limits->maxComputeWorkGroupCount[0] = 65535;
+        limits->maxComputeWorkGroupCount[1] = 65535;
+        limits->maxComputeWorkGroupCount[2] = 65535;
+        limits->maxComputeWorkGroupInvocations = 1024;
+        limits->maxComputeWorkGroupSize[0] = 1024;
+        limits->maxComputeWorkGroupSize[1] = 1024;
+        limits->maxComputeWorkGroupSize[2] = 64;
+        limits->maxDrawIndexedIndexValue = ~0u;
+        limits->maxDrawIndirectCount = ~0u;
+        limits->maxViewports = 16;
+        limits->maxViewportDimensions[0] = 16384;
+        limits->maxViewportDimensions[1] = 16384;
+        limits->viewportBoundsRange[0] = -32768.0f;
+        limits->viewportBoundsRange[1] = 32767.0f;
+        limits->minMemoryMapAlignment = 64;
+        limits->minTexelBufferOffsetAlignment = 16;
+        limits->minUniformBufferOffsetAlignment = 256;
+        limits->minStorageBufferOffsetAlignment = 256;
+        limits->maxFramebufferWidth = 16384;
+        limits->maxFramebufferHeight = 16384;
+        limits->maxFramebufferLayers = 2048;
+        limits->framebufferColorSampleCounts = VK_SAMPLE_COUNT_1_BIT | VK_SAMPLE_COUNT_4_BIT;
+        limits->framebufferDepthSampleCounts = VK_SAMPLE_COUNT_1_BIT | VK_SAMPLE_COUNT_4_BIT;
+        limits->framebufferStencilSampleCounts = VK_SAMPLE_COUNT_1_BIT | VK_SAMPLE_COUNT_4_BIT;
+        limits->framebufferNoAttachmentsSampleCounts =
+            VK_SAMPLE_COUNT_1_BIT | VK_SAMPLE_COUNT_4_BIT;
+        limits->maxColorAttachments = 8;
+        limits->sampledImageColorSampleCounts = VK_SAMPLE_COUNT_1_BIT | VK_SAMPLE_COUNT_4_BIT;
+        limits->sampledImageIntegerSampleCounts = VK_SAMPLE_COUNT_1_BIT | VK_SAMPLE_COUNT_4_BIT;
+        limits->sampledImageDepthSampleCounts = VK_SAMPLE_COUNT_1_BIT | VK_SAMPLE_COUNT_4_BIT;
+        limits->sampledImageStencilSampleCounts = VK_SAMPLE_COUNT_1_BIT | VK_SAMPLE_COUNT_4_BIT;
+        limits->storageImageSampleCounts = VK_SAMPLE_COUNT_1_BIT;
+        limits->maxSampleMaskWords = 1;
+        limits->maxClipDistances = 8;
+        limits->maxCullDistances = 8;
+        limits->maxCombinedClipAndCullDistances = 8;
+        limits->pointSizeRange[0] = 1.0f;
+        limits->pointSizeRange[1] = 64.0f;
+        limits->lineWidthRange[0] = 1.0f;
+        limits->lineWidthRange[1] = 8.0f;
+        limits->optimalBufferCopyOffsetAlignment = 1;
+        limits->optimalBufferCopyRowPitchAlignment = 1;
+        limits->nonCoherentAtomSize = kResourceAlignment;
+    }
+
+    VKAPI_ATTR void VKAPI_CALL
+    vkGetPhysicalDeviceQueueFamilyProperties(VkPhysicalDevice,
+                                             uint32_t* pQueueFamilyPropertyCount,
+                                             VkQueueFamilyProperties* pQueueFamilyProperties) {
+        VkQueueFamilyProperties universalFamily;
+        universalFamily.queueFlags =
+            VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT;
+        universalFamily.queueCount = 1;
+        universalFamily.timestampValidBits = 64;
+        universalFamily.minImageTransferGranularity = {1, 1, 1};
+        ReturnArray(&universalFamily, 1, pQueueFamilyPropertyCount, pQueueFamilyProperties);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkGetPhysicalDeviceSparseImageFormatProperties(
+        VkPhysicalDevice,
+        VkFormat,
+        VkImageType,
+        VkSampleCountFlagBits,
+        VkImageUsageFlags,
+        VkImageTiling,
+        uint32_t* pPropertyCount,
+        VkSparseImageFormatProperties* pProperties) {
+        ReturnArray<VkSparseImageFormatProperties>(nullptr, 0, pPropertyCount, pProperties);
+    }
+
+    // The KHR_get_physical_device_properties2 entry points return the same properties as their
+    // Vulkan 1.0 counterparts, with the ray tracing features and properties in the pNext chains.
+
+    VKAPI_ATTR void VKAPI_CALL
+    vkGetPhysicalDeviceFeatures2KHR(VkPhysicalDevice physicalDevice,
+                                    VkPhysicalDeviceFeatures2* pFeatures) {
+        vkGetPhysicalDeviceFeatures(physicalDevice, &pFeatures->features);
+
+        VkPhysicalDeviceRayTracingFeaturesKHR* rayTracingFeatures =
+            FindInChain<VkPhysicalDeviceRayTracingFeaturesKHR>(
+                pFeatures->pNext, VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_TRACING_FEATURES_KHR);
+        if (rayTracingFeatures != nullptr) {
+            rayTracingFeatures->rayTracing = VK_TRUE;
+        }
+    }
+
+    VKAPI_ATTR void VKAPI_CALL
+    vkGetPhysicalDeviceFormatProperties2KHR(VkPhysicalDevice physicalDevice,
+                                            VkFormat format,
+                                            VkFormatProperties2* pFormatProperties) {
+        vkGetPhysicalDeviceFormatProperties(physicalDevice, format,
+                                            &pFormatProperties->formatProperties);
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL vkGetPhysicalDeviceImageFormatProperties2KHR(
+        VkPhysicalDevice physicalDevice,
+        const VkPhysicalDeviceImageFormatInfo2* pImageFormatInfo,
+        VkImageFormatProperties2* pImageFormatProperties) {
+        return vkGetPhysicalDeviceImageFormatProperties(
+            physicalDevice, pImageFormatInfo->format, pImageFormatInfo->type,
+            pImageFormatInfo->tiling, pImageFormatInfo->usage, pImageFormatInfo->flags,
+            &pImageFormatProperties->imageFormatProperties);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL
+    vkGetPhysicalDeviceMemoryProperties2KHR(VkPhysicalDevice physicalDevice,
+                                            VkPhysicalDeviceMemoryProperties2* pMemoryProperties) {
+        vkGetPhysicalDeviceMemoryProperties(physicalDevice, &pMemoryProperties->memoryProperties);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL
+    vkGetPhysicalDeviceProperties2KHR(VkPhysicalDevice physicalDevice,
+                                      VkPhysicalDeviceProperties2* pProperties) {
+        vkGetPhysicalDeviceProperties(physicalDevice, &pProperties->properties);
+
+        VkPhysicalDeviceRayTracingPropertiesKHR* rayTracingProperties =
+            FindInChain<VkPhysicalDeviceRayTracingPropertiesKHR>(
+                pProperties->pNext, VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_TRACING_PROPERTIES_KHR);
+        if (rayTracingProperties != nullptr) {
+            rayTracingProperties->shaderGroupHandleSize = kShaderGroupHandleSize;
+            rayTracingProperties->maxRecursionDepth = 31;
+            rayTracingProperties->maxShaderGroupStride = 4096;
+            rayTracingProperties->shaderGroupBaseAlignment = 64;
+            rayTracingProperties->maxGeometryCount = 1u << 24;
+            rayTracingProperties->maxInstanceCount = 1u << 24;
+            rayTracingProperties->maxPrimitiveCount = 1u << 29;
+            rayTracingProperties->maxDescriptorSetAccelerationStructures = 16;
+            rayTracingProperties->shaderGroupHandleCaptureReplaySize = 0;
+        }
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkGetPhysicalDeviceQueueFamilyProperties2KHR(
+        VkPhysicalDevice physicalDevice,
+        uint32_t* pQueueFamilyPropertyCount,
+        VkQueueFamilyProperties2* pQueueFamilyProperties) {
+        if (pQueueFamilyProperties == nullptr) {
+            vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, pQueueFamilyPropertyCount,
+                                                     nullptr);
+            return;
+        }
+
+        std::vector<VkQueueFamilyProperties> properties(*pQueueFamilyPropertyCount);
+        vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, pQueueFamilyPropertyCount,
+                                                 properties.data());
+        for (uint32_t i = 0; i < *pQueueFamilyPropertyCount; ++i) {
+            pQueueFamilyProperties[i].queueFamilyProperties = properties[i];
+        }
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkGetPhysicalDeviceSparseImageFormatProperties2KHR(
+        VkPhysicalDevice,
+        const VkPhysicalDeviceSparseImageFormatInfo2*,
+        uint32_t* pPropertyCount,
+        VkSparseImageFormatProperties2* pProperties) {
+        ReturnArray<VkSparseImageFormatProperties2>(nullptr, 0, pPropertyCount, pProperties);
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL
+    vkEnumerateDeviceExtensionProperties(VkPhysicalDevice,
+                                         const char* pLayerName,
+                                         uint32_t* pPropertyCount,
+                                         VkExtensionProperties* pProperties) {
+        if (pLayerName != nullptr) {
+            return VK_ERROR_LAYER_NOT_PRESENT;
+        }
+        return ReturnExtensions(kDeviceExtensions, pPropertyCount, pProperties);
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL vkEnumerateDeviceLayerProperties(
+        VkPhysicalDevice,
+        uint32_t* pPropertyCount,
+        VkLayerProperties* pProperties) {
+        return ReturnArray<VkLayerProperties>(nullptr, 0, pPropertyCount, pProperties);
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL vkCreateDevice(VkPhysicalDevice,
+                                                  const VkDeviceCreateInfo* pCreateInfo,
+                                                  const VkAllocationCallbacks*,
+                                                  VkDevice* pDevice) {
+        if (!HasExtensions(kDeviceExtensions, pCreateInfo->enabledExtensionCount,
+                           pCreateInfo->ppEnabledExtensionNames)) {
+            return VK_ERROR_EXTENSION_NOT_PRESENT;
+        }
+
+        *pDevice = reinterpret_cast<VkDevice>(new FakeDevice);
+        return VK_SUCCESS;
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkDestroyDevice(VkDevice device, const VkAllocationCallbacks*) {
+        delete FromDevice(device);
+    }
+
+    // Device entry points
+
+    VKAPI_ATTR void VKAPI_CALL vkGetDeviceQueue(VkDevice device,
+                                                uint32_t,
+                                                uint32_t,
+                                                VkQueue* pQueue) {
+        FakeDevice* fakeDevice = FromDevice(device);
+        fakeDevice->Record(EntryPoint::GetDeviceQueue);
+        *pQueue = reinterpret_cast<VkQueue>(&fakeDevice->queue);
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL vkDeviceWaitIdle(VkDevice device) {
+        FromDevice(device)->Record(EntryPoint::DeviceWaitIdle);
+        return VK_SUCCESS;
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL vkQueueSubmit(VkQueue queue,
+                                                 uint32_t submitCount,
+                                                 const VkSubmitInfo* pSubmits,
+                                                 VkFence) {
+        FakeDevice* fakeDevice = FromQueue(queue);
+        fakeDevice->Record(EntryPoint::QueueSubmit);
+        Add(&fakeDevice->statistics.queueSubmitCount, 1);
+        for (uint32_t i = 0; i < submitCount; ++i) {
+            Add(&fakeDevice->statistics.submittedCommandBufferCount,
+                pSubmits[i].commandBufferCount);
+        }
+        return VK_SUCCESS;
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL vkQueueBindSparse(VkQueue queue,
+                                                     uint32_t,
+                                                     const VkBindSparseInfo*,
+                                                     VkFence) {
+        FromQueue(queue)->Record(EntryPoint::QueueBindSparse);
+        return VK_SUCCESS;
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL vkQueueWaitIdle(VkQueue queue) {
+        FromQueue(queue)->Record(EntryPoint::QueueWaitIdle);
+        return VK_SUCCESS;
+    }
+
+    // Memory
+
+    VKAPI_ATTR VkResult VKAPI_CALL vkAllocateMemory(VkDevice device,
+                                                    const VkMemoryAllocateInfo* pAllocateInfo,
+                                                    const VkAllocationCallbacks*,
+                                                    VkDeviceMemory* pMemory) {
+        FakeDevice* fakeDevice = FromDevice(device);
+        fakeDevice->Record(EntryPoint::AllocateMemory);
+
+        VkDeviceSize size = pAllocateInfo->allocationSize;
+        Add(&fakeDevice->statistics.memoryAllocationCount, 1);
+        Add(&fakeDevice->statistics.memoryAllocationSize, size);
+        Add(&fakeDevice->statistics.liveMemorySize, size);
+        Add(&fakeDevice->statistics.liveObjectCount, 1);
+
+        *pMemory = ToHandle<VkDeviceMemory>(new FakeMemory{size, nullptr});
+        return VK_SUCCESS;
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkFreeMemory(VkDevice device,
+                                            VkDeviceMemory memory,
+                                            const VkAllocationCallbacks*) {
+        FakeDevice* fakeDevice = FromDevice(device);
+        fakeDevice->Record(EntryPoint::FreeMemory);
+
+        FakeMemory* fakeMemory = FromHandle<FakeMemory>(memory);
+        if (fakeMemory == nullptr) {
+            return;
+        }
+        Subtract(&fakeDevice->statistics.liveMemorySize, fakeMemory->size);
+        Subtract(&fakeDevice->statistics.liveObjectCount, 1);
+        delete fakeMemory;
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL vkMapMemory(VkDevice device,
+                                               VkDeviceMemory memory,
+                                               VkDeviceSize offset,
+                                               VkDeviceSize,
+                                               VkMemoryMapFlags,
+                                               void** ppData) {
+        FromDevice(device)->Record(EntryPoint::MapMemory);
+
+        FakeMemory* fakeMemory = FromHandle<FakeMemory>(memory);
+        if (fakeMemory->data == nullptr) {
+            fakeMemory->data.reset(new (std::nothrow) uint8_t[fakeMemory->size]);
+            if (fakeMemory->data == nullptr) {
+                return VK_ERROR_MEMORY_MAP_FAILED;
+            }
+        }
+        *ppData = fakeMemory->data.get() + offset;
+        return VK_SUCCESS;
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkUnmapMemory(VkDevice device, VkDeviceMemory) {
+        FromDevice(device)->Record(EntryPoint::UnmapMemory);
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL vkFlushMappedMemoryRanges(VkDevice device,
+                                                             uint32_t,
+                                                             const VkMappedMemoryRange*) {
+        FromDevice(device)->Record(EntryPoint::FlushMappedMemoryRanges);
+        return VK_SUCCESS;
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL vkInvalidateMappedMemoryRanges(VkDevice device,
+                                                                  uint32_t,
+                                                                  const VkMappedMemoryRange*) {
+        FromDevice(device)->Record(EntryPoint::InvalidateMappedMemoryRanges);
+        return VK_SUCCESS;
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkGetDeviceMemoryCommitment(VkDevice device,
+                                                           VkDeviceMemory memory,
+                                                           VkDeviceSize* pCommittedMemoryInBytes) {
+        FromDevice(device)->Record(EntryPoint::GetDeviceMemoryCommitment);
+        *pCommittedMemoryInBytes = FromHandle<FakeMemory>(memory)->size;
+    }
+
+    // Buffers and images
+
+    VKAPI_ATTR VkResult VKAPI_CALL vkCreateBuffer(VkDevice device,
+                                                  const VkBufferCreateInfo* pCreateInfo,
+                                                  const VkAllocationCallbacks*,
+                                                  VkBuffer* pBuffer) {
+        FakeDevice* fakeDevice = FromDevice(device);
+        fakeDevice->Record(EntryPoint::CreateBuffer);
+        Add(&fakeDevice->statistics.liveObjectCount, 1);
+        *pBuffer = ToHandle<VkBuffer>(new FakeBuffer{AlignResourceSize(pCreateInfo->size)});
+        return VK_SUCCESS;
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL vkCreateImage(VkDevice device,
+                                                 const VkImageCreateInfo* pCreateInfo,
+                                                 const VkAllocationCallbacks*,
+                                                 VkImage* pImage) {
+        FakeDevice* fakeDevice = FromDevice(device);
+        fakeDevice->Record(EntryPoint::CreateImage);
+        Add(&fakeDevice->statistics.liveObjectCount, 1);
+
+        // The mipmaps of an image take less memory than its first level.
+        VkDeviceSize size = VkDeviceSize(pCreateInfo->extent.width) * pCreateInfo->extent.height *
+                            pCreateInfo->extent.depth * pCreateInfo->arrayLayers *
+                            pCreateInfo->samples * kMaxTexelBlockSize;
+        if (pCreateInfo->mipLevels > 1) {
+            size *= 2;
+        }
+
+        *pImage = ToHandle<VkImage>(new FakeImage{AlignResourceSize(size)});
+        return VK_SUCCESS;
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkGetBufferMemoryRequirements(
+        VkDevice device,
+        VkBuffer buffer,
+        VkMemoryRequirements* pMemoryRequirements) {
+        FromDevice(device)->Record(EntryPoint::GetBufferMemoryRequirements);
+        *pMemoryRequirements = MakeMemoryRequirements(FromHandle<FakeBuffer>(buffer)->size);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL
+    vkGetBufferMemoryRequirements2(VkDevice device,
+                                   const VkBufferMemoryRequirementsInfo2* pInfo,
+                                   VkMemoryRequirements2* pMemoryRequirements) {
+        FromDevice(device)->Record(EntryPoint::GetBufferMemoryRequirements2);
+        pMemoryRequirements->memoryRequirements =
+            MakeMemoryRequirements(FromHandle<FakeBuffer>(pInfo->buffer)->size);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkGetImageMemoryRequirements(
+        VkDevice device,
+        VkImage image,
+        VkMemoryRequirements* pMemoryRequirements) {
+        FromDevice(device)->Record(EntryPoint::GetImageMemoryRequirements);
+        *pMemoryRequirements = MakeMemoryRequirements(FromHandle<FakeImage>(image)->size);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkGetImageSparseMemoryRequirements(
+        VkDevice device,
+        VkImage,
+        uint32_t* pSparseMemoryRequirementCount,
+        VkSparseImageMemoryRequirements* pSparseMemoryRequirements) {
+        FromDevice(device)->Record(EntryPoint::GetImageSparseMemoryRequirements);
+        ReturnArray<VkSparseImageMemoryRequirements>(nullptr, 0, pSparseMemoryRequirementCount,
+                                                     pSparseMemoryRequirements);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkGetImageSubresourceLayout(VkDevice device,
+                                                           VkImage image,
+                                                           const VkImageSubresource*,
+                                                           VkSubresourceLayout* pLayout) {
+        FromDevice(device)->Record(EntryPoint::GetImageSubresourceLayout);
+        *pLayout = {};
+        pLayout->size = FromHandle<FakeImage>(image)->size;
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL vkBindBufferMemory(VkDevice device,
+                                                      VkBuffer,
+                                                      VkDeviceMemory,
+                                                      VkDeviceSize) {
+        FromDevice(device)->Record(EntryPoint::BindBufferMemory);
+        return VK_SUCCESS;
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL vkBindImageMemory(VkDevice device,
+                                                     VkImage,
+                                                     VkDeviceMemory,
+                                                     VkDeviceSize) {
+        FromDevice(device)->Record(EntryPoint::BindImageMemory);
+        return VK_SUCCESS;
+    }
+
+    // Device addresses are the addresses of the fake objects.
+    VKAPI_ATTR VkDeviceAddress VKAPI_CALL
+    vkGetBufferDeviceAddressKHR(VkDevice device, const VkBufferDeviceAddressInfo* pInfo) {
+        FromDevice(device)->Record(EntryPoint::GetBufferDeviceAddressKHR);
+        return reinterpret_cast<uintptr_t>(FromHandle<FakeBuffer>(pInfo->buffer));
+    }
+
+    // Pipelines
+
+    VKAPI_ATTR VkResult VKAPI_CALL
+    vkCreateComputePipelines(VkDevice device,
+                             VkPipelineCache,
+                             uint32_t createInfoCount,
+                             const VkComputePipelineCreateInfo* pCreateInfos,
+                             const VkAllocationCallbacks*,
+                             VkPipeline* pPipelines) {
+        FakeDevice* fakeDevice = FromDevice(device);
+        fakeDevice->Record(EntryPoint::CreateComputePipelines);
+        return CreatePipelines(fakeDevice, createInfoCount, pCreateInfos, pPipelines);
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL
+    vkCreateGraphicsPipelines(VkDevice device,
+                              VkPipelineCache,
+                              uint32_t createInfoCount,
+                              const VkGraphicsPipelineCreateInfo* pCreateInfos,
+                              const VkAllocationCallbacks*,
+                              VkPipeline* pPipelines) {
+        FakeDevice* fakeDevice = FromDevice(device);
+        fakeDevice->Record(EntryPoint::CreateGraphicsPipelines);
+        return CreatePipelines(fakeDevice, createInfoCount, pCreateInfos, pPipelines);
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL vkGetPipelineCacheData(VkDevice device,
+                                                          VkPipelineCache,
+                                                          size_t* pDataSize,
+                                                          void*) {
+        // There is never anything worth caching.
+        FromDevice(device)->Record(EntryPoint::GetPipelineCacheData);
+        *pDataSize = 0;
+        return VK_SUCCESS;
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL vkMergePipelineCaches(VkDevice device,
+                                                         VkPipelineCache,
+                                                         uint32_t,
+                                                         const VkPipelineCache*) {
+        FromDevice(device)->Record(EntryPoint::MergePipelineCaches);
+        return VK_SUCCESS;
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkGetRenderAreaGranularity(VkDevice device,
+                                                          VkRenderPass,
+                                                          VkExtent2D* pGranularity) {
+        FromDevice(device)->Record(EntryPoint::GetRenderAreaGranularity);
+        *pGranularity = {1, 1};
+    }
+
+    // Synchronization and queries. No work is ever pending so fences and events are always
+    // signaled, and queries are available.
+
+    VKAPI_ATTR VkResult VKAPI_CALL vkGetFenceStatus(VkDevice device, VkFence) {
+        FromDevice(device)->Record(EntryPoint::GetFenceStatus);
+        return VK_SUCCESS;
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL vkResetFences(VkDevice device, uint32_t, const VkFence*) {
+        FromDevice(device)->Record(EntryPoint::ResetFences);
+        return VK_SUCCESS;
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL
+    vkWaitForFences(VkDevice device, uint32_t, const VkFence*, VkBool32, uint64_t) {
+        FromDevice(device)->Record(EntryPoint::WaitForFences);
+        return VK_SUCCESS;
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL vkGetEventStatus(VkDevice device, VkEvent) {
+        FromDevice(device)->Record(EntryPoint::GetEventStatus);
+        return VK_EVENT_SET;
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL vkSetEvent(VkDevice device, VkEvent) {
+        FromDevice(device)->Record(EntryPoint::SetEvent);
+        return VK_SUCCESS;
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL vkResetEvent(VkDevice device, VkEvent) {
+        FromDevice(device)->Record(EntryPoint::ResetEvent);
+        return VK_SUCCESS;
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL vkCreateQueryPool(VkDevice device,
+                                                     const VkQueryPoolCreateInfo* pCreateInfo,
+                                                     const VkAllocationCallbacks*,
+                                                     VkQueryPool* pQueryPool) {
+        FakeDevice* fakeDevice = FromDevice(device);
+        fakeDevice->Record(EntryPoint::CreateQueryPool);
+        Add(&fakeDevice->statistics.liveObjectCount, 1);
+        *pQueryPool = ToHandle<VkQueryPool>(new FakeQueryPool(pCreateInfo->queryCount));
+        return VK_SUCCESS;
+    }
+
+    // Writes a query result, followed by its availability if it is requested.
+    template <typename T>
+    void WriteQueryResult(uint64_t result, VkQueryResultFlags flags, uint8_t* data) {
+        const T values[2] = {static_cast<T>(result), 1};
+        size_t valueCount = (flags & VK_QUERY_RESULT_WITH_AVAILABILITY_BIT) != 0 ? 2 : 1;
+        memcpy(data, values, valueCount * sizeof(T));
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL vkGetQueryPoolResults(VkDevice device,
+                                                         VkQueryPool queryPool,
+                                                         uint32_t firstQuery,
+                                                         uint32_t queryCount,
+                                                         size_t,
+                                                         void* pData,
+                                                         VkDeviceSize stride,
+                                                         VkQueryResultFlags flags) {
+        FromDevice(device)->Record(EntryPoint::GetQueryPoolResults);
+
+        const FakeQueryPool* fakeQueryPool = FromHandle<FakeQueryPool>(queryPool);
+        uint8_t* data = static_cast<uint8_t*>(pData);
+        for (uint32_t i = 0; i < queryCount; ++i) {
+            uint64_t result = Load(fakeQueryPool->results[firstQuery + i]);
+            if ((flags & VK_QUERY_RESULT_64_BIT) != 0) {
+                WriteQueryResult<uint64_t>(result, flags, data + i * stride);
+            } else {
+                WriteQueryResult<uint32_t>(result, flags, data + i * stride);
+            }
+        }
+        return VK_SUCCESS;
+    }
+
+    // Command pools and command buffers
+
+    VKAPI_ATTR VkResult VKAPI_CALL vkCreateCommandPool(VkDevice device,
+                                                       const VkCommandPoolCreateInfo*,
+                                                       const VkAllocationCallbacks*,
+                                                       VkCommandPool* pCommandPool) {
+        FakeDevice* fakeDevice = FromDevice(device);
+        fakeDevice->Record(EntryPoint::CreateCommandPool);
+        Add(&fakeDevice->statistics.liveObjectCount, 1);
+        *pCommandPool = ToHandle<VkCommandPool>(new FakeCommandPool);
+        return VK_SUCCESS;
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkDestroyCommandPool(VkDevice device,
+                                                    VkCommandPool commandPool,
+                                                    const VkAllocationCallbacks*) {
+        FakeDevice* fakeDevice = FromDevice(device);
+        fakeDevice->Record(EntryPoint::DestroyCommandPool);
+
+        FakeCommandPool* pool = FromHandle<FakeCommandPool>(commandPool);
+        if (pool == nullptr) {
+            return;
+        }
+        Subtract(&fakeDevice->statistics.liveObjectCount, 1 + pool->commandBuffers.size());
+        delete pool;
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL vkResetCommandPool(VkDevice device,
+                                                      VkCommandPool,
+                                                      VkCommandPoolResetFlags) {
+        FromDevice(device)->Record(EntryPoint::ResetCommandPool);
+        return VK_SUCCESS;
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL
+    vkAllocateCommandBuffers(VkDevice device,
+                             const VkCommandBufferAllocateInfo* pAllocateInfo,
+                             VkCommandBuffer* pCommandBuffers) {
+        FakeDevice* fakeDevice = FromDevice(device);
+        fakeDevice->Record(EntryPoint::AllocateCommandBuffers);
+        Add(&fakeDevice->statistics.liveObjectCount, pAllocateInfo->commandBufferCount);
+
+        FakeCommandPool* pool = FromHandle<FakeCommandPool>(pAllocateInfo->commandPool);
+        for (uint32_t i = 0; i < pAllocateInfo->commandBufferCount; ++i) {
+            pool->commandBuffers.push_back(
+                std::make_unique<FakeCommandBuffer>(FakeCommandBuffer{fakeDevice}));
+            pCommandBuffers[i] =
+                reinterpret_cast<VkCommandBuffer>(pool->commandBuffers.back().get());
+        }
+        return VK_SUCCESS;
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkFreeCommandBuffers(VkDevice device,
+                                                    VkCommandPool commandPool,
+                                                    uint32_t commandBufferCount,
+                                                    const VkCommandBuffer* pCommandBuffers) {
+        FakeDevice* fakeDevice = FromDevice(device);
+        fakeDevice->Record(EntryPoint::FreeCommandBuffers);
+
+        FakeCommandPool* pool = FromHandle<FakeCommandPool>(commandPool);
+        for (uint32_t i = 0; i < commandBufferCount; ++i) {
+            FakeCommandBuffer* commandBuffer =
+                reinterpret_cast<FakeCommandBuffer*>(pCommandBuffers[i]);
+            if (commandBuffer == nullptr) {
+                continue;
+            }
+
+            auto it = std::find_if(pool->commandBuffers.begin(), pool->commandBuffers.end(),
+                                   [&](const std::unique_ptr<FakeCommandBuffer>& c) {
+                                       return c.get() == commandBuffer;
+                                   });
+            ASSERT(it != pool->commandBuffers.end());
+            pool->commandBuffers.erase(it);
+            Subtract(&fakeDevice->statistics.liveObjectCount, 1);
+        }
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL vkBeginCommandBuffer(VkCommandBuffer commandBuffer,
+                                                        const VkCommandBufferBeginInfo*) {
+        FromCommandBuffer(commandBuffer)->Record(EntryPoint::BeginCommandBuffer);
+        return VK_SUCCESS;
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL vkEndCommandBuffer(VkCommandBuffer commandBuffer) {
+        FromCommandBuffer(commandBuffer)->Record(EntryPoint::EndCommandBuffer);
+        return VK_SUCCESS;
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL vkResetCommandBuffer(VkCommandBuffer commandBuffer,
+                                                        VkCommandBufferResetFlags) {
+        FromCommandBuffer(commandBuffer)->Record(EntryPoint::ResetCommandBuffer);
+        return VK_SUCCESS;
+    }
+
+    // Descriptors
+
+    VKAPI_ATTR VkResult VKAPI_CALL vkCreateDescriptorPool(VkDevice device,
+                                                          const VkDescriptorPoolCreateInfo*,
+                                                          const VkAllocationCallbacks*,
+                                                          VkDescriptorPool* pDescriptorPool) {
+        FakeDevice* fakeDevice = FromDevice(device);
+        fakeDevice->Record(EntryPoint::CreateDescriptorPool);
+        Add(&fakeDevice->statistics.liveObjectCount, 1);
+        *pDescriptorPool = ToHandle<VkDescriptorPool>(new FakeDescriptorPool);
+        return VK_SUCCESS;
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkDestroyDescriptorPool(VkDevice device,
+                                                       VkDescriptorPool descriptorPool,
+                                                       const VkAllocationCallbacks*) {
+        FakeDevice* fakeDevice = FromDevice(device);
+        fakeDevice->Record(EntryPoint::DestroyDescriptorPool);
+
+        FakeDescriptorPool* pool = FromHandle<FakeDescriptorPool>(descriptorPool);
+        if (pool == nullptr) {
+            return;
+        }
+        Subtract(&fakeDevice->statistics.liveObjectCount, 1 + pool->descriptorSets.size());
+        delete pool;
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL vkResetDescriptorPool(VkDevice device,
+                                                         VkDescriptorPool descriptorPool,
+                                                         VkDescriptorPoolResetFlags) {
+        FakeDevice* fakeDevice = FromDevice(device);
+        fakeDevice->Record(EntryPoint::ResetDescriptorPool);
+
+        FakeDescriptorPool* pool = FromHandle<FakeDescriptorPool>(descriptorPool);
+        Subtract(&fakeDevice->statistics.liveObjectCount, pool->descriptorSets.size());
+        pool->descriptorSets.clear();
+        return VK_SUCCESS;
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL
+    vkAllocateDescriptorSets(VkDevice device,
+                             const VkDescriptorSetAllocateInfo* pAllocateInfo,
+                             VkDescriptorSet* pDescriptorSets) {
+        FakeDevice* fakeDevice = FromDevice(device);
+        fakeDevice->Record(EntryPoint::AllocateDescriptorSets);
+
+        uint32_t setCount = pAllocateInfo->descriptorSetCount;
+        Add(&fakeDevice->statistics.descriptorSetAllocationCount, setCount);
+        Add(&fakeDevice->statistics.liveObjectCount, setCount);
+
+        FakeDescriptorPool* pool = FromHandle<FakeDescriptorPool>(pAllocateInfo->descriptorPool);
+        for (uint32_t i = 0; i < setCount; ++i) {
+            pool->descriptorSets.push_back(std::make_unique<FakeObject>());
+            pDescriptorSets[i] = ToHandle<VkDescriptorSet>(pool->descriptorSets.back().get());
+        }
+        return VK_SUCCESS;
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL vkFreeDescriptorSets(VkDevice device,
+                                                        VkDescriptorPool descriptorPool,
+                                                        uint32_t descriptorSetCount,
+                                                        const VkDescriptorSet* pDescriptorSets) {
+        FakeDevice* fakeDevice = FromDevice(device);
+        fakeDevice->Record(EntryPoint::FreeDescriptorSets);
+
+        FakeDescriptorPool* pool = FromHandle<FakeDescriptorPool>(descriptorPool);
+        for (uint32_t i = 0; i < descriptorSetCount; ++i) {
+            FakeObject* set = FromHandle<FakeObject>(pDescriptorSets[i]);
+            if (set == nullptr) {
+                continue;
+            }
+
+            auto it = std::find_if(
+                pool->descriptorSets.begin(), pool->descriptorSets.end(),
+                [&](const std::unique_ptr<FakeObject>& s) { return s.get() == set; });
+            ASSERT(it != pool->descriptorSets.end());
+            pool->descriptorSets.erase(it);
+            Subtract(&fakeDevice->statistics.liveObjectCount, 1);
+        }
+        return VK_SUCCESS;
+    }
+
+    VKAPI_ATTR void VKAPI_CALL
+    vkUpdateDescriptorSets(VkDevice device,
+                           uint32_t descriptorWriteCount,
+                           const VkWriteDescriptorSet* pDescriptorWrites,
+                           uint32_t descriptorCopyCount,
+                           const VkCopyDescriptorSet* pDescriptorCopies) {
+        FakeDevice* fakeDevice = FromDevice(device);
+        fakeDevice->Record(EntryPoint::UpdateDescriptorSets);
+
+        uint64_t writtenDescriptors = 0;
+        for (uint32_t i = 0; i < descriptorWriteCount; ++i) {
+            writtenDescriptors += pDescriptorWrites[i].descriptorCount;
+        }
+        uint64_t copiedDescriptors = 0;
+        for (uint32_t i = 0; i < descriptorCopyCount; ++i) {
+            copiedDescriptors += pDescriptorCopies[i].descriptorCount;
+        }
+        Add(&fakeDevice->statistics.descriptorWriteCount, writtenDescriptors);
+        Add(&fakeDevice->statistics.descriptorCopyCount, copiedDescriptors);
+    }
+
+    // Commands
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdPipelineBarrier(VkCommandBuffer commandBuffer,
+                                                    VkPipelineStageFlags,
+                                                    VkPipelineStageFlags,
+                                                    VkDependencyFlags,
+                                                    uint32_t memoryBarrierCount,
+                                                    const VkMemoryBarrier*,
+                                                    uint32_t bufferMemoryBarrierCount,
+                                                    const VkBufferMemoryBarrier*,
+                                                    uint32_t imageMemoryBarrierCount,
+                                                    const VkImageMemoryBarrier*) {
+        FakeDevice* fakeDevice = FromCommandBuffer(commandBuffer);
+        fakeDevice->Record(EntryPoint::CmdPipelineBarrier);
+        Add(&fakeDevice->statistics.pipelineBarrierCount, 1);
+        Add(&fakeDevice->statistics.memoryBarrierCount, memoryBarrierCount);
+        Add(&fakeDevice->statistics.bufferMemoryBarrierCount, bufferMemoryBarrierCount);
+        Add(&fakeDevice->statistics.imageMemoryBarrierCount, imageMemoryBarrierCount);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdWaitEvents(VkCommandBuffer commandBuffer,
+                                               uint32_t,
+                                               const VkEvent*,
+                                               VkPipelineStageFlags,
+                                               VkPipelineStageFlags,
+                                               uint32_t,
+                                               const VkMemoryBarrier*,
+                                               uint32_t,
+                                               const VkBufferMemoryBarrier*,
+                                               uint32_t,
+                                               const VkImageMemoryBarrier*) {
+        FromCommandBuffer(commandBuffer)->Record(EntryPoint::CmdWaitEvents);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdSetEvent(VkCommandBuffer commandBuffer,
+                                             VkEvent,
+                                             VkPipelineStageFlags) {
+        FromCommandBuffer(commandBuffer)->Record(EntryPoint::CmdSetEvent);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdResetEvent(VkCommandBuffer commandBuffer,
+                                               VkEvent,
+                                               VkPipelineStageFlags) {
+        FromCommandBuffer(commandBuffer)->Record(EntryPoint::CmdResetEvent);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdBeginRenderPass(VkCommandBuffer commandBuffer,
+                                                    const VkRenderPassBeginInfo*,
+                                                    VkSubpassContents) {
+        FakeDevice* fakeDevice = FromCommandBuffer(commandBuffer);
+        fakeDevice->Record(EntryPoint::CmdBeginRenderPass);
+        Add(&fakeDevice->statistics.renderPassCount, 1);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdNextSubpass(VkCommandBuffer commandBuffer,
+                                                VkSubpassContents) {
+        FromCommandBuffer(commandBuffer)->Record(EntryPoint::CmdNextSubpass);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdEndRenderPass(VkCommandBuffer commandBuffer) {
+        FromCommandBuffer(commandBuffer)->Record(EntryPoint::CmdEndRenderPass);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdExecuteCommands(VkCommandBuffer commandBuffer,
+                                                    uint32_t,
+                                                    const VkCommandBuffer*) {
+        FromCommandBuffer(commandBuffer)->Record(EntryPoint::CmdExecuteCommands);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdBindPipeline(VkCommandBuffer commandBuffer,
+                                                 VkPipelineBindPoint,
+                                                 VkPipeline) {
+        FromCommandBuffer(commandBuffer)->Record(EntryPoint::CmdBindPipeline);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdBindDescriptorSets(VkCommandBuffer commandBuffer,
+                                                       VkPipelineBindPoint,
+                                                       VkPipelineLayout,
+                                                       uint32_t,
+                                                       uint32_t,
+                                                       const VkDescriptorSet*,
+                                                       uint32_t,
+                                                       const uint32_t*) {
+        FromCommandBuffer(commandBuffer)->Record(EntryPoint::CmdBindDescriptorSets);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdBindIndexBuffer(VkCommandBuffer commandBuffer,
+                                                    VkBuffer,
+                                                    VkDeviceSize,
+                                                    VkIndexType) {
+        FromCommandBuffer(commandBuffer)->Record(EntryPoint::CmdBindIndexBuffer);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdBindVertexBuffers(VkCommandBuffer commandBuffer,
+                                                      uint32_t,
+                                                      uint32_t,
+                                                      const VkBuffer*,
+                                                      const VkDeviceSize*) {
+        FromCommandBuffer(commandBuffer)->Record(EntryPoint::CmdBindVertexBuffers);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdPushConstants(VkCommandBuffer commandBuffer,
+                                                  VkPipelineLayout,
+                                                  VkShaderStageFlags,
+                                                  uint32_t,
+                                                  uint32_t,
+                                                  const void*) {
+        FromCommandBuffer(commandBuffer)->Record(EntryPoint::CmdPushConstants);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdSetViewport(VkCommandBuffer commandBuffer,
+                                                uint32_t,
+                                                uint32_t,
+                                                const VkViewport*) {
+        FromCommandBuffer(commandBuffer)->Record(EntryPoint::CmdSetViewport);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdSetScissor(VkCommandBuffer commandBuffer,
+                                               uint32_t,
+                                               uint32_t,
+                                               const VkRect2D*) {
+        FromCommandBuffer(commandBuffer)->Record(EntryPoint::CmdSetScissor);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdSetLineWidth(VkCommandBuffer commandBuffer, float) {
+        FromCommandBuffer(commandBuffer)->Record(EntryPoint::CmdSetLineWidth);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdSetDepthBias(VkCommandBuffer commandBuffer,
+                                                 float,
+                                                 float,
+                                                 float) {
+        FromCommandBuffer(commandBuffer)->Record(EntryPoint::CmdSetDepthBias);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdSetDepthBounds(VkCommandBuffer commandBuffer, float, float) {
+        FromCommandBuffer(commandBuffer)->Record(EntryPoint::CmdSetDepthBounds);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdSetBlendConstants(VkCommandBuffer commandBuffer,
+                                                      const float[4]) {
+        FromCommandBuffer(commandBuffer)->Record(EntryPoint::CmdSetBlendConstants);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdSetStencilCompareMask(VkCommandBuffer commandBuffer,
+                                                          VkStencilFaceFlags,
+                                                          uint32_t) {
+        FromCommandBuffer(commandBuffer)->Record(EntryPoint::CmdSetStencilCompareMask);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdSetStencilWriteMask(VkCommandBuffer commandBuffer,
+                                                        VkStencilFaceFlags,
+                                                        uint32_t) {
+        FromCommandBuffer(commandBuffer)->Record(EntryPoint::CmdSetStencilWriteMask);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdSetStencilReference(VkCommandBuffer commandBuffer,
+                                                        VkStencilFaceFlags,
+                                                        uint32_t) {
+        FromCommandBuffer(commandBuffer)->Record(EntryPoint::CmdSetStencilReference);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL
+    vkCmdDraw(VkCommandBuffer commandBuffer, uint32_t, uint32_t, uint32_t, uint32_t) {
+        FakeDevice* fakeDevice = FromCommandBuffer(commandBuffer);
+        fakeDevice->Record(EntryPoint::CmdDraw);
+        Add(&fakeDevice->statistics.drawCount, 1);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdDrawIndexed(VkCommandBuffer commandBuffer,
+                                                uint32_t,
+                                                uint32_t,
+                                                uint32_t,
+                                                int32_t,
+                                                uint32_t) {
+        FakeDevice* fakeDevice = FromCommandBuffer(commandBuffer);
+        fakeDevice->Record(EntryPoint::CmdDrawIndexed);
+        Add(&fakeDevice->statistics.drawCount, 1);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdDrawIndirect(VkCommandBuffer commandBuffer,
+                                                 VkBuffer,
+                                                 VkDeviceSize,
+                                                 uint32_t drawCount,
+                                                 uint32_t) {
+        FakeDevice* fakeDevice = FromCommandBuffer(commandBuffer);
+        fakeDevice->Record(EntryPoint::CmdDrawIndirect);
+        Add(&fakeDevice->statistics.drawCount, drawCount);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdDrawIndexedIndirect(VkCommandBuffer commandBuffer,
+                                                        VkBuffer,
+                                                        VkDeviceSize,
+                                                        uint32_t drawCount,
+                                                        uint32_t) {
+        FakeDevice* fakeDevice = FromCommandBuffer(commandBuffer);
+        fakeDevice->Record(EntryPoint::CmdDrawIndexedIndirect);
+        Add(&fakeDevice->statistics.drawCount, drawCount);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdDispatch(VkCommandBuffer commandBuffer,
+                                             uint32_t,
+                                             uint32_t,
+                                             uint32_t) {
+        FakeDevice* fakeDevice = FromCommandBuffer(commandBuffer);
+        fakeDevice->Record(EntryPoint::CmdDispatch);
+        Add(&fakeDevice->statistics.dispatchCount, 1);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdDispatchIndirect(VkCommandBuffer commandBuffer,
+                                                     VkBuffer,
+                                                     VkDeviceSize) {
+        FakeDevice* fakeDevice = FromCommandBuffer(commandBuffer);
+        fakeDevice->Record(EntryPoint::CmdDispatchIndirect);
+        Add(&fakeDevice->statistics.dispatchCount, 1);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdCopyBuffer(VkCommandBuffer commandBuffer,
+                                               VkBuffer,
+                                               VkBuffer,
+                                               uint32_t,
+                                               const VkBufferCopy*) {
+        FakeDevice* fakeDevice = FromCommandBuffer(commandBuffer);
+        fakeDevice->Record(EntryPoint::CmdCopyBuffer);
+        Add(&fakeDevice->statistics.copyCount, 1);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdCopyBufferToImage(VkCommandBuffer commandBuffer,
+                                                      VkBuffer,
+                                                      VkImage,
+                                                      VkImageLayout,
+                                                      uint32_t,
+                                                      const VkBufferImageCopy*) {
+        FakeDevice* fakeDevice = FromCommandBuffer(commandBuffer);
+        fakeDevice->Record(EntryPoint::CmdCopyBufferToImage);
+        Add(&fakeDevice->statistics.copyCount, 1);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdCopyImageToBuffer(VkCommandBuffer commandBuffer,
+                                                      VkImage,
+                                                      VkImageLayout,
+                                                      VkBuffer,
+                                                      uint32_t,
+                                                      const VkBufferImageCopy*) {
+        FakeDevice* fakeDevice = FromCommandBuffer(commandBuffer);
+        fakeDevice->Record(EntryPoint::CmdCopyImageToBuffer);
+        Add(&fakeDevice->statistics.copyCount, 1);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdCopyImage(VkCommandBuffer commandBuffer,
+                                              VkImage,
+                                              VkImageLayout,
+                                              VkImage,
+                                              VkImageLayout,
+                                              uint32_t,
+                                              const VkImageCopy*) {
+        FakeDevice* fakeDevice = FromCommandBuffer(commandBuffer);
+        fakeDevice->Record(EntryPoint::CmdCopyImage);
+        Add(&fakeDevice->statistics.copyCount, 1);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdBlitImage(VkCommandBuffer commandBuffer,
+                                              VkImage,
+                                              VkImageLayout,
+                                              VkImage,
+                                              VkImageLayout,
+                                              uint32_t,
+                                              const VkImageBlit*,
+                                              VkFilter) {
+        FromCommandBuffer(commandBuffer)->Record(EntryPoint::CmdBlitImage);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdResolveImage(VkCommandBuffer commandBuffer,
+                                                 VkImage,
+                                                 VkImageLayout,
+                                                 VkImage,
+                                                 VkImageLayout,
+                                                 uint32_t,
+                                                 const VkImageResolve*) {
+        FromCommandBuffer(commandBuffer)->Record(EntryPoint::CmdResolveImage);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdUpdateBuffer(VkCommandBuffer commandBuffer,
+                                                 VkBuffer,
+                                                 VkDeviceSize,
+                                                 VkDeviceSize,
+                                                 const void*) {
+        FromCommandBuffer(commandBuffer)->Record(EntryPoint::CmdUpdateBuffer);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdFillBuffer(VkCommandBuffer commandBuffer,
+                                               VkBuffer,
+                                               VkDeviceSize,
+                                               VkDeviceSize,
+                                               uint32_t) {
+        FromCommandBuffer(commandBuffer)->Record(EntryPoint::CmdFillBuffer);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdClearColorImage(VkCommandBuffer commandBuffer,
+                                                    VkImage,
+                                                    VkImageLayout,
+                                                    const VkClearColorValue*,
+                                                    uint32_t,
+                                                    const VkImageSubresourceRange*) {
+        FromCommandBuffer(commandBuffer)->Record(EntryPoint::CmdClearColorImage);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdClearDepthStencilImage(VkCommandBuffer commandBuffer,
+                                                           VkImage,
+                                                           VkImageLayout,
+                                                           const VkClearDepthStencilValue*,
+                                                           uint32_t,
+                                                           const VkImageSubresourceRange*) {
+        FromCommandBuffer(commandBuffer)->Record(EntryPoint::CmdClearDepthStencilImage);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdClearAttachments(VkCommandBuffer commandBuffer,
+                                                     uint32_t,
+                                                     const VkClearAttachment*,
+                                                     uint32_t,
+                                                     const VkClearRect*) {
+        FromCommandBuffer(commandBuffer)->Record(EntryPoint::CmdClearAttachments);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdBeginQuery(VkCommandBuffer commandBuffer,
+                                               VkQueryPool,
+                                               uint32_t,
+                                               VkQueryControlFlags) {
+        FromCommandBuffer(commandBuffer)->Record(EntryPoint::CmdBeginQuery);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdEndQuery(VkCommandBuffer commandBuffer,
+                                             VkQueryPool,
+                                             uint32_t) {
+        FromCommandBuffer(commandBuffer)->Record(EntryPoint::CmdEndQuery);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdResetQueryPool(VkCommandBuffer commandBuffer,
+                                                   VkQueryPool queryPool,
+                                                   uint32_t firstQuery,
+                                                   uint32_t queryCount) {
+        FromCommandBuffer(commandBuffer)->Record(EntryPoint::CmdResetQueryPool);
+
+        FakeQueryPool* fakeQueryPool = FromHandle<FakeQueryPool>(queryPool);
+        for (uint32_t i = 0; i < queryCount; ++i) {
+            Store(&fakeQueryPool->results[firstQuery + i], 0);
+        }
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdWriteTimestamp(VkCommandBuffer commandBuffer,
+                                                   VkPipelineStageFlagBits,
+                                                   VkQueryPool,
+                                                   uint32_t) {
+        FromCommandBuffer(commandBuffer)->Record(EntryPoint::CmdWriteTimestamp);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdCopyQueryPoolResults(VkCommandBuffer commandBuffer,
+                                                         VkQueryPool,
+                                                         uint32_t,
+                                                         uint32_t,
+                                                         VkBuffer,
+                                                         VkDeviceSize,
+                                                         VkDeviceSize,
+                                                         VkQueryResultFlags) {
+        FromCommandBuffer(commandBuffer)->Record(EntryPoint::CmdCopyQueryPoolResults);
+    }
+
+    // Ray tracing. Acceleration structures are sized for the maximum number of primitives they
+    // are created for, and the compacted size of a structure is its size.
+
+    VKAPI_ATTR VkResult VKAPI_CALL
+    vkCreateAccelerationStructureKHR(VkDevice device,
+                                     const VkAccelerationStructureCreateInfoKHR* pCreateInfo,
+                                     const VkAllocationCallbacks*,
+                                     VkAccelerationStructureKHR* pAccelerationStructure) {
+        FakeDevice* fakeDevice = FromDevice(device);
+        fakeDevice->Record(EntryPoint::CreateAccelerationStructureKHR);
+        Add(&fakeDevice->statistics.liveObjectCount, 1);
+
+        // The destination of a compacting copy is created with the queried compacted size.
+        VkDeviceSize size = pCreateInfo->compactedSize;
+        if (size == 0) {
+            for (uint32_t i = 0; i < pCreateInfo->maxGeometryCount; ++i) {
+                size += VkDeviceSize(pCreateInfo->pGeometryInfos[i].maxPrimitiveCount) *
+                        kAccelerationStructureNodeSize;
+            }
+        }
+
+        *pAccelerationStructure = ToHandle<VkAccelerationStructureKHR>(
+            new FakeAccelerationStructure{AlignResourceSize(size)});
+        return VK_SUCCESS;
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkGetAccelerationStructureMemoryRequirementsKHR(
+        VkDevice device,
+        const VkAccelerationStructureMemoryRequirementsInfoKHR* pInfo,
+        VkMemoryRequirements2* pMemoryRequirements) {
+        FromDevice(device)->Record(EntryPoint::GetAccelerationStructureMemoryRequirementsKHR);
+
+        // Builds and updates need as much scratch memory as the structure itself.
+        pMemoryRequirements->memoryRequirements = MakeMemoryRequirements(
+            FromHandle<FakeAccelerationStructure>(pInfo->accelerationStructure)->size);
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL
+    vkBindAccelerationStructureMemoryKHR(VkDevice device,
+                                         uint32_t,
+                                         const VkBindAccelerationStructureMemoryInfoKHR*) {
+        FromDevice(device)->Record(EntryPoint::BindAccelerationStructureMemoryKHR);
+        return VK_SUCCESS;
+    }
+
+    VKAPI_ATTR VkDeviceAddress VKAPI_CALL vkGetAccelerationStructureDeviceAddressKHR(
+        VkDevice device,
+        const VkAccelerationStructureDeviceAddressInfoKHR* pInfo) {
+        FromDevice(device)->Record(EntryPoint::GetAccelerationStructureDeviceAddressKHR);
+        return reinterpret_cast<uintptr_t>(
+            FromHandle<FakeAccelerationStructure>(pInfo->accelerationStructure));
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL
+    vkCreateRayTracingPipelinesKHR(VkDevice device,
+                                   VkPipelineCache,
+                                   uint32_t createInfoCount,
+                                   const VkRayTracingPipelineCreateInfoKHR* pCreateInfos,
+                                   const VkAllocationCallbacks*,
+                                   VkPipeline* pPipelines) {
+        FakeDevice* fakeDevice = FromDevice(device);
+        fakeDevice->Record(EntryPoint::CreateRayTracingPipelinesKHR);
+        return CreatePipelines(fakeDevice, createInfoCount, pCreateInfos, pPipelines);
+    }
+
+    VKAPI_ATTR VkResult VKAPI_CALL vkGetRayTracingShaderGroupHandlesKHR(VkDevice device,
+                                                                        VkPipeline,
+                                                                        uint32_t,
+                                                                        uint32_t,
+                                                                        size_t dataSize,
+                                                                        void* pData) {
+        // No shader is ever run, so the handles don't need to identify anything.
+        FromDevice(device)->Record(EntryPoint::GetRayTracingShaderGroupHandlesKHR);
+        memset(pData, 0, dataSize);
+        return VK_SUCCESS;
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdBuildAccelerationStructureKHR(
+        VkCommandBuffer commandBuffer,
+        uint32_t,
+        const VkAccelerationStructureBuildGeometryInfoKHR*,
+        const VkAccelerationStructureBuildOffsetInfoKHR* const*) {
+        FromCommandBuffer(commandBuffer)->Record(EntryPoint::CmdBuildAccelerationStructureKHR);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL
+    vkCmdCopyAccelerationStructureKHR(VkCommandBuffer commandBuffer,
+                                      const VkCopyAccelerationStructureInfoKHR*) {
+        FromCommandBuffer(commandBuffer)->Record(EntryPoint::CmdCopyAccelerationStructureKHR);
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdWriteAccelerationStructuresPropertiesKHR(
+        VkCommandBuffer commandBuffer,
+        uint32_t accelerationStructureCount,
+        const VkAccelerationStructureKHR* pAccelerationStructures,
+        VkQueryType,
+        VkQueryPool queryPool,
+        uint32_t firstQuery) {
+        FromCommandBuffer(commandBuffer)
+            ->Record(EntryPoint::CmdWriteAccelerationStructuresPropertiesKHR);
+
+        // The compacted size is the only property that can be queried.
+        FakeQueryPool* fakeQueryPool = FromHandle<FakeQueryPool>(queryPool);
+        for (uint32_t i = 0; i < accelerationStructureCount; ++i) {
+            Store(&fakeQueryPool->results[firstQuery + i],
+                  FromHandle<FakeAccelerationStructure>(pAccelerationStructures[i])->size);
+        }
+    }
+
+    VKAPI_ATTR void VKAPI_CALL vkCmdTraceRaysKHR(VkCommandBuffer commandBuffer,
+                                                 const VkStridedBufferRegionKHR*,
+                                                 const VkStridedBufferRegionKHR*,
+                                                 const VkStridedBufferRegionKHR*,
+                                                 const VkStridedBufferRegionKHR*,
+                                                 uint32_t,
+                                                 uint32_t,
+                                                 uint32_t) {
+        FromCommandBuffer(commandBuffer)->Record(EntryPoint::CmdTraceRaysKHR);
+    }
+
+    VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL vkGetInstanceProcAddr(VkInstance, const char* pName);
+
+    VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL vkGetDeviceProcAddr(VkDevice, const char* pName) {
+        return vkGetInstanceProcAddr(nullptr, pName);
+    }
+
+    struct ProcEntry {
+        const char* name;
+        PFN_vkVoidFunction proc;
+    };
+
+    // The cast to the PFN_vk* type checks that the fake entry point has the right signature.
+#define FAKE_PROC(name) \
+    { "vk" #name, reinterpret_cast<PFN_vkVoidFunction>(static_cast<PFN_vk##name>(vk##name)) }
+#define FAKE_CREATE_PROC(name, CreateInfo, Handle)                             \
+    {                                                                          \
+        "vk" #name, reinterpret_cast<PFN_vkVoidFunction>(static_cast<PFN_vk##name>( \
+                        CreateObject<EntryPoint::name, CreateInfo, Handle>))   \
+    }
+#define FAKE_DESTROY_PROC(name, Object, Handle)                                \
+    {                                                                          \
+        "vk" #name, reinterpret_cast<PFN_vkVoidFunction>(static_cast<PFN_vk##name>( \
+                        DestroyObject<EntryPoint::name, Object, Handle>))      \
+    }
+
+    const ProcEntry kProcs[] = {
+        FAKE_PROC(CreateInstance),
+        FAKE_PROC(DestroyInstance),
+        FAKE_PROC(EnumerateInstanceExtensionProperties),
+        FAKE_PROC(EnumerateInstanceLayerProperties),
+        FAKE_PROC(GetInstanceProcAddr),
+        FAKE_PROC(CreateDevice),
+        FAKE_PROC(DestroyDevice),
+        FAKE_PROC(EnumerateDeviceExtensionProperties),
+        FAKE_PROC(EnumerateDeviceLayerProperties),
+        FAKE_PROC(EnumeratePhysicalDevices),
+        FAKE_PROC(GetDeviceProcAddr),
+        FAKE_PROC(GetPhysicalDeviceFeatures),
+        FAKE_PROC(GetPhysicalDeviceFeatures2KHR),
+        FAKE_PROC(GetPhysicalDeviceFormatProperties),
+        FAKE_PROC(GetPhysicalDeviceFormatProperties2KHR),
+        FAKE_PROC(GetPhysicalDeviceImageFormatProperties),
+        FAKE_PROC(GetPhysicalDeviceImageFormatProperties2KHR),
+        FAKE_PROC(GetPhysicalDeviceMemoryProperties),
+        FAKE_PROC(GetPhysicalDeviceMemoryProperties2KHR),
+        FAKE_PROC(GetPhysicalDeviceProperties),
+        FAKE_PROC(GetPhysicalDeviceProperties2KHR),
+        FAKE_PROC(GetPhysicalDeviceQueueFamilyProperties),
+        FAKE_PROC(GetPhysicalDeviceQueueFamilyProperties2KHR),
+        FAKE_PROC(GetPhysicalDeviceSparseImageFormatProperties),
+        FAKE_PROC(GetPhysicalDeviceSparseImageFormatProperties2KHR),
+
+        FAKE_PROC(AllocateCommandBuffers),
+        FAKE_PROC(AllocateDescriptorSets),
+        FAKE_PROC(AllocateMemory),
+        FAKE_PROC(BeginCommandBuffer),
+        FAKE_PROC(BindAccelerationStructureMemoryKHR),
+        FAKE_PROC(BindBufferMemory),
+        FAKE_PROC(BindImageMemory),
+        FAKE_PROC(CmdBeginQuery),
+        FAKE_PROC(CmdBeginRenderPass),
+        FAKE_PROC(CmdBindDescriptorSets),
+        FAKE_PROC(CmdBindIndexBuffer),
+        FAKE_PROC(CmdBindPipeline),
+        FAKE_PROC(CmdBindVertexBuffers),
+        FAKE_PROC(CmdBlitImage),
+        FAKE_PROC(CmdBuildAccelerationStructureKHR),
+        FAKE_PROC(CmdClearAttachments),
+        FAKE_PROC(CmdClearColorImage),
+        FAKE_PROC(CmdClearDepthStencilImage),
+        FAKE_PROC(CmdCopyAccelerationStructureKHR),
+        FAKE_PROC(CmdCopyBuffer),
+        FAKE_PROC(CmdCopyBufferToImage),
+        FAKE_PROC(CmdCopyImage),
+        FAKE_PROC(CmdCopyImageToBuffer),
+        FAKE_PROC(CmdCopyQueryPoolResults),
+        FAKE_PROC(CmdDispatch),
+        FAKE_PROC(CmdDispatchIndirect),
+        FAKE_PROC(CmdDraw),
+        FAKE_PROC(CmdDrawIndexed),
+        FAKE_PROC(CmdDrawIndexedIndirect),
+        FAKE_PROC(CmdDrawIndirect),
+        FAKE_PROC(CmdEndQuery),
+        FAKE_PROC(CmdEndRenderPass),
+        FAKE_PROC(CmdExecuteCommands),
+        FAKE_PROC(CmdFillBuffer),
+        FAKE_PROC(CmdNextSubpass),
+        FAKE_PROC(CmdPipelineBarrier),
+        FAKE_PROC(CmdPushConstants),
+        FAKE_PROC(CmdResetEvent),
+        FAKE_PROC(CmdResetQueryPool),
+        FAKE_PROC(CmdResolveImage),
+        FAKE_PROC(CmdSetBlendConstants),
+        FAKE_PROC(CmdSetDepthBias),
+        FAKE_PROC(CmdSetDepthBounds),
+        FAKE_PROC(CmdSetEvent),
+        FAKE_PROC(CmdSetLineWidth),
+        FAKE_PROC(CmdSetScissor),
+        FAKE_PROC(CmdSetStencilCompareMask),
+        FAKE_PROC(CmdSetStencilReference),
+        FAKE_PROC(CmdSetStencilWriteMask),
+        FAKE_PROC(CmdSetViewport),
+        FAKE_PROC(CmdTraceRaysKHR),
+        FAKE_PROC(CmdUpdateBuffer),
+        FAKE_PROC(CmdWaitEvents),
+        FAKE_PROC(CmdWriteAccelerationStructuresPropertiesKHR),
+        FAKE_PROC(CmdWriteTimestamp),
+        FAKE_PROC(CreateAccelerationStructureKHR),
+        FAKE_PROC(CreateBuffer),
+        FAKE_CREATE_PROC(CreateBufferView, VkBufferViewCreateInfo, VkBufferView),
+        FAKE_PROC(CreateCommandPool),
+        FAKE_PROC(CreateComputePipelines),
+        FAKE_PROC(CreateDescriptorPool),
+        FAKE_CREATE_PROC(CreateDescriptorSetLayout,
+                         VkDescriptorSetLayoutCreateInfo,
+                         VkDescriptorSetLayout),
+        FAKE_CREATE_PROC(CreateEvent, VkEventCreateInfo, VkEvent),
+        FAKE_CREATE_PROC(CreateFence, VkFenceCreateInfo, VkFence),
+        FAKE_CREATE_PROC(CreateFramebuffer, VkFramebufferCreateInfo, VkFramebuffer),
+        FAKE_PROC(CreateGraphicsPipelines),
+        FAKE_PROC(CreateImage),
+        FAKE_CREATE_PROC(CreateImageView, VkImageViewCreateInfo, VkImageView),
+        FAKE_CREATE_PROC(CreatePipelineCache, VkPipelineCacheCreateInfo, VkPipelineCache),
+        FAKE_CREATE_PROC(CreatePipelineLayout, VkPipelineLayoutCreateInfo, VkPipelineLayout),
+        FAKE_PROC(CreateQueryPool),
+        FAKE_PROC(CreateRayTracingPipelinesKHR),
+        FAKE_CREATE_PROC(CreateRenderPass, VkRenderPassCreateInfo, VkRenderPass),
+        FAKE_CREATE_PROC(CreateSampler, VkSamplerCreateInfo, VkSampler),
+        FAKE_CREATE_PROC(CreateSemaphore, VkSemaphoreCreateInfo, VkSemaphore),
+        FAKE_CREATE_PROC(CreateShaderModule, VkShaderModuleCreateInfo, VkShaderModule),
+        FAKE_DESTROY_PROC(DestroyAccelerationStructureKHR,
+                          FakeAccelerationStructure,
+                          VkAccelerationStructureKHR),
+        FAKE_DESTROY_PROC(DestroyBuffer, FakeBuffer, VkBuffer),
+        FAKE_DESTROY_PROC(DestroyBufferView, FakeObject, VkBufferView),
+        FAKE_PROC(DestroyCommandPool),
+        FAKE_PROC(DestroyDescriptorPool),
+        FAKE_DESTROY_PROC(DestroyDescriptorSetLayout, FakeObject, VkDescriptorSetLayout),
+        FAKE_DESTROY_PROC(DestroyEvent, FakeObject, VkEvent),
+        FAKE_DESTROY_PROC(DestroyFence, FakeObject, VkFence),
+        FAKE_DESTROY_PROC(DestroyFramebuffer, FakeObject, VkFramebuffer),
+        FAKE_DESTROY_PROC(DestroyImage, FakeImage, VkImage),
+        FAKE_DESTROY_PROC(DestroyImageView, FakeObject, VkImageView),
+        FAKE_DESTROY_PROC(DestroyPipeline, FakeObject, VkPipeline),
+        FAKE_DESTROY_PROC(DestroyPipelineCache, FakeObject, VkPipelineCache),
+        FAKE_DESTROY_PROC(DestroyPipelineLayout, FakeObject, VkPipelineLayout),
+        FAKE_DESTROY_PROC(DestroyQueryPool, FakeQueryPool, VkQueryPool),
+        FAKE_DESTROY_PROC(DestroyRenderPass, FakeObject, VkRenderPass),
+        FAKE_DESTROY_PROC(DestroySampler, FakeObject, VkSampler),
+        FAKE_DESTROY_PROC(DestroySemaphore, FakeObject, VkSemaphore),
+        FAKE_DESTROY_PROC(DestroyShaderModule, FakeObject, VkShaderModule),
+        FAKE_PROC(DeviceWaitIdle),
+        FAKE_PROC(EndCommandBuffer),
+        FAKE_PROC(FlushMappedMemoryRanges),
+        FAKE_PROC(FreeCommandBuffers),
+        FAKE_PROC(FreeDescriptorSets),
+        FAKE_PROC(FreeMemory),
+        FAKE_PROC(GetAccelerationStructureDeviceAddressKHR),
+        FAKE_PROC(GetAccelerationStructureMemoryRequirementsKHR),
+        FAKE_PROC(GetBufferDeviceAddressKHR),
+        FAKE_PROC(GetBufferMemoryRequirements),
+        FAKE_PROC(GetBufferMemoryRequirements2),
+        FAKE_PROC(GetDeviceMemoryCommitment),
+        FAKE_PROC(GetDeviceQueue),
+        FAKE_PROC(GetEventStatus),
+        FAKE_PROC(GetFenceStatus),
+        FAKE_PROC(GetImageMemoryRequirements),
+        FAKE_PROC(GetImageSparseMemoryRequirements),
+        FAKE_PROC(GetImageSubresourceLayout),
+        FAKE_PROC(GetPipelineCacheData),
+        FAKE_PROC(GetQueryPoolResults),
+        FAKE_PROC(GetRayTracingShaderGroupHandlesKHR),
+        FAKE_PROC(GetRenderAreaGranularity),
+        FAKE_PROC(InvalidateMappedMemoryRanges),
+        FAKE_PROC(MapMemory),
+        FAKE_PROC(MergePipelineCaches),
+        FAKE_PROC(QueueBindSparse),
+        FAKE_PROC(QueueSubmit),
+        FAKE_PROC(QueueWaitIdle),
+        FAKE_PROC(ResetCommandBuffer),
+        FAKE_PROC(ResetCommandPool),
+        FAKE_PROC(ResetDescriptorPool),
+        FAKE_PROC(ResetEvent),
+        FAKE_PROC(ResetFences),
+        FAKE_PROC(SetEvent),
+        FAKE_PROC(UnmapMemory),
+        FAKE_PROC(UpdateDescriptorSets),
+        FAKE_PROC(WaitForFences),
+    };
+
+#undef FAKE_PROC
+#undef FAKE_CREATE_PROC
+#undef FAKE_DESTROY_PROC
+
+    VKAPI_ATTR PFN_vkVoidFunction VKAPI_CALL vkGetInstanceProcAddr(VkInstance, const char* pName) {
+        for (const ProcEntry& entry : kProcs) {
+            if (strcmp(entry.name, pName) == 0) {
+                return entry.proc;
+            }
+        }
+        return nullptr;
+    }
+
+}  // anonymous namespace
+
+namespace dawn_native { namespace vulkan {
+
+    PFN_vkGetInstanceProcAddr GetFakeDriverInstanceProcAddr() {
+        return vkGetInstanceProcAddr;
+    }
+
+    FakeDriverStatistics GetFakeDeviceStatistics(VkDevice device) {
+        const FakeDevice* fakeDevice = FromDevice(device);
+        const AtomicStatistics& counters = fakeDevice->statistics;
+
+        FakeDriverStatistics statistics;
+        for (const std::atomic<uint64_t>& callCount : fakeDevice->callCounts) {
+            statistics.callCount += Load(callCount);
+        }
+        statistics.queueSubmitCount = Load(counters.queueSubmitCount);
+        statistics.submittedCommandBufferCount = Load(counters.submittedCommandBufferCount);
+        statistics.pipelineBarrierCount = Load(counters.pipelineBarrierCount);
+        statistics.memoryBarrierCount = Load(counters.memoryBarrierCount);
+        statistics.bufferMemoryBarrierCount = Load(counters.bufferMemoryBarrierCount);
+        statistics.imageMemoryBarrierCount = Load(counters.imageMemoryBarrierCount);
+        statistics.descriptorSetAllocationCount = Load(counters.descriptorSetAllocationCount);
+        statistics.descriptorWriteCount = Load(counters.descriptorWriteCount);
+        statistics.descriptorCopyCount = Load(counters.descriptorCopyCount);
+        statistics.memoryAllocationCount = Load(counters.memoryAllocationCount);
+        statistics.memoryAllocationSize = Load(counters.memoryAllocationSize);
+        statistics.liveMemorySize = Load(counters.liveMemorySize);
+        statistics.liveObjectCount = Load(counters.liveObjectCount);
+        statistics.renderPassCount = Load(counters.renderPassCount);
+        statistics.drawCount = Load(counters.drawCount);
+        statistics.dispatchCount = Load(counters.dispatchCount);
+        statistics.copyCount = Load(counters.copyCount);
+        return statistics;
+    }
+
+    uint64_t GetFakeDeviceCallCount(VkDevice device, const char* entryPoint) {
+        for (size_t i = 0; i < kEntryPointCount; ++i) {
+            if (strcmp(kEntryPointNames[i], entryPoint) == 0) {
+                return Load(FromDevice(device)->callCounts[i]);
+            }
+        }
+        return 0;
+    }
+
+}}  // namespace dawn_native::vulkan
@@ -0,0 +1,41 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_VULKAN_FAKEVULKANDRIVER_H_
+#define DAWNNATIVE_VULKAN_FAKEVULKANDRIVER_H_
+
+#include "common/vulkan_platform.h"
+#include "dawn_native/VulkanBackend.h"
+
+namespace dawn_native { namespace vulkan {
+
+    // The fake driver exposes a single CPU physical device with one universal queue, one memory
+    // type that is both device local and host visible, and every format feature. It implements the
+    // core Vulkan 1.0 entry points, KHR_maintenance1, and KHR_ray_tracing with the extensions it
+    // depends on, so that its adapter supports the RayTracing extension. Objects only keep the
+    // state needed to answer queries, for example buffer and acceleration structure sizes, and
+    // memory gets storage only when it is mapped. Fences are always signaled since no work is
+    // executed, so acceleration structures are never actually built or traversed.
+    //
+    // Each fake VkDevice records how many times each of its entry points is called and counters
+    // of their arguments. Entry points can be called concurrently as allowed by Vulkan.
+    PFN_vkGetInstanceProcAddr GetFakeDriverInstanceProcAddr();
+
+    // |device| must have been created by the fake driver.
+    FakeDriverStatistics GetFakeDeviceStatistics(VkDevice device);
+    uint64_t GetFakeDeviceCallCount(VkDevice device, const char* entryPoint);
+
+}}  // namespace dawn_native::vulkan
+
+#endif  // DAWNNATIVE_VULKAN_FAKEVULKANDRIVER_H_
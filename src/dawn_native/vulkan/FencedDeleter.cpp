@@ -16,168 +16,219 @@
 
 #include "dawn_native/vulkan/DeviceVk.h"
 
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
 namespace dawn_native { namespace vulkan {
 
+    namespace {
+
+        // Non-dispatchable handles are 64-bit on all platforms, either as pointers or integers,
+        // so they are stored as uint64_t in the type-erased records. The conversions go through
+        // the native handle type because the VkHandle wrappers aren't trivially copyable.
+        template <typename Tag, typename NativeHandle>
+        uint64_t HandleToUint64(detail::VkHandle<Tag, NativeHandle> handle) {
+            static_assert(sizeof(NativeHandle) == sizeof(uint64_t), "");
+            NativeHandle nativeHandle = handle.GetHandle();
+            uint64_t value;
+            memcpy(&value, &nativeHandle, sizeof(value));
+            return value;
+        }
+
+        template <typename Handle>
+        Handle Uint64ToHandle(uint64_t value) {
+            using NativeHandle = decltype(std::declval<Handle>().GetHandle());
+            static_assert(sizeof(NativeHandle) == sizeof(uint64_t), "");
+            NativeHandle nativeHandle;
+            memcpy(&nativeHandle, &value, sizeof(value));
+            return Handle::CreateFromHandle(nativeHandle);
+        }
+
+    }  // anonymous namespace
+
     FencedDeleter::FencedDeleter(Device* device) : mDevice(device) {
     }
 
     FencedDeleter::~FencedDeleter() {
-        ASSERT(mBuffersToDelete.Empty());
-        ASSERT(mAccelerationStructuresToDelete.Empty());
-        ASSERT(mDescriptorPoolsToDelete.Empty());
-        ASSERT(mFramebuffersToDelete.Empty());
-        ASSERT(mImagesToDelete.Empty());
-        ASSERT(mImageViewsToDelete.Empty());
-        ASSERT(mMemoriesToDelete.Empty());
-        ASSERT(mPipelinesToDelete.Empty());
-        ASSERT(mPipelineLayoutsToDelete.Empty());
-        ASSERT(mRenderPassesToDelete.Empty());
-        ASSERT(mSamplersToDelete.Empty());
-        ASSERT(mSemaphoresToDelete.Empty());
-        ASSERT(mShaderModulesToDelete.Empty());
-        ASSERT(mSurfacesToDelete.Empty());
-        ASSERT(mSwapChainsToDelete.Empty());
+        ASSERT(mReleasedHandles.Empty());
+        ASSERT(mHandlesToDelete.Empty());
     }
 
     void FencedDeleter::DeleteWhenUnused(VkBuffer buffer) {
-        mBuffersToDelete.Enqueue(buffer, mDevice->GetPendingCommandSerial());
+        Release(HandleType::Buffer, buffer);
     }
 
     void FencedDeleter::DeleteWhenUnused(VkAccelerationStructureKHR as) {
-        mAccelerationStructuresToDelete.Enqueue(as, mDevice->GetPendingCommandSerial());
+        Release(HandleType::AccelerationStructure, as);
+    }
+
+    void FencedDeleter::DeleteWhenUnused(VkCommandPool pool) {
+        Release(HandleType::CommandPool, pool);
     }
 
     void FencedDeleter::DeleteWhenUnused(VkDescriptorPool pool) {
-        mDescriptorPoolsToDelete.Enqueue(pool, mDevice->GetPendingCommandSerial());
+        Release(HandleType::DescriptorPool, pool);
     }
 
     void FencedDeleter::DeleteWhenUnused(VkDeviceMemory memory) {
-        mMemoriesToDelete.Enqueue(memory, mDevice->GetPendingCommandSerial());
+        Release(HandleType::DeviceMemory, memory);
     }
 
     void FencedDeleter::DeleteWhenUnused(VkFramebuffer framebuffer) {
-        mFramebuffersToDelete.Enqueue(framebuffer, mDevice->GetPendingCommandSerial());
+        Release(HandleType::Framebuffer, framebuffer);
     }
 
     void FencedDeleter::DeleteWhenUnused(VkImage image) {
-        mImagesToDelete.Enqueue(image, mDevice->GetPendingCommandSerial());
+        Release(HandleType::Image, image);
     }
 
     void FencedDeleter::DeleteWhenUnused(VkImageView view) {
-        mImageViewsToDelete.Enqueue(view, mDevice->GetPendingCommandSerial());
+        Release(HandleType::ImageView, view);
     }
 
     void FencedDeleter::DeleteWhenUnused(VkPipeline pipeline) {
-        mPipelinesToDelete.Enqueue(pipeline, mDevice->GetPendingCommandSerial());
+        Release(HandleType::Pipeline, pipeline);
     }
 
     void FencedDeleter::DeleteWhenUnused(VkPipelineLayout layout) {
-        mPipelineLayoutsToDelete.Enqueue(layout, mDevice->GetPendingCommandSerial());
+        Release(HandleType::PipelineLayout, layout);
+    }
+
+    void FencedDeleter::DeleteWhenUnused(VkQueryPool pool) {
+        Release(HandleType::QueryPool, pool);
     }
 
     void FencedDeleter::DeleteWhenUnused(VkRenderPass renderPass) {
-        mRenderPassesToDelete.Enqueue(renderPass, mDevice->GetPendingCommandSerial());
+        Release(HandleType::RenderPass, renderPass);
     }
 
     void FencedDeleter::DeleteWhenUnused(VkSampler sampler) {
-        mSamplersToDelete.Enqueue(sampler, mDevice->GetPendingCommandSerial());
+        Release(HandleType::Sampler, sampler);
     }
 
     void FencedDeleter::DeleteWhenUnused(VkSemaphore semaphore) {
-        mSemaphoresToDelete.Enqueue(semaphore, mDevice->GetPendingCommandSerial());
+        Release(HandleType::Semaphore, semaphore);
     }
 
     void FencedDeleter::DeleteWhenUnused(VkShaderModule module) {
-        mShaderModulesToDelete.Enqueue(module, mDevice->GetPendingCommandSerial());
+        Release(HandleType::ShaderModule, module);
     }
 
     void FencedDeleter::DeleteWhenUnused(VkSurfaceKHR surface) {
-        mSurfacesToDelete.Enqueue(surface, mDevice->GetPendingCommandSerial());
+        Release(HandleType::Surface, surface);
     }
 
     void FencedDeleter::DeleteWhenUnused(VkSwapchainKHR swapChain) {
-        mSwapChainsToDelete.Enqueue(swapChain, mDevice->GetPendingCommandSerial());
+        Release(HandleType::SwapChain, swapChain);
     }
 
-    void FencedDeleter::Tick(Serial completedSerial) {
-        VkDevice vkDevice = mDevice->GetVkDevice();
-        VkInstance instance = mDevice->GetVkInstance();
-
-        // Buffers and images must be deleted before memories because it is invalid to free memory
-        // that still have resources bound to it.
-        for (VkBuffer buffer : mBuffersToDelete.IterateUpTo(completedSerial)) {
-            mDevice->fn.DestroyBuffer(vkDevice, buffer, nullptr);
-        }
-        mBuffersToDelete.ClearUpTo(completedSerial);
-        for (VkAccelerationStructureKHR as :
-             mAccelerationStructuresToDelete.IterateUpTo(completedSerial)) {
-            mDevice->fn.DestroyAccelerationStructureKHR(vkDevice, as, nullptr);
-        }
-        mAccelerationStructuresToDelete.ClearUpTo(completedSerial);
-        for (VkImage image : mImagesToDelete.IterateUpTo(completedSerial)) {
-            mDevice->fn.DestroyImage(vkDevice, image, nullptr);
-        }
-        mImagesToDelete.ClearUpTo(completedSerial);
-
-        for (VkDeviceMemory memory : mMemoriesToDelete.IterateUpTo(completedSerial)) {
-            mDevice->fn.FreeMemory(vkDevice, memory, nullptr);
-        }
-        mMemoriesToDelete.ClearUpTo(completedSerial);
-
-        for (VkPipelineLayout layout : mPipelineLayoutsToDelete.IterateUpTo(completedSerial)) {
-            mDevice->fn.DestroyPipelineLayout(vkDevice, layout, nullptr);
-        }
-        mPipelineLayoutsToDelete.ClearUpTo(completedSerial);
-
-        for (VkRenderPass renderPass : mRenderPassesToDelete.IterateUpTo(completedSerial)) {
-            mDevice->fn.DestroyRenderPass(vkDevice, renderPass, nullptr);
-        }
-        mRenderPassesToDelete.ClearUpTo(completedSerial);
-
-        for (VkFramebuffer framebuffer : mFramebuffersToDelete.IterateUpTo(completedSerial)) {
-            mDevice->fn.DestroyFramebuffer(vkDevice, framebuffer, nullptr);
-        }
-        mFramebuffersToDelete.ClearUpTo(completedSerial);
-
-        for (VkImageView view : mImageViewsToDelete.IterateUpTo(completedSerial)) {
-            mDevice->fn.DestroyImageView(vkDevice, view, nullptr);
-        }
-        mImageViewsToDelete.ClearUpTo(completedSerial);
+    template <typename Handle>
+    void FencedDeleter::Release(HandleType type, Handle handle) {
+        mReleasedHandles.Push({type, HandleToUint64(handle)});
+    }
 
-        for (VkShaderModule module : mShaderModulesToDelete.IterateUpTo(completedSerial)) {
-            mDevice->fn.DestroyShaderModule(vkDevice, module, nullptr);
-        }
-        mShaderModulesToDelete.ClearUpTo(completedSerial);
+    void FencedDeleter::EnqueueReleasedHandles() {
+        Serial pendingSerial = mDevice->GetPendingCommandSerial();
+        mReleasedHandles.Drain([&](const ReleasedHandle& handle) {
+            mHandlesToDelete.Enqueue(handle, pendingSerial);
+        });
+    }
 
-        for (VkPipeline pipeline : mPipelinesToDelete.IterateUpTo(completedSerial)) {
-            mDevice->fn.DestroyPipeline(vkDevice, pipeline, nullptr);
-        }
-        mPipelinesToDelete.ClearUpTo(completedSerial);
+    void FencedDeleter::Tick(Serial completedSerial) {
+        EnqueueReleasedHandles();
 
-        // Vulkan swapchains must be destroyed before their corresponding VkSurface
-        for (VkSwapchainKHR swapChain : mSwapChainsToDelete.IterateUpTo(completedSerial)) {
-            mDevice->fn.DestroySwapchainKHR(vkDevice, swapChain, nullptr);
+        ASSERT(mHandlesToDestroy.empty());
+        for (const ReleasedHandle& handle : mHandlesToDelete.IterateUpTo(completedSerial)) {
+            mHandlesToDestroy.push_back(handle);
         }
-        mSwapChainsToDelete.ClearUpTo(completedSerial);
-        for (VkSurfaceKHR surface : mSurfacesToDelete.IterateUpTo(completedSerial)) {
-            mDevice->fn.DestroySurfaceKHR(instance, surface, nullptr);
+        mHandlesToDelete.ClearUpTo(completedSerial);
+
+        // Handles that become unused at the same time are destroyed in the order of their types
+        // so that objects are destroyed before the objects they depend on.
+        std::sort(mHandlesToDestroy.begin(), mHandlesToDestroy.end(),
+                  [](const ReleasedHandle& a, const ReleasedHandle& b) { return a.type < b.type; });
+        for (const ReleasedHandle& handle : mHandlesToDestroy) {
+            Destroy(handle);
         }
-        mSurfacesToDelete.ClearUpTo(completedSerial);
-
-        for (VkSemaphore semaphore : mSemaphoresToDelete.IterateUpTo(completedSerial)) {
-            mDevice->fn.DestroySemaphore(vkDevice, semaphore, nullptr);
-        }
-        mSemaphoresToDelete.ClearUpTo(completedSerial);
+        mHandlesToDestroy.clear();
+    }
 
-        for (VkDescriptorPool pool : mDescriptorPoolsToDelete.IterateUpTo(completedSerial)) {
-            mDevice->fn.DestroyDescriptorPool(vkDevice, pool, nullptr);
+    uint64_t FencedDeleter::GetPendingDeletionCount() const {
+        uint64_t count = 0;
+        for (const ReleasedHandle& handle : mHandlesToDelete.IterateAll()) {
+            DAWN_UNUSED(handle);
+            count++;
         }
-        mDescriptorPoolsToDelete.ClearUpTo(completedSerial);
+        return count;
+    }
 
-        for (VkSampler sampler : mSamplersToDelete.IterateUpTo(completedSerial)) {
-            mDevice->fn.DestroySampler(vkDevice, sampler, nullptr);
+    void FencedDeleter::Destroy(const ReleasedHandle& handle) {
+        VkDevice vkDevice = mDevice->GetVkDevice();
+        uint64_t value = handle.handle;
+
+        switch (handle.type) {
+            case HandleType::CommandPool:
+                mDevice->fn.DestroyCommandPool(
+                    vkDevice, Uint64ToHandle<VkCommandPool>(value), nullptr);
+                break;
+            case HandleType::Buffer:
+                mDevice->fn.DestroyBuffer(vkDevice, Uint64ToHandle<VkBuffer>(value), nullptr);
+                break;
+            case HandleType::AccelerationStructure:
+                mDevice->fn.DestroyAccelerationStructureKHR(
+                    vkDevice, Uint64ToHandle<VkAccelerationStructureKHR>(value), nullptr);
+                break;
+            case HandleType::Image:
+                mDevice->fn.DestroyImage(vkDevice, Uint64ToHandle<VkImage>(value), nullptr);
+                break;
+            case HandleType::DeviceMemory:
+                mDevice->fn.FreeMemory(vkDevice, Uint64ToHandle<VkDeviceMemory>(value), nullptr);
+                break;
+            case HandleType::PipelineLayout:
+                mDevice->fn.DestroyPipelineLayout(
+                    vkDevice, Uint64ToHandle<VkPipelineLayout>(value), nullptr);
+                break;
+            case HandleType::RenderPass:
+                mDevice->fn.DestroyRenderPass(
+                    vkDevice, Uint64ToHandle<VkRenderPass>(value), nullptr);
+                break;
+            case HandleType::Framebuffer:
+                mDevice->fn.DestroyFramebuffer(
+                    vkDevice, Uint64ToHandle<VkFramebuffer>(value), nullptr);
+                break;
+            case HandleType::ImageView:
+                mDevice->fn.DestroyImageView(vkDevice, Uint64ToHandle<VkImageView>(value), nullptr);
+                break;
+            case HandleType::ShaderModule:
+                mDevice->fn.DestroyShaderModule(
+                    vkDevice, Uint64ToHandle<VkShaderModule>(value), nullptr);
+                break;
+            case HandleType::Pipeline:
+                mDevice->fn.DestroyPipeline(vkDevice, Uint64ToHandle<VkPipeline>(value), nullptr);
+                break;
+            case HandleType::QueryPool:
+                mDevice->fn.DestroyQueryPool(vkDevice, Uint64ToHandle<VkQueryPool>(value), nullptr);
+                break;
+            case HandleType::SwapChain:
+                mDevice->fn.DestroySwapchainKHR(
+                    vkDevice, Uint64ToHandle<VkSwapchainKHR>(value), nullptr);
+                break;
+            case HandleType::Surface:
+                mDevice->fn.DestroySurfaceKHR(
+                    mDevice->GetVkInstance(), Uint64ToHandle<VkSurfaceKHR>(value), nullptr);
+                break;
+            case HandleType::Semaphore:
+                mDevice->fn.DestroySemaphore(vkDevice, Uint64ToHandle<VkSemaphore>(value), nullptr);
+                break;
+            case HandleType::DescriptorPool:
+                mDevice->fn.DestroyDescriptorPool(
+                    vkDevice, Uint64ToHandle<VkDescriptorPool>(value), nullptr);
+                break;
+            case HandleType::Sampler:
+                mDevice->fn.DestroySampler(vkDevice, Uint64ToHandle<VkSampler>(value), nullptr);
+                break;
         }
-        mSamplersToDelete.ClearUpTo(completedSerial);
     }
 
 }}  // namespace dawn_native::vulkan
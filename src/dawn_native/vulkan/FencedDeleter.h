@@ -15,13 +15,25 @@
 #ifndef DAWNNATIVE_VULKAN_FENCEDDELETER_H_
 #define DAWNNATIVE_VULKAN_FENCEDDELETER_H_
 
+#include "common/MPSCQueue.h"
 #include "common/SerialQueue.h"
 #include "common/vulkan_platform.h"
 
+#include <cstdint>
+#include <vector>
+
 namespace dawn_native { namespace vulkan {
 
     class Device;
 
+    // FencedDeleter destroys Vulkan handles once the GPU is done with the commands that were
+    // submitted before they were released.
+    //
+    // DeleteWhenUnused can be called from any thread: released handles are pushed on a lock-free
+    // queue that the device thread drains when it submits commands or ticks, enqueuing them with
+    // the pending serial. That serial is at least the one of the last commands that could use the
+    // handles, since they were submitted before the handles were released. All the handle types
+    // share the same queue, as type-erased records.
     class FencedDeleter {
       public:
         FencedDeleter(Device* device);
@@ -29,6 +41,7 @@ namespace dawn_native { namespace vulkan {
 
         void DeleteWhenUnused(VkBuffer buffer);
         void DeleteWhenUnused(VkAccelerationStructureKHR as);
+        void DeleteWhenUnused(VkCommandPool pool);
         void DeleteWhenUnused(VkDescriptorPool pool);
         void DeleteWhenUnused(VkDeviceMemory memory);
         void DeleteWhenUnused(VkFramebuffer framebuffer);
@@ -37,31 +50,65 @@ namespace dawn_native { namespace vulkan {
         void DeleteWhenUnused(VkPipelineLayout layout);
         void DeleteWhenUnused(VkRenderPass renderPass);
         void DeleteWhenUnused(VkPipeline pipeline);
+        void DeleteWhenUnused(VkQueryPool pool);
         void DeleteWhenUnused(VkSampler sampler);
         void DeleteWhenUnused(VkSemaphore semaphore);
         void DeleteWhenUnused(VkShaderModule module);
         void DeleteWhenUnused(VkSurfaceKHR surface);
         void DeleteWhenUnused(VkSwapchainKHR swapChain);
 
+        // Enqueues the handles released so far with the pending serial. Called on the device
+        // thread before the pending serial is submitted.
+        void EnqueueReleasedHandles();
+
         void Tick(Serial completedSerial);
 
+        // The number of handles enqueued with a serial that isn't completed yet, for the device
+        // statistics. Handles released since the last EnqueueReleasedHandles aren't counted.
+        uint64_t GetPendingDeletionCount() const;
+
       private:
+        // The types of handles, in the order they are destroyed when they are unused at the same
+        // time.
+        enum class HandleType : uint8_t {
+            // Command pools are deleted first because their command buffers can reference the
+            // other objects.
+            CommandPool,
+            // Buffers and images must be deleted before memories because it is invalid to free
+            // memory that still have resources bound to it.
+            Buffer,
+            AccelerationStructure,
+            Image,
+            DeviceMemory,
+            PipelineLayout,
+            RenderPass,
+            Framebuffer,
+            ImageView,
+            ShaderModule,
+            Pipeline,
+            QueryPool,
+            // Vulkan swapchains must be destroyed before their corresponding VkSurface
+            SwapChain,
+            Surface,
+            Semaphore,
+            DescriptorPool,
+            Sampler,
+        };
+
+        struct ReleasedHandle {
+            HandleType type;
+            uint64_t handle;
+        };
+
+        template <typename Handle>
+        void Release(HandleType type, Handle handle);
+        void Destroy(const ReleasedHandle& handle);
+
         Device* mDevice = nullptr;
-        SerialQueue<VkBuffer> mBuffersToDelete;
-        SerialQueue<VkAccelerationStructureKHR> mAccelerationStructuresToDelete;
-        SerialQueue<VkDescriptorPool> mDescriptorPoolsToDelete;
-        SerialQueue<VkDeviceMemory> mMemoriesToDelete;
-        SerialQueue<VkFramebuffer> mFramebuffersToDelete;
-        SerialQueue<VkImage> mImagesToDelete;
-        SerialQueue<VkImageView> mImageViewsToDelete;
-        SerialQueue<VkPipeline> mPipelinesToDelete;
-        SerialQueue<VkPipelineLayout> mPipelineLayoutsToDelete;
-        SerialQueue<VkRenderPass> mRenderPassesToDelete;
-        SerialQueue<VkSampler> mSamplersToDelete;
-        SerialQueue<VkSemaphore> mSemaphoresToDelete;
-        SerialQueue<VkShaderModule> mShaderModulesToDelete;
-        SerialQueue<VkSurfaceKHR> mSurfacesToDelete;
-        SerialQueue<VkSwapchainKHR> mSwapChainsToDelete;
+        MPSCQueue<ReleasedHandle> mReleasedHandles;
+        SerialQueue<ReleasedHandle> mHandlesToDelete;
+        // Scratch storage for the handles destroyed in Tick, kept to reuse its memory.
+        std::vector<ReleasedHandle> mHandlesToDestroy;
     };
 
 }}  // namespace dawn_native::vulkan
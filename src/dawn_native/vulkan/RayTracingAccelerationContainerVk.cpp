@@ -15,6 +15,7 @@
 #include "dawn_native/vulkan/RayTracingAccelerationContainerVk.h"
 
 #include "common/Math.h"
+#include "dawn_native/DynamicUploader.h"
 #include "dawn_native/vulkan/DeviceVk.h"
 #include "dawn_native/vulkan/FencedDeleter.h"
 #include "dawn_native/vulkan/ResourceHeapVk.h"
@@ -66,17 +67,7 @@ namespace dawn_native { namespace vulkan {
 
     void RayTracingAccelerationContainer::DestroyImpl() {
         Device* device = ToBackend(GetDevice());
-        DestroyScratchBuildMemory();
-        if (mScratchMemory.result.buffer != VK_NULL_HANDLE) {
-            device->DeallocateMemory(&mScratchMemory.result.resource);
-            device->GetFencedDeleter()->DeleteWhenUnused(mScratchMemory.result.buffer);
-            mScratchMemory.result.buffer = VK_NULL_HANDLE;
-        }
-        if (mScratchMemory.update.buffer != VK_NULL_HANDLE) {
-            device->DeallocateMemory(&mScratchMemory.update.resource);
-            device->GetFencedDeleter()->DeleteWhenUnused(mScratchMemory.update.buffer);
-            mScratchMemory.update.buffer = VK_NULL_HANDLE;
-        }
+        ReleaseScratchMemory(device, mResultMemory);
         if (mInstanceMemory.buffer != VK_NULL_HANDLE) {
             Buffer* buffer = mInstanceMemory.allocation.Get();
             if (buffer != nullptr) {
@@ -89,6 +80,10 @@ namespace dawn_native { namespace vulkan {
             device->GetFencedDeleter()->DeleteWhenUnused(mAccelerationStructure);
             mAccelerationStructure = VK_NULL_HANDLE;
         }
+        if (mCompactedSizeQueryPool != VK_NULL_HANDLE) {
+            device->GetFencedDeleter()->DeleteWhenUnused(mCompactedSizeQueryPool);
+            mCompactedSizeQueryPool = VK_NULL_HANDLE;
+        }
     }
 
     MaybeError RayTracingAccelerationContainer::Initialize(
@@ -211,33 +206,25 @@ namespace dawn_native { namespace vulkan {
                 return result.AcquireError();
         }
 
-        // reserve scratch memory
+        // reserve result memory, scratch memory is borrowed from the device when building
         {
             VkMemoryRequirements resultRequirements = GetMemoryRequirements(
                 VK_ACCELERATION_STRUCTURE_MEMORY_REQUIREMENTS_TYPE_OBJECT_KHR);
+            DAWN_TRY(AllocateScratchMemory(device, mResultMemory, resultRequirements));
+        }
 
-            VkMemoryRequirements buildRequirements = GetMemoryRequirements(
-                VK_ACCELERATION_STRUCTURE_MEMORY_REQUIREMENTS_TYPE_BUILD_SCRATCH_KHR);
-
-            VkMemoryRequirements updateRequirements = GetMemoryRequirements(
-                VK_ACCELERATION_STRUCTURE_MEMORY_REQUIREMENTS_TYPE_UPDATE_SCRATCH_KHR);
-
-            DAWN_TRY(AllocateScratchMemory(mScratchMemory.result, resultRequirements));
-            DAWN_TRY(AllocateScratchMemory(mScratchMemory.build, buildRequirements));
-            // update memory is optional
-            if (updateRequirements.size > 0) {
-                DAWN_TRY(AllocateScratchMemory(mScratchMemory.update, updateRequirements));
-            }
+        if (GetUsage() & wgpu::RayTracingAccelerationContainerUsage::AllowCompaction) {
+            DAWN_TRY(CreateCompactedSizeQueryPool());
         }
 
-        // bind scratch result memory
+        // bind result memory
         {
             VkBindAccelerationStructureMemoryInfoKHR memoryBindInfo;
             memoryBindInfo.sType = VK_STRUCTURE_TYPE_BIND_ACCELERATION_STRUCTURE_MEMORY_INFO_KHR;
             memoryBindInfo.pNext = nullptr;
             memoryBindInfo.accelerationStructure = GetAccelerationStructure();
-            memoryBindInfo.memory = mScratchMemory.result.memory;
-            memoryBindInfo.memoryOffset = mScratchMemory.result.offset;
+            memoryBindInfo.memory = mResultMemory.memory;
+            memoryBindInfo.memoryOffset = mResultMemory.offset;
             memoryBindInfo.deviceIndexCount = 0;
             memoryBindInfo.pDeviceIndices = nullptr;
 
@@ -266,21 +253,62 @@ namespace dawn_native { namespace vulkan {
         DestroyInternal();
     }
 
-    void RayTracingAccelerationContainer::DestroyScratchBuildMemory() {
+    VkMemoryRequirements RayTracingAccelerationContainer::GetScratchBuildMemoryRequirements()
+        const {
+        return GetMemoryRequirements(
+            VK_ACCELERATION_STRUCTURE_MEMORY_REQUIREMENTS_TYPE_BUILD_SCRATCH_KHR);
+    }
+
+    VkMemoryRequirements RayTracingAccelerationContainer::GetScratchUpdateMemoryRequirements()
+        const {
+        return GetMemoryRequirements(
+            VK_ACCELERATION_STRUCTURE_MEMORY_REQUIREMENTS_TYPE_UPDATE_SCRATCH_KHR);
+    }
+
+    MaybeError RayTracingAccelerationContainer::CreateCompactedSizeQueryPool() {
         Device* device = ToBackend(GetDevice());
-        // delete scratch build memory
-        if (mScratchMemory.build.buffer != VK_NULL_HANDLE) {
-            device->DeallocateMemory(&mScratchMemory.build.resource);
-            device->GetFencedDeleter()->DeleteWhenUnused(mScratchMemory.build.buffer);
-            mScratchMemory.build.buffer = VK_NULL_HANDLE;
-        }
+
+        VkQueryPoolCreateInfo createInfo;
+        createInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        createInfo.pNext = nullptr;
+        createInfo.flags = 0;
+        createInfo.queryType = VK_QUERY_TYPE_ACCELERATION_STRUCTURE_COMPACTED_SIZE_KHR;
+        createInfo.queryCount = 1;
+        createInfo.pipelineStatistics = 0;
+
+        return CheckVkSuccess(device->fn.CreateQueryPool(device->GetVkDevice(), &createInfo,
+                                                         nullptr, &*mCompactedSizeQueryPool),
+                              "vkCreateQueryPool");
     }
 
-    MaybeError RayTracingAccelerationContainer::AllocateScratchMemory(
-        MemoryEntry& memoryEntry,
-        VkMemoryRequirements& requirements) {
+    ResultOrError<uint64_t> RayTracingAccelerationContainer::GetCompactedSizeImpl() {
         Device* device = ToBackend(GetDevice());
+        ASSERT(mCompactedSizeQueryPool != VK_NULL_HANDLE);
+
+        uint64_t compactedSize = 0;
+        DAWN_TRY(CheckVkSuccess(
+            device->fn.GetQueryPoolResults(device->GetVkDevice(), mCompactedSizeQueryPool, 0, 1,
+                                           sizeof(uint64_t), &compactedSize, sizeof(uint64_t),
+                                           VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT),
+            "vkGetQueryPoolResults"));
+        return compactedSize;
+    }
+
+    VkQueryPool RayTracingAccelerationContainer::GetCompactedSizeQueryPool() const {
+        return mCompactedSizeQueryPool;
+    }
+
+    void ReleaseScratchMemory(Device* device, MemoryEntry& memoryEntry) {
+        if (memoryEntry.buffer != VK_NULL_HANDLE) {
+            device->DeallocateMemory(&memoryEntry.resource);
+            device->GetFencedDeleter()->DeleteWhenUnused(memoryEntry.buffer);
+            memoryEntry.buffer = VK_NULL_HANDLE;
+        }
+    }
 
+    MaybeError AllocateScratchMemory(Device* device,
+                                     MemoryEntry& memoryEntry,
+                                     VkMemoryRequirements& requirements) {
         VkBufferCreateInfo createInfo;
         createInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
         createInfo.pNext = nullptr;
@@ -388,9 +416,12 @@ namespace dawn_native { namespace vulkan {
                 accelerationCreateGeometryInfo.maxVertexCount = 0;
                 accelerationCreateGeometryInfo.vertexFormat = VK_FORMAT_UNDEFINED;
                 accelerationCreateGeometryInfo.indexType = VK_INDEX_TYPE_NONE_KHR;
+                accelerationCreateGeometryInfo.maxPrimitiveCount = 0;
                 // vertex buffer
                 if (geometry.vertex != nullptr && geometry.vertex->buffer != nullptr) {
                     accelerationCreateGeometryInfo.maxVertexCount = geometry.vertex->count;
+                    // same as the primitive count of the unindexed build offset
+                    accelerationCreateGeometryInfo.maxPrimitiveCount = geometry.vertex->count;
                     accelerationCreateGeometryInfo.vertexFormat =
                         ToVulkanAccelerationContainerVertexFormat(geometry.vertex->format);
                 }
@@ -427,7 +458,8 @@ namespace dawn_native { namespace vulkan {
         VkAccelerationStructureCreateInfoKHR accelerationStructureInfo;
         accelerationStructureInfo.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR;
         accelerationStructureInfo.pNext = nullptr;
-        accelerationStructureInfo.compactedSize = 0;
+        // compacted containers get their size from the query and must not declare geometries
+        accelerationStructureInfo.compactedSize = descriptor->compactedSize;
         accelerationStructureInfo.flags =
             ToVulkanBuildAccelerationContainerFlags(descriptor->usage);
         accelerationStructureInfo.maxGeometryCount = accelerationGeometries.size();
@@ -449,15 +481,27 @@ namespace dawn_native { namespace vulkan {
         return mInstanceMemory;
     }
 
-    MaybeError RayTracingAccelerationContainer::UpdateInstanceImpl(
-        uint32_t instanceIndex,
-        const RayTracingAccelerationInstanceDescriptor* descriptor) {
-        uint32_t start = instanceIndex * sizeof(VkAccelerationStructureInstanceKHR);
-        uint32_t count = sizeof(VkAccelerationStructureInstanceKHR);
-        VkAccelerationStructureInstanceKHR instanceData = GetVkAccelerationInstance(*descriptor);
-        mInstanceMemory.allocation.Get()->SetSubData(start, count,
-                                                     reinterpret_cast<void*>(&instanceData));
-        return {};
+    MaybeError RayTracingAccelerationContainer::UpdateInstancesImpl(
+        uint32_t firstInstance,
+        uint32_t instanceCount,
+        const RayTracingAccelerationInstanceDescriptor* descriptors) {
+        Device* device = ToBackend(GetDevice());
+        constexpr uint64_t kInstanceSize = sizeof(VkAccelerationStructureInstanceKHR);
+        uint64_t size = uint64_t(instanceCount) * kInstanceSize;
+
+        // write all instances to one staging region and flush them with a single copy
+        UploadHandle uploadHandle;
+        DAWN_TRY_ASSIGN(uploadHandle, device->GetDynamicUploader()->Allocate(
+                                          size, device->GetPendingCommandSerial()));
+        for (uint32_t i = 0; i < instanceCount; ++i) {
+            VkAccelerationStructureInstanceKHR instanceData =
+                GetVkAccelerationInstance(descriptors[i]);
+            memcpy(uploadHandle.mappedBuffer + i * kInstanceSize, &instanceData, kInstanceSize);
+        }
+
+        return device->CopyFromStagingToBuffer(uploadHandle.stagingBuffer, uploadHandle.startOffset,
+                                               mInstanceMemory.allocation.Get(),
+                                               firstInstance * kInstanceSize, size);
     }
 
     uint64_t RayTracingAccelerationContainer::GetHandle() const {
@@ -478,8 +522,4 @@ namespace dawn_native { namespace vulkan {
         return mBuildOffsets;
     }
 
-    ScratchMemoryPool& RayTracingAccelerationContainer::GetScratchMemory() {
-        return mScratchMemory;
-    }
-
 }}  // namespace dawn_native::vulkan
\ No newline at end of file
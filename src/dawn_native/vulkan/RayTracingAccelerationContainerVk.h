@@ -25,11 +25,13 @@ namespace dawn_native { namespace vulkan {
 
     class Device;
 
-    struct ScratchMemoryPool {
-        MemoryEntry result;
-        MemoryEntry update;
-        MemoryEntry build;
-    };
+    // Allocates a buffer with a device address that acceleration containers can be built in or
+    // use as scratch memory. |requirements| is updated with the size actually allocated.
+    MaybeError AllocateScratchMemory(Device* device,
+                                     MemoryEntry& memoryEntry,
+                                     VkMemoryRequirements& requirements);
+    // Releases the buffer and its memory once the pending commands are finished.
+    void ReleaseScratchMemory(Device* device, MemoryEntry& memoryEntry);
 
     class RayTracingAccelerationContainer : public RayTracingAccelerationContainerBase {
       public:
@@ -46,16 +48,24 @@ namespace dawn_native { namespace vulkan {
 
         MemoryEntry& GetInstanceMemory();
 
-        ScratchMemoryPool& GetScratchMemory();
-        void DestroyScratchBuildMemory();
+        // Scratch memory isn't owned by the container, builds and updates borrow it from the
+        // device's ScratchBufferAllocator.
+        VkMemoryRequirements GetScratchBuildMemoryRequirements() const;
+        VkMemoryRequirements GetScratchUpdateMemoryRequirements() const;
+
+        // Query pool the compacted size is written to after each build. Only created for
+        // containers that allow compaction.
+        VkQueryPool GetCompactedSizeQueryPool() const;
 
       private:
         using RayTracingAccelerationContainerBase::RayTracingAccelerationContainerBase;
 
         void DestroyImpl() override;
-        MaybeError UpdateInstanceImpl(
-            uint32_t instanceIndex,
-            const RayTracingAccelerationInstanceDescriptor* descriptor) override;
+        MaybeError UpdateInstancesImpl(
+            uint32_t firstInstance,
+            uint32_t instanceCount,
+            const RayTracingAccelerationInstanceDescriptor* descriptors) override;
+        ResultOrError<uint64_t> GetCompactedSizeImpl() override;
 
         std::vector<VkAccelerationStructureGeometryKHR> mGeometries;
         std::vector<VkAccelerationStructureBuildOffsetInfoKHR> mBuildOffsets;
@@ -64,12 +74,14 @@ namespace dawn_native { namespace vulkan {
         uint64_t mAccelerationHandle;
         VkAccelerationStructureKHR mAccelerationStructure = VK_NULL_HANDLE;
 
-        // scratch memory
-        ScratchMemoryPool mScratchMemory;
+        // memory the acceleration structure lives in
+        MemoryEntry mResultMemory;
 
         // instance buffer
         MemoryEntry mInstanceMemory;
 
+        VkQueryPool mCompactedSizeQueryPool = VK_NULL_HANDLE;
+
         VkMemoryRequirements GetMemoryRequirements(
             VkAccelerationStructureMemoryRequirementsTypeKHR type) const;
         uint64_t GetMemoryRequirementSize(
@@ -78,8 +90,7 @@ namespace dawn_native { namespace vulkan {
         MaybeError CreateAccelerationStructure(
             const RayTracingAccelerationContainerDescriptor* descriptor);
 
-        MaybeError AllocateScratchMemory(MemoryEntry& memoryEntry,
-                                         VkMemoryRequirements& requirements);
+        MaybeError CreateCompactedSizeQueryPool();
 
         MaybeError Initialize(const RayTracingAccelerationContainerDescriptor* descriptor);
     };
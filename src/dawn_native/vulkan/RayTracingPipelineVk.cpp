@@ -68,17 +68,48 @@ namespace dawn_native { namespace vulkan {
             createInfo.pLibraryInterface = nullptr;
 
             MaybeError result = CheckVkSuccess(
-                device->fn.CreateRayTracingPipelinesKHR(device->GetVkDevice(), VK_NULL_HANDLE, 1,
+                device->fn.CreateRayTracingPipelinesKHR(device->GetVkDevice(),
+                                                        device->GetVkPipelineCache(), 1,
                                                         &createInfo, nullptr, &*mHandle),
                 "vkCreateRayTracingPipelinesKHR");
             if (result.IsError())
                 return result.AcquireError();
         }
 
+        mGroupHandleSize = rtProperties.shaderGroupHandleSize;
+        mGroupCount = groups.size();
+
         {
-            uint64_t bufferSize = groups.size() * rtProperties.shaderGroupHandleSize;
+            uint64_t bufferSize = mGroupCount * mGroupHandleSize;
+
+            VkBufferCreateInfo createInfo;
+            createInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+            createInfo.pNext = nullptr;
+            createInfo.flags = 0;
+            createInfo.size = bufferSize;
+            createInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+            createInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+            createInfo.queueFamilyIndexCount = 0;
+            createInfo.pQueueFamilyIndices = nullptr;
+
+            DAWN_TRY(CheckVkSuccess(device->fn.CreateBuffer(device->GetVkDevice(), &createInfo,
+                                                            nullptr, &*mGroupBuffer),
+                                    "vkCreateBuffer"));
+
+            VkMemoryRequirements requirements;
+            device->fn.GetBufferMemoryRequirements(device->GetVkDevice(), mGroupBuffer,
+                                                   &requirements);
+
+            DAWN_TRY_ASSIGN(mGroupBufferResource, device->AllocateMemory(requirements, true));
+
+            DAWN_TRY(CheckVkSuccess(
+                device->fn.BindBufferMemory(
+                    device->GetVkDevice(), mGroupBuffer,
+                    ToBackend(mGroupBufferResource.GetResourceHeap())->GetMemory(),
+                    mGroupBufferResource.GetOffset()),
+                "vkBindBufferMemory"));
 
-            void* sbtData = shaderBindingTable->GetGroupBufferResource().GetMappedPointer();
+            void* sbtData = mGroupBufferResource.GetMappedPointer();
 
             MaybeError result = CheckVkSuccess(
                 device->fn.GetRayTracingShaderGroupHandlesKHR(device->GetVkDevice(), mHandle, 0,
@@ -92,8 +123,14 @@ namespace dawn_native { namespace vulkan {
     }
 
     RayTracingPipeline::~RayTracingPipeline() {
+        Device* device = ToBackend(GetDevice());
+        if (mGroupBuffer != VK_NULL_HANDLE) {
+            device->DeallocateMemory(&mGroupBufferResource);
+            device->GetFencedDeleter()->DeleteWhenUnused(mGroupBuffer);
+            mGroupBuffer = VK_NULL_HANDLE;
+        }
         if (mHandle != VK_NULL_HANDLE) {
-            ToBackend(GetDevice())->GetFencedDeleter()->DeleteWhenUnused(mHandle);
+            device->GetFencedDeleter()->DeleteWhenUnused(mHandle);
             mHandle = VK_NULL_HANDLE;
         }
     }
@@ -102,4 +139,16 @@ namespace dawn_native { namespace vulkan {
         return mHandle;
     }
 
+    VkBuffer RayTracingPipeline::GetGroupBufferHandle() const {
+        return mGroupBuffer;
+    }
+
+    uint32_t RayTracingPipeline::GetGroupHandleSize() const {
+        return mGroupHandleSize;
+    }
+
+    uint32_t RayTracingPipeline::GetGroupCount() const {
+        return mGroupCount;
+    }
+
 }}  // namespace dawn_native::vulkan
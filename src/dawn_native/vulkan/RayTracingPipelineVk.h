@@ -37,11 +37,22 @@ namespace dawn_native { namespace vulkan {
 
         VkPipeline GetHandle() const;
 
+        VkBuffer GetGroupBufferHandle() const;
+        uint32_t GetGroupHandleSize() const;
+        uint32_t GetGroupCount() const;
+
       private:
         using RayTracingPipelineBase::RayTracingPipelineBase;
         MaybeError Initialize(const RayTracingPipelineDescriptor* descriptor);
 
         VkPipeline mHandle = VK_NULL_HANDLE;
+
+        // The group handles are specific to this pipeline, so they can't live in the shader
+        // binding table that other pipelines may be created with.
+        VkBuffer mGroupBuffer = VK_NULL_HANDLE;
+        ResourceMemoryAllocation mGroupBufferResource;
+        uint32_t mGroupHandleSize = 0;
+        uint32_t mGroupCount = 0;
     };
 
 }}  // namespace dawn_native::vulkan
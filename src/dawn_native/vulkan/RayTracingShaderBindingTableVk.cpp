@@ -16,8 +16,6 @@
 
 #include "dawn_native/vulkan/AdapterVk.h"
 #include "dawn_native/vulkan/DeviceVk.h"
-#include "dawn_native/vulkan/FencedDeleter.h"
-#include "dawn_native/vulkan/ResourceHeapVk.h"
 #include "dawn_native/vulkan/ShaderModuleVk.h"
 #include "dawn_native/vulkan/UtilsVulkan.h"
 #include "dawn_native/vulkan/VulkanError.h"
@@ -39,12 +37,7 @@ namespace dawn_native { namespace vulkan {
     }
 
     void RayTracingShaderBindingTable::DestroyImpl() {
-        Device* device = ToBackend(GetDevice());
-        if (mGroupBuffer != VK_NULL_HANDLE) {
-            device->DeallocateMemory(&mGroupBufferResource);
-            device->GetFencedDeleter()->DeleteWhenUnused(mGroupBuffer);
-            mGroupBuffer = VK_NULL_HANDLE;
-        }
+        // The group handle buffers are owned by the pipelines created with this table.
     }
 
     MaybeError RayTracingShaderBindingTable::Initialize(
@@ -99,33 +92,6 @@ namespace dawn_native { namespace vulkan {
             mGroups.push_back(groupInfo);
         }
 
-        uint64_t bufferSize = mGroups.size() * rtProperties.shaderGroupHandleSize;
-
-        VkBufferCreateInfo createInfo;
-        createInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-        createInfo.pNext = nullptr;
-        createInfo.flags = 0;
-        createInfo.size = bufferSize;
-        createInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-        createInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-        createInfo.queueFamilyIndexCount = 0;
-        createInfo.pQueueFamilyIndices = nullptr;
-
-        DAWN_TRY(CheckVkSuccess(
-            device->fn.CreateBuffer(device->GetVkDevice(), &createInfo, nullptr, &*mGroupBuffer),
-            "vkCreateBuffer"));
-
-        VkMemoryRequirements requirements;
-        device->fn.GetBufferMemoryRequirements(device->GetVkDevice(), mGroupBuffer, &requirements);
-
-        DAWN_TRY_ASSIGN(mGroupBufferResource, device->AllocateMemory(requirements, true));
-
-        DAWN_TRY(CheckVkSuccess(device->fn.BindBufferMemory(
-                                    device->GetVkDevice(), mGroupBuffer,
-                                    ToBackend(mGroupBufferResource.GetResourceHeap())->GetMemory(),
-                                    mGroupBufferResource.GetOffset()),
-                                "vkBindBufferMemory"));
-
         return {};
     }
 
@@ -141,14 +107,6 @@ namespace dawn_native { namespace vulkan {
         return mStages;
     }
 
-    VkBuffer RayTracingShaderBindingTable::GetGroupBufferHandle() const {
-        return mGroupBuffer;
-    }
-
-    ResourceMemoryAllocation RayTracingShaderBindingTable::GetGroupBufferResource() const {
-        return mGroupBufferResource;
-    }
-
     uint32_t RayTracingShaderBindingTable::GetShaderGroupHandleSize() const {
         return mShaderGroupHandleSize;
     }
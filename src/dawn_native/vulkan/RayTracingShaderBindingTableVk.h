@@ -19,7 +19,6 @@
 
 #include "common/vulkan_platform.h"
 #include "dawn_native/RayTracingShaderBindingTable.h"
-#include "dawn_native/ResourceMemoryAllocation.h"
 
 namespace dawn_native { namespace vulkan {
 
@@ -37,9 +36,6 @@ namespace dawn_native { namespace vulkan {
 
         uint32_t GetShaderGroupHandleSize() const;
 
-        VkBuffer GetGroupBufferHandle() const;
-        ResourceMemoryAllocation GetGroupBufferResource() const;
-
       private:
         using RayTracingShaderBindingTableBase::RayTracingShaderBindingTableBase;
 
@@ -48,10 +44,6 @@ namespace dawn_native { namespace vulkan {
         std::vector<VkPipelineShaderStageCreateInfo> mStages;
         std::vector<VkRayTracingShaderGroupCreateInfoKHR> mGroups;
 
-        // group handle buffer
-        VkBuffer mGroupBuffer = VK_NULL_HANDLE;
-        ResourceMemoryAllocation mGroupBufferResource;
-
         uint32_t mShaderGroupHandleSize;
 
         MaybeError Initialize(const RayTracingShaderBindingTableDescriptor* descriptor);
@@ -73,6 +73,7 @@ namespace dawn_native { namespace vulkan {
     }
 
     ResultOrError<VkRenderPass> RenderPassCache::GetRenderPass(const RenderPassCacheQuery& query) {
+        std::lock_guard<std::mutex> lock(mMutex);
         auto it = mCache.find(query);
         if (it != mCache.end()) {
             return VkRenderPass(it->second);
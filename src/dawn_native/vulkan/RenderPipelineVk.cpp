@@ -502,8 +502,8 @@ namespace dawn_native { namespace vulkan {
         createInfo.basePipelineIndex = -1;
 
         return CheckVkSuccess(
-            device->fn.CreateGraphicsPipelines(device->GetVkDevice(), VkPipelineCache{}, 1,
-                                               &createInfo, nullptr, &*mHandle),
+            device->fn.CreateGraphicsPipelines(device->GetVkDevice(), device->GetVkPipelineCache(),
+                                               1, &createInfo, nullptr, &*mHandle),
             "CreateGraphicsPipeline");
     }
 
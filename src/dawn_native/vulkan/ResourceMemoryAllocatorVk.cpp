@@ -87,17 +87,27 @@ namespace dawn_native { namespace vulkan {
                 "vkAllocateMemory"));
 
             ASSERT(allocatedMemory != VK_NULL_HANDLE);
-            return {std::make_unique<ResourceHeap>(allocatedMemory, mMemoryTypeIndex)};
+            mAllocatedSize += size;
+            return {std::make_unique<ResourceHeap>(allocatedMemory, mMemoryTypeIndex, size)};
         }
 
         void DeallocateResourceHeap(std::unique_ptr<ResourceHeapBase> allocation) override {
-            mDevice->GetFencedDeleter()->DeleteWhenUnused(ToBackend(allocation.get())->GetMemory());
+            ResourceHeap* heap = ToBackend(allocation.get());
+            ASSERT(mAllocatedSize >= heap->GetSize());
+            mAllocatedSize -= heap->GetSize();
+            mDevice->GetFencedDeleter()->DeleteWhenUnused(heap->GetMemory());
+        }
+
+        uint64_t GetAllocatedSize() const {
+            return mAllocatedSize;
         }
 
       private:
         Device* mDevice;
         size_t mMemoryTypeIndex;
         BuddyMemoryAllocator mBuddySystem;
+        // The memory of both the heaps of the buddy system and the direct allocations.
+        uint64_t mAllocatedSize = 0;
     };
 
     // Implementation of ResourceMemoryAllocator
@@ -166,8 +176,8 @@ namespace dawn_native { namespace vulkan {
             case AllocationMethod::kDirect: {
                 ResourceHeap* heap = ToBackend(allocation->GetResourceHeap());
                 allocation->Invalidate();
-                mDevice->GetFencedDeleter()->DeleteWhenUnused(heap->GetMemory());
-                delete heap;
+                mAllocatorsPerType[heap->GetMemoryType()]->DeallocateResourceHeap(
+                    std::unique_ptr<ResourceHeapBase>(heap));
                 break;
             }
 
@@ -201,6 +211,23 @@ namespace dawn_native { namespace vulkan {
         mSubAllocationsToDelete.ClearUpTo(completedSerial);
     }
 
+    uint64_t ResourceMemoryAllocator::GetAllocatedMemorySize() const {
+        uint64_t size = 0;
+        for (const auto& allocator : mAllocatorsPerType) {
+            size += allocator->GetAllocatedSize();
+        }
+        return size;
+    }
+
+    uint64_t ResourceMemoryAllocator::GetPendingDeallocationCount() const {
+        uint64_t count = 0;
+        for (const ResourceMemoryAllocation& allocation : mSubAllocationsToDelete.IterateAll()) {
+            DAWN_UNUSED(allocation);
+            count++;
+        }
+        return count;
+    }
+
     int ResourceMemoryAllocator::FindBestTypeIndex(VkMemoryRequirements requirements,
                                                    bool mappable) {
         const VulkanDeviceInfo& info = mDevice->GetDeviceInfo();
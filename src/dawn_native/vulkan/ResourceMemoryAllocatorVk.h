@@ -42,6 +42,11 @@ namespace dawn_native { namespace vulkan {
 
         int FindBestTypeIndex(VkMemoryRequirements requirements, bool mappable);
 
+        // The size of the device memory allocated for all the memory types, and the number of
+        // sub-allocations waiting for the GPU to be done with them, for the device statistics.
+        uint64_t GetAllocatedMemorySize() const;
+        uint64_t GetPendingDeallocationCount() const;
+
       private:
         Device* mDevice;
 
@@ -0,0 +1,108 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_native/vulkan/ScratchBufferAllocatorVk.h"
+
+#include "dawn_native/vulkan/DeviceVk.h"
+#include "dawn_native/vulkan/RayTracingAccelerationContainerVk.h"
+
+namespace dawn_native { namespace vulkan {
+
+    ScratchBufferAllocator::ScratchBufferAllocator(Device* device) : mDevice(device) {
+        mRingBuffers.emplace_back(std::unique_ptr<RingBuffer>(
+            new RingBuffer{MemoryEntry(), RingBufferAllocator(kRingBufferSize)}));
+    }
+
+    ScratchBufferAllocator::~ScratchBufferAllocator() {
+        for (auto& ringBuffer : mRingBuffers) {
+            ReleaseScratchMemory(mDevice, ringBuffer->memory);
+        }
+    }
+
+    ResultOrError<ScratchAllocation> ScratchBufferAllocator::Allocate(uint64_t allocationSize) {
+        allocationSize = (allocationSize + kScratchAlignment - 1) & ~(kScratchAlignment - 1);
+
+        // Allocations larger than a ring buffer get their own buffer, released right away so
+        // that it is deleted once the pending commands are finished.
+        if (allocationSize > kRingBufferSize) {
+            MemoryEntry memory;
+            VkMemoryRequirements requirements = {};
+            requirements.size = allocationSize;
+            DAWN_TRY(AllocateScratchMemory(mDevice, memory, requirements));
+
+            ScratchAllocation allocation;
+            allocation.buffer = memory.buffer;
+            allocation.deviceAddress = memory.deviceAddress;
+
+            ReleaseScratchMemory(mDevice, memory);
+            return allocation;
+        }
+
+        Serial serial = mDevice->GetPendingCommandSerial();
+
+        // First-fit: use the first ring buffer with enough space left.
+        RingBuffer* targetRingBuffer = nullptr;
+        uint64_t startOffset = RingBufferAllocator::kInvalidOffset;
+        for (auto& ringBuffer : mRingBuffers) {
+            startOffset = ringBuffer->allocator.Allocate(allocationSize, serial);
+            if (startOffset != RingBufferAllocator::kInvalidOffset) {
+                targetRingBuffer = ringBuffer.get();
+                break;
+            }
+        }
+
+        // Upon failure, append a newly created ring buffer to fulfill the request.
+        if (targetRingBuffer == nullptr) {
+            mRingBuffers.emplace_back(std::unique_ptr<RingBuffer>(
+                new RingBuffer{MemoryEntry(), RingBufferAllocator(kRingBufferSize)}));
+
+            targetRingBuffer = mRingBuffers.back().get();
+            startOffset = targetRingBuffer->allocator.Allocate(allocationSize, serial);
+        }
+
+        ASSERT(startOffset != RingBufferAllocator::kInvalidOffset);
+
+        // The buffer backing the ring buffer is created lazily.
+        if (targetRingBuffer->memory.buffer == VK_NULL_HANDLE) {
+            VkMemoryRequirements requirements = {};
+            requirements.size = targetRingBuffer->allocator.GetSize();
+            DAWN_TRY(AllocateScratchMemory(mDevice, targetRingBuffer->memory, requirements));
+        }
+
+        ScratchAllocation allocation;
+        allocation.buffer = targetRingBuffer->memory.buffer;
+        allocation.offset = startOffset;
+        allocation.deviceAddress = targetRingBuffer->memory.deviceAddress + startOffset;
+        return allocation;
+    }
+
+    void ScratchBufferAllocator::Deallocate(Serial lastCompletedSerial) {
+        for (size_t i = 0; i < mRingBuffers.size();) {
+            mRingBuffers[i]->allocator.Deallocate(lastCompletedSerial);
+
+            // Never erase the last buffer as to prevent re-creating buffers for every build.
+            if (mRingBuffers[i]->allocator.Empty() && i < mRingBuffers.size() - 1) {
+                ReleaseScratchMemory(mDevice, mRingBuffers[i]->memory);
+                mRingBuffers.erase(mRingBuffers.begin() + i);
+            } else {
+                ++i;
+            }
+        }
+    }
+
+    size_t ScratchBufferAllocator::GetRingBufferCountForTesting() const {
+        return mRingBuffers.size();
+    }
+
+}}  // namespace dawn_native::vulkan
@@ -0,0 +1,67 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNNATIVE_VULKAN_SCRATCHBUFFERALLOCATORVK_H_
+#define DAWNNATIVE_VULKAN_SCRATCHBUFFERALLOCATORVK_H_
+
+#include "common/vulkan_platform.h"
+#include "dawn_native/Error.h"
+#include "dawn_native/RingBufferAllocator.h"
+#include "dawn_native/vulkan/BufferVk.h"
+
+#include <memory>
+#include <vector>
+
+namespace dawn_native { namespace vulkan {
+
+    class Device;
+
+    struct ScratchAllocation {
+        VkBuffer buffer = VK_NULL_HANDLE;
+        uint64_t offset = 0;
+        uint64_t deviceAddress = 0;
+    };
+
+    // Device-level scratch memory for acceleration container builds and updates. Containers
+    // borrow scratch memory while their commands are recorded, and the memory is reused once the
+    // serial of these commands completes. Scratch memory is sub-allocated from ring buffers the
+    // same way the DynamicUploader sub-allocates staging memory.
+    class ScratchBufferAllocator {
+      public:
+        ScratchBufferAllocator(Device* device);
+        ~ScratchBufferAllocator();
+
+        // The allocation stays valid until the pending command serial completes.
+        ResultOrError<ScratchAllocation> Allocate(uint64_t allocationSize);
+        void Deallocate(Serial lastCompletedSerial);
+
+        size_t GetRingBufferCountForTesting() const;
+
+        // Offsets of scratch allocations must be aligned to this, per the Vulkan spec.
+        static constexpr uint64_t kScratchAlignment = 256;
+        static constexpr uint64_t kRingBufferSize = 32 * 1024 * 1024;
+
+      private:
+        struct RingBuffer {
+            MemoryEntry memory;
+            RingBufferAllocator allocator;
+        };
+
+        std::vector<std::unique_ptr<RingBuffer>> mRingBuffers;
+        Device* mDevice;
+    };
+
+}}  // namespace dawn_native::vulkan
+
+#endif  // DAWNNATIVE_VULKAN_SCRATCHBUFFERALLOCATORVK_H_
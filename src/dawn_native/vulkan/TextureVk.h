@@ -62,7 +62,6 @@ namespace dawn_native { namespace vulkan {
 
         // Transitions the texture to be used as `usage`, recording any necessary barrier in
         // `commands`.
-        // TODO(cwallez@chromium.org): coalesce barriers and do them early when possible.
         void TransitionFullUsage(CommandRecordingContext* recordingContext,
                                  wgpu::TextureUsage usage);
 
@@ -72,8 +71,14 @@ namespace dawn_native { namespace vulkan {
                                 uint32_t levelCount,
                                 uint32_t baseArrayLayer,
                                 uint32_t layerCount);
+        // Transitions the subresources to their usage in a pass without recording the barriers.
+        // The barriers are appended to `imageBarriers` and their stages merged in `srcStages` and
+        // `dstStages` so that the barriers of all the resources of the pass are recorded at once.
         void TransitionUsageForPass(CommandRecordingContext* recordingContext,
-                                    const std::vector<wgpu::TextureUsage>& subresourceUsages);
+                                    const std::vector<wgpu::TextureUsage>& subresourceUsages,
+                                    std::vector<VkImageMemoryBarrier>* imageBarriers,
+                                    VkPipelineStageFlags* srcStages,
+                                    VkPipelineStageFlags* dstStages);
 
         void EnsureSubresourceContentInitialized(CommandRecordingContext* recordingContext,
                                                  uint32_t baseMipLevel,
@@ -106,8 +111,11 @@ namespace dawn_native { namespace vulkan {
                                 uint32_t layerCount,
                                 TextureBase::ClearValue);
 
+        // Changes the barrier of the texture, at `transitionBarrierStart` in `barriers`, to do
+        // queue family transfers of external textures.
         void TweakTransitionForExternalUsage(CommandRecordingContext* recordingContext,
-                                             std::vector<VkImageMemoryBarrier>* barriers);
+                                             std::vector<VkImageMemoryBarrier>* barriers,
+                                             size_t transitionBarrierStart);
 
         VkImage mHandle = VK_NULL_HANDLE;
         ResourceMemoryAllocation mMemoryAllocation;
@@ -152,6 +152,9 @@ namespace dawn_native { namespace vulkan {
         if (buildUsage & wgpu::RayTracingAccelerationContainerUsage::LowMemory) {
             flags |= VK_BUILD_ACCELERATION_STRUCTURE_LOW_MEMORY_BIT_KHR;
         }
+        if (buildUsage & wgpu::RayTracingAccelerationContainerUsage::AllowCompaction) {
+            flags |= VK_BUILD_ACCELERATION_STRUCTURE_ALLOW_COMPACTION_BIT_KHR;
+        }
         return static_cast<VkBuildAccelerationStructureFlagsKHR>(flags);
     }
 
@@ -22,12 +22,36 @@
 #include "dawn_native/VulkanBackend.h"
 
 #include "common/SwapChainUtils.h"
+#include "dawn_native/vulkan/AdapterVk.h"
+#include "dawn_native/vulkan/BackendVk.h"
 #include "dawn_native/vulkan/DeviceVk.h"
+#include "dawn_native/vulkan/FakeVulkanDriver.h"
 #include "dawn_native/vulkan/NativeSwapChainImplVk.h"
 #include "dawn_native/vulkan/TextureVk.h"
 
 namespace dawn_native { namespace vulkan {
 
+    AdapterDiscoveryOptions::AdapterDiscoveryOptions()
+        : AdapterDiscoveryOptionsBase(WGPUBackendType_Vulkan) {
+    }
+
+    bool GetFakeDriverStatistics(WGPUDevice device, FakeDriverStatistics* statistics) {
+        Device* backendDevice = reinterpret_cast<Device*>(device);
+        if (!ToBackend(backendDevice->GetAdapter())->GetBackend()->UsesFakeDriver()) {
+            return false;
+        }
+        *statistics = GetFakeDeviceStatistics(backendDevice->GetVkDevice());
+        return true;
+    }
+
+    uint64_t GetFakeDriverCallCount(WGPUDevice device, const char* entryPoint) {
+        Device* backendDevice = reinterpret_cast<Device*>(device);
+        if (!ToBackend(backendDevice->GetAdapter())->GetBackend()->UsesFakeDriver()) {
+            return 0;
+        }
+        return GetFakeDeviceCallCount(backendDevice->GetVkDevice(), entryPoint);
+    }
+
     VkInstance GetInstance(WGPUDevice device) {
         Device* backendDevice = reinterpret_cast<Device*>(device);
         return backendDevice->GetVkInstance();
@@ -28,10 +28,17 @@ namespace dawn_native { namespace vulkan {
     } while (0)
 
     MaybeError VulkanFunctions::LoadGlobalProcs(const DynamicLib& vulkanLib) {
-        if (!vulkanLib.GetProc(&GetInstanceProcAddr, "vkGetInstanceProcAddr")) {
+        PFN_vkGetInstanceProcAddr getInstanceProcAddr = nullptr;
+        if (!vulkanLib.GetProc(&getInstanceProcAddr, "vkGetInstanceProcAddr")) {
             return DAWN_INTERNAL_ERROR("Couldn't get vkGetInstanceProcAddr");
         }
 
+        return LoadGlobalProcs(getInstanceProcAddr);
+    }
+
+    MaybeError VulkanFunctions::LoadGlobalProcs(PFN_vkGetInstanceProcAddr getInstanceProcAddr) {
+        GetInstanceProcAddr = getInstanceProcAddr;
+
         GET_GLOBAL_PROC(CreateInstance);
         GET_GLOBAL_PROC(EnumerateInstanceExtensionProperties);
         GET_GLOBAL_PROC(EnumerateInstanceLayerProperties);
@@ -326,6 +333,7 @@ namespace dawn_native { namespace vulkan {
             GET_DEVICE_PROC(CreateRayTracingPipelinesKHR);
             GET_DEVICE_PROC(CmdBuildAccelerationStructureKHR);
             GET_DEVICE_PROC(CmdCopyAccelerationStructureKHR);
+            GET_DEVICE_PROC(CmdWriteAccelerationStructuresPropertiesKHR);
             GET_DEVICE_PROC(DestroyAccelerationStructureKHR);
             GET_DEVICE_PROC(GetRayTracingShaderGroupHandlesKHR);
             GET_DEVICE_PROC(CmdTraceRaysKHR);
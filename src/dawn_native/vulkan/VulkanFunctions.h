@@ -29,6 +29,7 @@ namespace dawn_native { namespace vulkan {
     // and the vkGet*ProcAddress entry points.
     struct VulkanFunctions {
         MaybeError LoadGlobalProcs(const DynamicLib& vulkanLib);
+        MaybeError LoadGlobalProcs(PFN_vkGetInstanceProcAddr getInstanceProcAddr);
         MaybeError LoadInstanceProcs(VkInstance instance, const VulkanGlobalInfo& globalInfo);
         MaybeError LoadDeviceProcs(VkDevice device, const VulkanDeviceInfo& deviceInfo);
 
@@ -294,6 +295,8 @@ namespace dawn_native { namespace vulkan {
         PFN_vkCreateRayTracingPipelinesKHR CreateRayTracingPipelinesKHR = nullptr;
         PFN_vkCmdBuildAccelerationStructureKHR CmdBuildAccelerationStructureKHR = nullptr;
         PFN_vkCmdCopyAccelerationStructureKHR CmdCopyAccelerationStructureKHR = nullptr;
+        PFN_vkCmdWriteAccelerationStructuresPropertiesKHR
+            CmdWriteAccelerationStructuresPropertiesKHR = nullptr;
         PFN_vkDestroyAccelerationStructureKHR DestroyAccelerationStructureKHR = nullptr;
         PFN_vkGetRayTracingShaderGroupHandlesKHR GetRayTracingShaderGroupHandlesKHR = nullptr;
         PFN_vkCmdTraceRaysKHR CmdTraceRaysKHR = nullptr;
@@ -0,0 +1,337 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_platform/TraceRecorderPlatform.h"
+
+#include "common/Assert.h"
+#include "common/Math.h"
+#include "dawn_platform/tracing/TraceEvent.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <ostream>
+
+namespace dawn_platform {
+
+    namespace {
+
+        constexpr uint32_t kCategoryCount = 4;
+        constexpr int kMaxArgCount = 2;
+
+        static_assert(static_cast<uint32_t>(TraceCategory::General) == 0, "");
+        static_assert(static_cast<uint32_t>(TraceCategory::Validation) == 1, "");
+        static_assert(static_cast<uint32_t>(TraceCategory::Recording) == 2, "");
+        static_assert(static_cast<uint32_t>(TraceCategory::GPUWork) == 3, "");
+
+        // Shared by all the recorders because the trace event call sites cache the pointers.
+        unsigned char gCategoryEnabled[kCategoryCount] = {};
+
+        const char* const kCategoryNames[kCategoryCount] = {
+            "general",
+            "validation",
+            "recording",
+            "gpu",
+        };
+
+        std::atomic<uint64_t> gNextRecorderId(1);
+
+        void WriteJSONString(std::ostream* stream, const char* string) {
+            *stream << '"';
+            for (const char* c = string; *c != '\0'; ++c) {
+                switch (*c) {
+                    case '"':
+                        *stream << "\\\"";
+                        break;
+                    case '\\':
+                        *stream << "\\\\";
+                        break;
+                    case '\n':
+                        *stream << "\\n";
+                        break;
+                    case '\t':
+                        *stream << "\\t";
+                        break;
+                    default:
+                        if (static_cast<unsigned char>(*c) < 0x20) {
+                            char escaped[8];
+                            snprintf(escaped, sizeof(escaped), "\\u%04x",
+                                     static_cast<unsigned char>(*c));
+                            *stream << escaped;
+                        } else {
+                            *stream << *c;
+                        }
+                        break;
+                }
+            }
+            *stream << '"';
+        }
+
+        void WriteJSONTimestamp(std::ostream* stream, double seconds) {
+            char microseconds[32];
+            snprintf(microseconds, sizeof(microseconds), "%.3f", seconds * 1000.0 * 1000.0);
+            *stream << microseconds;
+        }
+
+        void WriteJSONHex(std::ostream* stream, uint64_t value) {
+            char hex[24];
+            snprintf(hex, sizeof(hex), "\"0x%llx\"", static_cast<unsigned long long>(value));
+            *stream << hex;
+        }
+
+    }  // anonymous namespace
+
+    struct TraceRecorderPlatform::RecordedEvent {
+        double timestamp;
+        const char* name;
+        uint64_t id;
+        const char* argNames[kMaxArgCount];
+        uint64_t argValues[kMaxArgCount];
+        unsigned char argTypes[kMaxArgCount];
+        unsigned char argCount;
+        unsigned char category;
+        unsigned char flags;
+        char phase;
+    };
+
+    // A ring buffer with a single producer, the thread that owns it, and a single consumer,
+    // WriteJSON. The indices grow monotonically and are masked to index the events.
+    class TraceRecorderPlatform::ThreadEventBuffer {
+      public:
+        ThreadEventBuffer(size_t capacity, uint32_t threadIndex)
+            : mEvents(new RecordedEvent[capacity]),
+              mMask(capacity - 1),
+              mThreadIndex(threadIndex),
+              mWriteIndex(0),
+              mReadIndex(0) {
+            ASSERT(IsPowerOfTwo(capacity));
+        }
+
+        // Only called by the thread that owns the buffer. Returns false if the buffer is full.
+        bool Push(const RecordedEvent& event) {
+            uint64_t write = mWriteIndex.load(std::memory_order_relaxed);
+            if (write - mReadIndex.load(std::memory_order_acquire) > mMask) {
+                return false;
+            }
+            mEvents[write & mMask] = event;
+            mWriteIndex.store(write + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Only called by WriteJSON.
+        template <typename F>
+        void Drain(F&& f) {
+            uint64_t read = mReadIndex.load(std::memory_order_relaxed);
+            uint64_t write = mWriteIndex.load(std::memory_order_acquire);
+            for (; read != write; ++read) {
+                f(mEvents[read & mMask]);
+            }
+            mReadIndex.store(write, std::memory_order_release);
+        }
+
+        uint32_t GetThreadIndex() const {
+            return mThreadIndex;
+        }
+
+      private:
+        std::unique_ptr<RecordedEvent[]> mEvents;
+        const uint64_t mMask;
+        const uint32_t mThreadIndex;
+
+        std::atomic<uint64_t> mWriteIndex;
+        std::atomic<uint64_t> mReadIndex;
+    };
+
+    TraceRecorderPlatform::TraceRecorderPlatform(size_t eventsPerThread)
+        : mRecorderId(gNextRecorderId.fetch_add(1, std::memory_order_relaxed)),
+          mEventsPerThread(NextPowerOfTwo(std::max(eventsPerThread, size_t(1)))),
+          mOrigin(std::chrono::steady_clock::now()),
+          mRecording(false),
+          mDroppedEventCount(0) {
+    }
+
+    TraceRecorderPlatform::~TraceRecorderPlatform() {
+        StopRecording();
+    }
+
+    void TraceRecorderPlatform::StartRecording() {
+        mRecording.store(true, std::memory_order_relaxed);
+        memset(gCategoryEnabled, 1, sizeof(gCategoryEnabled));
+    }
+
+    void TraceRecorderPlatform::StopRecording() {
+        if (mRecording.exchange(false, std::memory_order_relaxed)) {
+            memset(gCategoryEnabled, 0, sizeof(gCategoryEnabled));
+        }
+    }
+
+    bool TraceRecorderPlatform::IsRecording() const {
+        return mRecording.load(std::memory_order_relaxed);
+    }
+
+    uint64_t TraceRecorderPlatform::GetDroppedEventCount() const {
+        return mDroppedEventCount.load(std::memory_order_relaxed);
+    }
+
+    const unsigned char* TraceRecorderPlatform::GetTraceCategoryEnabledFlag(
+        TraceCategory category) {
+        uint32_t index = static_cast<uint32_t>(category);
+        ASSERT(index < kCategoryCount);
+        return &gCategoryEnabled[index];
+    }
+
+    double TraceRecorderPlatform::MonotonicallyIncreasingTime() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - mOrigin).count();
+    }
+
+    TraceRecorderPlatform::ThreadEventBuffer* TraceRecorderPlatform::GetThreadEventBuffer() {
+        struct CachedBuffer {
+            uint64_t recorderId = 0;
+            ThreadEventBuffer* buffer = nullptr;
+        };
+        thread_local CachedBuffer cachedBuffer;
+
+        if (cachedBuffer.recorderId != mRecorderId) {
+            std::lock_guard<std::mutex> lock(mMutex);
+            std::unique_ptr<ThreadEventBuffer>& buffer =
+                mThreadEventBuffers[std::this_thread::get_id()];
+            if (buffer == nullptr) {
+                uint32_t threadIndex = static_cast<uint32_t>(mThreadEventBuffers.size());
+                buffer = std::make_unique<ThreadEventBuffer>(mEventsPerThread, threadIndex);
+            }
+            cachedBuffer.recorderId = mRecorderId;
+            cachedBuffer.buffer = buffer.get();
+        }
+        return cachedBuffer.buffer;
+    }
+
+    uint64_t TraceRecorderPlatform::AddTraceEvent(char phase,
+                                                  const unsigned char* categoryGroupEnabled,
+                                                  const char* name,
+                                                  uint64_t id,
+                                                  double timestamp,
+                                                  int numArgs,
+                                                  const char** argNames,
+                                                  const unsigned char* argTypes,
+                                                  const uint64_t* argValues,
+                                                  unsigned char flags) {
+        if (!mRecording.load(std::memory_order_relaxed)) {
+            return 0;
+        }
+
+        ptrdiff_t category = categoryGroupEnabled - gCategoryEnabled;
+        ASSERT(category >= 0 && category < static_cast<ptrdiff_t>(kCategoryCount));
+
+        RecordedEvent event;
+        event.timestamp = timestamp;
+        event.name = name;
+        event.id = id;
+        event.argCount = 0;
+        event.category = static_cast<unsigned char>(category);
+        event.flags = flags;
+        event.phase = phase;
+        for (int i = 0; i < numArgs && i < kMaxArgCount; ++i) {
+            if (argTypes[i] == TRACE_VALUE_TYPE_COPY_STRING) {
+                continue;
+            }
+            event.argNames[event.argCount] = argNames[i];
+            event.argTypes[event.argCount] = argTypes[i];
+            event.argValues[event.argCount] = argValues[i];
+            event.argCount++;
+        }
+
+        if (!GetThreadEventBuffer()->Push(event)) {
+            mDroppedEventCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        return 0;
+    }
+
+    void TraceRecorderPlatform::WriteJSON(std::ostream* stream) {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        *stream << "{\"traceEvents\":[";
+        bool first = true;
+        for (auto& it : mThreadEventBuffers) {
+            ThreadEventBuffer* buffer = it.second.get();
+            buffer->Drain([&](const RecordedEvent& event) {
+                if (!first) {
+                    *stream << ",";
+                }
+                first = false;
+
+                *stream << "\n{\"name\":";
+                WriteJSONString(stream, event.name);
+                *stream << ",\"cat\":\"" << kCategoryNames[event.category] << "\",\"ph\":\""
+                        << event.phase << "\",\"ts\":";
+                WriteJSONTimestamp(stream, event.timestamp);
+                *stream << ",\"pid\":\"Dawn\",\"tid\":" << buffer->GetThreadIndex();
+                if (event.flags & TRACE_EVENT_FLAG_HAS_ID) {
+                    *stream << ",\"id\":";
+                    WriteJSONHex(stream, event.id);
+                }
+
+                *stream << ",\"args\":{";
+                for (unsigned char i = 0; i < event.argCount; ++i) {
+                    if (i != 0) {
+                        *stream << ",";
+                    }
+                    WriteJSONString(stream, event.argNames[i]);
+                    *stream << ":";
+
+                    uint64_t value = event.argValues[i];
+                    switch (event.argTypes[i]) {
+                        case TRACE_VALUE_TYPE_BOOL:
+                            *stream << (value != 0 ? "true" : "false");
+                            break;
+                        case TRACE_VALUE_TYPE_UINT:
+                            *stream << value;
+                            break;
+                        case TRACE_VALUE_TYPE_INT:
+                            *stream << static_cast<int64_t>(value);
+                            break;
+                        case TRACE_VALUE_TYPE_DOUBLE: {
+                            double doubleValue;
+                            memcpy(&doubleValue, &value, sizeof(doubleValue));
+                            *stream << doubleValue;
+                            break;
+                        }
+                        case TRACE_VALUE_TYPE_POINTER:
+                            WriteJSONHex(stream, value);
+                            break;
+                        case TRACE_VALUE_TYPE_STRING:
+                            WriteJSONString(stream, reinterpret_cast<const char*>(
+                                                        static_cast<uintptr_t>(value)));
+                            break;
+                        default:
+                            *stream << "null";
+                            break;
+                    }
+                }
+                *stream << "}}";
+            });
+        }
+        *stream << "\n]}\n";
+    }
+
+    bool TraceRecorderPlatform::WriteJSONFile(const char* path) {
+        std::ofstream file(path);
+        if (!file) {
+            return false;
+        }
+        WriteJSON(&file);
+        return static_cast<bool>(file);
+    }
+
+}  // namespace dawn_platform
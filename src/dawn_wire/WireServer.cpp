@@ -21,7 +21,8 @@ namespace dawn_wire {
         : mImpl(new server::Server(descriptor.device,
                                    *descriptor.procs,
                                    descriptor.serializer,
-                                   descriptor.memoryTransferService)) {
+                                   descriptor.memoryTransferService,
+                                   descriptor.platform)) {
     }
 
     WireServer::~WireServer() {
@@ -202,6 +202,49 @@ namespace dawn_wire { namespace client {
         return device->RequestPopErrorScope(callback, userdata);
     }
 
+    void ClientHandwrittenDeviceGetStatistics(WGPUDevice cDevice,
+                                              WGPUDeviceStatisticsCallback callback,
+                                              void* userdata) {
+        Device* device = reinterpret_cast<Device*>(cDevice);
+        device->RequestStatistics(callback, userdata);
+    }
+
+    void ClientHandwrittenDeviceCreateComputePipelineAsync(
+        WGPUDevice cDevice,
+        WGPUComputePipelineDescriptor const* descriptor,
+        WGPUCreateComputePipelineAsyncCallback callback,
+        void* userdata) {
+        Device* device = reinterpret_cast<Device*>(cDevice);
+        device->CreateComputePipelineAsync(descriptor, callback, userdata);
+    }
+
+    void ClientHandwrittenDeviceCreateRenderPipelineAsync(
+        WGPUDevice cDevice,
+        WGPURenderPipelineDescriptor const* descriptor,
+        WGPUCreateRenderPipelineAsyncCallback callback,
+        void* userdata) {
+        Device* device = reinterpret_cast<Device*>(cDevice);
+        device->CreateRenderPipelineAsync(descriptor, callback, userdata);
+    }
+
+    void ClientHandwrittenDeviceCreateRayTracingPipelineAsync(
+        WGPUDevice cDevice,
+        WGPURayTracingPipelineDescriptor const* descriptor,
+        WGPUCreateRayTracingPipelineAsyncCallback callback,
+        void* userdata) {
+        Device* device = reinterpret_cast<Device*>(cDevice);
+        device->CreateRayTracingPipelineAsync(descriptor, callback, userdata);
+    }
+
+    void ClientHandwrittenRayTracingAccelerationContainerGetCompactedSizeAsync(
+        WGPURayTracingAccelerationContainer cContainer,
+        WGPURayTracingAccelerationContainerCompactedSizeCallback callback,
+        void* userdata) {
+        RayTracingAccelerationContainer* container =
+            reinterpret_cast<RayTracingAccelerationContainer*>(cContainer);
+        container->device->RequestCompactedSize(container->id, callback, userdata);
+    }
+
     uint64_t ClientHandwrittenFenceGetCompletedValue(WGPUFence cSelf) {
         auto fence = reinterpret_cast<Fence*>(cSelf);
         return fence->completedValue;
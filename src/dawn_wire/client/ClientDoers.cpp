@@ -46,6 +46,24 @@ namespace dawn_wire { namespace client {
         return mDevice->PopErrorScope(requestSerial, errorType, message);
     }
 
+    bool Client::DoDeviceCreatePipelineAsyncCallback(uint64_t requestSerial,
+                                                     uint32_t status,
+                                                     const char* message) {
+        return mDevice->OnCreatePipelineAsyncCallback(requestSerial, status, message);
+    }
+
+    bool Client::DoDeviceGetStatisticsCallback(uint64_t requestSerial,
+                                               uint32_t status,
+                                               const WGPUDeviceStatistics* statistics) {
+        return mDevice->OnStatistics(requestSerial, status, statistics);
+    }
+
+    bool Client::DoRayTracingAccelerationContainerCompactedSizeCallback(uint64_t requestSerial,
+                                                                        uint32_t status,
+                                                                        uint64_t compactedSize) {
+        return mDevice->OnCompactedSize(requestSerial, status, compactedSize);
+    }
+
     bool Client::DoBufferMapReadAsyncCallback(Buffer* buffer,
                                               uint32_t requestSerial,
                                               uint32_t status,
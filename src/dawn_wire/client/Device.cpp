@@ -46,6 +46,40 @@ namespace dawn_wire { namespace client {
             it.second.callback(WGPUErrorType_Unknown, "Device destroyed", it.second.userdata);
         }
 
+        // Fire pending compacted size requests
+        auto compactedSizeRequests = std::move(mCompactedSizeRequests);
+        for (const auto& it : compactedSizeRequests) {
+            it.second.callback(WGPURayTracingAccelerationContainerCompactedSizeStatus_Unknown, 0,
+                               it.second.userdata);
+        }
+
+        // Fire pending statistics requests
+        auto statisticsRequests = std::move(mStatisticsRequests);
+        for (const auto& it : statisticsRequests) {
+            WGPUDeviceStatistics statistics = {};
+            it.second.callback(WGPUDeviceStatisticsStatus_Unknown, &statistics,
+                               it.second.userdata);
+        }
+
+        // Fire pending pipeline creations
+        auto createPipelineAsyncRequests = std::move(mCreatePipelineAsyncRequests);
+        for (const auto& it : createPipelineAsyncRequests) {
+            const CreatePipelineAsyncRequest& request = it.second;
+            if (request.createComputePipelineAsyncCallback != nullptr) {
+                request.createComputePipelineAsyncCallback(
+                    WGPUCreatePipelineAsyncStatus_DeviceDestroyed, nullptr, "Device destroyed",
+                    request.userdata);
+            } else if (request.createRenderPipelineAsyncCallback != nullptr) {
+                request.createRenderPipelineAsyncCallback(
+                    WGPUCreatePipelineAsyncStatus_DeviceDestroyed, nullptr, "Device destroyed",
+                    request.userdata);
+            } else {
+                request.createRayTracingPipelineAsyncCallback(
+                    WGPUCreatePipelineAsyncStatus_DeviceDestroyed, nullptr, "Device destroyed",
+                    request.userdata);
+            }
+        }
+
         // Destroy the default queue
         DestroyObjectCmd cmd;
         cmd.objectType = ObjectType::Queue;
@@ -145,6 +179,228 @@ namespace dawn_wire { namespace client {
         return true;
     }
 
+    void Device::RequestCompactedSize(
+        uint32_t containerId,
+        WGPURayTracingAccelerationContainerCompactedSizeCallback callback,
+        void* userdata) {
+        uint64_t serial = mCompactedSizeRequestSerial++;
+        ASSERT(mCompactedSizeRequests.find(serial) == mCompactedSizeRequests.end());
+
+        mCompactedSizeRequests[serial] = {callback, userdata};
+
+        RayTracingAccelerationContainerGetCompactedSizeAsyncCmd cmd;
+        cmd.containerId = containerId;
+        cmd.requestSerial = serial;
+
+        Client* wireClient = GetClient();
+        size_t requiredSize = cmd.GetRequiredSize();
+        char* allocatedBuffer = static_cast<char*>(wireClient->GetCmdSpace(requiredSize));
+        cmd.Serialize(allocatedBuffer);
+    }
+
+    bool Device::OnCompactedSize(uint64_t requestSerial, uint32_t status, uint64_t compactedSize) {
+        switch (status) {
+            case WGPURayTracingAccelerationContainerCompactedSizeStatus_Success:
+            case WGPURayTracingAccelerationContainerCompactedSizeStatus_Error:
+            case WGPURayTracingAccelerationContainerCompactedSizeStatus_Unknown:
+            case WGPURayTracingAccelerationContainerCompactedSizeStatus_DeviceLost:
+                break;
+            default:
+                return false;
+        }
+
+        auto requestIt = mCompactedSizeRequests.find(requestSerial);
+        if (requestIt == mCompactedSizeRequests.end()) {
+            return false;
+        }
+
+        CompactedSizeRequestData request = std::move(requestIt->second);
+
+        mCompactedSizeRequests.erase(requestIt);
+        request.callback(
+            static_cast<WGPURayTracingAccelerationContainerCompactedSizeStatus>(status),
+            compactedSize, request.userdata);
+        return true;
+    }
+
+    void Device::RequestStatistics(WGPUDeviceStatisticsCallback callback, void* userdata) {
+        uint64_t serial = mStatisticsRequestSerial++;
+        ASSERT(mStatisticsRequests.find(serial) == mStatisticsRequests.end());
+
+        mStatisticsRequests[serial] = {callback, userdata};
+
+        DeviceGetStatisticsCmd cmd;
+        cmd.device = reinterpret_cast<WGPUDevice>(this);
+        cmd.requestSerial = serial;
+
+        Client* wireClient = GetClient();
+        size_t requiredSize = cmd.GetRequiredSize();
+        char* allocatedBuffer = static_cast<char*>(wireClient->GetCmdSpace(requiredSize));
+        cmd.Serialize(allocatedBuffer, *wireClient);
+    }
+
+    bool Device::OnStatistics(uint64_t requestSerial,
+                              uint32_t status,
+                              const WGPUDeviceStatistics* statistics) {
+        switch (status) {
+            case WGPUDeviceStatisticsStatus_Success:
+            case WGPUDeviceStatisticsStatus_DeviceLost:
+            case WGPUDeviceStatisticsStatus_Unknown:
+                break;
+            default:
+                return false;
+        }
+
+        auto requestIt = mStatisticsRequests.find(requestSerial);
+        if (requestIt == mStatisticsRequests.end()) {
+            return false;
+        }
+
+        StatisticsRequestData request = std::move(requestIt->second);
+
+        mStatisticsRequests.erase(requestIt);
+        request.callback(static_cast<WGPUDeviceStatisticsStatus>(status), statistics,
+                         request.userdata);
+        return true;
+    }
+
+    void Device::CreateComputePipelineAsync(WGPUComputePipelineDescriptor const* descriptor,
+                                            WGPUCreateComputePipelineAsyncCallback callback,
+                                            void* userdata) {
+        uint64_t serial = mCreatePipelineAsyncRequestSerial++;
+        ASSERT(mCreatePipelineAsyncRequests.find(serial) == mCreatePipelineAsyncRequests.end());
+
+        auto* allocation = mClient->ComputePipelineAllocator().New(this);
+
+        CreatePipelineAsyncRequest request;
+        request.createComputePipelineAsyncCallback = callback;
+        request.userdata = userdata;
+        request.pipelineObjectId = allocation->object->id;
+        mCreatePipelineAsyncRequests[serial] = request;
+
+        DeviceCreateComputePipelineAsyncCmd cmd;
+        cmd.device = reinterpret_cast<WGPUDevice>(this);
+        cmd.requestSerial = serial;
+        cmd.pipelineObjectHandle = ObjectHandle{allocation->object->id, allocation->generation};
+        cmd.descriptor = descriptor;
+
+        size_t requiredSize = cmd.GetRequiredSize();
+        char* allocatedBuffer = static_cast<char*>(mClient->GetCmdSpace(requiredSize));
+        cmd.Serialize(allocatedBuffer, *mClient);
+    }
+
+    void Device::CreateRenderPipelineAsync(WGPURenderPipelineDescriptor const* descriptor,
+                                           WGPUCreateRenderPipelineAsyncCallback callback,
+                                           void* userdata) {
+        uint64_t serial = mCreatePipelineAsyncRequestSerial++;
+        ASSERT(mCreatePipelineAsyncRequests.find(serial) == mCreatePipelineAsyncRequests.end());
+
+        auto* allocation = mClient->RenderPipelineAllocator().New(this);
+
+        CreatePipelineAsyncRequest request;
+        request.createRenderPipelineAsyncCallback = callback;
+        request.userdata = userdata;
+        request.pipelineObjectId = allocation->object->id;
+        mCreatePipelineAsyncRequests[serial] = request;
+
+        DeviceCreateRenderPipelineAsyncCmd cmd;
+        cmd.device = reinterpret_cast<WGPUDevice>(this);
+        cmd.requestSerial = serial;
+        cmd.pipelineObjectHandle = ObjectHandle{allocation->object->id, allocation->generation};
+        cmd.descriptor = descriptor;
+
+        size_t requiredSize = cmd.GetRequiredSize();
+        char* allocatedBuffer = static_cast<char*>(mClient->GetCmdSpace(requiredSize));
+        cmd.Serialize(allocatedBuffer, *mClient);
+    }
+
+    void Device::CreateRayTracingPipelineAsync(WGPURayTracingPipelineDescriptor const* descriptor,
+                                               WGPUCreateRayTracingPipelineAsyncCallback callback,
+                                               void* userdata) {
+        uint64_t serial = mCreatePipelineAsyncRequestSerial++;
+        ASSERT(mCreatePipelineAsyncRequests.find(serial) == mCreatePipelineAsyncRequests.end());
+
+        auto* allocation = mClient->RayTracingPipelineAllocator().New(this);
+
+        CreatePipelineAsyncRequest request;
+        request.createRayTracingPipelineAsyncCallback = callback;
+        request.userdata = userdata;
+        request.pipelineObjectId = allocation->object->id;
+        mCreatePipelineAsyncRequests[serial] = request;
+
+        DeviceCreateRayTracingPipelineAsyncCmd cmd;
+        cmd.device = reinterpret_cast<WGPUDevice>(this);
+        cmd.requestSerial = serial;
+        cmd.pipelineObjectHandle = ObjectHandle{allocation->object->id, allocation->generation};
+        cmd.descriptor = descriptor;
+
+        size_t requiredSize = cmd.GetRequiredSize();
+        char* allocatedBuffer = static_cast<char*>(mClient->GetCmdSpace(requiredSize));
+        cmd.Serialize(allocatedBuffer, *mClient);
+    }
+
+    bool Device::OnCreatePipelineAsyncCallback(uint64_t requestSerial,
+                                               uint32_t status,
+                                               const char* message) {
+        switch (status) {
+            case WGPUCreatePipelineAsyncStatus_Success:
+            case WGPUCreatePipelineAsyncStatus_Error:
+            case WGPUCreatePipelineAsyncStatus_DeviceLost:
+            case WGPUCreatePipelineAsyncStatus_DeviceDestroyed:
+            case WGPUCreatePipelineAsyncStatus_Unknown:
+                break;
+            default:
+                return false;
+        }
+
+        auto requestIt = mCreatePipelineAsyncRequests.find(requestSerial);
+        if (requestIt == mCreatePipelineAsyncRequests.end()) {
+            return false;
+        }
+
+        CreatePipelineAsyncRequest request = std::move(requestIt->second);
+        mCreatePipelineAsyncRequests.erase(requestIt);
+
+        // The server frees its pipeline object when the creation fails, so the client object is
+        // freed without sending a DestroyObject command.
+        const bool success = status == WGPUCreatePipelineAsyncStatus_Success;
+        const WGPUCreatePipelineAsyncStatus pipelineStatus =
+            static_cast<WGPUCreatePipelineAsyncStatus>(status);
+
+        if (request.createComputePipelineAsyncCallback != nullptr) {
+            auto& allocator = mClient->ComputePipelineAllocator();
+            ComputePipeline* pipeline = allocator.GetObject(request.pipelineObjectId);
+            if (!success) {
+                allocator.Free(pipeline);
+                pipeline = nullptr;
+            }
+            request.createComputePipelineAsyncCallback(
+                pipelineStatus, reinterpret_cast<WGPUComputePipeline>(pipeline), message,
+                request.userdata);
+        } else if (request.createRenderPipelineAsyncCallback != nullptr) {
+            auto& allocator = mClient->RenderPipelineAllocator();
+            RenderPipeline* pipeline = allocator.GetObject(request.pipelineObjectId);
+            if (!success) {
+                allocator.Free(pipeline);
+                pipeline = nullptr;
+            }
+            request.createRenderPipelineAsyncCallback(
+                pipelineStatus, reinterpret_cast<WGPURenderPipeline>(pipeline), message,
+                request.userdata);
+        } else {
+            auto& allocator = mClient->RayTracingPipelineAllocator();
+            RayTracingPipeline* pipeline = allocator.GetObject(request.pipelineObjectId);
+            if (!success) {
+                allocator.Free(pipeline);
+                pipeline = nullptr;
+            }
+            request.createRayTracingPipelineAsyncCallback(
+                pipelineStatus, reinterpret_cast<WGPURayTracingPipeline>(pipeline), message,
+                request.userdata);
+        }
+        return true;
+    }
+
     WGPUQueue Device::GetDefaultQueue() {
         mDefaultQueue->refcount++;
         return reinterpret_cast<WGPUQueue>(mDefaultQueue);
@@ -41,6 +41,33 @@ namespace dawn_wire { namespace client {
         bool RequestPopErrorScope(WGPUErrorCallback callback, void* userdata);
         bool PopErrorScope(uint64_t requestSerial, WGPUErrorType type, const char* message);
 
+        // Compacted size queries are answered by the device like error scopes because
+        // acceleration containers have no client-side state.
+        void RequestCompactedSize(uint32_t containerId,
+                                  WGPURayTracingAccelerationContainerCompactedSizeCallback callback,
+                                  void* userdata);
+        bool OnCompactedSize(uint64_t requestSerial, uint32_t status, uint64_t compactedSize);
+
+        void RequestStatistics(WGPUDeviceStatisticsCallback callback, void* userdata);
+        bool OnStatistics(uint64_t requestSerial,
+                          uint32_t status,
+                          const WGPUDeviceStatistics* statistics);
+
+        // The pipeline object is allocated when the creation is requested but only given to the
+        // application in the callback, and freed if the creation fails.
+        void CreateComputePipelineAsync(WGPUComputePipelineDescriptor const* descriptor,
+                                        WGPUCreateComputePipelineAsyncCallback callback,
+                                        void* userdata);
+        void CreateRenderPipelineAsync(WGPURenderPipelineDescriptor const* descriptor,
+                                       WGPUCreateRenderPipelineAsyncCallback callback,
+                                       void* userdata);
+        void CreateRayTracingPipelineAsync(WGPURayTracingPipelineDescriptor const* descriptor,
+                                           WGPUCreateRayTracingPipelineAsyncCallback callback,
+                                           void* userdata);
+        bool OnCreatePipelineAsyncCallback(uint64_t requestSerial,
+                                           uint32_t status,
+                                           const char* message);
+
         WGPUQueue GetDefaultQueue();
 
       private:
@@ -52,6 +79,32 @@ namespace dawn_wire { namespace client {
         uint64_t mErrorScopeRequestSerial = 0;
         uint64_t mErrorScopeStackSize = 0;
 
+        struct CompactedSizeRequestData {
+            WGPURayTracingAccelerationContainerCompactedSizeCallback callback = nullptr;
+            void* userdata = nullptr;
+        };
+        std::map<uint64_t, CompactedSizeRequestData> mCompactedSizeRequests;
+        uint64_t mCompactedSizeRequestSerial = 0;
+
+        struct StatisticsRequestData {
+            WGPUDeviceStatisticsCallback callback = nullptr;
+            void* userdata = nullptr;
+        };
+        std::map<uint64_t, StatisticsRequestData> mStatisticsRequests;
+        uint64_t mStatisticsRequestSerial = 0;
+
+        // Only the callback of the type of the requested pipeline is set.
+        struct CreatePipelineAsyncRequest {
+            WGPUCreateComputePipelineAsyncCallback createComputePipelineAsyncCallback = nullptr;
+            WGPUCreateRenderPipelineAsyncCallback createRenderPipelineAsyncCallback = nullptr;
+            WGPUCreateRayTracingPipelineAsyncCallback createRayTracingPipelineAsyncCallback =
+                nullptr;
+            void* userdata = nullptr;
+            uint32_t pipelineObjectId = 0;
+        };
+        std::map<uint64_t, CreatePipelineAsyncRequest> mCreatePipelineAsyncRequests;
+        uint64_t mCreatePipelineAsyncRequestSerial = 0;
+
         Client* mClient = nullptr;
         WGPUErrorCallback mErrorCallback = nullptr;
         WGPUDeviceLostCallback mDeviceLostCallback = nullptr;
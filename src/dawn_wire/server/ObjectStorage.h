@@ -15,6 +15,7 @@
 #ifndef DAWNWIRE_SERVER_OBJECTSTORAGE_H_
 #define DAWNWIRE_SERVER_OBJECTSTORAGE_H_
 
+#include "common/Assert.h"
 #include "dawn_wire/WireCmd_autogen.h"
 #include "dawn_wire/WireServer.h"
 
@@ -20,8 +20,12 @@ namespace dawn_wire { namespace server {
     Server::Server(WGPUDevice device,
                    const DawnProcTable& procs,
                    CommandSerializer* serializer,
-                   MemoryTransferService* memoryTransferService)
-        : mSerializer(serializer), mProcs(procs), mMemoryTransferService(memoryTransferService) {
+                   MemoryTransferService* memoryTransferService,
+                   dawn_platform::Platform* platform)
+        : mSerializer(serializer),
+          mProcs(procs),
+          mMemoryTransferService(memoryTransferService),
+          mPlatform(platform) {
         if (mMemoryTransferService == nullptr) {
             // If a MemoryTransferService is not provided, fallback to inline memory.
             mOwnedMemoryTransferService = CreateInlineMemoryTransferService();
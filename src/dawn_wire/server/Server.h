@@ -17,6 +17,10 @@
 
 #include "dawn_wire/server/ServerBase_autogen.h"
 
+namespace dawn_platform {
+    class Platform;
+}
+
 namespace dawn_wire { namespace server {
 
     class Server;
@@ -39,6 +43,22 @@ namespace dawn_wire { namespace server {
         uint64_t requestSerial;
     };
 
+    struct CompactedSizeUserdata {
+        Server* server;
+        uint64_t requestSerial;
+    };
+
+    struct StatisticsUserdata {
+        Server* server;
+        uint64_t requestSerial;
+    };
+
+    struct CreatePipelineAsyncUserdata {
+        Server* server;
+        uint64_t requestSerial;
+        ObjectHandle pipeline;
+    };
+
     struct FenceCompletionUserdata {
         Server* server;
         ObjectHandle fence;
@@ -50,7 +70,8 @@ namespace dawn_wire { namespace server {
         Server(WGPUDevice device,
                const DawnProcTable& procs,
                CommandSerializer* serializer,
-               MemoryTransferService* memoryTransferService);
+               MemoryTransferService* memoryTransferService,
+               dawn_platform::Platform* platform);
         ~Server();
 
         const volatile char* HandleCommands(const volatile char* commands, size_t size);
@@ -64,6 +85,9 @@ namespace dawn_wire { namespace server {
         static void ForwardUncapturedError(WGPUErrorType type, const char* message, void* userdata);
         static void ForwardDeviceLost(const char* message, void* userdata);
         static void ForwardPopErrorScope(WGPUErrorType type, const char* message, void* userdata);
+        static void ForwardStatistics(WGPUDeviceStatisticsStatus status,
+                                      const WGPUDeviceStatistics* statistics,
+                                      void* userdata);
         static void ForwardBufferMapReadAsync(WGPUBufferMapAsyncStatus status,
                                               const void* ptr,
                                               uint64_t dataLength,
@@ -73,6 +97,22 @@ namespace dawn_wire { namespace server {
                                                uint64_t dataLength,
                                                void* userdata);
         static void ForwardFenceCompletedValue(WGPUFenceCompletionStatus status, void* userdata);
+        static void ForwardCompactedSize(
+            WGPURayTracingAccelerationContainerCompactedSizeStatus status,
+            uint64_t compactedSize,
+            void* userdata);
+        static void ForwardCreateComputePipelineAsync(WGPUCreatePipelineAsyncStatus status,
+                                                      WGPUComputePipeline pipeline,
+                                                      const char* message,
+                                                      void* userdata);
+        static void ForwardCreateRenderPipelineAsync(WGPUCreatePipelineAsyncStatus status,
+                                                     WGPURenderPipeline pipeline,
+                                                     const char* message,
+                                                     void* userdata);
+        static void ForwardCreateRayTracingPipelineAsync(WGPUCreatePipelineAsyncStatus status,
+                                                         WGPURayTracingPipeline pipeline,
+                                                         const char* message,
+                                                         void* userdata);
 
         // Error callbacks
         void OnUncapturedError(WGPUErrorType type, const char* message);
@@ -80,6 +120,9 @@ namespace dawn_wire { namespace server {
         void OnDevicePopErrorScope(WGPUErrorType type,
                                    const char* message,
                                    ErrorScopeUserdata* userdata);
+        void OnDeviceStatistics(WGPUDeviceStatisticsStatus status,
+                                const WGPUDeviceStatistics* statistics,
+                                StatisticsUserdata* userdata);
         void OnBufferMapReadAsyncCallback(WGPUBufferMapAsyncStatus status,
                                           const void* ptr,
                                           uint64_t dataLength,
@@ -90,6 +133,24 @@ namespace dawn_wire { namespace server {
                                            MapUserdata* userdata);
         void OnFenceCompletedValueUpdated(WGPUFenceCompletionStatus status,
                                           FenceCompletionUserdata* userdata);
+        void OnCompactedSize(WGPURayTracingAccelerationContainerCompactedSizeStatus status,
+                             uint64_t compactedSize,
+                             CompactedSizeUserdata* userdata);
+        void OnCreateComputePipelineAsyncCallback(WGPUCreatePipelineAsyncStatus status,
+                                                  WGPUComputePipeline pipeline,
+                                                  const char* message,
+                                                  CreatePipelineAsyncUserdata* userdata);
+        void OnCreateRenderPipelineAsyncCallback(WGPUCreatePipelineAsyncStatus status,
+                                                 WGPURenderPipeline pipeline,
+                                                 const char* message,
+                                                 CreatePipelineAsyncUserdata* userdata);
+        void OnCreateRayTracingPipelineAsyncCallback(WGPUCreatePipelineAsyncStatus status,
+                                                     WGPURayTracingPipeline pipeline,
+                                                     const char* message,
+                                                     CreatePipelineAsyncUserdata* userdata);
+        void SerializeCreatePipelineAsyncCallback(uint64_t requestSerial,
+                                                  WGPUCreatePipelineAsyncStatus status,
+                                                  const char* message);
 
 #include "dawn_wire/server/ServerPrototypes_autogen.inc"
 
@@ -98,6 +159,7 @@ namespace dawn_wire { namespace server {
         DawnProcTable mProcs;
         std::unique_ptr<MemoryTransferService> mOwnedMemoryTransferService = nullptr;
         MemoryTransferService* mMemoryTransferService = nullptr;
+        dawn_platform::Platform* mPlatform = nullptr;
     };
 
     std::unique_ptr<MemoryTransferService> CreateInlineMemoryTransferService();
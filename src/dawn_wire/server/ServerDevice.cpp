@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "common/Assert.h"
 #include "dawn_wire/server/Server.h"
 
 namespace dawn_wire { namespace server {
@@ -78,4 +79,214 @@ namespace dawn_wire { namespace server {
         cmd.Serialize(allocatedBuffer);
     }
 
+    bool Server::DoDeviceGetStatistics(WGPUDevice cDevice, uint64_t requestSerial) {
+        StatisticsUserdata* userdata = new StatisticsUserdata;
+        userdata->server = this;
+        userdata->requestSerial = requestSerial;
+
+        mProcs.deviceGetStatistics(cDevice, ForwardStatistics, userdata);
+        return true;
+    }
+
+    // static
+    void Server::ForwardStatistics(WGPUDeviceStatisticsStatus status,
+                                   const WGPUDeviceStatistics* statistics,
+                                   void* userdata) {
+        auto* data = reinterpret_cast<StatisticsUserdata*>(userdata);
+        data->server->OnDeviceStatistics(status, statistics, data);
+    }
+
+    void Server::OnDeviceStatistics(WGPUDeviceStatisticsStatus status,
+                                    const WGPUDeviceStatistics* statistics,
+                                    StatisticsUserdata* userdata) {
+        std::unique_ptr<StatisticsUserdata> data{userdata};
+
+        ReturnDeviceGetStatisticsCallbackCmd cmd;
+        cmd.requestSerial = data->requestSerial;
+        cmd.status = status;
+        cmd.statistics = statistics;
+
+        size_t requiredSize = cmd.GetRequiredSize();
+        char* allocatedBuffer = static_cast<char*>(GetCmdSpace(requiredSize));
+        cmd.Serialize(allocatedBuffer);
+    }
+
+    bool Server::DoDeviceCreateComputePipelineAsync(
+        WGPUDevice cDevice,
+        uint64_t requestSerial,
+        ObjectHandle pipelineObjectHandle,
+        const WGPUComputePipelineDescriptor* descriptor) {
+        auto* resultData = ComputePipelineObjects().Allocate(pipelineObjectHandle.id);
+        if (resultData == nullptr) {
+            return false;
+        }
+        resultData->generation = pipelineObjectHandle.generation;
+
+        CreatePipelineAsyncUserdata* userdata = new CreatePipelineAsyncUserdata;
+        userdata->server = this;
+        userdata->requestSerial = requestSerial;
+        userdata->pipeline = pipelineObjectHandle;
+
+        mProcs.deviceCreateComputePipelineAsync(
+            cDevice, descriptor, ForwardCreateComputePipelineAsync, userdata);
+        return true;
+    }
+
+    // static
+    void Server::ForwardCreateComputePipelineAsync(WGPUCreatePipelineAsyncStatus status,
+                                                   WGPUComputePipeline pipeline,
+                                                   const char* message,
+                                                   void* userdata) {
+        auto* data = reinterpret_cast<CreatePipelineAsyncUserdata*>(userdata);
+        data->server->OnCreateComputePipelineAsyncCallback(status, pipeline, message, data);
+    }
+
+    void Server::OnCreateComputePipelineAsyncCallback(WGPUCreatePipelineAsyncStatus status,
+                                                      WGPUComputePipeline pipeline,
+                                                      const char* message,
+                                                      CreatePipelineAsyncUserdata* userdata) {
+        std::unique_ptr<CreatePipelineAsyncUserdata> data{userdata};
+
+        // The object is gone if the server was destroyed while the pipeline was created.
+        auto* pipelineData = ComputePipelineObjects().Get(data->pipeline.id);
+        if (pipelineData == nullptr || pipelineData->generation != data->pipeline.generation) {
+            if (pipeline != nullptr) {
+                mProcs.computePipelineRelease(pipeline);
+            }
+            return;
+        }
+
+        // The client frees its object when the creation fails.
+        if (status == WGPUCreatePipelineAsyncStatus_Success) {
+            pipelineData->handle = pipeline;
+        } else {
+            ComputePipelineObjects().Free(data->pipeline.id);
+        }
+
+        SerializeCreatePipelineAsyncCallback(data->requestSerial, status, message);
+    }
+
+    bool Server::DoDeviceCreateRenderPipelineAsync(
+        WGPUDevice cDevice,
+        uint64_t requestSerial,
+        ObjectHandle pipelineObjectHandle,
+        const WGPURenderPipelineDescriptor* descriptor) {
+        auto* resultData = RenderPipelineObjects().Allocate(pipelineObjectHandle.id);
+        if (resultData == nullptr) {
+            return false;
+        }
+        resultData->generation = pipelineObjectHandle.generation;
+
+        CreatePipelineAsyncUserdata* userdata = new CreatePipelineAsyncUserdata;
+        userdata->server = this;
+        userdata->requestSerial = requestSerial;
+        userdata->pipeline = pipelineObjectHandle;
+
+        mProcs.deviceCreateRenderPipelineAsync(
+            cDevice, descriptor, ForwardCreateRenderPipelineAsync, userdata);
+        return true;
+    }
+
+    // static
+    void Server::ForwardCreateRenderPipelineAsync(WGPUCreatePipelineAsyncStatus status,
+                                                  WGPURenderPipeline pipeline,
+                                                  const char* message,
+                                                  void* userdata) {
+        auto* data = reinterpret_cast<CreatePipelineAsyncUserdata*>(userdata);
+        data->server->OnCreateRenderPipelineAsyncCallback(status, pipeline, message, data);
+    }
+
+    void Server::OnCreateRenderPipelineAsyncCallback(WGPUCreatePipelineAsyncStatus status,
+                                                     WGPURenderPipeline pipeline,
+                                                     const char* message,
+                                                     CreatePipelineAsyncUserdata* userdata) {
+        std::unique_ptr<CreatePipelineAsyncUserdata> data{userdata};
+
+        // The object is gone if the server was destroyed while the pipeline was created.
+        auto* pipelineData = RenderPipelineObjects().Get(data->pipeline.id);
+        if (pipelineData == nullptr || pipelineData->generation != data->pipeline.generation) {
+            if (pipeline != nullptr) {
+                mProcs.renderPipelineRelease(pipeline);
+            }
+            return;
+        }
+
+        // The client frees its object when the creation fails.
+        if (status == WGPUCreatePipelineAsyncStatus_Success) {
+            pipelineData->handle = pipeline;
+        } else {
+            RenderPipelineObjects().Free(data->pipeline.id);
+        }
+
+        SerializeCreatePipelineAsyncCallback(data->requestSerial, status, message);
+    }
+
+    bool Server::DoDeviceCreateRayTracingPipelineAsync(
+        WGPUDevice cDevice,
+        uint64_t requestSerial,
+        ObjectHandle pipelineObjectHandle,
+        const WGPURayTracingPipelineDescriptor* descriptor) {
+        auto* resultData = RayTracingPipelineObjects().Allocate(pipelineObjectHandle.id);
+        if (resultData == nullptr) {
+            return false;
+        }
+        resultData->generation = pipelineObjectHandle.generation;
+
+        CreatePipelineAsyncUserdata* userdata = new CreatePipelineAsyncUserdata;
+        userdata->server = this;
+        userdata->requestSerial = requestSerial;
+        userdata->pipeline = pipelineObjectHandle;
+
+        mProcs.deviceCreateRayTracingPipelineAsync(
+            cDevice, descriptor, ForwardCreateRayTracingPipelineAsync, userdata);
+        return true;
+    }
+
+    // static
+    void Server::ForwardCreateRayTracingPipelineAsync(WGPUCreatePipelineAsyncStatus status,
+                                                      WGPURayTracingPipeline pipeline,
+                                                      const char* message,
+                                                      void* userdata) {
+        auto* data = reinterpret_cast<CreatePipelineAsyncUserdata*>(userdata);
+        data->server->OnCreateRayTracingPipelineAsyncCallback(status, pipeline, message, data);
+    }
+
+    void Server::OnCreateRayTracingPipelineAsyncCallback(WGPUCreatePipelineAsyncStatus status,
+                                                         WGPURayTracingPipeline pipeline,
+                                                         const char* message,
+                                                         CreatePipelineAsyncUserdata* userdata) {
+        std::unique_ptr<CreatePipelineAsyncUserdata> data{userdata};
+
+        // The object is gone if the server was destroyed while the pipeline was created.
+        auto* pipelineData = RayTracingPipelineObjects().Get(data->pipeline.id);
+        if (pipelineData == nullptr || pipelineData->generation != data->pipeline.generation) {
+            if (pipeline != nullptr) {
+                mProcs.rayTracingPipelineRelease(pipeline);
+            }
+            return;
+        }
+
+        // The client frees its object when the creation fails.
+        if (status == WGPUCreatePipelineAsyncStatus_Success) {
+            pipelineData->handle = pipeline;
+        } else {
+            RayTracingPipelineObjects().Free(data->pipeline.id);
+        }
+
+        SerializeCreatePipelineAsyncCallback(data->requestSerial, status, message);
+    }
+
+    void Server::SerializeCreatePipelineAsyncCallback(uint64_t requestSerial,
+                                                      WGPUCreatePipelineAsyncStatus status,
+                                                      const char* message) {
+        ReturnDeviceCreatePipelineAsyncCallbackCmd cmd;
+        cmd.requestSerial = requestSerial;
+        cmd.status = status;
+        cmd.message = message;
+
+        size_t requiredSize = cmd.GetRequiredSize();
+        char* allocatedBuffer = static_cast<char*>(GetCmdSpace(requiredSize));
+        cmd.Serialize(allocatedBuffer);
+    }
+
 }}  // namespace dawn_wire::server
@@ -0,0 +1,65 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dawn_wire/server/Server.h"
+
+#include <memory>
+
+namespace dawn_wire { namespace server {
+
+    bool Server::DoRayTracingAccelerationContainerGetCompactedSizeAsync(ObjectId containerId,
+                                                                        uint64_t requestSerial) {
+        // The null object isn't valid as `self`
+        if (containerId == 0) {
+            return false;
+        }
+
+        auto* container = RayTracingAccelerationContainerObjects().Get(containerId);
+        if (container == nullptr) {
+            return false;
+        }
+
+        CompactedSizeUserdata* userdata = new CompactedSizeUserdata;
+        userdata->server = this;
+        userdata->requestSerial = requestSerial;
+
+        mProcs.rayTracingAccelerationContainerGetCompactedSizeAsync(
+            container->handle, ForwardCompactedSize, userdata);
+        return true;
+    }
+
+    // static
+    void Server::ForwardCompactedSize(WGPURayTracingAccelerationContainerCompactedSizeStatus status,
+                                      uint64_t compactedSize,
+                                      void* userdata) {
+        auto* data = static_cast<CompactedSizeUserdata*>(userdata);
+        data->server->OnCompactedSize(status, compactedSize, data);
+    }
+
+    void Server::OnCompactedSize(WGPURayTracingAccelerationContainerCompactedSizeStatus status,
+                                 uint64_t compactedSize,
+                                 CompactedSizeUserdata* userdata) {
+        std::unique_ptr<CompactedSizeUserdata> data(userdata);
+
+        ReturnRayTracingAccelerationContainerCompactedSizeCallbackCmd cmd;
+        cmd.requestSerial = data->requestSerial;
+        cmd.status = status;
+        cmd.compactedSize = compactedSize;
+
+        size_t requiredSize = cmd.GetRequiredSize();
+        char* allocatedBuffer = static_cast<char*>(GetCmdSpace(requiredSize));
+        cmd.Serialize(allocatedBuffer);
+    }
+
+}}  // namespace dawn_wire::server
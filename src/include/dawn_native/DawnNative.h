@@ -178,6 +178,20 @@ namespace dawn_native {
     // Backdoor to get the number of deprecation warnings for testing
     DAWN_NATIVE_EXPORT size_t GetDeprecationWarningCountForTesting(WGPUDevice device);
 
+    // How an acceleration container has been updated by the commands submitted so far.
+    struct DAWN_NATIVE_EXPORT AccelerationContainerUpdateStats {
+        // Builds, including the rebuilds of containers created with the AllowUpdate usage.
+        uint64_t buildCount = 0;
+        // Updates, which refit the container without changing its topology.
+        uint64_t refitCount = 0;
+        // Refits since the last build. The quality of the container degrades with every refit so
+        // applications can use this to decide when to rebuild it.
+        uint64_t refitCountSinceBuild = 0;
+    };
+
+    DAWN_NATIVE_EXPORT AccelerationContainerUpdateStats
+    GetAccelerationContainerUpdateStats(WGPURayTracingAccelerationContainer container);
+
     //  Query if texture has been initialized
     DAWN_NATIVE_EXPORT bool IsTextureSubresourceInitialized(WGPUTexture texture,
                                                             uint32_t baseMipLevel,
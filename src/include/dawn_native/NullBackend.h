@@ -20,6 +20,50 @@
 
 namespace dawn_native { namespace null {
     DAWN_NATIVE_EXPORT DawnSwapChainImplementation CreateNativeSwapChainImpl();
+
+    // Sets the number of threads, including the submitting thread, that build acceleration
+    // containers. Zero, the default, uses all the hardware threads.
+    DAWN_NATIVE_EXPORT void SetAccelerationContainerBuildThreadCount(WGPUDevice device,
+                                                                     uint32_t threadCount);
+
+    struct DAWN_NATIVE_EXPORT Ray {
+        float origin[3];
+        float tMin;
+        float direction[3];
+        float tMax;
+        uint32_t cullMask = 0xFF;
+    };
+
+    struct DAWN_NATIVE_EXPORT RayHit {
+        bool hit;
+        float t;
+        // Barycentric coordinates of the hit, zero for AABB geometries.
+        float u;
+        float v;
+        uint32_t primitiveIndex;
+        uint32_t geometryIndex;
+        uint32_t instanceIndex;
+        uint32_t instanceId;
+    };
+
+    struct DAWN_NATIVE_EXPORT TraceRaysOptions {
+        // Use the SIMD traversal kernel when the CPU supports it, the scalar one otherwise.
+        bool useSIMD = true;
+        // Trace consecutive rays by packets of four. This is faster when neighboring rays are
+        // coherent, like primary rays ordered by 2x2 tiles of pixels, and slower otherwise.
+        bool usePackets = false;
+    };
+
+    // Traces |rayCount| rays against a built acceleration container of a Null device on the CPU
+    // and writes the closest hit of each ray to |hits|. The traversal doesn't run any shader,
+    // triangles are hit on both faces and AABBs are hit where the ray enters them. This is meant
+    // as a reference implementation for tests and benchmarks. |options| may be null to use the
+    // defaults.
+    DAWN_NATIVE_EXPORT void TraceRays(WGPURayTracingAccelerationContainer container,
+                                      const Ray* rays,
+                                      RayHit* hits,
+                                      uint32_t rayCount,
+                                      const TraceRaysOptions* options = nullptr);
 }}  // namespace dawn_native::null
 
 #endif  // DAWNNATIVE_NULLBACKEND_H_
@@ -23,6 +23,53 @@
 #include <vector>
 
 namespace dawn_native { namespace vulkan {
+    // Options to discover the adapter of the fake Vulkan driver built in Dawn. It implements the
+    // entry points used by the backend with in-memory objects and doesn't execute any GPU work,
+    // so that the backend can be tested and profiled on machines without a GPU. It isn't part of
+    // the default adapters.
+    struct DAWN_NATIVE_EXPORT AdapterDiscoveryOptions : public AdapterDiscoveryOptionsBase {
+        AdapterDiscoveryOptions();
+
+        bool useFakeDriver = false;
+    };
+
+    // Counters of the calls a device made to the fake driver since it was created. Everything
+    // is cumulative except the live counts and sizes.
+    struct DAWN_NATIVE_EXPORT FakeDriverStatistics {
+        // Device-level entry points called, including vkQueue* and vkCmd* entry points.
+        uint64_t callCount = 0;
+
+        uint64_t queueSubmitCount = 0;
+        uint64_t submittedCommandBufferCount = 0;
+
+        uint64_t pipelineBarrierCount = 0;
+        uint64_t memoryBarrierCount = 0;
+        uint64_t bufferMemoryBarrierCount = 0;
+        uint64_t imageMemoryBarrierCount = 0;
+
+        uint64_t descriptorSetAllocationCount = 0;
+        // Descriptors written or copied, summed over the descriptorCount of the updates.
+        uint64_t descriptorWriteCount = 0;
+        uint64_t descriptorCopyCount = 0;
+
+        uint64_t memoryAllocationCount = 0;
+        uint64_t memoryAllocationSize = 0;
+        uint64_t liveMemorySize = 0;
+        uint64_t liveObjectCount = 0;
+
+        uint64_t renderPassCount = 0;
+        uint64_t drawCount = 0;
+        uint64_t dispatchCount = 0;
+        uint64_t copyCount = 0;
+    };
+
+    // Returns false if the device doesn't use the fake driver.
+    DAWN_NATIVE_EXPORT bool GetFakeDriverStatistics(WGPUDevice device,
+                                                    FakeDriverStatistics* statistics);
+    // Returns how many times the device called an entry point of the fake driver, for example
+    // "vkCmdPipelineBarrier". Returns 0 if the device doesn't use the fake driver.
+    DAWN_NATIVE_EXPORT uint64_t GetFakeDriverCallCount(WGPUDevice device, const char* entryPoint);
+
     DAWN_NATIVE_EXPORT VkInstance GetInstance(WGPUDevice device);
 
     DAWN_NATIVE_EXPORT PFN_vkVoidFunction GetInstanceProcAddr(WGPUDevice device, const char* pName);
@@ -17,6 +17,7 @@
 
 #include <dawn_native/dawn_native_export.h>
 
+#include <stddef.h>
 #include <stdint.h>
 
 namespace dawn_platform {
@@ -28,6 +29,27 @@ namespace dawn_platform {
         GPUWork,     // Actual GPU work
     };
 
+    class DAWN_NATIVE_EXPORT CachingInterface {
+      public:
+        virtual ~CachingInterface() {
+        }
+
+        // LoadData has two modes. When |valueOut| is nullptr and |valueSize| is 0, it returns the
+        // size of the value stored for |key|, or 0 if there is none. Otherwise it copies the value
+        // stored for |key| into |valueOut|, which is |valueSize| bytes large, and returns the
+        // number of bytes written.
+        virtual size_t LoadData(const void* key,
+                                size_t keySize,
+                                void* valueOut,
+                                size_t valueSize) = 0;
+
+        // StoreData puts a |value| in the cache which corresponds to the |key|.
+        virtual void StoreData(const void* key,
+                               size_t keySize,
+                               const void* value,
+                               size_t valueSize) = 0;
+    };
+
     class DAWN_NATIVE_EXPORT Platform {
       public:
         virtual ~Platform() {
@@ -46,6 +68,15 @@ namespace dawn_platform {
                                        const unsigned char* argTypes,
                                        const uint64_t* argValues,
                                        unsigned char flags) = 0;
+
+        // Returns the persistent cache Dawn uses to store compiled shaders and pipelines across
+        // runs, or nullptr to disable persistent caching. The |fingerprint| identifies the adapter;
+        // the embedder should keep a separate cache per fingerprint. The returned interface must
+        // outlive the devices that use it.
+        virtual CachingInterface* GetCachingInterface(const void* fingerprint,
+                                                      size_t fingerprintSize) {
+            return nullptr;
+        }
     };
 
 }  // namespace dawn_platform
@@ -0,0 +1,104 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DAWNPLATFORM_TRACERECORDERPLATFORM_H_
+#define DAWNPLATFORM_TRACERECORDERPLATFORM_H_
+
+#include <dawn_platform/DawnPlatform.h>
+
+#include <atomic>
+#include <chrono>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace dawn_platform {
+
+    // A platform that records the trace events of Dawn in memory and writes them in the Chrome
+    // trace event format, which can be loaded in chrome://tracing or Perfetto. See
+    // https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU
+    //
+    // Nothing is recorded until StartRecording is called and the trace event call sites only
+    // check a flag while recording is stopped, so the recorder can stay installed in production.
+    // Each thread adds its events to its own fixed-size ring buffer without taking a lock. When a
+    // ring buffer is full, the events of that thread are dropped until WriteJSON drains it.
+    //
+    // The names of the events and arguments aren't copied, so they must outlive the recorder like
+    // the string literals used by the TRACE_EVENT macros. Copied string arguments aren't recorded.
+    //
+    // The trace event call sites cache the enabled flags of the categories for the whole process,
+    // so the flags are shared by all the recorders and only one of them should record at a time.
+    class TraceRecorderPlatform : public Platform {
+      public:
+        static constexpr size_t kDefaultEventsPerThread = 64 * 1024;
+
+        // |eventsPerThread| is rounded up to a power of two.
+        explicit TraceRecorderPlatform(size_t eventsPerThread = kDefaultEventsPerThread);
+        ~TraceRecorderPlatform() override;
+
+        void StartRecording();
+        void StopRecording();
+        bool IsRecording() const;
+
+        // Writes the events recorded since the last call as a JSON object with a "traceEvents"
+        // array, and removes them from the ring buffers. It can be called while other threads
+        // add events, in which case the events added during the call may be left for the next one.
+        void WriteJSON(std::ostream* stream);
+        // Returns false if the file couldn't be written.
+        bool WriteJSONFile(const char* path);
+
+        // The number of events dropped because the ring buffer of their thread was full.
+        uint64_t GetDroppedEventCount() const;
+
+        // dawn_platform::Platform implementation.
+        const unsigned char* GetTraceCategoryEnabledFlag(TraceCategory category) override;
+        double MonotonicallyIncreasingTime() override;
+        uint64_t AddTraceEvent(char phase,
+                               const unsigned char* categoryGroupEnabled,
+                               const char* name,
+                               uint64_t id,
+                               double timestamp,
+                               int numArgs,
+                               const char** argNames,
+                               const unsigned char* argTypes,
+                               const uint64_t* argValues,
+                               unsigned char flags) override;
+
+      private:
+        struct RecordedEvent;
+        class ThreadEventBuffer;
+
+        ThreadEventBuffer* GetThreadEventBuffer();
+
+        // Used by the threads to find their buffer in the thread_local cache, which may contain
+        // the buffer of a previous recorder at the same address.
+        const uint64_t mRecorderId;
+        const size_t mEventsPerThread;
+        const std::chrono::steady_clock::time_point mOrigin;
+
+        std::atomic<bool> mRecording;
+        std::atomic<uint64_t> mDroppedEventCount;
+
+        // Guards the creation of the thread buffers and serializes the calls to WriteJSON, which
+        // is the only reader of the buffers. Adding events doesn't take it.
+        std::mutex mMutex;
+        std::unordered_map<std::thread::id, std::unique_ptr<ThreadEventBuffer>>
+            mThreadEventBuffers;
+    };
+
+}  // namespace dawn_platform
+
+#endif  // DAWNPLATFORM_TRACERECORDERPLATFORM_H_
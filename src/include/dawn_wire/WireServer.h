@@ -21,6 +21,10 @@
 
 struct DawnProcTable;
 
+namespace dawn_platform {
+    class Platform;
+}
+
 namespace dawn_wire {
 
     namespace server {
@@ -33,6 +37,8 @@ namespace dawn_wire {
         const DawnProcTable* procs;
         CommandSerializer* serializer;
         server::MemoryTransferService* memoryTransferService = nullptr;
+        // Optional platform that receives the trace events of the server.
+        dawn_platform::Platform* platform = nullptr;
     };
 
     class DAWN_WIRE_EXPORT WireServer : public CommandHandler {
@@ -40,6 +40,10 @@
 #    include "dawn_native/OpenGLBackend.h"
 #endif  // DAWN_ENABLE_BACKEND_OPENGL
 
+#ifdef DAWN_ENABLE_BACKEND_VULKAN
+#    include "dawn_native/VulkanBackend.h"
+#endif  // DAWN_ENABLE_BACKEND_VULKAN
+
 namespace {
 
     std::string ParamName(wgpu::BackendType type) {
@@ -217,6 +221,11 @@ void DawnTestEnvironment::ParseArgs(int argc, char** argv) {
             continue;
         }
 
+        if (strcmp("--use-fake-vulkan-driver", argv[i]) == 0) {
+            mUseFakeVulkanDriver = true;
+            continue;
+        }
+
         if (strcmp("--skip-validation", argv[i]) == 0) {
             mSkipDawnValidation = true;
             continue;
@@ -347,6 +356,8 @@ void DawnTestEnvironment::ParseArgs(int argc, char** argv) {
                    " to disabled)\n"
                    "  -c, --begin-capture-on-startup: Begin debug capture on startup "
                    "(defaults to no capture)\n"
+                   "  --use-fake-vulkan-driver: Also discover the adapter of the fake Vulkan "
+                   "driver, which doesn't execute GPU work\n"
                    "  --skip-validation: Skip Dawn validation\n"
                    "  --use-spvc: Use spvc for accessing spirv-cross\n"
                    "  --no-use-spvc: Do not use spvc for accessing spirv-cross\n"
@@ -391,6 +402,14 @@ std::unique_ptr<dawn_native::Instance> DawnTestEnvironment::CreateInstanceAndDis
     instance->DiscoverAdapters(&adapterOptions);
 #endif  // DAWN_ENABLE_BACKEND_OPENGL
 
+#ifdef DAWN_ENABLE_BACKEND_VULKAN
+    if (mUseFakeVulkanDriver) {
+        dawn_native::vulkan::AdapterDiscoveryOptions fakeDriverOptions;
+        fakeDriverOptions.useFakeDriver = true;
+        instance->DiscoverAdapters(&fakeDriverOptions);
+    }
+#endif  // DAWN_ENABLE_BACKEND_VULKAN
+
     return instance;
 }
 
@@ -488,6 +507,9 @@ void DawnTestEnvironment::PrintTestConfigurationAndAdapterInfo() const {
         << "\n"
            "BeginCaptureOnStartup: "
         << (mBeginCaptureOnStartup ? "true" : "false")
+        << "\n"
+           "UseFakeVulkanDriver: "
+        << (mUseFakeVulkanDriver ? "true" : "false")
         << "\n"
            "\n"
         << "System adapters: \n";
@@ -201,6 +201,7 @@ class DawnTestEnvironment : public testing::Environment {
     bool mUseSpvcParser = false;
     bool mSpvcParserFlagSeen = false;
     bool mBeginCaptureOnStartup = false;
+    bool mUseFakeVulkanDriver = false;
     bool mHasVendorIdFilter = false;
     uint32_t mVendorIdFilter = 0;
     std::string mWireTraceDir;
@@ -0,0 +1,111 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/DawnTest.h"
+
+#include "utils/ComboRenderPipelineDescriptor.h"
+#include "utils/WGPUHelpers.h"
+
+constexpr static unsigned int kRTSize = 1;
+
+class ReusableCommandBufferTest : public DawnTest {
+  protected:
+    void SetUp() override {
+        DawnTest::SetUp();
+
+        renderPass = utils::CreateBasicRenderPass(device, kRTSize, kRTSize);
+        renderPass.renderPassInfo.cColorAttachments[0].loadOp = wgpu::LoadOp::Load;
+
+        // Draw a triangle covering the whole render target that adds 51 to the red channel
+        // every time it is drawn.
+        utils::ComboRenderPipelineDescriptor descriptor(device);
+        descriptor.vertexStage.module =
+            utils::CreateShaderModule(device, utils::SingleShaderStage::Vertex, R"(
+                #version 450
+                const vec2 pos[3] = vec2[3](vec2(-1.0f, -1.0f), vec2(3.0f, -1.0f),
+                                            vec2(-1.0f, 3.0f));
+                void main() {
+                    gl_Position = vec4(pos[gl_VertexIndex], 0.0, 1.0);
+                })");
+        descriptor.cFragmentStage.module =
+            utils::CreateShaderModule(device, utils::SingleShaderStage::Fragment, R"(
+                #version 450
+                layout(location = 0) out vec4 fragColor;
+                void main() {
+                    fragColor = vec4(51.0 / 255.0, 0.0, 0.0, 0.0);
+                })");
+
+        wgpu::BlendDescriptor blend;
+        blend.operation = wgpu::BlendOperation::Add;
+        blend.srcFactor = wgpu::BlendFactor::One;
+        blend.dstFactor = wgpu::BlendFactor::One;
+        descriptor.cColorStates[0].format = renderPass.colorFormat;
+        descriptor.cColorStates[0].colorBlend = blend;
+        descriptor.cColorStates[0].alphaBlend = blend;
+
+        pipeline = device.CreateRenderPipeline(&descriptor);
+    }
+
+    wgpu::CommandBuffer RecordAdditiveDraw(bool reusable) {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass.renderPassInfo);
+        pass.SetPipeline(pipeline);
+        pass.Draw(3);
+        pass.EndPass();
+
+        wgpu::CommandBufferDescriptor descriptor;
+        descriptor.reusable = reusable;
+        return encoder.Finish(&descriptor);
+    }
+
+    utils::BasicRenderPass renderPass;
+    wgpu::RenderPipeline pipeline;
+};
+
+// Test that a reusable command buffer executes its commands at every submit.
+TEST_P(ReusableCommandBufferTest, SubmitSeveralTimes) {
+    wgpu::CommandBuffer commands = RecordAdditiveDraw(true);
+    for (uint32_t i = 0; i < 3; ++i) {
+        queue.Submit(1, &commands);
+    }
+
+    EXPECT_PIXEL_RGBA8_EQ(RGBA8(153, 0, 0, 0), renderPass.color, 0, 0);
+}
+
+// Test that the lazy clear of the attachment in the first submit doesn't change the load
+// operation used in the next submits.
+TEST_P(ReusableCommandBufferTest, LazyClearOnlyInFirstSubmit) {
+    wgpu::CommandBuffer commands = RecordAdditiveDraw(true);
+    queue.Submit(1, &commands);
+    EXPECT_PIXEL_RGBA8_EQ(RGBA8(51, 0, 0, 0), renderPass.color, 0, 0);
+
+    queue.Submit(1, &commands);
+    EXPECT_PIXEL_RGBA8_EQ(RGBA8(102, 0, 0, 0), renderPass.color, 0, 0);
+}
+
+// Test that reusable and non-reusable command buffers can be submitted together.
+TEST_P(ReusableCommandBufferTest, MixedWithOtherCommandBuffers) {
+    wgpu::CommandBuffer commands[3] = {RecordAdditiveDraw(true), RecordAdditiveDraw(false),
+                                       RecordAdditiveDraw(true)};
+    queue.Submit(3, commands);
+    queue.Submit(1, &commands[0]);
+
+    EXPECT_PIXEL_RGBA8_EQ(RGBA8(204, 0, 0, 0), renderPass.color, 0, 0);
+}
+
+DAWN_INSTANTIATE_TEST(ReusableCommandBufferTest,
+                      D3D12Backend(),
+                      MetalBackend(),
+                      OpenGLBackend(),
+                      VulkanBackend());
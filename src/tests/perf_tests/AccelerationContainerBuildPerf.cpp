@@ -0,0 +1,175 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "dawn_native/NullBackend.h"
+#include "tests/ParamGenerator.h"
+#include "utils/Timer.h"
+
+#include <random>
+
+namespace {
+
+    constexpr unsigned int kNumIterations = 1;
+
+    // The number of threads building the container, including the submitting thread.
+    enum class BuildThreads {
+        Threads_1 = 1,
+        Threads_2 = 2,
+        Threads_4 = 4,
+        Threads_8 = 8,
+    };
+
+    enum class TriangleCount {
+        Triangles_64K = 64 * 1024,
+        Triangles_1M = 1024 * 1024,
+    };
+
+    struct AccelerationContainerBuildParams : AdapterTestParam {
+        AccelerationContainerBuildParams(const AdapterTestParam& param,
+                                         BuildThreads buildThreads,
+                                         TriangleCount triangleCount)
+            : AdapterTestParam(param), buildThreads(buildThreads), triangleCount(triangleCount) {
+        }
+
+        BuildThreads buildThreads;
+        TriangleCount triangleCount;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const AccelerationContainerBuildParams& param) {
+        ostream << static_cast<const AdapterTestParam&>(param);
+        ostream << "_Threads_" << static_cast<uint32_t>(param.buildThreads);
+
+        switch (param.triangleCount) {
+            case TriangleCount::Triangles_64K:
+                ostream << "_Triangles_64K";
+                break;
+            case TriangleCount::Triangles_1M:
+                ostream << "_Triangles_1M";
+                break;
+        }
+        return ostream;
+    }
+
+}  // namespace
+
+// Test building a bottom-level acceleration container over a triangle soup on the CPU
+// implementation of the Null backend.
+class AccelerationContainerBuildPerf
+    : public DawnPerfTestWithParams<AccelerationContainerBuildParams> {
+  public:
+    AccelerationContainerBuildPerf()
+        : DawnPerfTestWithParams(kNumIterations, 1),
+          mTriangleCount(static_cast<uint32_t>(GetParam().triangleCount)),
+          mTimer(utils::CreateTimer()) {
+    }
+    ~AccelerationContainerBuildPerf() override = default;
+
+    void SetUp() override;
+    void TearDown() override;
+
+  protected:
+    std::vector<const char*> GetRequiredExtensions() override {
+        return {"ray_tracing"};
+    }
+
+  private:
+    void Step() override;
+
+    uint32_t mTriangleCount;
+    wgpu::Buffer mVertexBuffer;
+
+    std::unique_ptr<utils::Timer> mTimer;
+    double mBuildTime = 0.0;
+    uint64_t mTrianglesBuilt = 0;
+};
+
+void AccelerationContainerBuildPerf::SetUp() {
+    DawnPerfTestWithParams<AccelerationContainerBuildParams>::SetUp();
+
+    dawn_native::null::SetAccelerationContainerBuildThreadCount(
+        backendDevice, static_cast<uint32_t>(GetParam().buildThreads));
+
+    // Small random triangles scattered in a box, which is a worst case for the memory locality
+    // of the build.
+    wgpu::BufferDescriptor descriptor;
+    descriptor.size = mTriangleCount * 3 * 3 * sizeof(float);
+    descriptor.usage = wgpu::BufferUsage::RayTracing;
+    wgpu::CreateBufferMappedResult result = device.CreateBufferMapped(&descriptor);
+
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> offset(-0.5f, 0.5f);
+    float* vertices = static_cast<float*>(result.data);
+    for (uint32_t i = 0; i < mTriangleCount; ++i) {
+        float center[3] = {position(generator), position(generator), position(generator)};
+        for (uint32_t corner = 0; corner < 3; ++corner) {
+            for (uint32_t axis = 0; axis < 3; ++axis) {
+                *vertices++ = center[axis] + offset(generator);
+            }
+        }
+    }
+    result.buffer.Unmap();
+    mVertexBuffer = result.buffer;
+}
+
+void AccelerationContainerBuildPerf::TearDown() {
+    if (mBuildTime > 0.0) {
+        PrintResult("triangles_per_second", mTrianglesBuilt / mBuildTime, "triangles/s", true);
+    }
+    DawnPerfTestWithParams<AccelerationContainerBuildParams>::TearDown();
+}
+
+void AccelerationContainerBuildPerf::Step() {
+    wgpu::RayTracingAccelerationGeometryVertexDescriptor vertex;
+    vertex.buffer = mVertexBuffer;
+    vertex.format = wgpu::VertexFormat::Float3;
+    vertex.stride = 3 * sizeof(float);
+    vertex.count = mTriangleCount * 3;
+
+    wgpu::RayTracingAccelerationGeometryDescriptor geometry;
+    geometry.type = wgpu::RayTracingAccelerationGeometryType::Triangles;
+    geometry.vertex = &vertex;
+
+    wgpu::RayTracingAccelerationContainerDescriptor descriptor;
+    descriptor.level = wgpu::RayTracingAccelerationContainerLevel::Bottom;
+    descriptor.usage = wgpu::RayTracingAccelerationContainerUsage::PreferFastBuild;
+    descriptor.geometryCount = 1;
+    descriptor.geometries = &geometry;
+    wgpu::RayTracingAccelerationContainer container =
+        device.CreateRayTracingAccelerationContainer(&descriptor);
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    encoder.BuildRayTracingAccelerationContainer(container);
+    wgpu::CommandBuffer commands = encoder.Finish();
+
+    // The build runs synchronously at submit on the Null backend.
+    mTimer->Start();
+    queue.Submit(1, &commands);
+    mTimer->Stop();
+
+    mBuildTime += mTimer->GetElapsedTime();
+    mTrianglesBuilt += mTriangleCount;
+}
+
+TEST_P(AccelerationContainerBuildPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_PERF_TEST_SUITE_P(AccelerationContainerBuildPerf,
+                                   {NullBackend()},
+                                   {BuildThreads::Threads_1, BuildThreads::Threads_2,
+                                    BuildThreads::Threads_4, BuildThreads::Threads_8},
+                                   {TriangleCount::Triangles_64K, TriangleCount::Triangles_1M});
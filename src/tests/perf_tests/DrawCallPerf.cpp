@@ -24,6 +24,8 @@
 namespace {
 
     constexpr unsigned int kNumDraws = 2000;
+    constexpr unsigned int kNumDrawsPerSplitPass = 20;
+    static_assert(kNumDraws % kNumDrawsPerSplitPass == 0, "Split passes must have all the draws");
 
     constexpr uint32_t kTextureSize = 64;
     constexpr size_t kUniformSize = 3 * sizeof(float);
@@ -92,16 +94,22 @@ namespace {
         Yes,  // Record commands in a render bundle
     };
 
+    enum class RenderPass {
+        Single,  // Record all the draws in a single render pass.
+        Split,   // Split the draws in many render passes.
+    };
+
     struct DrawCallParam {
         Pipeline pipelineType;
         VertexBuffer vertexBufferType;
         BindGroup bindGroupType;
         UniformData uniformDataType;
         RenderBundle withRenderBundle;
+        RenderPass renderPassType;
     };
 
     using DrawCallParamTuple =
-        std::tuple<Pipeline, VertexBuffer, BindGroup, UniformData, RenderBundle>;
+        std::tuple<Pipeline, VertexBuffer, BindGroup, UniformData, RenderBundle, RenderPass>;
 
     template <typename T>
     unsigned int AssignParam(T& lhs, T rhs) {
@@ -117,11 +125,12 @@ namespace {
     //  - BindGroup::NoChange
     //  - UniformData::Static
     //  - RenderBundle::No
+    //  - RenderPass::Single
     template <typename... Ts>
     DrawCallParam MakeParam(Ts... args) {
         // Baseline param
         DrawCallParamTuple paramTuple{Pipeline::Static, VertexBuffer::NoChange, BindGroup::NoChange,
-                                      UniformData::Static, RenderBundle::No};
+                                      UniformData::Static, RenderBundle::No, RenderPass::Single};
 
         unsigned int unused[] = {
             0,  // Avoid making a 0-sized array.
@@ -132,7 +141,7 @@ namespace {
         return DrawCallParam{
             std::get<Pipeline>(paramTuple),     std::get<VertexBuffer>(paramTuple),
             std::get<BindGroup>(paramTuple),    std::get<UniformData>(paramTuple),
-            std::get<RenderBundle>(paramTuple),
+            std::get<RenderBundle>(paramTuple), std::get<RenderPass>(paramTuple),
         };
     }
 
@@ -202,6 +211,14 @@ namespace {
                 break;
         }
 
+        switch (param.renderPassType) {
+            case RenderPass::Single:
+                break;
+            case RenderPass::Split:
+                ostream << "_SplitRenderPasses";
+                break;
+        }
+
         return ostream;
     }
 
@@ -221,6 +238,9 @@ namespace {
 //     precomputed in a render bundle.
 //   - Static/Dynamic data: Updating data for each draw is a common use case. It also tests
 //     the efficiency of resource transitions.
+//   - Single/Split render passes: Commands are validated as they are recorded so the cost of
+//     CommandEncoder::Finish, reported as validation_time, only depends on the number of passes.
+//     Comparing with the skip_validation variants shows the cost of the validation of the draws.
 class DrawCallPerf : public DawnPerfTestWithParams<DrawCallParamForTest> {
   public:
     DrawCallPerf() : DawnPerfTestWithParams(kNumDraws, 3) {
@@ -234,8 +254,9 @@ class DrawCallPerf : public DawnPerfTestWithParams<DrawCallParamForTest> {
         return DawnPerfTestWithParams::GetParam().param;
     }
 
+    // Records the draws in [firstDraw, firstDraw + drawCount), setting the static state first.
     template <typename Encoder>
-    void RecordRenderCommands(Encoder encoder);
+    void RecordRenderCommands(Encoder encoder, unsigned int firstDraw, unsigned int drawCount);
 
   private:
     void Step() override;
@@ -463,13 +484,15 @@ void DrawCallPerf::SetUp() {
         descriptor.depthStencilFormat = renderPipelineDesc.cDepthStencilState.format;
 
         wgpu::RenderBundleEncoder encoder = device.CreateRenderBundleEncoder(&descriptor);
-        RecordRenderCommands(encoder);
+        RecordRenderCommands(encoder, 0, kNumDraws);
         mRenderBundle = encoder.Finish();
     }
 }
 
 template <typename Encoder>
-void DrawCallPerf::RecordRenderCommands(Encoder pass) {
+void DrawCallPerf::RecordRenderCommands(Encoder pass,
+                                        unsigned int firstDraw,
+                                        unsigned int drawCount) {
     uint32_t uniformBindGroupIndex = 0;
 
     if (GetParam().pipelineType == Pipeline::Static) {
@@ -490,7 +513,7 @@ void DrawCallPerf::RecordRenderCommands(Encoder pass) {
         pass.SetBindGroup(uniformBindGroupIndex, mUniformBindGroups[0]);
     }
 
-    for (unsigned int i = 0; i < kNumDraws; ++i) {
+    for (unsigned int i = firstDraw; i < firstDraw + drawCount; ++i) {
         switch (GetParam().pipelineType) {
             case Pipeline::Static:
                 break;
@@ -586,21 +609,41 @@ void DrawCallPerf::Step() {
 
     wgpu::CommandEncoder commands = device.CreateCommandEncoder();
     utils::ComboRenderPassDescriptor renderPass({mColorAttachment}, mDepthStencilAttachment);
-    wgpu::RenderPassEncoder pass = commands.BeginRenderPass(&renderPass);
 
-    switch (GetParam().withRenderBundle) {
-        case RenderBundle::No:
-            RecordRenderCommands(pass);
-            break;
-        case RenderBundle::Yes:
-            pass.ExecuteBundles(1, &mRenderBundle);
+    switch (GetParam().renderPassType) {
+        case RenderPass::Single: {
+            wgpu::RenderPassEncoder pass = commands.BeginRenderPass(&renderPass);
+            switch (GetParam().withRenderBundle) {
+                case RenderBundle::No:
+                    RecordRenderCommands(pass, 0, kNumDraws);
+                    break;
+                case RenderBundle::Yes:
+                    pass.ExecuteBundles(1, &mRenderBundle);
+                    break;
+                default:
+                    UNREACHABLE();
+                    break;
+            }
+            pass.EndPass();
             break;
-        default:
-            UNREACHABLE();
+        }
+
+        case RenderPass::Split: {
+            // Render bundles are recorded with all the draws.
+            ASSERT(GetParam().withRenderBundle == RenderBundle::No);
+
+            renderPass.cColorAttachments[0].loadOp = wgpu::LoadOp::Load;
+            renderPass.cDepthStencilAttachmentInfo.depthLoadOp = wgpu::LoadOp::Load;
+            renderPass.cDepthStencilAttachmentInfo.stencilLoadOp = wgpu::LoadOp::Load;
+            for (unsigned int i = 0; i < kNumDraws; i += kNumDrawsPerSplitPass) {
+                wgpu::RenderPassEncoder pass = commands.BeginRenderPass(&renderPass);
+                RecordRenderCommands(pass, i, kNumDrawsPerSplitPass);
+                pass.EndPass();
+            }
             break;
+        }
     }
 
-    pass.EndPass();
     wgpu::CommandBuffer commandBuffer = commands.Finish();
     queue.Submit(1, &commandBuffer);
 }
@@ -663,4 +706,9 @@ DAWN_INSTANTIATE_PERF_TEST_SUITE_P(
                   UniformData::Dynamic),  // Update per-draw data: Multiple bind groups
         MakeParam(BindGroup::Dynamic,
                   UniformData::Dynamic),  // Update per-draw data: Dynamic bind groups
+
+        // Split the draws in many render passes to compare the cost of finishing the command
+        // buffer with the number of passes.
+        MakeParam(RenderPass::Split),
+        MakeParam(BindGroup::Multiple, RenderPass::Split),
     });
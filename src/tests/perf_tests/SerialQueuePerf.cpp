@@ -0,0 +1,140 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "common/SerialMap.h"
+#include "common/SerialQueue.h"
+#include "tests/ParamGenerator.h"
+
+namespace {
+
+    // Each iteration enqueues the values of one serial and retires the oldest serial.
+    constexpr unsigned int kNumIterations = 10000;
+
+    enum class Storage {
+        Queue,
+        Map,
+    };
+
+    enum class SerialsInFlight {
+        Serials_3 = 3,
+        Serials_64 = 64,
+    };
+
+    enum class ValuesPerSerial {
+        Values_1 = 1,
+        Values_32 = 32,
+    };
+
+    struct SerialQueueParams : AdapterTestParam {
+        SerialQueueParams(const AdapterTestParam& param,
+                          Storage storage,
+                          SerialsInFlight serialsInFlight,
+                          ValuesPerSerial valuesPerSerial)
+            : AdapterTestParam(param),
+              storage(storage),
+              serialsInFlight(serialsInFlight),
+              valuesPerSerial(valuesPerSerial) {
+        }
+
+        Storage storage;
+        SerialsInFlight serialsInFlight;
+        ValuesPerSerial valuesPerSerial;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const SerialQueueParams& param) {
+        ostream << static_cast<const AdapterTestParam&>(param);
+
+        switch (param.storage) {
+            case Storage::Queue:
+                ostream << "_SerialQueue";
+                break;
+            case Storage::Map:
+                ostream << "_SerialMap";
+                break;
+        }
+        ostream << "_InFlight_" << static_cast<uint32_t>(param.serialsInFlight);
+        ostream << "_Values_" << static_cast<uint32_t>(param.valuesPerSerial);
+        return ostream;
+    }
+
+}  // namespace
+
+// Test the cost of enqueuing values in SerialQueue and SerialMap and retiring them, the way
+// the backends use them to defer work until the GPU is done with a serial. It doesn't use the
+// device so it only runs on the Null backend.
+class SerialQueuePerf : public DawnPerfTestWithParams<SerialQueueParams> {
+  public:
+    SerialQueuePerf()
+        : DawnPerfTestWithParams(kNumIterations, 1),
+          mSerialsInFlight(static_cast<Serial>(GetParam().serialsInFlight)),
+          mValuesPerSerial(static_cast<uint32_t>(GetParam().valuesPerSerial)) {
+    }
+    ~SerialQueuePerf() override = default;
+
+  private:
+    void Step() override;
+
+    template <typename Container>
+    void Run(Container* container);
+
+    Serial mSerialsInFlight;
+    uint32_t mValuesPerSerial;
+    Serial mSerial = 0;
+    // Accumulates the retired values so that iterating over them isn't optimized out.
+    uint64_t mChecksum = 0;
+
+    SerialQueue<uint64_t> mQueue;
+    SerialMap<uint64_t> mMap;
+};
+
+template <typename Container>
+void SerialQueuePerf::Run(Container* container) {
+    for (unsigned int i = 0; i < kNumIterations; ++i) {
+        mSerial++;
+        for (uint32_t j = 0; j < mValuesPerSerial; ++j) {
+            container->Enqueue(mSerial + j, mSerial);
+        }
+
+        if (mSerial > mSerialsInFlight) {
+            Serial completedSerial = mSerial - mSerialsInFlight;
+            for (uint64_t value : container->IterateUpTo(completedSerial)) {
+                mChecksum += value;
+            }
+            container->ClearUpTo(completedSerial);
+        }
+    }
+}
+
+void SerialQueuePerf::Step() {
+    switch (GetParam().storage) {
+        case Storage::Queue:
+            Run(&mQueue);
+            break;
+        case Storage::Map:
+            Run(&mMap);
+            break;
+    }
+}
+
+TEST_P(SerialQueuePerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_PERF_TEST_SUITE_P(SerialQueuePerf,
+                                   {NullBackend()},
+                                   {Storage::Queue, Storage::Map},
+                                   {SerialsInFlight::Serials_3, SerialsInFlight::Serials_64},
+                                   {ValuesPerSerial::Values_1, ValuesPerSerial::Values_32});
@@ -0,0 +1,266 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/perf_tests/DawnPerfTest.h"
+
+#include "dawn_native/NullBackend.h"
+#include "tests/ParamGenerator.h"
+#include "utils/Timer.h"
+
+#include <cmath>
+#include <limits>
+#include <random>
+
+namespace {
+
+    constexpr unsigned int kNumIterations = 10;
+
+    // The scene is a heightfield of kGridSize x kGridSize quads, about 1M triangles.
+    constexpr uint32_t kGridSize = 724;
+    constexpr float kGridExtent = 200.0f;
+
+    // The rays traced per step, as a square image.
+    constexpr uint32_t kImageSize = 256;
+
+    enum class Kernel {
+        Scalar,
+        SIMD,
+        SIMDPackets,
+    };
+
+    enum class Rays {
+        // Primary rays of a pinhole camera ordered by 2x2 tiles of pixels.
+        Coherent,
+        // Rays with random origins and directions.
+        Incoherent,
+    };
+
+    struct TraceRaysParams : AdapterTestParam {
+        TraceRaysParams(const AdapterTestParam& param, Kernel kernel, Rays rays)
+            : AdapterTestParam(param), kernel(kernel), rays(rays) {
+        }
+
+        Kernel kernel;
+        Rays rays;
+    };
+
+    std::ostream& operator<<(std::ostream& ostream, const TraceRaysParams& param) {
+        ostream << static_cast<const AdapterTestParam&>(param);
+
+        switch (param.kernel) {
+            case Kernel::Scalar:
+                ostream << "_Scalar";
+                break;
+            case Kernel::SIMD:
+                ostream << "_SIMD";
+                break;
+            case Kernel::SIMDPackets:
+                ostream << "_SIMDPackets";
+                break;
+        }
+
+        switch (param.rays) {
+            case Rays::Coherent:
+                ostream << "_Coherent";
+                break;
+            case Rays::Incoherent:
+                ostream << "_Incoherent";
+                break;
+        }
+        return ostream;
+    }
+
+    float Height(float x, float y) {
+        return 10.0f * std::sin(x * 0.05f) * std::cos(y * 0.07f);
+    }
+
+}  // namespace
+
+// Test tracing rays against a bottom-level acceleration container with the CPU implementation
+// of the Null backend.
+class TraceRaysPerf : public DawnPerfTestWithParams<TraceRaysParams> {
+  public:
+    TraceRaysPerf() : DawnPerfTestWithParams(kNumIterations, 1), mTimer(utils::CreateTimer()) {
+    }
+    ~TraceRaysPerf() override = default;
+
+    void SetUp() override;
+    void TearDown() override;
+
+  protected:
+    std::vector<const char*> GetRequiredExtensions() override {
+        return {"ray_tracing"};
+    }
+
+  private:
+    void Step() override;
+
+    void CreateScene();
+    void CreateRays();
+
+    wgpu::Buffer mVertexBuffer;
+    wgpu::RayTracingAccelerationContainer mContainer;
+    std::vector<dawn_native::null::Ray> mRays;
+    std::vector<dawn_native::null::RayHit> mHits;
+
+    std::unique_ptr<utils::Timer> mTimer;
+    double mTraceTime = 0.0;
+    uint64_t mRaysTraced = 0;
+};
+
+void TraceRaysPerf::SetUp() {
+    DawnPerfTestWithParams<TraceRaysParams>::SetUp();
+    CreateScene();
+    CreateRays();
+}
+
+void TraceRaysPerf::CreateScene() {
+    constexpr uint32_t kTriangleCount = kGridSize * kGridSize * 2;
+
+    wgpu::BufferDescriptor bufferDescriptor;
+    bufferDescriptor.size = kTriangleCount * 3 * 3 * sizeof(float);
+    bufferDescriptor.usage = wgpu::BufferUsage::RayTracing;
+    wgpu::CreateBufferMappedResult result = device.CreateBufferMapped(&bufferDescriptor);
+
+    float* vertices = static_cast<float*>(result.data);
+    auto AddVertex = [&vertices](float x, float y) {
+        *vertices++ = x;
+        *vertices++ = y;
+        *vertices++ = Height(x, y);
+    };
+
+    constexpr float kStep = kGridExtent / kGridSize;
+    for (uint32_t j = 0; j < kGridSize; ++j) {
+        for (uint32_t i = 0; i < kGridSize; ++i) {
+            float x = i * kStep - kGridExtent / 2.0f;
+            float y = j * kStep - kGridExtent / 2.0f;
+            AddVertex(x, y);
+            AddVertex(x + kStep, y);
+            AddVertex(x, y + kStep);
+            AddVertex(x + kStep, y);
+            AddVertex(x + kStep, y + kStep);
+            AddVertex(x, y + kStep);
+        }
+    }
+    result.buffer.Unmap();
+    mVertexBuffer = result.buffer;
+
+    wgpu::RayTracingAccelerationGeometryVertexDescriptor vertex;
+    vertex.buffer = mVertexBuffer;
+    vertex.format = wgpu::VertexFormat::Float3;
+    vertex.stride = 3 * sizeof(float);
+    vertex.count = kTriangleCount * 3;
+
+    wgpu::RayTracingAccelerationGeometryDescriptor geometry;
+    geometry.type = wgpu::RayTracingAccelerationGeometryType::Triangles;
+    geometry.vertex = &vertex;
+
+    wgpu::RayTracingAccelerationContainerDescriptor descriptor;
+    descriptor.level = wgpu::RayTracingAccelerationContainerLevel::Bottom;
+    descriptor.usage = wgpu::RayTracingAccelerationContainerUsage::PreferFastTrace;
+    descriptor.geometryCount = 1;
+    descriptor.geometries = &geometry;
+    mContainer = device.CreateRayTracingAccelerationContainer(&descriptor);
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    encoder.BuildRayTracingAccelerationContainer(mContainer);
+    wgpu::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+}
+
+void TraceRaysPerf::CreateRays() {
+    constexpr float kInfinity = std::numeric_limits<float>::infinity();
+
+    mRays.resize(kImageSize * kImageSize);
+    mHits.resize(mRays.size());
+
+    switch (GetParam().rays) {
+        case Rays::Coherent: {
+            // A camera above the heightfield looking down on it, with consecutive rays going
+            // through the pixels of 2x2 tiles so that packets are made of neighboring rays.
+            constexpr float kFieldOfView = 0.6f;
+            uint32_t rayIndex = 0;
+            for (uint32_t tileY = 0; tileY < kImageSize; tileY += 2) {
+                for (uint32_t tileX = 0; tileX < kImageSize; tileX += 2) {
+                    for (uint32_t pixel = 0; pixel < 4; ++pixel) {
+                        float x = (tileX + (pixel & 1) + 0.5f) / kImageSize * 2.0f - 1.0f;
+                        float y = (tileY + (pixel >> 1) + 0.5f) / kImageSize * 2.0f - 1.0f;
+                        dawn_native::null::Ray& ray = mRays[rayIndex++];
+                        ray.origin[0] = 0.0f;
+                        ray.origin[1] = 0.0f;
+                        ray.origin[2] = 150.0f;
+                        ray.direction[0] = x * kFieldOfView;
+                        ray.direction[1] = y * kFieldOfView;
+                        ray.direction[2] = -1.0f;
+                        ray.tMin = 0.0f;
+                        ray.tMax = kInfinity;
+                    }
+                }
+            }
+            break;
+        }
+
+        case Rays::Incoherent: {
+            // Rays starting in the box around the heightfield in random directions.
+            std::mt19937 generator(0);
+            std::uniform_real_distribution<float> position(-kGridExtent / 2.0f,
+                                                           kGridExtent / 2.0f);
+            std::uniform_real_distribution<float> height(-20.0f, 20.0f);
+            std::uniform_real_distribution<float> direction(-1.0f, 1.0f);
+            for (dawn_native::null::Ray& ray : mRays) {
+                ray.origin[0] = position(generator);
+                ray.origin[1] = position(generator);
+                ray.origin[2] = height(generator);
+                ray.direction[0] = direction(generator);
+                ray.direction[1] = direction(generator);
+                ray.direction[2] = direction(generator);
+                ray.tMin = 0.0f;
+                ray.tMax = kInfinity;
+            }
+            break;
+        }
+    }
+}
+
+void TraceRaysPerf::TearDown() {
+    if (mTraceTime > 0.0) {
+        PrintResult("rays_per_second", mRaysTraced / mTraceTime / 1e6, "Mrays/s", true);
+    }
+    DawnPerfTestWithParams<TraceRaysParams>::TearDown();
+}
+
+void TraceRaysPerf::Step() {
+    dawn_native::null::TraceRaysOptions options;
+    options.useSIMD = GetParam().kernel != Kernel::Scalar;
+    options.usePackets = GetParam().kernel == Kernel::SIMDPackets;
+
+    for (unsigned int i = 0; i < kNumIterations; ++i) {
+        mTimer->Start();
+        dawn_native::null::TraceRays(mContainer.Get(), mRays.data(), mHits.data(),
+                                     static_cast<uint32_t>(mRays.size()), &options);
+        mTimer->Stop();
+
+        mTraceTime += mTimer->GetElapsedTime();
+        mRaysTraced += mRays.size();
+    }
+}
+
+TEST_P(TraceRaysPerf, Run) {
+    RunTest();
+}
+
+DAWN_INSTANTIATE_PERF_TEST_SUITE_P(TraceRaysPerf,
+                                   {NullBackend()},
+                                   {Kernel::Scalar, Kernel::SIMD, Kernel::SIMDPackets},
+                                   {Rays::Coherent, Rays::Incoherent});
@@ -0,0 +1,489 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "common/ThreadPool.h"
+#include "dawn_native/null/BVHNull.h"
+
+#include <limits>
+#include <random>
+
+using namespace dawn_native::null;
+
+namespace {
+
+    constexpr float kInfinity = std::numeric_limits<float>::infinity();
+
+    std::vector<BVHTriangle> MakeRandomTriangles(uint32_t count, uint32_t seed) {
+        std::mt19937 generator(seed);
+        std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+        std::uniform_real_distribution<float> offset(-1.0f, 1.0f);
+
+        std::vector<BVHTriangle> triangles;
+        for (uint32_t i = 0; i < count; ++i) {
+            float v0[3] = {position(generator), position(generator), position(generator)};
+            float v1[3] = {v0[0] + offset(generator), v0[1] + offset(generator),
+                           v0[2] + offset(generator)};
+            float v2[3] = {v0[0] + offset(generator), v0[1] + offset(generator),
+                           v0[2] + offset(generator)};
+            triangles.push_back(MakeBVHTriangle(v0, v1, v2));
+        }
+        return triangles;
+    }
+
+    std::vector<BVHBounds> GetBounds(const std::vector<BVHTriangle>& triangles) {
+        std::vector<BVHBounds> bounds;
+        for (const BVHTriangle& triangle : triangles) {
+            bounds.push_back(GetBVHTriangleBounds(triangle));
+        }
+        return bounds;
+    }
+
+    std::vector<BVHKernel> GetSupportedKernels() {
+        std::vector<BVHKernel> kernels;
+        for (BVHKernel kernel : {BVHKernel::Scalar, BVHKernel::SSE2}) {
+            if (IsBVHKernelSupported(kernel)) {
+                kernels.push_back(kernel);
+            }
+        }
+        return kernels;
+    }
+
+    // Returns the index of the closest triangle hit by |ray| or -1 if there is none.
+    int32_t TraceBVH(const BVH& bvh,
+                     const std::vector<BVHTriangle>& triangles,
+                     const BVHRay& ray,
+                     BVHKernel kernel,
+                     float* tHit) {
+        int32_t closest = -1;
+        bvh.Traverse(ray, kernel, [&](uint32_t primitive, float* tMax) {
+            float t, u, v;
+            if (IntersectRayTriangle(ray, triangles[primitive], ray.tMin, *tMax, &t, &u, &v)) {
+                *tMax = t;
+                *tHit = t;
+                closest = static_cast<int32_t>(primitive);
+            }
+        });
+        return closest;
+    }
+
+    // Same as TraceBVH for a packet of kBVHPacketSize rays.
+    void TraceBVHPacket(const BVH& bvh,
+                        const std::vector<BVHTriangle>& triangles,
+                        const BVHRay* rays,
+                        uint32_t activeMask,
+                        BVHKernel kernel,
+                        int32_t* closest,
+                        float* tHit) {
+        for (uint32_t i = 0; i < kBVHPacketSize; ++i) {
+            closest[i] = -1;
+        }
+        bvh.TraversePacket(rays, activeMask, kernel,
+                           [&](uint32_t primitive, uint32_t rayMask, float* tMax) {
+                               EXPECT_EQ(rayMask & ~activeMask, 0u);
+                               for (uint32_t i = 0; i < kBVHPacketSize; ++i) {
+                                   float t, u, v;
+                                   if ((rayMask & (1u << i)) != 0 &&
+                                       IntersectRayTriangle(rays[i], triangles[primitive],
+                                                            rays[i].tMin, tMax[i], &t, &u, &v)) {
+                                       tMax[i] = t;
+                                       tHit[i] = t;
+                                       closest[i] = static_cast<int32_t>(primitive);
+                                   }
+                               }
+                           });
+    }
+
+    int32_t TraceBruteForce(const std::vector<BVHTriangle>& triangles,
+                            const BVHRay& ray,
+                            float* tHit) {
+        int32_t closest = -1;
+        float tMax = ray.tMax;
+        for (uint32_t i = 0; i < triangles.size(); ++i) {
+            float t, u, v;
+            if (IntersectRayTriangle(ray, triangles[i], ray.tMin, tMax, &t, &u, &v)) {
+                tMax = t;
+                *tHit = t;
+                closest = static_cast<int32_t>(i);
+            }
+        }
+        return closest;
+    }
+
+    // Checks that every primitive is referenced once by the leaves and that the nodes contain their
+    // children.
+    void ExpectWellFormed(const BVH& bvh, uint32_t primitiveCount) {
+        ASSERT_FALSE(bvh.IsEmpty());
+
+        const BVH::Node* nodes = bvh.GetNodes();
+        std::vector<uint32_t> referenceCount(primitiveCount, 0);
+        std::vector<uint32_t> parentCount(bvh.GetNodeCount(), 0);
+        for (uint32_t nodeIndex = 0; nodeIndex < bvh.GetNodeCount(); ++nodeIndex) {
+            const BVH::Node& node = nodes[nodeIndex];
+            for (uint32_t slot = 0; slot < BVH::kWidth; ++slot) {
+                uint32_t count = node.primitiveCount[slot];
+                if (count == BVH::kEmptySlot) {
+                    continue;
+                }
+                if (count != BVH::kInnerSlot) {
+                    EXPECT_LE(count, BVH::kMaxLeafSize);
+                    for (uint32_t i = 0; i < count; ++i) {
+                        referenceCount[bvh.GetPrimitiveIndices()[node.child[slot] + i]]++;
+                    }
+                    continue;
+                }
+
+                uint32_t child = node.child[slot];
+                ASSERT_GT(child, nodeIndex);
+                ASSERT_LT(child, bvh.GetNodeCount());
+                parentCount[child]++;
+
+                BVHBounds bounds = node.GetChildBounds(slot);
+                const BVH::Node& childNode = nodes[child];
+                for (uint32_t childSlot = 0; childSlot < BVH::kWidth; ++childSlot) {
+                    if (childNode.primitiveCount[childSlot] == BVH::kEmptySlot) {
+                        continue;
+                    }
+                    BVHBounds childBounds = childNode.GetChildBounds(childSlot);
+                    for (uint32_t axis = 0; axis < 3; ++axis) {
+                        EXPECT_LE(bounds.min[axis], childBounds.min[axis]);
+                        EXPECT_GE(bounds.max[axis], childBounds.max[axis]);
+                    }
+                }
+            }
+        }
+
+        for (uint32_t count : referenceCount) {
+            EXPECT_EQ(count, 1u);
+        }
+        for (uint32_t nodeIndex = 1; nodeIndex < bvh.GetNodeCount(); ++nodeIndex) {
+            EXPECT_EQ(parentCount[nodeIndex], 1u);
+        }
+    }
+
+}  // anonymous namespace
+
+// Test that a ray hits a triangle in front of it and reports the barycentrics of the hit.
+TEST(BVHNullTests, RayTriangleIntersection) {
+    float v0[3] = {0.0f, 0.0f, 0.0f};
+    float v1[3] = {1.0f, 0.0f, 0.0f};
+    float v2[3] = {0.0f, 1.0f, 0.0f};
+    BVHTriangle triangle = MakeBVHTriangle(v0, v1, v2);
+
+    BVHRay ray = {{0.25f, 0.25f, 1.0f}, 0.0f, {0.0f, 0.0f, -1.0f}, kInfinity};
+    float t, u, v;
+    ASSERT_TRUE(IntersectRayTriangle(ray, triangle, ray.tMin, ray.tMax, &t, &u, &v));
+    EXPECT_FLOAT_EQ(t, 1.0f);
+    EXPECT_FLOAT_EQ(u, 0.25f);
+    EXPECT_FLOAT_EQ(v, 0.25f);
+
+    // The back face is hit too.
+    BVHRay backRay = {{0.25f, 0.25f, -1.0f}, 0.0f, {0.0f, 0.0f, 1.0f}, kInfinity};
+    EXPECT_TRUE(IntersectRayTriangle(backRay, triangle, backRay.tMin, backRay.tMax, &t, &u, &v));
+
+    // Hits outside of [tMin, tMax] are rejected.
+    EXPECT_FALSE(IntersectRayTriangle(ray, triangle, 0.0f, 0.5f, &t, &u, &v));
+
+    // Rays missing the triangle don't hit.
+    BVHRay missRay = {{1.0f, 1.0f, 1.0f}, 0.0f, {0.0f, 0.0f, -1.0f}, kInfinity};
+    EXPECT_FALSE(IntersectRayTriangle(missRay, triangle, missRay.tMin, missRay.tMax, &t, &u, &v));
+}
+
+// Test the slab test with axis-aligned rays, which have infinite inverse directions.
+TEST(BVHNullTests, RayBoundsIntersection) {
+    BVHBounds bounds = {{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}};
+
+    BVHRay ray = {{0.0f, 0.0f, -5.0f}, 0.0f, {0.0f, 0.0f, 1.0f}, kInfinity};
+    float tEntry;
+    ASSERT_TRUE(IntersectRayBounds(BVHRayInverse(ray), bounds, ray.tMin, ray.tMax, &tEntry));
+    EXPECT_FLOAT_EQ(tEntry, 4.0f);
+
+    // A ray starting inside the box enters it at tMin.
+    BVHRay insideRay = {{0.0f, 0.0f, 0.0f}, 0.0f, {1.0f, 0.0f, 0.0f}, kInfinity};
+    ASSERT_TRUE(IntersectRayBounds(BVHRayInverse(insideRay), bounds, insideRay.tMin,
+                                   insideRay.tMax, &tEntry));
+    EXPECT_FLOAT_EQ(tEntry, 0.0f);
+
+    BVHRay missRay = {{2.0f, 0.0f, -5.0f}, 0.0f, {0.0f, 0.0f, 1.0f}, kInfinity};
+    EXPECT_FALSE(IntersectRayBounds(BVHRayInverse(missRay), bounds, missRay.tMin, missRay.tMax,
+                                    &tEntry));
+}
+
+// Test that building over no primitives, or only empty ones, gives an empty hierarchy.
+TEST(BVHNullTests, EmptyHierarchy) {
+    BVH bvh;
+    bvh.Build({});
+    EXPECT_TRUE(bvh.IsEmpty());
+
+    bvh.Build({BVHBounds::Empty(), BVHBounds::Empty()});
+    EXPECT_TRUE(bvh.IsEmpty());
+
+    BVHRay ray = {{0.0f, 0.0f, 0.0f}, 0.0f, {0.0f, 0.0f, 1.0f}, kInfinity};
+    bool visited = false;
+    for (BVHKernel kernel : GetSupportedKernels()) {
+        bvh.Traverse(ray, kernel, [&](uint32_t, float*) { visited = true; });
+    }
+    EXPECT_FALSE(visited);
+}
+
+// Test that the hierarchy is well formed.
+TEST(BVHNullTests, HierarchyIsWellFormed) {
+    std::vector<BVHTriangle> triangles = MakeRandomTriangles(1000, 1);
+    BVH bvh;
+    bvh.Build(GetBounds(triangles));
+    ExpectWellFormed(bvh, triangles.size());
+}
+
+// Test building over primitives that all have the same centroid.
+TEST(BVHNullTests, CoincidentPrimitives) {
+    std::vector<BVHBounds> bounds(100, {{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}});
+    BVH bvh;
+    bvh.Build(bounds);
+    ExpectWellFormed(bvh, bounds.size());
+}
+
+// Test that building with a thread pool gives the same hierarchy as building on a single thread.
+TEST(BVHNullTests, ParallelBuild) {
+    // Enough triangles for the subtrees and the binning of the root to be split in tasks.
+    std::vector<BVHTriangle> triangles = MakeRandomTriangles(200000, 4);
+    std::vector<BVHBounds> bounds = GetBounds(triangles);
+
+    BVH serialBVH;
+    serialBVH.Build(bounds);
+
+    ThreadPool pool(3);
+    BVH parallelBVH;
+    parallelBVH.Build(bounds, &pool);
+    ExpectWellFormed(parallelBVH, triangles.size());
+
+    EXPECT_EQ(serialBVH.GetNodeCount(), parallelBVH.GetNodeCount());
+    EXPECT_EQ(serialBVH.GetPrimitiveIndices(), parallelBVH.GetPrimitiveIndices());
+}
+
+// Test that the scalar kernel is always supported and that the preferred kernel is supported.
+TEST(BVHNullTests, KernelSupport) {
+    EXPECT_TRUE(IsBVHKernelSupported(BVHKernel::Scalar));
+    EXPECT_TRUE(IsBVHKernelSupported(GetPreferredBVHKernel()));
+}
+
+// Test that traversal finds the same closest hits as intersecting every triangle, with every
+// kernel.
+TEST(BVHNullTests, TraversalMatchesBruteForce) {
+    std::vector<BVHTriangle> triangles = MakeRandomTriangles(2000, 2);
+    BVH bvh;
+    bvh.Build(GetBounds(triangles));
+
+    std::mt19937 generator(3);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+    uint32_t hitCount = 0;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        BVHRay ray = {{0.0f, 0.0f, 0.0f},
+                      0.0f,
+                      {distribution(generator), distribution(generator), distribution(generator)},
+                      kInfinity};
+
+        float tBruteForce = 0.0f;
+        int32_t hitBruteForce = TraceBruteForce(triangles, ray, &tBruteForce);
+        if (hitBruteForce >= 0) {
+            hitCount++;
+        }
+
+        for (BVHKernel kernel : GetSupportedKernels()) {
+            float tBVH = 0.0f;
+            int32_t hitBVH = TraceBVH(bvh, triangles, ray, kernel, &tBVH);
+            ASSERT_EQ(hitBVH, hitBruteForce);
+            if (hitBVH >= 0) {
+                EXPECT_EQ(tBVH, tBruteForce);
+            }
+        }
+    }
+
+    // Check that the test isn't trivially passing.
+    EXPECT_GT(hitCount, 0u);
+}
+
+// Test that the kernels handle rays parallel to the axes, including rays starting on the faces
+// of the boxes.
+TEST(BVHNullTests, AxisAlignedRays) {
+    // A grid of unit triangles in the z = 0 plane.
+    std::vector<BVHTriangle> triangles;
+    for (int32_t x = -8; x < 8; ++x) {
+        for (int32_t y = -8; y < 8; ++y) {
+            float v0[3] = {float(x), float(y), 0.0f};
+            float v1[3] = {float(x + 1), float(y), 0.0f};
+            float v2[3] = {float(x), float(y + 1), 0.0f};
+            triangles.push_back(MakeBVHTriangle(v0, v1, v2));
+        }
+    }
+    BVH bvh;
+    bvh.Build(GetBounds(triangles));
+
+    for (BVHKernel kernel : GetSupportedKernels()) {
+        for (float sign : {-1.0f, 1.0f}) {
+            BVHRay ray = {{-7.75f, -7.75f, -sign}, 0.0f, {0.0f, 0.0f, sign}, kInfinity};
+            float tHit = 0.0f;
+            EXPECT_EQ(TraceBVH(bvh, triangles, ray, kernel, &tHit), 0);
+            EXPECT_EQ(tHit, 1.0f);
+
+            // Grazing the plane of the triangles along x doesn't hit anything.
+            BVHRay grazingRay = {{-9.0f, 0.25f, 0.0f}, 0.0f, {sign, 0.0f, 0.0f}, kInfinity};
+            float tGrazing = 0.0f;
+            int32_t hitBVH = TraceBVH(bvh, triangles, grazingRay, kernel, &tGrazing);
+            EXPECT_EQ(hitBVH, TraceBruteForce(triangles, grazingRay, &tGrazing));
+        }
+    }
+}
+
+// Test that packet traversal finds the same closest hits as intersecting every triangle, for
+// coherent and incoherent packets and with inactive rays.
+TEST(BVHNullTests, PacketTraversalMatchesBruteForce) {
+    std::vector<BVHTriangle> triangles = MakeRandomTriangles(2000, 5);
+    BVH bvh;
+    bvh.Build(GetBounds(triangles));
+
+    std::mt19937 generator(6);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> jitter(-0.01f, 0.01f);
+
+    uint32_t hitCount = 0;
+    for (uint32_t packetIndex = 0; packetIndex < 1000; ++packetIndex) {
+        bool coherent = packetIndex % 2 == 0;
+        float direction[3] = {distribution(generator), distribution(generator),
+                              distribution(generator)};
+
+        BVHRay rays[kBVHPacketSize];
+        for (uint32_t i = 0; i < kBVHPacketSize; ++i) {
+            rays[i] = {{0.0f, 0.0f, 0.0f}, 0.0f, {0.0f, 0.0f, 0.0f}, kInfinity};
+            for (uint32_t axis = 0; axis < 3; ++axis) {
+                rays[i].direction[axis] =
+                    coherent ? direction[axis] + jitter(generator) : distribution(generator);
+            }
+        }
+        uint32_t activeMask = (packetIndex % 16) == 1 ? 0x5 : 0xF;
+
+        for (BVHKernel kernel : GetSupportedKernels()) {
+            int32_t hitBVH[kBVHPacketSize];
+            float tBVH[kBVHPacketSize] = {};
+            TraceBVHPacket(bvh, triangles, rays, activeMask, kernel, hitBVH, tBVH);
+
+            for (uint32_t i = 0; i < kBVHPacketSize; ++i) {
+                if ((activeMask & (1u << i)) == 0) {
+                    EXPECT_EQ(hitBVH[i], -1);
+                    continue;
+                }
+                float tBruteForce = 0.0f;
+                int32_t hitBruteForce = TraceBruteForce(triangles, rays[i], &tBruteForce);
+                ASSERT_EQ(hitBVH[i], hitBruteForce);
+                if (hitBruteForce >= 0) {
+                    EXPECT_EQ(tBVH[i], tBruteForce);
+                    hitCount++;
+                }
+            }
+        }
+    }
+
+    EXPECT_GT(hitCount, 0u);
+}
+
+// Test that refitting after moving every triangle keeps the hierarchy well formed and that
+// traversal still finds the same closest hits as intersecting every triangle.
+TEST(BVHNullTests, RefitMatchesBruteForce) {
+    std::vector<BVHTriangle> triangles = MakeRandomTriangles(2000, 7);
+    BVH bvh;
+    bvh.Build(GetBounds(triangles));
+    uint32_t nodeCount = bvh.GetNodeCount();
+
+    // Moving the triangles around makes the hierarchy worse but it has to stay correct.
+    std::vector<BVHTriangle> movedTriangles = MakeRandomTriangles(2000, 8);
+    bvh.Refit(GetBounds(movedTriangles));
+    ExpectWellFormed(bvh, movedTriangles.size());
+    EXPECT_EQ(bvh.GetNodeCount(), nodeCount);
+
+    std::mt19937 generator(9);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+    uint32_t hitCount = 0;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        BVHRay ray = {{0.0f, 0.0f, 0.0f},
+                      0.0f,
+                      {distribution(generator), distribution(generator), distribution(generator)},
+                      kInfinity};
+
+        float tBruteForce = 0.0f;
+        int32_t hitBruteForce = TraceBruteForce(movedTriangles, ray, &tBruteForce);
+        if (hitBruteForce >= 0) {
+            hitCount++;
+        }
+
+        for (BVHKernel kernel : GetSupportedKernels()) {
+            float tBVH = 0.0f;
+            ASSERT_EQ(TraceBVH(bvh, movedTriangles, ray, kernel, &tBVH), hitBruteForce);
+        }
+    }
+
+    EXPECT_GT(hitCount, 0u);
+}
+
+// Test that refitting only the primitives that changed gives the same hierarchy as refitting
+// all of them.
+TEST(BVHNullTests, PartialRefitMatchesFullRefit) {
+    std::vector<BVHTriangle> triangles = MakeRandomTriangles(2000, 10);
+    BVH fullBVH;
+    fullBVH.Build(GetBounds(triangles));
+    BVH partialBVH = fullBVH;
+
+    std::mt19937 generator(11);
+    std::uniform_real_distribution<float> offset(-2.0f, 2.0f);
+
+    // Several refits in a row to check that the links used by partial refits stay valid.
+    for (uint32_t iteration = 0; iteration < 3; ++iteration) {
+        std::vector<uint32_t> dirtyPrimitives;
+        for (uint32_t i = iteration; i < triangles.size(); i += 7) {
+            BVHTriangle& triangle = triangles[i];
+            float translation[3] = {offset(generator), offset(generator), offset(generator)};
+            float v0[3], v1[3], v2[3];
+            for (uint32_t axis = 0; axis < 3; ++axis) {
+                v0[axis] = triangle.v0[axis] + translation[axis];
+                v1[axis] = v0[axis] + triangle.e1[axis];
+                v2[axis] = v0[axis] + triangle.e2[axis];
+            }
+            triangle = MakeBVHTriangle(v0, v1, v2);
+            dirtyPrimitives.push_back(i);
+        }
+
+        std::vector<BVHBounds> bounds = GetBounds(triangles);
+        fullBVH.Refit(bounds);
+        partialBVH.Refit(bounds, dirtyPrimitives);
+        ExpectWellFormed(partialBVH, triangles.size());
+
+        ASSERT_EQ(fullBVH.GetNodeCount(), partialBVH.GetNodeCount());
+        for (uint32_t nodeIndex = 0; nodeIndex < fullBVH.GetNodeCount(); ++nodeIndex) {
+            const BVH::Node& fullNode = fullBVH.GetNodes()[nodeIndex];
+            const BVH::Node& partialNode = partialBVH.GetNodes()[nodeIndex];
+            for (uint32_t slot = 0; slot < BVH::kWidth; ++slot) {
+                if (fullNode.primitiveCount[slot] == BVH::kEmptySlot) {
+                    continue;
+                }
+                BVHBounds fullBounds = fullNode.GetChildBounds(slot);
+                BVHBounds partialBounds = partialNode.GetChildBounds(slot);
+                for (uint32_t axis = 0; axis < 3; ++axis) {
+                    EXPECT_EQ(fullBounds.min[axis], partialBounds.min[axis]);
+                    EXPECT_EQ(fullBounds.max[axis], partialBounds.max[axis]);
+                }
+            }
+        }
+    }
+}
@@ -446,3 +446,94 @@ TEST(CommandAllocator, AllocateDataDefaultInitializes) {
     CommandIterator iterator(std::move(allocator));
     iterator.DataWasDestroyed();
 }
+
+// Records |count| draws in an allocator using |pool| and checks they are iterated correctly.
+void RecordAndIterateDraws(CommandBlockPool* pool, uint32_t count, bool useSizeHint = true) {
+    CommandAllocator allocator(pool, useSizeHint);
+    for (uint32_t i = 0; i < count; ++i) {
+        CommandDraw* draw = allocator.Allocate<CommandDraw>(CommandType::Draw);
+        draw->first = i;
+    }
+
+    CommandIterator iterator(std::move(allocator));
+    CommandType type;
+    for (uint32_t i = 0; i < count; ++i) {
+        ASSERT_TRUE(iterator.NextCommandId(&type));
+        ASSERT_EQ(type, CommandType::Draw);
+        ASSERT_EQ(iterator.NextCommand<CommandDraw>()->first, i);
+    }
+    ASSERT_FALSE(iterator.NextCommandId(&type));
+    iterator.DataWasDestroyed();
+}
+
+// Test that the blocks of destroyed iterators are reused by the next allocators of the pool.
+TEST(CommandBlockPool, BlocksAreRecycled) {
+    CommandBlockPool pool;
+
+    RecordAndIterateDraws(&pool, 100);
+    uint64_t allocatedBlockCount = pool.GetAllocatedBlockCountForTesting();
+    EXPECT_GT(allocatedBlockCount, 0u);
+
+    for (uint32_t i = 0; i < 10; ++i) {
+        RecordAndIterateDraws(&pool, 100);
+    }
+    EXPECT_EQ(pool.GetAllocatedBlockCountForTesting(), allocatedBlockCount);
+}
+
+// Test that after a large command buffer, the next ones start with a block large enough for all
+// their commands and then stop allocating.
+TEST(CommandBlockPool, SizeHint) {
+    CommandBlockPool pool;
+    constexpr uint32_t kDrawCount = 10000;
+
+    RecordAndIterateDraws(&pool, kDrawCount);
+    uint64_t allocatedBlockCount = pool.GetAllocatedBlockCountForTesting();
+    EXPECT_GT(allocatedBlockCount, 1u);
+    EXPECT_GE(pool.GetSizeHint(), kDrawCount * (sizeof(uint32_t) + sizeof(CommandDraw)));
+
+    RecordAndIterateDraws(&pool, kDrawCount);
+    EXPECT_EQ(pool.GetAllocatedBlockCountForTesting(), allocatedBlockCount + 1);
+
+    RecordAndIterateDraws(&pool, kDrawCount);
+    EXPECT_EQ(pool.GetAllocatedBlockCountForTesting(), allocatedBlockCount + 1);
+}
+
+// Test that allocators that don't use the size hint, like the ones of render bundles, neither
+// start with a large block nor make the hint grow.
+TEST(CommandBlockPool, SizeHintNotUsed) {
+    CommandBlockPool pool;
+    constexpr uint32_t kDrawCount = 10000;
+
+    RecordAndIterateDraws(&pool, kDrawCount, false);
+    EXPECT_EQ(pool.GetSizeHint(), 0u);
+
+    RecordAndIterateDraws(&pool, kDrawCount);
+    size_t sizeHint = pool.GetSizeHint();
+    EXPECT_GE(sizeHint, kDrawCount * (sizeof(uint32_t) + sizeof(CommandDraw)));
+
+    // Small command buffers would make the hint shrink if they updated it.
+    RecordAndIterateDraws(&pool, 1, false);
+    EXPECT_EQ(pool.GetSizeHint(), sizeHint);
+}
+
+// Test that commands larger than the largest size class still work with a pool.
+TEST(CommandBlockPool, LargeCommands) {
+    CommandBlockPool pool;
+
+    for (int i = 0; i < 2; ++i) {
+        CommandAllocator allocator(&pool, true);
+        CommandBig* big = allocator.Allocate<CommandBig>(CommandType::Big);
+        big->buffer[0] = 42;
+        big->buffer[kBigBufferSize - 1] = 43;
+
+        CommandIterator iterator(std::move(allocator));
+        CommandType type;
+        ASSERT_TRUE(iterator.NextCommandId(&type));
+        ASSERT_EQ(type, CommandType::Big);
+        CommandBig* iteratedBig = iterator.NextCommand<CommandBig>();
+        ASSERT_EQ(iteratedBig->buffer[0], 42u);
+        ASSERT_EQ(iteratedBig->buffer[kBigBufferSize - 1], 43u);
+        ASSERT_FALSE(iterator.NextCommandId(&type));
+        iterator.DataWasDestroyed();
+    }
+}
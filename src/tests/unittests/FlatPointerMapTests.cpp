@@ -0,0 +1,110 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "common/FlatPointerMap.h"
+
+// Test the basic operations of a set small enough to not use a hash table.
+TEST(FlatPointerSet, SmallSet) {
+    int objects[3];
+    FlatPointerSet<int> set;
+    ASSERT_TRUE(set.Empty());
+
+    EXPECT_EQ(set.Insert(&objects[0]), std::make_pair(size_t(0), true));
+    EXPECT_EQ(set.Insert(&objects[1]), std::make_pair(size_t(1), true));
+    EXPECT_EQ(set.Insert(&objects[0]), std::make_pair(size_t(0), false));
+
+    EXPECT_EQ(set.Size(), 2u);
+    EXPECT_TRUE(set.Contains(&objects[0]));
+    EXPECT_TRUE(set.Contains(&objects[1]));
+    EXPECT_FALSE(set.Contains(&objects[2]));
+
+    set.Clear();
+    ASSERT_TRUE(set.Empty());
+    EXPECT_FALSE(set.Contains(&objects[0]));
+}
+
+// Test that large sets deduplicate keys and keep them in insertion order.
+TEST(FlatPointerSet, LargeSet) {
+    constexpr size_t kObjectCount = 1000;
+    std::vector<int> objects(kObjectCount);
+
+    FlatPointerSet<int> set;
+    for (size_t i = 0; i < kObjectCount; ++i) {
+        EXPECT_EQ(set.Insert(&objects[i]), std::make_pair(i, true));
+    }
+    for (size_t i = 0; i < kObjectCount; ++i) {
+        EXPECT_EQ(set.Insert(&objects[i]), std::make_pair(i, false));
+    }
+    EXPECT_EQ(set.Size(), kObjectCount);
+
+    size_t index = 0;
+    for (int* object : set) {
+        EXPECT_EQ(object, &objects[index]);
+        index++;
+    }
+    EXPECT_EQ(index, kObjectCount);
+
+    int other;
+    EXPECT_FALSE(set.Contains(&other));
+
+    std::vector<int*> keys = set.AcquireKeys();
+    EXPECT_EQ(keys.size(), kObjectCount);
+    EXPECT_TRUE(set.Empty());
+    EXPECT_FALSE(set.Contains(&objects[0]));
+}
+
+// Test inserting a range of keys.
+TEST(FlatPointerSet, InsertRange) {
+    int objects[2];
+    int* keys[] = {&objects[0], &objects[1], &objects[0]};
+
+    FlatPointerSet<int> set;
+    set.Insert(keys, keys + 3);
+    EXPECT_EQ(set.GetKeys(), std::vector<int*>({&objects[0], &objects[1]}));
+}
+
+// Test that values are value-initialized, merged, and acquired in insertion order.
+TEST(FlatPointerMap, Basic) {
+    constexpr size_t kObjectCount = 100;
+    std::vector<int> objects(kObjectCount);
+
+    FlatPointerMap<int, uint32_t> map;
+    for (size_t i = 0; i < kObjectCount; ++i) {
+        EXPECT_EQ(map[&objects[i]], 0u);
+        map[&objects[i]] |= 1;
+    }
+    for (size_t i = 0; i < kObjectCount; i += 2) {
+        map[&objects[i]] |= 2;
+    }
+    EXPECT_EQ(map.Size(), kObjectCount);
+
+    std::vector<int*> keys;
+    std::vector<uint32_t> values;
+    map.Acquire(&keys, &values);
+    EXPECT_TRUE(map.Empty());
+
+    ASSERT_EQ(keys.size(), kObjectCount);
+    ASSERT_EQ(values.size(), kObjectCount);
+    for (size_t i = 0; i < kObjectCount; ++i) {
+        EXPECT_EQ(keys[i], &objects[i]);
+        EXPECT_EQ(values[i], i % 2 == 0 ? 3u : 1u);
+    }
+
+    // The map can be reused after its content is acquired.
+    map[&objects[0]] = 4;
+    EXPECT_EQ(map.GetKeys(), std::vector<int*>({&objects[0]}));
+    EXPECT_EQ(map.GetValues(), std::vector<uint32_t>({4}));
+}
@@ -0,0 +1,112 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "common/MPSCQueue.h"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Test that values are drained in push order and only once.
+TEST(MPSCQueue, PushOrder) {
+    MPSCQueue<int> queue;
+    ASSERT_TRUE(queue.Empty());
+
+    queue.Push(1);
+    queue.Push(2);
+    queue.Push(3);
+    ASSERT_FALSE(queue.Empty());
+
+    std::vector<int> values;
+    queue.Drain([&](int value) { values.push_back(value); });
+    EXPECT_EQ(values, std::vector<int>({1, 2, 3}));
+    ASSERT_TRUE(queue.Empty());
+
+    queue.Push(4);
+    values.clear();
+    queue.Drain([&](int value) { values.push_back(value); });
+    EXPECT_EQ(values, std::vector<int>({4}));
+}
+
+// Test that values left in the queue are destroyed with it.
+TEST(MPSCQueue, DestroyedWithQueue) {
+    std::shared_ptr<int> value = std::make_shared<int>(0);
+    {
+        MPSCQueue<std::shared_ptr<int>> queue;
+        queue.Push(value);
+        queue.Push(value);
+        EXPECT_EQ(value.use_count(), 3);
+    }
+    EXPECT_EQ(value.use_count(), 1);
+}
+
+// Test that drained nodes are reused by other queues of the same type.
+TEST(MPSCQueue, NodesReusedAcrossQueues) {
+    std::vector<int> values;
+    {
+        MPSCQueue<int> queue;
+        queue.Push(1);
+        queue.Push(2);
+        queue.Drain([&](int value) { values.push_back(value); });
+
+        MPSCQueue<int> otherQueue;
+        otherQueue.Push(3);
+        queue.Push(4);
+        otherQueue.Push(5);
+        otherQueue.Drain([&](int value) { values.push_back(value); });
+        queue.Drain([&](int value) { values.push_back(value); });
+    }
+
+    // Queues created after nodes were cached by the thread work too.
+    MPSCQueue<int> queue;
+    queue.Push(6);
+    queue.Drain([&](int value) { values.push_back(value); });
+    EXPECT_EQ(values, std::vector<int>({1, 2, 3, 5, 4, 6}));
+}
+
+// Test pushing from several threads while another thread drains.
+TEST(MPSCQueue, ConcurrentPushes) {
+    constexpr uint32_t kThreadCount = 8;
+    constexpr uint32_t kValuesPerThread = 10000;
+
+    MPSCQueue<uint32_t> queue;
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < kThreadCount; ++i) {
+        threads.emplace_back([&queue, i]() {
+            for (uint32_t j = 0; j < kValuesPerThread; ++j) {
+                queue.Push(i * kValuesPerThread + j);
+            }
+        });
+    }
+
+    // Values of each thread are drained in the order the thread pushed them.
+    std::vector<uint32_t> nextValues(kThreadCount, 0);
+    uint32_t drainedCount = 0;
+    auto drain = [&](uint32_t value) {
+        uint32_t thread = value / kValuesPerThread;
+        EXPECT_EQ(value % kValuesPerThread, nextValues[thread]);
+        nextValues[thread]++;
+        drainedCount++;
+    };
+    while (drainedCount < kThreadCount * kValuesPerThread) {
+        queue.Drain(drain);
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    EXPECT_TRUE(queue.Empty());
+}
@@ -0,0 +1,187 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "dawn_native/Device.h"
+#include "dawn_native/Instance.h"
+#include "dawn_native/PersistentCache.h"
+#include "dawn_native/null/DeviceNull.h"
+#include "dawn_platform/DawnPlatform.h"
+
+#include <cstring>
+#include <map>
+#include <string>
+
+using namespace dawn_native;
+
+namespace {
+
+    // In-memory implementation of the caching interface an embedder would back with disk.
+    class FakeCachingInterface : public dawn_platform::CachingInterface {
+      public:
+        size_t LoadData(const void* key,
+                        size_t keySize,
+                        void* valueOut,
+                        size_t valueSize) override {
+            auto iter = mEntries.find(ToString(key, keySize));
+            if (iter == mEntries.end()) {
+                return 0;
+            }
+            if (valueOut != nullptr) {
+                EXPECT_EQ(valueSize, iter->second.size());
+                memcpy(valueOut, iter->second.data(), iter->second.size());
+            }
+            return iter->second.size();
+        }
+
+        void StoreData(const void* key,
+                       size_t keySize,
+                       const void* value,
+                       size_t valueSize) override {
+            mEntries[ToString(key, keySize)] = ToString(value, valueSize);
+        }
+
+        size_t GetEntryCount() const {
+            return mEntries.size();
+        }
+
+      private:
+        static std::string ToString(const void* data, size_t size) {
+            return std::string(static_cast<const char*>(data), size);
+        }
+
+        std::map<std::string, std::string> mEntries;
+    };
+
+    class FakePlatform : public dawn_platform::Platform {
+      public:
+        FakePlatform(FakeCachingInterface* cache) : mCache(cache) {
+        }
+
+        const unsigned char* GetTraceCategoryEnabledFlag(
+            dawn_platform::TraceCategory category) override {
+            static unsigned char disabled = 0;
+            return &disabled;
+        }
+
+        double MonotonicallyIncreasingTime() override {
+            return 0.0;
+        }
+
+        uint64_t AddTraceEvent(char phase,
+                               const unsigned char* categoryGroupEnabled,
+                               const char* name,
+                               uint64_t id,
+                               double timestamp,
+                               int numArgs,
+                               const char** argNames,
+                               const unsigned char* argTypes,
+                               const uint64_t* argValues,
+                               unsigned char flags) override {
+            return 0;
+        }
+
+        dawn_platform::CachingInterface* GetCachingInterface(const void* fingerprint,
+                                                             size_t fingerprintSize) override {
+            mFingerprint = std::string(static_cast<const char*>(fingerprint), fingerprintSize);
+            return mCache;
+        }
+
+        std::string mFingerprint;
+
+      private:
+        FakeCachingInterface* mCache;
+    };
+
+}  // anonymous namespace
+
+class PersistentCacheTests : public testing::Test {
+  public:
+    PersistentCacheTests()
+        : testing::Test(),
+          mPlatform(&mCachingInterface),
+          mInstanceBase(InstanceBase::Create()),
+          mAdapterBase(mInstanceBase.Get()) {
+    }
+
+    void SetUp() override {
+        mInstanceBase->SetPlatform(&mPlatform);
+        Adapter adapter(&mAdapterBase);
+        mDevice = reinterpret_cast<DeviceBase*>(adapter.CreateDevice());
+    }
+
+    void TearDown() override {
+        mDevice->Release();
+    }
+
+  protected:
+    FakeCachingInterface mCachingInterface;
+    FakePlatform mPlatform;
+    Ref<InstanceBase> mInstanceBase;
+    null::Adapter mAdapterBase;
+    DeviceBase* mDevice = nullptr;
+};
+
+// Test that stored values can be loaded back with the same key.
+TEST_F(PersistentCacheTests, StoreAndLoad) {
+    const PersistentCacheKey key =
+        PersistentCacheKeyRecorder(mDevice, PersistentKeyType::Shader).Record(42u).GetKey();
+    const char kValue[] = "compiled shader";
+
+    PersistentCache* cache = mDevice->GetPersistentCache();
+    EXPECT_EQ(cache->LoadData(key).bufferSize, 0u);
+
+    cache->StoreData(key, kValue, sizeof(kValue));
+    ScopedCachedBlob blob = cache->LoadData(key);
+    ASSERT_EQ(blob.bufferSize, sizeof(kValue));
+    EXPECT_EQ(memcmp(blob.buffer.get(), kValue, sizeof(kValue)), 0);
+
+    // The platform is given a fingerprint of the adapter to separate the caches of adapters.
+    EXPECT_FALSE(mPlatform.mFingerprint.empty());
+}
+
+// Test that keys differ when any of the recorded values differ.
+TEST_F(PersistentCacheTests, KeysDependOnRecordedValues) {
+    auto MakeKey = [&](PersistentKeyType type, uint32_t value, const std::string& a,
+                       const std::string& b) {
+        return PersistentCacheKeyRecorder(mDevice, type).Record(value).Record(a).Record(b).GetKey();
+    };
+
+    const PersistentCacheKey key = MakeKey(PersistentKeyType::Shader, 1, "ab", "c");
+    EXPECT_EQ(key, MakeKey(PersistentKeyType::Shader, 1, "ab", "c"));
+    EXPECT_NE(key, MakeKey(PersistentKeyType::PipelineCache, 1, "ab", "c"));
+    EXPECT_NE(key, MakeKey(PersistentKeyType::Shader, 2, "ab", "c"));
+    // Strings are prefixed with their size so moving characters between them changes the key.
+    EXPECT_NE(key, MakeKey(PersistentKeyType::Shader, 1, "a", "bc"));
+}
+
+// Test that the persistent cache does nothing when the platform doesn't provide a cache.
+TEST_F(PersistentCacheTests, NoPlatformCache) {
+    Ref<InstanceBase> instance = AcquireRef(InstanceBase::Create());
+    null::Adapter nullAdapter(instance.Get());
+    Adapter adapter(&nullAdapter);
+    DeviceBase* device = reinterpret_cast<DeviceBase*>(adapter.CreateDevice());
+
+    const PersistentCacheKey key =
+        PersistentCacheKeyRecorder(device, PersistentKeyType::Shader).GetKey();
+    const char kValue[] = "compiled shader";
+
+    PersistentCache* cache = device->GetPersistentCache();
+    cache->StoreData(key, kValue, sizeof(kValue));
+    EXPECT_EQ(cache->LoadData(key).bufferSize, 0u);
+    EXPECT_EQ(mCachingInterface.GetEntryCount(), 0u);
+
+    device->Release();
+}
@@ -108,6 +108,31 @@ TEST(RefCounted, RaceOnReferenceRelease) {
     EXPECT_TRUE(deleted);
 }
 
+// Test that TryReference adds a reference to live objects but not to objects being deleted.
+TEST(RefCounted, TryReference) {
+    // Keeps its memory alive after the last reference is removed, like an object that is still
+    // in a cache while its destructor runs.
+    class DeferredDeleteRCTest : public RefCounted {
+      public:
+        bool deleteCalled = false;
+
+      private:
+        void DeleteThis() override {
+            deleteCalled = true;
+        }
+    };
+
+    DeferredDeleteRCTest test;
+    EXPECT_TRUE(test.TryReference());
+    EXPECT_EQ(test.GetRefCountForTesting(), 2u);
+
+    test.Release();
+    test.Release();
+    EXPECT_TRUE(test.deleteCalled);
+    EXPECT_FALSE(test.TryReference());
+    EXPECT_EQ(test.GetRefCountForTesting(), 0u);
+}
+
 // Test Ref remove reference when going out of scope
 TEST(Ref, EndOfScopeRemovesRef) {
     bool deleted = false;
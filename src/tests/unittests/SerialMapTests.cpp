@@ -162,3 +162,30 @@ TEST(SerialMap, FirstSerial) {
     map.Enqueue(vector1, 6);
     EXPECT_EQ(map.FirstSerial(), 6u);
 }
+
+// Test that items enqueued out of order after the map was cleared up to some serial are still
+// iterated in serial order.
+TEST(SerialMap, EnqueueOrderAfterClearUpTo) {
+    TestSerialMap map;
+
+    for (Serial serial = 0; serial < 10; ++serial) {
+        map.Enqueue(static_cast<int>(serial), serial);
+    }
+    map.ClearUpTo(5);
+
+    map.Enqueue(12, 12);
+    map.Enqueue(6, 6);
+    map.Enqueue(11, 11);
+    map.Enqueue(10, 10);
+    map.Enqueue(66, 6);
+
+    std::vector<int> expectedValues = {6, 6, 66, 7, 8, 9, 10, 11, 12};
+    for (int value : map.IterateAll()) {
+        EXPECT_EQ(expectedValues.front(), value);
+        ASSERT_FALSE(expectedValues.empty());
+        expectedValues.erase(expectedValues.begin());
+    }
+    ASSERT_TRUE(expectedValues.empty());
+    EXPECT_EQ(map.FirstSerial(), 6u);
+    EXPECT_EQ(map.LastSerial(), 12u);
+}
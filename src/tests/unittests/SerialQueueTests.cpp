@@ -153,4 +153,29 @@ TEST(SerialQueue, LastSerial) {
 
     queue.Enqueue({2}, 1);
     EXPECT_EQ(queue.LastSerial(), 1u);
-}
\ No newline at end of file
+}
+
+// Test enqueuing and clearing over many serials so that the storage wraps around and grows while
+// it is wrapped around.
+TEST(SerialQueue, Wraparound) {
+    TestSerialQueue queue;
+
+    Serial nextValue = 0;
+    Serial firstValue = 0;
+    for (Serial serial = 0; serial < 100; ++serial) {
+        // Keep an increasing number of serials in flight.
+        for (uint32_t i = 0; i < 3; ++i) {
+            queue.Enqueue(static_cast<int>(nextValue++), serial);
+        }
+        Serial completedSerial = serial - serial / 10;
+        queue.ClearUpTo(completedSerial);
+        firstValue = (completedSerial + 1) * 3;
+
+        int expectedValue = static_cast<int>(firstValue);
+        for (int value : queue.IterateAll()) {
+            EXPECT_EQ(expectedValue, value);
+            expectedValue++;
+        }
+        EXPECT_EQ(static_cast<Serial>(expectedValue), nextValue);
+    }
+}
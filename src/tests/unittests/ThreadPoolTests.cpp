@@ -0,0 +1,98 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "common/ThreadPool.h"
+
+#include <atomic>
+
+class ThreadPoolTests : public testing::TestWithParam<uint32_t> {};
+
+// Test that all the spawned tasks run before Wait returns.
+TEST_P(ThreadPoolTests, SpawnAndWait) {
+    ThreadPool pool(GetParam());
+    EXPECT_EQ(pool.GetWorkerCount(), GetParam());
+
+    std::atomic<uint32_t> counter(0);
+    ThreadPool::TaskGroup group;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        pool.Spawn(&group, [&counter] { counter++; });
+    }
+    pool.Wait(&group);
+    EXPECT_EQ(counter.load(), 1000u);
+}
+
+// Test that tasks can spawn and wait on tasks themselves without deadlocking.
+TEST_P(ThreadPoolTests, NestedTasks) {
+    ThreadPool pool(GetParam());
+
+    std::atomic<uint32_t> counter(0);
+    std::function<void(uint32_t)> recurse = [&](uint32_t depth) {
+        counter++;
+        if (depth == 0) {
+            return;
+        }
+        ThreadPool::TaskGroup group;
+        pool.Spawn(&group, [&recurse, depth] { recurse(depth - 1); });
+        pool.Spawn(&group, [&recurse, depth] { recurse(depth - 1); });
+        pool.Wait(&group);
+    };
+    recurse(10);
+
+    // A full binary tree of depth 10.
+    EXPECT_EQ(counter.load(), (1u << 11) - 1);
+}
+
+// Test that waiting on a group doesn't wait on the tasks of other groups.
+TEST_P(ThreadPoolTests, IndependentGroups) {
+    ThreadPool pool(GetParam());
+
+    std::atomic<uint32_t> counterA(0);
+    std::atomic<uint32_t> counterB(0);
+    ThreadPool::TaskGroup groupA;
+    ThreadPool::TaskGroup groupB;
+    for (uint32_t i = 0; i < 100; ++i) {
+        pool.Spawn(&groupA, [&counterA] { counterA++; });
+        pool.Spawn(&groupB, [&counterB] { counterB++; });
+    }
+    pool.Wait(&groupA);
+    EXPECT_EQ(counterA.load(), 100u);
+    pool.Wait(&groupB);
+    EXPECT_EQ(counterB.load(), 100u);
+}
+
+// Test that ParallelFor covers the whole range once, including a partial last chunk.
+TEST_P(ThreadPoolTests, ParallelFor) {
+    ThreadPool pool(GetParam());
+
+    std::vector<std::atomic<uint32_t>> visits(1000);
+    for (std::atomic<uint32_t>& visit : visits) {
+        visit = 0;
+    }
+    pool.ParallelFor(1000, 64, [&](uint32_t begin, uint32_t end) {
+        EXPECT_LE(end - begin, 64u);
+        for (uint32_t i = begin; i < end; ++i) {
+            visits[i]++;
+        }
+    });
+    for (const std::atomic<uint32_t>& visit : visits) {
+        EXPECT_EQ(visit.load(), 1u);
+    }
+
+    // An empty range doesn't call the function.
+    pool.ParallelFor(0, 64, [](uint32_t, uint32_t) { FAIL(); });
+}
+
+INSTANTIATE_TEST_SUITE_P(, ThreadPoolTests, testing::Values(0u, 1u, 4u));
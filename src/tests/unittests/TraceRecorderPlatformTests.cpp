@@ -0,0 +1,170 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "dawn_platform/TraceRecorderPlatform.h"
+#include "dawn_platform/tracing/TraceEvent.h"
+
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    std::string WriteJSON(dawn_platform::TraceRecorderPlatform* recorder) {
+        std::ostringstream stream;
+        recorder->WriteJSON(&stream);
+        return stream.str();
+    }
+
+    size_t CountOccurrences(const std::string& string, const std::string& pattern) {
+        size_t count = 0;
+        for (size_t pos = string.find(pattern); pos != std::string::npos;
+             pos = string.find(pattern, pos + pattern.size())) {
+            count++;
+        }
+        return count;
+    }
+
+}  // anonymous namespace
+
+// Test that events are only recorded between StartRecording and StopRecording.
+TEST(TraceRecorderPlatformTests, RecordsOnlyWhileRecording) {
+    dawn_platform::TraceRecorderPlatform recorder;
+    dawn_platform::Platform* platform = &recorder;
+    EXPECT_FALSE(recorder.IsRecording());
+
+    TRACE_EVENT_INSTANT0(platform, General, "BeforeStart");
+    recorder.StartRecording();
+    EXPECT_TRUE(recorder.IsRecording());
+    TRACE_EVENT_INSTANT0(platform, General, "WhileRecording");
+    recorder.StopRecording();
+    EXPECT_FALSE(recorder.IsRecording());
+    TRACE_EVENT_INSTANT0(platform, General, "AfterStop");
+
+    std::string json = WriteJSON(&recorder);
+    EXPECT_EQ(json.find("BeforeStart"), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"WhileRecording\""), std::string::npos);
+    EXPECT_EQ(json.find("AfterStop"), std::string::npos);
+}
+
+// Test that scoped events, their arguments and counters are written in the Chrome trace format.
+TEST(TraceRecorderPlatformTests, WritesChromeTraceEvents) {
+    dawn_platform::TraceRecorderPlatform recorder;
+    dawn_platform::Platform* platform = &recorder;
+    recorder.StartRecording();
+    {
+        TRACE_EVENT2(platform, Recording, "Scope", "size", uint64_t(42), "label", "a\"b");
+        TRACE_COUNTER1(platform, GPUWork, "Counter", 7);
+    }
+    recorder.StopRecording();
+
+    std::string json = WriteJSON(&recorder);
+    EXPECT_EQ(json.find("{\"traceEvents\":["), 0u);
+    EXPECT_NE(json.find("\"name\":\"Scope\",\"cat\":\"recording\",\"ph\":\"B\""),
+              std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"Scope\",\"cat\":\"recording\",\"ph\":\"E\""),
+              std::string::npos);
+    EXPECT_NE(json.find("\"args\":{\"size\":42,\"label\":\"a\\\"b\"}"), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"Counter\",\"cat\":\"gpu\",\"ph\":\"C\""),
+              std::string::npos);
+    EXPECT_NE(json.find("\"args\":{\"value\":7}"), std::string::npos);
+}
+
+// Test that 64 bit counters are written without being truncated to 32 bits.
+TEST(TraceRecorderPlatformTests, WritesUint64Counters) {
+    dawn_platform::TraceRecorderPlatform recorder;
+    dawn_platform::Platform* platform = &recorder;
+    recorder.StartRecording();
+    TRACE_COUNTER_UINT64(platform, General, "Bytes", uint64_t(5) << 32);
+    recorder.StopRecording();
+
+    std::string json = WriteJSON(&recorder);
+    EXPECT_NE(json.find("\"args\":{\"value\":21474836480}"), std::string::npos);
+}
+
+// Test that writing the events removes them from the recorder.
+TEST(TraceRecorderPlatformTests, WriteJSONDrainsEvents) {
+    dawn_platform::TraceRecorderPlatform recorder;
+    dawn_platform::Platform* platform = &recorder;
+    recorder.StartRecording();
+    TRACE_EVENT_INSTANT0(platform, General, "First");
+
+    EXPECT_NE(WriteJSON(&recorder).find("First"), std::string::npos);
+    EXPECT_EQ(WriteJSON(&recorder).find("First"), std::string::npos);
+
+    TRACE_EVENT_INSTANT0(platform, General, "Second");
+    recorder.StopRecording();
+    std::string json = WriteJSON(&recorder);
+    EXPECT_EQ(json.find("First"), std::string::npos);
+    EXPECT_NE(json.find("Second"), std::string::npos);
+}
+
+// Test that events are dropped and counted when the buffer of a thread is full, and recorded
+// again once it is drained.
+TEST(TraceRecorderPlatformTests, FullBufferDropsEvents) {
+    dawn_platform::TraceRecorderPlatform recorder(4);
+    dawn_platform::Platform* platform = &recorder;
+    recorder.StartRecording();
+    for (uint32_t i = 0; i < 6; ++i) {
+        TRACE_EVENT_INSTANT0(platform, General, "Event");
+    }
+    EXPECT_EQ(recorder.GetDroppedEventCount(), 2u);
+    EXPECT_EQ(CountOccurrences(WriteJSON(&recorder), "\"name\":\"Event\""), 4u);
+
+    TRACE_EVENT_INSTANT0(platform, General, "Event");
+    recorder.StopRecording();
+    EXPECT_EQ(recorder.GetDroppedEventCount(), 2u);
+    EXPECT_EQ(CountOccurrences(WriteJSON(&recorder), "\"name\":\"Event\""), 1u);
+}
+
+// Test that the events of several threads are all recorded, each with its own thread id.
+TEST(TraceRecorderPlatformTests, RecordsEventsOfSeveralThreads) {
+    constexpr uint32_t kThreadCount = 4;
+    constexpr uint32_t kEventsPerThread = 100;
+
+    dawn_platform::TraceRecorderPlatform recorder;
+    dawn_platform::Platform* platform = &recorder;
+    recorder.StartRecording();
+
+    // The threads wait for each other before recording so that they are all alive at the same
+    // time and can't reuse the id of a finished thread.
+    std::atomic<uint32_t> startedThreadCount(0);
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < kThreadCount; ++i) {
+        threads.emplace_back([platform, &startedThreadCount] {
+            startedThreadCount++;
+            while (startedThreadCount.load() < kThreadCount) {
+                std::this_thread::yield();
+            }
+            for (uint32_t j = 0; j < kEventsPerThread; ++j) {
+                TRACE_EVENT_INSTANT0(platform, General, "ThreadEvent");
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    recorder.StopRecording();
+
+    std::string json = WriteJSON(&recorder);
+    EXPECT_EQ(CountOccurrences(json, "\"name\":\"ThreadEvent\""), kThreadCount * kEventsPerThread);
+    EXPECT_EQ(recorder.GetDroppedEventCount(), 0u);
+    for (uint32_t i = 1; i <= kThreadCount; ++i) {
+        EXPECT_EQ(CountOccurrences(json, "\"tid\":" + std::to_string(i) + ","), kEventsPerThread);
+    }
+}
@@ -0,0 +1,205 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/unittests/validation/ValidationTest.h"
+
+#include "utils/ComboRenderPipelineDescriptor.h"
+#include "utils/WGPUHelpers.h"
+
+namespace {
+
+    struct CreatePipelineAsyncResult {
+        bool isCalled = false;
+        WGPUCreatePipelineAsyncStatus status = WGPUCreatePipelineAsyncStatus_Unknown;
+        wgpu::ComputePipeline computePipeline;
+        wgpu::RenderPipeline renderPipeline;
+    };
+
+    void ComputeCallback(WGPUCreatePipelineAsyncStatus status,
+                         WGPUComputePipeline pipeline,
+                         const char* message,
+                         void* userdata) {
+        CreatePipelineAsyncResult* result = static_cast<CreatePipelineAsyncResult*>(userdata);
+        result->isCalled = true;
+        result->status = status;
+        result->computePipeline = wgpu::ComputePipeline::Acquire(pipeline);
+    }
+
+    void RenderCallback(WGPUCreatePipelineAsyncStatus status,
+                        WGPURenderPipeline pipeline,
+                        const char* message,
+                        void* userdata) {
+        CreatePipelineAsyncResult* result = static_cast<CreatePipelineAsyncResult*>(userdata);
+        result->isCalled = true;
+        result->status = status;
+        result->renderPipeline = wgpu::RenderPipeline::Acquire(pipeline);
+    }
+
+}  // anonymous namespace
+
+class CreatePipelineAsyncValidationTest : public ValidationTest {
+  protected:
+    void SetUp() override {
+        ValidationTest::SetUp();
+
+        mCsModule = utils::CreateShaderModule(device, utils::SingleShaderStage::Compute, R"(
+            #version 450
+            layout(std430, set = 0, binding = 0) buffer Data {
+                uint value;
+            } data;
+            void main() {
+                data.value = 1;
+            })");
+    }
+
+    wgpu::ComputePipelineDescriptor MakeComputeDescriptor() const {
+        wgpu::ComputePipelineDescriptor descriptor;
+        descriptor.computeStage.module = mCsModule;
+        descriptor.computeStage.entryPoint = "main";
+        return descriptor;
+    }
+
+    // Pipelines might be created on worker threads so tick until the callback is called.
+    void WaitForCallback(const CreatePipelineAsyncResult& result) {
+        while (!result.isCalled) {
+            device.Tick();
+        }
+    }
+
+    wgpu::ShaderModule mCsModule;
+};
+
+// Test that a valid compute pipeline is returned in the callback.
+TEST_F(CreatePipelineAsyncValidationTest, ComputeSuccess) {
+    wgpu::ComputePipelineDescriptor descriptor = MakeComputeDescriptor();
+
+    CreatePipelineAsyncResult result;
+    device.CreateComputePipelineAsync(&descriptor, ComputeCallback, &result);
+    WaitForCallback(result);
+
+    EXPECT_EQ(result.status, WGPUCreatePipelineAsyncStatus_Success);
+    EXPECT_TRUE(result.computePipeline);
+}
+
+// Test that the callback is only called when the device ticks, even if the pipeline is already
+// known when the request is made.
+TEST_F(CreatePipelineAsyncValidationTest, CallbackCalledOnTick) {
+    wgpu::ComputePipelineDescriptor descriptor = MakeComputeDescriptor();
+    wgpu::ComputePipeline pipeline = device.CreateComputePipeline(&descriptor);
+
+    CreatePipelineAsyncResult result;
+    device.CreateComputePipelineAsync(&descriptor, ComputeCallback, &result);
+    EXPECT_FALSE(result.isCalled);
+
+    device.Tick();
+    EXPECT_TRUE(result.isCalled);
+}
+
+// Test that asynchronously created pipelines are deduplicated with the synchronous ones.
+TEST_F(CreatePipelineAsyncValidationTest, ComputeCachedWithSyncPipelines) {
+    wgpu::ComputePipelineDescriptor descriptor = MakeComputeDescriptor();
+
+    CreatePipelineAsyncResult result;
+    device.CreateComputePipelineAsync(&descriptor, ComputeCallback, &result);
+    WaitForCallback(result);
+    ASSERT_EQ(result.status, WGPUCreatePipelineAsyncStatus_Success);
+
+    wgpu::ComputePipeline pipeline = device.CreateComputePipeline(&descriptor);
+    EXPECT_EQ(pipeline.Get(), result.computePipeline.Get());
+
+    CreatePipelineAsyncResult secondResult;
+    device.CreateComputePipelineAsync(&descriptor, ComputeCallback, &secondResult);
+    WaitForCallback(secondResult);
+    EXPECT_EQ(secondResult.computePipeline.Get(), pipeline.Get());
+}
+
+// Test that validation errors are returned in the callback instead of the device error callback.
+TEST_F(CreatePipelineAsyncValidationTest, ComputeValidationError) {
+    wgpu::ComputePipelineDescriptor descriptor = MakeComputeDescriptor();
+    descriptor.computeStage.entryPoint = "doesNotExist";
+
+    CreatePipelineAsyncResult result;
+    device.CreateComputePipelineAsync(&descriptor, ComputeCallback, &result);
+    WaitForCallback(result);
+
+    EXPECT_EQ(result.status, WGPUCreatePipelineAsyncStatus_Error);
+    EXPECT_FALSE(result.computePipeline);
+}
+
+// Test that a valid render pipeline is returned in the callback.
+TEST_F(CreatePipelineAsyncValidationTest, RenderSuccess) {
+    utils::ComboRenderPipelineDescriptor descriptor(device);
+    descriptor.vertexStage.module =
+        utils::CreateShaderModule(device, utils::SingleShaderStage::Vertex, R"(
+            #version 450
+            void main() {
+                gl_Position = vec4(0.0, 0.0, 0.0, 1.0);
+            })");
+    descriptor.cFragmentStage.module =
+        utils::CreateShaderModule(device, utils::SingleShaderStage::Fragment, R"(
+            #version 450
+            layout(location = 0) out vec4 fragColor;
+            void main() {
+                fragColor = vec4(0.0, 1.0, 0.0, 1.0);
+            })");
+
+    CreatePipelineAsyncResult result;
+    device.CreateRenderPipelineAsync(&descriptor, RenderCallback, &result);
+    WaitForCallback(result);
+
+    EXPECT_EQ(result.status, WGPUCreatePipelineAsyncStatus_Success);
+    EXPECT_TRUE(result.renderPipeline);
+}
+
+// Test that render pipelines created after their descriptor is gone are deduplicated with the
+// synchronous ones.
+TEST_F(CreatePipelineAsyncValidationTest, RenderCachedWithSyncPipelines) {
+    wgpu::ShaderModule vsModule =
+        utils::CreateShaderModule(device, utils::SingleShaderStage::Vertex, R"(
+            #version 450
+            layout(location = 0) in vec4 pos;
+            void main() {
+                gl_Position = pos;
+            })");
+    wgpu::ShaderModule fsModule =
+        utils::CreateShaderModule(device, utils::SingleShaderStage::Fragment, R"(
+            #version 450
+            layout(location = 0) out vec4 fragColor;
+            void main() {
+                fragColor = vec4(0.0, 1.0, 0.0, 1.0);
+            })");
+
+    auto InitDescriptor = [&](utils::ComboRenderPipelineDescriptor* descriptor) {
+        descriptor->vertexStage.module = vsModule;
+        descriptor->cFragmentStage.module = fsModule;
+        descriptor->cVertexState.vertexBufferCount = 1;
+        descriptor->cVertexState.cVertexBuffers[0].arrayStride = 16;
+        descriptor->cVertexState.cVertexBuffers[0].attributeCount = 1;
+        descriptor->cVertexState.cAttributes[0].format = wgpu::VertexFormat::Float4;
+    };
+
+    CreatePipelineAsyncResult result;
+    {
+        utils::ComboRenderPipelineDescriptor descriptor(device);
+        InitDescriptor(&descriptor);
+        device.CreateRenderPipelineAsync(&descriptor, RenderCallback, &result);
+    }
+    WaitForCallback(result);
+    ASSERT_EQ(result.status, WGPUCreatePipelineAsyncStatus_Success);
+
+    utils::ComboRenderPipelineDescriptor descriptor(device);
+    InitDescriptor(&descriptor);
+    wgpu::RenderPipeline pipeline = device.CreateRenderPipeline(&descriptor);
+    EXPECT_EQ(pipeline.Get(), result.renderPipeline.Get());
+}
@@ -0,0 +1,125 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/unittests/validation/ValidationTest.h"
+
+#include "utils/WGPUHelpers.h"
+
+class DeviceStatisticsValidationTest : public ValidationTest {
+  protected:
+    WGPUDeviceStatistics GetStatistics() {
+        struct Result {
+            bool called = false;
+            WGPUDeviceStatisticsStatus status;
+            WGPUDeviceStatistics statistics;
+        } result;
+
+        device.GetStatistics(
+            [](WGPUDeviceStatisticsStatus status, const WGPUDeviceStatistics* statistics,
+               void* userdata) {
+                Result* result = static_cast<Result*>(userdata);
+                result->called = true;
+                result->status = status;
+                result->statistics = *statistics;
+            },
+            &result);
+
+        // The native device answers synchronously.
+        EXPECT_TRUE(result.called);
+        EXPECT_EQ(result.status, WGPUDeviceStatisticsStatus_Success);
+        return result.statistics;
+    }
+
+    wgpu::Buffer CreateBuffer(uint64_t size, wgpu::BufferUsage usage) {
+        wgpu::BufferDescriptor descriptor;
+        descriptor.size = size;
+        descriptor.usage = usage;
+        return device.CreateBuffer(&descriptor);
+    }
+};
+
+// Test that the live objects are counted until they are destroyed.
+TEST_F(DeviceStatisticsValidationTest, LiveObjectCounts) {
+    WGPUDeviceStatistics before = GetStatistics();
+
+    {
+        wgpu::Buffer buffer1 = CreateBuffer(4, wgpu::BufferUsage::CopyDst);
+        wgpu::Buffer buffer2 = CreateBuffer(4, wgpu::BufferUsage::CopyDst);
+        wgpu::Fence fence = device.GetDefaultQueue().CreateFence();
+
+        WGPUDeviceStatistics during = GetStatistics();
+        EXPECT_EQ(during.bufferCount, before.bufferCount + 2);
+        EXPECT_EQ(during.fenceCount, before.fenceCount + 1);
+        EXPECT_EQ(during.textureCount, before.textureCount);
+    }
+
+    WGPUDeviceStatistics after = GetStatistics();
+    EXPECT_EQ(after.bufferCount, before.bufferCount);
+    EXPECT_EQ(after.fenceCount, before.fenceCount);
+}
+
+// Test that creating the same cached object twice counts a miss and then a hit.
+TEST_F(DeviceStatisticsValidationTest, CacheHitsAndMisses) {
+    WGPUDeviceStatistics before = GetStatistics();
+
+    wgpu::SamplerDescriptor descriptor = utils::GetDefaultSamplerDescriptor();
+    wgpu::Sampler sampler1 = device.CreateSampler(&descriptor);
+
+    WGPUDeviceStatistics afterFirst = GetStatistics();
+    EXPECT_EQ(afterFirst.samplerCacheMisses, before.samplerCacheMisses + 1);
+    EXPECT_EQ(afterFirst.samplerCacheHits, before.samplerCacheHits);
+    EXPECT_EQ(afterFirst.samplerCount, before.samplerCount + 1);
+
+    wgpu::Sampler sampler2 = device.CreateSampler(&descriptor);
+
+    WGPUDeviceStatistics afterSecond = GetStatistics();
+    EXPECT_EQ(afterSecond.samplerCacheMisses, afterFirst.samplerCacheMisses);
+    EXPECT_EQ(afterSecond.samplerCacheHits, afterFirst.samplerCacheHits + 1);
+    EXPECT_EQ(afterSecond.samplerCount, afterFirst.samplerCount);
+}
+
+// Test that the encoded and submitted commands are counted.
+TEST_F(DeviceStatisticsValidationTest, CommandCounts) {
+    wgpu::Buffer source = CreateBuffer(4, wgpu::BufferUsage::CopySrc);
+    wgpu::Buffer destination = CreateBuffer(4, wgpu::BufferUsage::CopyDst);
+
+    WGPUDeviceStatistics before = GetStatistics();
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    encoder.CopyBufferToBuffer(source, 0, destination, 0, 4);
+    encoder.CopyBufferToBuffer(source, 0, destination, 0, 4);
+    wgpu::CommandBuffer commands = encoder.Finish();
+
+    WGPUDeviceStatistics afterFinish = GetStatistics();
+    EXPECT_EQ(afterFinish.encodedCommandCount, before.encodedCommandCount + 2);
+    EXPECT_EQ(afterFinish.commandBufferCount, before.commandBufferCount + 1);
+    EXPECT_EQ(afterFinish.submittedCommandBufferCount, before.submittedCommandBufferCount);
+
+    device.GetDefaultQueue().Submit(1, &commands);
+
+    WGPUDeviceStatistics afterSubmit = GetStatistics();
+    EXPECT_EQ(afterSubmit.submittedCommandBufferCount, before.submittedCommandBufferCount + 1);
+    EXPECT_EQ(afterSubmit.submittedCommandCount, before.submittedCommandCount + 2);
+    EXPECT_GE(afterSubmit.lastSubmittedSerial, afterSubmit.completedSerial);
+}
+
+// Test that the allocated memory of the null backend is reported.
+TEST_F(DeviceStatisticsValidationTest, AllocatedMemorySize) {
+    WGPUDeviceStatistics before = GetStatistics();
+
+    wgpu::Buffer buffer = CreateBuffer(256, wgpu::BufferUsage::CopyDst);
+
+    WGPUDeviceStatistics after = GetStatistics();
+    EXPECT_EQ(after.allocatedMemorySize, before.allocatedMemorySize + 256);
+}
@@ -0,0 +1,131 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/unittests/validation/ValidationTest.h"
+
+#include "utils/WGPUHelpers.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+class MultithreadedEncodingValidationTest : public ValidationTest {
+  protected:
+    static constexpr uint32_t kThreadCount = 8;
+    static constexpr uint32_t kEncodersPerThread = 50;
+
+    // Runs |recordFunction| on kThreadCount threads and returns the command buffers they
+    // recorded, in an unspecified order.
+    template <typename RecordFunction>
+    std::vector<wgpu::CommandBuffer> RecordOnThreads(RecordFunction recordFunction) {
+        std::vector<std::vector<wgpu::CommandBuffer>> commandsPerThread(kThreadCount);
+        std::vector<std::thread> threads;
+        for (uint32_t i = 0; i < kThreadCount; ++i) {
+            threads.emplace_back([&, i]() {
+                for (uint32_t j = 0; j < kEncodersPerThread; ++j) {
+                    commandsPerThread[i].push_back(recordFunction());
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        std::vector<wgpu::CommandBuffer> commands;
+        for (std::vector<wgpu::CommandBuffer>& threadCommands : commandsPerThread) {
+            commands.insert(commands.end(), threadCommands.begin(), threadCommands.end());
+        }
+        return commands;
+    }
+};
+
+// Test that compute passes using the same objects can be recorded on several threads and
+// submitted on the device thread.
+TEST_F(MultithreadedEncodingValidationTest, ComputePasses) {
+    wgpu::ShaderModule module =
+        utils::CreateShaderModule(device, utils::SingleShaderStage::Compute, R"(
+            #version 450
+            layout(std430, set = 0, binding = 0) buffer Data {
+                uint value;
+            } data;
+            void main() {
+                data.value = 1;
+            })");
+    wgpu::ComputePipelineDescriptor pipelineDescriptor;
+    pipelineDescriptor.computeStage.module = module;
+    pipelineDescriptor.computeStage.entryPoint = "main";
+    wgpu::ComputePipeline pipeline = device.CreateComputePipeline(&pipelineDescriptor);
+
+    wgpu::Buffer buffer = utils::CreateBufferFromData(device, wgpu::BufferUsage::Storage, {0u});
+    wgpu::BindGroup bindGroup =
+        utils::MakeBindGroup(device, pipeline.GetBindGroupLayout(0), {{0, buffer}});
+
+    std::vector<wgpu::CommandBuffer> commands = RecordOnThreads([&]() {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+        pass.SetPipeline(pipeline);
+        pass.SetBindGroup(0, bindGroup);
+        pass.Dispatch(1);
+        pass.EndPass();
+        return encoder.Finish();
+    });
+
+    device.GetDefaultQueue().Submit(static_cast<uint32_t>(commands.size()), commands.data());
+}
+
+// Test that render passes and render bundles, which share the device's attachment state cache,
+// can be recorded on several threads.
+TEST_F(MultithreadedEncodingValidationTest, RenderPassesAndBundles) {
+    DummyRenderPass renderPass(device);
+
+    wgpu::RenderBundleEncoderDescriptor bundleDescriptor;
+    bundleDescriptor.colorFormatsCount = 1;
+    bundleDescriptor.colorFormats = &renderPass.attachmentFormat;
+
+    std::vector<wgpu::CommandBuffer> commands = RecordOnThreads([&]() {
+        wgpu::RenderBundleEncoder bundleEncoder =
+            device.CreateRenderBundleEncoder(&bundleDescriptor);
+        wgpu::RenderBundle bundle = bundleEncoder.Finish();
+
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+        pass.ExecuteBundles(1, &bundle);
+        pass.EndPass();
+        return encoder.Finish();
+    });
+
+    device.GetDefaultQueue().Submit(static_cast<uint32_t>(commands.size()), commands.data());
+}
+
+// Test that errors of encoders finished on several threads are all reported.
+TEST_F(MultithreadedEncodingValidationTest, ConcurrentErrors) {
+    std::atomic<uint32_t> errorCount(0);
+    device.SetUncapturedErrorCallback(
+        [](WGPUErrorType type, const char*, void* userdata) {
+            EXPECT_EQ(type, WGPUErrorType_Validation);
+            (*static_cast<std::atomic<uint32_t>*>(userdata))++;
+        },
+        &errorCount);
+
+    RecordOnThreads([&]() {
+        // Dispatching without a pipeline is an error.
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+        pass.Dispatch(1);
+        pass.EndPass();
+        return encoder.Finish();
+    });
+
+    EXPECT_EQ(errorCount.load(), kThreadCount * kEncodersPerThread);
+}
@@ -66,4 +66,37 @@ TEST_F(QueueSubmitValidationTest, SubmitWithMappedBuffer) {
     queue.Submit(1, &commands);
 }
 
+// Test that resubmitting a command buffer checks again the resources used in its passes when one
+// of them is destroyed.
+TEST_F(QueueSubmitValidationTest, ResubmitAfterDestroy) {
+    DummyRenderPass renderPass(device);
+
+    wgpu::BufferDescriptor descriptor;
+    descriptor.usage = wgpu::BufferUsage::Vertex;
+    descriptor.size = 16;
+    wgpu::Buffer unrelatedBuffer = device.CreateBuffer(&descriptor);
+
+    wgpu::CommandBuffer commands;
+    {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        wgpu::RenderPassEncoder pass = encoder.BeginRenderPass(&renderPass);
+        pass.EndPass();
+        pass = encoder.BeginRenderPass(&renderPass);
+        pass.EndPass();
+        commands = encoder.Finish();
+    }
+
+    wgpu::Queue queue = device.GetDefaultQueue();
+    queue.Submit(1, &commands);
+    queue.Submit(1, &commands);
+
+    // Destroying a resource that isn't used by the command buffer doesn't make it invalid.
+    unrelatedBuffer.Destroy();
+    queue.Submit(1, &commands);
+
+    // Destroying the render target used by both passes makes it invalid.
+    renderPass.attachment.Destroy();
+    ASSERT_DEVICE_ERROR(queue.Submit(1, &commands));
+}
+
 }  // anonymous namespace
@@ -0,0 +1,445 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/unittests/validation/ValidationTest.h"
+
+#include <gmock/gmock.h>
+
+#include <cstring>
+#include <vector>
+
+using namespace testing;
+
+class MockCompactedSizeCallback {
+  public:
+    MOCK_METHOD(void,
+                Call,
+                (WGPURayTracingAccelerationContainerCompactedSizeStatus status,
+                 uint64_t compactedSize,
+                 void* userdata));
+};
+
+static std::unique_ptr<MockCompactedSizeCallback> mockCompactedSizeCallback;
+static void ToMockCompactedSizeCallback(
+    WGPURayTracingAccelerationContainerCompactedSizeStatus status,
+    uint64_t compactedSize,
+    void* userdata) {
+    mockCompactedSizeCallback->Call(status, compactedSize, userdata);
+}
+
+class RayTracingAccelerationContainerValidationTest : public ValidationTest {
+  protected:
+    static constexpr uint32_t kVertexCount = 9;
+
+    void SetUp() override {
+        ValidationTest::SetUp();
+        device = CreateDeviceFromAdapter(adapter, {"ray_tracing"});
+        queue = device.GetDefaultQueue();
+
+        mockCompactedSizeCallback = std::make_unique<MockCompactedSizeCallback>();
+
+        // Three triangles side by side.
+        const float vertices[kVertexCount * 3] = {
+            0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f,  //
+            2.0f, 0.0f, 0.0f, 3.0f, 0.0f, 0.0f, 2.0f, 1.0f, 0.0f,  //
+            4.0f, 0.0f, 0.0f, 5.0f, 0.0f, 0.0f, 4.0f, 1.0f, 0.0f,
+        };
+        wgpu::BufferDescriptor descriptor;
+        descriptor.size = sizeof(vertices);
+        descriptor.usage = wgpu::BufferUsage::RayTracing;
+        wgpu::CreateBufferMappedResult result = device.CreateBufferMapped(&descriptor);
+        memcpy(result.data, vertices, sizeof(vertices));
+        result.buffer.Unmap();
+        mVertexBuffer = result.buffer;
+    }
+
+    void TearDown() override {
+        // Delete mocks so that expectations are checked
+        mockCompactedSizeCallback = nullptr;
+
+        ValidationTest::TearDown();
+    }
+
+    wgpu::RayTracingAccelerationContainer CreateBottomLevelContainer(
+        wgpu::RayTracingAccelerationContainerUsage usage) {
+        wgpu::RayTracingAccelerationGeometryVertexDescriptor vertex;
+        vertex.buffer = mVertexBuffer;
+        vertex.format = wgpu::VertexFormat::Float3;
+        vertex.stride = 3 * sizeof(float);
+        vertex.count = kVertexCount;
+
+        wgpu::RayTracingAccelerationGeometryDescriptor geometry;
+        geometry.type = wgpu::RayTracingAccelerationGeometryType::Triangles;
+        geometry.vertex = &vertex;
+
+        wgpu::RayTracingAccelerationContainerDescriptor descriptor;
+        descriptor.level = wgpu::RayTracingAccelerationContainerLevel::Bottom;
+        descriptor.usage = usage;
+        descriptor.geometryCount = 1;
+        descriptor.geometries = &geometry;
+        return device.CreateRayTracingAccelerationContainer(&descriptor);
+    }
+
+    wgpu::RayTracingAccelerationContainer CreateTopLevelContainer(
+        const wgpu::RayTracingAccelerationContainer& geometryContainer,
+        uint32_t instanceCount) {
+        std::vector<wgpu::RayTracingAccelerationInstanceDescriptor> instances(instanceCount);
+        for (wgpu::RayTracingAccelerationInstanceDescriptor& instance : instances) {
+            instance.geometryContainer = geometryContainer;
+        }
+
+        wgpu::RayTracingAccelerationContainerDescriptor descriptor;
+        descriptor.level = wgpu::RayTracingAccelerationContainerLevel::Top;
+        descriptor.instanceCount = instanceCount;
+        descriptor.instances = instances.data();
+        return device.CreateRayTracingAccelerationContainer(&descriptor);
+    }
+
+    wgpu::RayTracingAccelerationContainer CreateCompactedContainer(uint64_t compactedSize) {
+        wgpu::RayTracingAccelerationContainerDescriptor descriptor;
+        descriptor.level = wgpu::RayTracingAccelerationContainerLevel::Bottom;
+        descriptor.compactedSize = compactedSize;
+        return device.CreateRayTracingAccelerationContainer(&descriptor);
+    }
+
+    void Build(const wgpu::RayTracingAccelerationContainer& container) {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        encoder.BuildRayTracingAccelerationContainer(container);
+        wgpu::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+    }
+
+    void Update(const wgpu::RayTracingAccelerationContainer& container) {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        encoder.UpdateRayTracingAccelerationContainer(container);
+        wgpu::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+    }
+
+    wgpu::CommandEncoder EncodeUpdate(
+        const wgpu::RayTracingAccelerationContainer& container,
+        const std::vector<wgpu::RayTracingAccelerationContainerDirtyRange>& dirtyRanges) {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        encoder.UpdateRayTracingAccelerationContainer(
+            container, static_cast<uint32_t>(dirtyRanges.size()), dirtyRanges.data());
+        return encoder;
+    }
+
+    wgpu::Queue queue;
+    wgpu::Buffer mVertexBuffer;
+};
+
+// Test the validation of the dirty ranges of an update.
+TEST_F(RayTracingAccelerationContainerValidationTest, DirtyRanges) {
+    wgpu::RayTracingAccelerationContainer container =
+        CreateBottomLevelContainer(wgpu::RayTracingAccelerationContainerUsage::AllowUpdate);
+    Build(container);
+
+    // Success cases, including an empty range and a range ending at the last vertex.
+    EncodeUpdate(container, {{0, 0, 3}, {0, 3, 0}, {0, 6, kVertexCount - 6}}).Finish();
+
+    // Error case, the geometry doesn't exist.
+    ASSERT_DEVICE_ERROR(EncodeUpdate(container, {{1, 0, 3}}).Finish());
+
+    // Error case, the range is out of the bounds of the geometry.
+    ASSERT_DEVICE_ERROR(EncodeUpdate(container, {{0, 6, kVertexCount - 5}}).Finish());
+    ASSERT_DEVICE_ERROR(EncodeUpdate(container, {{0, 1, 0xFFFFFFFF}}).Finish());
+
+    // Error case, the container can't be updated.
+    wgpu::RayTracingAccelerationContainer staticContainer =
+        CreateBottomLevelContainer(wgpu::RayTracingAccelerationContainerUsage::None);
+    Build(staticContainer);
+    ASSERT_DEVICE_ERROR(EncodeUpdate(staticContainer, {{0, 0, 3}}).Finish());
+
+    // Error case, the container is destroyed.
+    container.Destroy();
+    ASSERT_DEVICE_ERROR(EncodeUpdate(container, {{0, 0, 3}}).Finish());
+}
+
+// Test that only containers that can be updated can be built again.
+TEST_F(RayTracingAccelerationContainerValidationTest, Rebuild) {
+    wgpu::RayTracingAccelerationContainer container =
+        CreateBottomLevelContainer(wgpu::RayTracingAccelerationContainerUsage::AllowUpdate);
+    Build(container);
+    Build(container);
+
+    wgpu::RayTracingAccelerationContainer staticContainer =
+        CreateBottomLevelContainer(wgpu::RayTracingAccelerationContainerUsage::None);
+    Build(staticContainer);
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    encoder.BuildRayTracingAccelerationContainer(staticContainer);
+    ASSERT_DEVICE_ERROR(encoder.Finish());
+}
+
+// Test that refits and rebuilds are counted separately.
+TEST_F(RayTracingAccelerationContainerValidationTest, UpdateStats) {
+    wgpu::RayTracingAccelerationContainer container =
+        CreateBottomLevelContainer(wgpu::RayTracingAccelerationContainerUsage::AllowUpdate);
+
+    dawn_native::AccelerationContainerUpdateStats stats =
+        dawn_native::GetAccelerationContainerUpdateStats(container.Get());
+    EXPECT_EQ(stats.buildCount, 0u);
+    EXPECT_EQ(stats.refitCount, 0u);
+
+    Build(container);
+    wgpu::CommandBuffer commands = EncodeUpdate(container, {{0, 3, 3}}).Finish();
+    queue.Submit(1, &commands);
+    Update(container);
+    stats = dawn_native::GetAccelerationContainerUpdateStats(container.Get());
+    EXPECT_EQ(stats.buildCount, 1u);
+    EXPECT_EQ(stats.refitCount, 2u);
+    EXPECT_EQ(stats.refitCountSinceBuild, 2u);
+
+    Build(container);
+    Update(container);
+    stats = dawn_native::GetAccelerationContainerUpdateStats(container.Get());
+    EXPECT_EQ(stats.buildCount, 2u);
+    EXPECT_EQ(stats.refitCount, 3u);
+    EXPECT_EQ(stats.refitCountSinceBuild, 1u);
+}
+
+// Test the validation of the descriptor of compacted containers.
+TEST_F(RayTracingAccelerationContainerValidationTest, CompactedContainerDescriptor) {
+    // Success case, a compacted container has no geometry.
+    CreateCompactedContainer(256);
+
+    wgpu::RayTracingAccelerationGeometryVertexDescriptor vertex;
+    vertex.buffer = mVertexBuffer;
+    vertex.format = wgpu::VertexFormat::Float3;
+    vertex.stride = 3 * sizeof(float);
+    vertex.count = kVertexCount;
+
+    wgpu::RayTracingAccelerationGeometryDescriptor geometry;
+    geometry.type = wgpu::RayTracingAccelerationGeometryType::Triangles;
+    geometry.vertex = &vertex;
+
+    // Error case, compacted containers can't have geometries.
+    {
+        wgpu::RayTracingAccelerationContainerDescriptor descriptor;
+        descriptor.level = wgpu::RayTracingAccelerationContainerLevel::Bottom;
+        descriptor.geometryCount = 1;
+        descriptor.geometries = &geometry;
+        descriptor.compactedSize = 256;
+        ASSERT_DEVICE_ERROR(device.CreateRayTracingAccelerationContainer(&descriptor));
+    }
+
+    // Error case, compacted containers can't be updated or compacted again.
+    {
+        wgpu::RayTracingAccelerationContainerDescriptor descriptor;
+        descriptor.level = wgpu::RayTracingAccelerationContainerLevel::Bottom;
+        descriptor.compactedSize = 256;
+        descriptor.usage = wgpu::RayTracingAccelerationContainerUsage::AllowUpdate;
+        ASSERT_DEVICE_ERROR(device.CreateRayTracingAccelerationContainer(&descriptor));
+
+        descriptor.usage = wgpu::RayTracingAccelerationContainerUsage::AllowCompaction;
+        ASSERT_DEVICE_ERROR(device.CreateRayTracingAccelerationContainer(&descriptor));
+    }
+
+    // Error case, compacted containers can't be built.
+    wgpu::RayTracingAccelerationContainer compacted = CreateCompactedContainer(256);
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    encoder.BuildRayTracingAccelerationContainer(compacted);
+    ASSERT_DEVICE_ERROR(encoder.Finish());
+}
+
+// Test the errors of compacted size queries.
+TEST_F(RayTracingAccelerationContainerValidationTest, GetCompactedSizeErrors) {
+    // Error case, the container doesn't allow compaction.
+    wgpu::RayTracingAccelerationContainer staticContainer =
+        CreateBottomLevelContainer(wgpu::RayTracingAccelerationContainerUsage::None);
+    Build(staticContainer);
+    EXPECT_CALL(*mockCompactedSizeCallback,
+                Call(WGPURayTracingAccelerationContainerCompactedSizeStatus_Error, 0u, this))
+        .Times(1);
+    ASSERT_DEVICE_ERROR(staticContainer.GetCompactedSizeAsync(ToMockCompactedSizeCallback, this));
+
+    // Error case, the container isn't built.
+    wgpu::RayTracingAccelerationContainer container =
+        CreateBottomLevelContainer(wgpu::RayTracingAccelerationContainerUsage::AllowCompaction);
+    EXPECT_CALL(*mockCompactedSizeCallback,
+                Call(WGPURayTracingAccelerationContainerCompactedSizeStatus_Error, 0u, this + 1))
+        .Times(1);
+    ASSERT_DEVICE_ERROR(container.GetCompactedSizeAsync(ToMockCompactedSizeCallback, this + 1));
+
+    // Error case, the container is destroyed.
+    Build(container);
+    container.Destroy();
+    EXPECT_CALL(*mockCompactedSizeCallback,
+                Call(WGPURayTracingAccelerationContainerCompactedSizeStatus_Error, 0u, this + 2))
+        .Times(1);
+    ASSERT_DEVICE_ERROR(container.GetCompactedSizeAsync(ToMockCompactedSizeCallback, this + 2));
+}
+
+// Test that the compacted size is returned once the build is finished.
+TEST_F(RayTracingAccelerationContainerValidationTest, GetCompactedSizeSuccess) {
+    wgpu::RayTracingAccelerationContainer container =
+        CreateBottomLevelContainer(wgpu::RayTracingAccelerationContainerUsage::AllowCompaction);
+    Build(container);
+
+    container.GetCompactedSizeAsync(ToMockCompactedSizeCallback, this);
+    EXPECT_CALL(*mockCompactedSizeCallback,
+                Call(WGPURayTracingAccelerationContainerCompactedSizeStatus_Success, Gt(0u), this))
+        .Times(1);
+    device.Tick();
+}
+
+// Test that destroying the container before the compacted size is known aborts the query.
+TEST_F(RayTracingAccelerationContainerValidationTest, GetCompactedSizeDestroyedBeforeCallback) {
+    wgpu::RayTracingAccelerationContainer container =
+        CreateBottomLevelContainer(wgpu::RayTracingAccelerationContainerUsage::AllowCompaction);
+    Build(container);
+
+    container.GetCompactedSizeAsync(ToMockCompactedSizeCallback, this);
+    container.Destroy();
+    EXPECT_CALL(*mockCompactedSizeCallback,
+                Call(WGPURayTracingAccelerationContainerCompactedSizeStatus_Unknown, 0u, this))
+        .Times(1);
+    device.Tick();
+}
+
+// Test the validation of compacting copies.
+TEST_F(RayTracingAccelerationContainerValidationTest, CompactCopy) {
+    wgpu::RayTracingAccelerationContainer source =
+        CreateBottomLevelContainer(wgpu::RayTracingAccelerationContainerUsage::AllowCompaction);
+    Build(source);
+
+    // Success case, and the source can be destroyed right after to release its memory.
+    wgpu::RayTracingAccelerationContainer compacted = CreateCompactedContainer(256);
+    {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        encoder.CopyRayTracingAccelerationContainer(
+            source, compacted, wgpu::RayTracingAccelerationContainerCopyMode::Compact);
+        wgpu::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+    }
+
+    // Error case, the destination already holds a compacted container.
+    {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        encoder.CopyRayTracingAccelerationContainer(
+            source, compacted, wgpu::RayTracingAccelerationContainerCopyMode::Compact);
+        ASSERT_DEVICE_ERROR(encoder.Finish());
+    }
+
+    // Error case, the destination wasn't created with a compacted size.
+    {
+        wgpu::RayTracingAccelerationContainer destination =
+            CreateBottomLevelContainer(wgpu::RayTracingAccelerationContainerUsage::None);
+        Build(destination);
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        encoder.CopyRayTracingAccelerationContainer(
+            source, destination, wgpu::RayTracingAccelerationContainerCopyMode::Compact);
+        ASSERT_DEVICE_ERROR(encoder.Finish());
+    }
+
+    // Error case, the source doesn't allow compaction.
+    {
+        wgpu::RayTracingAccelerationContainer staticSource =
+            CreateBottomLevelContainer(wgpu::RayTracingAccelerationContainerUsage::None);
+        Build(staticSource);
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        encoder.CopyRayTracingAccelerationContainer(
+            staticSource, CreateCompactedContainer(256),
+            wgpu::RayTracingAccelerationContainerCopyMode::Compact);
+        ASSERT_DEVICE_ERROR(encoder.Finish());
+    }
+
+    // Error case, compacted containers can't be the destination of a clone.
+    {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        encoder.CopyRayTracingAccelerationContainer(
+            source, compacted, wgpu::RayTracingAccelerationContainerCopyMode::Clone);
+        ASSERT_DEVICE_ERROR(encoder.Finish());
+    }
+
+    source.Destroy();
+}
+
+// Test the validation of building several containers at once.
+TEST_F(RayTracingAccelerationContainerValidationTest, BatchedBuild) {
+    wgpu::RayTracingAccelerationContainer containers[2] = {
+        CreateBottomLevelContainer(wgpu::RayTracingAccelerationContainerUsage::AllowUpdate),
+        CreateBottomLevelContainer(wgpu::RayTracingAccelerationContainerUsage::None),
+    };
+
+    // Success case, both containers are built.
+    {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        encoder.BuildRayTracingAccelerationContainers(2, containers);
+        wgpu::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+
+        EXPECT_EQ(dawn_native::GetAccelerationContainerUpdateStats(containers[0].Get()).buildCount,
+                  1u);
+        EXPECT_EQ(dawn_native::GetAccelerationContainerUpdateStats(containers[1].Get()).buildCount,
+                  1u);
+    }
+
+    // Error case, there are no containers.
+    {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        encoder.BuildRayTracingAccelerationContainers(0, nullptr);
+        ASSERT_DEVICE_ERROR(encoder.Finish());
+    }
+
+    // Error case, a container is built twice.
+    {
+        wgpu::RayTracingAccelerationContainer duplicates[2] = {containers[0], containers[0]};
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        encoder.BuildRayTracingAccelerationContainers(2, duplicates);
+        ASSERT_DEVICE_ERROR(encoder.Finish());
+    }
+
+    // Error case, the static container was already built.
+    {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        encoder.BuildRayTracingAccelerationContainers(2, containers);
+        ASSERT_DEVICE_ERROR(encoder.Finish());
+    }
+}
+
+// Test the validation of updating a range of instances.
+TEST_F(RayTracingAccelerationContainerValidationTest, UpdateInstances) {
+    wgpu::RayTracingAccelerationContainer geometryContainer =
+        CreateBottomLevelContainer(wgpu::RayTracingAccelerationContainerUsage::None);
+    wgpu::RayTracingAccelerationContainer container = CreateTopLevelContainer(geometryContainer, 4);
+
+    std::vector<wgpu::RayTracingAccelerationInstanceDescriptor> instances(4);
+    for (wgpu::RayTracingAccelerationInstanceDescriptor& instance : instances) {
+        instance.geometryContainer = geometryContainer;
+    }
+
+    // Success cases, including an empty range and a range ending at the last instance.
+    container.UpdateInstances(0, 4, instances.data());
+    container.UpdateInstances(1, 3, instances.data());
+    container.UpdateInstances(4, 0, nullptr);
+    container.UpdateInstance(3, &instances[0]);
+
+    // Error case, the range is out of bounds.
+    ASSERT_DEVICE_ERROR(container.UpdateInstances(1, 4, instances.data()));
+    ASSERT_DEVICE_ERROR(container.UpdateInstances(0xFFFFFFFF, 2, instances.data()));
+    ASSERT_DEVICE_ERROR(container.UpdateInstance(4, &instances[0]));
+
+    // Error case, an instance links a top-level container.
+    instances[2].geometryContainer = container;
+    ASSERT_DEVICE_ERROR(container.UpdateInstances(0, 4, instances.data()));
+    instances[2].geometryContainer = geometryContainer;
+
+    // Error case, bottom-level containers have no instances.
+    ASSERT_DEVICE_ERROR(geometryContainer.UpdateInstances(0, 1, instances.data()));
+
+    // Error case, the container is destroyed.
+    container.Destroy();
+    ASSERT_DEVICE_ERROR(container.UpdateInstances(0, 4, instances.data()));
+}
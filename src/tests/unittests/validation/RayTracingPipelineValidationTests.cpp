@@ -0,0 +1,120 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/unittests/validation/ValidationTest.h"
+
+#include "utils/WGPUHelpers.h"
+
+class RayTracingPipelineValidationTest : public ValidationTest {
+  protected:
+    void SetUp() override {
+        ValidationTest::SetUp();
+        device = CreateDeviceFromAdapter(adapter, {"ray_tracing"});
+
+        // Shader binding tables don't inspect their modules, so any module will do.
+        mModule = utils::CreateShaderModule(device, utils::SingleShaderStage::Compute, R"(
+            #version 450
+            void main() {
+            })");
+        mOtherModule = utils::CreateShaderModule(device, utils::SingleShaderStage::Compute, R"(
+            #version 450
+            layout(std430, set = 0, binding = 0) buffer Data { uint data; };
+            void main() {
+                data = 1;
+            })");
+    }
+
+    wgpu::RayTracingShaderBindingTable CreateShaderBindingTable(wgpu::ShaderModule module) {
+        wgpu::RayTracingShaderBindingTableStageDescriptor stage;
+        stage.stage = wgpu::ShaderStage::RayGeneration;
+        stage.module = module;
+
+        wgpu::RayTracingShaderBindingTableGroupDescriptor group;
+        group.type = wgpu::RayTracingShaderBindingTableGroupType::General;
+        group.generalIndex = 0;
+
+        wgpu::RayTracingShaderBindingTableDescriptor descriptor;
+        descriptor.stageCount = 1;
+        descriptor.stages = &stage;
+        descriptor.groupCount = 1;
+        descriptor.groups = &group;
+        return device.CreateRayTracingShaderBindingTable(&descriptor);
+    }
+
+    wgpu::RayTracingPipeline CreatePipeline(wgpu::RayTracingShaderBindingTable table,
+                                            uint32_t maxPayloadSize) {
+        wgpu::RayTracingStateDescriptor state;
+        state.shaderBindingTable = table;
+        state.maxPayloadSize = maxPayloadSize;
+
+        wgpu::RayTracingPipelineDescriptor descriptor;
+        descriptor.rayTracingState = &state;
+        return device.CreateRayTracingPipeline(&descriptor);
+    }
+
+    wgpu::ShaderModule mModule;
+    wgpu::ShaderModule mOtherModule;
+};
+
+// Test that shader binding tables aren't deduplicated, so that destroying one doesn't affect
+// another with the same contents.
+TEST_F(RayTracingPipelineValidationTest, ShaderBindingTablesAreNotDeduplicated) {
+    wgpu::RayTracingShaderBindingTable table = CreateShaderBindingTable(mModule);
+    wgpu::RayTracingShaderBindingTable sameTable = CreateShaderBindingTable(mModule);
+    EXPECT_NE(table.Get(), sameTable.Get());
+
+    table.Destroy();
+    CreatePipeline(sameTable, 16);
+}
+
+// Test that ray tracing pipelines with the same contents are deduplicated.
+TEST_F(RayTracingPipelineValidationTest, PipelineDeduplication) {
+    wgpu::RayTracingPipeline pipeline = CreatePipeline(CreateShaderBindingTable(mModule), 16);
+    wgpu::RayTracingPipeline samePipeline = CreatePipeline(CreateShaderBindingTable(mModule), 16);
+    wgpu::RayTracingPipeline otherPayloadPipeline =
+        CreatePipeline(CreateShaderBindingTable(mModule), 32);
+    wgpu::RayTracingPipeline otherTablePipeline =
+        CreatePipeline(CreateShaderBindingTable(mOtherModule), 16);
+
+    EXPECT_EQ(pipeline.Get(), samePipeline.Get());
+    EXPECT_NE(pipeline.Get(), otherPayloadPipeline.Get());
+    EXPECT_NE(pipeline.Get(), otherTablePipeline.Get());
+}
+
+// Test that a pipeline can still be used after the table it was created with, or another table
+// with the same contents, is destroyed.
+TEST_F(RayTracingPipelineValidationTest, PipelineOutlivesShaderBindingTable) {
+    wgpu::RayTracingShaderBindingTable table = CreateShaderBindingTable(mModule);
+    wgpu::RayTracingShaderBindingTable sameTable = CreateShaderBindingTable(mModule);
+    wgpu::RayTracingPipeline pipeline = CreatePipeline(table, 16);
+    wgpu::RayTracingPipeline samePipeline = CreatePipeline(sameTable, 16);
+    EXPECT_EQ(pipeline.Get(), samePipeline.Get());
+
+    table.Destroy();
+
+    wgpu::RayTracingPassDescriptor passDescriptor;
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    wgpu::RayTracingPassEncoder pass = encoder.BeginRayTracingPass(&passDescriptor);
+    pass.SetPipeline(samePipeline);
+    pass.EndPass();
+    encoder.Finish();
+}
+
+// Test that creating a pipeline with a destroyed shader binding table is an error.
+TEST_F(RayTracingPipelineValidationTest, DestroyedShaderBindingTable) {
+    wgpu::RayTracingShaderBindingTable table = CreateShaderBindingTable(mModule);
+    table.Destroy();
+
+    ASSERT_DEVICE_ERROR(CreatePipeline(table, 16));
+}
@@ -0,0 +1,137 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/unittests/wire/WireTest.h"
+
+using namespace testing;
+using namespace dawn_wire;
+
+namespace {
+
+    // Mock class to add expectations on the wire calling callbacks
+    class MockDeviceStatisticsCallback {
+      public:
+        MOCK_METHOD(void,
+                    Call,
+                    (WGPUDeviceStatisticsStatus status,
+                     const WGPUDeviceStatistics* statistics,
+                     void* userdata));
+    };
+
+    std::unique_ptr<StrictMock<MockDeviceStatisticsCallback>> mockDeviceStatisticsCallback;
+    void ToMockDeviceStatisticsCallback(WGPUDeviceStatisticsStatus status,
+                                        const WGPUDeviceStatistics* statistics,
+                                        void* userdata) {
+        mockDeviceStatisticsCallback->Call(status, statistics, userdata);
+    }
+
+}  // anonymous namespace
+
+class WireDeviceStatisticsTests : public WireTest {
+  public:
+    WireDeviceStatisticsTests() {
+    }
+    ~WireDeviceStatisticsTests() override = default;
+
+    void SetUp() override {
+        WireTest::SetUp();
+
+        mockDeviceStatisticsCallback = std::make_unique<StrictMock<MockDeviceStatisticsCallback>>();
+    }
+
+    void TearDown() override {
+        WireTest::TearDown();
+
+        mockDeviceStatisticsCallback = nullptr;
+    }
+
+    void FlushServer() {
+        WireTest::FlushServer();
+
+        Mock::VerifyAndClearExpectations(&mockDeviceStatisticsCallback);
+    }
+};
+
+// Test that the statistics of the server device are returned to the client.
+TEST_F(WireDeviceStatisticsTests, GetStatistics) {
+    wgpuDeviceGetStatistics(device, ToMockDeviceStatisticsCallback, this);
+
+    WGPUDeviceStatisticsCallback callback;
+    void* userdata;
+    EXPECT_CALL(api, OnDeviceGetStatisticsCallback(apiDevice, _, _))
+        .WillOnce(DoAll(SaveArg<1>(&callback), SaveArg<2>(&userdata)));
+
+    FlushClient();
+
+    WGPUDeviceStatistics statistics = {};
+    statistics.bufferCount = 3;
+    statistics.shaderModuleCacheHits = 5;
+    statistics.stagingBytesInFlight = 4096;
+    statistics.pendingDeletionCount = 7;
+    callback(WGPUDeviceStatisticsStatus_Success, &statistics, userdata);
+
+    EXPECT_CALL(*mockDeviceStatisticsCallback,
+                Call(WGPUDeviceStatisticsStatus_Success, NotNull(), this))
+        .WillOnce(WithArg<1>(Invoke([](const WGPUDeviceStatistics* received) {
+            EXPECT_EQ(received->bufferCount, 3u);
+            EXPECT_EQ(received->textureCount, 0u);
+            EXPECT_EQ(received->shaderModuleCacheHits, 5u);
+            EXPECT_EQ(received->stagingBytesInFlight, 4096u);
+            EXPECT_EQ(received->pendingDeletionCount, 7u);
+        })));
+
+    FlushServer();
+}
+
+// Test that the statistics requests return in the order the server answers them.
+TEST_F(WireDeviceStatisticsTests, GetStatisticsOrdering) {
+    wgpuDeviceGetStatistics(device, ToMockDeviceStatisticsCallback, this);
+    wgpuDeviceGetStatistics(device, ToMockDeviceStatisticsCallback, this + 1);
+
+    WGPUDeviceStatisticsCallback callback1;
+    WGPUDeviceStatisticsCallback callback2;
+    void* userdata1;
+    void* userdata2;
+    EXPECT_CALL(api, OnDeviceGetStatisticsCallback(apiDevice, _, _))
+        .WillOnce(DoAll(SaveArg<1>(&callback1), SaveArg<2>(&userdata1)))
+        .WillOnce(DoAll(SaveArg<1>(&callback2), SaveArg<2>(&userdata2)));
+
+    FlushClient();
+
+    WGPUDeviceStatistics statistics = {};
+    callback2(WGPUDeviceStatisticsStatus_Success, &statistics, userdata2);
+    EXPECT_CALL(*mockDeviceStatisticsCallback,
+                Call(WGPUDeviceStatisticsStatus_Success, NotNull(), this + 1))
+        .Times(1);
+    FlushServer();
+
+    callback1(WGPUDeviceStatisticsStatus_DeviceLost, &statistics, userdata1);
+    EXPECT_CALL(*mockDeviceStatisticsCallback,
+                Call(WGPUDeviceStatisticsStatus_DeviceLost, NotNull(), this))
+        .Times(1);
+    FlushServer();
+}
+
+// Test that the statistics requests in flight are answered when the device is destroyed.
+TEST_F(WireDeviceStatisticsTests, GetStatisticsDeviceDestroyed) {
+    wgpuDeviceGetStatistics(device, ToMockDeviceStatisticsCallback, this);
+
+    EXPECT_CALL(api, OnDeviceGetStatisticsCallback(apiDevice, _, _)).Times(1);
+    FlushClient();
+
+    // Incomplete callback called in Device destructor.
+    EXPECT_CALL(*mockDeviceStatisticsCallback,
+                Call(WGPUDeviceStatisticsStatus_Unknown, NotNull(), this))
+        .Times(1);
+}
@@ -0,0 +1,186 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/unittests/wire/WireTest.h"
+
+using namespace testing;
+using namespace dawn_wire;
+
+namespace {
+
+    // Mock class to add expectations on the wire calling callbacks
+    class MockCompactedSizeCallback {
+      public:
+        MOCK_METHOD(void,
+                    Call,
+                    (WGPURayTracingAccelerationContainerCompactedSizeStatus status,
+                     uint64_t compactedSize,
+                     void* userdata));
+    };
+
+    std::unique_ptr<StrictMock<MockCompactedSizeCallback>> mockCompactedSizeCallback;
+    void ToMockCompactedSizeCallback(WGPURayTracingAccelerationContainerCompactedSizeStatus status,
+                                     uint64_t compactedSize,
+                                     void* userdata) {
+        mockCompactedSizeCallback->Call(status, compactedSize, userdata);
+    }
+
+}  // anonymous namespace
+
+class WireRayTracingAccelerationContainerTests : public WireTest {
+  public:
+    WireRayTracingAccelerationContainerTests() {
+    }
+    ~WireRayTracingAccelerationContainerTests() override = default;
+
+    void SetUp() override {
+        WireTest::SetUp();
+
+        mockCompactedSizeCallback = std::make_unique<StrictMock<MockCompactedSizeCallback>>();
+
+        WGPURayTracingAccelerationContainerDescriptor descriptor = {};
+        descriptor.level = WGPURayTracingAccelerationContainerLevel_Bottom;
+        descriptor.usage = WGPURayTracingAccelerationContainerUsage_AllowCompaction;
+
+        apiContainer = api.GetNewRayTracingAccelerationContainer();
+        container = wgpuDeviceCreateRayTracingAccelerationContainer(device, &descriptor);
+
+        EXPECT_CALL(api, DeviceCreateRayTracingAccelerationContainer(apiDevice, _))
+            .WillOnce(Return(apiContainer));
+        FlushClient();
+    }
+
+    void TearDown() override {
+        WireTest::TearDown();
+
+        mockCompactedSizeCallback = nullptr;
+    }
+
+    void FlushServer() {
+        WireTest::FlushServer();
+
+        Mock::VerifyAndClearExpectations(&mockCompactedSizeCallback);
+    }
+
+  protected:
+    // A successfully created container
+    WGPURayTracingAccelerationContainer container;
+    WGPURayTracingAccelerationContainer apiContainer;
+};
+
+// Test that the compacted size returned by the server is forwarded to the client.
+TEST_F(WireRayTracingAccelerationContainerTests, GetCompactedSizeSuccess) {
+    wgpuRayTracingAccelerationContainerGetCompactedSizeAsync(container, ToMockCompactedSizeCallback,
+                                                             this);
+
+    EXPECT_CALL(api, OnRayTracingAccelerationContainerGetCompactedSizeAsyncCallback(apiContainer,
+                                                                                    _, _))
+        .WillOnce(InvokeWithoutArgs([&]() {
+            api.CallCompactedSizeCallback(
+                apiContainer, WGPURayTracingAccelerationContainerCompactedSizeStatus_Success,
+                4096);
+        }));
+    FlushClient();
+
+    EXPECT_CALL(*mockCompactedSizeCallback,
+                Call(WGPURayTracingAccelerationContainerCompactedSizeStatus_Success, 4096u, this))
+        .Times(1);
+    FlushServer();
+}
+
+// Test that errors of the server are forwarded to the client without a compacted size.
+TEST_F(WireRayTracingAccelerationContainerTests, GetCompactedSizeError) {
+    wgpuRayTracingAccelerationContainerGetCompactedSizeAsync(container, ToMockCompactedSizeCallback,
+                                                             this);
+
+    EXPECT_CALL(api, OnRayTracingAccelerationContainerGetCompactedSizeAsyncCallback(apiContainer,
+                                                                                    _, _))
+        .WillOnce(InvokeWithoutArgs([&]() {
+            api.CallCompactedSizeCallback(
+                apiContainer, WGPURayTracingAccelerationContainerCompactedSizeStatus_Error, 0);
+        }));
+    FlushClient();
+
+    EXPECT_CALL(*mockCompactedSizeCallback,
+                Call(WGPURayTracingAccelerationContainerCompactedSizeStatus_Error, 0u, this))
+        .Times(1);
+    FlushServer();
+}
+
+// Test that the requests are answered in the order the server answers them.
+TEST_F(WireRayTracingAccelerationContainerTests, GetCompactedSizeOrdering) {
+    wgpuRayTracingAccelerationContainerGetCompactedSizeAsync(container, ToMockCompactedSizeCallback,
+                                                             this);
+    wgpuRayTracingAccelerationContainerGetCompactedSizeAsync(container, ToMockCompactedSizeCallback,
+                                                             this + 1);
+
+    WGPURayTracingAccelerationContainerCompactedSizeCallback callback1;
+    WGPURayTracingAccelerationContainerCompactedSizeCallback callback2;
+    void* userdata1;
+    void* userdata2;
+    EXPECT_CALL(api, OnRayTracingAccelerationContainerGetCompactedSizeAsyncCallback(apiContainer,
+                                                                                    _, _))
+        .WillOnce(DoAll(SaveArg<1>(&callback1), SaveArg<2>(&userdata1)))
+        .WillOnce(DoAll(SaveArg<1>(&callback2), SaveArg<2>(&userdata2)));
+    FlushClient();
+
+    callback2(WGPURayTracingAccelerationContainerCompactedSizeStatus_Success, 256, userdata2);
+    EXPECT_CALL(*mockCompactedSizeCallback,
+                Call(WGPURayTracingAccelerationContainerCompactedSizeStatus_Success, 256u,
+                     this + 1))
+        .Times(1);
+    FlushServer();
+
+    callback1(WGPURayTracingAccelerationContainerCompactedSizeStatus_Success, 512, userdata1);
+    EXPECT_CALL(*mockCompactedSizeCallback,
+                Call(WGPURayTracingAccelerationContainerCompactedSizeStatus_Success, 512u, this))
+        .Times(1);
+    FlushServer();
+}
+
+// Test that the device lost status of the server is forwarded to the client.
+TEST_F(WireRayTracingAccelerationContainerTests, GetCompactedSizeDeviceLost) {
+    wgpuRayTracingAccelerationContainerGetCompactedSizeAsync(container, ToMockCompactedSizeCallback,
+                                                             this);
+
+    EXPECT_CALL(api, OnRayTracingAccelerationContainerGetCompactedSizeAsyncCallback(apiContainer,
+                                                                                    _, _))
+        .WillOnce(InvokeWithoutArgs([&]() {
+            api.CallCompactedSizeCallback(
+                apiContainer, WGPURayTracingAccelerationContainerCompactedSizeStatus_DeviceLost,
+                0);
+        }));
+    FlushClient();
+
+    EXPECT_CALL(*mockCompactedSizeCallback,
+                Call(WGPURayTracingAccelerationContainerCompactedSizeStatus_DeviceLost, 0u, this))
+        .Times(1);
+    FlushServer();
+}
+
+// Test that the requests in flight are answered when the device is destroyed.
+TEST_F(WireRayTracingAccelerationContainerTests, GetCompactedSizeDeviceDestroyed) {
+    wgpuRayTracingAccelerationContainerGetCompactedSizeAsync(container, ToMockCompactedSizeCallback,
+                                                             this);
+
+    EXPECT_CALL(api, OnRayTracingAccelerationContainerGetCompactedSizeAsyncCallback(apiContainer,
+                                                                                    _, _))
+        .Times(1);
+    FlushClient();
+
+    // Incomplete callback called in Device destructor.
+    EXPECT_CALL(*mockCompactedSizeCallback,
+                Call(WGPURayTracingAccelerationContainerCompactedSizeStatus_Unknown, 0u, this))
+        .Times(1);
+}
@@ -0,0 +1,295 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/DawnTest.h"
+
+#include "common/vulkan_platform.h"
+#include "dawn_native/VulkanBackend.h"
+#include "utils/WGPUHelpers.h"
+
+namespace {
+
+    // These tests only run on the adapter of the fake Vulkan driver, which is discovered with
+    // --use-fake-vulkan-driver.
+    class VulkanFakeDriverTests : public DawnTest {
+      public:
+        void SetUp() override {
+            DawnTest::SetUp();
+            DAWN_SKIP_TEST_IF(UsesWire());
+
+            dawn_native::vulkan::FakeDriverStatistics statistics;
+            DAWN_SKIP_TEST_IF(
+                !dawn_native::vulkan::GetFakeDriverStatistics(device.Get(), &statistics));
+        }
+
+      protected:
+        dawn_native::vulkan::FakeDriverStatistics GetStatistics() {
+            dawn_native::vulkan::FakeDriverStatistics statistics;
+            EXPECT_TRUE(dawn_native::vulkan::GetFakeDriverStatistics(device.Get(), &statistics));
+            return statistics;
+        }
+
+        uint64_t GetCallCount(const char* entryPoint) {
+            return dawn_native::vulkan::GetFakeDriverCallCount(device.Get(), entryPoint);
+        }
+    };
+
+    // The fake driver supports ray tracing, so these tests only skip on other adapters.
+    class VulkanFakeDriverRayTracingTests : public VulkanFakeDriverTests {
+      protected:
+        std::vector<const char*> GetRequiredExtensions() override {
+            mIsRayTracingSupported = SupportsExtensions({"ray_tracing"});
+            if (!mIsRayTracingSupported) {
+                return {};
+            }
+            return {"ray_tracing"};
+        }
+
+        void SetUp() override {
+            VulkanFakeDriverTests::SetUp();
+            DAWN_SKIP_TEST_IF(!mIsRayTracingSupported);
+        }
+
+        bool mIsRayTracingSupported = false;
+    };
+
+    struct CompactedSizeResult {
+        bool done = false;
+        WGPURayTracingAccelerationContainerCompactedSizeStatus status;
+        uint64_t compactedSize = 0;
+    };
+
+    void StoreCompactedSize(WGPURayTracingAccelerationContainerCompactedSizeStatus status,
+                            uint64_t compactedSize,
+                            void* userdata) {
+        CompactedSizeResult* result = static_cast<CompactedSizeResult*>(userdata);
+        result->done = true;
+        result->status = status;
+        result->compactedSize = compactedSize;
+    }
+
+}  // anonymous namespace
+
+// Test that a buffer to buffer copy is recorded and submitted to the fake driver.
+TEST_P(VulkanFakeDriverTests, CopyIsRecordedAndSubmitted) {
+    wgpu::BufferDescriptor descriptor;
+    descriptor.size = 256;
+    descriptor.usage = wgpu::BufferUsage::CopySrc | wgpu::BufferUsage::CopyDst;
+    wgpu::Buffer source = device.CreateBuffer(&descriptor);
+    wgpu::Buffer destination = device.CreateBuffer(&descriptor);
+
+    dawn_native::vulkan::FakeDriverStatistics before = GetStatistics();
+    uint64_t submitCallsBefore = GetCallCount("vkQueueSubmit");
+    uint64_t copyCallsBefore = GetCallCount("vkCmdCopyBuffer");
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    encoder.CopyBufferToBuffer(source, 0, destination, 0, descriptor.size);
+    wgpu::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+
+    dawn_native::vulkan::FakeDriverStatistics after = GetStatistics();
+    EXPECT_EQ(after.copyCount, before.copyCount + 1);
+    EXPECT_GT(after.queueSubmitCount, before.queueSubmitCount);
+    EXPECT_GT(after.submittedCommandBufferCount, before.submittedCommandBufferCount);
+    EXPECT_GT(after.callCount, before.callCount);
+    EXPECT_EQ(GetCallCount("vkCmdCopyBuffer"), copyCallsBefore + 1);
+    EXPECT_EQ(GetCallCount("vkQueueSubmit"), after.queueSubmitCount);
+    EXPECT_GT(GetCallCount("vkQueueSubmit"), submitCallsBefore);
+}
+
+// Test that a dispatch and the descriptors it uses are recorded by the fake driver.
+TEST_P(VulkanFakeDriverTests, DispatchIsRecorded) {
+    wgpu::ShaderModule module =
+        utils::CreateShaderModule(device, utils::SingleShaderStage::Compute, R"(
+        #version 450
+        layout(std430, set = 0, binding = 0) buffer Data {
+            uint value;
+        } data;
+        void main() {
+            data.value = 1u;
+        })");
+
+    wgpu::ComputePipelineDescriptor pipelineDescriptor;
+    pipelineDescriptor.computeStage.module = module;
+    pipelineDescriptor.computeStage.entryPoint = "main";
+    wgpu::ComputePipeline pipeline = device.CreateComputePipeline(&pipelineDescriptor);
+
+    wgpu::BufferDescriptor descriptor;
+    descriptor.size = 4;
+    descriptor.usage = wgpu::BufferUsage::Storage;
+    wgpu::Buffer buffer = device.CreateBuffer(&descriptor);
+
+    wgpu::BindGroup bindGroup =
+        utils::MakeBindGroup(device, pipeline.GetBindGroupLayout(0), {{0, buffer, 0, 4}});
+
+    dawn_native::vulkan::FakeDriverStatistics before = GetStatistics();
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+    pass.SetPipeline(pipeline);
+    pass.SetBindGroup(0, bindGroup);
+    pass.Dispatch(1);
+    pass.EndPass();
+    wgpu::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+
+    dawn_native::vulkan::FakeDriverStatistics after = GetStatistics();
+    EXPECT_EQ(after.dispatchCount, before.dispatchCount + 1);
+    EXPECT_EQ(after.renderPassCount, before.renderPassCount);
+    EXPECT_GE(after.descriptorWriteCount, 1u);
+    EXPECT_GT(after.queueSubmitCount, before.queueSubmitCount);
+}
+
+// Test that the transitions of all the resources of a pass are recorded in a single
+// vkCmdPipelineBarrier.
+TEST_P(VulkanFakeDriverTests, OneBarrierPerPass) {
+    constexpr uint32_t kBufferCount = 3;
+
+    wgpu::ShaderModule module =
+        utils::CreateShaderModule(device, utils::SingleShaderStage::Compute, R"(
+        #version 450
+        layout(std430, set = 0, binding = 0) buffer Data0 {
+            uint value;
+        } data0;
+        layout(std430, set = 0, binding = 1) buffer Data1 {
+            uint value;
+        } data1;
+        layout(std430, set = 0, binding = 2) buffer Data2 {
+            uint value;
+        } data2;
+        void main() {
+            data0.value = 1u;
+            data1.value = 2u;
+            data2.value = 3u;
+        })");
+
+    wgpu::ComputePipelineDescriptor pipelineDescriptor;
+    pipelineDescriptor.computeStage.module = module;
+    pipelineDescriptor.computeStage.entryPoint = "main";
+    wgpu::ComputePipeline pipeline = device.CreateComputePipeline(&pipelineDescriptor);
+
+    wgpu::BufferDescriptor descriptor;
+    descriptor.size = 4;
+    descriptor.usage = wgpu::BufferUsage::CopySrc;
+    wgpu::Buffer source = device.CreateBuffer(&descriptor);
+
+    descriptor.usage = wgpu::BufferUsage::Storage | wgpu::BufferUsage::CopyDst;
+    wgpu::Buffer buffers[kBufferCount];
+    for (wgpu::Buffer& buffer : buffers) {
+        buffer = device.CreateBuffer(&descriptor);
+    }
+
+    // Copy to the buffers first so that each of them needs a transition to the storage usage.
+    // The first usage of a buffer doesn't need a barrier.
+    {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        for (const wgpu::Buffer& buffer : buffers) {
+            encoder.CopyBufferToBuffer(source, 0, buffer, 0, descriptor.size);
+        }
+        wgpu::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+    }
+
+    wgpu::BindGroup bindGroup = utils::MakeBindGroup(device, pipeline.GetBindGroupLayout(0),
+                                                     {{0, buffers[0], 0, 4},
+                                                      {1, buffers[1], 0, 4},
+                                                      {2, buffers[2], 0, 4}});
+
+    uint64_t barrierCallsBefore = GetCallCount("vkCmdPipelineBarrier");
+
+    wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+    wgpu::ComputePassEncoder pass = encoder.BeginComputePass();
+    pass.SetPipeline(pipeline);
+    pass.SetBindGroup(0, bindGroup);
+    pass.Dispatch(1);
+    pass.EndPass();
+    wgpu::CommandBuffer commands = encoder.Finish();
+    queue.Submit(1, &commands);
+
+    EXPECT_EQ(GetCallCount("vkCmdPipelineBarrier"), barrierCallsBefore + 1);
+}
+
+DAWN_INSTANTIATE_TEST(VulkanFakeDriverTests, VulkanBackend());
+
+// Test that building an acceleration container, querying its compacted size and compacting it
+// go through the ray tracing entry points of the fake driver.
+TEST_P(VulkanFakeDriverRayTracingTests, BuildAndCompact) {
+    constexpr uint32_t kTriangleCount = 4;
+
+    wgpu::BufferDescriptor bufferDescriptor;
+    bufferDescriptor.size = kTriangleCount * 3 * 3 * sizeof(float);
+    bufferDescriptor.usage = wgpu::BufferUsage::RayTracing;
+    wgpu::Buffer vertexBuffer = device.CreateBuffer(&bufferDescriptor);
+
+    wgpu::RayTracingAccelerationGeometryVertexDescriptor vertex;
+    vertex.buffer = vertexBuffer;
+    vertex.format = wgpu::VertexFormat::Float3;
+    vertex.stride = 3 * sizeof(float);
+    vertex.count = kTriangleCount * 3;
+
+    wgpu::RayTracingAccelerationGeometryDescriptor geometry;
+    geometry.type = wgpu::RayTracingAccelerationGeometryType::Triangles;
+    geometry.vertex = &vertex;
+
+    wgpu::RayTracingAccelerationContainerDescriptor descriptor;
+    descriptor.level = wgpu::RayTracingAccelerationContainerLevel::Bottom;
+    descriptor.usage = wgpu::RayTracingAccelerationContainerUsage::AllowCompaction;
+    descriptor.geometryCount = 1;
+    descriptor.geometries = &geometry;
+
+    uint64_t createCallsBefore = GetCallCount("vkCreateAccelerationStructureKHR");
+    uint64_t buildCallsBefore = GetCallCount("vkCmdBuildAccelerationStructureKHR");
+    uint64_t queryCallsBefore = GetCallCount("vkCmdWriteAccelerationStructuresPropertiesKHR");
+    uint64_t copyCallsBefore = GetCallCount("vkCmdCopyAccelerationStructureKHR");
+
+    wgpu::RayTracingAccelerationContainer container =
+        device.CreateRayTracingAccelerationContainer(&descriptor);
+    EXPECT_EQ(GetCallCount("vkCreateAccelerationStructureKHR"), createCallsBefore + 1);
+
+    {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        encoder.BuildRayTracingAccelerationContainer(container);
+        wgpu::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+    }
+    EXPECT_EQ(GetCallCount("vkCmdBuildAccelerationStructureKHR"), buildCallsBefore + 1);
+    EXPECT_EQ(GetCallCount("vkCmdWriteAccelerationStructuresPropertiesKHR"),
+              queryCallsBefore + 1);
+
+    CompactedSizeResult result;
+    container.GetCompactedSizeAsync(StoreCompactedSize, &result);
+    while (!result.done) {
+        WaitABit();
+    }
+    ASSERT_EQ(result.status, WGPURayTracingAccelerationContainerCompactedSizeStatus_Success);
+    EXPECT_GT(result.compactedSize, 0u);
+
+    wgpu::RayTracingAccelerationContainerDescriptor compactedDescriptor;
+    compactedDescriptor.level = wgpu::RayTracingAccelerationContainerLevel::Bottom;
+    compactedDescriptor.compactedSize = result.compactedSize;
+    wgpu::RayTracingAccelerationContainer compactedContainer =
+        device.CreateRayTracingAccelerationContainer(&compactedDescriptor);
+
+    {
+        wgpu::CommandEncoder encoder = device.CreateCommandEncoder();
+        encoder.CopyRayTracingAccelerationContainer(
+            container, compactedContainer, wgpu::RayTracingAccelerationContainerCopyMode::Compact);
+        wgpu::CommandBuffer commands = encoder.Finish();
+        queue.Submit(1, &commands);
+    }
+    EXPECT_EQ(GetCallCount("vkCreateAccelerationStructureKHR"), createCallsBefore + 2);
+    EXPECT_EQ(GetCallCount("vkCmdCopyAccelerationStructureKHR"), copyCallsBefore + 1);
+}
+
+DAWN_INSTANTIATE_TEST(VulkanFakeDriverRayTracingTests, VulkanBackend());
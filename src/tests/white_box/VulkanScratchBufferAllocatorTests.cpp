@@ -0,0 +1,120 @@
+// Copyright 2020 The Dawn Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tests/DawnTest.h"
+
+#include "dawn_native/vulkan/DeviceVk.h"
+#include "dawn_native/vulkan/ScratchBufferAllocatorVk.h"
+
+using namespace dawn_native::vulkan;
+
+namespace {
+
+    constexpr uint64_t kRingBufferSize = ScratchBufferAllocator::kRingBufferSize;
+    constexpr uint64_t kScratchAlignment = ScratchBufferAllocator::kScratchAlignment;
+
+    // Scratch buffers are created with the ray tracing usage, so these tests need the ray tracing
+    // extension.
+    class VulkanScratchBufferAllocatorTests : public DawnTest {
+      protected:
+        std::vector<const char*> GetRequiredExtensions() override {
+            mIsRayTracingSupported = SupportsExtensions({"ray_tracing"});
+            if (!mIsRayTracingSupported) {
+                return {};
+            }
+            return {"ray_tracing"};
+        }
+
+        void SetUp() override {
+            DawnTest::SetUp();
+            DAWN_SKIP_TEST_IF(UsesWire());
+            DAWN_SKIP_TEST_IF(!mIsRayTracingSupported);
+
+            mDeviceVk = reinterpret_cast<Device*>(device.Get());
+            mAllocator = mDeviceVk->GetScratchBufferAllocator();
+        }
+
+        ScratchAllocation Allocate(uint64_t size) {
+            ScratchAllocation allocation;
+            EXPECT_FALSE(mDeviceVk->ConsumedError(mAllocator->Allocate(size), &allocation));
+            return allocation;
+        }
+
+        // Waits for the commands of the current pending serial to complete and returns their
+        // scratch memory to the allocator.
+        void CompletePendingSerial() {
+            Serial serial = mDeviceVk->GetPendingCommandSerial();
+            while (mDeviceVk->GetCompletedCommandSerial() < serial) {
+                WaitABit();
+            }
+            mAllocator->Deallocate(mDeviceVk->GetCompletedCommandSerial());
+        }
+
+        bool mIsRayTracingSupported = false;
+        Device* mDeviceVk = nullptr;
+        ScratchBufferAllocator* mAllocator = nullptr;
+    };
+
+}  // anonymous namespace
+
+// Test that scratch allocations are aligned for acceleration container builds.
+TEST_P(VulkanScratchBufferAllocatorTests, AllocationsAreAligned) {
+    ScratchAllocation first = Allocate(1);
+    ScratchAllocation second = Allocate(1);
+
+    EXPECT_EQ(first.buffer, second.buffer);
+    EXPECT_EQ(second.offset, first.offset + kScratchAlignment);
+    EXPECT_EQ(second.deviceAddress, first.deviceAddress + kScratchAlignment);
+}
+
+// Test that the memory of a ring buffer is reused once the serial of its allocations completes.
+TEST_P(VulkanScratchBufferAllocatorTests, ReuseAfterSerialCompletes) {
+    CompletePendingSerial();
+    EXPECT_EQ(mAllocator->GetRingBufferCountForTesting(), 1u);
+
+    ScratchAllocation first = Allocate(kRingBufferSize);
+    EXPECT_EQ(first.offset, 0u);
+
+    CompletePendingSerial();
+
+    // The whole ring buffer is available again.
+    ScratchAllocation second = Allocate(kRingBufferSize);
+    EXPECT_EQ(second.buffer, first.buffer);
+    EXPECT_EQ(second.offset, 0u);
+    EXPECT_EQ(mAllocator->GetRingBufferCountForTesting(), 1u);
+}
+
+// Test that a new ring buffer is created when the existing ones are exhausted, and that it is
+// released once its allocations complete.
+TEST_P(VulkanScratchBufferAllocatorTests, GrowsWhenExhausted) {
+    CompletePendingSerial();
+    EXPECT_EQ(mAllocator->GetRingBufferCountForTesting(), 1u);
+
+    ScratchAllocation first = Allocate(kRingBufferSize / 2);
+    ScratchAllocation second = Allocate(kRingBufferSize);
+    EXPECT_NE(second.buffer, first.buffer);
+    EXPECT_EQ(second.offset, 0u);
+    EXPECT_EQ(mAllocator->GetRingBufferCountForTesting(), 2u);
+
+    // Smaller allocations still use the space left in the first ring buffer.
+    ScratchAllocation third = Allocate(kRingBufferSize / 4);
+    EXPECT_EQ(third.buffer, first.buffer);
+    EXPECT_EQ(third.offset, kRingBufferSize / 2);
+
+    // Only the last ring buffer is kept once all the allocations complete.
+    CompletePendingSerial();
+    EXPECT_EQ(mAllocator->GetRingBufferCountForTesting(), 1u);
+}
+
+DAWN_INSTANTIATE_TEST(VulkanScratchBufferAllocatorTests, VulkanBackend());